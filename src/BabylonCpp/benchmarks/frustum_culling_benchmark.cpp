@@ -0,0 +1,129 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/culling/bounding_info.h>
+#include <babylon/culling/bounding_volume_arrays.h>
+#include <babylon/math/frustum.h>
+#include <babylon/math/matrix.h>
+#include <babylon/math/plane.h>
+
+/**
+ * @brief Measures the frustum culling of randomly placed, rotated and scaled
+ * bounding volumes: one object at a time through BoundingInfo::isInFrustum(),
+ * against the structure of arrays kernel of BoundingVolumeArrays, with and
+ * without the gathering of the bounding volumes.
+ *
+ * Usage: frustum_culling_benchmark [objectCount] [passCount]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock = std::chrono::high_resolution_clock;
+
+template <typename Pass>
+double measure(std::size_t passCount, Pass&& pass)
+{
+  // Warm up
+  pass();
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < passCount; ++i) {
+    pass();
+  }
+  const auto end = Clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count()
+         / static_cast<double>(passCount);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::size_t objectCount = 50000;
+  std::size_t passCount   = 100;
+  if (argc > 1) {
+    objectCount = std::max<std::size_t>(1, std::strtoul(argv[1], nullptr, 10));
+  }
+  if (argc > 2) {
+    passCount = std::max<std::size_t>(1, std::strtoul(argv[2], nullptr, 10));
+  }
+
+  const Vector3 eye(0.f, 0.f, -100.f);
+  Vector3 target(0.f, 0.f, 0.f);
+  auto view                = Matrix::LookAtLH(eye, target, Vector3::Up());
+  const auto frustumPlanes = Frustum::GetPlanes(
+    view.multiply(Matrix::PerspectiveFovLH(0.8f, 1.5f, 1.f, 300.f)));
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> position(-200.f, 200.f);
+  std::uniform_real_distribution<float> angle(-3.f, 3.f);
+  std::uniform_real_distribution<float> size(0.5f, 2.f);
+  std::vector<std::unique_ptr<BoundingInfo>> boundingInfos;
+  boundingInfos.reserve(objectCount);
+  for (std::size_t i = 0; i < objectCount; ++i) {
+    boundingInfos.emplace_back(std_util::make_unique<BoundingInfo>(
+      Vector3(-size(generator), -size(generator), -size(generator)),
+      Vector3(size(generator), size(generator), size(generator))));
+    boundingInfos.back()->update(
+      Matrix::RotationYawPitchRoll(angle(generator), angle(generator),
+                                   angle(generator))
+        .multiply(Matrix::Translation(position(generator),
+                                      position(generator),
+                                      position(generator))));
+  }
+
+  // One object at a time
+  Uint8Array scalarVisibility(objectCount);
+  const auto scalar = measure(passCount, [&]() {
+    for (std::size_t i = 0; i < objectCount; ++i) {
+      scalarVisibility[i] = boundingInfos[i]->isInFrustum(frustumPlanes);
+    }
+  });
+
+  // Structure of arrays, gathered from scratch at each pass
+  Uint32Array visibility;
+  const auto gatherAndCull = measure(passCount, [&]() {
+    BoundingVolumeArrays volumes;
+    volumes.resize(objectCount);
+    for (std::size_t i = 0; i < objectCount; ++i) {
+      volumes.attach(i, *boundingInfos[i]);
+    }
+    volumes.cull(frustumPlanes, visibility);
+  });
+
+  // Structure of arrays mirroring the bounding infos, as maintained by the
+  // scene when the active meshes candidates do not change
+  BoundingVolumeArrays volumes;
+  volumes.resize(objectCount);
+  for (std::size_t i = 0; i < objectCount; ++i) {
+    volumes.attach(i, *boundingInfos[i]);
+  }
+  const auto cull = measure(passCount, [&]() {
+    for (std::size_t i = 0; i < objectCount; ++i) {
+      volumes.attach(i, *boundingInfos[i]);
+    }
+    volumes.cull(frustumPlanes, visibility);
+  });
+  const auto kernel = measure(
+    passCount, [&]() { volumes.cull(frustumPlanes, visibility); });
+
+  std::size_t visibleCount = 0, mismatchCount = 0;
+  for (std::size_t i = 0; i < objectCount; ++i) {
+    const bool visible = BoundingVolumeArrays::IsVisible(visibility, i);
+    visibleCount += visible ? 1 : 0;
+    mismatchCount += (visible != (scalarVisibility[i] != 0)) ? 1 : 0;
+  }
+
+  std::printf("%zu objects, %zu visible, %zu mismatches, %zu passes\n",
+              objectCount, visibleCount, mismatchCount, passCount);
+  std::printf("%-24s %10s %10s\n", "culling", "ms/pass", "speedup");
+  std::printf("%-24s %10.3f %10.2f\n", "one object at a time", scalar, 1.0);
+  std::printf("%-24s %10.3f %10.2f\n", "gather + SIMD kernel", gatherAndCull,
+              scalar / gatherAndCull);
+  std::printf("%-24s %10.3f %10.2f\n", "mirrored + SIMD kernel", cull,
+              scalar / cull);
+  std::printf("%-24s %10.3f %10.2f\n", "SIMD kernel", kernel,
+              scalar / kernel);
+
+  return 0;
+}
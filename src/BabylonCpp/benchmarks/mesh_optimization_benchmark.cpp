@@ -0,0 +1,153 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/loading/scene_loader.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/mesh_optimizer.h>
+#include <babylon/mesh/vertex_buffer.h>
+
+/**
+ * @brief Reports the efficiency of the post-transform vertex cache (ACMR and
+ * ATVR for a cache of 16 vertices) before and after the MeshOptimizer, with the
+ * duration of the optimization and the vertices removed by the welding.
+ *
+ * The meshes are generated ones, as built and as exported by tools writing a
+ * vertex per triangle corner in an arbitrary triangle order, and the meshes of
+ * the .babylon files given on the command line.
+ *
+ * Usage: mesh_optimization_benchmark [file.babylon...]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Splits a mesh in one vertex per index, the triangles being shuffled
+void unweld(Mesh* mesh)
+{
+  const auto indices     = mesh->getIndices();
+  const auto vertexCount = mesh->getTotalVertices();
+  std::vector<std::size_t> triangles(indices.size() / 3);
+  std::iota(triangles.begin(), triangles.end(), 0);
+  std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+
+  for (auto kind : mesh->getVerticesDataKinds()) {
+    const auto data = mesh->getVerticesData(kind);
+    const auto size = data.size() / vertexCount;
+    Float32Array unwelded;
+    unwelded.reserve(indices.size() * size);
+    for (auto triangle : triangles) {
+      for (std::size_t corner = 0; corner < 3; ++corner) {
+        const auto vertex = indices[triangle * 3 + corner];
+        const auto first  = data.begin() + vertex * size;
+        unwelded.insert(unwelded.end(), first, first + size);
+      }
+    }
+    mesh->setVerticesData(kind, unwelded);
+  }
+
+  IndicesArray unweldedIndices(indices.size());
+  std::iota(unweldedIndices.begin(), unweldedIndices.end(), 0u);
+  mesh->setIndices(unweldedIndices, unweldedIndices.size());
+}
+
+void report(const std::string& name, const MeshOptimizationReport& report,
+            double duration)
+{
+  printf("%-28s %8zu %8zu %8zu %6.3f %6.3f %6.3f %6.3f %9.2f\n", name.c_str(),
+         report.before.triangles, report.verticesBefore, report.verticesAfter,
+         report.before.acmr, report.after.acmr, report.before.atvr,
+         report.after.atvr, duration);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+
+  std::vector<std::pair<std::string, Mesh*>> meshes;
+  const auto generate = [&](const std::string& name, Mesh* built,
+                            Mesh* exported) {
+    meshes.emplace_back(name, built);
+    unweld(exported);
+    meshes.emplace_back(name + " (exported)", exported);
+  };
+  generate("sphere", Mesh::CreateSphere("sphere", 64, 2.f, scene.get()),
+           Mesh::CreateSphere("sphere2", 64, 2.f, scene.get()));
+  generate("torus knot",
+           Mesh::CreateTorusKnot("knot", 2.f, 0.5f, 128, 64, 2.f, 3.f,
+                                 scene.get()),
+           Mesh::CreateTorusKnot("knot2", 2.f, 0.5f, 128, 64, 2.f, 3.f,
+                                 scene.get()));
+  generate("ground", Mesh::CreateGround("ground", 10, 10, 128, scene.get()),
+           Mesh::CreateGround("ground2", 10, 10, 128, scene.get()));
+
+  // The files are read here and imported as data, as the loader has no file
+  // access
+  for (int i = 1; i < argc; ++i) {
+    const std::string path = argv[i];
+    std::ifstream file(path);
+    if (!file) {
+      fprintf(stderr, "Cannot read %s\n", path.c_str());
+      continue;
+    }
+    const std::string data{std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>()};
+    const auto fileName = path.substr(path.find_last_of('/') + 1);
+    try {
+      SceneLoader::ImportMesh(
+        {}, "", "data:" + data, scene.get(),
+        [&](std::vector<AbstractMesh*>& imported,
+            std::vector<ParticleSystem*>&, std::vector<Skeleton*>&) {
+          for (auto mesh : imported) {
+            auto asMesh = dynamic_cast<Mesh*>(mesh);
+            if (asMesh && asMesh->getTotalIndices() > 0) {
+              meshes.emplace_back(fileName + ":" + mesh->name, asMesh);
+            }
+          }
+        });
+    }
+    catch (const std::exception& e) {
+      fprintf(stderr, "Cannot import %s: %s\n", path.c_str(), e.what());
+    }
+  }
+
+  printf("%-28s %8s %8s %8s %6s %6s %6s %6s %9s\n", "mesh", "tris", "verts",
+         "welded", "ACMR", "ACMR'", "ATVR", "ATVR'", "ms");
+
+  // The copies are optimized on the task scheduler, the meshes on this thread
+  std::vector<Mesh*> copies;
+  for (const auto& entry : meshes) {
+    auto copy = entry.second->clone(entry.second->name + "_copy");
+    copy->makeGeometryUnique();
+    copies.emplace_back(copy);
+  }
+
+  for (const auto& entry : meshes) {
+    const auto start  = Clock::now();
+    const auto result = MeshOptimizer::Optimize(entry.second);
+    const auto end    = Clock::now();
+    report(entry.first, result,
+           std::chrono::duration<double, std::milli>(end - start).count());
+  }
+
+  MeshOptimizer optimizer(scene.get());
+  const auto start = Clock::now();
+  for (auto copy : copies) {
+    optimizer.optimizeAsync(copy);
+  }
+  optimizer.wait();
+  const auto end = Clock::now();
+  printf("%zu meshes optimized on the task scheduler in %.2f ms\n",
+         copies.size(),
+         std::chrono::duration<double, std::milli>(end - start).count());
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/core/task_scheduler.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/simplification/isimplification_settings.h>
+#include <babylon/mesh/simplification/quadratic_error_simplification.h>
+#include <babylon/mesh/simplification/simplification_queue.h>
+
+/**
+ * @brief Reports the duration of the quadratic error simplification of a
+ * torus knot of about a million triangles, down to 50%, 25% and 10% of its
+ * triangles, the levels being decimated one after the other on this thread,
+ * then by the simplification queue of the scene, one after the other and in
+ * parallel. The same is done for several meshes of 130k triangles, the meshes
+ * being simplified at the same time by the queue.
+ *
+ * Usage: mesh_simplification_benchmark [tubularSegments radialSegments]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock = std::chrono::high_resolution_clock;
+
+double elapsed(const Clock::time_point& start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+    .count();
+}
+
+const std::vector<ISimplificationSettings> settings{
+  {0.5f, 10.f, true}, {0.25f, 20.f, true}, {0.1f, 40.f, true}};
+
+// Sequential decimation of every level, without creating the meshes
+double decimate(const std::vector<Mesh*>& meshes, bool verbose)
+{
+  const auto start = Clock::now();
+  for (auto mesh : meshes) {
+    auto levelStart = Clock::now();
+    QuadraticErrorSimplification simplifier(mesh);
+    if (verbose) {
+      printf("  copy of %zu triangles: %9.2f ms\n",
+             simplifier.getTriangleCount(), elapsed(levelStart));
+    }
+    for (const auto& setting : settings) {
+      levelStart           = Clock::now();
+      const auto decimated = simplifier.decimate(setting);
+      if (verbose) {
+        printf("  quality %.2f: %8zu triangles %9.2f ms\n", setting.quality,
+               decimated.indices.size() / 3, elapsed(levelStart));
+      }
+    }
+  }
+  return elapsed(start);
+}
+
+// Simplification through the queue of the scene, the LOD levels being added
+double simplify(Scene* scene, const std::vector<Mesh*>& meshes,
+                bool parallelProcessing)
+{
+  const auto start = Clock::now();
+  for (auto mesh : meshes) {
+    mesh->simplify(settings, parallelProcessing);
+  }
+  scene->simplificationQueue->wait();
+  const auto duration = elapsed(start);
+  for (auto mesh : meshes) {
+    for (const auto& setting : settings) {
+      auto lod = mesh->getLODLevelAtDistance(setting.distance);
+      mesh->removeLODLevel(lod);
+      lod->dispose();
+    }
+  }
+  return duration;
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  const unsigned int tubularSegments
+    = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[1])) : 1024;
+  const unsigned int radialSegments
+    = argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : 512;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+
+  printf("%zu workers\n", TaskScheduler::Instance().workerCount());
+
+  auto knot
+    = Mesh::CreateTorusKnot("knot", 2.f, 0.5f, radialSegments, tubularSegments,
+                            2.f, 3.f, scene.get());
+  printf("torus knot of %zu triangles\n", knot->getTotalIndices() / 3);
+  const auto sequential = decimate({knot}, true);
+  printf("  sequential decimation:      %9.2f ms\n", sequential);
+  printf("  queue, one after the other: %9.2f ms\n",
+         simplify(scene.get(), {knot}, false));
+  printf("  queue, in parallel:         %9.2f ms\n",
+         simplify(scene.get(), {knot}, true));
+  knot->dispose();
+
+  std::vector<Mesh*> meshes;
+  for (unsigned int i = 0; i < 8; ++i) {
+    meshes.emplace_back(Mesh::CreateTorusKnot("knot" + std::to_string(i), 2.f,
+                                              0.5f, 128, 512, 2.f, 3.f,
+                                              scene.get()));
+  }
+  printf("%zu torus knots of %zu triangles\n", meshes.size(),
+         meshes.front()->getTotalIndices() / 3);
+  printf("  sequential decimation:      %9.2f ms\n", decimate(meshes, false));
+  printf("  queue, one after the other: %9.2f ms\n",
+         simplify(scene.get(), meshes, false));
+  printf("  queue, in parallel:         %9.2f ms\n",
+         simplify(scene.get(), meshes, true));
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/core/task_scheduler.h>
+#include <babylon/culling/bounding_box.h>
+#include <babylon/culling/octrees/octree.h>
+#include <babylon/culling/ray.h>
+#include <babylon/math/frustum.h>
+#include <babylon/math/matrix.h>
+#include <babylon/math/plane.h>
+
+/**
+ * @brief Measures the construction of an Octree and its frustum, sphere and ray
+ * queries, against a linear scan of the bounding boxes, for 10k, 100k and 1M
+ * randomly placed boxes. Batches of queries are measured against the same
+ * queries run one after the other.
+ *
+ * The octree never dereferences its entries, they are indices disguised as
+ * SubMesh pointers, so that the boxes need no scene.
+ *
+ * Usage: octree_benchmark [queryCount] [maxCount]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock = std::chrono::high_resolution_clock;
+
+std::vector<Vector3> minimums, maximums;
+
+SubMesh* toEntry(std::size_t index)
+{
+  return reinterpret_cast<SubMesh*>((index + 1) * sizeof(void*));
+}
+
+std::size_t toIndex(SubMesh* entry)
+{
+  return reinterpret_cast<std::size_t>(entry) / sizeof(void*) - 1;
+}
+
+bool boundsFunc(SubMesh* entry, Vector3& minimum, Vector3& maximum)
+{
+  minimum = minimums[toIndex(entry)];
+  maximum = maximums[toIndex(entry)];
+  return true;
+}
+
+bool isInFrustum(const Vector3& minimum, const Vector3& maximum,
+                 const std::array<Plane, 6>& frustumPlanes)
+{
+  for (const auto& plane : frustumPlanes) {
+    const Vector3 corner(plane.normal.x >= 0.f ? maximum.x : minimum.x,
+                         plane.normal.y >= 0.f ? maximum.y : minimum.y,
+                         plane.normal.z >= 0.f ? maximum.z : minimum.z);
+    if (plane.dotCoordinate(corner) < 0.f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Func>
+double measure(std::size_t passCount, Func&& func)
+{
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < passCount; ++i) {
+    func(i);
+  }
+  const auto end = Clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count()
+         / static_cast<double>(passCount);
+}
+
+void report(const char* name, double scan, double octree)
+{
+  std::printf("  %-22s %12.4f %12.4f %10.1f\n", name, scan, octree,
+              scan / octree);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::size_t queryCount = 64;
+  std::size_t maxCount   = 1000000;
+  if (argc > 1) {
+    queryCount = std::max<std::size_t>(1, std::strtoul(argv[1], nullptr, 10));
+  }
+  if (argc > 2) {
+    maxCount = std::max<std::size_t>(1, std::strtoul(argv[2], nullptr, 10));
+  }
+
+  std::printf("%zu task scheduler workers, %zu queries, times in ms\n",
+              TaskScheduler::Instance().workerCount(), queryCount);
+
+  for (std::size_t count = 10000; count <= maxCount; count *= 10) {
+    // Same density of boxes for every count
+    const float worldSize = 20.f * std::cbrt(static_cast<float>(count));
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-worldSize, worldSize);
+    std::uniform_real_distribution<float> size(0.5f, 4.f);
+    std::uniform_real_distribution<float> direction(-1.f, 1.f);
+    minimums.clear();
+    maximums.clear();
+    std::vector<SubMesh*> entries;
+    for (std::size_t i = 0; i < count; ++i) {
+      const Vector3 center(position(generator), position(generator),
+                           position(generator));
+      const Vector3 extend(size(generator), size(generator), size(generator));
+      minimums.emplace_back(center.subtract(extend));
+      maximums.emplace_back(center.add(extend));
+      entries.emplace_back(toEntry(i));
+    }
+
+    // Queries around random points of the world
+    std::vector<std::array<Plane, 6>> frustums;
+    std::vector<Vector3> sphereCenters;
+    Float32Array sphereRadii;
+    std::vector<Ray> rays;
+    for (std::size_t i = 0; i < queryCount; ++i) {
+      const Vector3 eye(position(generator), position(generator),
+                        position(generator));
+      const Vector3 forward(direction(generator), direction(generator),
+                            direction(generator));
+      Vector3 target = eye.add(forward);
+      auto view      = Matrix::LookAtLH(eye, target, Vector3::Up());
+      frustums.emplace_back(Frustum::GetPlanes(
+        view.multiply(Matrix::PerspectiveFovLH(0.8f, 1.5f, 1.f, 200.f))));
+      sphereCenters.emplace_back(eye);
+      sphereRadii.emplace_back(50.f);
+      rays.emplace_back(eye, Vector3::Normalize(forward), 500.f);
+    }
+
+    Octree<SubMesh*> octree(boundsFunc, 64, 8);
+    const Vector3 worldMin(-worldSize - 4.f, -worldSize - 4.f,
+                           -worldSize - 4.f);
+    const Vector3 worldMax(worldSize + 4.f, worldSize + 4.f, worldSize + 4.f);
+    const auto build = measure(5, [&](std::size_t) {
+      octree.update(worldMin, worldMax, entries);
+    });
+
+    std::vector<SubMesh*> selection;
+    std::size_t selected = 0, scanned = 0;
+    const auto scanFrustum = measure(queryCount, [&](std::size_t i) {
+      selection.clear();
+      for (std::size_t j = 0; j < count; ++j) {
+        if (isInFrustum(minimums[j], maximums[j], frustums[i])) {
+          selection.emplace_back(entries[j]);
+        }
+      }
+      scanned += selection.size();
+    });
+    const auto octreeFrustum = measure(queryCount, [&](std::size_t i) {
+      selected += octree.select(frustums[i], false).size();
+    });
+    const auto scanSphere = measure(queryCount, [&](std::size_t i) {
+      selection.clear();
+      for (std::size_t j = 0; j < count; ++j) {
+        if (BoundingBox::IntersectsSphere(minimums[j], maximums[j],
+                                          sphereCenters[i], sphereRadii[i])) {
+          selection.emplace_back(entries[j]);
+        }
+      }
+    });
+    const auto octreeSphere = measure(queryCount, [&](std::size_t i) {
+      octree.intersects(sphereCenters[i], sphereRadii[i], false);
+    });
+    const auto scanRay = measure(queryCount, [&](std::size_t i) {
+      selection.clear();
+      for (std::size_t j = 0; j < count; ++j) {
+        if (rays[i].intersectsBoxMinMax(minimums[j], maximums[j])) {
+          selection.emplace_back(entries[j]);
+        }
+      }
+    });
+    const auto octreeRay = measure(
+      queryCount, [&](std::size_t i) { octree.intersectsRay(rays[i]); });
+
+    // Batches, time per query
+    std::vector<std::vector<SubMesh*>> selections;
+    const auto batchFrustum = measure(1, [&](std::size_t) {
+      octree.select(frustums, selections, false);
+    }) / static_cast<double>(queryCount);
+    const auto batchSphere = measure(1, [&](std::size_t) {
+      octree.intersects(sphereCenters, sphereRadii, selections, false);
+    }) / static_cast<double>(queryCount);
+    const auto batchRay = measure(1, [&](std::size_t) {
+      octree.intersectsRay(rays, selections);
+    }) / static_cast<double>(queryCount);
+
+    std::printf("\n%zu boxes, %zu blocks, build %.2f, %.1f selected per "
+                "frustum (%.1f in the frustum)\n",
+                count, octree.blocks.size(), build,
+                static_cast<double>(selected) / queryCount,
+                static_cast<double>(scanned) / queryCount);
+    std::printf("  %-22s %12s %12s %10s\n", "query", "scan", "octree",
+                "speedup");
+    report("frustum", scanFrustum, octreeFrustum);
+    report("sphere", scanSphere, octreeSphere);
+    report("ray", scanRay, octreeRay);
+    std::printf("  %-22s %12s %12s %10s\n", "query", "one by one", "batch",
+                "speedup");
+    report("frustum", octreeFrustum, batchFrustum);
+    report("sphere", octreeSphere, batchSphere);
+    report("ray", octreeRay, batchRay);
+  }
+
+  return 0;
+}
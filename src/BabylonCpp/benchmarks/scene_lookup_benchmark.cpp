@@ -0,0 +1,120 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/mesh/mesh.h>
+
+/**
+ * @brief Measures the Scene lookups by id, name and unique id for growing
+ * numbers of meshes, against a linear scan of the meshes.
+ *
+ * Usage: scene_lookup_benchmark [maxMeshCount] [lookupCount]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock = std::chrono::high_resolution_clock;
+
+template <typename Lookup>
+double measure(std::size_t lookupCount, std::size_t meshCount,
+               Lookup&& lookup)
+{
+  std::mt19937 generator(42);
+  // One lookup out of 8 misses
+  std::uniform_int_distribution<std::size_t> distribution(
+    0, meshCount + meshCount / 8);
+  std::vector<std::size_t> indices(lookupCount);
+  for (auto& index : indices) {
+    index = distribution(generator);
+  }
+
+  std::size_t found = 0;
+  const auto start  = Clock::now();
+  for (auto index : indices) {
+    found += lookup(index) ? 1 : 0;
+  }
+  const auto end = Clock::now();
+
+  // Keeps the lookups from being optimized away
+  if (found > lookupCount) {
+    std::printf("unexpected number of hits\n");
+  }
+  return std::chrono::duration<double, std::nano>(end - start).count()
+         / static_cast<double>(lookupCount);
+}
+
+void runBenchmark(std::size_t meshCount, std::size_t lookupCount)
+{
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+
+  std::vector<std::string> ids(meshCount + meshCount / 8 + 1);
+  std::vector<std::string> names(ids.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    ids[i]   = "id" + std::to_string(i);
+    names[i] = "mesh" + std::to_string(i);
+  }
+  unsigned int firstUniqueId = 0;
+  for (std::size_t i = 0; i < meshCount; ++i) {
+    auto mesh = Mesh::New(names[i], scene.get());
+    mesh->setId(ids[i]);
+    if (i == 0) {
+      firstUniqueId = mesh->uniqueId;
+    }
+  }
+
+  const auto byID = measure(lookupCount, meshCount, [&](std::size_t i) {
+    return scene->getMeshByID(ids[i]);
+  });
+  const auto byName = measure(lookupCount, meshCount, [&](std::size_t i) {
+    return scene->getMeshByName(names[i]);
+  });
+  const auto byUniqueID
+    = measure(lookupCount, meshCount, [&](std::size_t i) {
+        return scene->getMeshByUniqueID(
+          firstUniqueId + static_cast<unsigned int>(i));
+      });
+  // Linear scan, as performed before the meshes were indexed
+  const auto scanCount = std::max<std::size_t>(1, lookupCount / 100);
+  const auto scan      = measure(scanCount, meshCount, [&](std::size_t i) {
+    const auto& id = ids[i];
+    auto it        = std::find_if(
+      scene->meshes.begin(), scene->meshes.end(),
+      [&id](const std::unique_ptr<AbstractMesh>& mesh) {
+        return mesh->id == id;
+      });
+    return it == scene->meshes.end() ? nullptr : it->get();
+  });
+
+  std::printf("%-10zu %12.1f %12.1f %12.1f %12.1f\n", meshCount, byID, byName,
+              byUniqueID, scan);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::size_t maxMeshCount = 100000;
+  std::size_t lookupCount  = 1000000;
+  if (argc > 1) {
+    maxMeshCount
+      = std::max<std::size_t>(1, std::strtoul(argv[1], nullptr, 10));
+  }
+  if (argc > 2) {
+    lookupCount = std::max<std::size_t>(1, std::strtoul(argv[2], nullptr, 10));
+  }
+
+  std::printf("%zu lookups, time per lookup in ns\n", lookupCount);
+  std::printf("%-10s %12s %12s %12s %12s\n", "meshes", "by id", "by name",
+              "by unique id", "linear scan");
+  for (std::size_t meshCount = 100; meshCount <= maxMeshCount;
+       meshCount *= 10) {
+    runBenchmark(meshCount, lookupCount);
+  }
+
+  return 0;
+}
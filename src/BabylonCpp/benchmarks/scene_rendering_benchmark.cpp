@@ -0,0 +1,278 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/cameras/free_camera.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/recording_gl_rendering_context.h>
+#include <babylon/engine/scene.h>
+#include <babylon/lights/hemispheric_light.h>
+#include <babylon/materials/standard_material.h>
+#include <babylon/math/color3.h>
+#include <babylon/mesh/instanced_mesh.h>
+#include <babylon/mesh/mesh.h>
+
+/**
+ * @brief Measures the CPU side cost of Scene::render() on synthetic scenes.
+ *
+ * The scenes are rendered through a headless canvas, so the timings only cover
+ * the engine work (culling, sorting, state management and GL call issuing).
+ * The GL counters of the recording context are reported per frame, which
+ * allows to track the amount of redundant state changes over time.
+ *
+ * Usage: scene_rendering_benchmark [meshCount] [frameCount] [instanceCount]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+struct BenchmarkOptions {
+  std::size_t meshCount     = 1000;
+  std::size_t materialCount = 16;
+  std::size_t instanceCount = 100000;
+  std::size_t warmupFrames  = 10;
+  std::size_t frameCount    = 100;
+}; // end of struct BenchmarkOptions
+
+using SceneBuilder
+  = std::function<void(Scene* scene, const BenchmarkOptions& options)>;
+
+// Places the meshes on a square grid centered on the origin
+Vector3 gridPosition(std::size_t index, std::size_t count)
+{
+  const auto side = static_cast<std::size_t>(
+    std::ceil(std::sqrt(static_cast<float>(count))));
+  const auto offset = static_cast<float>(side) * 0.5f;
+  return Vector3(static_cast<float>(index % side) * 2.f - offset, 0.f,
+                 static_cast<float>(index / side) * 2.f - offset);
+}
+
+StandardMaterial* createMaterial(Scene* scene, std::size_t index)
+{
+  auto material = StandardMaterial::New("material" + std::to_string(index),
+                                        scene);
+  material->diffuseColor
+    = Color3(static_cast<float>(index % 3) * 0.5f,
+             static_cast<float>(index % 5) * 0.25f,
+             static_cast<float>(index % 7) / 7.f);
+  return material;
+}
+
+void buildSharedMaterialScene(Scene* scene, const BenchmarkOptions& options)
+{
+  auto material = createMaterial(scene, 0);
+  for (std::size_t i = 0; i < options.meshCount; ++i) {
+    auto box = Mesh::CreateBox("box" + std::to_string(i), 1.f, scene);
+    box->setPosition(gridPosition(i, options.meshCount));
+    box->setMaterial(material);
+  }
+}
+
+void buildManyMaterialsScene(Scene* scene, const BenchmarkOptions& options)
+{
+  std::vector<StandardMaterial*> materials;
+  for (std::size_t i = 0; i < options.materialCount; ++i) {
+    materials.emplace_back(createMaterial(scene, i));
+  }
+
+  for (std::size_t i = 0; i < options.meshCount; ++i) {
+    auto box = Mesh::CreateBox("box" + std::to_string(i), 1.f, scene);
+    box->setPosition(gridPosition(i, options.meshCount));
+    box->setMaterial(materials[i % materials.size()]);
+  }
+}
+
+// Interleaves two effects, several materials and a few shared geometries, as
+// in a scene whose meshes are created in no particular order
+void buildMixedStatesScene(Scene* scene, const BenchmarkOptions& options)
+{
+  std::vector<StandardMaterial*> materials;
+  for (std::size_t i = 0; i < options.materialCount; ++i) {
+    materials.emplace_back(createMaterial(scene, i));
+    // Unlit materials use another effect
+    materials.back()->setDisableLighting(i % 2 == 1);
+  }
+
+  std::vector<Mesh*> shapes{
+    Mesh::CreateBox("box", 1.f, scene),
+    Mesh::CreateSphere("sphere", 8, 1.f, scene),
+    Mesh::CreateCylinder("cylinder", 1.f, 1.f, 1.f, 16, 1, scene),
+    Mesh::CreateTorus("torus", 1.f, 0.3f, 16, scene)};
+  for (std::size_t i = 0; i < options.meshCount; ++i) {
+    // The clones share the geometry of their shape
+    auto shape = shapes[i % shapes.size()];
+    auto mesh  = (i < shapes.size()) ?
+                  shape :
+                  shape->clone(shape->name + std::to_string(i));
+    mesh->setPosition(gridPosition(i, options.meshCount));
+    mesh->setMaterial(materials[(i / shapes.size()) % materials.size()]);
+  }
+}
+
+// Static props of a city, clones of a few shapes with several materials whose
+// world matrices are frozen
+void buildCityScene(Scene* scene, const BenchmarkOptions& options)
+{
+  std::vector<StandardMaterial*> materials;
+  for (std::size_t i = 0; i < 8; ++i) {
+    materials.emplace_back(createMaterial(scene, i));
+  }
+
+  std::vector<Mesh*> shapes{
+    Mesh::CreateBox("building", 1.f, scene),
+    Mesh::CreateCylinder("pole", 1.f, 0.5f, 0.5f, 8, 1, scene)};
+  for (std::size_t i = 0; i < options.meshCount; ++i) {
+    auto shape = shapes[i % shapes.size()];
+    auto mesh  = (i < shapes.size()) ?
+                  shape :
+                  shape->clone(shape->name + std::to_string(i));
+    mesh->setPosition(gridPosition(i, options.meshCount));
+    mesh->setScaling(Vector3(1.f, 1.f + static_cast<float>(i % 5), 1.f));
+    mesh->setMaterial(materials[(i / 3) % materials.size()]);
+    mesh->freezeWorldMatrix();
+  }
+}
+
+void buildStaticBatchingScene(Scene* scene, const BenchmarkOptions& options)
+{
+  buildCityScene(scene, options);
+  scene->enableStaticBatching();
+}
+
+void buildInstancesScene(Scene* scene, const BenchmarkOptions& options)
+{
+  auto sphere = Mesh::CreateSphere("sphere", 8, 1.f, scene);
+  sphere->setPosition(gridPosition(0, options.meshCount));
+  sphere->setMaterial(createMaterial(scene, 0));
+  for (std::size_t i = 1; i < options.meshCount; ++i) {
+    auto instance = sphere->createInstance("sphere" + std::to_string(i));
+    instance->setPosition(gridPosition(i, options.meshCount));
+  }
+}
+
+// The instances of a single mesh, seen from above so that all of them are
+// drawn
+std::vector<InstancedMesh*> createManyInstances(Scene* scene,
+                                                const BenchmarkOptions& options)
+{
+  const auto extent = std::sqrt(static_cast<float>(options.instanceCount));
+  auto camera       = FreeCamera::New("topCamera",
+                                Vector3(0.f, extent * 2.f, -0.1f), scene);
+  camera->setTarget(Vector3::Zero());
+  scene->activeCamera = camera;
+
+  auto box = Mesh::CreateBox("box", 1.f, scene);
+  box->setPosition(gridPosition(0, options.instanceCount));
+  box->setMaterial(createMaterial(scene, 0));
+  std::vector<InstancedMesh*> instances;
+  instances.reserve(options.instanceCount);
+  for (std::size_t i = 1; i < options.instanceCount; ++i) {
+    auto instance = box->createInstance("box" + std::to_string(i));
+    instance->setPosition(gridPosition(i, options.instanceCount));
+    instances.emplace_back(instance);
+  }
+  return instances;
+}
+
+void buildManyInstancesScene(Scene* scene, const BenchmarkOptions& options)
+{
+  createManyInstances(scene, options);
+}
+
+// 1% of the instances move every frame
+void buildMovingInstancesScene(Scene* scene, const BenchmarkOptions& options)
+{
+  auto instances = createManyInstances(scene, options);
+  auto frame     = std::make_shared<std::size_t>(0);
+  scene->registerBeforeRender([instances, frame]() {
+    const auto height = static_cast<float>(*frame % 2);
+    for (std::size_t i = *frame % 100; i < instances.size(); i += 100) {
+      auto position = instances[i]->position();
+      instances[i]->setPosition(Vector3(position.x, height, position.z));
+    }
+    ++(*frame);
+  });
+}
+
+void runBenchmark(const std::string& name, const SceneBuilder& buildScene,
+                  const BenchmarkOptions& options)
+{
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+
+  const auto extent = std::sqrt(static_cast<float>(options.meshCount)) * 2.f;
+  auto camera
+    = FreeCamera::New("camera", Vector3(0.f, extent, -extent), scene.get());
+  camera->setTarget(Vector3::Zero());
+  HemisphericLight::New("light", Vector3(0.f, 1.f, 0.f), scene.get());
+  buildScene(scene.get(), options);
+
+  // Warm up: compiles the effects and fills the engine caches
+  for (std::size_t i = 0; i < options.warmupFrames; ++i) {
+    scene->render();
+  }
+
+  auto gl = canvas.recordingContext();
+  gl->setCommandRecording(false);
+  gl->resetStatistics();
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  for (std::size_t i = 0; i < options.frameCount; ++i) {
+    scene->render();
+  }
+  const auto end = std::chrono::high_resolution_clock::now();
+
+  const auto& stats = gl->statistics();
+  const auto frames = static_cast<double>(options.frameCount);
+  const auto frameTime
+    = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+  const auto redundancy
+    = stats.stateChanges > 0 ? 100.0 * static_cast<double>(
+                                         stats.redundantStateChanges)
+                                 / static_cast<double>(stats.stateChanges) :
+                               0.0;
+
+  std::printf(
+    "%-16s %10.3f %10.0f %10.0f %10.0f %9.1f%% %10.0f %10.0f %10.0f %10.1f\n",
+    name.c_str(), frameTime, stats.commands / frames, stats.drawCalls / frames,
+    stats.stateChanges / frames, redundancy, stats.programChanges / frames,
+    stats.bufferBindings / frames, stats.uniformUpdates / frames,
+    stats.uploadedBytes / frames / 1024.0);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  BenchmarkOptions options;
+  if (argc > 1) {
+    options.meshCount
+      = std::max<std::size_t>(1, std::strtoul(argv[1], nullptr, 10));
+  }
+  if (argc > 2) {
+    options.frameCount
+      = std::max<std::size_t>(1, std::strtoul(argv[2], nullptr, 10));
+  }
+  if (argc > 3) {
+    options.instanceCount
+      = std::max<std::size_t>(1, std::strtoul(argv[3], nullptr, 10));
+  }
+
+  std::printf("%zu meshes, %zu frames, %zu instances\n", options.meshCount,
+              options.frameCount, options.instanceCount);
+  std::printf("%-16s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n",
+              "scene", "ms/frame", "calls", "draws", "states", "redundant",
+              "programs", "buffers", "uniforms", "upload KB");
+
+  runBenchmark("shared_material", buildSharedMaterialScene, options);
+  runBenchmark("many_materials", buildManyMaterialsScene, options);
+  runBenchmark("mixed_states", buildMixedStatesScene, options);
+  runBenchmark("instances", buildInstancesScene, options);
+  runBenchmark("city", buildCityScene, options);
+  runBenchmark("city_batched", buildStaticBatchingScene, options);
+  runBenchmark("many_instances", buildManyInstancesScene, options);
+  runBenchmark("moving_instances", buildMovingInstancesScene, options);
+
+  return 0;
+}
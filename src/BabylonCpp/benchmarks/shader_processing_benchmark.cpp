@@ -0,0 +1,196 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/core/string.h>
+#include <babylon/materials/effect_includes_shaders_store.h>
+#include <babylon/materials/effect_shaders_store.h>
+#include <babylon/materials/shader_processor.h>
+
+/**
+ * @brief Measures the expansion of the shader includes of all the built-in
+ * shaders, with the regular expressions based processing done for every
+ * effect before and with the ShaderProcessor, cold and with its cache filled.
+ * The default and PBR shaders are then processed for the effects of common
+ * define sets, each set creating an effect whose includes are expanded. The
+ * outputs of both processings are checked to be identical.
+ *
+ * Usage: shader_processing_benchmark [repeats]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock           = std::chrono::high_resolution_clock;
+using IndexParameters = std::unordered_map<std::string, unsigned int>;
+
+// The processing of the includes done by Effect::_processIncludes before the
+// ShaderProcessor, kept as the reference.
+std::string legacyProcessIncludes(const std::string& sourceCode,
+                                  const IndexParameters& indexParameters)
+{
+  std::ostringstream returnValue;
+  auto lines = String::split(sourceCode, '\n');
+  std::regex regex;
+  std::smatch match;
+
+  for (const auto& line : lines) {
+    regex = std::regex("#include<(.+)>");
+    std::string includeFile;
+    if (std::regex_search(line, match, regex) && (match.size() == 2)) {
+      includeFile = match.str(1);
+    }
+    else {
+      returnValue << line << std::endl;
+      continue;
+    }
+
+    if (std_util::contains(EffectIncludesShadersStore::Shaders, includeFile)) {
+      auto includeContent = EffectIncludesShadersStore::Shaders[includeFile];
+      regex = std::regex("#include<(.+)>\\[(.*)]");
+      if (std::regex_search(line, match, regex) && (match.size() == 3)) {
+        std::string indexString(match.str(2));
+        if (indexString.find("..") != std::string::npos) {
+          String::replaceInPlace(indexString, "..", ".");
+          std::vector<std::string> indexSplits
+            = String::split(indexString, '.');
+          if (indexSplits.size() == 2) {
+            auto minIndex = indexSplits[0];
+            auto maxIndex = indexSplits[1];
+            std::ostringstream includeContentStream;
+
+            if ((!String::isDigit(maxIndex))
+                && std_util::contains(indexParameters, maxIndex)) {
+              maxIndex = std::to_string(indexParameters.at(maxIndex));
+            }
+
+            if (String::isDigit(minIndex) && String::isDigit(maxIndex)) {
+              size_t _minIndex = std::stoul(minIndex, nullptr, 0);
+              size_t _maxIndex = std::stoul(maxIndex, nullptr, 0);
+              for (size_t i = _minIndex; i <= _maxIndex; ++i) {
+                std::string _includeContent(includeContent);
+                String::replaceInPlace(_includeContent, "{X}",
+                                       std::to_string(i));
+                includeContentStream << _includeContent << std::endl;
+              }
+            }
+
+            returnValue << includeContentStream.str();
+          }
+        }
+      }
+      else {
+        returnValue << includeContent;
+      }
+    }
+  }
+
+  return returnValue.str();
+}
+
+template <typename Func>
+double measure(unsigned int repeats, Func&& func)
+{
+  const auto start = Clock::now();
+  for (unsigned int i = 0; i < repeats; ++i) {
+    func();
+  }
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+           .count()
+         / repeats;
+}
+
+struct Job {
+  std::string source;
+  IndexParameters indexParameters;
+}; // end of struct Job
+
+// Processes the jobs with both processings and checks that they agree
+void report(const char* name, const std::vector<Job>& jobs,
+            unsigned int repeats)
+{
+  std::vector<std::string> reference(jobs.size()), results(jobs.size());
+  const double legacyMs = measure(repeats, [&]() {
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      reference[i]
+        = legacyProcessIncludes(jobs[i].source, jobs[i].indexParameters);
+    }
+  });
+  const double coldMs = measure(repeats, [&]() {
+    ShaderProcessor::ClearCache();
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      results[i] = ShaderProcessor::ProcessIncludes(jobs[i].source,
+                                                    jobs[i].indexParameters);
+    }
+  });
+  const double warmMs = measure(repeats, [&]() {
+    for (size_t i = 0; i < jobs.size(); ++i) {
+      results[i] = ShaderProcessor::ProcessIncludes(jobs[i].source,
+                                                    jobs[i].indexParameters);
+    }
+  });
+  std::printf("%-28s %6zu %12.3f %12.3f %12.3f %10s\n", name, jobs.size(),
+              legacyMs, coldMs, warmMs, results == reference ? "yes" : "NO");
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  unsigned int repeats = 10;
+  if (argc > 1) {
+    repeats = std::max(
+      1u, static_cast<unsigned int>(std::strtoul(argv[1], nullptr, 10)));
+  }
+
+  std::printf("%-28s %6s %12s %12s %12s %10s\n", "shaders", "jobs",
+              "regex ms", "cold ms", "cached ms", "identical");
+
+  // All the built-in shaders, with the index parameters of the materials
+  std::vector<std::string> names;
+  for (const auto& shader : EffectShadersStore::Shaders) {
+    names.emplace_back(shader.first);
+  }
+  std::sort(names.begin(), names.end());
+  std::vector<Job> jobs;
+  for (const auto& name : names) {
+    jobs.emplace_back(Job{EffectShadersStore::Shaders[name],
+                          {{"maxSimultaneousLights", 4},
+                           {"maxSimultaneousMorphTargets", 0}}});
+  }
+  report("all built-in shaders", jobs, repeats);
+
+  // The effects of a material for common define sets, e.g. with and without
+  // textures, fog or shadows, for several numbers of lights and of morph
+  // targets. The defines are added after the processing of the includes, so
+  // the sets only differ by their index parameters.
+  std::vector<IndexParameters> defineSets;
+  for (unsigned int lights : {1u, 2u, 4u, 8u}) {
+    for (unsigned int morphTargets : {0u, 2u}) {
+      for (unsigned int variant = 0; variant < 4; ++variant) {
+        defineSets.emplace_back(
+          IndexParameters{{"maxSimultaneousLights", lights},
+                          {"maxSimultaneousMorphTargets", morphTargets}});
+      }
+    }
+  }
+  const struct {
+    const char* name;
+    const char* vertex;
+    const char* fragment;
+  } materials[] = {
+    {"default material", "defaultVertexShader", "defaultPixelShader"},
+    {"pbr material", "pbrVertexShader", "pbrPixelShader"},
+  };
+  for (const auto& material : materials) {
+    jobs.clear();
+    for (const auto& indexParameters : defineSets) {
+      jobs.emplace_back(
+        Job{EffectShadersStore::Shaders[material.vertex], indexParameters});
+      jobs.emplace_back(
+        Job{EffectShadersStore::Shaders[material.fragment], indexParameters});
+    }
+    report(material.name, jobs, repeats);
+  }
+
+  return 0;
+}
@@ -0,0 +1,128 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/core/bounded_queue.h>
+#include <babylon/core/shared_queue.h>
+
+/**
+ * @brief Compares the throughput of SharedQueue and BoundedQueue.
+ *
+ * Every run starts the same number of producer and consumer threads, which
+ * transfer a fixed number of items through the queue. The BoundedQueue is
+ * measured both with single item operations and with batch operations.
+ *
+ * Usage: shared_queue_benchmark [itemCount] [maxThreadCount]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr std::size_t BatchSize = 32;
+
+template <typename Producer, typename Consumer>
+double measure(std::size_t threadCount, std::size_t itemCount,
+               Producer&& produce, Consumer&& consume)
+{
+  const auto itemsPerThread = itemCount / threadCount;
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount * 2);
+
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < threadCount; ++i) {
+    threads.emplace_back([&] { produce(itemsPerThread); });
+    threads.emplace_back([&] { consume(itemsPerThread); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto end = Clock::now();
+
+  const auto seconds = std::chrono::duration<double>(end - start).count();
+  return static_cast<double>(itemsPerThread * threadCount) / seconds / 1e6;
+}
+
+double sharedQueue(std::size_t threadCount, std::size_t itemCount)
+{
+  SharedQueue<std::size_t> queue;
+  return measure(threadCount, itemCount,
+                 [&](std::size_t count) {
+                   for (std::size_t i = 0; i < count; ++i) {
+                     queue.push(i);
+                   }
+                 },
+                 [&](std::size_t count) {
+                   std::size_t item;
+                   for (std::size_t i = 0; i < count; ++i) {
+                     queue.waitAndPop(item);
+                   }
+                 });
+}
+
+double boundedQueue(std::size_t threadCount, std::size_t itemCount)
+{
+  BoundedQueue<std::size_t> queue(4096);
+  return measure(threadCount, itemCount,
+                 [&](std::size_t count) {
+                   for (std::size_t i = 0; i < count; ++i) {
+                     queue.push(i);
+                   }
+                 },
+                 [&](std::size_t count) {
+                   std::size_t item;
+                   for (std::size_t i = 0; i < count; ++i) {
+                     queue.waitAndPop(item);
+                   }
+                 });
+}
+
+double boundedQueueBatch(std::size_t threadCount, std::size_t itemCount)
+{
+  BoundedQueue<std::size_t> queue(4096);
+  return measure(threadCount, itemCount,
+                 [&](std::size_t count) {
+                   std::array<std::size_t, BatchSize> items;
+                   for (std::size_t i = 0; i < count; i += BatchSize) {
+                     const auto n = std::min(BatchSize, count - i);
+                     std::iota(items.begin(), items.begin() + n, i);
+                     queue.pushBatch(items.begin(), items.begin() + n);
+                   }
+                 },
+                 [&](std::size_t count) {
+                   std::array<std::size_t, BatchSize> items;
+                   for (std::size_t i = 0; i < count;) {
+                     i += queue.waitAndPopBatch(
+                       items.begin(), std::min(BatchSize, count - i));
+                   }
+                 });
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::size_t itemCount      = 1 << 20;
+  std::size_t maxThreadCount = 32;
+  if (argc > 1) {
+    itemCount = std::max<std::size_t>(1, std::strtoul(argv[1], nullptr, 10));
+  }
+  if (argc > 2) {
+    maxThreadCount
+      = std::max<std::size_t>(1, std::strtoul(argv[2], nullptr, 10));
+  }
+
+  std::printf("%zu items, throughput in million items per second\n",
+              itemCount);
+  std::printf("%-10s %14s %14s %14s\n", "threads", "SharedQueue",
+              "BoundedQueue", "batch");
+  for (std::size_t threadCount = 1; threadCount <= maxThreadCount;
+       threadCount *= 2) {
+    std::printf("%-10zu %14.2f %14.2f %14.2f\n", threadCount,
+                sharedQueue(threadCount, itemCount),
+                boundedQueue(threadCount, itemCount),
+                boundedQueueBatch(threadCount, itemCount));
+  }
+
+  return 0;
+}
@@ -0,0 +1,218 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/math/matrix.h>
+#include <babylon/math/quaternion.h>
+#include <babylon/math/simd/simd_matrix.h>
+#include <babylon/math/simd/simd_quaternion.h>
+#include <babylon/math/simd/simd_vector3.h>
+#include <babylon/math/vector3.h>
+
+/**
+ * @brief Measures the SSE implementations of the matrix, quaternion and vector
+ * routines against their scalar counterparts, on arrays of random inputs. The
+ * scalar routines are those of Matrix, Quaternion and Vector3, as long as the
+ * library is built without BABYLONCPP_OPTION_ENABLE_SIMD.
+ *
+ * Usage: simd_math_benchmark [count] [passCount]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Keeps the results from being optimized away
+float checksum = 0.f;
+
+template <typename Pass>
+double measure(std::size_t count, std::size_t passCount, Pass&& pass)
+{
+  // Warm up
+  pass();
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < passCount; ++i) {
+    pass();
+  }
+  const auto end = Clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count()
+         / static_cast<double>(passCount * count);
+}
+
+void report(const char* name, double scalar, double simd)
+{
+  std::printf("%-24s %10.2f %10.2f %10.2f\n", name, scalar, simd,
+              scalar / simd);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::size_t count     = 10000;
+  std::size_t passCount = 100;
+  if (argc > 1) {
+    count = std::max<std::size_t>(1, std::strtoul(argv[1], nullptr, 10));
+  }
+  if (argc > 2) {
+    passCount = std::max<std::size_t>(1, std::strtoul(argv[2], nullptr, 10));
+  }
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> angle(-3.f, 3.f);
+  std::uniform_real_distribution<float> position(-100.f, 100.f);
+  std::uniform_real_distribution<float> size(0.5f, 2.f);
+  std::uniform_real_distribution<float> amount(0.f, 1.f);
+
+  std::vector<Vector3> scales, translations;
+  std::vector<Quaternion> rotations;
+  std::vector<Matrix> matrices(count), results(count);
+  std::vector<Quaternion> quaternionResults(count);
+  std::vector<float> amounts;
+  for (std::size_t i = 0; i < count; ++i) {
+    scales.emplace_back(size(generator), size(generator), size(generator));
+    translations.emplace_back(position(generator), position(generator),
+                              position(generator));
+    rotations.emplace_back(Quaternion::RotationYawPitchRoll(
+      angle(generator), angle(generator), angle(generator)));
+    Matrix::ComposeToRef(scales[i], rotations[i], translations[i],
+                         matrices[i]);
+    amounts.emplace_back(amount(generator));
+  }
+  Float32Array vectors(count * 3 * 16), transformed;
+  for (auto& value : vectors) {
+    value = position(generator);
+  }
+
+  std::printf("%zu inputs, %zu passes, ns per operation\n", count, passCount);
+  std::printf("%-24s %10s %10s %10s\n", "operation", "scalar", "SSE",
+              "speedup");
+
+  report("matrix multiply", measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i + 1 < count; ++i) {
+             matrices[i].multiplyToRef(matrices[i + 1], results[i]);
+           }
+         }),
+         measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i + 1 < count; ++i) {
+             SIMD::SIMDMatrix::MultiplyToRefSIMD(matrices[i], matrices[i + 1],
+                                                 results[i]);
+           }
+         }));
+
+  report("matrix invert", measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i < count; ++i) {
+             matrices[i].invertToRef(results[i]);
+           }
+         }),
+         measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i < count; ++i) {
+             SIMD::SIMDMatrix::InvertToRefSIMD(matrices[i], results[i]);
+           }
+         }));
+
+  report("matrix compose", measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i < count; ++i) {
+             Matrix::ComposeToRef(scales[i], rotations[i], translations[i],
+                                  results[i]);
+           }
+         }),
+         measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i < count; ++i) {
+             SIMD::SIMDMatrix::ComposeToRefSIMD(scales[i], rotations[i],
+                                                translations[i], results[i]);
+           }
+         }));
+
+  Vector3 scale, translation;
+  Quaternion rotation;
+  report("matrix decompose", measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i < count; ++i) {
+             matrices[i].decompose(scale, rotation, translation);
+             checksum += rotation.w;
+           }
+         }),
+         measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i < count; ++i) {
+             SIMD::SIMDMatrix::DecomposeSIMD(matrices[i], scale, rotation,
+                                             translation);
+             checksum += rotation.w;
+           }
+         }));
+
+  report("quaternion multiply", measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i + 1 < count; ++i) {
+             rotations[i].multiplyToRef(rotations[i + 1],
+                                        quaternionResults[i]);
+           }
+         }),
+         measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i + 1 < count; ++i) {
+             SIMD::SIMDQuaternion::MultiplyToRefSIMD(
+               rotations[i], rotations[i + 1], quaternionResults[i]);
+           }
+         }));
+
+  report("quaternion slerp", measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i + 1 < count; ++i) {
+             Quaternion::SlerpToRef(rotations[i], rotations[i + 1], amounts[i],
+                                    quaternionResults[i]);
+           }
+         }),
+         measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i + 1 < count; ++i) {
+             SIMD::SIMDQuaternion::SlerpToRefSIMD(rotations[i],
+                                                  rotations[i + 1], amounts[i],
+                                                  quaternionResults[i]);
+           }
+         }));
+
+  report("quaternion to matrix", measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i < count; ++i) {
+             rotations[i].toRotationMatrix(results[i]);
+           }
+         }),
+         measure(count, passCount, [&]() {
+           for (std::size_t i = 0; i < count; ++i) {
+             SIMD::SIMDQuaternion::ToRotationMatrixSIMD(rotations[i],
+                                                        results[i]);
+           }
+         }));
+
+  // Vertex arrays, time per vector
+  const auto& transformation = matrices[0];
+  const auto vectorCount     = vectors.size() / 3;
+  Vector3 vector;
+  transformed.resize(vectors.size());
+  report("transform coordinates", measure(vectorCount, passCount, [&]() {
+           for (std::size_t i = 0; i < vectors.size(); i += 3) {
+             Vector3::TransformCoordinatesFromFloatsToRef(
+               vectors[i], vectors[i + 1], vectors[i + 2], transformation,
+               vector);
+             vector.toArray(transformed, static_cast<unsigned int>(i));
+           }
+         }),
+         measure(vectorCount, passCount, [&]() {
+           SIMD::SIMDVector3::TransformCoordinatesArraySIMD(
+             vectors, transformation, transformed);
+         }));
+
+  report("transform normals", measure(vectorCount, passCount, [&]() {
+           for (std::size_t i = 0; i < vectors.size(); i += 3) {
+             Vector3::TransformNormalFromFloatsToRef(
+               vectors[i], vectors[i + 1], vectors[i + 2], transformation,
+               vector);
+             vector.toArray(transformed, static_cast<unsigned int>(i));
+           }
+         }),
+         measure(vectorCount, passCount, [&]() {
+           SIMD::SIMDVector3::TransformNormalsArraySIMD(vectors, transformation,
+                                                        transformed);
+         }));
+
+  if (std::isnan(checksum)) {
+    std::printf("unexpected checksum\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+#include <babylon/babylon_stl.h>
+
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/math/matrix.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/transform_hierarchy.h>
+
+/**
+ * @brief Measures the update of the world matrices of a scene made of trees of
+ * meshes (a root, its children and their children), one mesh at a time through
+ * AbstractMesh::computeWorldMatrix() against TransformHierarchy::update(), when
+ * nothing moves and when a fraction of the roots move at each frame.
+ *
+ * Usage: world_matrix_benchmark [treeCount] [frameCount]
+ */
+
+namespace {
+
+using namespace BABYLON;
+
+using Clock = std::chrono::high_resolution_clock;
+
+constexpr std::size_t ChildCount = 4;
+
+template <typename Frame>
+double measure(Scene& scene, std::size_t frameCount, Frame&& frame)
+{
+  // Warm up
+  scene.incrementRenderId();
+  frame(0);
+  const auto start = Clock::now();
+  for (std::size_t i = 0; i < frameCount; ++i) {
+    scene.incrementRenderId();
+    frame(i + 1);
+  }
+  const auto end = Clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count()
+         / static_cast<double>(frameCount);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  std::size_t treeCount  = 2000;
+  std::size_t frameCount = 100;
+  if (argc > 1) {
+    treeCount = std::max<std::size_t>(1, std::strtoul(argv[1], nullptr, 10));
+  }
+  if (argc > 2) {
+    frameCount = std::max<std::size_t>(1, std::strtoul(argv[2], nullptr, 10));
+  }
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> position(-100.f, 100.f);
+  std::uniform_real_distribution<float> angle(-3.f, 3.f);
+  std::vector<Mesh*> roots;
+  for (std::size_t i = 0; i < treeCount; ++i) {
+    auto root = Mesh::New("root" + std::to_string(i), scene.get());
+    root->position().copyFromFloats(position(generator), position(generator),
+                                    position(generator));
+    roots.emplace_back(root);
+    for (std::size_t j = 0; j < ChildCount; ++j) {
+      auto child = Mesh::New("child", scene.get());
+      child->setParent(root);
+      child->position().copyFromFloats(1.f, 0.f, 0.f);
+      child->rotation().copyFromFloats(0.f, angle(generator), 0.f);
+      for (std::size_t k = 0; k < ChildCount; ++k) {
+        auto grandChild = Mesh::New("grandChild", scene.get());
+        grandChild->setParent(child);
+        grandChild->position().copyFromFloats(0.f, 1.f, 0.f);
+        grandChild->rotation().copyFromFloats(angle(generator), 0.f, 0.f);
+      }
+    }
+  }
+  const auto meshes = scene->getMeshes();
+  TransformHierarchy hierarchy(scene.get());
+
+  const auto perMesh = [&](std::size_t) {
+    for (auto mesh : meshes) {
+      mesh->computeWorldMatrix();
+    }
+  };
+  const auto batched = [&](std::size_t) { hierarchy.update(); };
+  // One root out of 10 moves at each frame
+  const auto moveRoots = [&](std::size_t frame) {
+    for (std::size_t i = frame % 10; i < roots.size(); i += 10) {
+      roots[i]->rotation().y += 0.01f;
+    }
+  };
+
+  const auto staticPerMesh = measure(*scene, frameCount, perMesh);
+  const auto staticBatched = measure(*scene, frameCount, batched);
+  const auto staticUpdated = hierarchy.updatedCount();
+  const auto movingPerMesh = measure(*scene, frameCount, [&](std::size_t i) {
+    moveRoots(i);
+    perMesh(i);
+  });
+  const auto movingBatched = measure(*scene, frameCount, [&](std::size_t i) {
+    moveRoots(i);
+    batched(i);
+  });
+  const auto movingUpdated = hierarchy.updatedCount();
+
+  // Compares the world matrices of the last frame with a full computation
+  float maxError = 0.f;
+  for (auto mesh : meshes) {
+    const Matrix world  = *mesh->getWorldMatrix();
+    const auto expected = mesh->computeWorldMatrix(true);
+    for (unsigned int i = 0; i < 16; ++i) {
+      maxError = std::max(maxError, std::abs(world.m[i] - expected.m[i]));
+    }
+  }
+
+  std::printf("%zu meshes, max error %g, %zu frames\n", meshes.size(),
+              static_cast<double>(maxError), frameCount);
+  std::printf("%-10s %12s %12s %12s %10s\n", "scene", "updated", "per mesh",
+              "hierarchy", "speedup");
+  std::printf("%-10s %12zu %12.3f %12.3f %10.2f\n", "static", staticUpdated,
+              staticPerMesh, staticBatched, staticPerMesh / staticBatched);
+  std::printf("%-10s %12zu %12.3f %12.3f %10.2f\n", "moving", movingUpdated,
+              movingPerMesh, movingBatched, movingPerMesh / movingBatched);
+  std::printf("(times in ms per frame)\n");
+
+  return 0;
+}
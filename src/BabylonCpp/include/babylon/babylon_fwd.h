@@ -109,8 +109,11 @@ struct UpdatePayload;
 class Worker;
 struct WorkerReply;
 // --- Core ---
+class Active;
 struct Image;
 struct NodeCache;
+class SerialTaskQueue;
+class TaskScheduler;
 // - Logging
 class LogChannel;
 class LogMessage;
@@ -119,6 +122,7 @@ class Logger;
 class BoundingBox;
 class BoundingInfo;
 class BoundingSphere;
+class BoundingVolumeArrays;
 struct ICullable;
 class Ray;
 // - Octrees
@@ -147,6 +151,7 @@ class PointerInfoBase;
 class PointerInfoPre;
 struct RenderingGroupInfo;
 class Scene;
+class ShaderProgramCache;
 // --- Interfaces ---
 class ICanvas;
 class ICanvasRenderingContext2D;
@@ -213,6 +218,7 @@ class PushMaterial;
 class ShaderMaterial;
 struct ShaderMaterialOptions;
 class StandardMaterial;
+class StaticBatcher;
 struct StandardMaterialDefines;
 class UniformBuffer;
 // - Textures
@@ -272,11 +278,13 @@ class Geometry;
 class GroundMesh;
 struct IGetSetVerticesData;
 class InstancedMesh;
+class InstancesStream;
 class LinesMesh;
 class Mesh;
 class MeshBuilder;
 class MeshLODLevel;
 class SubMesh;
+class TransformHierarchy;
 class VertexBuffer;
 class VertexData;
 // - Options
@@ -329,14 +337,10 @@ struct Polygon;
 class PolygonMeshBuilder;
 struct PolygonPoints;
 // - Simplification
-class DecimationTriangle;
-class DecimationVertex;
 struct ISimplificationSettings;
 struct ISimplificationTask;
 class ISimplifier;
 class QuadraticErrorSimplification;
-class QuadraticMatrix;
-class Reference;
 class SimplificationQueue;
 class SimplificationSettings;
 // --- Morph ---
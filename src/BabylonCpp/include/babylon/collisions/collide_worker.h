@@ -11,8 +11,8 @@ namespace BABYLON {
 class BABYLON_SHARED_EXPORT CollideWorker {
 
 public:
-  CollideWorker(Collider* collider, const CollisionCache& collisionCache,
-                const Vector3& finalPosition);
+  CollideWorker(Collider* collider, CollisionCache& collisionCache,
+                Vector3& finalPosition);
   ~CollideWorker();
 
   void collideWithWorld(Vector3& position, Vector3& velocity,
@@ -33,8 +33,8 @@ public:
 private:
   Matrix collisionsScalingMatrix;
   Matrix collisionTranformationMatrix;
-  CollisionCache _collisionCache;
-  Vector3 finalPosition;
+  CollisionCache& _collisionCache;
+  Vector3& finalPosition;
 
 }; // end of class CollidePayload
 
@@ -32,7 +32,7 @@ public:
                      const Vector3& p1, const Vector3& p2, const Vector3& p3,
                      bool hasMaterial);
   void _collide(std::vector<Plane>& trianglePlaneArray,
-                const std::vector<Vector3> pts, const IndicesArray& indices,
+                const std::vector<Vector3>& pts, const IndicesArray& indices,
                 size_t indexStart, size_t indexEnd, unsigned int decal,
                 bool hasMaterial);
   void _getResponse(Vector3& pos, Vector3& vel);
@@ -28,6 +28,7 @@ public:
   void onGeometryAdded(Geometry* geometry) override;
   void onGeometryUpdated(Geometry* geometry) override;
   void onGeometryDeleted(Geometry* geometry) override;
+  void onCameraRemoved(Camera* camera) override;
 
 private:
   void _collideWithWorld(Vector3& position, Vector3& velocity,
@@ -7,6 +7,7 @@
 #include <babylon/collisions/serialized_mesh.h>
 #include <babylon/collisions/worker.h>
 #include <babylon/math/vector3.h>
+#include <babylon/tools/observer.h>
 
 namespace BABYLON {
 
@@ -36,13 +37,17 @@ public:
   void onGeometryAdded(Geometry* geometry) override;
   void onGeometryUpdated(Geometry* geometry) override;
   void onGeometryDeleted(Geometry* geometry) override;
+  void onCameraRemoved(Camera* camera) override;
 
 private:
   void _afterRender();
+  // Drops the callback of a pending request, whose reply is then ignored
+  void _cancelCollision(unsigned int collisionIndex);
   void _onMessageFromWorker(const WorkerReply& returnData);
 
 private:
   Scene* _scene;
+  Observer<Scene>::Ptr _onAfterRenderObserver;
   Vector3 _scaledPosition;
   Vector3 _scaledVelocity;
   std::vector<std::function<void(unsigned int collisionIndex,
@@ -24,6 +24,10 @@ struct BABYLON_SHARED_EXPORT ICollisionCoordinator {
   virtual void onGeometryAdded(Geometry* geometry)   = 0;
   virtual void onGeometryUpdated(Geometry* geometry) = 0;
   virtual void onGeometryDeleted(Geometry* geometry) = 0;
+
+  // Cancels the pending requests of a camera, the meshes being handled by
+  // onMeshRemoved()
+  virtual void onCameraRemoved(Camera* camera) = 0;
 }; // end of struct ICollisionCoordinator
 
 } // end of namespace BABYLON
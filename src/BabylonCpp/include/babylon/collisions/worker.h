@@ -3,26 +3,57 @@
 
 #include <babylon/babylon_global.h>
 #include <babylon/collisions/collision_detector_transferable.h>
+#include <babylon/collisions/worker_reply.h>
+#include <babylon/core/shared_queue.h>
 #include <babylon/core/structs.h>
 
 namespace BABYLON {
 
+/**
+ * @brief Background collision worker.
+ *
+ * Messages are processed one at a time and in order on the shared task
+ * scheduler, so the collision cache is never accessed concurrently. The
+ * replies are queued and handed to the callback handler on the thread calling
+ * dispatchReplies(), usually the render thread.
+ */
 class BABYLON_SHARED_EXPORT Worker {
 
 public:
   Worker();
   ~Worker();
 
-  void postMessage(const BabylonMessage& message);
-  void postMessage(const BabylonMessage& message,
-                   const std::vector<ArrayBufferView>& serializable);
+  /**
+   * @brief Queues a message for the worker. The message is moved, so the
+   * payload buffers are transferred to the worker without being copied.
+   */
+  void postMessage(BabylonMessage&& message);
+
+  /**
+   * @brief Hands the replies of the processed messages to the callback
+   * handler, on the calling thread.
+   * @return The number of dispatched replies.
+   */
+  size_t dispatchReplies();
+
+  /**
+   * @brief Stops the worker once the pending messages are processed.
+   */
   void terminate();
 
 public:
   std::function<void(const WorkerReply& e)> callbackHandler;
 
 private:
+  WorkerReply _processMessage(const BabylonMessage& message);
+
+private:
+  // Only accessed from the worker tasks
   CollisionDetectorTransferable collisionDetector;
+  SharedQueue<WorkerReply> _replies;
+  // Declared last so that the pending tasks are processed before the state
+  // they use is destroyed
+  std::unique_ptr<SerialTaskQueue> _tasks;
 
 }; // end of struct Worker
 
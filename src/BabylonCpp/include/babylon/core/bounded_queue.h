@@ -0,0 +1,308 @@
+#ifndef BABYLON_CORE_BOUNDED_QUEUE_H
+#define BABYLON_CORE_BOUNDED_QUEUE_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+/**
+ * @brief Bounded multiple producer, multiple consumer thread safe queue.
+ *
+ * Lock-free alternative to SharedQueue built on a ring buffer where every cell
+ * carries a sequence number, so producers and consumers only contend on two
+ * atomic counters. The capacity is rounded up to the next power of two.
+ *
+ * The blocking operations (push on a full queue and waitAndPop on an empty
+ * one) spin for a short while and then sleep on a condition variable. The
+ * mutex is only touched when a thread actually has to sleep, or when a
+ * waiting thread has to be woken up.
+ *
+ * Ref: Dmitry Vyukov, "Bounded MPMC queue"
+ * http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+template <typename T>
+class BABYLON_SHARED_EXPORT BoundedQueue {
+
+public:
+  static constexpr std::size_t DefaultCapacity = 1024;
+
+public:
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+  BoundedQueue(const BoundedQueue& other)      = delete;
+
+  BoundedQueue(std::size_t capacity = DefaultCapacity)
+      : _mask{_roundUpToPowerOfTwo(capacity) - 1}
+      , _cells{new Cell[_mask + 1]}
+      , _enqueuePos{0}
+      , _dequeuePos{0}
+      , _waitingProducers{0}
+      , _waitingConsumers{0}
+  {
+    for (std::size_t i = 0; i <= _mask; ++i) {
+      _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Wait till a cell is available if the queue is full
+  void push(T item)
+  {
+    if (!_tryPush(item)) {
+      _wait(_waitingProducers, _notFull, [&] { return _tryPush(item); });
+    }
+    _notify(_waitingConsumers, _notEmpty);
+  }
+
+  // return immediately, with true if successful insertion
+  bool tryPush(T item)
+  {
+    if (!_tryPush(item)) {
+      return false;
+    }
+    _notify(_waitingConsumers, _notEmpty);
+    return true;
+  }
+
+  // return immediately, with true if successful retrieval
+  bool tryAndPop(T& poppedItem)
+  {
+    if (!_tryPop(poppedItem)) {
+      return false;
+    }
+    _notify(_waitingProducers, _notFull);
+    return true;
+  }
+
+  // Try to retrieve, if no items, wait till an item is available and try again
+  void waitAndPop(T& poppedItem)
+  {
+    if (!_tryPop(poppedItem)) {
+      _wait(_waitingConsumers, _notEmpty,
+            [&] { return _tryPop(poppedItem); });
+    }
+    _notify(_waitingProducers, _notFull);
+  }
+
+  /**
+   * @brief Moves all the items of the range into the queue, waiting for free
+   * cells when the queue is full. Waiting consumers are woken up once per
+   * batch instead of once per item.
+   */
+  template <typename InputIt>
+  void pushBatch(InputIt first, InputIt last)
+  {
+    for (; first != last; ++first) {
+      if (!_tryPush(*first)) {
+        _notify(_waitingConsumers, _notEmpty);
+        _wait(_waitingProducers, _notFull, [&] { return _tryPush(*first); });
+      }
+    }
+    _notify(_waitingConsumers, _notEmpty);
+  }
+
+  /**
+   * @brief Moves the items of the range into the queue until it is full.
+   * @return the number of items moved into the queue
+   */
+  template <typename InputIt>
+  std::size_t tryPushBatch(InputIt first, InputIt last)
+  {
+    std::size_t count = 0;
+    for (; first != last && _tryPush(*first); ++first) {
+      ++count;
+    }
+    if (count > 0) {
+      _notify(_waitingConsumers, _notEmpty);
+    }
+    return count;
+  }
+
+  /**
+   * @brief Retrieves up to maxItems items without waiting.
+   * @return the number of items written to the output iterator
+   */
+  template <typename OutputIt>
+  std::size_t tryPopBatch(OutputIt out, std::size_t maxItems)
+  {
+    std::size_t count = 0;
+    T poppedItem;
+    for (; count < maxItems && _tryPop(poppedItem); ++count) {
+      *out++ = std::move(poppedItem);
+    }
+    if (count > 0) {
+      _notify(_waitingProducers, _notFull);
+    }
+    return count;
+  }
+
+  /**
+   * @brief Waits till at least one item is available and retrieves up to
+   * maxItems items.
+   * @return the number of items written to the output iterator
+   */
+  template <typename OutputIt>
+  std::size_t waitAndPopBatch(OutputIt out, std::size_t maxItems)
+  {
+    if (maxItems == 0) {
+      return 0;
+    }
+    T poppedItem;
+    waitAndPop(poppedItem);
+    *out++ = std::move(poppedItem);
+    return 1 + tryPopBatch(out, maxItems - 1);
+  }
+
+  // The result is only a snapshot when other threads access the queue
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  // The result is only a snapshot when other threads access the queue
+  std::size_t size() const
+  {
+    const auto dequeuePos = _dequeuePos.load(std::memory_order_acquire);
+    const auto enqueuePos = _enqueuePos.load(std::memory_order_acquire);
+    return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+  }
+
+  std::size_t capacity() const
+  {
+    return _mask + 1;
+  }
+
+private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T data;
+  }; // end of struct Cell
+
+  static constexpr std::size_t CacheLineSize = 64;
+  static constexpr unsigned int SpinCount    = 64;
+
+  using CacheLinePad = char[CacheLineSize];
+
+  static std::size_t _roundUpToPowerOfTwo(std::size_t value)
+  {
+    std::size_t result = 2;
+    while (result < value) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  bool _tryPush(T& item)
+  {
+    Cell* cell = nullptr;
+    auto pos   = _enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell          = &_cells[pos & _mask];
+      auto sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff     = static_cast<std::intptr_t>(sequence)
+                  - static_cast<std::intptr_t>(pos);
+      if (diff == 0) {
+        if (_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      else if (diff < 0) {
+        // Full
+        return false;
+      }
+      else {
+        pos = _enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = std::move(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool _tryPop(T& poppedItem)
+  {
+    Cell* cell = nullptr;
+    auto pos   = _dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      cell          = &_cells[pos & _mask];
+      auto sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff     = static_cast<std::intptr_t>(sequence)
+                  - static_cast<std::intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      else if (diff < 0) {
+        // Empty
+        return false;
+      }
+      else {
+        pos = _dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    poppedItem = std::move(cell->data);
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Spins on the operation for a while and then sleeps till another thread
+   * signals progress. The waiter is registered before the last attempt, so
+   * _notify() either sees it or the attempt sees the other thread's change.
+   */
+  template <typename Operation>
+  void _wait(std::atomic<unsigned int>& waiters,
+             std::condition_variable& condition, Operation&& operation)
+  {
+    for (unsigned int i = 0; i < SpinCount; ++i) {
+      if (operation()) {
+        return;
+      }
+      std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!operation()) {
+      condition.wait(lock);
+    }
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void _notify(std::atomic<unsigned int>& waiters,
+               std::condition_variable& condition)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) > 0) {
+      { // Synchronize with a waiter between its last attempt and its sleep
+        std::lock_guard<std::mutex> lock(_mutex);
+      }
+      condition.notify_all();
+    }
+  }
+
+private:
+  CacheLinePad _pad0;
+  const std::size_t _mask;
+  const std::unique_ptr<Cell[]> _cells;
+  CacheLinePad _pad1;
+  std::atomic<std::size_t> _enqueuePos;
+  CacheLinePad _pad2;
+  std::atomic<std::size_t> _dequeuePos;
+  CacheLinePad _pad3;
+  std::atomic<unsigned int> _waitingProducers;
+  std::atomic<unsigned int> _waitingConsumers;
+  std::mutex _mutex;
+  std::condition_variable _notFull;
+  std::condition_variable _notEmpty;
+
+}; // end of class BoundedQueue
+
+template <typename T>
+constexpr std::size_t BoundedQueue<T>::DefaultCapacity;
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_CORE_BOUNDED_QUEUE_H
@@ -4,6 +4,7 @@
 #include <babylon/babylon_global.h>
 #include <babylon/core/active.h>
 #include <babylon/core/move_on_copy.h>
+#include <babylon/core/task_scheduler.h>
 
 namespace BABYLON {
 
@@ -35,6 +36,16 @@ std::future<typename std::result_of<Func()>::type> spawn_task(Func func,
   return std::move(result);
 }
 
+/**
+ * Runs the task on the task scheduler shared by the engine. The returned
+ * handle supports continuations and helps the scheduler while waiting.
+ */
+template <typename Func>
+TaskHandle<typename std::result_of<Func()>::type> spawn_task(Func&& func)
+{
+  return TaskScheduler::Instance().submit(std::forward<Func>(func));
+}
+
 } // end of namespace BABYLON
 
 #endif // end of BABYLON_CORE_DELEGATE_H
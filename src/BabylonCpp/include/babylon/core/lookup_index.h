@@ -0,0 +1,143 @@
+#ifndef BABYLON_CORE_LOOKUP_INDEX_H
+#define BABYLON_CORE_LOOKUP_INDEX_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+/**
+ * @brief Hash index from a key (id, name, unique id...) to the items having
+ * this key.
+ *
+ * Several items may share a key. The items of a key are kept in insertion
+ * order, so first() and last() return the same items as a front to back or a
+ * back to front scan of the container the items were appended to. A renamed
+ * item keeps its original position in that order.
+ */
+template <typename Key, typename T>
+class LookupIndex {
+
+public:
+  LookupIndex() : _sequence{0}
+  {
+  }
+
+  /**
+   * @brief Indexes an item appended to the indexed container.
+   */
+  void add(const Key& key, T* item)
+  {
+    _buckets[key].emplace_back(Entry{_sequence++, item});
+  }
+
+  /**
+   * @brief Removes an item from the index.
+   * @return Whether the item was indexed with this key.
+   */
+  bool remove(const Key& key, T* item)
+  {
+    Entry entry;
+    return _take(key, item, entry);
+  }
+
+  /**
+   * @brief Moves an item to another key, keeping its insertion order. Items
+   * which are not indexed with the old key are ignored.
+   */
+  void rename(const Key& oldKey, const Key& newKey, T* item)
+  {
+    Entry entry;
+    if (oldKey == newKey || !_take(oldKey, item, entry)) {
+      return;
+    }
+    auto& bucket = _buckets[newKey];
+    bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), entry,
+                                   [](const Entry& a, const Entry& b) {
+                                     return a.sequence < b.sequence;
+                                   }),
+                  entry);
+  }
+
+  /**
+   * @brief Returns the first inserted item with this key, or nullptr.
+   */
+  T* first(const Key& key) const
+  {
+    auto it = _buckets.find(key);
+    return (it == _buckets.end()) ? nullptr : it->second.front().item;
+  }
+
+  /**
+   * @brief Returns the last inserted item with this key, or nullptr.
+   */
+  T* last(const Key& key) const
+  {
+    auto it = _buckets.find(key);
+    return (it == _buckets.end()) ? nullptr : it->second.back().item;
+  }
+
+  /**
+   * @brief Returns all the items with this key, in insertion order.
+   */
+  std::vector<T*> all(const Key& key) const
+  {
+    std::vector<T*> items;
+    auto it = _buckets.find(key);
+    if (it != _buckets.end()) {
+      items.reserve(it->second.size());
+      for (const auto& entry : it->second) {
+        items.emplace_back(entry.item);
+      }
+    }
+    return items;
+  }
+
+  void clear()
+  {
+    _buckets.clear();
+  }
+
+  // Number of distinct keys
+  std::size_t size() const
+  {
+    return _buckets.size();
+  }
+
+private:
+  struct Entry {
+    std::size_t sequence;
+    T* item;
+  }; // end of struct Entry
+
+  bool _take(const Key& key, T* item, Entry& entry)
+  {
+    auto it = _buckets.find(key);
+    if (it == _buckets.end()) {
+      return false;
+    }
+    auto& bucket = it->second;
+    auto entryIt = std::find_if(bucket.begin(), bucket.end(),
+                                [item](const Entry& candidate) {
+                                  return candidate.item == item;
+                                });
+    if (entryIt == bucket.end()) {
+      return false;
+    }
+    entry = *entryIt;
+    bucket.erase(entryIt);
+    // Empty buckets are dropped, first() and last() rely on it
+    if (bucket.empty()) {
+      _buckets.erase(it);
+    }
+    return true;
+  }
+
+private:
+  std::unordered_map<Key, std::vector<Entry>> _buckets;
+  std::size_t _sequence;
+
+}; // end of class LookupIndex
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_CORE_LOOKUP_INDEX_H
@@ -0,0 +1,427 @@
+#ifndef BABYLON_CORE_TASK_SCHEDULER_H
+#define BABYLON_CORE_TASK_SCHEDULER_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+class TaskScheduler;
+template <typename T>
+class TaskHandle;
+
+/**
+ * @brief Per worker counters of a TaskScheduler, accumulated since the last
+ * call to TaskScheduler::resetStatistics().
+ */
+struct BABYLON_SHARED_EXPORT TaskSchedulerStatistics {
+  std::size_t executedTasks = 0;
+  // Tasks taken from the queue of another worker
+  std::size_t stolenTasks = 0;
+  std::chrono::nanoseconds busyTime{0};
+  std::chrono::nanoseconds elapsedTime{0};
+
+  // Fraction of the elapsed time spent executing tasks, in the range [0, 1]
+  float utilization() const
+  {
+    return elapsedTime.count() > 0 ?
+             static_cast<float>(busyTime.count())
+               / static_cast<float>(elapsedTime.count()) :
+             0.f;
+  }
+}; // end of struct TaskSchedulerStatistics
+
+/**
+ * @brief Shared state of a task: the packaged callable, its result and the
+ * continuations to schedule once it has run.
+ */
+template <typename T>
+struct _TaskState {
+  std::packaged_task<T()> task;
+  std::shared_future<T> future;
+  TaskScheduler* scheduler;
+  // Set by the thread running the task, a worker or a thread waiting for it
+  std::atomic<bool> claimed{false};
+  // Waits for the task this one is a continuation of
+  std::function<void()> waitDependency;
+  std::mutex mutex;
+  bool done = false;
+  std::vector<std::function<void()>> continuations;
+
+  template <typename Func>
+  _TaskState(Func&& func, TaskScheduler* iScheduler)
+      : task{std::forward<Func>(func)}
+      , future{task.get_future().share()}
+      , scheduler{iScheduler}
+  {
+  }
+
+  // Returns false when the task was claimed by another thread
+  bool run();
+  void addContinuation(std::function<void()> continuation);
+}; // end of struct _TaskState
+
+/**
+ * @brief Work-stealing thread pool shared by the engine subsystems.
+ *
+ * Every worker owns a double ended queue of tasks. A worker pushes and pops
+ * the tasks it spawns at the back of its own queue, and steals from the front
+ * of the other queues when it runs out of work. Tasks sent from threads which
+ * are not workers of the scheduler go through a shared injection queue. Idle
+ * workers sleep until a task is sent.
+ *
+ * The send() method makes the scheduler usable as a background worker for
+ * spawn_task() (see core/future.h), in place of an Active object.
+ *
+ * A thread waiting for a task or a parallelFor only runs the work it waits
+ * for. The scene evaluates the active meshes and skins meshes on the CPU with
+ * parallelFor, the collision worker, the mesh optimizer and the simplification
+ * queue submit their tasks to it.
+ */
+class BABYLON_SHARED_EXPORT TaskScheduler {
+
+public:
+  using Callback = std::function<void()>;
+
+public:
+  /**
+   * @brief Returns the scheduler shared by the engine, which is created with
+   * DefaultWorkerCount() workers on first use.
+   */
+  static TaskScheduler& Instance();
+
+  /**
+   * @brief Returns the number of hardware threads minus one (the render
+   * thread), with a minimum of one worker.
+   */
+  static std::size_t DefaultWorkerCount();
+
+  TaskScheduler(std::size_t workerCount = DefaultWorkerCount());
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+  /**
+   * @brief Runs the pending tasks and joins the worker threads.
+   */
+  ~TaskScheduler();
+
+  /**
+   * @brief Queues a task without any handle on its completion.
+   */
+  void send(Callback task);
+
+  /**
+   * @brief Queues a task and returns a handle on its result.
+   */
+  template <typename Func>
+  TaskHandle<typename std::result_of<Func()>::type> submit(Func&& func)
+  {
+    using result_type = typename std::result_of<Func()>::type;
+    auto state        = std::make_shared<_TaskState<result_type>>(
+      std::forward<Func>(func), this);
+    send([state]() { state->run(); });
+    return TaskHandle<result_type>(std::move(state));
+  }
+
+  /**
+   * @brief Splits the range [begin, end) in chunks of grainSize indices and
+   * calls func(chunkBegin, chunkEnd) for each chunk, on the workers and on the
+   * calling thread. Returns once all the chunks are processed. When grainSize
+   * is 0, the range is split in about four chunks per thread.
+   *
+   * The calling thread claims chunks as the workers do, so parallelFor can be
+   * nested in tasks without starving the workers, and waits for the chunks
+   * claimed by the workers without running other tasks: a frame never stalls
+   * on a long task sent by another subsystem. The first exception thrown by
+   * func is rethrown on the calling thread.
+   */
+  template <typename Func>
+  void parallelFor(std::size_t begin, std::size_t end, Func&& func,
+                   std::size_t grainSize = 0);
+
+  /**
+   * @brief Executes one pending task on the calling thread, if any. Waiting
+   * threads do not call it, so as not to run unrelated long tasks.
+   * @return Whether a task was executed.
+   */
+  bool runPendingTask();
+
+  /**
+   * @brief Returns whether the calling thread is a worker of this scheduler.
+   */
+  bool isWorkerThread() const;
+
+  std::size_t workerCount() const;
+
+  /**
+   * @brief Returns the counters of every worker.
+   */
+  std::vector<TaskSchedulerStatistics> statistics() const;
+  void resetStatistics();
+
+private:
+  struct Worker;
+  struct ParallelForState;
+
+  void _run(std::size_t workerIndex);
+  bool _popTask(Callback& task, bool& stolen);
+  void _execute(Callback& task, Worker* worker, bool stolen);
+
+private:
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::mutex _injectedTasksMutex;
+  std::deque<Callback> _injectedTasks;
+  // Number of queued tasks that are not taken by a thread yet
+  std::atomic<std::size_t> _pendingTasks;
+  std::atomic<std::size_t> _sleepingWorkers;
+  std::mutex _sleepMutex;
+  std::condition_variable _wakeUp;
+  bool _done;
+  std::atomic<std::int64_t> _statisticsStart;
+
+}; // end of class TaskScheduler
+
+/**
+ * @brief Handle on a task submitted to a TaskScheduler.
+ */
+template <typename T>
+class TaskHandle {
+
+public:
+  TaskHandle() = default;
+  explicit TaskHandle(std::shared_ptr<_TaskState<T>> state)
+      : _state{std::move(state)}
+  {
+  }
+
+  bool valid() const
+  {
+    return _state != nullptr;
+  }
+
+  bool isReady() const
+  {
+    return _state->future.wait_for(std::chrono::seconds(0))
+           == std::future_status::ready;
+  }
+
+  /**
+   * @brief Waits for the task to complete. The task is run on the calling
+   * thread when no worker has started it yet, other pending tasks of the
+   * scheduler are not.
+   */
+  void wait() const
+  {
+    if (isReady()) {
+      return;
+    }
+    if (_state->waitDependency) {
+      _state->waitDependency();
+    }
+    if (!_state->run()) {
+      _state->future.wait();
+    }
+  }
+
+  /**
+   * @brief Waits for the task and returns its result, or rethrows the
+   * exception thrown by the task.
+   */
+  decltype(auto) get() const
+  {
+    wait();
+    return _state->future.get();
+  }
+
+  std::shared_future<T> future() const
+  {
+    return _state->future;
+  }
+
+  /**
+   * @brief Schedules func(future) once this task has completed, where future
+   * is the std::shared_future holding the result of this task.
+   */
+  template <typename Func>
+  TaskHandle<typename std::result_of<Func(std::shared_future<T>)>::type>
+  then(Func&& func) const
+  {
+    using result_type =
+      typename std::result_of<Func(std::shared_future<T>)>::type;
+    auto future       = _state->future;
+    auto continuation = std::make_shared<_TaskState<result_type>>(
+      std::bind(std::forward<Func>(func), std::move(future)),
+      _state->scheduler);
+    auto state                   = _state;
+    continuation->waitDependency = [state]() { TaskHandle<T>(state).wait(); };
+    _state->addContinuation([continuation]() { continuation->run(); });
+    return TaskHandle<result_type>(std::move(continuation));
+  }
+
+private:
+  std::shared_ptr<_TaskState<T>> _state;
+
+}; // end of class TaskHandle
+
+/**
+ * @brief Runs the tasks sent to it one at a time and in order, on a
+ * TaskScheduler. Replaces a dedicated thread for a subsystem which owns state
+ * that must not be accessed concurrently.
+ */
+class BABYLON_SHARED_EXPORT SerialTaskQueue {
+
+public:
+  using Callback = std::function<void()>;
+
+public:
+  SerialTaskQueue(TaskScheduler& scheduler = TaskScheduler::Instance());
+  SerialTaskQueue(const SerialTaskQueue&) = delete;
+  SerialTaskQueue& operator=(const SerialTaskQueue&) = delete;
+  /**
+   * @brief Waits for the pending tasks.
+   */
+  ~SerialTaskQueue();
+
+  void send(Callback task);
+
+  /**
+   * @brief Waits till all the tasks sent so far have run. When no worker has
+   * started them yet, they are run on the calling thread.
+   */
+  void wait();
+
+private:
+  // Shared with the drain tasks, which may run after the queue is destroyed
+  // when the queue was drained by a waiting thread
+  struct State {
+    std::mutex mutex;
+    std::condition_variable idle;
+    std::deque<Callback> tasks;
+    // A drain is scheduled or in progress
+    bool running = false;
+    // A thread is running the tasks
+    bool draining = false;
+  }; // end of struct State
+
+  static void _Drain(State& state);
+
+private:
+  TaskScheduler& _scheduler;
+  std::shared_ptr<State> _state;
+
+}; // end of class SerialTaskQueue
+
+template <typename T>
+bool _TaskState<T>::run()
+{
+  if (claimed.exchange(true)) {
+    return false;
+  }
+  task();
+  std::vector<std::function<void()>> pendingContinuations;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+    pendingContinuations.swap(continuations);
+  }
+  for (auto& continuation : pendingContinuations) {
+    scheduler->send(std::move(continuation));
+  }
+  return true;
+}
+
+template <typename T>
+void _TaskState<T>::addContinuation(std::function<void()> continuation)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!done) {
+      continuations.emplace_back(std::move(continuation));
+      return;
+    }
+  }
+  scheduler->send(std::move(continuation));
+}
+
+struct TaskScheduler::ParallelForState {
+  std::size_t begin;
+  std::size_t end;
+  std::size_t grainSize;
+  std::size_t chunkCount;
+  std::atomic<std::size_t> nextChunk{0};
+  std::atomic<std::size_t> remainingChunks;
+  std::mutex exceptionMutex;
+  std::exception_ptr exception;
+
+  ParallelForState(std::size_t iBegin, std::size_t iEnd,
+                   std::size_t iGrainSize, std::size_t iChunkCount)
+      : begin{iBegin}
+      , end{iEnd}
+      , grainSize{iGrainSize}
+      , chunkCount{iChunkCount}
+      , remainingChunks{iChunkCount}
+  {
+  }
+
+  // Processes chunks till none is left
+  template <typename Func>
+  void run(Func& func)
+  {
+    for (auto chunk = nextChunk++; chunk < chunkCount; chunk = nextChunk++) {
+      const auto chunkBegin = begin + chunk * grainSize;
+      const auto chunkEnd   = std::min(chunkBegin + grainSize, end);
+      try {
+        func(chunkBegin, chunkEnd);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+      --remainingChunks;
+    }
+  }
+}; // end of struct ParallelForState
+
+template <typename Func>
+void TaskScheduler::parallelFor(std::size_t begin, std::size_t end,
+                                Func&& func, std::size_t grainSize)
+{
+  if (begin >= end) {
+    return;
+  }
+
+  const auto count = end - begin;
+  if (grainSize == 0) {
+    grainSize = std::max<std::size_t>(1, count / ((_workers.size() + 1) * 4));
+  }
+  const auto chunkCount = (count + grainSize - 1) / grainSize;
+  if (chunkCount == 1 || _workers.empty()) {
+    func(begin, end);
+    return;
+  }
+
+  // The helpers only dereference func after claiming a chunk, which cannot
+  // happen once parallelFor has returned
+  auto state = std::make_shared<ParallelForState>(begin, end, grainSize,
+                                                  chunkCount);
+  auto funcPtr = &func;
+  const auto helperCount = std::min(_workers.size(), chunkCount - 1);
+  for (std::size_t i = 0; i < helperCount; ++i) {
+    send([state, funcPtr]() { state->run(*funcPtr); });
+  }
+
+  // Once the calling thread finds no chunk left, the remaining ones are being
+  // processed by helpers, which it waits for without running other tasks
+  state->run(func);
+  while (state->remainingChunks.load() > 0) {
+    std::this_thread::yield();
+  }
+
+  if (state->exception) {
+    std::rethrow_exception(state->exception);
+  }
+}
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_CORE_TASK_SCHEDULER_H
@@ -11,9 +11,12 @@ namespace BABYLON {
 
 class BABYLON_SHARED_EXPORT BoundingInfo : public ICullable {
 
+  friend class BoundingVolumeArrays;
+
 public:
   BoundingInfo(const Vector3& minimum, const Vector3& maximum);
   BoundingInfo(const BoundingInfo& boundingInfo);
+  BoundingInfo& operator=(const BoundingInfo& other);
   virtual ~BoundingInfo();
 
   /** Methods **/
@@ -41,6 +44,9 @@ public:
 
 private:
   bool _isLocked;
+  // Structure of arrays mirroring the world bounding volumes, if any
+  BoundingVolumeArrays* _volumes;
+  std::size_t _volumesIndex;
 
 }; // end of class BoundingInfo
 
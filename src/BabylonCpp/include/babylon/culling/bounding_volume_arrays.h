@@ -0,0 +1,113 @@
+#ifndef BABYLON_CULLING_BOUNDING_VOLUME_ARRAYS_H
+#define BABYLON_CULLING_BOUNDING_VOLUME_ARRAYS_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+/**
+ * @brief Structure of arrays holding the world space bounding spheres and
+ * oriented bounding boxes of a set of objects, culled against a frustum 4
+ * objects at a time.
+ *
+ * An object mirrors the world bounding volumes of the BoundingInfo attached to
+ * it, which are copied again each time BoundingInfo::update() is called, so
+ * that the volumes are only gathered when they change. Objects without
+ * BoundingInfo are culled.
+ *
+ * The result of the culling is a visibility bitmask, the bit i % 32 of the word
+ * i / 32 being set when the object i is visible. The flags of the objects of
+ * distinct words can be set and culled concurrently.
+ */
+class BABYLON_SHARED_EXPORT BoundingVolumeArrays {
+
+public:
+  static constexpr std::size_t ObjectsPerWord = 32;
+
+  BoundingVolumeArrays();
+  BoundingVolumeArrays(const BoundingVolumeArrays& other) = delete;
+  BoundingVolumeArrays& operator=(const BoundingVolumeArrays& other) = delete;
+  ~BoundingVolumeArrays();
+
+  /**
+   * @brief Sets the number of objects, the remaining objects keep their
+   * bounding volumes and flags.
+   */
+  void resize(std::size_t count);
+  std::size_t size() const;
+
+  /**
+   * @brief Returns the number of words of the visibility bitmask.
+   */
+  std::size_t wordCount() const;
+
+  /**
+   * @brief Mirrors the world bounding volumes of a BoundingInfo into an object,
+   * detaching it from its previous object. Nothing is copied when it is
+   * already attached to this object.
+   */
+  void attach(std::size_t index, BoundingInfo& boundingInfo);
+  void detach(std::size_t index);
+
+  /**
+   * @brief Flags an object as visible whatever the frustum.
+   */
+  void setAlwaysVisible(std::size_t index, bool value);
+
+  /**
+   * @brief Flags an object as not visible whatever the frustum.
+   */
+  void setCulled(std::size_t index, bool value);
+
+  /**
+   * @brief Culls all the objects, the visibility bitmask is resized to
+   * wordCount().
+   */
+  void cull(const std::array<Plane, 6>& frustumPlanes,
+            Uint32Array& visibility) const;
+
+  /**
+   * @brief Culls the objects of the words [startWord, endWord) of the
+   * visibility bitmask, with the tests of BoundingInfo::isInFrustum().
+   */
+  void cull(const std::array<Plane, 6>& frustumPlanes, std::size_t startWord,
+            std::size_t endWord, std::uint32_t* visibility) const;
+
+  /**
+   * @brief Copies the world bounding volumes of the BoundingInfo attached to an
+   * object, called by BoundingInfo::update().
+   */
+  void _update(std::size_t index, const BoundingInfo& boundingInfo);
+
+  static bool IsVisible(const Uint32Array& visibility, std::size_t index)
+  {
+    return (visibility[index / ObjectsPerWord]
+            & (1u << (index % ObjectsPerWord)))
+           != 0;
+  }
+
+private:
+  static void _setBit(Uint32Array& bits, std::size_t index, bool value);
+
+private:
+  std::size_t _count;
+  std::vector<BoundingInfo*> _boundingInfos;
+  // Bounding spheres
+  Float32Array _sphereX;
+  Float32Array _sphereY;
+  Float32Array _sphereZ;
+  Float32Array _sphereRadius;
+  // Bounding boxes, center and half axes
+  Float32Array _boxX;
+  Float32Array _boxY;
+  Float32Array _boxZ;
+  std::array<Float32Array, 9> _boxAxes;
+  // Flags
+  Uint32Array _alwaysVisible;
+  Uint32Array _culled;
+
+}; // end of class BoundingVolumeArrays
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_CULLING_BOUNDING_VOLUME_ARRAYS_H
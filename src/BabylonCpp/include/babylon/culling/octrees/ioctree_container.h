@@ -7,12 +7,11 @@ namespace BABYLON {
 
 template <class T>
 struct BABYLON_SHARED_EXPORT IOctreeContainer {
-  static std::vector<OctreeBlock<T>> blocks;
+  // Blocks of the octree in breadth first order, the 8 inner blocks of a block
+  // being stored next to each other
+  std::vector<OctreeBlock<T>> blocks;
 }; // end of struct IOctreeContainer
 
-template <class T>
-std::vector<OctreeBlock<T>> IOctreeContainer<T>::blocks;
-
 } // end of namespace BABYLON
 
 #endif // end of BABYLON_CULLING_OCTREES_IOCTREE_CONTAINER_H
@@ -3,22 +3,45 @@
 
 #include <babylon/babylon_global.h>
 #include <babylon/culling/octrees/ioctree_container.h>
+#include <babylon/culling/octrees/octree_block.h>
 
 namespace BABYLON {
 
+/**
+ * @brief Octree of entries selected by their world axis aligned bounding box.
+ *
+ * The blocks are stored in a flat array in breadth first order and the entries
+ * of the leaves in a single array of entry indices. The tree is built one level
+ * at a time, the entries of every level being distributed to the 8 inner
+ * blocks of their block on the task scheduler. An entry intersecting several
+ * leaves is stored in each of them, the queries without duplicates marking the
+ * selected entries in a bitset.
+ */
 template <class T>
 class BABYLON_SHARED_EXPORT Octree : public IOctreeContainer<T> {
 
+public:
+  /**
+   * @brief Writes the world bounding box of an entry, returns false when the
+   * entry must not be stored in the octree. It is called on the calling thread
+   * of update() and addMesh().
+   */
+  using BoundsFunc
+    = std::function<bool(const T& entry, Vector3& minimum, Vector3& maximum)>;
+
 public:
   Octree();
-  Octree(
-    const std::function<void(T& entry, OctreeBlock<T>& block)>& creationFunc,
-    size_t maxBlockCapacity = 64, size_t maxDepth = 2);
+  Octree(const BoundsFunc& boundsFunc, size_t maxBlockCapacity = 64,
+         size_t maxDepth = 2);
   ~Octree();
 
   /** Methods **/
   void update(const Vector3& worldMin, const Vector3& worldMax,
               std::vector<T>& entries);
+  /**
+   * @brief Adds an entry to the leaves it intersects, the leaves are only
+   * subdivided on the next update.
+   */
   void addMesh(T& entry);
   std::vector<T>& select(const std::array<Plane, 6>& frustumPlanes,
                          bool allowDuplicate = true);
@@ -26,25 +49,69 @@ public:
                              bool allowDuplicate = true);
   std::vector<T>& intersectsRay(const Ray& ray);
 
+  /**
+   * @brief Batched versions of the queries, run in parallel on the task
+   * scheduler. The selection of the i-th query is written to selections[i].
+   */
+  void select(const std::vector<std::array<Plane, 6>>& frustums,
+              std::vector<std::vector<T>>& selections,
+              bool allowDuplicate = true);
+  void intersects(const std::vector<Vector3>& sphereCenters,
+                  const Float32Array& sphereRadii,
+                  std::vector<std::vector<T>>& selections,
+                  bool allowDuplicate = true);
+  void intersectsRay(const std::vector<Ray>& rays,
+                     std::vector<std::vector<T>>& selections);
+
+  /**
+   * @brief Returns the entries stored in the octree by the last update.
+   */
+  const std::vector<T>& entries() const;
+  /**
+   * @brief Returns the indices in entries() of the entries of the leaves.
+   */
+  const std::vector<uint32_t>& blockEntries() const;
+
   /** Statics **/
-  static void _CreateBlocks(
-    const Vector3& worldMin, const Vector3& worldMax, std::vector<T>& entries,
-    size_t maxBlockCapacity, size_t currentDepth, size_t maxDepth,
-    IOctreeContainer<T>& target,
-    std::function<void(T& entry, OctreeBlock<T>& block)>& creationFunc);
-  static void CreationFuncForMeshes(AbstractMesh* entry,
-                                    OctreeBlock<AbstractMesh*>& block);
-  static void CreationFuncForSubMeshes(SubMesh* entry,
-                                       OctreeBlock<SubMesh*>& block);
+  static void _CreateBlocks(const Vector3& worldMin, const Vector3& worldMax,
+                            size_t depth, IOctreeContainer<T>& target);
+  static bool BoundsFuncForMeshes(AbstractMesh* entry, Vector3& minimum,
+                                  Vector3& maximum);
+  static bool BoundsFuncForSubMeshes(SubMesh* entry, Vector3& minimum,
+                                     Vector3& maximum);
 
 public:
   std::vector<T> dynamicContent;
 
+private:
+  // Query scratch data, one per thread
+  struct Selection {
+    std::vector<uint32_t> indices;
+    // One bit per entry, cleared after each query
+    std::vector<uint64_t> marks;
+  }; // end of struct Selection
+
+  void _distributeEntries(std::vector<size_t>& groups,
+                          std::vector<uint32_t>& levelEntries,
+                          std::vector<size_t>& levelStarts);
+  void _addToLeaves(size_t blockIndex, uint32_t entryIndex);
+  template <typename BlockTest>
+  void _collect(size_t blockIndex, const BlockTest& blockTest,
+                Selection& selection, bool allowDuplicate) const;
+  template <typename BlockTest>
+  void _query(const BlockTest& blockTest, Selection& selection,
+              std::vector<T>& result, bool allowDuplicate) const;
+
 private:
   size_t _maxBlockCapacity;
   size_t _maxDepth;
+  BoundsFunc _boundsFunc;
+  std::vector<T> _entries;
+  std::vector<Vector3> _entriesMin;
+  std::vector<Vector3> _entriesMax;
+  std::vector<uint32_t> _blockEntries;
+  Selection _selection;
   std::vector<T> _selectionContent;
-  std::function<void(T&, OctreeBlock<T>&)> _creationFunc;
 
 }; // end of class Octree
 
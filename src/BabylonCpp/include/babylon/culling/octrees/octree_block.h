@@ -2,46 +2,48 @@
 #define BABYLON_CULLING_OCTREES_OCTREE_BLOCK_H
 
 #include <babylon/babylon_global.h>
-#include <babylon/culling/octrees/ioctree_container.h>
 #include <babylon/math/vector3.h>
 
 namespace BABYLON {
 
+/**
+ * @brief Block of an Octree. Blocks do not own any entry nor any other block,
+ * they refer to the inner blocks and to the entries of the octree by index.
+ */
 template <class T>
-class BABYLON_SHARED_EXPORT OctreeBlock : public IOctreeContainer<T> {
+class BABYLON_SHARED_EXPORT OctreeBlock {
 
 public:
-  OctreeBlock(const Vector3& minPoint, const Vector3& maxPoint, size_t capacity,
-              size_t depth, size_t maxDepth,
-              const std::function<void(T&, OctreeBlock<T>&)>& creationFunc);
+  OctreeBlock(const Vector3& minPoint, const Vector3& maxPoint, size_t depth);
   ~OctreeBlock();
 
   /** Properties **/
-  size_t capacity() const;
-  Vector3& minPoint();
-  Vector3& maxPoint();
-
-  /** Methods **/
-  void addEntry(T& entry);
-  void addEntries(std::vector<T>& entries);
-  void select(const std::array<Plane, 6>& frustumPlanes,
-              std::vector<T>& selection, bool allowDuplicate = true);
-  void intersects(const Vector3& sphereCenter, float sphereRadius,
-                  std::vector<T>& selection, bool allowDuplicate = true);
-  void intersectsRay(const Ray& ray, std::vector<T>& selection);
-  void createInnerBlocks();
-
-public:
-  std::vector<T> entries;
+  const Vector3& minPoint() const;
+  const Vector3& maxPoint() const;
+  size_t depth() const;
+  bool isLeaf() const;
+  /**
+   * @brief Returns the index of the first of the 8 inner blocks in the blocks
+   * of the octree.
+   */
+  size_t firstBlock() const;
+  /**
+   * @brief Returns the range of the entries of a leaf in the block entries of
+   * the octree.
+   */
+  size_t entriesStart() const;
+  size_t entriesCount() const;
 
 private:
-  size_t _depth;
-  size_t _maxDepth;
-  size_t _capacity;
+  friend class Octree<T>;
+
   Vector3 _minPoint;
   Vector3 _maxPoint;
-  std::vector<Vector3> _boundingVectors;
-  std::function<void(T&, OctreeBlock<T>&)> _creationFunc;
+  size_t _depth;
+  // 0 for a leaf, as the blocks of the first level come first
+  size_t _firstBlock;
+  size_t _entriesStart;
+  size_t _entriesCount;
 
 }; // end of class OctreeBlock
 
@@ -314,6 +314,20 @@ public:
                                         const std::string& fragmentCode,
                                         const std::string& defines,
                                         GL::IGLRenderingContext* gl = nullptr);
+
+  /**
+   * @brief Enables the on-disk cache of the linked shader programs: the
+   * programs are stored as binaries in the given directory and loaded back
+   * instead of being compiled by later runs with the same driver.
+   * @param directory The cache directory, created if needed.
+   */
+  void enableShaderProgramCache(const std::string& directory);
+  void disableShaderProgramCache();
+
+  /**
+   * @brief Returns the shader program cache, nullptr when it is disabled.
+   */
+  ShaderProgramCache* getShaderProgramCache();
   std::unordered_map<std::string, GLUniformLocationPtr>
   getUniforms(GL::IGLProgram* shaderProgram,
               const std::vector<std::string>& uniformsNames);
@@ -620,6 +634,7 @@ private:
   Effect* _currentEffect;
   GL::IGLProgram* _currentProgram;
   std::unordered_map<std::string, std::unique_ptr<Effect>> _compiledEffects;
+  std::unique_ptr<ShaderProgramCache> _shaderProgramCache;
   std::vector<bool> _vertexAttribArraysEnabled;
   Viewport* _cachedViewport;
   GL::IGLVertexArrayObject* _cachedVertexArrayObject;
@@ -0,0 +1,42 @@
+#ifndef BABYLON_ENGINE_HEADLESS_CANVAS_H
+#define BABYLON_ENGINE_HEADLESS_CANVAS_H
+
+#include <babylon/babylon_global.h>
+#include <babylon/interfaces/icanvas.h>
+
+namespace BABYLON {
+
+namespace GL {
+class RecordingGLRenderingContext;
+} // end of namespace GL
+
+/**
+ * @brief Window-less canvas backed by a recording GL rendering context.
+ *
+ * Lets an Engine and its scenes run without a GPU, e.g. for benchmarks and
+ * tests. The GL calls issued by the engine can be inspected through
+ * recordingContext().
+ */
+class BABYLON_SHARED_EXPORT HeadlessCanvas : public ICanvas {
+
+public:
+  HeadlessCanvas(int width = 1024, int height = 768);
+  ~HeadlessCanvas();
+
+  ClientRect& getBoundingClientRect() override;
+  bool onlyRenderBoundingClientRect() const override;
+  bool initializeContext3d() override;
+  ICanvasRenderingContext2D* getContext2d() override;
+  GL::IGLRenderingContext* getContext3d(const EngineOptions& options) override;
+
+  /**
+   * @brief Returns the recording GL rendering context of the canvas, created
+   * on first use.
+   */
+  GL::RecordingGLRenderingContext* recordingContext();
+
+}; // end of class HeadlessCanvas
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_ENGINE_HEADLESS_CANVAS_H
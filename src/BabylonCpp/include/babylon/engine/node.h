@@ -28,6 +28,13 @@ public:
 
   virtual IReflect::Type type() const override;
   void setParent(Node* parent);
+  /**
+   * Renames the node. Use these methods rather than assigning the fields once
+   * the node is added to the scene, so that the scene lookups by id and by
+   * name stay consistent.
+   */
+  void setId(const std::string& newId);
+  void setName(const std::string& newName);
   virtual const char* getClassName() const;
   Node* parent() const override;
   void setOnDispose(const std::function<void()>& callback);
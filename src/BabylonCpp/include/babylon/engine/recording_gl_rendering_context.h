@@ -0,0 +1,528 @@
+#ifndef BABYLON_ENGINE_RECORDING_GL_RENDERING_CONTEXT_H
+#define BABYLON_ENGINE_RECORDING_GL_RENDERING_CONTEXT_H
+
+#include <babylon/babylon_global.h>
+#include <babylon/interfaces/igl_rendering_context.h>
+
+namespace BABYLON {
+namespace GL {
+
+/**
+ * @brief Identifies the GL call a recorded command originates from.
+ */
+enum class GLCommandType : std::uint8_t {
+  BACKUP_GL_STATE,
+  RESTORE_GL_STATE,
+  ACTIVE_TEXTURE,
+  ATTACH_SHADER,
+  BIND_ATTRIB_LOCATION,
+  BIND_BUFFER,
+  BIND_FRAMEBUFFER,
+  BIND_BUFFER_BASE,
+  BIND_RENDERBUFFER,
+  BIND_TEXTURE,
+  BLEND_COLOR,
+  BLEND_EQUATION,
+  BLEND_EQUATION_SEPARATE,
+  BLEND_FUNC,
+  BLEND_FUNC_SEPARATE,
+  BLIT_FRAMEBUFFER,
+  BUFFER_DATA,
+  BUFFER_SUB_DATA,
+  BIND_VERTEX_ARRAY,
+  CHECK_FRAMEBUFFER_STATUS,
+  CLEAR,
+  CLEAR_COLOR,
+  CLEAR_DEPTH,
+  CLEAR_STENCIL,
+  COLOR_MASK,
+  COMPILE_SHADER,
+  COMPRESSED_TEX_IMAGE_2D,
+  COMPRESSED_TEX_SUB_IMAGE_2D,
+  COPY_TEX_IMAGE_2D,
+  COPY_TEX_SUB_IMAGE_2D,
+  CREATE_BUFFER,
+  CREATE_FRAMEBUFFER,
+  CREATE_PROGRAM,
+  CREATE_RENDERBUFFER,
+  CREATE_SHADER,
+  CREATE_TEXTURE,
+  CREATE_VERTEX_ARRAY,
+  CULL_FACE,
+  DELETE_BUFFER,
+  DELETE_FRAMEBUFFER,
+  DELETE_PROGRAM,
+  DELETE_RENDERBUFFER,
+  DELETE_SHADER,
+  DELETE_TEXTURE,
+  DELETE_VERTEX_ARRAY,
+  DEPTH_FUNC,
+  DEPTH_MASK,
+  DEPTH_RANGE,
+  DETACH_SHADER,
+  DISABLE,
+  DISABLE_VERTEX_ATTRIB_ARRAY,
+  DRAW_ARRAYS,
+  DRAW_ARRAYS_INSTANCED,
+  DRAW_ELEMENTS,
+  DRAW_ELEMENTS_INSTANCED,
+  ENABLE,
+  ENABLE_VERTEX_ATTRIB_ARRAY,
+  FINISH,
+  FLUSH,
+  FRAMEBUFFER_RENDERBUFFER,
+  FRAMEBUFFER_TEXTURE_2D,
+  FRONT_FACE,
+  GENERATE_MIPMAP,
+  GET_ATTACHED_SHADERS,
+  GET_ATTRIB_LOCATION,
+  HAS_EXTENSION,
+  GET_SCISSOR_BOX_PARAMETER,
+  GET_PARAMETERI,
+  GET_PARAMETERF,
+  GET_STRING,
+  GET_TEX_PARAMETERI,
+  GET_TEX_PARAMETERF,
+  GET_ERROR,
+  GET_ERROR_STRING,
+  GET_PROGRAM_BINARY,
+  GET_PROGRAM_PARAMETER,
+  GET_PROGRAM_INFO_LOG,
+  GET_RENDERBUFFER_PARAMETER,
+  GET_SHADER_INFO_LOG,
+  GET_SHADER_PARAMETER,
+  GET_SHADER_PRECISION_FORMAT,
+  GET_SHADER_SOURCE,
+  GET_UNIFORM_BLOCK_INDEX,
+  GET_UNIFORM_LOCATION,
+  HINT,
+  IS_BUFFER,
+  IS_ENABLED,
+  IS_FRAMEBUFFER,
+  IS_PROGRAM,
+  IS_RENDERBUFFER,
+  IS_SHADER,
+  IS_TEXTURE,
+  LINE_WIDTH,
+  LINK_PROGRAM,
+  PIXEL_STOREI,
+  POLYGON_OFFSET,
+  PROGRAM_BINARY,
+  PROGRAM_PARAMETERI,
+  READ_PIXELS,
+  RENDERBUFFER_STORAGE,
+  RENDERBUFFER_STORAGE_MULTISAMPLE,
+  SAMPLE_COVERAGE,
+  SCISSOR,
+  SHADER_SOURCE,
+  STENCIL_FUNC,
+  STENCIL_FUNC_SEPARATE,
+  STENCIL_MASK,
+  STENCIL_MASK_SEPARATE,
+  STENCIL_OP,
+  STENCIL_OP_SEPARATE,
+  TEX_IMAGE_2D,
+  TEX_PARAMETERF,
+  TEX_PARAMETERI,
+  TEX_SUB_IMAGE_2D,
+  UNIFORM1F,
+  UNIFORM1FV,
+  UNIFORM1I,
+  UNIFORM1IV,
+  UNIFORM2F,
+  UNIFORM2FV,
+  UNIFORM2I,
+  UNIFORM2IV,
+  UNIFORM3F,
+  UNIFORM3FV,
+  UNIFORM3I,
+  UNIFORM3IV,
+  UNIFORM4F,
+  UNIFORM4FV,
+  UNIFORM4I,
+  UNIFORM4IV,
+  UNIFORM_BLOCK_BINDING,
+  UNIFORM_MATRIX2FV,
+  UNIFORM_MATRIX3FV,
+  UNIFORM_MATRIX4FV,
+  USE_PROGRAM,
+  VALIDATE_PROGRAM,
+  VERTEX_ATTRIB1F,
+  VERTEX_ATTRIB1FV,
+  VERTEX_ATTRIB2F,
+  VERTEX_ATTRIB2FV,
+  VERTEX_ATTRIB3F,
+  VERTEX_ATTRIB3FV,
+  VERTEX_ATTRIB4F,
+  VERTEX_ATTRIB4FV,
+  VERTEX_ATTRIB_DIVISOR,
+  VERTEX_ATTRIB_POINTER,
+  VIEWPORT,
+}; // end of enum class GLCommandType
+
+/**
+ * @brief Compact record of a single GL call.
+ */
+struct BABYLON_SHARED_EXPORT GLCommand {
+  GLCommandType type;
+  // Enum, object name and integer arguments of the call, in call order. Float
+  // arguments are stored bitwise.
+  std::array<GLuint, 4> args;
+  // Element count of draw calls and byte count of uploads
+  GLsizeiptr size;
+}; // end of struct GLCommand
+
+/**
+ * @brief Counters accumulated by the recording GL rendering context.
+ */
+struct BABYLON_SHARED_EXPORT GLStatistics {
+  // Number of GL calls
+  std::size_t commands = 0;
+  // Calls reading back from the context (glGet*, glIs*, glReadPixels, ...)
+  std::size_t queries = 0;
+  std::size_t drawCalls          = 0;
+  std::size_t instancedDrawCalls = 0;
+  // Vertices or indices submitted by the draw calls
+  std::size_t drawnElements  = 0;
+  std::size_t drawnInstances = 0;
+  // Calls modifying the pipeline state (binds, enables, blend modes, ...)
+  std::size_t stateChanges = 0;
+  // State changes setting a value which is already current
+  std::size_t redundantStateChanges = 0;
+  std::size_t programChanges        = 0;
+  // Vertex and index buffer bindings
+  std::size_t bufferBindings = 0;
+  std::size_t uniformUpdates = 0;
+  std::size_t bufferUploads         = 0;
+  std::size_t textureUploads        = 0;
+  std::size_t uploadedBytes         = 0;
+  std::size_t shaderCompilations    = 0;
+  std::size_t programLinks          = 0;
+  // Programs loaded from a binary instead of being linked
+  std::size_t programBinaryLoads = 0;
+}; // end of struct GLStatistics
+
+/**
+ * @brief Headless GL rendering context recording the calls it receives.
+ *
+ * No rendering happens: objects are given unique names, shaders always compile
+ * and link, and the queries return the values of a generic GL ES 3.0 device.
+ * The binary of a linked program holds the sources of its shaders, so that
+ * program binary caches can be exercised.
+ * Every call is appended to a command log and accumulated in counters, which
+ * makes the context suited to measuring the CPU side cost of a frame and to
+ * checking the amount of GL work it issues, without a GPU.
+ */
+class BABYLON_SHARED_EXPORT RecordingGLRenderingContext
+    : public IGLRenderingContext {
+
+public:
+  // The format of the program binaries
+  static constexpr GLenum PROGRAM_BINARY_FORMAT = 0x5247;
+
+public:
+  RecordingGLRenderingContext();
+  ~RecordingGLRenderingContext();
+
+  /** Recording **/
+
+  /**
+   * @brief Returns the calls recorded since the last clearCommands().
+   */
+  const std::vector<GLCommand>& commands() const;
+
+  /**
+   * @brief Clears the command log, keeping its capacity.
+   */
+  void clearCommands();
+
+  /**
+   * @brief Enables or disables the command log. The statistics are always
+   * accumulated.
+   */
+  void setCommandRecording(bool enabled);
+  bool commandRecording() const;
+
+  /**
+   * @brief Returns the counters accumulated since the last resetStatistics().
+   */
+  const GLStatistics& statistics() const;
+  void resetStatistics();
+
+  /** IGLRenderingContext **/
+  bool initialize() override;
+  void backupGLState() override;
+  void restoreGLState() override;
+  GLenum operator[](const std::string& name) override;
+  void activeTexture(GLenum texture) override;
+  void attachShader(const std::unique_ptr<IGLProgram>& program,
+                    const std::unique_ptr<IGLShader>& shader) override;
+  void bindAttribLocation(IGLProgram* program, GLuint index,
+                          const std::string& name) override;
+  void bindBuffer(GLenum target, IGLBuffer* buffer) override;
+  void bindFramebuffer(GLenum target, IGLFramebuffer* framebuffer) override;
+  void bindBufferBase(GLenum target, GLuint index, IGLBuffer* buffer) override;
+  void bindRenderbuffer(
+    GLenum target,
+    const std::unique_ptr<IGLRenderbuffer>& renderbuffer) override;
+  void bindTexture(GLenum target, IGLTexture* texture) override;
+  void blendColor(GLclampf red, GLclampf green, GLclampf blue,
+                  GLclampf alpha) override;
+  void blendEquation(GLenum mode) override;
+  void blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) override;
+  void blendFunc(GLenum sfactor, GLenum dfactor) override;
+  void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha,
+                         GLenum dstAlpha) override;
+  void blitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1,
+                       GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1,
+                       GLbitfield mask, GLenum filter) override;
+  void bufferData(GLenum target, GLsizeiptr size, GLenum usage) override;
+  void bufferData(GLenum target, const Float32Array& data,
+                  GLenum usage) override;
+  void bufferData(GLenum target, const Int32Array& data, GLenum usage) override;
+  void bufferData(GLenum target, const Uint16Array& data,
+                  GLenum usage) override;
+  void bufferData(GLenum target, const Uint32Array& data,
+                  GLenum usage) override;
+  void bufferSubData(GLenum target, GLintptr offset,
+                     const Float32Array& data) override;
+  void bufferSubData(GLenum target, GLintptr offset, Int32Array& data) override;
+  void bindVertexArray(GL::IGLVertexArrayObject* vao) override;
+  GLenum checkFramebufferStatus(GLenum target) override;
+  void clear(GLbitfield mask) override;
+  void clearColor(GLclampf red, GLclampf green, GLclampf blue,
+                  GLclampf alpha) override;
+  void clearDepth(GLclampf depth) override;
+  void clearStencil(GLint stencil) override;
+  void colorMask(GLboolean red, GLboolean green, GLboolean blue,
+                 GLboolean alpha) override;
+  void compileShader(const std::unique_ptr<IGLShader>& shader) override;
+  void compressedTexImage2D(GLenum target, GLint level, GLenum internalformat,
+                            GLsizei width, GLsizei height, GLint border,
+                            const Uint8Array& pixels) override;
+  void compressedTexSubImage2D(GLenum target, GLint level, GLint xoffset,
+                               GLint yoffset, GLsizei width, GLsizei height,
+                               GLenum format, GLsizeiptr size) override;
+  void copyTexImage2D(GLenum target, GLint level, GLenum internalformat,
+                      GLint x, GLint y, GLsizei width, GLsizei height,
+                      GLint border) override;
+  void copyTexSubImage2D(GLenum target, GLint level, GLint xoffset,
+                         GLint yoffset, GLint x, GLint y, GLint width,
+                         GLint height) override;
+  std::unique_ptr<IGLBuffer> createBuffer() override;
+  std::unique_ptr<IGLFramebuffer> createFramebuffer() override;
+  std::unique_ptr<IGLProgram> createProgram() override;
+  std::unique_ptr<IGLRenderbuffer> createRenderbuffer() override;
+  std::unique_ptr<IGLShader> createShader(GLenum type) override;
+  std::unique_ptr<IGLTexture> createTexture() override;
+  std::unique_ptr<IGLVertexArrayObject> createVertexArray() override;
+  void cullFace(GLenum mode) override;
+  void deleteBuffer(IGLBuffer* buffer) override;
+  void deleteFramebuffer(
+    const std::unique_ptr<IGLFramebuffer>& framebuffer) override;
+  void deleteProgram(IGLProgram* program) override;
+  void deleteRenderbuffer(
+    const std::unique_ptr<IGLRenderbuffer>& renderbuffer) override;
+  void deleteShader(const std::unique_ptr<IGLShader>& shader) override;
+  void deleteTexture(IGLTexture* texture) override;
+  void deleteVertexArray(IGLVertexArrayObject* vao) override;
+  void depthFunc(GLenum func) override;
+  void depthMask(GLboolean flag) override;
+  void depthRange(GLclampf zNear, GLclampf zFar) override;
+  void detachShader(IGLProgram* program, IGLShader* shader) override;
+  void disable(GLenum cap) override;
+  void disableVertexAttribArray(GLuint index) override;
+  void drawArrays(GLenum mode, GLint first, GLint count) override;
+  void drawArraysInstanced(GLenum mode, GLint first, GLsizei count,
+                           GLsizei instanceCount) override;
+  void drawElements(GLenum mode, GLsizei count, GLenum type,
+                    GLintptr offset) override;
+  void drawElementsInstanced(GLenum mode, GLsizei count, GLenum type,
+                             GLintptr offset, GLsizei instanceCount) override;
+  void enable(GLenum cap) override;
+  void enableVertexAttribArray(GLuint index) override;
+  void finish() override;
+  void flush() override;
+  void framebufferRenderbuffer(
+    GLenum target, GLenum attachment, GLenum renderbuffertarget,
+    const std::unique_ptr<IGLRenderbuffer>& renderbuffer) override;
+  void framebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget,
+                            IGLTexture* texture, GLint level) override;
+  void frontFace(GLenum mode) override;
+  void generateMipmap(GLenum target) override;
+  std::vector<IGLShader*> getAttachedShaders(IGLProgram* program) override;
+  GLint getAttribLocation(IGLProgram* program,
+                          const std::string& name) override;
+  GLboolean hasExtension(const std::string& extension) override;
+  std::array<int, 3> getScissorBoxParameter() override;
+  GLint getParameteri(GLenum pname) override;
+  GLfloat getParameterf(GLenum pname) override;
+  std::string getString(GLenum pname) override;
+  GLint getTexParameteri(GLenum pname) override;
+  GLfloat getTexParameterf(GLenum pname) override;
+  GLenum getError() override;
+  const char* getErrorString(GLenum err) override;
+  Uint8Array getProgramBinary(IGLProgram* program,
+                              GLenum& binaryFormat) override;
+  GLint getProgramParameter(IGLProgram* program, GLenum pname) override;
+  std::string
+  getProgramInfoLog(const std::unique_ptr<IGLProgram>& program) override;
+  any getRenderbufferParameter(GLenum target, GLenum pname) override;
+  std::string
+  getShaderInfoLog(const std::unique_ptr<IGLShader>& shader) override;
+  GLint getShaderParameter(const std::unique_ptr<IGLShader>& shader,
+                           GLenum pname) override;
+  IGLShaderPrecisionFormat*
+  getShaderPrecisionFormat(GLenum shadertype, GLenum precisiontype) override;
+  std::string getShaderSource(IGLShader* shader) override;
+  GLuint getUniformBlockIndex(IGLProgram* program,
+                              const std::string& uniformBlockName) override;
+  std::unique_ptr<IGLUniformLocation>
+  getUniformLocation(IGLProgram* program, const std::string& name) override;
+  void hint(GLenum target, GLenum mode) override;
+  GLboolean isBuffer(IGLBuffer* buffer) override;
+  GLboolean isEnabled(GLenum cap) override;
+  GLboolean isFramebuffer(IGLFramebuffer* framebuffer) override;
+  GLboolean isProgram(const std::unique_ptr<IGLProgram>& program) override;
+  GLboolean isRenderbuffer(IGLRenderbuffer* renderbuffer) override;
+  GLboolean isShader(IGLShader* shader) override;
+  GLboolean isTexture(IGLTexture* texture) override;
+  void lineWidth(GLfloat width) override;
+  bool linkProgram(const std::unique_ptr<IGLProgram>& program) override;
+  void pixelStorei(GLenum pname, GLint param) override;
+  void polygonOffset(GLfloat factor, GLfloat units) override;
+  bool programBinary(IGLProgram* program, GLenum binaryFormat,
+                     const Uint8Array& binary) override;
+  void programParameteri(IGLProgram* program, GLenum pname,
+                         GLint value) override;
+  void readPixels(GLint x, GLint y, GLsizei width, GLsizei height,
+                  GLenum format, GLenum type, Uint8Array& pixels) override;
+  void renderbufferStorage(GLenum target, GLenum internalformat, GLsizei width,
+                           GLsizei height) override;
+  void renderbufferStorageMultisample(GLenum target, GLsizei samples,
+                                      GLenum internalFormat, GLsizei width,
+                                      GLsizei height) override;
+  void sampleCoverage(GLclampf value, GLboolean invert) override;
+  void scissor(GLint x, GLint y, GLsizei width, GLsizei height) override;
+  void shaderSource(const std::unique_ptr<IGLShader>& shader,
+                    const std::string& source) override;
+  void stencilFunc(GLenum func, GLint ref, GLuint mask) override;
+  void stencilFuncSeparate(GLenum face, GLenum func, GLint ref,
+                           GLuint mask) override;
+  void stencilMask(GLuint mask) override;
+  void stencilMaskSeparate(GLenum face, GLuint mask) override;
+  void stencilOp(GLenum fail, GLenum zfail, GLenum zpass) override;
+  void stencilOpSeparate(GLenum face, GLenum fail, GLenum zfail,
+                         GLenum zpass) override;
+  void texImage2D(GLenum target, GLint level, GLint internalformat,
+                  GLsizei width, GLsizei height, GLint border, GLenum format,
+                  GLenum type, const Uint8Array& pixels) override;
+  void texImage2D(GLenum target, GLint level, GLenum internalformat,
+                  GLenum format, GLenum type, ICanvas* pixels) override;
+  void texImage2D(GLenum target, GLint level, GLenum internalformat,
+                  GLsizei width, GLsizei height, GLsizei border, GLenum format,
+                  GLenum type, ICanvas* pixels) override;
+  void texParameterf(GLenum target, GLenum pname, GLfloat param) override;
+  void texParameteri(GLenum target, GLenum pname, GLint param) override;
+  void texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                     GLsizei width, GLsizei height, GLenum format, GLenum type,
+                     any pixels) override;
+  void uniform1f(IGLUniformLocation* location, GLfloat v0) override;
+  void uniform1fv(GL::IGLUniformLocation* location,
+                  const Float32Array& array) override;
+  void uniform1i(IGLUniformLocation* location, GLint v0) override;
+  void uniform1iv(IGLUniformLocation* location, const Int32Array& v) override;
+  void uniform2f(IGLUniformLocation* location, GLfloat v0, GLfloat v1) override;
+  void uniform2fv(IGLUniformLocation* location, const Float32Array& v) override;
+  void uniform2i(IGLUniformLocation* location, GLint v0, GLint v1) override;
+  void uniform2iv(IGLUniformLocation* location, const Int32Array& v) override;
+  void uniform3f(IGLUniformLocation* location, GLfloat v0, GLfloat v1,
+                 GLfloat v2) override;
+  void uniform3fv(IGLUniformLocation* location, const Float32Array& v) override;
+  void uniform3i(IGLUniformLocation* location, GLint v0, GLint v1,
+                 GLint v2) override;
+  void uniform3iv(IGLUniformLocation* location, const Int32Array& v) override;
+  void uniform4f(IGLUniformLocation* location, GLfloat v0, GLfloat v1,
+                 GLfloat v2, GLfloat v3) override;
+  void uniform4fv(IGLUniformLocation* location, const Float32Array& v) override;
+  void uniform4i(IGLUniformLocation* location, GLint v0, GLint v1, GLint v2,
+                 GLint v3) override;
+  void uniform4iv(IGLUniformLocation* location, const Int32Array& v) override;
+  void uniformBlockBinding(IGLProgram* program, GLuint uniformBlockIndex,
+                           GLuint uniformBlockBinding) override;
+  void uniformMatrix2fv(IGLUniformLocation* location, GLboolean transpose,
+                        const Float32Array& value) override;
+  void uniformMatrix3fv(IGLUniformLocation* location, GLboolean transpose,
+                        const Float32Array& value) override;
+  void uniformMatrix4fv(IGLUniformLocation* location, GLboolean transpose,
+                        const Float32Array& value) override;
+  void uniformMatrix4fv(IGLUniformLocation* location, GLboolean transpose,
+                        const std::array<float, 16>& value) override;
+  void useProgram(IGLProgram* program) override;
+  void validateProgram(IGLProgram* program) override;
+  void vertexAttrib1f(GLuint index, GLfloat v0) override;
+  void vertexAttrib1fv(GLuint indx, Float32Array& values) override;
+  void vertexAttrib2f(GLuint index, GLfloat v0, GLfloat v1) override;
+  void vertexAttrib2fv(GLuint index, Float32Array& values) override;
+  void vertexAttrib3f(GLuint index, GLfloat v0, GLfloat v1,
+                      GLfloat v2) override;
+  void vertexAttrib3fv(GLuint index, Float32Array& values) override;
+  void vertexAttrib4f(GLuint index, GLfloat v0, GLfloat v1, GLfloat v2,
+                      GLfloat v3) override;
+  void vertexAttrib4fv(GLuint index, Float32Array& values) override;
+  void vertexAttribDivisor(GLuint index, GLuint divisor) override;
+  void vertexAttribPointer(GLuint index, GLint size, GLenum type,
+                           GLboolean normalized, GLint stride,
+                           GLintptr offset) override;
+  void viewport(GLint x, GLint y, GLsizei width, GLsizei height) override;
+
+private:
+  using GLCommandArgs = std::array<GLuint, 4>;
+
+  void _record(GLCommandType type, const GLCommandArgs& args = {},
+               GLsizeiptr size = 0);
+  void _query(GLCommandType type, const GLCommandArgs& args = {});
+  void _setState(GLCommandType type, GLCommandType state, std::uint64_t slot,
+                 const GLCommandArgs& args);
+  void _draw(GLCommandType type, GLenum mode, GLsizeiptr count,
+             GLsizei instanceCount);
+  void _upload(GLCommandType type, GLenum target, std::size_t bytes,
+               bool texture);
+  void _uniform(GLCommandType type, IGLUniformLocation* location,
+                std::size_t count);
+  GLuint _createObject();
+  void _deleteObject(GLCommandType type, GLuint name);
+  GLboolean _isObject(GLCommandType type, GLuint name);
+  GLuint _boundTexture(GLenum target) const;
+  bool _stateValue(GLCommandType state, std::uint64_t slot,
+                   GLCommandArgs& args) const;
+  static GLuint _bits(GLfloat value);
+  static std::size_t _texelBytes(GLenum format, GLenum type);
+
+private:
+  bool _commandRecording;
+  std::vector<GLCommand> _commands;
+  GLStatistics _statistics;
+  GLuint _lastObjectName;
+  GLint _lastUniformLocation;
+  GLuint _activeTextureUnit;
+  // Last arguments of the state setting calls, keyed by state and slot
+  std::unordered_map<std::uint64_t, GLCommandArgs> _state;
+  std::unordered_set<GLuint> _objects;
+  std::unordered_map<GLuint, std::string> _shaderSources;
+  std::unordered_map<GLuint, GLenum> _shaderTypes;
+  std::unordered_map<GLuint, std::vector<std::unique_ptr<IGLShader>>>
+    _attachedShaders;
+  std::unordered_map<GLuint, Uint8Array> _programBinaries;
+  std::unordered_map<GLuint, std::unordered_map<std::string, GLint>>
+    _attribLocations;
+  std::unordered_map<GLuint, std::unordered_map<std::string, GLuint>>
+    _uniformBlockIndices;
+  IGLShaderPrecisionFormat _shaderPrecisionFormat;
+
+}; // end of class RecordingGLRenderingContext
+
+} // end of namespace GL
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_ENGINE_RECORDING_GL_RENDERING_CONTEXT_H
@@ -3,6 +3,7 @@
 
 #include <babylon/animations/ianimatable.h>
 #include <babylon/babylon_global.h>
+#include <babylon/core/lookup_index.h>
 #include <babylon/core/structs.h>
 #include <babylon/culling/octrees/octree.h>
 #include <babylon/engine/pointer_info.h>
@@ -38,6 +39,9 @@ public:
   static bool ExclusiveDoubleClickMode; // If you need to check double click
                                         // without raising a single click at
                                         // first click, enable this flag
+  static size_t MinActiveMeshesPerEvaluationBatch; // Smallest number of
+                                                   // candidates handed to an
+                                                   // evaluation task
 
   template <typename... Ts>
   static std::unique_ptr<Scene> New(Ts&&... args)
@@ -85,6 +89,12 @@ public:
   DebugLayer* debugLayer();
   void setWorkerCollisions(bool enabled);
   bool workerCollisions() const;
+  /**
+   * @brief Enables or disables the distribution of the active meshes frustum
+   * tests over the workers of the shared task scheduler.
+   */
+  void setParallelActiveMeshesEvaluation(bool enabled);
+  bool parallelActiveMeshesEvaluation() const;
   Octree<AbstractMesh*>* selectionOctree();
 
   /**
@@ -227,6 +237,17 @@ public:
   int removeCamera(Camera* toRemove);
   void addLight(std::unique_ptr<Light>&& newLight);
   void addCamera(std::unique_ptr<Camera>&& newCamera);
+  void addMaterial(std::unique_ptr<Material>&& newMaterial);
+  int removeMaterial(Material* toRemove);
+  /**
+   * @brief Keeps the lookup indexes in sync when an object of the scene is
+   * renamed. Called by the setId() and setName() methods of the nodes and of
+   * the materials.
+   */
+  void _onIDChanged(Node* node, const std::string& oldID);
+  void _onNameChanged(Node* node, const std::string& oldName);
+  void _onIDChanged(Material* material, const std::string& oldID);
+  void _onNameChanged(Material* material, const std::string& oldName);
 
   /**
    * @brief Switch active camera.
@@ -440,6 +461,23 @@ public:
   Octree<AbstractMesh*>* createOrUpdateSelectionOctree(size_t maxCapacity = 64,
                                                        size_t maxDepth    = 2);
 
+  /** Static batching **/
+  /**
+   * @brief Enables the static batching, which merges the static meshes sharing
+   * a material per cell of a grid, and adds the meshes whose world matrix is
+   * frozen to it. Other meshes can be added with StaticBatcher::addMesh().
+   * @param cellSize The size of the cells of the grid
+   * @return The static batcher of the scene
+   */
+  StaticBatcher* enableStaticBatching(float cellSize = 64.f);
+
+  /**
+   * @brief Disables the static batching, the batched meshes being rendered on
+   * their own again.
+   */
+  void disableStaticBatching();
+  StaticBatcher* getStaticBatcher();
+
   /** Picking **/
   Ray* createPickingRay(int x, int y, Matrix* world, Camera* camera);
   Ray* createPickingRayInCameraSpace(int x, int y, Camera* camera);
@@ -597,6 +635,8 @@ private:
   void _animate();
   void _evaluateSubMesh(SubMesh* subMesh, AbstractMesh* mesh);
   void _evaluateActiveMeshes();
+  void _evaluateActiveMeshesVisibility();
+  void _setActiveMeshCandidateFlags(size_t index);
   void _activeMesh(AbstractMesh* mesh);
   void _renderForCamera(Camera* camera);
   void _processSubCameras(Camera* camera);
@@ -838,6 +878,10 @@ public:
   Material* _cachedMaterial;
   Effect* _cachedEffect;
   std::vector<IDisposable*> _toBeDisposed;
+  // Meshes and cameras removed from the scene, destroyed at the start of the
+  // next frame or when the scene is disposed
+  std::vector<std::unique_ptr<AbstractMesh>> _removedMeshes;
+  std::vector<std::unique_ptr<Camera>> _removedCameras;
   std::vector<ParticleSystem*> _activeParticleSystems;
   std::vector<Animatable*> _activeAnimatables;
 
@@ -948,6 +992,16 @@ private:
   int _projectionUpdateFlag;
   std::vector<std::string> _pendingData;
   std::vector<Mesh*> _activeMeshes;
+  // World matrices of the meshes
+  std::unique_ptr<TransformHierarchy> _transformHierarchy;
+  // Static batching
+  std::unique_ptr<StaticBatcher> _staticBatcher;
+  // Active meshes evaluation
+  bool _parallelActiveMeshesEvaluation;
+  std::vector<AbstractMesh*> _activeMeshesCandidates;
+  std::vector<AbstractMesh*> _activeMeshesCandidatesLOD;
+  std::unique_ptr<BoundingVolumeArrays> _activeMeshesCandidatesVolumes;
+  Uint32Array _activeMeshesCandidatesVisibility;
   std::vector<Material*> _processedMaterials;
   std::vector<RenderTargetTexture*> _renderTargets;
   std::vector<Skeleton*> _activeSkeletons;
@@ -970,6 +1024,19 @@ private:
   std::unique_ptr<DebugLayer> _debugLayer;
   std::unique_ptr<DepthRenderer> _depthRenderer;
   unsigned int _uniqueIdCounter;
+  // Lookup indexes
+  LookupIndex<std::string, AbstractMesh> _meshesByID;
+  LookupIndex<std::string, AbstractMesh> _meshesByName;
+  LookupIndex<unsigned int, AbstractMesh> _meshesByUniqueID;
+  LookupIndex<std::string, Light> _lightsByID;
+  LookupIndex<std::string, Light> _lightsByName;
+  LookupIndex<unsigned int, Light> _lightsByUniqueID;
+  LookupIndex<std::string, Camera> _camerasByID;
+  LookupIndex<std::string, Camera> _camerasByName;
+  LookupIndex<unsigned int, Camera> _camerasByUniqueID;
+  LookupIndex<std::string, Material> _materialsByID;
+  LookupIndex<std::string, Material> _materialsByName;
+  LookupIndex<std::string, Geometry> _geometriesByID;
   AbstractMesh* _pickedDownMesh;
   AbstractMesh* _pickedUpMesh;
   Sprite* _pickedDownSprite;
@@ -0,0 +1,85 @@
+#ifndef BABYLON_ENGINE_SHADER_PROGRAM_CACHE_H
+#define BABYLON_ENGINE_SHADER_PROGRAM_CACHE_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+/**
+ * @brief On-disk cache of linked shader program binaries.
+ *
+ * A program is stored in a file of the cache directory named after the hash of
+ * its sources, of its defines and of the driver (vendor, renderer and
+ * versions), so that it is reused by later runs with the same driver. The file
+ * also holds the length and a second hash of these strings, so that a program
+ * whose name collides is not loaded in place of another. A file which does not
+ * match the program or the driver, or whose binary is rejected by the driver,
+ * is removed and the program is compiled again.
+ */
+class BABYLON_SHARED_EXPORT ShaderProgramCache {
+
+public:
+  /**
+   * @brief Identifies a program in the cache.
+   */
+  struct Key {
+    // Name of the file, the hexadecimal FNV-1a hash of the strings
+    std::string name;
+    // Total length and second hash of the strings, checked on load
+    std::uint64_t length = 0;
+    std::uint64_t digest = 0;
+  }; // end of struct Key
+
+public:
+  ShaderProgramCache(const std::string& directory);
+  ~ShaderProgramCache();
+
+  const std::string& getDirectory() const;
+
+  /**
+   * @brief Returns the key of a program, from its sources, its defines and the
+   * driver of the rendering context.
+   */
+  Key getKey(GL::IGLRenderingContext* gl, const std::string& vertexCode,
+             const std::string& fragmentCode, const std::string& defines);
+
+  /**
+   * @brief Creates a program from its cached binary.
+   * @return The linked program, nullptr when the program is not in the cache
+   * or when its binary can not be used.
+   */
+  std::unique_ptr<GL::IGLProgram> load(GL::IGLRenderingContext* gl,
+                                       const Key& key);
+
+  /**
+   * @brief Stores the binary of a linked program in the cache.
+   * @return Whether or not the binary was written.
+   */
+  bool store(GL::IGLRenderingContext* gl, GL::IGLProgram* program,
+             const Key& key);
+
+  /** Statistics **/
+  std::size_t getHitCount() const;
+  std::size_t getMissCount() const;
+  // Cached binaries which did not match the driver or were rejected by it
+  std::size_t getRejectedCount() const;
+  std::size_t getStoredCount() const;
+
+private:
+  std::string _getPath(const Key& key) const;
+  const std::string& _getDriverInfo(GL::IGLRenderingContext* gl);
+
+private:
+  std::string _directory;
+  GL::IGLRenderingContext* _driverInfoContext;
+  std::string _driverInfo;
+  std::size_t _hitCount;
+  std::size_t _missCount;
+  std::size_t _rejectedCount;
+  std::size_t _storedCount;
+
+}; // end of class ShaderProgramCache
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_ENGINE_SHADER_PROGRAM_CACHE_H
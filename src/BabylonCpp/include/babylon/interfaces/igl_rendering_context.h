@@ -211,6 +211,11 @@ enum GLEnums : GLenum {
   ACTIVE_ATTRIBUTES                = 0x8B89,
   SHADING_LANGUAGE_VERSION         = 0x8B8C,
   CURRENT_PROGRAM                  = 0x8B8D,
+  /* Program binaries */
+  PROGRAM_BINARY_RETRIEVABLE_HINT = 0x8257,
+  PROGRAM_BINARY_LENGTH           = 0x8741,
+  NUM_PROGRAM_BINARY_FORMATS      = 0x87FE,
+  PROGRAM_BINARY_FORMATS          = 0x87FF,
   /* StencilFunction */
   NEVER    = 0x0200,
   LESS     = 0x0201,
@@ -530,6 +535,10 @@ public:
 class BABYLON_SHARED_EXPORT IGLRenderingContext {
 
 public:
+  virtual ~IGLRenderingContext()
+  {
+  }
+
   virtual bool initialize()     = 0;
   virtual void backupGLState()  = 0;
   virtual void restoreGLState() = 0;
@@ -1236,6 +1245,17 @@ public:
   virtual GLenum getError()                      = 0;
   virtual const char* getErrorString(GLenum err) = 0;
 
+  /**
+   * @brief Returns the binary representation of a linked program, which can be
+   * loaded back with programBinary() on the same driver.
+   * @param program A linked IGLProgram.
+   * @param binaryFormat Set to the format of the returned binary.
+   * @return The program binary, empty when the program is not linked or when
+   * the driver does not support program binaries.
+   */
+  virtual Uint8Array getProgramBinary(IGLProgram* program,
+                                      GLenum& binaryFormat) = 0;
+
   /**
    * @brief Returns information about the given program.
    * @param program A IGLProgram to get parameter information from.
@@ -1416,6 +1436,29 @@ public:
    */
   virtual void polygonOffset(GLfloat factor, GLfloat units) = 0;
 
+  /**
+   * @brief Loads a program binary returned by getProgramBinary() into a
+   * program, replacing its linking.
+   * @param program An IGLProgram to load the binary into.
+   * @param binaryFormat The format of the binary.
+   * @param binary The program binary.
+   * @return Whether or not the program is linked. The driver rejects binaries
+   * from another driver version or in an unsupported format, in which case the
+   * program has to be compiled and linked from its sources.
+   */
+  virtual bool programBinary(IGLProgram* program, GLenum binaryFormat,
+                             const Uint8Array& binary) = 0;
+
+  /**
+   * @brief Sets a parameter of a program.
+   * @param program An IGLProgram.
+   * @param pname A GLenum specifying the parameter to set, e.g.
+   * PROGRAM_BINARY_RETRIEVABLE_HINT.
+   * @param value A GLint specifying the value of the parameter.
+   */
+  virtual void programParameteri(IGLProgram* program, GLenum pname,
+                                 GLint value) = 0;
+
   /**
    * @brief Reads a block of pixels from a specified rectangle of the current
    * color framebuffer into an Uint8Array object.
@@ -2032,7 +2075,9 @@ protected:
 class BABYLON_SHARED_EXPORT IGLVertexArrayObject {
 
 public:
-  IGLVertexArrayObject();
+  IGLVertexArrayObject()
+  {
+  }
 
 }; // end of class IGLVertexArrayObject
 
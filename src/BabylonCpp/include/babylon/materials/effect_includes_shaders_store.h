@@ -7,6 +7,22 @@ namespace BABYLON {
 
 struct BABYLON_SHARED_EXPORT EffectIncludesShadersStore {
   static std::unordered_map<std::string, const char*> Shaders;
+
+  /**
+   * @brief Adds, replaces or removes an include. Use these methods rather than
+   * modifying the Shaders, so that the sources processed with the previous
+   * includes are not reused.
+   */
+  static void SetShader(const std::string& name, const char* content);
+  static void RemoveShader(const std::string& name);
+
+  /**
+   * @brief Returns the number of modifications of the includes.
+   */
+  static std::size_t Generation();
+
+private:
+  static std::atomic<std::size_t> _generation;
 }; // end of struct EffectIncludesShadersStore
 
 } // end of namespace BABYLON
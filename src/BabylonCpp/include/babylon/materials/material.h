@@ -38,6 +38,13 @@ public:
   const char* getClassName() const;
 
   virtual IReflect::Type type() const override;
+  /**
+   * @brief Renames the material. Use these methods rather than assigning the
+   * fields once the material is added to the scene, so that the scene lookups
+   * by id and by name stay consistent.
+   */
+  void setId(const std::string& newId);
+  void setName(const std::string& newName);
   void addMaterialToScene(std::unique_ptr<Material>&& newMaterial);
   void
   addMultiMaterialToScene(std::unique_ptr<MultiMaterial>&& newMultiMaterial);
@@ -0,0 +1,45 @@
+#ifndef BABYLON_MATERIALS_SHADER_PROCESSOR_H
+#define BABYLON_MATERIALS_SHADER_PROCESSOR_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+/**
+ * @brief Expands the #include<name> and #include<name>[min..max] directives
+ * of the shader sources.
+ *
+ * A source is tokenized once into text chunks and include directives, and its
+ * expansions are cached by the values of the index parameters it uses, so
+ * that the effects of all the define permutations of a material share them.
+ * The instanced includes are cached by name and index range. The cache holds
+ * a bounded number of sources, and is emptied when the includes of the
+ * EffectIncludesShadersStore are modified through its methods.
+ */
+class BABYLON_SHARED_EXPORT ShaderProcessor {
+
+public:
+  /**
+   * Returns the source with its include directives replaced by the content of
+   * the EffectIncludesShadersStore. A directive naming an unknown include, or
+   * with an invalid index range, is removed.
+   * @param sourceCode The shader source.
+   * @param indexParameters The values of the named maximum indices of the
+   * instanced includes, e.g. maxSimultaneousLights.
+   * @return The expanded source.
+   */
+  static std::string ProcessIncludes(
+    const std::string& sourceCode,
+    const std::unordered_map<std::string, unsigned int>& indexParameters);
+
+  /**
+   * Clears the tokenized sources and the cached expansions. To be called when
+   * the Shaders of the EffectIncludesShadersStore are modified directly.
+   */
+  static void ClearCache();
+
+}; // end of class ShaderProcessor
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_MATERIALS_SHADER_PROCESSOR_H
@@ -3,11 +3,6 @@
 
 #include <babylon/babylon_global.h>
 
-// SIMD
-#if BABYLONCPP_OPTION_ENABLE_SIMD == true
-#include <babylon/math/simd/simd_matrix.h>
-#endif
-
 namespace BABYLON {
 
 /**
@@ -624,9 +619,6 @@ public:
 public:
   int updateFlag;
   std::array<float, 16> m;
-#if BABYLONCPP_OPTION_ENABLE_SIMD == true
-  SIMD::SIMDMatrix simdMatrix;
-#endif
 
 private:
   static Quaternion _tempQuaternion;
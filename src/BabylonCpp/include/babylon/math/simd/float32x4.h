@@ -3,7 +3,7 @@
 
 #include <babylon/babylon_global.h>
 
-#include <xmmintrin.h>
+#include <pmmintrin.h>
 
 #define ALIGN_16 __attribute__((aligned(16)))
 
@@ -447,6 +447,64 @@ struct BABYLON_SHARED_EXPORT Float32x4 {
     return _mm_load_ps(res);
   }
 
+  /**
+   * @brief Returns a new instance with the absolute lane values.
+   * @param a An instance of a corresponding SIMD type.
+   * @return A new corresponding SIMD data type with the absolute lane values.
+   */
+  static inline float32x4_t abs(float32x4_t a)
+  {
+    return _mm_andnot_ps(_mm_set1_ps(-0.f), a);
+  }
+
+  /**
+   * @brief Returns a selection mask of the lanes for which a < b.
+   * @param a An instance of a SIMD type.
+   * @param b Another instance of a SIMD type.
+   * @return A new SIMD data type with all the bits of the lanes for which
+   * a < b set, and the other lanes cleared.
+   */
+  static inline float32x4_t lessThan(float32x4_t a, float32x4_t b)
+  {
+    return _mm_cmplt_ps(a, b);
+  }
+
+  /**
+   * @brief Returns a selection mask of the lanes for which a <= b.
+   * @param a An instance of a SIMD type.
+   * @param b Another instance of a SIMD type.
+   * @return A new SIMD data type with all the bits of the lanes for which
+   * a <= b set, and the other lanes cleared.
+   */
+  static inline float32x4_t lessThanOrEqual(float32x4_t a, float32x4_t b)
+  {
+    return _mm_cmple_ps(a, b);
+  }
+
+  /**
+   * @brief Returns a selection mask of the lanes for which a >= b.
+   * @param a An instance of a SIMD type.
+   * @param b Another instance of a SIMD type.
+   * @return A new SIMD data type with all the bits of the lanes for which
+   * a >= b set, and the other lanes cleared.
+   */
+  static inline float32x4_t greaterThanOrEqual(float32x4_t a, float32x4_t b)
+  {
+    return _mm_cmpge_ps(a, b);
+  }
+
+  /**
+   * @brief Returns the sign bits of the lanes packed in the 4 lowest bits,
+   * lane 0 being the lowest bit.
+   * @param a An instance of a corresponding SIMD type, usually a selection
+   * mask.
+   * @return The sign bits of the lanes.
+   */
+  static inline unsigned int signMask(float32x4_t a)
+  {
+    return static_cast<unsigned int>(_mm_movemask_ps(a));
+  }
+
   /**
    * @brief Returns a new instance with an approximation of the reciprocal lane
    * values (1 / x).
@@ -26,6 +26,41 @@ struct BABYLON_SHARED_EXPORT SIMDMatrix {
   static void LookAtLHToRefSIMD(const Vector3& eyeRef, const Vector3& targetRef,
                                 const Vector3& upRef, Matrix& result);
 
+  /**
+   * @brief Sets result to left * right, result may be left or right. The update
+   * flag of result is not changed.
+   */
+  static void MultiplyToRefSIMD(const Matrix& left, const Matrix& right,
+                                Matrix& result);
+
+  /**
+   * @brief Stores left * right into 16 floats, which may be the values of left
+   * or right.
+   */
+  static void MultiplyToArraySIMD(const Matrix& left, const Matrix& right,
+                                  float* result);
+
+  /**
+   * @brief Sets result to the inverse of matrix, result may be matrix. The
+   * update flag of result is not changed.
+   */
+  static void InvertToRefSIMD(const Matrix& matrix, Matrix& result);
+
+  /**
+   * @brief Sets result to the scaling, rotation and translation transform, as
+   * Matrix::ComposeToRef().
+   */
+  static void ComposeToRefSIMD(const Vector3& scale, const Quaternion& rotation,
+                               const Vector3& translation, Matrix& result);
+
+  /**
+   * @brief Decomposes matrix into its scaling, rotation and translation, as
+   * Matrix::decompose().
+   * @return false when one of the scaling components is zero.
+   */
+  static bool DecomposeSIMD(const Matrix& matrix, Vector3& scale,
+                            Quaternion& rotation, Vector3& translation);
+
   std::array<float, 16> m;
 
 }; // end of struct SIMDMatrix
@@ -0,0 +1,37 @@
+#ifndef BABYLON_MATH_SIMD_QUATERNION_H
+#define BABYLON_MATH_SIMD_QUATERNION_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+namespace SIMD {
+
+struct BABYLON_SHARED_EXPORT SIMDQuaternion {
+
+  /**
+   * @brief Sets result to left * right, as Quaternion::multiplyToRef(), result
+   * may be left or right.
+   */
+  static void MultiplyToRefSIMD(const Quaternion& left,
+                                const Quaternion& right, Quaternion& result);
+
+  /**
+   * @brief Sets result to the spherical interpolation of left and right, as
+   * Quaternion::SlerpToRef().
+   */
+  static void SlerpToRefSIMD(const Quaternion& left, const Quaternion& right,
+                             float amount, Quaternion& result);
+
+  /**
+   * @brief Sets result to the rotation matrix of quaternion, as
+   * Quaternion::toRotationMatrix(). The update flag of result is not changed.
+   */
+  static void ToRotationMatrixSIMD(const Quaternion& quaternion,
+                                   Matrix& result);
+
+}; // end of struct SIMDQuaternion
+
+} // end of namespace SIMD
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_MATH_SIMD_QUATERNION_H
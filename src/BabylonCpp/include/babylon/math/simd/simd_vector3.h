@@ -15,6 +15,24 @@ struct BABYLON_SHARED_EXPORT SIMDVector3 {
   static void TransformCoordinatesFromFloatsToRefSIMD(
     float x, float y, float z, const Matrix& transformation, Vector3& result);
 
+  /**
+   * @brief Transforms an array of packed coordinates (x, y, z) as
+   * Vector3::TransformCoordinatesToRef(), 4 vectors at a time. The result is
+   * resized to the size of the source and may be the source.
+   */
+  static void TransformCoordinatesArraySIMD(const Float32Array& source,
+                                            const Matrix& transformation,
+                                            Float32Array& result);
+
+  /**
+   * @brief Transforms an array of packed normals (x, y, z) as
+   * Vector3::TransformNormalToRef(), 4 vectors at a time. The result is resized
+   * to the size of the source and may be the source.
+   */
+  static void TransformNormalsArraySIMD(const Float32Array& source,
+                                        const Matrix& transformation,
+                                        Float32Array& result);
+
 }; // end of struct SIMDVector3
 
 } // end of namespace SIMD
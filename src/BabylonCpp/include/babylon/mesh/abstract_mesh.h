@@ -27,6 +27,8 @@ class BABYLON_SHARED_EXPORT AbstractMesh : public Node,
                                            public ICullable,
                                            public IGetSetVerticesData {
 
+  friend class TransformHierarchy;
+
 public:
   // The billboard Mode None, the object is normal by default
   static constexpr unsigned int BILLBOARDMODE_NONE = 0;
@@ -220,7 +222,7 @@ public:
    * @brief Returns true if the mesh is blocked. Used by the class Mesh.
    * @returns The boolean `false` by default.
    */
-  bool isBlocked() const;
+  virtual bool isBlocked() const;
 
   /**
    * @brief Returns the mesh itself by default, used by the class Mesh.
@@ -538,6 +540,12 @@ public:
    */
   Matrix computeWorldMatrix(bool force = false) override;
 
+  /**
+   * @brief Returns the number of times the world matrix was computed, used to
+   * detect the changes of the world matrix.
+   */
+  unsigned int worldMatrixUpdateCount() const;
+
   /**
    * @brief If you'd like to be called back after the mesh position, rotation or
    * scaling has been updated.
@@ -907,7 +915,7 @@ protected:
 private:
   void _markSubMeshesAsDirty(
     const std::function<void(const MaterialDefines& defines)>& func);
-  void _onCollisionPositionChange(int collisionId, const Vector3& newPosition,
+  void _onCollisionPositionChange(int collisionId, Vector3& newPosition,
                                   AbstractMesh* collidedMesh = nullptr);
   // Facet data
 
@@ -918,6 +926,12 @@ private:
    */
   AbstractMesh& _initFacetData();
 
+  // Steps of computeWorldMatrix(), the world matrix of the parent must be up to
+  // date when computing the local world matrix of a billboard
+  void _computeLocalWorldMatrix();
+  void _computeWorldMatrixFromParent();
+  void _afterWorldMatrixUpdate();
+
 public:
   /**
    * An event triggered when this mesh collides with another one
@@ -983,6 +997,8 @@ public:
   Octree<SubMesh*>* _submeshesOctree;
   std::vector<AbstractMesh*> _intersectionsInProgress;
   bool _unIndexed;
+  // Whether the mesh is rendered as part of a static batch
+  bool _isStaticBatched;
   std::unique_ptr<Matrix> _poseMatrix;
   std::vector<Light*> _lightSources;
   // Loading properties
@@ -1045,6 +1061,7 @@ private:
   bool _isDirty;
   Matrix _pivotMatrix;
   bool _isWorldMatrixFrozen;
+  unsigned int _worldMatrixUpdateCount;
   // Skeleton
   Skeleton* _skeleton;
 
@@ -0,0 +1,100 @@
+#ifndef BABYLON_MESH_INSTANCES_STREAM_H
+#define BABYLON_MESH_INSTANCES_STREAM_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+/**
+ * @brief Streams the world matrices of the instances of a mesh to the vertex
+ * buffer read by its instanced draw calls.
+ *
+ * The vertex buffer and its copy in memory are kept from a frame to the next
+ * and only grow, so that they are not reallocated once the number of visible
+ * instances is stable. The matrices are written in place in the copy, and the
+ * stream remembers which instance and which world matrix update each slot
+ * holds: only the ranges of slots whose content changed since the previous
+ * draw call are uploaded.
+ */
+class BABYLON_SHARED_EXPORT InstancesStream {
+
+public:
+  // Floats per instance, a world matrix
+  static constexpr std::size_t InstanceSize = 16;
+  // Slots between two ranges to upload below which the ranges are merged
+  static constexpr std::size_t MaxRangeGap = 4;
+  // Above this number of ranges to upload, the range covering them is uploaded
+  // with a single call
+  static constexpr std::size_t MaxDirtyRanges = 16;
+
+public:
+  InstancesStream(Mesh* mesh, std::size_t capacity);
+  InstancesStream(const InstancesStream& other) = delete;
+  InstancesStream& operator=(const InstancesStream& other) = delete;
+  ~InstancesStream();
+
+  std::size_t getCapacity() const;
+  std::size_t getInstancesCount() const;
+
+  /**
+   * @brief Starts the writing of the instances of a draw call, the buffers
+   * growing if they cannot hold them.
+   */
+  void begin(std::size_t instancesCount);
+
+  /**
+   * @brief Writes the world matrix of a mesh to the next slot, unless the slot
+   * already holds it.
+   */
+  void write(AbstractMesh* mesh);
+
+  /**
+   * @brief Uploads the slots which changed since begin().
+   * @return The number of instances written since begin().
+   */
+  std::size_t end();
+
+  /**
+   * @brief Forces the upload of all the slots by the next draw call.
+   */
+  void markAsDirty();
+
+  void dispose();
+
+  /** Statistics **/
+  // Instances uploaded by the last draw call
+  std::size_t getUploadedCount() const;
+  // Number of times the buffers grew
+  std::size_t getReallocationCount() const;
+
+private:
+  struct Slot {
+    AbstractMesh* mesh;
+    unsigned int uniqueId;
+    unsigned int worldMatrixUpdateCount;
+  }; // end of struct Slot
+
+  void _grow(std::size_t capacity);
+  void _markSlotAsDirty(std::size_t slot);
+
+private:
+  Mesh* _mesh;
+  Engine* _engine;
+  std::size_t _capacity;
+  std::unique_ptr<Buffer> _buffer;
+  Float32Array _data;
+  // Content of the slots, as written to the buffer
+  std::vector<Slot> _slots;
+  std::size_t _instancesCount;
+  // Ranges of slots to upload, sorted, with the end of each range excluded
+  std::vector<std::pair<std::size_t, std::size_t>> _dirtyRanges;
+  // Data of a range, reused from an upload to the next
+  Float32Array _uploadData;
+  std::size_t _uploadedCount;
+  std::size_t _reallocationCount;
+
+}; // end of class InstancesStream
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_MESH_INSTANCES_STREAM_H
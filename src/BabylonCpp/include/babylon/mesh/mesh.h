@@ -261,7 +261,11 @@ public:
    */
   IndicesArray getIndices(bool copyWhenShared = false) override;
 
-  bool isBlocked();
+  /**
+   * @brief Returns true if the mesh is a LOD level of another mesh, in which
+   * case it is only rendered through the mesh it belongs to.
+   */
+  bool isBlocked() const override;
 
   /**
    * @brief Returns true once the mesh is ready after all the delayed process
@@ -702,17 +706,23 @@ public:
    * @param type the type of simplification to run.
    * @param successCallback optional success callback to be called after the
    * simplification finished processing all settings.
+   * The levels are decimated on the task scheduler and added with
+   * addLODLevel() by the simplification queue of the scene, before a frame.
+   * @returns the Mesh.
    */
-  /*void
-  simplify(const std::vector<ISimplificationSettings*>& settings,
-           std::function<void(Mesh* mesh, int submeshIndex)>& successCallback,
-           bool parallelProcessing = true, SimplificationType simplificationType
-                                           = SimplificationType::QUADRATIC);*/
+  Mesh& simplify(const std::vector<ISimplificationSettings>& settings,
+                 bool parallelProcessing = true,
+                 SimplificationType simplificationType
+                 = SimplificationType::QUADRATIC,
+                 const std::function<void(Mesh* mesh)>& successCallback
+                 = nullptr);
 
   /**
-   * @brief Optimization of the mesh's indices, in case a mesh has duplicated
-   * vertices. The function will only reorder the indices and will not remove
-   * unused vertices to avoid problems with submeshes.
+   * @brief Optimization of the mesh's indices and vertices for the GPU: the
+   * duplicated vertices are welded, the triangles reordered for the vertex
+   * cache and overdraw, and the vertices reordered in their order of use, the
+   * submeshes being kept. See MeshOptimizer, which can also run it on a worker
+   * thread.
    * This should be used together with the simplification to avoid disappearing
    * triangles.
    * @param successCallback an optional success callback to be called after the
@@ -1440,9 +1450,8 @@ private:
   std::vector<VertexBuffer*> _delayInfo;
   Int32Array _renderIdForInstances;
   std::unique_ptr<_InstancesBatch> _batchCache;
-  unsigned int _instancesBufferSize;
-  std::unique_ptr<Buffer> _instancesBuffer;
-  Float32Array _instancesData;
+  // World matrices of the instances, created by the first instanced draw call
+  std::unique_ptr<InstancesStream> _instancesStream;
   size_t _overridenInstanceCount;
   int _preActivateId;
   unsigned int _sideOrientation;
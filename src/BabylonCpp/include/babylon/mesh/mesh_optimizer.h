@@ -0,0 +1,217 @@
+#ifndef BABYLON_MESH_MESH_OPTIMIZER_H
+#define BABYLON_MESH_MESH_OPTIMIZER_H
+
+#include <babylon/babylon_global.h>
+#include <babylon/core/task_scheduler.h>
+#include <babylon/tools/observer.h>
+
+namespace BABYLON {
+
+/**
+ * @brief Efficiency of an index buffer for a FIFO post-transform vertex cache.
+ */
+struct BABYLON_SHARED_EXPORT VertexCacheStatistics {
+  // Cache misses, i.e. vertices transformed by the vertex shader
+  std::size_t transformedVertices = 0;
+  std::size_t triangles           = 0;
+  // Distinct vertices referenced by the indices
+  std::size_t vertices = 0;
+  // Average cache miss ratio, transformed vertices per triangle, from 0.5 for
+  // an ideal grid to 3
+  float acmr = 0.f;
+  // Average transform to vertex ratio, transformed vertices per vertex, from 1
+  // (each vertex transformed once) to 6
+  float atvr = 0.f;
+}; // end of struct VertexCacheStatistics
+
+/**
+ * @brief Steps run by the MeshOptimizer.
+ */
+struct BABYLON_SHARED_EXPORT MeshOptimizationOptions {
+  // Merges the vertices whose data is identical in every vertex buffer, up to
+  // weldEpsilon
+  bool weldVertices = true;
+  float weldEpsilon = 0.f;
+  // Reorders the triangles for the post-transform vertex cache (Tipsify)
+  bool optimizeVertexCache = true;
+  std::size_t cacheSize    = 16;
+  // Reorders the clusters of triangles so that those facing outwards are drawn
+  // first, the clusters being split while the ACMR stays below
+  // overdrawThreshold times the ACMR of the vertex cache order
+  bool optimizeOverdraw   = true;
+  float overdrawThreshold = 1.05f;
+  // Reorders the vertices in the order of their first use, the unreferenced
+  // vertices being removed, which the welding also implies
+  bool optimizeVertexFetch = true;
+}; // end of struct MeshOptimizationOptions
+
+/**
+ * @brief Outcome of the optimization of a mesh.
+ */
+struct BABYLON_SHARED_EXPORT MeshOptimizationReport {
+  VertexCacheStatistics before;
+  VertexCacheStatistics after;
+  std::size_t verticesBefore = 0;
+  std::size_t verticesAfter  = 0;
+  // Clusters of triangles ordered for overdraw
+  std::size_t clusters = 0;
+  // Whether the welding and vertex fetch steps could run, which requires the
+  // vertex ranges of the submeshes to partition the vertices and their index
+  // ranges to partition the indices
+  bool verticesOptimized = false;
+  // Whether the result was applied to the mesh
+  bool applied = false;
+}; // end of struct MeshOptimizationReport
+
+/**
+ * @brief Reorders the indices and the vertices of meshes for the GPU.
+ *
+ * The pipeline, run per submesh, is:
+ * - welding of the duplicated vertices, which lets the vertex cache work on
+ *   meshes exported with unshared vertices;
+ * - triangle reordering for the post-transform vertex cache, following
+ *   Tipsify (Sander, Nehab and Barczak, "Fast Triangle Reordering for Vertex
+ *   Locality and Reduced Overdraw", 2007), which also splits the triangles in
+ *   clusters;
+ * - cluster reordering for overdraw, the clusters whose average normal faces
+ *   away from the center of the submesh being drawn first;
+ * - vertex reordering in the order of their first use, every vertex buffer
+ *   being remapped.
+ *
+ * The submeshes keep their index ranges, their vertex ranges shrinking with
+ * the removed vertices. Optimize() runs on the calling thread. An instance of
+ * the optimizer runs the pipeline on a TaskScheduler instead, on a copy of the
+ * geometry, the result being applied on the render thread before a frame once
+ * it is ready.
+ */
+class BABYLON_SHARED_EXPORT MeshOptimizer {
+
+public:
+  using Callback = std::function<void(Mesh* mesh,
+                                      const MeshOptimizationReport& report)>;
+
+public:
+  MeshOptimizer(Scene* scene,
+                TaskScheduler& scheduler = TaskScheduler::Instance());
+  MeshOptimizer(const MeshOptimizer& other) = delete;
+  MeshOptimizer& operator=(const MeshOptimizer& other) = delete;
+  /**
+   * @brief The pending optimizations are not applied.
+   */
+  ~MeshOptimizer();
+
+  /**
+   * @brief Optimizes a mesh on the calling thread.
+   */
+  static MeshOptimizationReport
+  Optimize(Mesh* mesh,
+           const MeshOptimizationOptions& options = MeshOptimizationOptions());
+
+  /**
+   * @brief Optimizes a copy of the geometry of a mesh on the task scheduler.
+   * The result is applied before the first frame rendered once it is ready,
+   * unless the mesh was disposed or its geometry changed in the meantime, the
+   * callback being called in both cases.
+   */
+  void optimizeAsync(Mesh* mesh, const MeshOptimizationOptions& options
+                                 = MeshOptimizationOptions(),
+                     const Callback& callback = nullptr);
+
+  /**
+   * @brief Returns the number of optimizations not applied yet.
+   */
+  std::size_t getPendingCount() const;
+
+  /**
+   * @brief Waits for the pending optimizations and applies them.
+   */
+  void wait();
+
+  /** Algorithms **/
+
+  /**
+   * @brief Simulates a FIFO post-transform vertex cache over a list of
+   * triangles.
+   */
+  static VertexCacheStatistics
+  AnalyzeVertexCache(const IndicesArray& indices, std::size_t vertexCount,
+                     std::size_t cacheSize = 16);
+
+  /**
+   * @brief Reorders a list of triangles for the post-transform vertex cache.
+   * @return The first triangle of each cluster, a new cluster starting where
+   * the algorithm had to jump to a vertex which is not in the cache.
+   */
+  static std::vector<std::size_t> OptimizeVertexCache(IndicesArray& indices,
+                                                      std::size_t vertexCount,
+                                                      std::size_t cacheSize
+                                                      = 16);
+
+  /**
+   * @brief Splits the clusters returned by OptimizeVertexCache() and sorts
+   * them to reduce overdraw.
+   * @param positions The vertex positions, 3 floats per vertex.
+   * @return The number of clusters.
+   */
+  static std::size_t OptimizeOverdraw(IndicesArray& indices,
+                                      const Float32Array& positions,
+                                      const std::vector<std::size_t>& clusters,
+                                      std::size_t cacheSize = 16,
+                                      float threshold       = 1.05f);
+
+private:
+  struct Stream {
+    unsigned int kind;
+    Float32Array data;
+    std::size_t size;
+    bool updatable;
+  }; // end of struct Stream
+
+  struct SubMeshLayout {
+    unsigned int materialIndex;
+    std::size_t verticesStart;
+    std::size_t verticesCount;
+    std::size_t indexStart;
+    std::size_t indexCount;
+  }; // end of struct SubMeshLayout
+
+  // Copy of the geometry of a mesh, which the pipeline can work on outside
+  // of the render thread
+  struct MeshData {
+    IndicesArray indices;
+    std::size_t totalVertices;
+    std::vector<Stream> streams;
+    std::vector<SubMeshLayout> subMeshes;
+    // Whether every vertex buffer could be copied and remapped
+    bool remappable;
+  }; // end of struct MeshData
+
+  struct Job {
+    unsigned int meshUniqueId;
+    MeshData data;
+    MeshOptimizationReport report;
+    Callback callback;
+    TaskHandle<void> task;
+  }; // end of struct Job
+
+  static bool _Extract(Mesh* mesh, MeshData& data);
+  static void _Optimize(MeshData& data, const MeshOptimizationOptions& options,
+                        MeshOptimizationReport& report);
+  static bool _Apply(Mesh* mesh, const MeshData& data,
+                     const MeshOptimizationReport& report);
+  static Uint32Array _WeldVertices(const MeshData& data,
+                                   std::size_t verticesStart,
+                                   std::size_t verticesCount, float epsilon);
+  void _applyCompleted();
+
+private:
+  Scene* _scene;
+  TaskScheduler& _scheduler;
+  std::vector<std::shared_ptr<Job>> _jobs;
+  Observer<Scene>::Ptr _onBeforeRenderObserver;
+
+}; // end of class MeshOptimizer
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_MESH_MESH_OPTIMIZER_H
@@ -1,35 +0,0 @@
-#ifndef BABYLON_MESH_SIMPLIFICATION_DECIMATION_VERTEX_H
-#define BABYLON_MESH_SIMPLIFICATION_DECIMATION_VERTEX_H
-
-#include <babylon/babylon_global.h>
-
-#include <babylon/math/vector3.h>
-#include <babylon/mesh/simplification/quadratic_matrix.h>
-
-namespace BABYLON {
-
-/**
- * @brief
- */
-class BABYLON_SHARED_EXPORT DecimationVertex {
-
-public:
-  DecimationVertex(const Vector3& position, int id);
-  ~DecimationVertex();
-
-  void updatePosition(const Vector3& newPosition);
-
-public:
-  QuadraticMatrix q;
-  Vector3 position;
-  int id;
-  bool isBorder;
-  int triangleStart;
-  int triangleCount;
-  std::vector<float> originalOffsets;
-
-}; // end of class DecimationVertex
-
-} // end of namespace BABYLON
-
-#endif // end of BABYLON_MESH_SIMPLIFICATION_DECIMATION_VERTEX_H
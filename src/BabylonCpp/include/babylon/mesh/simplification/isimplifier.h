@@ -11,6 +11,8 @@ namespace BABYLON {
 class BABYLON_SHARED_EXPORT ISimplifier {
 
 public:
+  virtual ~ISimplifier() = default;
+
   /**
    * Simplification of a given mesh according to the given settings.
    * Since this requires computation, it is assumed that the function runs
@@ -19,13 +21,14 @@ public:
    * distance
    * @param successCallback A callback that will be called after the mesh was
    * simplified.
-   * @param errorCallback in case of an error, this callback will be called.
-   * optional.
    */
-  virtual void simplify() = 0;
+  virtual void
+  simplify(const ISimplificationSettings& settings,
+           const std::function<void(Mesh* simplifiedMesh)>& successCallback)
+    = 0;
 
 }; // end of class ISimplifier
 
 } // end of namespace BABYLON
 
-#endif // end of BABYLON_MESH_SIMPLIFICATION_ISIMPLIFIER_H
\ No newline at end of file
+#endif // end of BABYLON_MESH_SIMPLIFICATION_ISIMPLIFIER_H
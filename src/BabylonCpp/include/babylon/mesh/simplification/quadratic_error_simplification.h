@@ -2,6 +2,8 @@
 #define BABYLON_MESH_SIMPLIFICATION_QUADRATIC_ERROR_SIMPLIFICATION_H
 
 #include <babylon/babylon_global.h>
+#include <babylon/mesh/simplification/isimplification_settings.h>
+#include <babylon/mesh/simplification/isimplifier.h>
 
 namespace BABYLON {
 
@@ -12,15 +14,81 @@ namespace BABYLON {
  * http://voxels.blogspot.de/2014/05/quadric-mesh-simplification-with-source.html
  * to babylon JS
  * @author RaananW
+ *
+ * The geometry of the mesh is copied when the simplifier is created, each
+ * submesh being decimated on its own, in flat arrays of vertices, quadrics,
+ * triangles and references. decimate() only reads the copy: it can run on
+ * several threads at once, one per quality, the simplified meshes being
+ * created by reconstructMesh() on the render thread.
  */
 class BABYLON_SHARED_EXPORT QuadraticErrorSimplification : public ISimplifier {
 
 public:
-  QuadraticErrorSimplification();
-  ~QuadraticErrorSimplification();
+  struct Stream {
+    unsigned int kind;
+    Float32Array data;
+    std::size_t size;
+  }; // end of struct Stream
+
+  struct SubMeshLayout {
+    unsigned int materialIndex;
+    std::size_t verticesStart;
+    std::size_t verticesCount;
+    std::size_t indexStart;
+    std::size_t indexCount;
+  }; // end of struct SubMeshLayout
+
+  /**
+   * @brief Geometry of a simplified mesh.
+   */
+  struct DecimatedMesh {
+    std::vector<Stream> streams;
+    IndicesArray indices;
+    std::vector<SubMeshLayout> subMeshes;
+  }; // end of struct DecimatedMesh
+
+public:
+  QuadraticErrorSimplification(Mesh* mesh);
+  ~QuadraticErrorSimplification() override;
+
+  /**
+   * @brief Simplifies the mesh on the calling thread.
+   */
+  void simplify(const ISimplificationSettings& settings,
+                const std::function<void(Mesh* simplifiedMesh)>&
+                  successCallback) override;
+
+  /**
+   * @brief Decimates each submesh down to settings.quality of its triangles.
+   * Thread safe.
+   */
+  DecimatedMesh decimate(const ISimplificationSettings& settings) const;
+
+  /**
+   * @brief Creates the mesh of a decimation, with the material and the parent
+   * of the simplified mesh.
+   */
+  Mesh* reconstructMesh(const DecimatedMesh& decimated);
+
+  /**
+   * @brief Returns the number of triangles of the simplified mesh.
+   */
+  std::size_t getTriangleCount() const;
+
+public:
+  // Exponent of the growth of the error threshold with the iterations
+  int aggressiveness;
+  int decimationIterations;
+
+private:
+  Mesh* _mesh;
+  // Vertex buffers, the positions first
+  std::vector<Stream> _streams;
+  IndicesArray _indices;
+  std::vector<SubMeshLayout> _subMeshes;
 
 }; // end of class QuadraticErrorSimplification
 
 } // end of namespace BABYLON
 
-#endif // end of BABYLON_MESH_SIMPLIFICATION_QUADRATIC_ERROR_SIMPLIFICATION_H
\ No newline at end of file
+#endif // end of BABYLON_MESH_SIMPLIFICATION_QUADRATIC_ERROR_SIMPLIFICATION_H
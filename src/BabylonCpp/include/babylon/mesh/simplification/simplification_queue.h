@@ -2,31 +2,72 @@
 #define BABYLON_MESH_SIMPLIFICATION_SIMPLIFICATION_QUEUE_H
 
 #include <babylon/babylon_global.h>
+#include <babylon/core/task_scheduler.h>
 #include <babylon/mesh/simplification/isimplification_task.h>
+#include <babylon/mesh/simplification/quadratic_error_simplification.h>
 
 namespace BABYLON {
 
 /**
- * @brief
+ * @brief Queue of the simplifications of the meshes of a scene.
+ *
+ * The settings of the tasks are decimated on the task scheduler, the tasks of
+ * several meshes running at the same time, as well as the settings of a task
+ * when it requests parallel processing. A task starts as soon as it is added,
+ * the geometry of its mesh being copied then, so that the mesh may be disposed
+ * before the decimation completes. The simplified meshes are created and added
+ * as LOD levels of their mesh on the render thread, by executeNext(), if the
+ * mesh is still part of the scene.
  */
 class BABYLON_SHARED_EXPORT SimplificationQueue {
 
 public:
-  SimplificationQueue();
+  SimplificationQueue(TaskScheduler& scheduler = TaskScheduler::Instance());
   ~SimplificationQueue();
 
   void addTask(const ISimplificationTask& task);
+
+  /**
+   * @brief Adds the LOD levels whose decimation completed, called by the scene
+   * before each frame.
+   */
   void executeNext();
+
   void runSimplification(const ISimplificationTask& task);
 
+  /**
+   * @brief Waits for the running tasks and adds their LOD levels.
+   */
+  void wait();
+
+  /**
+   * @brief Returns the number of running tasks.
+   */
+  std::size_t getPendingCount() const;
+
 private:
-  ISimplifier* getSimplifier(const ISimplificationTask& task);
+  using DecimatedMesh = QuadraticErrorSimplification::DecimatedMesh;
+
+  struct RunningTask {
+    ISimplificationTask task;
+    Scene* scene;
+    unsigned int meshUniqueId;
+    std::shared_ptr<QuadraticErrorSimplification> simplifier;
+    // One decimation per setting, removed once added as LOD level
+    std::vector<std::pair<std::size_t, TaskHandle<DecimatedMesh>>> levels;
+  }; // end of struct RunningTask
+
+  std::shared_ptr<QuadraticErrorSimplification>
+  getSimplifier(const ISimplificationTask& task);
+  // Returns whether all the levels of the task were added
+  bool _addCompletedLevels(RunningTask& runningTask);
 
 public:
   bool running;
 
 private:
-  std::queue<ISimplificationTask> _simplificationQueue;
+  TaskScheduler& _scheduler;
+  std::vector<std::unique_ptr<RunningTask>> _runningTasks;
 
 }; // end of class SimplificationQueue
 
@@ -0,0 +1,175 @@
+#ifndef BABYLON_MESH_STATIC_BATCHER_H
+#define BABYLON_MESH_STATIC_BATCHER_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+/**
+ * @brief Merges static meshes sharing a material into shared vertex and index
+ * buffers, so that they are drawn with a draw call per batch instead of a draw
+ * call per mesh.
+ *
+ * The meshes are grouped by material, rendering settings and cell of a regular
+ * grid, a batch being a mesh of the scene holding the vertices of its members
+ * in world space. The batches are frustum culled as any other mesh, so the
+ * size of the cells trades the number of draw calls for the culling accuracy.
+ * When the scene has a selection octree, the batch meshes are part of its
+ * dynamic content, their bounds changing with their members.
+ *
+ * The members stay in the scene: they keep their bounding info and can still
+ * be picked or collided with, they are only skipped by the active meshes
+ * evaluation. The batcher keeps the vertex and index ranges of each member in
+ * its batch and, once per frame, checks the members for changes:
+ * - a member whose world matrix changed has its vertices transformed again in
+ *   place, its batch being uploaded again;
+ * - a member whose material, rendering settings, vertex data kinds or cell
+ *   changed moves to the batch of its new key;
+ * - a member which is hidden, disabled, made transparent, whose vertex count
+ *   changed, removed or disposed triggers the rebuild of its batch, the other
+ *   batches being left untouched.
+ * A member which is hidden, disabled or made transparent is rendered on its
+ * own again until it can be batched again.
+ */
+class BABYLON_SHARED_EXPORT StaticBatcher {
+
+public:
+  StaticBatcher(Scene* scene, float cellSize);
+  StaticBatcher(const StaticBatcher& other) = delete;
+  StaticBatcher& operator=(const StaticBatcher& other) = delete;
+  ~StaticBatcher();
+
+  float getCellSize() const;
+
+  /**
+   * @brief Returns whether or not a mesh can be batched: a mesh with a single
+   * submesh, indices, positions and only normals, uvs and colors as other
+   * vertex data, and without instances, skeleton, LOD levels, billboard mode
+   * or action manager.
+   */
+  static bool CanBatch(AbstractMesh* mesh);
+
+  /**
+   * @brief Adds a mesh to the batch of its material and cell.
+   * @return Whether or not the mesh was added, i.e. whether it can be batched
+   * and was not already.
+   */
+  bool addMesh(AbstractMesh* mesh);
+
+  /**
+   * @brief Adds the meshes of the scene which can be batched and whose world
+   * matrix is frozen.
+   * @return The number of meshes added.
+   */
+  std::size_t addStaticMeshes();
+
+  /**
+   * @brief Removes a mesh from its batch, the mesh being rendered on its own
+   * again.
+   * @return Whether or not the mesh was a member of a batch.
+   */
+  bool removeMesh(AbstractMesh* mesh);
+
+  /**
+   * @brief Flags the batch of a mesh to be rebuilt, to be called when the
+   * vertex data of the mesh is updated without changing its vertex count.
+   */
+  void markMeshAsDirty(AbstractMesh* mesh);
+
+  /**
+   * @brief Checks the members for changes and updates their batches, called
+   * by the scene before the evaluation of the active meshes.
+   */
+  void update();
+
+  /**
+   * @brief Removes all the meshes from their batches and disposes the batches.
+   */
+  void dispose();
+
+  /**
+   * @brief Called by the scene when a mesh is removed from it.
+   */
+  void _onMeshRemoved(AbstractMesh* mesh);
+
+  /** Statistics **/
+  std::size_t getMeshCount() const;
+  std::size_t getBatchCount() const;
+  // Batches rebuilt and batches whose vertices were uploaded again, in place,
+  // by the last update
+  std::size_t getRebuiltCount() const;
+  std::size_t getUpdatedCount() const;
+
+private:
+  struct Batch;
+
+  struct Member {
+    Mesh* mesh;
+    Batch* batch;
+    // World matrix update count of the mesh when its vertices were transformed
+    unsigned int worldMatrixUpdateCount;
+    // Whether the mesh is part of the geometry of its batch
+    bool active;
+    // Whether the winding of the triangles of the mesh is reversed by its
+    // world matrix
+    bool reversed;
+    // Range of the mesh in the buffers of its batch
+    std::size_t vertexStart;
+    std::size_t vertexCount;
+    std::size_t indexStart;
+    std::size_t indexCount;
+  }; // end of struct Member
+
+  // Material and rendering settings of the members of a batch
+  struct BatchKey {
+    Material* material;
+    // Vertex data kinds and flags
+    unsigned int layout;
+    unsigned int renderingGroupId;
+    unsigned int layerMask;
+    int x, y, z;
+    bool operator<(const BatchKey& other) const;
+    bool operator==(const BatchKey& other) const;
+  }; // end of struct BatchKey
+
+  struct Batch {
+    BatchKey key;
+    Mesh* mesh;
+    // Indices of the members in _members
+    std::vector<std::size_t> members;
+    std::vector<std::pair<unsigned int, Float32Array>> vertexData;
+    IndicesArray indices;
+    bool needsRebuild;
+    bool needsUpload;
+  }; // end of struct Batch
+
+  static unsigned int _GetLayout(Mesh* mesh);
+  static bool _CanBeActive(Mesh* mesh);
+  BatchKey _getKey(Mesh* mesh) const;
+  void _insert(std::size_t memberIndex);
+  void _detach(std::size_t memberIndex);
+  void _markAsDirty(Batch* batch, bool rebuild);
+  void _updateOctree();
+  void _addToOctree(Mesh* mesh);
+  void _transform(Member& member, Batch& batch);
+  void _rebuild(Batch& batch);
+  void _upload(Batch& batch);
+
+private:
+  Scene* _scene;
+  float _cellSize;
+  std::vector<Member> _members;
+  std::unordered_map<AbstractMesh*, std::size_t> _memberIndices;
+  std::map<BatchKey, std::unique_ptr<Batch>> _batches;
+  std::vector<Batch*> _dirtyBatches;
+  // Selection octree whose dynamic content holds the batch meshes
+  Octree<AbstractMesh*>* _octree;
+  std::size_t _batchNameCounter;
+  std::size_t _rebuiltCount;
+  std::size_t _updatedCount;
+
+}; // end of class StaticBatcher
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_MESH_STATIC_BATCHER_H
@@ -0,0 +1,86 @@
+#ifndef BABYLON_MESH_TRANSFORM_HIERARCHY_H
+#define BABYLON_MESH_TRANSFORM_HIERARCHY_H
+
+#include <babylon/babylon_global.h>
+
+namespace BABYLON {
+
+/**
+ * @brief Flat array of the meshes of a scene, sorted by depth so that parents
+ * come before their children, updating the world matrices of the meshes once
+ * per frame.
+ *
+ * The world matrix of a mesh is only computed again when its local transform
+ * changed or when the world matrix of its parent changed, the world matrices of
+ * a level of the hierarchy being multiplied by the world matrices of their
+ * parents in a single batch. Meshes whose world matrix depends on other nodes
+ * (parents which are not meshes of the scene, billboards, infinite distance
+ * meshes and meshes attached to bones) fall back to
+ * AbstractMesh::computeWorldMatrix().
+ */
+class BABYLON_SHARED_EXPORT TransformHierarchy {
+
+public:
+  TransformHierarchy(Scene* scene);
+  TransformHierarchy(const TransformHierarchy& other) = delete;
+  TransformHierarchy& operator=(const TransformHierarchy& other) = delete;
+  ~TransformHierarchy();
+
+  /**
+   * @brief Flags the hierarchy to be sorted again on the next update, called
+   * when meshes are added to or removed from the scene.
+   */
+  void markAsDirty();
+
+  /**
+   * @brief Brings the world matrices of all the meshes of the scene up to date
+   * for the current render id.
+   */
+  void update();
+
+  /**
+   * @brief Returns the number of meshes in the hierarchy.
+   */
+  std::size_t size() const;
+
+  /**
+   * @brief Returns the number of world matrices computed by the last update.
+   */
+  std::size_t updatedCount() const;
+
+private:
+  void _rebuild();
+  void _updateLevel(std::size_t start, std::size_t end, int renderId,
+                    bool sorted);
+
+private:
+  // Parent index of the meshes without parent
+  static constexpr int NoParent = -1;
+  // Parent index of the meshes whose parent is not a mesh of the scene
+  static constexpr int ExternalParent = -2;
+
+  struct Entry {
+    AbstractMesh* mesh;
+    // Parent of the mesh when the hierarchy was sorted
+    Node* parent;
+    int parentIndex;
+    // World matrix update count of the mesh at the end of the last update
+    unsigned int worldMatrixUpdateCount;
+  }; // end of struct Entry
+
+  Scene* _scene;
+  bool _isDirty;
+  std::vector<Entry> _entries;
+  // Start of each level of the hierarchy, followed by the number of entries
+  std::vector<std::size_t> _levels;
+  // Whether the world matrix of each entry changed during the last update
+  Uint8Array _changed;
+  // Entries of the current level whose world matrix is computed in batch
+  std::vector<std::size_t> _batch;
+  std::size_t _updatedCount;
+
+}; // end of class TransformHierarchy
+
+} // end of namespace BABYLON
+
+#endif // end of BABYLON_MESH_TRANSFORM_HIERARCHY_H
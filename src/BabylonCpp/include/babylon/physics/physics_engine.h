@@ -25,6 +25,36 @@ public:
    */
   void setTimeStep(float newTimeStep = 1.f / 60.f);
 
+  float getTimeStep() const;
+
+  /**
+   * Set the maximum number of physics steps run in a single frame.
+   * The frame time is consumed in steps of the time step, so a slow frame runs
+   * several steps. Beyond this number, the physics slow down instead of making
+   * the next frames even slower.
+   * default is 4.
+   * @param {number} maxSubSteps the maximum number of steps per frame.
+   */
+  void setMaxSubSteps(unsigned int maxSubSteps);
+
+  unsigned int getMaxSubSteps() const;
+
+  /**
+   * Enable or disable the interpolation of the objects between their last two
+   * physics states. Without it, the objects are rendered at their last physics
+   * state, which stutters when the frame rate is not the physics rate.
+   * default is enabled.
+   */
+  void setInterpolationEnabled(bool enabled);
+
+  bool isInterpolationEnabled() const;
+
+  /**
+   * The fraction of a time step elapsed since the last physics step, at which
+   * the objects are interpolated between their last two physics states.
+   */
+  float getInterpolationAlpha() const;
+
   void dispose(bool doNotRecurse = false) override;
   std::string getPhysicsPluginName() const;
 
@@ -77,6 +107,12 @@ public:
 private:
   bool _initialized;
   IPhysicsEnginePlugin* _physicsPlugin;
+  float _timeStep;
+  unsigned int _maxSubSteps;
+  // The frame time not consumed by a physics step yet
+  float _timeAccumulator;
+  float _interpolationAlpha;
+  bool _interpolationEnabled;
   std::vector<std::unique_ptr<PhysicsImpostor>> _impostors;
   std::vector<std::shared_ptr<PhysicsImpostorJoint>> _joints;
 
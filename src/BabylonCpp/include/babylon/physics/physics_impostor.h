@@ -148,6 +148,13 @@ public:
    */
   void afterStep();
 
+  /**
+   * Moves the object between the last two states of its body, alpha being the
+   * fraction of a time step elapsed since the last one. This function is
+   * executed by the physics engine.
+   */
+  void interpolate(float alpha);
+
   /**
    * Event and body object due to cannon's event-based architecture.
    */
@@ -218,6 +225,18 @@ private:
   std::vector<Joint> _joints;
   Vector3 _tmpPositionWithDelta;
   Quaternion _tmpRotationWithDelta;
+  // The transforms of the object after the previous and the last step
+  Vector3 _previousPosition;
+  Quaternion _previousRotation;
+  Vector3 _currentPosition;
+  Quaternion _currentRotation;
+  // The transform last given to the object by the physics engine, which is
+  // pushed to the body again only if the object was moved since
+  Vector3 _syncedPosition;
+  Quaternion _syncedRotation;
+  bool _isSynced;
+  // Whether the object is between two different transforms
+  bool _isMoving;
 
 }; // end of class PhysicsImpostor
 
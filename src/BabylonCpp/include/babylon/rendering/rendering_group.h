@@ -11,10 +11,10 @@ public:
   /**
    * Creates a new rendering group.
    * @param index The rendering group index
-   * @param opaqueSortCompareFn The opaque sort comparison function. If null no
-   * order is applied
+   * @param opaqueSortCompareFn The opaque sort comparison function. If null
+   * the sub meshes are sorted by state
    * @param alphaTestSortCompareFn The alpha test sort comparison function. If
-   * null no order is applied
+   * null the sub meshes are sorted by state
    * @param transparentSortCompareFn The transparent sort comparison function.
    * If null back to front + alpha index sort is applied
    */
@@ -30,14 +30,15 @@ public:
 
   /**
    * Set the opaque sort comparison function.
-   * If null the sub meshes will be render in the order they were created
+   * If null the sub meshes will be sorted by state, so that consecutive draws
+   * share their effect, material and vertex buffers, then front to back
    */
   void setOpaqueSortCompareFn(
     const std::function<int(SubMesh* a, SubMesh* b)>& value);
 
   /**
    * Set the alpha test sort comparison function.
-   * If null the sub meshes will be render in the order they were created
+   * If null the sub meshes will be sorted by state, as the opaque ones
    */
   void setAlphaTestSortCompareFn(
     const std::function<int(SubMesh* a, SubMesh* b)>& value);
@@ -155,6 +156,26 @@ private:
    */
   static void renderUnsorted(const std::vector<SubMesh*>& subMeshes);
 
+  /**
+   * Sorts the submeshes by their state sort keys, with a radix sort which
+   * keeps the order of the submeshes with equal keys.
+   * @param subMeshes The submeshes to sort
+   */
+  void _sortByState(std::vector<SubMesh*>& subMeshes);
+
+  /**
+   * Computes the state sort key of a submesh, which packs from its most to its
+   * least significant 16 bits the hashes of its effect, of its material and of
+   * its vertex buffers, then its depth bucket.
+   * @param subMesh The submesh
+   * @param cameraPosition The camera position
+   * @param maxDistance The distance of the farthest depth bucket
+   * @returns The sort key
+   */
+  static std::uint64_t _getStateSortKey(SubMesh* subMesh,
+                                        const Vector3& cameraPosition,
+                                        float maxDistance);
+
 public:
   unsigned int index;
   std::function<void()> onBeforeTransparentRendering;
@@ -177,6 +198,11 @@ private:
   std::function<void(const std::vector<SubMesh*>& subMeshes)>
     _renderTransparent;
 
+  // State sort keys and buffers of the radix sort, kept between frames
+  std::vector<std::uint64_t> _sortKeys;
+  std::vector<std::uint64_t> _sortKeysBuffer;
+  std::vector<SubMesh*> _sortSubMeshesBuffer;
+
 }; // end of class RenderingGroup
 
 } // end of namespace BABYLON
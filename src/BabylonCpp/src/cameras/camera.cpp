@@ -503,7 +503,7 @@ void Camera::dispose(bool /*doNotRecurse*/)
   _rigCameras.clear();
 
   // Postprocesses
-  for (size_t i = _postProcesses.size() - 1; i-- > 0;) {
+  for (size_t i = _postProcesses.size(); i-- > 0;) {
     _postProcesses[i]->dispose(this);
   }
 
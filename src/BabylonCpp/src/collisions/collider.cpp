@@ -11,6 +11,8 @@ Collider::Collider()
     , velocityWorld{Vector3::Zero()}
     , normalizedVelocity{Vector3::Zero()}
     , intersectionPointSet{false}
+    , collidedMesh{nullptr}
+    , collidedMeshId{std::numeric_limits<unsigned int>::max()}
     , _collisionPoint{Vector3::Zero()}
     , _planeIntersectionPoint{Vector3::Zero()}
     , _tempVector{Vector3::Zero()}
@@ -366,7 +368,7 @@ void Collider::_testTriangle(size_t faceIndex,
 }
 
 void Collider::_collide(std::vector<Plane>& trianglePlaneArray,
-                        const std::vector<Vector3> pts,
+                        const std::vector<Vector3>& pts,
                         const IndicesArray& indices, size_t indexStart,
                         size_t indexEnd, unsigned int decal, bool hasMaterial)
 {
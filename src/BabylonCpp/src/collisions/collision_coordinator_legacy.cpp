@@ -65,6 +65,11 @@ void CollisionCoordinatorLegacy::onMeshRemoved(AbstractMesh* /*mesh*/)
   // No update in legacy mode
 }
 
+void CollisionCoordinatorLegacy::onCameraRemoved(Camera* /*camera*/)
+{
+  // The positions are computed synchronously in legacy mode
+}
+
 void CollisionCoordinatorLegacy::onGeometryAdded(Geometry* /*mesh*/)
 {
   // No update in legacy mode
@@ -1,5 +1,6 @@
 #include <babylon/collisions/collision_coordinator_worker.h>
 
+#include <babylon/cameras/camera.h>
 #include <babylon/collisions/babylon_message.h>
 #include <babylon/collisions/collide_payload.h>
 #include <babylon/collisions/serialized_collider_to_worker.h>
@@ -20,7 +21,9 @@
 namespace BABYLON {
 
 CollisionCoordinatorWorker::CollisionCoordinatorWorker()
-    : _scaledPosition{Vector3::Zero()}
+    : _scene{nullptr}
+    , _onAfterRenderObserver{nullptr}
+    , _scaledPosition{Vector3::Zero()}
     , _scaledVelocity{Vector3::Zero()}
     , _init{false}
     , _runningUpdated{0}
@@ -107,7 +110,9 @@ void CollisionCoordinatorWorker::getNewPosition(
   if (!_init) {
     return;
   }
-  if (collisionIndex < _collisionsCallbackArray.size()) {
+  // A request for this index is still being processed by the worker
+  if (collisionIndex < _collisionsCallbackArray.size()
+      && _collisionsCallbackArray[collisionIndex]) {
     return;
   }
 
@@ -136,27 +141,44 @@ void CollisionCoordinatorWorker::getNewPosition(
   message.collidePayload = payload;
   message.taskType       = WorkerTaskType::COLLIDE;
 
-  _worker.postMessage(message);
+  _runningCollisionTask = true;
+  _worker.postMessage(std::move(message));
 }
 
 void CollisionCoordinatorWorker::init(Scene* scene)
 {
   _scene = scene;
-  _scene->registerAfterRender([this]() { _afterRender(); });
+  _onAfterRenderObserver
+    = _scene->onAfterRenderObservable.add([this]() { _afterRender(); });
 
   _worker.callbackHandler
-    = [this](const WorkerReply e) { _onMessageFromWorker(e); };
+    = [this](const WorkerReply& e) { _onMessageFromWorker(e); };
+
+  // The current state of the scene is queued now and sent once the worker is
+  // initialized, the meshes and geometries added in between being queued by
+  // the scene
+  for (auto& mesh : _scene->meshes) {
+    onMeshAdded(mesh.get());
+  }
+  for (auto& geometry : _scene->getGeometries()) {
+    onGeometryAdded(geometry.get());
+  }
 
   BabylonMessage message;
   message.taskType = WorkerTaskType::INIT;
 
-  _worker.postMessage(message);
+  _worker.postMessage(std::move(message));
 }
 
 void CollisionCoordinatorWorker::destroy()
 {
-  _scene->unregisterAfterRender([this]() { _afterRender(); });
+  if (_scene && _onAfterRenderObserver) {
+    _scene->onAfterRenderObservable.remove(_onAfterRenderObserver);
+    _onAfterRenderObserver = nullptr;
+  }
   _worker.terminate();
+  _worker.callbackHandler = nullptr;
+  _collisionsCallbackArray.clear();
 }
 
 void CollisionCoordinatorWorker::onMeshAdded(AbstractMesh* mesh)
@@ -175,6 +197,8 @@ void CollisionCoordinatorWorker::onMeshUpdated(AbstractMesh* mesh)
 void CollisionCoordinatorWorker::onMeshRemoved(AbstractMesh* mesh)
 {
   _toRemoveMeshesArray.emplace_back(mesh->uniqueId);
+  // The callback of a moveWithCollisions() request refers to the mesh
+  _cancelCollision(mesh->uniqueId);
 }
 
 void CollisionCoordinatorWorker::onGeometryAdded(Geometry* geometry)
@@ -195,13 +219,29 @@ void CollisionCoordinatorWorker::onGeometryDeleted(Geometry* geometry)
   _toRemoveGeometryArray.emplace_back(geometry->id);
 }
 
+void CollisionCoordinatorWorker::onCameraRemoved(Camera* camera)
+{
+  _cancelCollision(camera->uniqueId);
+}
+
+void CollisionCoordinatorWorker::_cancelCollision(unsigned int collisionIndex)
+{
+  if (collisionIndex < _collisionsCallbackArray.size()) {
+    _collisionsCallbackArray[collisionIndex] = nullptr;
+  }
+}
+
 void CollisionCoordinatorWorker::_afterRender()
 {
+  // Replies of the requests processed since the last frame
+  _worker.dispatchReplies();
+
   if (!_init) {
     return;
   }
 
-  if (_toRemoveGeometryArray.empty() && _toRemoveMeshesArray.empty()) {
+  if (_toRemoveGeometryArray.empty() && _toRemoveMeshesArray.empty()
+      && _addUpdateGeometriesList.empty() && _addUpdateMeshesList.empty()) {
     return;
   }
 
@@ -214,31 +254,18 @@ void CollisionCoordinatorWorker::_afterRender()
 
   ++_runningUpdated;
 
-  UpdatePayload payload;
-  payload.updatedMeshes     = _addUpdateMeshesList;
-  payload.updatedGeometries = _addUpdateGeometriesList;
-  payload.removedGeometries = _toRemoveGeometryArray;
-  payload.removedMeshes     = _toRemoveMeshesArray;
-
+  // The serialized meshes and geometries are transferred to the worker, not
+  // copied
   BabylonMessage message;
-  message.updatePayload = payload;
-  message.taskType      = WorkerTaskType::UPDATE;
-
-  std::vector<ArrayBufferView> serializable;
-  for (auto item : payload.updatedGeometries) {
-    const std::string& id = item.first;
-    if (std_util::contains(payload.updatedGeometries, id)) {
-      // prepare transferables
-      serializable.emplace_back(
-        ArrayBufferView(message.updatePayload.updatedGeometries[id].indices));
-      serializable.emplace_back(
-        ArrayBufferView(message.updatePayload.updatedGeometries[id].normals));
-      serializable.emplace_back(
-        ArrayBufferView(message.updatePayload.updatedGeometries[id].positions));
-    }
-  }
+  message.taskType = WorkerTaskType::UPDATE;
+
+  UpdatePayload& payload    = message.updatePayload;
+  payload.updatedMeshes     = std::move(_addUpdateMeshesList);
+  payload.updatedGeometries = std::move(_addUpdateGeometriesList);
+  payload.removedGeometries = std::move(_toRemoveGeometryArray);
+  payload.removedMeshes     = std::move(_toRemoveMeshesArray);
 
-  _worker.postMessage(message, serializable);
+  _worker.postMessage(std::move(message));
   _addUpdateMeshesList.clear();
   _addUpdateGeometriesList.clear();
   _toRemoveGeometryArray.clear();
@@ -258,13 +285,6 @@ void CollisionCoordinatorWorker::_onMessageFromWorker(
   switch (returnData.taskType) {
     case WorkerTaskType::INIT: {
       _init = true;
-      // Update the worked with ALL of the scene's current state
-      for (auto& mesh : _scene->meshes) {
-        onMeshAdded(mesh.get());
-      }
-      for (auto& geometry : _scene->getGeometries()) {
-        onGeometryAdded(geometry.get());
-      }
     } break;
     case WorkerTaskType::UPDATE:
       --_runningUpdated;
@@ -273,15 +293,20 @@ void CollisionCoordinatorWorker::_onMessageFromWorker(
       _runningCollisionTask = false;
       const CollisionReplyPayload& returnPayload
         = returnData.collisionReplyPayload;
+      // The requests of the removed meshes and cameras have no callback
       if (returnPayload.collisionId >= _collisionsCallbackArray.size()) {
         return;
       }
-      //_collisionsCallbackArray[returnPayload.collisionId](
-      //  returnPayload.collisionId,
-      //  Vector3::FromArray(returnPayload.newPosition),
-      //  _scene->getMeshByUniqueID(returnPayload.collidedMeshUniqueId));
-      // cleanup
+      // cleanup before running the callback, so that it can issue a new
+      // request with the same collision index
+      auto callback
+        = std::move(_collisionsCallbackArray[returnPayload.collisionId]);
       _collisionsCallbackArray[returnPayload.collisionId] = nullptr;
+      if (callback) {
+        auto newPosition = Vector3::FromArray(returnPayload.newPosition);
+        callback(returnPayload.collisionId, newPosition,
+                 _scene->getMeshByUniqueID(returnPayload.collidedMeshUniqueId));
+      }
     } break;
   }
 }
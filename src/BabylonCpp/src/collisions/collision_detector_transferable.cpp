@@ -59,17 +59,18 @@ CollisionDetectorTransferable::onCollision(const CollidePayload& payload)
 {
   Vector3 finalPosition = Vector3::Zero();
   // Create a new collider
-  Collider* collider = new Collider();
-  collider->radius   = Vector3::FromArray(payload.collider.radius);
-  // Create new collide worker
-  CollideWorker colliderWorker(collider, *_collisionCache.get(), finalPosition);
+  Collider collider;
+  collider.radius = Vector3::FromArray(payload.collider.radius);
+  // Create new collide worker, the collision cache is shared between requests
+  // so that the transformed vertices of static meshes are reused
+  CollideWorker colliderWorker(&collider, *_collisionCache, finalPosition);
   Vector3 position = Vector3::FromArray(payload.collider.position);
   Vector3 velocity = Vector3::FromArray(payload.collider.velocity);
   colliderWorker.collideWithWorld(position, velocity, payload.maximumRetry,
                                   payload.excludedMeshUniqueId);
   CollisionReplyPayload replyPayload;
-  replyPayload.collidedMeshUniqueId = collider->collidedMeshId,
-  replyPayload.collisionId          = payload.collisionId,
+  replyPayload.collidedMeshUniqueId = collider.collidedMeshId;
+  replyPayload.collisionId          = payload.collisionId;
   replyPayload.newPosition          = finalPosition.asArray();
 
   WorkerReply reply;
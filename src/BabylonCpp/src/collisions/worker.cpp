@@ -1,11 +1,11 @@
 #include <babylon/collisions/worker.h>
 
 #include <babylon/collisions/babylon_message.h>
-#include <babylon/collisions/worker_reply.h>
+#include <babylon/core/task_scheduler.h>
 
 namespace BABYLON {
 
-Worker::Worker()
+Worker::Worker() : _tasks{std_util::make_unique<SerialTaskQueue>()}
 {
 }
 
@@ -13,28 +13,51 @@ Worker::~Worker()
 {
 }
 
-void Worker::postMessage(const BabylonMessage& message)
+void Worker::postMessage(BabylonMessage&& message)
 {
-  switch (message.taskType) {
-    case WorkerTaskType::INIT:
-      callbackHandler(collisionDetector.onInit(message.initPayload));
-      break;
-    case WorkerTaskType::COLLIDE:
-      callbackHandler(collisionDetector.onCollision(message.collidePayload));
-      break;
-    case WorkerTaskType::UPDATE:
-      callbackHandler(collisionDetector.onUpdate(message.updatePayload));
-      break;
+  if (!_tasks) {
+    return;
   }
+
+  _tasks->send([this, message = std::move(message)]() {
+    _replies.push(_processMessage(message));
+  });
 }
 
-void Worker::postMessage(const BabylonMessage& /*message*/,
-                         const std::vector<ArrayBufferView>& /*serializable*/)
+size_t Worker::dispatchReplies()
 {
+  size_t dispatched = 0;
+  WorkerReply reply;
+  while (_replies.tryAndPop(reply)) {
+    if (callbackHandler) {
+      callbackHandler(reply);
+    }
+    ++dispatched;
+  }
+  return dispatched;
 }
 
 void Worker::terminate()
 {
+  // Waits for the pending messages
+  _tasks.reset(nullptr);
+}
+
+WorkerReply Worker::_processMessage(const BabylonMessage& message)
+{
+  switch (message.taskType) {
+    case WorkerTaskType::INIT:
+      return collisionDetector.onInit(message.initPayload);
+    case WorkerTaskType::COLLIDE:
+      return collisionDetector.onCollision(message.collidePayload);
+    case WorkerTaskType::UPDATE:
+      return collisionDetector.onUpdate(message.updatePayload);
+  }
+
+  WorkerReply reply;
+  reply.error    = WorkerReplyType::UNKNOWN_ERROR;
+  reply.taskType = message.taskType;
+  return reply;
 }
 
 } // end of namespace BABYLON
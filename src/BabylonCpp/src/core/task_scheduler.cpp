@@ -0,0 +1,328 @@
+#include <babylon/core/task_scheduler.h>
+
+namespace BABYLON {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Scheduler and worker index of the calling thread, if it is a worker thread
+thread_local TaskScheduler* currentScheduler = nullptr;
+thread_local std::size_t currentWorkerIndex  = 0;
+// Number of tasks being executed by the calling thread, tasks executed while
+// waiting inside another task are not accounted twice in the busy time
+thread_local unsigned int executionDepth = 0;
+
+std::int64_t now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           Clock::now().time_since_epoch())
+    .count();
+}
+
+} // end of anonymous namespace
+
+struct TaskScheduler::Worker {
+  std::mutex mutex;
+  std::deque<Callback> tasks;
+  std::thread thread;
+  std::atomic<std::size_t> executedTasks{0};
+  std::atomic<std::size_t> stolenTasks{0};
+  std::atomic<std::int64_t> busyTime{0};
+}; // end of struct Worker
+
+TaskScheduler& TaskScheduler::Instance()
+{
+  static TaskScheduler scheduler;
+  return scheduler;
+}
+
+std::size_t TaskScheduler::DefaultWorkerCount()
+{
+  const std::size_t concurrency = std::thread::hardware_concurrency();
+  return concurrency > 1 ? concurrency - 1 : 1;
+}
+
+TaskScheduler::TaskScheduler(std::size_t workerCount)
+    : _pendingTasks{0}
+    , _sleepingWorkers{0}
+    , _done{false}
+    , _statisticsStart{now()}
+{
+  _workers.reserve(workerCount);
+  for (std::size_t i = 0; i < workerCount; ++i) {
+    _workers.emplace_back(std_util::make_unique<Worker>());
+  }
+  // Started once all the queues exist, as the workers steal from each other
+  for (std::size_t i = 0; i < workerCount; ++i) {
+    _workers[i]->thread = std::thread(&TaskScheduler::_run, this, i);
+  }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _done = true;
+  }
+  _wakeUp.notify_all();
+  for (auto& worker : _workers) {
+    worker->thread.join();
+  }
+  // Tasks sent by the last running tasks
+  Callback task;
+  bool stolen;
+  while (_popTask(task, stolen)) {
+    task();
+  }
+}
+
+void TaskScheduler::send(Callback task)
+{
+  // Counted before being queued so that the counter never underflows, pairs
+  // with the registration of a sleeping worker in _run()
+  _pendingTasks.fetch_add(1);
+  if (currentScheduler == this) {
+    auto& worker = *_workers[currentWorkerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.emplace_back(std::move(task));
+  }
+  else {
+    std::lock_guard<std::mutex> lock(_injectedTasksMutex);
+    _injectedTasks.emplace_back(std::move(task));
+  }
+
+  if (_sleepingWorkers.load() > 0) {
+    {
+      std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    _wakeUp.notify_one();
+  }
+}
+
+bool TaskScheduler::runPendingTask()
+{
+  Callback task;
+  bool stolen = false;
+  if (!_popTask(task, stolen)) {
+    return false;
+  }
+  _execute(task, currentScheduler == this ?
+                   _workers[currentWorkerIndex].get() :
+                   nullptr,
+           stolen);
+  return true;
+}
+
+bool TaskScheduler::isWorkerThread() const
+{
+  return currentScheduler == this;
+}
+
+std::size_t TaskScheduler::workerCount() const
+{
+  return _workers.size();
+}
+
+std::vector<TaskSchedulerStatistics> TaskScheduler::statistics() const
+{
+  const std::chrono::nanoseconds elapsedTime(now() - _statisticsStart.load());
+  std::vector<TaskSchedulerStatistics> result(_workers.size());
+  for (std::size_t i = 0; i < _workers.size(); ++i) {
+    const auto& worker       = *_workers[i];
+    auto& statistics         = result[i];
+    statistics.executedTasks = worker.executedTasks.load();
+    statistics.stolenTasks   = worker.stolenTasks.load();
+    statistics.busyTime      = std::chrono::nanoseconds(worker.busyTime.load());
+    statistics.elapsedTime   = elapsedTime;
+  }
+  return result;
+}
+
+void TaskScheduler::resetStatistics()
+{
+  for (auto& worker : _workers) {
+    worker->executedTasks = 0;
+    worker->stolenTasks   = 0;
+    worker->busyTime      = 0;
+  }
+  _statisticsStart = now();
+}
+
+void TaskScheduler::_run(std::size_t workerIndex)
+{
+  currentScheduler   = this;
+  currentWorkerIndex = workerIndex;
+  auto worker        = _workers[workerIndex].get();
+
+  Callback task;
+  bool stolen = false;
+  for (;;) {
+    if (_popTask(task, stolen)) {
+      _execute(task, worker, stolen);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    _sleepingWorkers.fetch_add(1);
+    while (!_done && _pendingTasks.load() == 0) {
+      _wakeUp.wait(lock);
+    }
+    _sleepingWorkers.fetch_sub(1);
+    if (_done && _pendingTasks.load() == 0) {
+      break;
+    }
+  }
+
+  currentScheduler = nullptr;
+}
+
+bool TaskScheduler::_popTask(Callback& task, bool& stolen)
+{
+  if (_pendingTasks.load() == 0) {
+    return false;
+  }
+
+  const auto take = [&task](std::deque<Callback>& tasks, bool back) {
+    if (tasks.empty()) {
+      return false;
+    }
+    if (back) {
+      task = std::move(tasks.back());
+      tasks.pop_back();
+    }
+    else {
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    return true;
+  };
+
+  // Most recent task of the own queue first, as its data is likely cached
+  const bool isWorker = currentScheduler == this;
+  if (isWorker) {
+    auto& worker = *_workers[currentWorkerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (take(worker.tasks, true)) {
+      --_pendingTasks;
+      stolen = false;
+      return true;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_injectedTasksMutex);
+    if (take(_injectedTasks, false)) {
+      --_pendingTasks;
+      stolen = false;
+      return true;
+    }
+  }
+
+  // Oldest task of the other queues
+  const auto first = isWorker ? currentWorkerIndex + 1 : 0;
+  for (std::size_t i = 0; i < _workers.size(); ++i) {
+    auto& victim = *_workers[(first + i) % _workers.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (take(victim.tasks, false)) {
+      --_pendingTasks;
+      stolen = isWorker;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void TaskScheduler::_execute(Callback& task, Worker* worker, bool stolen)
+{
+  const bool measure = worker && executionDepth == 0;
+  const auto start   = measure ? now() : 0;
+  ++executionDepth;
+  task();
+  --executionDepth;
+  // Releases the captured state before the task is considered complete
+  task = nullptr;
+  if (!worker) {
+    return;
+  }
+
+  if (measure) {
+    worker->busyTime += now() - start;
+  }
+  ++worker->executedTasks;
+  if (stolen) {
+    ++worker->stolenTasks;
+  }
+}
+
+SerialTaskQueue::SerialTaskQueue(TaskScheduler& scheduler)
+    : _scheduler{scheduler}, _state{std::make_shared<State>()}
+{
+}
+
+SerialTaskQueue::~SerialTaskQueue()
+{
+  wait();
+}
+
+void SerialTaskQueue::send(Callback task)
+{
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->tasks.emplace_back(std::move(task));
+    if (_state->running) {
+      return;
+    }
+    _state->running = true;
+  }
+  auto state = _state;
+  _scheduler.send([state]() { _Drain(*state); });
+}
+
+void SerialTaskQueue::wait()
+{
+  auto& state = *_state;
+  std::unique_lock<std::mutex> lock(state.mutex);
+  while (state.running) {
+    // The drain task may be queued behind a long task, in which case the
+    // tasks of this queue only are run here
+    if (!state.draining) {
+      lock.unlock();
+      _Drain(state);
+      lock.lock();
+      continue;
+    }
+    state.idle.wait(lock, [&state]() { return !state.draining; });
+  }
+}
+
+void SerialTaskQueue::_Drain(State& state)
+{
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    // Drained by a waiting thread or by another drain task already
+    if (!state.running || state.draining) {
+      return;
+    }
+    state.draining = true;
+  }
+
+  Callback task;
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      if (state.tasks.empty()) {
+        state.running  = false;
+        state.draining = false;
+        state.idle.notify_all();
+        return;
+      }
+      task = std::move(state.tasks.front());
+      state.tasks.pop_front();
+    }
+    task();
+  }
+}
+
+} // end of namespace BABYLON
@@ -3,6 +3,7 @@
 #include <babylon/collisions/collider.h>
 #include <babylon/culling/bounding_box.h>
 #include <babylon/culling/bounding_sphere.h>
+#include <babylon/culling/bounding_volume_arrays.h>
 
 namespace BABYLON {
 
@@ -12,6 +13,8 @@ BoundingInfo::BoundingInfo(const Vector3& iMinimum, const Vector3& iMaximum)
     , boundingBox{BoundingBox(iMinimum, iMaximum)}
     , boundingSphere{BoundingSphere(iMinimum, iMaximum)}
     , _isLocked{false}
+    , _volumes{nullptr}
+    , _volumesIndex{0}
 {
 }
 
@@ -21,11 +24,33 @@ BoundingInfo::BoundingInfo(const BoundingInfo& boundingInfo)
     , boundingBox{BoundingBox(boundingInfo.boundingBox)}
     , boundingSphere{BoundingSphere(boundingInfo.boundingSphere)}
     , _isLocked{boundingInfo._isLocked}
+    , _volumes{nullptr}
+    , _volumesIndex{0}
 {
 }
 
+BoundingInfo& BoundingInfo::operator=(const BoundingInfo& other)
+{
+  if (&other != this) {
+    minimum        = other.minimum;
+    maximum        = other.maximum;
+    boundingBox    = other.boundingBox;
+    boundingSphere = other.boundingSphere;
+    _isLocked      = other._isLocked;
+    // Keeps mirroring its world bounding volumes, if attached
+    if (_volumes) {
+      _volumes->_update(_volumesIndex, *this);
+    }
+  }
+
+  return *this;
+}
+
 BoundingInfo::~BoundingInfo()
 {
+  if (_volumes) {
+    _volumes->detach(_volumesIndex);
+  }
 }
 
 bool BoundingInfo::isLocked() const
@@ -46,6 +71,9 @@ void BoundingInfo::update(const Matrix& world)
   }
   boundingBox._update(world);
   boundingSphere._update(world);
+  if (_volumes) {
+    _volumes->_update(_volumesIndex, *this);
+  }
 }
 
 bool BoundingInfo::isInFrustum(const std::array<Plane, 6>& frustumPlanes)
@@ -0,0 +1,205 @@
+#include <babylon/culling/bounding_volume_arrays.h>
+
+#include <babylon/culling/bounding_info.h>
+#include <babylon/math/plane.h>
+#include <babylon/math/simd/float32x4.h>
+
+namespace BABYLON {
+
+constexpr std::size_t BoundingVolumeArrays::ObjectsPerWord;
+
+BoundingVolumeArrays::BoundingVolumeArrays() : _count{0}
+{
+}
+
+BoundingVolumeArrays::~BoundingVolumeArrays()
+{
+  resize(0);
+}
+
+void BoundingVolumeArrays::resize(std::size_t count)
+{
+  for (std::size_t i = count; i < _count; ++i) {
+    detach(i);
+    _setBit(_alwaysVisible, i, false);
+    _setBit(_culled, i, false);
+  }
+  _count = count;
+
+  // Padded to whole words, the padding objects are culled
+  const std::size_t paddedCount = wordCount() * ObjectsPerWord;
+  _boundingInfos.resize(count, nullptr);
+  for (auto array :
+       {&_sphereX, &_sphereY, &_sphereZ, &_boxX, &_boxY, &_boxZ}) {
+    array->resize(paddedCount, 0.f);
+  }
+  for (auto& array : _boxAxes) {
+    array.resize(paddedCount, 0.f);
+  }
+  _sphereRadius.resize(paddedCount, -std::numeric_limits<float>::max());
+  _alwaysVisible.resize(wordCount(), 0);
+  _culled.resize(wordCount(), 0);
+}
+
+std::size_t BoundingVolumeArrays::size() const
+{
+  return _count;
+}
+
+std::size_t BoundingVolumeArrays::wordCount() const
+{
+  return (_count + ObjectsPerWord - 1) / ObjectsPerWord;
+}
+
+void BoundingVolumeArrays::attach(std::size_t index,
+                                  BoundingInfo& boundingInfo)
+{
+  if (_boundingInfos[index] == &boundingInfo) {
+    return;
+  }
+
+  detach(index);
+  if (boundingInfo._volumes) {
+    boundingInfo._volumes->detach(boundingInfo._volumesIndex);
+  }
+  _boundingInfos[index]      = &boundingInfo;
+  boundingInfo._volumes      = this;
+  boundingInfo._volumesIndex = index;
+  _update(index, boundingInfo);
+}
+
+void BoundingVolumeArrays::detach(std::size_t index)
+{
+  auto boundingInfo = _boundingInfos[index];
+  if (!boundingInfo) {
+    return;
+  }
+
+  boundingInfo->_volumes = nullptr;
+  _boundingInfos[index]  = nullptr;
+  _sphereRadius[index]   = -std::numeric_limits<float>::max();
+}
+
+void BoundingVolumeArrays::setAlwaysVisible(std::size_t index, bool value)
+{
+  _setBit(_alwaysVisible, index, value);
+}
+
+void BoundingVolumeArrays::setCulled(std::size_t index, bool value)
+{
+  _setBit(_culled, index, value);
+}
+
+void BoundingVolumeArrays::_update(std::size_t index,
+                                   const BoundingInfo& boundingInfo)
+{
+  const auto& sphere   = boundingInfo.boundingSphere;
+  _sphereX[index]      = sphere.centerWorld.x;
+  _sphereY[index]      = sphere.centerWorld.y;
+  _sphereZ[index]      = sphere.centerWorld.z;
+  _sphereRadius[index] = sphere.radiusWorld;
+
+  // The world corners are the minimum, the maximum, and the minimum with one
+  // coordinate of the maximum (see the BoundingBox constructor)
+  const auto& corners = boundingInfo.boundingBox.vectorsWorld;
+  const auto& minimum = corners[0];
+  const auto& maximum = corners[1];
+  _boxX[index]        = (minimum.x + maximum.x) * 0.5f;
+  _boxY[index]        = (minimum.y + maximum.y) * 0.5f;
+  _boxZ[index]        = (minimum.z + maximum.z) * 0.5f;
+  for (unsigned int axis = 0; axis < 3; ++axis) {
+    const auto& corner            = corners[axis + 2];
+    _boxAxes[axis * 3][index]     = (corner.x - minimum.x) * 0.5f;
+    _boxAxes[axis * 3 + 1][index] = (corner.y - minimum.y) * 0.5f;
+    _boxAxes[axis * 3 + 2][index] = (corner.z - minimum.z) * 0.5f;
+  }
+}
+
+void BoundingVolumeArrays::_setBit(Uint32Array& bits, std::size_t index,
+                                   bool value)
+{
+  const std::uint32_t bit = 1u << (index % ObjectsPerWord);
+  if (value) {
+    bits[index / ObjectsPerWord] |= bit;
+  }
+  else {
+    bits[index / ObjectsPerWord] &= ~bit;
+  }
+}
+
+void BoundingVolumeArrays::cull(const std::array<Plane, 6>& frustumPlanes,
+                                Uint32Array& visibility) const
+{
+  visibility.resize(wordCount());
+  cull(frustumPlanes, 0, visibility.size(), visibility.data());
+}
+
+void BoundingVolumeArrays::cull(const std::array<Plane, 6>& frustumPlanes,
+                                std::size_t startWord, std::size_t endWord,
+                                std::uint32_t* visibility) const
+{
+  using SIMD::Float32x4;
+
+  std::array<Float32x4, 6> normalX, normalY, normalZ, d;
+  for (unsigned int p = 0; p < 6; ++p) {
+    normalX[p] = Float32x4(frustumPlanes[p].normal.x);
+    normalY[p] = Float32x4(frustumPlanes[p].normal.y);
+    normalZ[p] = Float32x4(frustumPlanes[p].normal.z);
+    d[p]       = Float32x4(frustumPlanes[p].d);
+  }
+  const auto load = [](const Float32Array& array, std::size_t i) {
+    return Float32x4(_mm_loadu_ps(array.data() + i));
+  };
+  const Float32x4 zero;
+
+  for (std::size_t word = startWord; word < endWord; ++word) {
+    std::uint32_t visibleBits = 0;
+    for (std::size_t group = 0; group < ObjectsPerWord; group += 4) {
+      const std::size_t i = word * ObjectsPerWord + group;
+
+      // Spheres, culled when behind a plane by more than their radius
+      const auto sphereX     = load(_sphereX, i);
+      const auto sphereY     = load(_sphereY, i);
+      const auto sphereZ     = load(_sphereZ, i);
+      const auto minusRadius = zero - load(_sphereRadius, i);
+      Float32x4 culled;
+      for (unsigned int p = 0; p < 6; ++p) {
+        const auto distance = normalX[p] * sphereX + normalY[p] * sphereY
+                              + normalZ[p] * sphereZ + d[p];
+        culled = culled
+                 | Float32x4::lessThanOrEqual(distance.xmm, minusRadius.xmm);
+      }
+      if (Float32x4::signMask(culled.xmm) == 0xF) {
+        continue;
+      }
+
+      // Boxes, culled when their farthest corner along the normal of a plane
+      // is behind it
+      const auto boxX = load(_boxX, i);
+      const auto boxY = load(_boxY, i);
+      const auto boxZ = load(_boxZ, i);
+      std::array<Float32x4, 9> axes;
+      for (unsigned int k = 0; k < 9; ++k) {
+        axes[k] = load(_boxAxes[k], i);
+      }
+      for (unsigned int p = 0; p < 6; ++p) {
+        const auto distance = normalX[p] * boxX + normalY[p] * boxY
+                              + normalZ[p] * boxZ + d[p];
+        Float32x4 extent;
+        for (unsigned int axis = 0; axis < 9; axis += 3) {
+          extent += Float32x4::abs((normalX[p] * axes[axis]
+                                    + normalY[p] * axes[axis + 1]
+                                    + normalZ[p] * axes[axis + 2])
+                                     .xmm);
+        }
+        culled = culled
+                 | Float32x4::lessThan((distance + extent).xmm, zero.xmm);
+      }
+
+      visibleBits |= (~Float32x4::signMask(culled.xmm) & 0xFu) << group;
+    }
+    visibility[word] = (visibleBits & ~_culled[word]) | _alwaysVisible[word];
+  }
+}
+
+} // end of namespace BABYLON
@@ -1,28 +1,94 @@
 #include <babylon/culling/octrees/octree.h>
 
+#include <babylon/core/task_scheduler.h>
 #include <babylon/culling/bounding_box.h>
 #include <babylon/culling/bounding_info.h>
-#include <babylon/culling/octrees/octree_block.h>
-#include <babylon/math/vector3.h>
+#include <babylon/culling/ray.h>
+#include <babylon/math/plane.h>
 #include <babylon/mesh/abstract_mesh.h>
 #include <babylon/mesh/sub_mesh.h>
 
 namespace BABYLON {
 
+namespace {
+
+// Entries processed by a task of the octree construction
+constexpr size_t BuildGrainSize = 4096;
+
+// Same result as BoundingBox::IsInFrustum() on the 8 corners of the box, only
+// the corner furthest along the normal of each plane being tested
+bool isInFrustum(const Vector3& minPoint, const Vector3& maxPoint,
+                 const std::array<Plane, 6>& frustumPlanes)
+{
+  for (const auto& plane : frustumPlanes) {
+    const Vector3 corner(plane.normal.x >= 0.f ? maxPoint.x : minPoint.x,
+                         plane.normal.y >= 0.f ? maxPoint.y : minPoint.y,
+                         plane.normal.z >= 0.f ? maxPoint.z : minPoint.z);
+    if (plane.dotCoordinate(corner) < 0.f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Same test as BoundingBox::intersectsMinMax()
+bool intersectsMinMax(const Vector3& minimum, const Vector3& maximum,
+                      const Vector3& minPoint, const Vector3& maxPoint)
+{
+  return !(maximum.x < minPoint.x || minimum.x > maxPoint.x
+           || maximum.y < minPoint.y || minimum.y > maxPoint.y
+           || maximum.z < minPoint.z || minimum.z > maxPoint.z);
+}
+
+// Bit 0 is set when [minimum, maximum] intersects [lowerMin, lowerMax] and bit
+// 1 when it intersects [upperMin, upperMax]
+unsigned int intersectedHalves(float minimum, float maximum, float lowerMin,
+                               float lowerMax, float upperMin, float upperMax)
+{
+  const bool lower = !(maximum < lowerMin || minimum > lowerMax);
+  const bool upper = !(maximum < upperMin || minimum > upperMax);
+  return (lower ? 1u : 0u) | (upper ? 2u : 0u);
+}
+
+// Bit x * 4 + y * 2 + z is set when the box intersects the inner block
+// (x, y, z) of the 8 blocks starting with lower and ending with upper
+uint8_t intersectedBlocks(const Vector3& minimum, const Vector3& maximum,
+                          const Vector3& lowerMin, const Vector3& lowerMax,
+                          const Vector3& upperMin, const Vector3& upperMax)
+{
+  const unsigned int xs = intersectedHalves(
+    minimum.x, maximum.x, lowerMin.x, lowerMax.x, upperMin.x, upperMax.x);
+  const unsigned int ys = intersectedHalves(
+    minimum.y, maximum.y, lowerMin.y, lowerMax.y, upperMin.y, upperMax.y);
+  const unsigned int zs = intersectedHalves(
+    minimum.z, maximum.z, lowerMin.z, lowerMax.z, upperMin.z, upperMax.z);
+  unsigned int blocks = 0;
+  for (unsigned int x = 0; x < 2; ++x) {
+    for (unsigned int y = 0; y < 2; ++y) {
+      for (unsigned int z = 0; z < 2; ++z) {
+        if ((xs >> x) & (ys >> y) & (zs >> z) & 1) {
+          blocks |= 1u << (x * 4 + y * 2 + z);
+        }
+      }
+    }
+  }
+  return static_cast<uint8_t>(blocks);
+}
+
+} // end of anonymous namespace
+
 template <class T>
-Octree<T>::Octree()
+Octree<T>::Octree() : _maxBlockCapacity{64}, _maxDepth{2}
 {
 }
 
 template <class T>
-Octree<T>::Octree(
-  const std::function<void(T& entry, OctreeBlock<T>& block)>& creationFunc,
-  size_t maxBlockCapacity, size_t maxDepth)
+Octree<T>::Octree(const BoundsFunc& boundsFunc, size_t maxBlockCapacity,
+                  size_t maxDepth)
     : _maxBlockCapacity{maxBlockCapacity}
     , _maxDepth{maxDepth}
-    , _creationFunc{creationFunc}
+    , _boundsFunc{boundsFunc}
 {
-  _selectionContent.resize(1024);
 }
 
 template <class T>
@@ -34,81 +100,392 @@ template <class T>
 void Octree<T>::update(const Vector3& worldMin, const Vector3& worldMax,
                        std::vector<T>& entries)
 {
-  Octree<T>::_CreateBlocks(worldMin, worldMax, entries, _maxBlockCapacity, 0,
-                           _maxDepth, *this, _creationFunc);
+  _entries.clear();
+  _entriesMin.clear();
+  _entriesMax.clear();
+  _blockEntries.clear();
+
+  // Bounding boxes, gathered once for all the blocks
+  Vector3 minimum, maximum;
+  for (auto& entry : entries) {
+    if (_boundsFunc(entry, minimum, maximum)) {
+      _entries.emplace_back(entry);
+      _entriesMin.emplace_back(minimum);
+      _entriesMax.emplace_back(maximum);
+    }
+  }
+  _selection.marks.assign((_entries.size() + 63) / 64, 0);
+
+  // The first level is made of the 8 blocks of the world, holding all the
+  // entries
+  IOctreeContainer<T>::blocks.clear();
+  Octree<T>::_CreateBlocks(worldMin, worldMax, 1, *this);
+  std::vector<size_t> groups{0};
+  std::vector<uint32_t> levelEntries(_entries.size());
+  std::iota(levelEntries.begin(), levelEntries.end(), 0u);
+  std::vector<size_t> levelStarts{0, levelEntries.size()};
+
+  _distributeEntries(groups, levelEntries, levelStarts);
+}
+
+template <class T>
+void Octree<T>::_distributeEntries(std::vector<size_t>& groups,
+                                   std::vector<uint32_t>& levelEntries,
+                                   std::vector<size_t>& levelStarts)
+{
+  auto& blocks    = IOctreeContainer<T>::blocks;
+  auto& scheduler = TaskScheduler::Instance();
+  std::vector<uint8_t> intersections;
+  std::vector<size_t> counts, offsets;
+  std::vector<size_t> nextGroups, nextStarts;
+  std::vector<uint32_t> nextEntries;
+
+  // Each group is made of the 8 inner blocks of a block of the previous level,
+  // and levelEntries holds the entries of that block from levelStarts[group]
+  while (!groups.empty()) {
+    const size_t groupCount = groups.size();
+
+    // Inner blocks intersected by each entry of the level
+    intersections.resize(levelEntries.size());
+    scheduler.parallelFor(
+      0, levelEntries.size(),
+      [&](size_t begin, size_t end) {
+        size_t group = static_cast<size_t>(
+          std::upper_bound(levelStarts.begin(), levelStarts.end(), begin)
+          - levelStarts.begin() - 1);
+        for (size_t i = begin; i < end; ++i) {
+          while (i >= levelStarts[group + 1]) {
+            ++group;
+          }
+          const auto& lower = blocks[groups[group]];
+          const auto& upper = blocks[groups[group] + 7];
+          const auto entry  = levelEntries[i];
+          intersections[i]  = intersectedBlocks(
+            _entriesMin[entry], _entriesMax[entry], lower._minPoint,
+            lower._maxPoint, upper._minPoint, upper._maxPoint);
+        }
+      },
+      BuildGrainSize);
+
+    // Entry count of each block
+    counts.assign(groupCount * 8, 0);
+    scheduler.parallelFor(0, groupCount, [&](size_t begin, size_t end) {
+      for (size_t group = begin; group < end; ++group) {
+        auto count = counts.begin() + static_cast<std::ptrdiff_t>(group * 8);
+        for (size_t i = levelStarts[group]; i < levelStarts[group + 1]; ++i) {
+          for (unsigned int block = 0; block < 8; ++block) {
+            count[block] += (intersections[i] >> block) & 1;
+          }
+        }
+      }
+    });
+
+    // Blocks holding too many entries are subdivided, the other ones become
+    // leaves
+    offsets.resize(groupCount * 8);
+    nextGroups.clear();
+    nextStarts.assign(1, 0);
+    size_t leafEntryCount = _blockEntries.size();
+    for (size_t i = 0; i < groupCount * 8; ++i) {
+      const size_t blockIndex = groups[i / 8] + i % 8;
+      const auto depth        = blocks[blockIndex]._depth;
+      if (counts[i] > _maxBlockCapacity && depth < _maxDepth) {
+        offsets[i] = nextStarts.back();
+        nextStarts.emplace_back(nextStarts.back() + counts[i]);
+        nextGroups.emplace_back(blocks.size());
+        blocks[blockIndex]._firstBlock = blocks.size();
+        const Vector3 minPoint         = blocks[blockIndex]._minPoint;
+        const Vector3 maxPoint         = blocks[blockIndex]._maxPoint;
+        Octree<T>::_CreateBlocks(minPoint, maxPoint, depth + 1, *this);
+      }
+      else {
+        offsets[i]                       = leafEntryCount;
+        blocks[blockIndex]._entriesStart = leafEntryCount;
+        blocks[blockIndex]._entriesCount = counts[i];
+        leafEntryCount += counts[i];
+      }
+    }
+    _blockEntries.resize(leafEntryCount);
+    nextEntries.resize(nextStarts.back());
+
+    // Entries copied to the leaves and to the blocks of the next level, in the
+    // order of the level
+    scheduler.parallelFor(0, groupCount, [&](size_t begin, size_t end) {
+      std::array<uint32_t*, 8> outputs;
+      for (size_t group = begin; group < end; ++group) {
+        for (unsigned int block = 0; block < 8; ++block) {
+          const size_t i = group * 8 + block;
+          outputs[block] = (blocks[groups[group] + block].isLeaf() ?
+                              _blockEntries.data() :
+                              nextEntries.data())
+                           + offsets[i];
+        }
+        for (size_t i = levelStarts[group]; i < levelStarts[group + 1]; ++i) {
+          for (unsigned int block = 0; block < 8; ++block) {
+            if ((intersections[i] >> block) & 1) {
+              *outputs[block]++ = levelEntries[i];
+            }
+          }
+        }
+      }
+    });
+
+    groups.swap(nextGroups);
+    levelEntries.swap(nextEntries);
+    levelStarts.swap(nextStarts);
+  }
 }
 
 template <class T>
 void Octree<T>::addMesh(T& entry)
 {
-  for (auto& block : IOctreeContainer<T>::blocks) {
-    block.addEntry(entry);
+  Vector3 minimum, maximum;
+  if (!_boundsFunc(entry, minimum, maximum)) {
+    return;
+  }
+
+  const auto entryIndex = static_cast<uint32_t>(_entries.size());
+  _entries.emplace_back(entry);
+  _entriesMin.emplace_back(minimum);
+  _entriesMax.emplace_back(maximum);
+  _selection.marks.resize((_entries.size() + 63) / 64, 0);
+
+  const auto& blocks = IOctreeContainer<T>::blocks;
+  for (size_t i = 0; i < std::min<size_t>(8, blocks.size()); ++i) {
+    _addToLeaves(i, entryIndex);
   }
 }
 
 template <class T>
-std::vector<T>& Octree<T>::select(const std::array<Plane, 6>& frustumPlanes,
-                                  bool allowDuplicate)
+void Octree<T>::_addToLeaves(size_t blockIndex, uint32_t entryIndex)
 {
-  _selectionContent.clear();
+  auto& blocks = IOctreeContainer<T>::blocks;
+  auto& block  = blocks[blockIndex];
+  if (!intersectsMinMax(_entriesMin[entryIndex], _entriesMax[entryIndex],
+                        block._minPoint, block._maxPoint)) {
+    return;
+  }
 
-  for (auto& block : IOctreeContainer<T>::blocks) {
-    block.select(frustumPlanes, _selectionContent, allowDuplicate);
+  if (!block.isLeaf()) {
+    for (size_t i = 0; i < 8; ++i) {
+      _addToLeaves(block._firstBlock + i, entryIndex);
+    }
+    return;
   }
 
-  if (allowDuplicate) {
-    std_util::concat(_selectionContent, dynamicContent);
+  // The entries of the following leaves are moved by one
+  const size_t position = block._entriesStart + block._entriesCount;
+  _blockEntries.insert(
+    _blockEntries.begin() + static_cast<std::ptrdiff_t>(position), entryIndex);
+  for (auto& other : blocks) {
+    if (&other != &block && other._entriesStart >= position) {
+      ++other._entriesStart;
+    }
   }
-  else {
-    std_util::concat_with_no_duplicates(_selectionContent, dynamicContent);
+  ++block._entriesCount;
+}
+
+template <class T>
+template <typename BlockTest>
+void Octree<T>::_collect(size_t blockIndex, const BlockTest& blockTest,
+                         Selection& selection, bool allowDuplicate) const
+{
+  const auto& block = IOctreeContainer<T>::blocks[blockIndex];
+  if (!blockTest(block._minPoint, block._maxPoint)) {
+    return;
   }
 
-  return _selectionContent;
+  if (!block.isLeaf()) {
+    for (size_t i = 0; i < 8; ++i) {
+      _collect(block._firstBlock + i, blockTest, selection, allowDuplicate);
+    }
+    return;
+  }
+
+  const auto begin
+    = _blockEntries.begin() + static_cast<std::ptrdiff_t>(block._entriesStart);
+  const auto end = begin + static_cast<std::ptrdiff_t>(block._entriesCount);
+  if (allowDuplicate) {
+    selection.indices.insert(selection.indices.end(), begin, end);
+    return;
+  }
+
+  for (auto it = begin; it != end; ++it) {
+    auto& word         = selection.marks[*it / 64];
+    const uint64_t bit = uint64_t(1) << (*it % 64);
+    if (!(word & bit)) {
+      word |= bit;
+      selection.indices.emplace_back(*it);
+    }
+  }
 }
 
 template <class T>
-std::vector<T>& Octree<T>::intersects(const Vector3& sphereCenter,
-                                      float sphereRadius, bool allowDuplicate)
+template <typename BlockTest>
+void Octree<T>::_query(const BlockTest& blockTest, Selection& selection,
+                       std::vector<T>& result, bool allowDuplicate) const
 {
-  _selectionContent.clear();
+  const auto& blocks = IOctreeContainer<T>::blocks;
+  selection.indices.clear();
+  for (size_t i = 0; i < std::min<size_t>(8, blocks.size()); ++i) {
+    _collect(i, blockTest, selection, allowDuplicate);
+  }
+
+  result.clear();
+  result.reserve(selection.indices.size() + dynamicContent.size());
+  for (auto index : selection.indices) {
+    result.emplace_back(_entries[index]);
+  }
+  if (!allowDuplicate) {
+    // Only the words of the selected entries hold marks
+    for (auto index : selection.indices) {
+      selection.marks[index / 64] = 0;
+    }
+  }
 
-  for (auto& block : IOctreeContainer<T>::blocks) {
-    block.intersects(sphereCenter, sphereRadius, _selectionContent,
-                     allowDuplicate);
+  if (dynamicContent.empty()) {
+    return;
   }
 
   if (allowDuplicate) {
-    std_util::concat(_selectionContent, dynamicContent);
+    std_util::concat(result, dynamicContent);
+    return;
   }
-  else {
-    std_util::concat_with_no_duplicates(_selectionContent, dynamicContent);
+
+  // The dynamic content not selected yet is appended in its own order, once
+  std::unordered_set<T> pending(dynamicContent.begin(), dynamicContent.end());
+  for (const auto& item : result) {
+    pending.erase(item);
+  }
+  for (const auto& item : dynamicContent) {
+    if (pending.erase(item)) {
+      result.emplace_back(item);
+    }
   }
+}
+
+template <class T>
+std::vector<T>& Octree<T>::select(const std::array<Plane, 6>& frustumPlanes,
+                                  bool allowDuplicate)
+{
+  _query(
+    [&frustumPlanes](const Vector3& minPoint, const Vector3& maxPoint) {
+      return isInFrustum(minPoint, maxPoint, frustumPlanes);
+    },
+    _selection, _selectionContent, allowDuplicate);
 
   return _selectionContent;
 }
 
 template <class T>
-std::vector<T>& Octree<T>::intersectsRay(const Ray& ray)
+std::vector<T>& Octree<T>::intersects(const Vector3& sphereCenter,
+                                      float sphereRadius, bool allowDuplicate)
 {
-  _selectionContent.clear();
+  _query(
+    [&sphereCenter, sphereRadius](const Vector3& minPoint,
+                                  const Vector3& maxPoint) {
+      return BoundingBox::IntersectsSphere(minPoint, maxPoint, sphereCenter,
+                                           sphereRadius);
+    },
+    _selection, _selectionContent, allowDuplicate);
 
-  for (auto& block : IOctreeContainer<T>::blocks) {
-    block.intersectsRay(ray, _selectionContent);
-  }
+  return _selectionContent;
+}
 
-  std_util::concat_with_no_duplicates(_selectionContent, dynamicContent);
+template <class T>
+std::vector<T>& Octree<T>::intersectsRay(const Ray& ray)
+{
+  _query(
+    [&ray](const Vector3& minPoint, const Vector3& maxPoint) {
+      return ray.intersectsBoxMinMax(minPoint, maxPoint);
+    },
+    _selection, _selectionContent, false);
 
   return _selectionContent;
 }
 
 template <class T>
-void Octree<T>::_CreateBlocks(
-  const Vector3& worldMin, const Vector3& worldMax, std::vector<T>& entries,
-  size_t maxBlockCapacity, size_t currentDepth, size_t maxDepth,
-  IOctreeContainer<T>& target,
-  std::function<void(T& entry, OctreeBlock<T>& block)>& creationFunc)
+void Octree<T>::select(const std::vector<std::array<Plane, 6>>& frustums,
+                       std::vector<std::vector<T>>& selections,
+                       bool allowDuplicate)
+{
+  selections.resize(frustums.size());
+  TaskScheduler::Instance().parallelFor(
+    0, frustums.size(), [&](size_t begin, size_t end) {
+      Selection selection;
+      selection.marks.resize(_selection.marks.size(), 0);
+      for (size_t i = begin; i < end; ++i) {
+        const auto& frustumPlanes = frustums[i];
+        _query(
+          [&frustumPlanes](const Vector3& minPoint, const Vector3& maxPoint) {
+            return isInFrustum(minPoint, maxPoint, frustumPlanes);
+          },
+          selection, selections[i], allowDuplicate);
+      }
+    });
+}
+
+template <class T>
+void Octree<T>::intersects(const std::vector<Vector3>& sphereCenters,
+                           const Float32Array& sphereRadii,
+                           std::vector<std::vector<T>>& selections,
+                           bool allowDuplicate)
+{
+  selections.resize(sphereCenters.size());
+  TaskScheduler::Instance().parallelFor(
+    0, sphereCenters.size(), [&](size_t begin, size_t end) {
+      Selection selection;
+      selection.marks.resize(_selection.marks.size(), 0);
+      for (size_t i = begin; i < end; ++i) {
+        const auto& sphereCenter = sphereCenters[i];
+        const float sphereRadius = sphereRadii[i];
+        _query(
+          [&sphereCenter, sphereRadius](const Vector3& minPoint,
+                                        const Vector3& maxPoint) {
+            return BoundingBox::IntersectsSphere(minPoint, maxPoint,
+                                                 sphereCenter, sphereRadius);
+          },
+          selection, selections[i], allowDuplicate);
+      }
+    });
+}
+
+template <class T>
+void Octree<T>::intersectsRay(const std::vector<Ray>& rays,
+                              std::vector<std::vector<T>>& selections)
+{
+  selections.resize(rays.size());
+  TaskScheduler::Instance().parallelFor(
+    0, rays.size(), [&](size_t begin, size_t end) {
+      Selection selection;
+      selection.marks.resize(_selection.marks.size(), 0);
+      for (size_t i = begin; i < end; ++i) {
+        const auto& ray = rays[i];
+        _query(
+          [&ray](const Vector3& minPoint, const Vector3& maxPoint) {
+            return ray.intersectsBoxMinMax(minPoint, maxPoint);
+          },
+          selection, selections[i], false);
+      }
+    });
+}
+
+template <class T>
+const std::vector<T>& Octree<T>::entries() const
+{
+  return _entries;
+}
+
+template <class T>
+const std::vector<uint32_t>& Octree<T>::blockEntries() const
+{
+  return _blockEntries;
+}
+
+template <class T>
+void Octree<T>::_CreateBlocks(const Vector3& worldMin, const Vector3& worldMax,
+                              size_t depth, IOctreeContainer<T>& target)
 {
-  target.blocks.clear();
   Vector3 blockSize((worldMax.x - worldMin.x) / 2.f,
                     (worldMax.y - worldMin.y) / 2.f,
                     (worldMax.z - worldMin.z) / 2.f);
@@ -120,34 +497,34 @@ void Octree<T>::_CreateBlocks(
         Vector3 localMax
           = worldMin.add(blockSize.multiplyByFloats(x + 1, y + 1, z + 1));
 
-        OctreeBlock<T> block(localMin, localMax, maxBlockCapacity,
-                             currentDepth + 1, maxDepth, creationFunc);
-        block.addEntries(entries);
-        target.blocks.emplace_back(block);
+        target.blocks.emplace_back(localMin, localMax, depth);
       }
     }
   }
 }
 
 template <class T>
-void Octree<T>::CreationFuncForMeshes(AbstractMesh* entry,
-                                      OctreeBlock<AbstractMesh*>& block)
+bool Octree<T>::BoundsFuncForMeshes(AbstractMesh* entry, Vector3& minimum,
+                                    Vector3& maximum)
 {
-  if (!entry->isBlocked()
-      && entry->getBoundingInfo()->boundingBox.intersectsMinMax(
-           block.minPoint(), block.maxPoint())) {
-    block.entries.emplace_back(entry);
+  if (entry->isBlocked()) {
+    return false;
   }
+
+  const auto& boundingBox = entry->getBoundingInfo()->boundingBox;
+  minimum                 = boundingBox.minimumWorld;
+  maximum                 = boundingBox.maximumWorld;
+  return true;
 }
 
 template <class T>
-void Octree<T>::CreationFuncForSubMeshes(SubMesh* entry,
-                                         OctreeBlock<SubMesh*>& block)
+bool Octree<T>::BoundsFuncForSubMeshes(SubMesh* entry, Vector3& minimum,
+                                       Vector3& maximum)
 {
-  if (entry->getBoundingInfo()->boundingBox.intersectsMinMax(
-        block.minPoint(), block.maxPoint())) {
-    block.entries.emplace_back(entry);
-  }
+  const auto& boundingBox = entry->getBoundingInfo()->boundingBox;
+  minimum                 = boundingBox.minimumWorld;
+  maximum                 = boundingBox.maximumWorld;
+  return true;
 }
 
 template class Octree<AbstractMesh*>;
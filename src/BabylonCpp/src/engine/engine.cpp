@@ -6,6 +6,7 @@
 #include <babylon/core/string.h>
 #include <babylon/core/time.h>
 #include <babylon/engine/instancing_attribute_info.h>
+#include <babylon/engine/shader_program_cache.h>
 #include <babylon/interfaces/icanvas.h>
 #include <babylon/interfaces/igl_rendering_context.h>
 #include <babylon/interfaces/iloading_screen.h>
@@ -50,12 +51,15 @@ Engine::Engine(ICanvas* canvas, const EngineOptions& options)
     , renderEvenInBackground{true}
     , preventCacheWipeBetweenFrames{false}
     , enableOfflineSupport{true}
+    , _vrDisplayEnabled{false}
     , _gl{nullptr}
     , _renderingCanvas{canvas}
     , _windowIsBackground{false}
     , _webGLVersion{1.f}
     , _badOS{false}
+    , _pointerLockRequested{false}
     , _alphaTest{false}
+    , _loadingScreen{nullptr}
     , _videoTextureSupported{false}
     , _renderingQueueLaunched{false}
     , fpsRange{60}
@@ -66,21 +70,22 @@ Engine::Engine(ICanvas* canvas, const EngineOptions& options)
     , _alphaState{std_util::make_unique<Internals::_AlphaState>()}
     , _alphaMode{Engine::ALPHA_DISABLE}
     , _maxTextureChannels{16}
+    , _activeTexture{0}
+    , _currentEffect{nullptr}
     , _currentProgram{nullptr}
+    , _cachedViewport{nullptr}
+    , _cachedVertexArrayObject{nullptr}
     , _cachedVertexBuffers{nullptr}
     , _cachedIndexBuffer{nullptr}
     , _cachedEffectForVertexBuffers{nullptr}
     , _currentRenderTarget{nullptr}
+    , _uintIndicesCurrentlySet{false}
+    , _currentFramebuffer{nullptr}
     , _vaoRecordInProgress{false}
     , _mustWipeVertexAttributes{false}
 {
   Engine::Instances.emplace_back(this);
 
-  // Checks if some of the format renders first to allow the use of webgl
-  // inspector.
-  auto renderToFullFloat = _canRenderToFloatTexture();
-  auto renderToHalfFloat = _canRenderToHalfFloatTexture();
-
   // GL
   if (!_gl) {
     if (!canvas) {
@@ -101,6 +106,11 @@ Engine::Engine(ICanvas* canvas, const EngineOptions& options)
     }
   }
 
+  // Checks if some of the format renders first to allow the use of webgl
+  // inspector.
+  auto renderToFullFloat = _canRenderToFloatTexture();
+  auto renderToHalfFloat = _canRenderToHalfFloatTexture();
+
   _onBlur = [this]() { _windowIsBackground = true; };
 
   _onFocus = [this]() { _windowIsBackground = false; };
@@ -147,7 +157,9 @@ Engine::Engine(ICanvas* canvas, const EngineOptions& options)
                           static_cast<unsigned>(_gl->getParameteri(
                             GL::MAX_TEXTURE_MAX_ANISOTROPY_EXT)) :
                           0;
-  _caps.instancedArrays              = false;
+  _caps.instancedArrays
+    = _webGLVersion > 1.f
+      || std_util::contains(extensions, "GL_ARB_instanced_arrays");
   _caps.uintIndices                  = true;
   _caps.fragmentDepthSupported       = true;
   _caps.highPrecisionShaderSupported = true;
@@ -192,6 +204,9 @@ Engine::Engine(ICanvas* canvas, const EngineOptions& options)
 
 Engine::~Engine()
 {
+  Engine::Instances.erase(
+    std::remove(Engine::Instances.begin(), Engine::Instances.end(), this),
+    Engine::Instances.end());
 }
 
 Engine* Engine::LastCreatedEngine()
@@ -1034,15 +1049,19 @@ void Engine::_bindVertexBuffersAttributes(
     auto order = effect->getAttributeLocation(index);
 
     if (order >= 0) {
-      _order             = static_cast<unsigned int>(order);
-      auto& vertexBuffer = vertexBuffers.at(attributes[index]);
+      _order  = static_cast<unsigned int>(order);
+      auto it = vertexBuffers.find(attributes[index]);
 
-      if (!vertexBuffer) {
+      if (it == vertexBuffers.end() || !it->second) {
         continue;
       }
 
+      auto& vertexBuffer = it->second;
       _gl->enableVertexAttribArray(_order);
       if (!_vaoRecordInProgress) {
+        if (_order + 1 > _vertexAttribArraysEnabled.size()) {
+          _vertexAttribArraysEnabled.resize(_order + 1);
+        }
         _vertexAttribArraysEnabled[_order] = true;
       }
 
@@ -1421,6 +1440,17 @@ std::unique_ptr<GL::IGLProgram> Engine::createShaderProgram(
 
   const std::string shaderVersion
     = (_webGLVersion > 1.f) ? "#version 300 es\n" : "";
+
+  ShaderProgramCache::Key cacheKey;
+  if (_shaderProgramCache) {
+    cacheKey = _shaderProgramCache->getKey(gl, vertexCode, fragmentCode,
+                                           shaderVersion + defines);
+    auto cachedProgram = _shaderProgramCache->load(gl, cacheKey);
+    if (cachedProgram) {
+      return cachedProgram;
+    }
+  }
+
   auto vertexShader
     = Engine::CompileShader(gl, vertexCode, "vertex", defines, shaderVersion);
   auto fragmentShader = Engine::CompileShader(gl, fragmentCode, "fragment",
@@ -1429,6 +1459,10 @@ std::unique_ptr<GL::IGLProgram> Engine::createShaderProgram(
   auto shaderProgram = gl->createProgram();
   gl->attachShader(shaderProgram, vertexShader);
   gl->attachShader(shaderProgram, fragmentShader);
+  if (_shaderProgramCache) {
+    gl->programParameteri(shaderProgram.get(),
+                          GL::PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
+  }
 
   bool linked = gl->linkProgram(shaderProgram);
 
@@ -1439,6 +1473,9 @@ std::unique_ptr<GL::IGLProgram> Engine::createShaderProgram(
       return nullptr;
     }
   }
+  else if (_shaderProgramCache) {
+    _shaderProgramCache->store(gl, shaderProgram.get(), cacheKey);
+  }
 
   gl->deleteShader(vertexShader);
   gl->deleteShader(fragmentShader);
@@ -1446,6 +1483,21 @@ std::unique_ptr<GL::IGLProgram> Engine::createShaderProgram(
   return shaderProgram;
 }
 
+void Engine::enableShaderProgramCache(const std::string& directory)
+{
+  _shaderProgramCache = std_util::make_unique<ShaderProgramCache>(directory);
+}
+
+void Engine::disableShaderProgramCache()
+{
+  _shaderProgramCache = nullptr;
+}
+
+ShaderProgramCache* Engine::getShaderProgramCache()
+{
+  return _shaderProgramCache.get();
+}
+
 std::unordered_map<std::string, std::unique_ptr<GL::IGLUniformLocation>>
 Engine::getUniforms(GL::IGLProgram* shaderProgram,
                     const std::vector<std::string>& uniformsNames)
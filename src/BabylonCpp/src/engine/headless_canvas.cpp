@@ -0,0 +1,65 @@
+#include <babylon/engine/headless_canvas.h>
+
+#include <babylon/engine/recording_gl_rendering_context.h>
+
+namespace BABYLON {
+
+HeadlessCanvas::HeadlessCanvas(int iWidth, int iHeight) : ICanvas{}
+{
+  width        = iWidth;
+  height       = iHeight;
+  clientWidth  = iWidth;
+  clientHeight = iHeight;
+
+  _boundingClientRect.left   = 0;
+  _boundingClientRect.top    = 0;
+  _boundingClientRect.right  = iWidth;
+  _boundingClientRect.bottom = iHeight;
+  _boundingClientRect.width  = iWidth;
+  _boundingClientRect.height = iHeight;
+}
+
+HeadlessCanvas::~HeadlessCanvas()
+{
+}
+
+ClientRect& HeadlessCanvas::getBoundingClientRect()
+{
+  return _boundingClientRect;
+}
+
+bool HeadlessCanvas::onlyRenderBoundingClientRect() const
+{
+  return false;
+}
+
+bool HeadlessCanvas::initializeContext3d()
+{
+  if (!_renderingContext) {
+    _renderingContext
+      = std_util::make_unique<GL::RecordingGLRenderingContext>();
+    _initialized = _renderingContext->initialize();
+  }
+
+  return _initialized;
+}
+
+ICanvasRenderingContext2D* HeadlessCanvas::getContext2d()
+{
+  return nullptr;
+}
+
+GL::IGLRenderingContext*
+HeadlessCanvas::getContext3d(const EngineOptions& /*options*/)
+{
+  return initializeContext3d() ? _renderingContext.get() : nullptr;
+}
+
+GL::RecordingGLRenderingContext* HeadlessCanvas::recordingContext()
+{
+  initializeContext3d();
+  return static_cast<GL::RecordingGLRenderingContext*>(
+    _renderingContext.get());
+}
+
+} // end of namespace BABYLON
@@ -77,6 +77,32 @@ void Node::setOnDispose(const std::function<void()>& callback)
   _onDisposeObserver = onDisposeObservable.add(callback);
 }
 
+void Node::setId(const std::string& newId)
+{
+  if (id == newId) {
+    return;
+  }
+
+  const auto oldId = id;
+  id               = newId;
+  if (_scene) {
+    _scene->_onIDChanged(this, oldId);
+  }
+}
+
+void Node::setName(const std::string& newName)
+{
+  if (name == newName) {
+    return;
+  }
+
+  const auto oldName = name;
+  name               = newName;
+  if (_scene) {
+    _scene->_onNameChanged(this, oldName);
+  }
+}
+
 Scene* Node::getScene()
 {
   return _scene;
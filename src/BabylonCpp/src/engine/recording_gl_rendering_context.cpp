@@ -0,0 +1,1568 @@
+#include <babylon/engine/recording_gl_rendering_context.h>
+
+#include <cstring>
+
+#include <babylon/interfaces/icanvas.h>
+
+namespace BABYLON {
+namespace GL {
+
+constexpr GLenum RecordingGLRenderingContext::PROGRAM_BINARY_FORMAT;
+
+RecordingGLRenderingContext::RecordingGLRenderingContext()
+    : _commandRecording{true}
+    , _lastObjectName{0}
+    , _lastUniformLocation{0}
+    , _activeTextureUnit{0}
+{
+  _shaderPrecisionFormat.rangeMin  = 127;
+  _shaderPrecisionFormat.rangeMax  = 127;
+  _shaderPrecisionFormat.precision = 23;
+}
+
+RecordingGLRenderingContext::~RecordingGLRenderingContext()
+{
+}
+
+const std::vector<GLCommand>& RecordingGLRenderingContext::commands() const
+{
+  return _commands;
+}
+
+void RecordingGLRenderingContext::clearCommands()
+{
+  _commands.clear();
+}
+
+void RecordingGLRenderingContext::setCommandRecording(bool enabled)
+{
+  _commandRecording = enabled;
+}
+
+bool RecordingGLRenderingContext::commandRecording() const
+{
+  return _commandRecording;
+}
+
+const GLStatistics& RecordingGLRenderingContext::statistics() const
+{
+  return _statistics;
+}
+
+void RecordingGLRenderingContext::resetStatistics()
+{
+  _statistics = GLStatistics();
+}
+
+/** Recording helpers **/
+
+void RecordingGLRenderingContext::_record(GLCommandType type,
+                                          const GLCommandArgs& args,
+                                          GLsizeiptr size)
+{
+  ++_statistics.commands;
+  if (_commandRecording) {
+    _commands.emplace_back(GLCommand{type, args, size});
+  }
+}
+
+void RecordingGLRenderingContext::_query(GLCommandType type,
+                                         const GLCommandArgs& args)
+{
+  _record(type, args);
+  ++_statistics.queries;
+}
+
+void RecordingGLRenderingContext::_setState(GLCommandType type,
+                                            GLCommandType state,
+                                            std::uint64_t slot,
+                                            const GLCommandArgs& args)
+{
+  _record(type, args);
+  ++_statistics.stateChanges;
+
+  // The slot identifies the state instance (capability, binding target,
+  // texture unit, ...), the low bits hold the state itself
+  const auto key = (slot << 8) | static_cast<std::uint64_t>(state);
+  auto it        = _state.find(key);
+  if (it == _state.end()) {
+    _state[key] = args;
+  }
+  else if (it->second == args) {
+    ++_statistics.redundantStateChanges;
+  }
+  else {
+    it->second = args;
+  }
+}
+
+bool RecordingGLRenderingContext::_stateValue(GLCommandType state,
+                                              std::uint64_t slot,
+                                              GLCommandArgs& args) const
+{
+  const auto key = (slot << 8) | static_cast<std::uint64_t>(state);
+  auto it        = _state.find(key);
+  if (it == _state.end()) {
+    return false;
+  }
+  args = it->second;
+  return true;
+}
+
+void RecordingGLRenderingContext::_draw(GLCommandType type, GLenum mode,
+                                        GLsizeiptr count,
+                                        GLsizei instanceCount)
+{
+  _record(type, {{mode, static_cast<GLuint>(instanceCount), 0, 0}}, count);
+  ++_statistics.drawCalls;
+  if (type == GLCommandType::DRAW_ARRAYS_INSTANCED
+      || type == GLCommandType::DRAW_ELEMENTS_INSTANCED) {
+    ++_statistics.instancedDrawCalls;
+  }
+  _statistics.drawnElements += static_cast<std::size_t>(count);
+  _statistics.drawnInstances += static_cast<std::size_t>(instanceCount);
+}
+
+void RecordingGLRenderingContext::_upload(GLCommandType type, GLenum target,
+                                          std::size_t bytes, bool texture)
+{
+  _record(type, {{target, 0, 0, 0}}, static_cast<GLsizeiptr>(bytes));
+  if (texture) {
+    ++_statistics.textureUploads;
+  }
+  else {
+    ++_statistics.bufferUploads;
+  }
+  _statistics.uploadedBytes += bytes;
+}
+
+void RecordingGLRenderingContext::_uniform(GLCommandType type,
+                                           IGLUniformLocation* location,
+                                           std::size_t count)
+{
+  _record(type,
+          {{location ? static_cast<GLuint>(location->value) : 0, 0, 0, 0}},
+          static_cast<GLsizeiptr>(count));
+  ++_statistics.uniformUpdates;
+}
+
+GLuint RecordingGLRenderingContext::_createObject()
+{
+  const auto name = ++_lastObjectName;
+  _objects.insert(name);
+  return name;
+}
+
+void RecordingGLRenderingContext::_deleteObject(GLCommandType type,
+                                                GLuint name)
+{
+  _record(type, {{name, 0, 0, 0}});
+  _objects.erase(name);
+}
+
+GLboolean RecordingGLRenderingContext::_isObject(GLCommandType type,
+                                                 GLuint name)
+{
+  _query(type, {{name, 0, 0, 0}});
+  return _objects.find(name) != _objects.end();
+}
+
+GLuint RecordingGLRenderingContext::_boundTexture(GLenum target) const
+{
+  GLCommandArgs args;
+  const auto slot = (static_cast<std::uint64_t>(_activeTextureUnit) << 16)
+                    | (target & 0xFFFF);
+  return _stateValue(GLCommandType::BIND_TEXTURE, slot, args) ? args[1] : 0;
+}
+
+GLuint RecordingGLRenderingContext::_bits(GLfloat value)
+{
+  GLuint bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+std::size_t RecordingGLRenderingContext::_texelBytes(GLenum format,
+                                                     GLenum type)
+{
+  if (type == GL::UNSIGNED_SHORT_4_4_4_4 || type == GL::UNSIGNED_SHORT_5_5_5_1
+      || type == GL::UNSIGNED_SHORT_5_6_5) {
+    return 2;
+  }
+
+  std::size_t components = 4;
+  switch (format) {
+    case GL::ALPHA:
+    case GL::LUMINANCE:
+    case GL::DEPTH_COMPONENT:
+      components = 1;
+      break;
+    case GL::LUMINANCE_ALPHA:
+      components = 2;
+      break;
+    case GL::RGB:
+      components = 3;
+      break;
+    default:
+      break;
+  }
+
+  switch (type) {
+    case GL::FLOAT:
+    case GL::INT:
+    case GL::UNSIGNED_INT:
+      return components * 4;
+    case GL::SHORT:
+    case GL::UNSIGNED_SHORT:
+      return components * 2;
+    default:
+      return components;
+  }
+}
+
+/** IGLRenderingContext **/
+
+bool RecordingGLRenderingContext::initialize()
+{
+  return true;
+}
+
+void RecordingGLRenderingContext::backupGLState()
+{
+  _record(GLCommandType::BACKUP_GL_STATE);
+}
+
+void RecordingGLRenderingContext::restoreGLState()
+{
+  _record(GLCommandType::RESTORE_GL_STATE);
+}
+
+GLenum RecordingGLRenderingContext::operator[](const std::string& name)
+{
+  // Only the texture units are looked up by name
+  if (name.compare(0, 7, "TEXTURE") == 0 && name.size() > 7) {
+    return GL::TEXTURE0
+           + static_cast<GLenum>(std::stoul(name.substr(7), nullptr, 10));
+  }
+
+  return 0;
+}
+
+void RecordingGLRenderingContext::activeTexture(GLenum texture)
+{
+  _setState(GLCommandType::ACTIVE_TEXTURE, GLCommandType::ACTIVE_TEXTURE, 0,
+            {{texture, 0, 0, 0}});
+  _activeTextureUnit = texture - GL::TEXTURE0;
+}
+
+void RecordingGLRenderingContext::attachShader(
+  const std::unique_ptr<IGLProgram>& program,
+  const std::unique_ptr<IGLShader>& shader)
+{
+  if (!program || !shader) {
+    return;
+  }
+
+  _record(GLCommandType::ATTACH_SHADER,
+          {{program->value, shader->value, 0, 0}});
+  _attachedShaders[program->value].emplace_back(
+    std_util::make_unique<IGLShader>(shader->value));
+}
+
+void RecordingGLRenderingContext::bindAttribLocation(IGLProgram* program,
+                                                     GLuint index,
+                                                     const std::string& name)
+{
+  if (!program) {
+    return;
+  }
+
+  _record(GLCommandType::BIND_ATTRIB_LOCATION, {{program->value, index, 0, 0}});
+  _attribLocations[program->value][name] = static_cast<GLint>(index);
+}
+
+void RecordingGLRenderingContext::bindBuffer(GLenum target, IGLBuffer* buffer)
+{
+  _setState(GLCommandType::BIND_BUFFER, GLCommandType::BIND_BUFFER, target,
+            {{target, buffer ? buffer->value : 0, 0, 0}});
+  ++_statistics.bufferBindings;
+}
+
+void RecordingGLRenderingContext::bindFramebuffer(GLenum target,
+                                                  IGLFramebuffer* framebuffer)
+{
+  _setState(GLCommandType::BIND_FRAMEBUFFER, GLCommandType::BIND_FRAMEBUFFER,
+            target, {{target, framebuffer ? framebuffer->value : 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::bindBufferBase(GLenum target, GLuint index,
+                                                 IGLBuffer* buffer)
+{
+  _setState(GLCommandType::BIND_BUFFER_BASE, GLCommandType::BIND_BUFFER_BASE,
+            (static_cast<std::uint64_t>(index) << 16) | (target & 0xFFFF),
+            {{target, index, buffer ? buffer->value : 0, 0}});
+}
+
+void RecordingGLRenderingContext::bindRenderbuffer(
+  GLenum target, const std::unique_ptr<IGLRenderbuffer>& renderbuffer)
+{
+  _setState(GLCommandType::BIND_RENDERBUFFER, GLCommandType::BIND_RENDERBUFFER,
+            target, {{target, renderbuffer ? renderbuffer->value : 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::bindTexture(GLenum target,
+                                              IGLTexture* texture)
+{
+  _setState(GLCommandType::BIND_TEXTURE, GLCommandType::BIND_TEXTURE,
+            (static_cast<std::uint64_t>(_activeTextureUnit) << 16)
+              | (target & 0xFFFF),
+            {{target, texture ? texture->value : 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::blendColor(GLclampf red, GLclampf green,
+                                             GLclampf blue, GLclampf alpha)
+{
+  _setState(GLCommandType::BLEND_COLOR, GLCommandType::BLEND_COLOR, 0,
+            {{_bits(red), _bits(green), _bits(blue), _bits(alpha)}});
+}
+
+void RecordingGLRenderingContext::blendEquation(GLenum mode)
+{
+  _setState(GLCommandType::BLEND_EQUATION, GLCommandType::BLEND_EQUATION, 0,
+            {{mode, mode, 0, 0}});
+}
+
+void RecordingGLRenderingContext::blendEquationSeparate(GLenum modeRGB,
+                                                        GLenum modeAlpha)
+{
+  _setState(GLCommandType::BLEND_EQUATION_SEPARATE,
+            GLCommandType::BLEND_EQUATION, 0, {{modeRGB, modeAlpha, 0, 0}});
+}
+
+void RecordingGLRenderingContext::blendFunc(GLenum sfactor, GLenum dfactor)
+{
+  _setState(GLCommandType::BLEND_FUNC, GLCommandType::BLEND_FUNC, 0,
+            {{sfactor, dfactor, sfactor, dfactor}});
+}
+
+void RecordingGLRenderingContext::blendFuncSeparate(GLenum srcRGB,
+                                                    GLenum dstRGB,
+                                                    GLenum srcAlpha,
+                                                    GLenum dstAlpha)
+{
+  _setState(GLCommandType::BLEND_FUNC_SEPARATE, GLCommandType::BLEND_FUNC, 0,
+            {{srcRGB, dstRGB, srcAlpha, dstAlpha}});
+}
+
+void RecordingGLRenderingContext::blitFramebuffer(
+  GLint /*srcX0*/, GLint /*srcY0*/, GLint /*srcX1*/, GLint /*srcY1*/,
+  GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask,
+  GLenum filter)
+{
+  _record(GLCommandType::BLIT_FRAMEBUFFER,
+          {{static_cast<GLuint>(mask), filter, 0, 0}},
+          static_cast<GLsizeiptr>(dstX1 - dstX0) * (dstY1 - dstY0));
+}
+
+void RecordingGLRenderingContext::bufferData(GLenum target, GLsizeiptr size,
+                                             GLenum /*usage*/)
+{
+  _upload(GLCommandType::BUFFER_DATA, target, static_cast<std::size_t>(size),
+          false);
+}
+
+void RecordingGLRenderingContext::bufferData(GLenum target,
+                                             const Float32Array& data,
+                                             GLenum /*usage*/)
+{
+  _upload(GLCommandType::BUFFER_DATA, target, data.size() * sizeof(float),
+          false);
+}
+
+void RecordingGLRenderingContext::bufferData(GLenum target,
+                                             const Int32Array& data,
+                                             GLenum /*usage*/)
+{
+  _upload(GLCommandType::BUFFER_DATA, target,
+          data.size() * sizeof(Int32Array::value_type), false);
+}
+
+void RecordingGLRenderingContext::bufferData(GLenum target,
+                                             const Uint16Array& data,
+                                             GLenum /*usage*/)
+{
+  _upload(GLCommandType::BUFFER_DATA, target,
+          data.size() * sizeof(Uint16Array::value_type), false);
+}
+
+void RecordingGLRenderingContext::bufferData(GLenum target,
+                                             const Uint32Array& data,
+                                             GLenum /*usage*/)
+{
+  _upload(GLCommandType::BUFFER_DATA, target,
+          data.size() * sizeof(Uint32Array::value_type), false);
+}
+
+void RecordingGLRenderingContext::bufferSubData(GLenum target,
+                                                GLintptr /*offset*/,
+                                                const Float32Array& data)
+{
+  _upload(GLCommandType::BUFFER_SUB_DATA, target, data.size() * sizeof(float),
+          false);
+}
+
+void RecordingGLRenderingContext::bufferSubData(GLenum target,
+                                                GLintptr /*offset*/,
+                                                Int32Array& data)
+{
+  _upload(GLCommandType::BUFFER_SUB_DATA, target,
+          data.size() * sizeof(Int32Array::value_type), false);
+}
+
+void RecordingGLRenderingContext::bindVertexArray(
+  GL::IGLVertexArrayObject* vao)
+{
+  // Vertex array objects have no name, their address identifies them
+  const auto id = static_cast<GLuint>(reinterpret_cast<std::uintptr_t>(vao));
+  _setState(GLCommandType::BIND_VERTEX_ARRAY, GLCommandType::BIND_VERTEX_ARRAY,
+            0, {{id, 0, 0, 0}});
+}
+
+GLenum RecordingGLRenderingContext::checkFramebufferStatus(GLenum target)
+{
+  _query(GLCommandType::CHECK_FRAMEBUFFER_STATUS, {{target, 0, 0, 0}});
+  return GL::FRAMEBUFFER_COMPLETE;
+}
+
+void RecordingGLRenderingContext::clear(GLbitfield mask)
+{
+  _record(GLCommandType::CLEAR, {{static_cast<GLuint>(mask), 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::clearColor(GLclampf red, GLclampf green,
+                                             GLclampf blue, GLclampf alpha)
+{
+  _setState(GLCommandType::CLEAR_COLOR, GLCommandType::CLEAR_COLOR, 0,
+            {{_bits(red), _bits(green), _bits(blue), _bits(alpha)}});
+}
+
+void RecordingGLRenderingContext::clearDepth(GLclampf depth)
+{
+  _setState(GLCommandType::CLEAR_DEPTH, GLCommandType::CLEAR_DEPTH, 0,
+            {{_bits(depth), 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::clearStencil(GLint stencil)
+{
+  _setState(GLCommandType::CLEAR_STENCIL, GLCommandType::CLEAR_STENCIL, 0,
+            {{static_cast<GLuint>(stencil), 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::colorMask(GLboolean red, GLboolean green,
+                                            GLboolean blue, GLboolean alpha)
+{
+  _setState(GLCommandType::COLOR_MASK, GLCommandType::COLOR_MASK, 0,
+            {{red, green, blue, alpha}});
+}
+
+void RecordingGLRenderingContext::compileShader(
+  const std::unique_ptr<IGLShader>& shader)
+{
+  _record(GLCommandType::COMPILE_SHADER,
+          {{shader ? shader->value : 0, 0, 0, 0}});
+  ++_statistics.shaderCompilations;
+}
+
+void RecordingGLRenderingContext::compressedTexImage2D(
+  GLenum target, GLint /*level*/, GLenum /*internalformat*/,
+  GLsizei /*width*/, GLsizei /*height*/, GLint /*border*/,
+  const Uint8Array& pixels)
+{
+  _upload(GLCommandType::COMPRESSED_TEX_IMAGE_2D, target, pixels.size(), true);
+}
+
+void RecordingGLRenderingContext::compressedTexSubImage2D(
+  GLenum target, GLint /*level*/, GLint /*xoffset*/, GLint /*yoffset*/,
+  GLsizei /*width*/, GLsizei /*height*/, GLenum /*format*/, GLsizeiptr size)
+{
+  _upload(GLCommandType::COMPRESSED_TEX_SUB_IMAGE_2D, target,
+          static_cast<std::size_t>(size), true);
+}
+
+void RecordingGLRenderingContext::copyTexImage2D(
+  GLenum target, GLint level, GLenum internalformat, GLint /*x*/, GLint /*y*/,
+  GLsizei width, GLsizei height, GLint /*border*/)
+{
+  _record(GLCommandType::COPY_TEX_IMAGE_2D,
+          {{target, static_cast<GLuint>(level), internalformat, 0}},
+          static_cast<GLsizeiptr>(width * height));
+}
+
+void RecordingGLRenderingContext::copyTexSubImage2D(
+  GLenum target, GLint level, GLint /*xoffset*/, GLint /*yoffset*/,
+  GLint /*x*/, GLint /*y*/, GLint width, GLint height)
+{
+  _record(GLCommandType::COPY_TEX_SUB_IMAGE_2D,
+          {{target, static_cast<GLuint>(level), 0, 0}},
+          static_cast<GLsizeiptr>(width * height));
+}
+
+std::unique_ptr<IGLBuffer> RecordingGLRenderingContext::createBuffer()
+{
+  auto name = _createObject();
+  _record(GLCommandType::CREATE_BUFFER, {{name, 0, 0, 0}});
+  return std_util::make_unique<IGLBuffer>(name);
+}
+
+std::unique_ptr<IGLFramebuffer> RecordingGLRenderingContext::createFramebuffer()
+{
+  auto name = _createObject();
+  _record(GLCommandType::CREATE_FRAMEBUFFER, {{name, 0, 0, 0}});
+  return std_util::make_unique<IGLFramebuffer>(name);
+}
+
+std::unique_ptr<IGLProgram> RecordingGLRenderingContext::createProgram()
+{
+  auto name = _createObject();
+  _record(GLCommandType::CREATE_PROGRAM, {{name, 0, 0, 0}});
+  return std_util::make_unique<IGLProgram>(name);
+}
+
+std::unique_ptr<IGLRenderbuffer>
+RecordingGLRenderingContext::createRenderbuffer()
+{
+  auto name = _createObject();
+  _record(GLCommandType::CREATE_RENDERBUFFER, {{name, 0, 0, 0}});
+  return std_util::make_unique<IGLRenderbuffer>(name);
+}
+
+std::unique_ptr<IGLShader>
+RecordingGLRenderingContext::createShader(GLenum type)
+{
+  auto name = _createObject();
+  _record(GLCommandType::CREATE_SHADER, {{name, type, 0, 0}});
+  _shaderTypes[name] = type;
+  return std_util::make_unique<IGLShader>(name);
+}
+
+std::unique_ptr<IGLTexture> RecordingGLRenderingContext::createTexture()
+{
+  auto name = _createObject();
+  _record(GLCommandType::CREATE_TEXTURE, {{name, 0, 0, 0}});
+  return std_util::make_unique<IGLTexture>(name);
+}
+
+std::unique_ptr<IGLVertexArrayObject>
+RecordingGLRenderingContext::createVertexArray()
+{
+  _record(GLCommandType::CREATE_VERTEX_ARRAY);
+  return std_util::make_unique<IGLVertexArrayObject>();
+}
+
+void RecordingGLRenderingContext::cullFace(GLenum mode)
+{
+  _setState(GLCommandType::CULL_FACE, GLCommandType::CULL_FACE, 0,
+            {{mode, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::deleteBuffer(IGLBuffer* buffer)
+{
+  _deleteObject(GLCommandType::DELETE_BUFFER, buffer ? buffer->value : 0);
+}
+
+void RecordingGLRenderingContext::deleteFramebuffer(
+  const std::unique_ptr<IGLFramebuffer>& framebuffer)
+{
+  _deleteObject(GLCommandType::DELETE_FRAMEBUFFER,
+                framebuffer ? framebuffer->value : 0);
+}
+
+void RecordingGLRenderingContext::deleteProgram(IGLProgram* program)
+{
+  if (!program) {
+    return;
+  }
+
+  _deleteObject(GLCommandType::DELETE_PROGRAM, program->value);
+  _attachedShaders.erase(program->value);
+  _programBinaries.erase(program->value);
+  _attribLocations.erase(program->value);
+  _uniformBlockIndices.erase(program->value);
+}
+
+void RecordingGLRenderingContext::deleteRenderbuffer(
+  const std::unique_ptr<IGLRenderbuffer>& renderbuffer)
+{
+  _deleteObject(GLCommandType::DELETE_RENDERBUFFER,
+                renderbuffer ? renderbuffer->value : 0);
+}
+
+void RecordingGLRenderingContext::deleteShader(
+  const std::unique_ptr<IGLShader>& shader)
+{
+  if (!shader) {
+    return;
+  }
+
+  // The source is kept while the shader is attached to a program, as in GL
+  _deleteObject(GLCommandType::DELETE_SHADER, shader->value);
+  _shaderTypes.erase(shader->value);
+}
+
+void RecordingGLRenderingContext::deleteTexture(IGLTexture* texture)
+{
+  _deleteObject(GLCommandType::DELETE_TEXTURE, texture ? texture->value : 0);
+}
+
+void RecordingGLRenderingContext::deleteVertexArray(
+  IGLVertexArrayObject* /*vao*/)
+{
+  _record(GLCommandType::DELETE_VERTEX_ARRAY);
+}
+
+void RecordingGLRenderingContext::depthFunc(GLenum func)
+{
+  _setState(GLCommandType::DEPTH_FUNC, GLCommandType::DEPTH_FUNC, 0,
+            {{func, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::depthMask(GLboolean flag)
+{
+  _setState(GLCommandType::DEPTH_MASK, GLCommandType::DEPTH_MASK, 0,
+            {{flag, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::depthRange(GLclampf zNear, GLclampf zFar)
+{
+  _setState(GLCommandType::DEPTH_RANGE, GLCommandType::DEPTH_RANGE, 0,
+            {{_bits(zNear), _bits(zFar), 0, 0}});
+}
+
+void RecordingGLRenderingContext::detachShader(IGLProgram* program,
+                                               IGLShader* shader)
+{
+  if (!program || !shader) {
+    return;
+  }
+
+  _record(GLCommandType::DETACH_SHADER,
+          {{program->value, shader->value, 0, 0}});
+  auto it = _attachedShaders.find(program->value);
+  if (it != _attachedShaders.end()) {
+    auto& shaders = it->second;
+    shaders.erase(std::remove_if(shaders.begin(), shaders.end(),
+                                 [shader](const std::unique_ptr<IGLShader>& s) {
+                                   return s->value == shader->value;
+                                 }),
+                  shaders.end());
+  }
+}
+
+void RecordingGLRenderingContext::disable(GLenum cap)
+{
+  _setState(GLCommandType::DISABLE, GLCommandType::ENABLE, cap,
+            {{cap, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::disableVertexAttribArray(GLuint index)
+{
+  _setState(GLCommandType::DISABLE_VERTEX_ATTRIB_ARRAY,
+            GLCommandType::ENABLE_VERTEX_ATTRIB_ARRAY, index,
+            {{index, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::drawArrays(GLenum mode, GLint /*first*/,
+                                             GLint count)
+{
+  _draw(GLCommandType::DRAW_ARRAYS, mode, count, 1);
+}
+
+void RecordingGLRenderingContext::drawArraysInstanced(GLenum mode,
+                                                      GLint /*first*/,
+                                                      GLsizei count,
+                                                      GLsizei instanceCount)
+{
+  _draw(GLCommandType::DRAW_ARRAYS_INSTANCED, mode, count, instanceCount);
+}
+
+void RecordingGLRenderingContext::drawElements(GLenum mode, GLsizei count,
+                                               GLenum /*type*/,
+                                               GLintptr /*offset*/)
+{
+  _draw(GLCommandType::DRAW_ELEMENTS, mode, count, 1);
+}
+
+void RecordingGLRenderingContext::drawElementsInstanced(GLenum mode,
+                                                        GLsizei count,
+                                                        GLenum /*type*/,
+                                                        GLintptr /*offset*/,
+                                                        GLsizei instanceCount)
+{
+  _draw(GLCommandType::DRAW_ELEMENTS_INSTANCED, mode, count, instanceCount);
+}
+
+void RecordingGLRenderingContext::enable(GLenum cap)
+{
+  _setState(GLCommandType::ENABLE, GLCommandType::ENABLE, cap,
+            {{cap, 1, 0, 0}});
+}
+
+void RecordingGLRenderingContext::enableVertexAttribArray(GLuint index)
+{
+  _setState(GLCommandType::ENABLE_VERTEX_ATTRIB_ARRAY,
+            GLCommandType::ENABLE_VERTEX_ATTRIB_ARRAY, index,
+            {{index, 1, 0, 0}});
+}
+
+void RecordingGLRenderingContext::finish()
+{
+  _record(GLCommandType::FINISH);
+}
+
+void RecordingGLRenderingContext::flush()
+{
+  _record(GLCommandType::FLUSH);
+}
+
+void RecordingGLRenderingContext::framebufferRenderbuffer(
+  GLenum target, GLenum attachment, GLenum renderbuffertarget,
+  const std::unique_ptr<IGLRenderbuffer>& renderbuffer)
+{
+  _record(GLCommandType::FRAMEBUFFER_RENDERBUFFER,
+          {{target, attachment, renderbuffertarget,
+            renderbuffer ? renderbuffer->value : 0}});
+}
+
+void RecordingGLRenderingContext::framebufferTexture2D(GLenum target,
+                                                       GLenum attachment,
+                                                       GLenum textarget,
+                                                       IGLTexture* texture,
+                                                       GLint /*level*/)
+{
+  _record(GLCommandType::FRAMEBUFFER_TEXTURE_2D,
+          {{target, attachment, textarget, texture ? texture->value : 0}});
+}
+
+void RecordingGLRenderingContext::frontFace(GLenum mode)
+{
+  _setState(GLCommandType::FRONT_FACE, GLCommandType::FRONT_FACE, 0,
+            {{mode, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::generateMipmap(GLenum target)
+{
+  _record(GLCommandType::GENERATE_MIPMAP,
+          {{target, _boundTexture(target), 0, 0}});
+}
+
+std::vector<IGLShader*>
+RecordingGLRenderingContext::getAttachedShaders(IGLProgram* program)
+{
+  std::vector<IGLShader*> shaders;
+  if (!program) {
+    return shaders;
+  }
+
+  _query(GLCommandType::GET_ATTACHED_SHADERS, {{program->value, 0, 0, 0}});
+  auto it = _attachedShaders.find(program->value);
+  if (it != _attachedShaders.end()) {
+    for (auto& shader : it->second) {
+      shaders.emplace_back(shader.get());
+    }
+  }
+
+  return shaders;
+}
+
+GLint RecordingGLRenderingContext::getAttribLocation(IGLProgram* program,
+                                                     const std::string& name)
+{
+  if (!program) {
+    return -1;
+  }
+
+  _query(GLCommandType::GET_ATTRIB_LOCATION, {{program->value, 0, 0, 0}});
+  // Attributes which were not explicitly bound get the next free location
+  auto& locations = _attribLocations[program->value];
+  auto it         = locations.find(name);
+  if (it != locations.end()) {
+    return it->second;
+  }
+
+  const auto location = static_cast<GLint>(locations.size());
+  locations[name]     = location;
+  return location;
+}
+
+GLboolean RecordingGLRenderingContext::hasExtension(
+  const std::string& /*extension*/)
+{
+  _query(GLCommandType::HAS_EXTENSION);
+  return false;
+}
+
+std::array<int, 3> RecordingGLRenderingContext::getScissorBoxParameter()
+{
+  _query(GLCommandType::GET_SCISSOR_BOX_PARAMETER);
+  GLCommandArgs args;
+  if (_stateValue(GLCommandType::SCISSOR, 0, args)) {
+    return {{static_cast<int>(args[0]), static_cast<int>(args[1]),
+             static_cast<int>(args[2])}};
+  }
+  return {{0, 0, 0}};
+}
+
+GLint RecordingGLRenderingContext::getParameteri(GLenum pname)
+{
+  _query(GLCommandType::GET_PARAMETERI, {{pname, 0, 0, 0}});
+  switch (pname) {
+    case GL::MAX_TEXTURE_IMAGE_UNITS:
+    case GL::MAX_VERTEX_TEXTURE_IMAGE_UNITS:
+    case GL::MAX_VERTEX_ATTRIBS:
+    case GL::MAX_TEXTURE_MAX_ANISOTROPY_EXT:
+      return 16;
+    case GL::MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+      return 32;
+    case GL::MAX_TEXTURE_SIZE:
+    case GL::MAX_CUBE_MAP_TEXTURE_SIZE:
+    case GL::MAX_RENDERBUFFER_SIZE:
+      return 16384;
+    case GL::MAX_VERTEX_UNIFORM_VECTORS:
+    case GL::MAX_FRAGMENT_UNIFORM_VECTORS:
+      return 1024;
+    case GL::MAX_VARYING_VECTORS:
+      return 32;
+    case GL::MAX_SAMPLES:
+      return 4;
+    case GL::NUM_PROGRAM_BINARY_FORMATS:
+      return 1;
+    case GL::SCISSOR_TEST:
+      return isEnabled(GL::SCISSOR_TEST) ? 1 : 0;
+    default:
+      return 0;
+  }
+}
+
+GLfloat RecordingGLRenderingContext::getParameterf(GLenum pname)
+{
+  _query(GLCommandType::GET_PARAMETERF, {{pname, 0, 0, 0}});
+  return 0.f;
+}
+
+std::string RecordingGLRenderingContext::getString(GLenum pname)
+{
+  _query(GLCommandType::GET_STRING, {{pname, 0, 0, 0}});
+  switch (pname) {
+    case GL::VENDOR:
+      return "BabylonCpp";
+    case GL::RENDERER:
+      return "Recording GL rendering context";
+    case GL::VERSION:
+      return "OpenGL ES 3.0";
+    case GL::SHADING_LANGUAGE_VERSION:
+      return "OpenGL ES GLSL ES 3.00";
+    case GL::EXTENSIONS:
+      return "GL_ARB_instanced_arrays";
+    default:
+      return "";
+  }
+}
+
+GLint RecordingGLRenderingContext::getTexParameteri(GLenum pname)
+{
+  _query(GLCommandType::GET_TEX_PARAMETERI, {{pname, 0, 0, 0}});
+  return 0;
+}
+
+GLfloat RecordingGLRenderingContext::getTexParameterf(GLenum pname)
+{
+  _query(GLCommandType::GET_TEX_PARAMETERF, {{pname, 0, 0, 0}});
+  return 0.f;
+}
+
+GLenum RecordingGLRenderingContext::getError()
+{
+  _query(GLCommandType::GET_ERROR);
+  return GL::NO_ERROR;
+}
+
+const char* RecordingGLRenderingContext::getErrorString(GLenum err)
+{
+  _query(GLCommandType::GET_ERROR_STRING, {{err, 0, 0, 0}});
+  return err == GL::NO_ERROR ? "NO_ERROR" : "UNKNOWN_ERROR";
+}
+
+Uint8Array RecordingGLRenderingContext::getProgramBinary(IGLProgram* program,
+                                                         GLenum& binaryFormat)
+{
+  binaryFormat = PROGRAM_BINARY_FORMAT;
+  if (!program) {
+    return Uint8Array();
+  }
+
+  _query(GLCommandType::GET_PROGRAM_BINARY, {{program->value, 0, 0, 0}});
+  auto it = _programBinaries.find(program->value);
+  return (it != _programBinaries.end()) ? it->second : Uint8Array();
+}
+
+GLint RecordingGLRenderingContext::getProgramParameter(IGLProgram* program,
+                                                       GLenum pname)
+{
+  if (!program) {
+    return 0;
+  }
+
+  _query(GLCommandType::GET_PROGRAM_PARAMETER, {{program->value, pname, 0, 0}});
+  switch (pname) {
+    case GL::LINK_STATUS:
+    case GL::VALIDATE_STATUS:
+      return 1;
+    case GL::ATTACHED_SHADERS: {
+      auto it = _attachedShaders.find(program->value);
+      return (it != _attachedShaders.end()) ?
+               static_cast<GLint>(it->second.size()) :
+               0;
+    }
+    case GL::PROGRAM_BINARY_LENGTH: {
+      auto it = _programBinaries.find(program->value);
+      return (it != _programBinaries.end()) ?
+               static_cast<GLint>(it->second.size()) :
+               0;
+    }
+    default:
+      return 0;
+  }
+}
+
+std::string RecordingGLRenderingContext::getProgramInfoLog(
+  const std::unique_ptr<IGLProgram>& program)
+{
+  _query(GLCommandType::GET_PROGRAM_INFO_LOG,
+         {{program ? program->value : 0, 0, 0, 0}});
+  return "";
+}
+
+any RecordingGLRenderingContext::getRenderbufferParameter(GLenum target,
+                                                          GLenum pname)
+{
+  _query(GLCommandType::GET_RENDERBUFFER_PARAMETER, {{target, pname, 0, 0}});
+  return nullptr;
+}
+
+std::string RecordingGLRenderingContext::getShaderInfoLog(
+  const std::unique_ptr<IGLShader>& shader)
+{
+  _query(GLCommandType::GET_SHADER_INFO_LOG,
+         {{shader ? shader->value : 0, 0, 0, 0}});
+  return "";
+}
+
+GLint RecordingGLRenderingContext::getShaderParameter(
+  const std::unique_ptr<IGLShader>& shader, GLenum pname)
+{
+  if (!shader) {
+    return 0;
+  }
+
+  _query(GLCommandType::GET_SHADER_PARAMETER, {{shader->value, pname, 0, 0}});
+  switch (pname) {
+    case GL::COMPILE_STATUS:
+      return 1;
+    case GL::SHADER_TYPE: {
+      auto it = _shaderTypes.find(shader->value);
+      return (it != _shaderTypes.end()) ? static_cast<GLint>(it->second) : 0;
+    }
+    default:
+      return 0;
+  }
+}
+
+IGLShaderPrecisionFormat*
+RecordingGLRenderingContext::getShaderPrecisionFormat(GLenum shadertype,
+                                                      GLenum precisiontype)
+{
+  _query(GLCommandType::GET_SHADER_PRECISION_FORMAT,
+         {{shadertype, precisiontype, 0, 0}});
+  return &_shaderPrecisionFormat;
+}
+
+std::string RecordingGLRenderingContext::getShaderSource(IGLShader* shader)
+{
+  if (!shader) {
+    return "";
+  }
+
+  _query(GLCommandType::GET_SHADER_SOURCE, {{shader->value, 0, 0, 0}});
+  auto it = _shaderSources.find(shader->value);
+  return (it != _shaderSources.end()) ? it->second : "";
+}
+
+GLuint RecordingGLRenderingContext::getUniformBlockIndex(
+  IGLProgram* program, const std::string& uniformBlockName)
+{
+  if (!program) {
+    return 0;
+  }
+
+  _query(GLCommandType::GET_UNIFORM_BLOCK_INDEX, {{program->value, 0, 0, 0}});
+  auto& indices = _uniformBlockIndices[program->value];
+  auto it       = indices.find(uniformBlockName);
+  if (it != indices.end()) {
+    return it->second;
+  }
+
+  const auto index          = static_cast<GLuint>(indices.size());
+  indices[uniformBlockName] = index;
+  return index;
+}
+
+std::unique_ptr<IGLUniformLocation>
+RecordingGLRenderingContext::getUniformLocation(IGLProgram* program,
+                                                const std::string& /*name*/)
+{
+  _query(GLCommandType::GET_UNIFORM_LOCATION,
+         {{program ? program->value : 0, 0, 0, 0}});
+  return std_util::make_unique<IGLUniformLocation>(++_lastUniformLocation);
+}
+
+void RecordingGLRenderingContext::hint(GLenum target, GLenum mode)
+{
+  _setState(GLCommandType::HINT, GLCommandType::HINT, target,
+            {{target, mode, 0, 0}});
+}
+
+GLboolean RecordingGLRenderingContext::isBuffer(IGLBuffer* buffer)
+{
+  return _isObject(GLCommandType::IS_BUFFER, buffer ? buffer->value : 0);
+}
+
+GLboolean RecordingGLRenderingContext::isEnabled(GLenum cap)
+{
+  _query(GLCommandType::IS_ENABLED, {{cap, 0, 0, 0}});
+  GLCommandArgs args;
+  if (_stateValue(GLCommandType::ENABLE, cap, args)) {
+    return args[1] != 0;
+  }
+
+  // Dithering is the only capability enabled by default
+  return cap == GL::DITHER;
+}
+
+GLboolean
+RecordingGLRenderingContext::isFramebuffer(IGLFramebuffer* framebuffer)
+{
+  return _isObject(GLCommandType::IS_FRAMEBUFFER,
+                   framebuffer ? framebuffer->value : 0);
+}
+
+GLboolean RecordingGLRenderingContext::isProgram(
+  const std::unique_ptr<IGLProgram>& program)
+{
+  return _isObject(GLCommandType::IS_PROGRAM, program ? program->value : 0);
+}
+
+GLboolean
+RecordingGLRenderingContext::isRenderbuffer(IGLRenderbuffer* renderbuffer)
+{
+  return _isObject(GLCommandType::IS_RENDERBUFFER,
+                   renderbuffer ? renderbuffer->value : 0);
+}
+
+GLboolean RecordingGLRenderingContext::isShader(IGLShader* shader)
+{
+  return _isObject(GLCommandType::IS_SHADER, shader ? shader->value : 0);
+}
+
+GLboolean RecordingGLRenderingContext::isTexture(IGLTexture* texture)
+{
+  return _isObject(GLCommandType::IS_TEXTURE, texture ? texture->value : 0);
+}
+
+void RecordingGLRenderingContext::lineWidth(GLfloat width)
+{
+  _setState(GLCommandType::LINE_WIDTH, GLCommandType::LINE_WIDTH, 0,
+            {{_bits(width), 0, 0, 0}});
+}
+
+bool RecordingGLRenderingContext::linkProgram(
+  const std::unique_ptr<IGLProgram>& program)
+{
+  _record(GLCommandType::LINK_PROGRAM,
+          {{program ? program->value : 0, 0, 0, 0}});
+  ++_statistics.programLinks;
+  if (!program) {
+    return false;
+  }
+
+  // The binary holds the type, the size and the source of each shader
+  Uint8Array binary;
+  auto it = _attachedShaders.find(program->value);
+  if (it != _attachedShaders.end()) {
+    for (const auto& shader : it->second) {
+      const auto& source = _shaderSources[shader->value];
+      auto type          = _shaderTypes.find(shader->value);
+      const std::array<std::uint32_t, 2> header{
+        {type != _shaderTypes.end() ? type->second : 0,
+         static_cast<std::uint32_t>(source.size())}};
+      const auto offset = binary.size();
+      binary.resize(offset + sizeof(header) + source.size());
+      std::memcpy(&binary[offset], header.data(), sizeof(header));
+      std::memcpy(&binary[offset + sizeof(header)], source.data(),
+                  source.size());
+    }
+  }
+  _programBinaries[program->value] = std::move(binary);
+  return true;
+}
+
+void RecordingGLRenderingContext::pixelStorei(GLenum pname, GLint param)
+{
+  _setState(GLCommandType::PIXEL_STOREI, GLCommandType::PIXEL_STOREI, pname,
+            {{pname, static_cast<GLuint>(param), 0, 0}});
+}
+
+void RecordingGLRenderingContext::polygonOffset(GLfloat factor, GLfloat units)
+{
+  _setState(GLCommandType::POLYGON_OFFSET, GLCommandType::POLYGON_OFFSET, 0,
+            {{_bits(factor), _bits(units), 0, 0}});
+}
+
+bool RecordingGLRenderingContext::programBinary(IGLProgram* program,
+                                                GLenum binaryFormat,
+                                                const Uint8Array& binary)
+{
+  if (!program) {
+    return false;
+  }
+
+  _record(GLCommandType::PROGRAM_BINARY,
+          {{program->value, binaryFormat, 0, 0}},
+          static_cast<GLsizeiptr>(binary.size()));
+  if (binaryFormat != PROGRAM_BINARY_FORMAT) {
+    return false;
+  }
+
+  // Rejects the binaries whose shader sizes do not add up
+  std::size_t offset = 0;
+  std::array<std::uint32_t, 2> header;
+  while (offset + sizeof(header) <= binary.size()) {
+    std::memcpy(header.data(), &binary[offset], sizeof(header));
+    offset += sizeof(header) + header[1];
+  }
+  if (offset != binary.size()) {
+    return false;
+  }
+
+  ++_statistics.programBinaryLoads;
+  _programBinaries[program->value] = binary;
+  return true;
+}
+
+void RecordingGLRenderingContext::programParameteri(IGLProgram* program,
+                                                    GLenum pname, GLint value)
+{
+  _record(GLCommandType::PROGRAM_PARAMETERI,
+          {{program ? program->value : 0, pname,
+            static_cast<GLuint>(value), 0}});
+}
+
+void RecordingGLRenderingContext::readPixels(GLint /*x*/, GLint /*y*/,
+                                             GLsizei width, GLsizei height,
+                                             GLenum format, GLenum type,
+                                             Uint8Array& pixels)
+{
+  _query(GLCommandType::READ_PIXELS, {{format, type, 0, 0}});
+  const auto bytes = static_cast<std::size_t>(width * height)
+                     * _texelBytes(format, type);
+  std::fill(pixels.begin(), pixels.begin() + std::min(bytes, pixels.size()),
+            0);
+}
+
+void RecordingGLRenderingContext::renderbufferStorage(GLenum target,
+                                                      GLenum internalformat,
+                                                      GLsizei width,
+                                                      GLsizei height)
+{
+  _record(GLCommandType::RENDERBUFFER_STORAGE, {{target, internalformat, 0, 0}},
+          static_cast<GLsizeiptr>(width * height));
+}
+
+void RecordingGLRenderingContext::renderbufferStorageMultisample(
+  GLenum target, GLsizei samples, GLenum internalFormat, GLsizei width,
+  GLsizei height)
+{
+  _record(GLCommandType::RENDERBUFFER_STORAGE_MULTISAMPLE,
+          {{target, internalFormat, static_cast<GLuint>(samples), 0}},
+          static_cast<GLsizeiptr>(width * height));
+}
+
+void RecordingGLRenderingContext::sampleCoverage(GLclampf value,
+                                                 GLboolean invert)
+{
+  _setState(GLCommandType::SAMPLE_COVERAGE, GLCommandType::SAMPLE_COVERAGE, 0,
+            {{_bits(value), invert, 0, 0}});
+}
+
+void RecordingGLRenderingContext::scissor(GLint x, GLint y, GLsizei width,
+                                          GLsizei height)
+{
+  _setState(GLCommandType::SCISSOR, GLCommandType::SCISSOR, 0,
+            {{static_cast<GLuint>(x), static_cast<GLuint>(y),
+              static_cast<GLuint>(width), static_cast<GLuint>(height)}});
+}
+
+void RecordingGLRenderingContext::shaderSource(
+  const std::unique_ptr<IGLShader>& shader, const std::string& source)
+{
+  if (!shader) {
+    return;
+  }
+
+  _record(GLCommandType::SHADER_SOURCE, {{shader->value, 0, 0, 0}},
+          static_cast<GLsizeiptr>(source.size()));
+  _shaderSources[shader->value] = source;
+}
+
+void RecordingGLRenderingContext::stencilFunc(GLenum func, GLint ref,
+                                              GLuint mask)
+{
+  _setState(GLCommandType::STENCIL_FUNC, GLCommandType::STENCIL_FUNC,
+            GL::FRONT_AND_BACK,
+            {{func, static_cast<GLuint>(ref), mask, 0}});
+}
+
+void RecordingGLRenderingContext::stencilFuncSeparate(GLenum face, GLenum func,
+                                                      GLint ref, GLuint mask)
+{
+  _setState(GLCommandType::STENCIL_FUNC_SEPARATE, GLCommandType::STENCIL_FUNC,
+            face, {{func, static_cast<GLuint>(ref), mask, 0}});
+}
+
+void RecordingGLRenderingContext::stencilMask(GLuint mask)
+{
+  _setState(GLCommandType::STENCIL_MASK, GLCommandType::STENCIL_MASK,
+            GL::FRONT_AND_BACK, {{mask, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::stencilMaskSeparate(GLenum face, GLuint mask)
+{
+  _setState(GLCommandType::STENCIL_MASK_SEPARATE, GLCommandType::STENCIL_MASK,
+            face, {{mask, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::stencilOp(GLenum fail, GLenum zfail,
+                                            GLenum zpass)
+{
+  _setState(GLCommandType::STENCIL_OP, GLCommandType::STENCIL_OP,
+            GL::FRONT_AND_BACK, {{fail, zfail, zpass, 0}});
+}
+
+void RecordingGLRenderingContext::stencilOpSeparate(GLenum face, GLenum fail,
+                                                    GLenum zfail, GLenum zpass)
+{
+  _setState(GLCommandType::STENCIL_OP_SEPARATE, GLCommandType::STENCIL_OP,
+            face, {{fail, zfail, zpass, 0}});
+}
+
+void RecordingGLRenderingContext::texImage2D(
+  GLenum target, GLint /*level*/, GLint /*internalformat*/, GLsizei width,
+  GLsizei height, GLint /*border*/, GLenum format, GLenum type,
+  const Uint8Array& pixels)
+{
+  // Allocations without data are not uploads
+  const auto bytes = pixels.empty() ?
+                       0 :
+                       static_cast<std::size_t>(width * height)
+                         * _texelBytes(format, type);
+  _upload(GLCommandType::TEX_IMAGE_2D, target, bytes, true);
+}
+
+void RecordingGLRenderingContext::texImage2D(GLenum target, GLint /*level*/,
+                                             GLenum /*internalformat*/,
+                                             GLenum format, GLenum type,
+                                             ICanvas* pixels)
+{
+  const auto bytes = pixels ? static_cast<std::size_t>(pixels->width
+                                                       * pixels->height)
+                                * _texelBytes(format, type) :
+                              0;
+  _upload(GLCommandType::TEX_IMAGE_2D, target, bytes, true);
+}
+
+void RecordingGLRenderingContext::texImage2D(
+  GLenum target, GLint /*level*/, GLenum /*internalformat*/, GLsizei width,
+  GLsizei height, GLsizei /*border*/, GLenum format, GLenum type,
+  ICanvas* pixels)
+{
+  const auto bytes = pixels ? static_cast<std::size_t>(width * height)
+                                * _texelBytes(format, type) :
+                              0;
+  _upload(GLCommandType::TEX_IMAGE_2D, target, bytes, true);
+}
+
+void RecordingGLRenderingContext::texParameterf(GLenum target, GLenum pname,
+                                                GLfloat param)
+{
+  _setState(GLCommandType::TEX_PARAMETERF, GLCommandType::TEX_PARAMETERI,
+            (static_cast<std::uint64_t>(_boundTexture(target)) << 16)
+              | (pname & 0xFFFF),
+            {{target, pname, _bits(param), 0}});
+}
+
+void RecordingGLRenderingContext::texParameteri(GLenum target, GLenum pname,
+                                                GLint param)
+{
+  _setState(GLCommandType::TEX_PARAMETERI, GLCommandType::TEX_PARAMETERI,
+            (static_cast<std::uint64_t>(_boundTexture(target)) << 16)
+              | (pname & 0xFFFF),
+            {{target, pname, static_cast<GLuint>(param), 0}});
+}
+
+void RecordingGLRenderingContext::texSubImage2D(
+  GLenum target, GLint /*level*/, GLint /*xoffset*/, GLint /*yoffset*/,
+  GLsizei width, GLsizei height, GLenum format, GLenum type, any /*pixels*/)
+{
+  _upload(GLCommandType::TEX_SUB_IMAGE_2D, target,
+          static_cast<std::size_t>(width * height) * _texelBytes(format, type),
+          true);
+}
+
+void RecordingGLRenderingContext::uniform1f(IGLUniformLocation* location,
+                                            GLfloat /*v0*/)
+{
+  _uniform(GLCommandType::UNIFORM1F, location, 1);
+}
+
+void RecordingGLRenderingContext::uniform1fv(GL::IGLUniformLocation* location,
+                                             const Float32Array& array)
+{
+  _uniform(GLCommandType::UNIFORM1FV, location, array.size());
+}
+
+void RecordingGLRenderingContext::uniform1i(IGLUniformLocation* location,
+                                            GLint /*v0*/)
+{
+  _uniform(GLCommandType::UNIFORM1I, location, 1);
+}
+
+void RecordingGLRenderingContext::uniform1iv(IGLUniformLocation* location,
+                                             const Int32Array& v)
+{
+  _uniform(GLCommandType::UNIFORM1IV, location, v.size());
+}
+
+void RecordingGLRenderingContext::uniform2f(IGLUniformLocation* location,
+                                            GLfloat /*v0*/, GLfloat /*v1*/)
+{
+  _uniform(GLCommandType::UNIFORM2F, location, 2);
+}
+
+void RecordingGLRenderingContext::uniform2fv(IGLUniformLocation* location,
+                                             const Float32Array& v)
+{
+  _uniform(GLCommandType::UNIFORM2FV, location, v.size());
+}
+
+void RecordingGLRenderingContext::uniform2i(IGLUniformLocation* location,
+                                            GLint /*v0*/, GLint /*v1*/)
+{
+  _uniform(GLCommandType::UNIFORM2I, location, 2);
+}
+
+void RecordingGLRenderingContext::uniform2iv(IGLUniformLocation* location,
+                                             const Int32Array& v)
+{
+  _uniform(GLCommandType::UNIFORM2IV, location, v.size());
+}
+
+void RecordingGLRenderingContext::uniform3f(IGLUniformLocation* location,
+                                            GLfloat /*v0*/, GLfloat /*v1*/,
+                                            GLfloat /*v2*/)
+{
+  _uniform(GLCommandType::UNIFORM3F, location, 3);
+}
+
+void RecordingGLRenderingContext::uniform3fv(IGLUniformLocation* location,
+                                             const Float32Array& v)
+{
+  _uniform(GLCommandType::UNIFORM3FV, location, v.size());
+}
+
+void RecordingGLRenderingContext::uniform3i(IGLUniformLocation* location,
+                                            GLint /*v0*/, GLint /*v1*/,
+                                            GLint /*v2*/)
+{
+  _uniform(GLCommandType::UNIFORM3I, location, 3);
+}
+
+void RecordingGLRenderingContext::uniform3iv(IGLUniformLocation* location,
+                                             const Int32Array& v)
+{
+  _uniform(GLCommandType::UNIFORM3IV, location, v.size());
+}
+
+void RecordingGLRenderingContext::uniform4f(IGLUniformLocation* location,
+                                            GLfloat /*v0*/, GLfloat /*v1*/,
+                                            GLfloat /*v2*/, GLfloat /*v3*/)
+{
+  _uniform(GLCommandType::UNIFORM4F, location, 4);
+}
+
+void RecordingGLRenderingContext::uniform4fv(IGLUniformLocation* location,
+                                             const Float32Array& v)
+{
+  _uniform(GLCommandType::UNIFORM4FV, location, v.size());
+}
+
+void RecordingGLRenderingContext::uniform4i(IGLUniformLocation* location,
+                                            GLint /*v0*/, GLint /*v1*/,
+                                            GLint /*v2*/, GLint /*v3*/)
+{
+  _uniform(GLCommandType::UNIFORM4I, location, 4);
+}
+
+void RecordingGLRenderingContext::uniform4iv(IGLUniformLocation* location,
+                                             const Int32Array& v)
+{
+  _uniform(GLCommandType::UNIFORM4IV, location, v.size());
+}
+
+void RecordingGLRenderingContext::uniformBlockBinding(
+  IGLProgram* program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+  _record(GLCommandType::UNIFORM_BLOCK_BINDING,
+          {{program ? program->value : 0, uniformBlockIndex,
+            uniformBlockBinding, 0}});
+}
+
+void RecordingGLRenderingContext::uniformMatrix2fv(
+  IGLUniformLocation* location, GLboolean /*transpose*/,
+  const Float32Array& value)
+{
+  _uniform(GLCommandType::UNIFORM_MATRIX2FV, location, value.size());
+}
+
+void RecordingGLRenderingContext::uniformMatrix3fv(
+  IGLUniformLocation* location, GLboolean /*transpose*/,
+  const Float32Array& value)
+{
+  _uniform(GLCommandType::UNIFORM_MATRIX3FV, location, value.size());
+}
+
+void RecordingGLRenderingContext::uniformMatrix4fv(
+  IGLUniformLocation* location, GLboolean /*transpose*/,
+  const Float32Array& value)
+{
+  _uniform(GLCommandType::UNIFORM_MATRIX4FV, location, value.size());
+}
+
+void RecordingGLRenderingContext::uniformMatrix4fv(
+  IGLUniformLocation* location, GLboolean /*transpose*/,
+  const std::array<float, 16>& value)
+{
+  _uniform(GLCommandType::UNIFORM_MATRIX4FV, location, value.size());
+}
+
+void RecordingGLRenderingContext::useProgram(IGLProgram* program)
+{
+  _setState(GLCommandType::USE_PROGRAM, GLCommandType::USE_PROGRAM, 0,
+            {{program ? program->value : 0, 0, 0, 0}});
+  ++_statistics.programChanges;
+}
+
+void RecordingGLRenderingContext::validateProgram(IGLProgram* program)
+{
+  _record(GLCommandType::VALIDATE_PROGRAM,
+          {{program ? program->value : 0, 0, 0, 0}});
+}
+
+void RecordingGLRenderingContext::vertexAttrib1f(GLuint index, GLfloat v0)
+{
+  _record(GLCommandType::VERTEX_ATTRIB1F, {{index, _bits(v0), 0, 0}});
+}
+
+void RecordingGLRenderingContext::vertexAttrib1fv(GLuint indx,
+                                                  Float32Array& values)
+{
+  _record(GLCommandType::VERTEX_ATTRIB1FV, {{indx, 0, 0, 0}},
+          static_cast<GLsizeiptr>(values.size()));
+}
+
+void RecordingGLRenderingContext::vertexAttrib2f(GLuint index, GLfloat v0,
+                                                 GLfloat v1)
+{
+  _record(GLCommandType::VERTEX_ATTRIB2F, {{index, _bits(v0), _bits(v1), 0}});
+}
+
+void RecordingGLRenderingContext::vertexAttrib2fv(GLuint index,
+                                                  Float32Array& values)
+{
+  _record(GLCommandType::VERTEX_ATTRIB2FV, {{index, 0, 0, 0}},
+          static_cast<GLsizeiptr>(values.size()));
+}
+
+void RecordingGLRenderingContext::vertexAttrib3f(GLuint index, GLfloat v0,
+                                                 GLfloat v1, GLfloat v2)
+{
+  _record(GLCommandType::VERTEX_ATTRIB3F,
+          {{index, _bits(v0), _bits(v1), _bits(v2)}});
+}
+
+void RecordingGLRenderingContext::vertexAttrib3fv(GLuint index,
+                                                  Float32Array& values)
+{
+  _record(GLCommandType::VERTEX_ATTRIB3FV, {{index, 0, 0, 0}},
+          static_cast<GLsizeiptr>(values.size()));
+}
+
+void RecordingGLRenderingContext::vertexAttrib4f(GLuint index, GLfloat v0,
+                                                 GLfloat v1, GLfloat v2,
+                                                 GLfloat /*v3*/)
+{
+  _record(GLCommandType::VERTEX_ATTRIB4F,
+          {{index, _bits(v0), _bits(v1), _bits(v2)}});
+}
+
+void RecordingGLRenderingContext::vertexAttrib4fv(GLuint index,
+                                                  Float32Array& values)
+{
+  _record(GLCommandType::VERTEX_ATTRIB4FV, {{index, 0, 0, 0}},
+          static_cast<GLsizeiptr>(values.size()));
+}
+
+void RecordingGLRenderingContext::vertexAttribDivisor(GLuint index,
+                                                      GLuint divisor)
+{
+  _setState(GLCommandType::VERTEX_ATTRIB_DIVISOR,
+            GLCommandType::VERTEX_ATTRIB_DIVISOR, index,
+            {{index, divisor, 0, 0}});
+}
+
+void RecordingGLRenderingContext::vertexAttribPointer(GLuint index, GLint size,
+                                                      GLenum type,
+                                                      GLboolean normalized,
+                                                      GLint stride,
+                                                      GLintptr offset)
+{
+  // The pointer also captures the buffer bound to GL_ARRAY_BUFFER
+  GLCommandArgs buffer{{0, 0, 0, 0}};
+  _stateValue(GLCommandType::BIND_BUFFER, GL::ARRAY_BUFFER, buffer);
+  const auto format = (static_cast<GLuint>(size) << 24)
+                      | (static_cast<GLuint>(normalized) << 16)
+                      | (type & 0xFFFF);
+  _setState(GLCommandType::VERTEX_ATTRIB_POINTER,
+            GLCommandType::VERTEX_ATTRIB_POINTER, index,
+            {{buffer[1], format, static_cast<GLuint>(stride),
+              static_cast<GLuint>(offset)}});
+}
+
+void RecordingGLRenderingContext::viewport(GLint x, GLint y, GLsizei width,
+                                           GLsizei height)
+{
+  _setState(GLCommandType::VIEWPORT, GLCommandType::VIEWPORT, 0,
+            {{static_cast<GLuint>(x), static_cast<GLuint>(y),
+              static_cast<GLuint>(width), static_cast<GLuint>(height)}});
+}
+
+} // end of namespace GL
+} // end of namespace BABYLON
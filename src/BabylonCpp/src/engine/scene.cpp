@@ -13,8 +13,10 @@
 #include <babylon/collisions/collision_coordinator_worker.h>
 #include <babylon/collisions/icollision_coordinator.h>
 #include <babylon/core/logging.h>
+#include <babylon/core/task_scheduler.h>
 #include <babylon/culling/bounding_box.h>
 #include <babylon/culling/bounding_info.h>
+#include <babylon/culling/bounding_volume_arrays.h>
 #include <babylon/culling/ray.h>
 #include <babylon/debug/debug_layer.h>
 #include <babylon/engine/engine.h>
@@ -35,8 +37,11 @@
 #include <babylon/math/frustum.h>
 #include <babylon/mesh/abstract_mesh.h>
 #include <babylon/mesh/geometry.h>
+#include <babylon/mesh/mesh.h>
 #include <babylon/mesh/simplification/simplification_queue.h>
 #include <babylon/mesh/sub_mesh.h>
+#include <babylon/mesh/static_batcher.h>
+#include <babylon/mesh/transform_hierarchy.h>
 #include <babylon/morph/morph_target_manager.h>
 #include <babylon/particles/particle_system.h>
 #include <babylon/physics/physics_engine.h>
@@ -61,6 +66,8 @@ milliseconds_t Scene::LongPressDelay      = std::chrono::milliseconds(500);
 milliseconds_t Scene::DoubleClickDelay    = std::chrono::milliseconds(300);
 bool Scene::ExclusiveDoubleClickMode      = false;
 
+size_t Scene::MinActiveMeshesPerEvaluationBatch = 1024;
+
 Scene::Scene(Engine* engine)
     : autoClear{true}
     , clearColor{Color4(0.2f, 0.2f, 0.3f, 1.f)}
@@ -145,6 +152,11 @@ Scene::Scene(Engine* engine)
     , _intermediateRendering{false}
     , _viewUpdateFlag{-1}
     , _projectionUpdateFlag{-1}
+    , _transformHierarchy{std_util::make_unique<TransformHierarchy>(this)}
+    , _staticBatcher{nullptr}
+    , _parallelActiveMeshesEvaluation{false}
+    , _activeMeshesCandidatesVolumes{
+        std_util::make_unique<BoundingVolumeArrays>()}
     , _renderingManager{nullptr}
     , _physicsEngine{nullptr}
     , _transformMatrix{Matrix::Zero()}
@@ -422,6 +434,16 @@ bool Scene::workerCollisions() const
   return _workerCollisions;
 }
 
+void Scene::setParallelActiveMeshesEvaluation(bool enabled)
+{
+  _parallelActiveMeshesEvaluation = enabled;
+}
+
+bool Scene::parallelActiveMeshesEvaluation() const
+{
+  return _parallelActiveMeshesEvaluation;
+}
+
 std::vector<AbstractMesh*> Scene::getMeshes() const
 {
   std::vector<AbstractMesh*> _meshes;
@@ -1295,6 +1317,10 @@ void Scene::addMesh(std::unique_ptr<AbstractMesh>&& newMesh)
   newMesh->uniqueId = getUniqueId();
   auto _newMesh     = newMesh.get();
   meshes.emplace_back(std::move(newMesh));
+  _meshesByID.add(_newMesh->id, _newMesh);
+  _meshesByName.add(_newMesh->name, _newMesh);
+  _meshesByUniqueID.add(_newMesh->uniqueId, _newMesh);
+  _transformHierarchy->markAsDirty();
 
   // notify the collision coordinator
   if (collisionCoordinator) {
@@ -1312,8 +1338,17 @@ int Scene::removeMesh(AbstractMesh* toRemove)
                      return mesh.get() == toRemove;
                    });
   int index = static_cast<int>(it - meshes.begin());
+  if (_staticBatcher) {
+    _staticBatcher->_onMeshRemoved(toRemove);
+  }
   if (it != meshes.end()) {
+    _meshesByID.remove(toRemove->id, toRemove);
+    _meshesByName.remove(toRemove->name, toRemove);
+    _meshesByUniqueID.remove(toRemove->uniqueId, toRemove);
+    // Not destroyed yet, as the mesh is removed while it is being disposed
+    _removedMeshes.emplace_back(std::move(*it));
     meshes.erase(it);
+    _transformHierarchy->markAsDirty();
   }
   // notify the collision coordinator
   if (collisionCoordinator) {
@@ -1366,6 +1401,9 @@ int Scene::removeLight(Light* toRemove)
   int index = static_cast<int>(it - lights.begin());
   if (it != lights.end()) {
     // Remove from the scene if mesh found
+    _lightsByID.remove(toRemove->id, toRemove);
+    _lightsByName.remove(toRemove->name, toRemove);
+    _lightsByUniqueID.remove(toRemove->uniqueId, toRemove);
     lights.erase(it);
   }
 
@@ -1381,8 +1419,17 @@ int Scene::removeCamera(Camera* toRemove)
                             return camera.get() == toRemove;
                           });
   int index = static_cast<int>(it1 - cameras.begin());
+  // notify the collision coordinator
+  if (collisionCoordinator) {
+    collisionCoordinator->onCameraRemoved(toRemove);
+  }
   if (it1 != cameras.end()) {
     // Remove from the scene if camera found
+    _camerasByID.remove(toRemove->id, toRemove);
+    _camerasByName.remove(toRemove->name, toRemove);
+    _camerasByUniqueID.remove(toRemove->uniqueId, toRemove);
+    // Not destroyed yet, as the camera is removed while it is being disposed
+    _removedCameras.emplace_back(std::move(*it1));
     cameras.erase(it1);
   }
   // Remove from activeCameras
@@ -1411,6 +1458,9 @@ void Scene::addLight(std::unique_ptr<Light>&& newLight)
   newLight->uniqueId = getUniqueId();
   auto _newLight     = newLight.get();
   lights.emplace_back(std::move(newLight));
+  _lightsByID.add(_newLight->id, _newLight);
+  _lightsByName.add(_newLight->name, _newLight);
+  _lightsByUniqueID.add(_newLight->uniqueId, _newLight);
   onNewLightAddedObservable.notifyObservers(_newLight);
 }
 
@@ -1419,9 +1469,74 @@ void Scene::addCamera(std::unique_ptr<Camera>&& newCamera)
   newCamera->uniqueId = getUniqueId();
   auto _newCamera     = newCamera.get();
   cameras.emplace_back(std::move(newCamera));
+  _camerasByID.add(_newCamera->id, _newCamera);
+  _camerasByName.add(_newCamera->name, _newCamera);
+  _camerasByUniqueID.add(_newCamera->uniqueId, _newCamera);
   onNewCameraAddedObservable.notifyObservers(_newCamera);
 }
 
+void Scene::addMaterial(std::unique_ptr<Material>&& newMaterial)
+{
+  auto _newMaterial = newMaterial.get();
+  materials.emplace_back(std::move(newMaterial));
+  _materialsByID.add(_newMaterial->id, _newMaterial);
+  _materialsByName.add(_newMaterial->name, _newMaterial);
+}
+
+int Scene::removeMaterial(Material* toRemove)
+{
+  auto it
+    = std::find_if(materials.begin(), materials.end(),
+                   [&toRemove](const std::unique_ptr<Material>& material) {
+                     return material.get() == toRemove;
+                   });
+  int index = static_cast<int>(it - materials.begin());
+  if (it != materials.end()) {
+    // Remove from the scene if material found
+    _materialsByID.remove(toRemove->id, toRemove);
+    _materialsByName.remove(toRemove->name, toRemove);
+    materials.erase(it);
+  }
+
+  return index;
+}
+
+void Scene::_onIDChanged(Node* node, const std::string& oldID)
+{
+  if (auto mesh = dynamic_cast<AbstractMesh*>(node)) {
+    _meshesByID.rename(oldID, mesh->id, mesh);
+  }
+  else if (auto light = dynamic_cast<Light*>(node)) {
+    _lightsByID.rename(oldID, light->id, light);
+  }
+  else if (auto camera = dynamic_cast<Camera*>(node)) {
+    _camerasByID.rename(oldID, camera->id, camera);
+  }
+}
+
+void Scene::_onNameChanged(Node* node, const std::string& oldName)
+{
+  if (auto mesh = dynamic_cast<AbstractMesh*>(node)) {
+    _meshesByName.rename(oldName, mesh->name, mesh);
+  }
+  else if (auto light = dynamic_cast<Light*>(node)) {
+    _lightsByName.rename(oldName, light->name, light);
+  }
+  else if (auto camera = dynamic_cast<Camera*>(node)) {
+    _camerasByName.rename(oldName, camera->name, camera);
+  }
+}
+
+void Scene::_onIDChanged(Material* material, const std::string& oldID)
+{
+  _materialsByID.rename(oldID, material->id, material);
+}
+
+void Scene::_onNameChanged(Material* material, const std::string& oldName)
+{
+  _materialsByName.rename(oldName, material->name, material);
+}
+
 void Scene::switchActiveCamera(Camera* newCamera, bool attachControl)
 {
   auto canvas = _engine->getRenderingCanvas();
@@ -1458,22 +1573,12 @@ Camera* Scene::setActiveCameraByName(const std::string& name)
 
 Material* Scene::getMaterialByID(const std::string& id)
 {
-  auto it = std::find_if(materials.begin(), materials.end(),
-                         [&id](const std::unique_ptr<Material>& material) {
-                           return material->id == id;
-                         });
-
-  return (it == materials.end()) ? nullptr : (*it).get();
+  return _materialsByID.first(id);
 }
 
 Material* Scene::getMaterialByName(const std::string& name)
 {
-  auto it = std::find_if(materials.begin(), materials.end(),
-                         [&name](const std::unique_ptr<Material>& material) {
-                           return material->name == name;
-                         });
-
-  return (it == materials.end()) ? nullptr : (*it).get();
+  return _materialsByName.first(name);
 }
 
 LensFlareSystem* Scene::getLensFlareSystemByName(const std::string& name)
@@ -1512,31 +1617,17 @@ std::vector<Camera*> Scene::getCameras() const
 
 Camera* Scene::getCameraByID(const std::string& id)
 {
-  auto it = std::find_if(
-    cameras.begin(), cameras.end(),
-    [&id](const std::unique_ptr<Camera>& camera) { return camera->id == id; });
-
-  return (it == cameras.end()) ? nullptr : (*it).get();
+  return _camerasByID.first(id);
 }
 
 Camera* Scene::getCameraByUniqueID(unsigned int uniqueId)
 {
-  auto it = std::find_if(cameras.begin(), cameras.end(),
-                         [uniqueId](const std::unique_ptr<Camera>& camera) {
-                           return camera->uniqueId == uniqueId;
-                         });
-
-  return (it == cameras.end()) ? nullptr : (*it).get();
+  return _camerasByUniqueID.first(uniqueId);
 }
 
 Camera* Scene::getCameraByName(const std::string& name)
 {
-  auto it = std::find_if(cameras.begin(), cameras.end(),
-                         [&name](const std::unique_ptr<Camera>& camera) {
-                           return camera->name == name;
-                         });
-
-  return (it == cameras.end()) ? nullptr : (*it).get();
+  return _camerasByName.first(name);
 }
 
 Bone* Scene::getBoneByID(const std::string& id)
@@ -1567,31 +1658,17 @@ Bone* Scene::getBoneByName(const std::string& name)
 
 Light* Scene::getLightByName(const std::string& name)
 {
-  auto it = std::find_if(lights.begin(), lights.end(),
-                         [&name](const std::unique_ptr<Light>& light) {
-                           return light->name == name;
-                         });
-
-  return (it == lights.end()) ? nullptr : (*it).get();
+  return _lightsByName.first(name);
 }
 
 Light* Scene::getLightByID(const std::string& id)
 {
-  auto it = std::find_if(
-    lights.begin(), lights.end(),
-    [&id](const std::unique_ptr<Light>& light) { return light->id == id; });
-
-  return (it == lights.end()) ? nullptr : (*it).get();
+  return _lightsByID.first(id);
 }
 
 Light* Scene::getLightByUniqueID(unsigned int uniqueId)
 {
-  auto it = std::find_if(lights.begin(), lights.end(),
-                         [uniqueId](const std::unique_ptr<Light>& light) {
-                           return light->uniqueId == uniqueId;
-                         });
-
-  return (it == lights.end()) ? nullptr : (*it).get();
+  return _lightsByUniqueID.first(uniqueId);
 }
 
 ParticleSystem* Scene::getParticleSystemByID(const std::string& id)
@@ -1607,12 +1684,7 @@ ParticleSystem* Scene::getParticleSystemByID(const std::string& id)
 
 Geometry* Scene::getGeometryByID(const std::string& id)
 {
-  auto it = std::find_if(_geometries.begin(), _geometries.end(),
-                         [&id](const std::unique_ptr<Geometry>& geometry) {
-                           return geometry->id == id;
-                         });
-
-  return (it == _geometries.end()) ? nullptr : (*it).get();
+  return _geometriesByID.first(id);
 }
 
 bool Scene::pushGeometry(std::unique_ptr<Geometry>&& geometry, bool force)
@@ -1623,6 +1695,7 @@ bool Scene::pushGeometry(std::unique_ptr<Geometry>&& geometry, bool force)
 
   auto _geometry = geometry.get();
   _geometries.emplace_back(std::move(geometry));
+  _geometriesByID.add(_geometry->id, _geometry);
 
   // Notify the collision coordinator
   if (collisionCoordinator) {
@@ -1642,6 +1715,7 @@ bool Scene::removeGeometry(Geometry* geometry)
                      return _geometry.get() == geometry;
                    });
   if (it != _geometries.end()) {
+    _geometriesByID.remove(geometry->id, geometry);
     _geometries.erase(it);
 
     // notify the collision coordinator
@@ -1663,75 +1737,35 @@ std::vector<std::unique_ptr<Geometry>>& Scene::getGeometries()
 
 AbstractMesh* Scene::getMeshByID(const std::string& id)
 {
-  auto it = std::find_if(meshes.begin(), meshes.end(),
-                         [&id](const std::unique_ptr<AbstractMesh>& mesh) {
-                           return mesh->id == id;
-                         });
-
-  return (it == meshes.end()) ? nullptr : (*it).get();
+  return _meshesByID.first(id);
 }
 
 std::vector<AbstractMesh*> Scene::getMeshesByID(const std::string& id)
 {
-  std::vector<AbstractMesh*> filteredMeshes;
-  std::for_each(
-    meshes.begin(), meshes.end(),
-    [&filteredMeshes, &id](const std::unique_ptr<AbstractMesh>& mesh) {
-      if (mesh->id == id) {
-        filteredMeshes.emplace_back(mesh.get());
-      }
-    });
-  return filteredMeshes;
+  return _meshesByID.all(id);
 }
 
 AbstractMesh* Scene::getMeshByUniqueID(unsigned int uniqueId)
 {
-  auto it
-    = std::find_if(meshes.begin(), meshes.end(),
-                   [&uniqueId](const std::unique_ptr<AbstractMesh>& mesh) {
-                     return mesh->uniqueId == uniqueId;
-                   });
-
-  return (it == meshes.end()) ? nullptr : (*it).get();
+  return _meshesByUniqueID.first(uniqueId);
 }
 
 AbstractMesh* Scene::getLastMeshByID(const std::string& id)
 {
-  if (meshes.empty()) {
-    return nullptr;
-  }
-
-  for (size_t index = meshes.size(); index > 0; --index) {
-    if (meshes[index - 1]->id == id) {
-      return meshes[index - 1].get();
-    }
-  }
-
-  return nullptr;
+  return _meshesByID.last(id);
 }
 
 Node* Scene::getLastEntryByID(const std::string& id)
 {
-  size_t index;
-  for (index = meshes.size(); index > 0; --index) {
-    if (meshes[index - 1]->id == id) {
-      return meshes[index - 1].get();
-    }
-  }
-
-  for (index = cameras.size(); index > 0; --index) {
-    if (cameras[index - 1]->id == id) {
-      return cameras[index - 1].get();
-    }
+  if (auto mesh = _meshesByID.last(id)) {
+    return mesh;
   }
 
-  for (index = lights.size(); index > 0; --index) {
-    if (lights[index - 1]->id == id) {
-      return lights[index - 1].get();
-    }
+  if (auto camera = _camerasByID.last(id)) {
+    return camera;
   }
 
-  return nullptr;
+  return _lightsByID.last(id);
 }
 
 Node* Scene::getNodeByID(const std::string& id)
@@ -1786,12 +1820,7 @@ Node* Scene::getNodeByName(const std::string& name)
 
 AbstractMesh* Scene::getMeshByName(const std::string& name)
 {
-  auto it = std::find_if(meshes.begin(), meshes.end(),
-                         [&name](const std::unique_ptr<AbstractMesh>& mesh) {
-                           return mesh->name == name;
-                         });
-
-  return (it == meshes.end()) ? nullptr : (*it).get();
+  return _meshesByName.first(name);
 }
 
 Sound* Scene::getSoundByName(const std::string& /*name*/)
@@ -1932,18 +1961,33 @@ void Scene::_evaluateActiveMeshes()
     Frustum::GetPlanesToRef(_transformMatrix, _frustumPlanes);
   }
 
+  // World matrices, updated before the octree selection which relies on the
+  // bounding infos
+  _transformHierarchy->update();
+
+  // Static batches, rebuilt or updated from their members
+  if (_staticBatcher) {
+    _staticBatcher->update();
+  }
+
   // Meshes
   std::vector<AbstractMesh*> _meshes;
 
   if (_selectionOctree) { // Octree
-    _meshes = _selectionOctree->select(_frustumPlanes);
+    _meshes = _selectionOctree->select(_frustumPlanes, false);
   }
   else { // Full scene traversal
     _meshes = getMeshes();
   }
 
-  for (auto& mesh : meshes) {
-    if (mesh->isBlocked()) {
+  // LOD selection, it relies on shared temporaries and can trigger user
+  // callbacks so it is kept on the render thread.
+  _activeMeshesCandidates.clear();
+  _activeMeshesCandidatesLOD.clear();
+  auto& volumes = *_activeMeshesCandidatesVolumes;
+  for (auto& mesh : _meshes) {
+    // The members of a static batch are rendered by their batch
+    if (mesh->isBlocked() || mesh->_isStaticBatched) {
       continue;
     }
 
@@ -1953,17 +1997,15 @@ void Scene::_evaluateActiveMeshes()
       continue;
     }
 
-    mesh->computeWorldMatrix();
-
     // Intersections
     if (mesh->actionManager
         && mesh->actionManager->hasSpecificTriggers(
              {ActionManager::OnIntersectionEnterTrigger,
               ActionManager::OnIntersectionExitTrigger})) {
       if (std::find(_meshesForIntersections.begin(),
-                    _meshesForIntersections.end(), mesh.get())
+                    _meshesForIntersections.end(), mesh)
           == _meshesForIntersections.end()) {
-        _meshesForIntersections.emplace_back(mesh.get());
+        _meshesForIntersections.emplace_back(mesh);
       }
     }
 
@@ -1976,16 +2018,45 @@ void Scene::_evaluateActiveMeshes()
 
     mesh->_preActivate();
 
-    if (mesh->alwaysSelectAsActiveMesh
-        || ((mesh->isVisible && mesh->visibility > 0)
-            && ((mesh->layerMask & activeCamera->layerMask) != 0)
-            && mesh->isInFrustum(_frustumPlanes))) {
-      _activeMeshes.emplace_back(dynamic_cast<Mesh*>(mesh.get()));
-      activeCamera->_activeMeshes.emplace_back(_activeMeshes.back());
-      mesh->_activate(_renderId);
+    // The bounding volumes are only copied to the culling arrays when the
+    // candidate changes, then mirrored by BoundingInfo::update()
+    const size_t index = _activeMeshesCandidates.size();
+    if (index >= volumes.size()) {
+      volumes.resize(std::max(_meshes.size(), index + 1));
+    }
+    if (mesh->_boundingInfo) {
+      volumes.attach(index, *mesh->_boundingInfo);
+    }
+    else {
+      volumes.detach(index);
+    }
+
+    _activeMeshesCandidates.emplace_back(mesh);
+    _activeMeshesCandidatesLOD.emplace_back(meshLOD);
+  }
+
+  // Frustum culling
+  _evaluateActiveMeshesVisibility();
+
+  // Activation, in candidate order so that the rendering manager dispatch does
+  // not depend on how the visibility tests were scheduled
+  for (size_t i = 0; i < _activeMeshesCandidates.size(); ++i) {
+    if (!BoundingVolumeArrays::IsVisible(_activeMeshesCandidatesVisibility,
+                                         i)) {
+      continue;
+    }
 
-      _activeMesh(meshLOD);
+    auto mesh  = _activeMeshesCandidates[i];
+    auto _mesh = dynamic_cast<Mesh*>(mesh);
+    if (_mesh && !mesh->alwaysSelectAsActiveMesh) {
+      _mesh->_checkDelayState();
     }
+
+    _activeMeshes.emplace_back(_mesh);
+    activeCamera->_activeMeshes.emplace_back(_activeMeshes.back());
+    mesh->_activate(_renderId);
+
+    _activeMesh(_activeMeshesCandidatesLOD[i]);
   }
 
   // Particle systems
@@ -2008,6 +2079,61 @@ void Scene::_evaluateActiveMeshes()
   _particlesDuration.endMonitoring(false);
 }
 
+void Scene::_evaluateActiveMeshesVisibility()
+{
+  auto& volumes          = *_activeMeshesCandidatesVolumes;
+  const size_t wordCount = (_activeMeshesCandidates.size()
+                            + BoundingVolumeArrays::ObjectsPerWord - 1)
+                           / BoundingVolumeArrays::ObjectsPerWord;
+  _activeMeshesCandidatesVisibility.resize(wordCount);
+
+  // Batches are made of whole words of the visibility bitmask, the flags of a
+  // batch are set then its bounding volumes are culled 4 at a time
+  const auto evaluateBatch = [this, &volumes](size_t startWord,
+                                              size_t endWord) {
+    const size_t end = std::min(endWord * BoundingVolumeArrays::ObjectsPerWord,
+                                _activeMeshesCandidates.size());
+    for (size_t i = startWord * BoundingVolumeArrays::ObjectsPerWord; i < end;
+         ++i) {
+      _setActiveMeshCandidateFlags(i);
+    }
+    volumes.cull(_frustumPlanes, startWord, endWord,
+                 _activeMeshesCandidatesVisibility.data());
+  };
+
+  const size_t minBatchSize
+    = std::max(MinActiveMeshesPerEvaluationBatch
+                 / BoundingVolumeArrays::ObjectsPerWord,
+               static_cast<size_t>(1));
+  if (!_parallelActiveMeshesEvaluation || wordCount < 2 * minBatchSize) {
+    evaluateBatch(0, wordCount);
+    return;
+  }
+
+  // The render thread takes part in the evaluation
+  TaskScheduler::Instance().parallelFor(0, wordCount, evaluateBatch,
+                                        minBatchSize);
+}
+
+void Scene::_setActiveMeshCandidateFlags(size_t index)
+{
+  auto& volumes = *_activeMeshesCandidatesVolumes;
+  auto mesh     = _activeMeshesCandidates[index];
+  volumes.setAlwaysVisible(index, mesh->alwaysSelectAsActiveMesh);
+  if (mesh->alwaysSelectAsActiveMesh) {
+    return;
+  }
+
+  // Side effect free part of Mesh::isInFrustum, the delay loading check is
+  // performed on the render thread once the mesh is known to be visible
+  auto _mesh = dynamic_cast<Mesh*>(mesh);
+  volumes.setCulled(
+    index,
+    !(mesh->isVisible && mesh->visibility > 0)
+      || ((mesh->layerMask & activeCamera->layerMask) == 0)
+      || (_mesh && _mesh->delayLoadState == Engine::DELAYLOADSTATE_LOADING));
+}
+
 void Scene::_activeMesh(AbstractMesh* mesh)
 {
   if (mesh->skeleton() && skeletonsEnabled()) {
@@ -2298,6 +2424,8 @@ void Scene::render()
   _activeBones.fetchNewFrame();
   getEngine()->drawCallsPerfCounter().fetchNewFrame();
   _meshesForIntersections.clear();
+  _removedMeshes.clear();
+  _removedCameras.clear();
   resetCachedMaterial();
 
   Tools::StartPerformanceCounter("Scene rendering");
@@ -2308,7 +2436,7 @@ void Scene::render()
   }
 
   // Simplification Queue
-  if (simplificationQueue && !simplificationQueue->running) {
+  if (simplificationQueue) {
     simplificationQueue->executeNext();
   }
 
@@ -2635,6 +2763,9 @@ void Scene::dispose(bool /*doNotRecurse*/)
     light->dispose();
   }
 
+  // Static batching
+  disableStaticBatching();
+
   // Release meshes
   for (auto& mesh : meshes) {
     mesh->dispose(true);
@@ -2685,6 +2816,10 @@ void Scene::dispose(bool /*doNotRecurse*/)
     disablePhysicsEngine();
   }
 
+  // Destroy the removed meshes and cameras, no frame being rendered anymore
+  _removedMeshes.clear();
+  _removedCameras.clear();
+
   // Remove from engine
   _engine->scenes.erase(
     std::remove(_engine->scenes.begin(), _engine->scenes.end(), this),
@@ -2730,10 +2865,7 @@ Octree<AbstractMesh*>* Scene::createOrUpdateSelectionOctree(size_t maxCapacity,
 {
   if (!_selectionOctree) {
     _selectionOctree = new Octree<AbstractMesh*>(
-      [](AbstractMesh* entry, OctreeBlock<AbstractMesh*>& block) {
-        Octree<AbstractMesh*>::CreationFuncForMeshes(entry, block);
-      },
-      maxCapacity, maxDepth);
+      Octree<AbstractMesh*>::BoundsFuncForMeshes, maxCapacity, maxDepth);
   }
 
   auto worldExtends = getWorldExtends();
@@ -2745,6 +2877,32 @@ Octree<AbstractMesh*>* Scene::createOrUpdateSelectionOctree(size_t maxCapacity,
   return _selectionOctree;
 }
 
+/** Static batching **/
+StaticBatcher* Scene::enableStaticBatching(float cellSize)
+{
+  disableStaticBatching();
+
+  _staticBatcher = std_util::make_unique<StaticBatcher>(this, cellSize);
+  _staticBatcher->addStaticMeshes();
+  return _staticBatcher.get();
+}
+
+void Scene::disableStaticBatching()
+{
+  if (!_staticBatcher) {
+    return;
+  }
+
+  // Reset first, as disposing the batch meshes removes them from the scene
+  auto staticBatcher = std::move(_staticBatcher);
+  staticBatcher->dispose();
+}
+
+StaticBatcher* Scene::getStaticBatcher()
+{
+  return _staticBatcher.get();
+}
+
 /** Picking **/
 Ray* Scene::createPickingRay(int x, int y, Matrix* world, Camera* camera)
 {
@@ -0,0 +1,233 @@
+#include <babylon/engine/shader_program_cache.h>
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>
+
+#include <babylon/core/filesystem.h>
+#include <babylon/core/logging.h>
+#include <babylon/interfaces/igl_rendering_context.h>
+
+namespace BABYLON {
+
+namespace {
+
+// Identifies the files of the cache and the version of their layout:
+// magic, key length, key digest, binary format, driver info size, driver
+// info, binary size, binary
+const std::string FILE_MAGIC = "BJSPRGM2";
+
+// Suffix of the temporary files, unique to the process and thread writing
+// them
+std::string temporarySuffix()
+{
+  static const auto processTag = std::random_device{}();
+  const auto threadId
+    = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  const auto time = static_cast<std::size_t>(
+    std::chrono::steady_clock::now().time_since_epoch().count());
+  return "." + std::to_string(processTag) + "." + std::to_string(threadId) + "."
+         + std::to_string(time) + ".tmp";
+}
+
+template <typename T>
+void appendValue(std::string& data, T value)
+{
+  data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(const std::string& data, std::size_t& offset, T& value)
+{
+  if (offset + sizeof(value) > data.size()) {
+    return false;
+  }
+  std::memcpy(&value, &data[offset], sizeof(value));
+  offset += sizeof(value);
+  return true;
+}
+
+} // end of anonymous namespace
+
+ShaderProgramCache::ShaderProgramCache(const std::string& directory)
+    : _directory{directory}
+    , _driverInfoContext{nullptr}
+    , _hitCount{0}
+    , _missCount{0}
+    , _rejectedCount{0}
+    , _storedCount{0}
+{
+  if (!Filesystem::isDirectory(_directory)
+      && !Filesystem::createDirectory(_directory)) {
+    BABYLON_LOGF_WARN("ShaderProgramCache",
+                      "Could not create the cache directory %s",
+                      _directory.c_str());
+  }
+}
+
+ShaderProgramCache::~ShaderProgramCache()
+{
+}
+
+const std::string& ShaderProgramCache::getDirectory() const
+{
+  return _directory;
+}
+
+ShaderProgramCache::Key ShaderProgramCache::getKey(
+  GL::IGLRenderingContext* gl, const std::string& vertexCode,
+  const std::string& fragmentCode, const std::string& defines)
+{
+  // 64-bit FNV-1a hash for the name, and a multiplicative hash of the same
+  // bytes for the digest, the strings being terminated by a byte which does
+  // not appear in GLSL sources
+  Key key;
+  std::uint64_t hash = 14695981039346656037ull;
+  for (const auto* part :
+       {&_getDriverInfo(gl), &vertexCode, &fragmentCode, &defines}) {
+    key.length += part->size();
+    for (auto c : *part) {
+      const auto byte = static_cast<std::uint8_t>(c);
+      hash            = (hash ^ byte) * 1099511628211ull;
+      key.digest      = (key.digest + byte + 1) * 0x9E3779B97F4A7C15ull;
+      key.digest      = key.digest ^ (key.digest >> 29);
+    }
+    hash       = (hash ^ 0xFFu) * 1099511628211ull;
+    key.digest = (key.digest + 0x100u) * 0x9E3779B97F4A7C15ull;
+  }
+
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016llx",
+                static_cast<unsigned long long>(hash));
+  key.name = name;
+  return key;
+}
+
+std::unique_ptr<GL::IGLProgram>
+ShaderProgramCache::load(GL::IGLRenderingContext* gl, const Key& key)
+{
+  const auto path = _getPath(key);
+  if (!Filesystem::isFile(path)) {
+    ++_missCount;
+    return nullptr;
+  }
+
+  // Parses the file, checking that it was written for this program and for
+  // the current driver
+  const auto data      = Filesystem::readFileContents(path.c_str());
+  std::size_t offset   = FILE_MAGIC.size();
+  std::uint64_t length = 0;
+  std::uint64_t digest = 0;
+  std::uint32_t format = 0;
+  std::uint32_t size   = 0;
+  bool valid = data.compare(0, offset, FILE_MAGIC) == 0
+               && readValue(data, offset, length) && length == key.length
+               && readValue(data, offset, digest) && digest == key.digest
+               && readValue(data, offset, format)
+               && readValue(data, offset, size)
+               && offset + size <= data.size()
+               && data.compare(offset, size, _getDriverInfo(gl)) == 0;
+  if (valid) {
+    offset += size;
+    valid = readValue(data, offset, size) && offset + size == data.size();
+  }
+
+  std::unique_ptr<GL::IGLProgram> program;
+  if (valid) {
+    const Uint8Array binary(data.begin() + static_cast<long>(offset),
+                            data.end());
+    program = gl->createProgram();
+    if (!gl->programBinary(program.get(), format, binary)) {
+      gl->deleteProgram(program.get());
+      program = nullptr;
+    }
+  }
+
+  if (!program) {
+    // Stale or corrupted binary, replaced once the program is linked again
+    Filesystem::removeFile(path);
+    ++_rejectedCount;
+    return nullptr;
+  }
+
+  ++_hitCount;
+  return program;
+}
+
+bool ShaderProgramCache::store(GL::IGLRenderingContext* gl,
+                               GL::IGLProgram* program, const Key& key)
+{
+  GL::GLenum format = 0;
+  const auto binary = gl->getProgramBinary(program, format);
+  if (binary.empty()) {
+    return false;
+  }
+
+  const auto& driverInfo = _getDriverInfo(gl);
+  std::string data(FILE_MAGIC);
+  data.reserve(data.size() + 28 + driverInfo.size() + binary.size());
+  appendValue(data, key.length);
+  appendValue(data, key.digest);
+  appendValue(data, static_cast<std::uint32_t>(format));
+  appendValue(data, static_cast<std::uint32_t>(driverInfo.size()));
+  data.append(driverInfo);
+  appendValue(data, static_cast<std::uint32_t>(binary.size()));
+  data.append(binary.begin(), binary.end());
+
+  // Written aside and renamed, so that a concurrent run never reads a
+  // partially written file
+  const auto path          = _getPath(key);
+  const auto temporaryPath = path + temporarySuffix();
+  if (!Filesystem::writeFileContents(temporaryPath.c_str(), data)
+      || std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+    Filesystem::removeFile(temporaryPath);
+    return false;
+  }
+
+  ++_storedCount;
+  return true;
+}
+
+std::size_t ShaderProgramCache::getHitCount() const
+{
+  return _hitCount;
+}
+
+std::size_t ShaderProgramCache::getMissCount() const
+{
+  return _missCount;
+}
+
+std::size_t ShaderProgramCache::getRejectedCount() const
+{
+  return _rejectedCount;
+}
+
+std::size_t ShaderProgramCache::getStoredCount() const
+{
+  return _storedCount;
+}
+
+std::string ShaderProgramCache::_getPath(const Key& key) const
+{
+  return Filesystem::joinPath(_directory, key.name + ".bin");
+}
+
+const std::string&
+ShaderProgramCache::_getDriverInfo(GL::IGLRenderingContext* gl)
+{
+  if (gl != _driverInfoContext) {
+    _driverInfoContext = gl;
+    _driverInfo.clear();
+    for (auto name : {GL::VENDOR, GL::RENDERER, GL::VERSION,
+                      GL::SHADING_LANGUAGE_VERSION}) {
+      _driverInfo.append(gl->getString(name));
+      _driverInfo.push_back('\n');
+    }
+  }
+  return _driverInfo;
+}
+
+} // end of namespace BABYLON
@@ -5,8 +5,8 @@
 #include <babylon/engine/engine.h>
 #include <babylon/materials/effect_creation_options.h>
 #include <babylon/materials/effect_fallbacks.h>
-#include <babylon/materials/effect_includes_shaders_store.h>
 #include <babylon/materials/effect_shaders_store.h>
+#include <babylon/materials/shader_processor.h>
 #include <babylon/math/color3.h>
 #include <babylon/math/vector2.h>
 #include <babylon/math/vector4.h>
@@ -329,70 +329,7 @@ void Effect::_processIncludes(
   const std::string& sourceCode,
   const std::function<void(const std::string& data)>& callback)
 {
-  std::ostringstream returnValue;
-  auto lines = String::split(sourceCode, '\n');
-  std::regex regex;
-  std::smatch match;
-
-  for (const auto& line : lines) {
-    // Shader includes
-    regex = std::regex("#include<(.+)>");
-    std::string includeFile;
-    if (std::regex_search(line, match, regex) && (match.size() == 2)) {
-      // Shader include found
-      includeFile = match.str(1);
-    }
-    else {
-      // Line without shader include
-      returnValue << line << std::endl;
-      continue;
-    }
-
-    if (std_util::contains(EffectIncludesShadersStore::Shaders, includeFile)) {
-      // Substitution
-      auto includeContent = EffectIncludesShadersStore::Shaders[includeFile];
-      // Instanced includes
-      regex = std::regex("#include<(.+)>\\[(.*)]");
-      if (std::regex_search(line, match, regex) && (match.size() == 3)) {
-        // Perform instanced includes
-        std::string indexString(match.str(2));
-        if (indexString.find("..") != std::string::npos) {
-          String::replaceInPlace(indexString, "..", ".");
-          std::vector<std::string> indexSplits
-            = String::split(indexString, '.');
-          if (indexSplits.size() == 2) {
-            auto minIndex = indexSplits[0];
-            auto maxIndex = indexSplits[1];
-            std::ostringstream includeContentStream;
-
-            if ((!String::isDigit(maxIndex))
-                && std_util::contains(_indexParameters, maxIndex)) {
-              maxIndex = std::to_string(_indexParameters[maxIndex]);
-            }
-
-            if (String::isDigit(minIndex) && String::isDigit(maxIndex)) {
-              size_t _minIndex = std::stoul(minIndex, nullptr, 0);
-              size_t _maxIndex = std::stoul(maxIndex, nullptr, 0);
-              for (size_t i = _minIndex; i <= _maxIndex; ++i) {
-                std::string _includeContent(includeContent);
-                String::replaceInPlace(_includeContent, "{X}",
-                                       std::to_string(i));
-                includeContentStream << _includeContent << std::endl;
-              }
-            }
-
-            returnValue << includeContentStream.str();
-          }
-        }
-      }
-      else {
-        // No instanced includes
-        returnValue << includeContent;
-      }
-    }
-  }
-
-  callback(returnValue.str());
+  callback(ShaderProcessor::ProcessIncludes(sourceCode, _indexParameters));
 }
 
 std::string Effect::_processPrecision(const std::string& source)
@@ -80,4 +80,25 @@ std::unordered_map<std::string, const char*> EffectIncludesShadersStore::Shaders
    {"shadowsVertexDeclaration", shadowsVertexDeclaration}
 };
 
+std::atomic<std::size_t> EffectIncludesShadersStore::_generation{0};
+
+void EffectIncludesShadersStore::SetShader(const std::string& name,
+                                           const char* content)
+{
+  Shaders[name] = content;
+  ++_generation;
+}
+
+void EffectIncludesShadersStore::RemoveShader(const std::string& name)
+{
+  if (Shaders.erase(name) > 0) {
+    ++_generation;
+  }
+}
+
+std::size_t EffectIncludesShadersStore::Generation()
+{
+  return _generation;
+}
+
 } // end of namespace BABYLON
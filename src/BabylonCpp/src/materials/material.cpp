@@ -65,9 +65,36 @@ IReflect::Type Material::type() const
   return IReflect::Type::MATERIAL;
 }
 
+void Material::setId(const std::string& newId)
+{
+  if (id == newId) {
+    return;
+  }
+
+  const auto oldId = id;
+  id               = newId;
+  // The multi materials are not part of the material lookups of the scene
+  if (_scene && type() != IReflect::Type::MULTIMATERIAL) {
+    _scene->_onIDChanged(this, oldId);
+  }
+}
+
+void Material::setName(const std::string& newName)
+{
+  if (name == newName) {
+    return;
+  }
+
+  const auto oldName = name;
+  name               = newName;
+  if (_scene && type() != IReflect::Type::MULTIMATERIAL) {
+    _scene->_onNameChanged(this, oldName);
+  }
+}
+
 void Material::addMaterialToScene(std::unique_ptr<Material>&& newMaterial)
 {
-  _scene->materials.emplace_back(std::move(newMaterial));
+  _scene->addMaterial(std::move(newMaterial));
 }
 
 void Material::addMultiMaterialToScene(
@@ -347,12 +374,7 @@ void Material::dispose(bool forceDisposeEffect, bool /*forceDisposeTextures*/)
   getScene()->stopAnimation(this);
 
   // Remove from scene
-  _scene->materials.erase(
-    std::remove_if(_scene->materials.begin(), _scene->materials.end(),
-                   [this](const std::unique_ptr<Material>& material) {
-                     return material.get() == this;
-                   }),
-    _scene->materials.end());
+  _scene->removeMaterial(this);
 
   // Remove from meshes
   Mesh* _mesh = nullptr;
@@ -429,7 +451,7 @@ Material::ParseMultiMaterial(const Json::value& parsedMultiMaterial,
   auto multiMaterial
     = MultiMaterial::New(Json::GetString(parsedMultiMaterial, "name"), scene);
 
-  multiMaterial->id = Json::GetString(parsedMultiMaterial, "id");
+  multiMaterial->setId(Json::GetString(parsedMultiMaterial, "id"));
 
   // Tags.AddTagsTo(multiMaterial, parsedMultiMaterial.tags);
 
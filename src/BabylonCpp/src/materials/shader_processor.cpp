@@ -0,0 +1,292 @@
+#include <babylon/materials/shader_processor.h>
+
+#include <babylon/core/string.h>
+#include <babylon/materials/effect_includes_shaders_store.h>
+
+namespace BABYLON {
+
+namespace {
+
+const std::string INCLUDE_DIRECTIVE = "#include<";
+const char* const WHITESPACES       = " \t\n\v\f\r";
+// Tokenized sources kept, the least recently used being evicted first
+constexpr std::size_t MaxCachedSources = 256;
+
+struct Include {
+  std::string name;
+  const char* content = nullptr;
+  bool instanced      = false;
+  // Whether the index string of an instanced include is a min..max range
+  bool hasRange = false;
+  std::string minIndex;
+  std::string maxIndex;
+}; // end of struct Include
+
+// The text preceding an include, or the end of the source
+struct Token {
+  std::string text;
+  int include = -1;
+}; // end of struct Token
+
+struct TokenizedSource {
+  // The source, compared on lookup as the sources are keyed by their hash
+  std::string sourceCode;
+  std::size_t lastUse = 0;
+  std::vector<Token> tokens;
+  std::vector<Include> includes;
+  // The index parameters of the instanced includes
+  std::vector<std::string> parameters;
+  // Expanded sources by values of the index parameters
+  std::unordered_map<std::string, std::string> expansions;
+}; // end of struct TokenizedSource
+
+// Whether the first word of a string is an integer, as String::isDigit
+bool isInteger(const std::string& value)
+{
+  auto begin = value.find_first_not_of(WHITESPACES);
+  if (begin == std::string::npos) {
+    return false;
+  }
+  auto end = std::min(value.find_first_of(WHITESPACES, begin), value.size());
+  if (value[begin] == '-') {
+    ++begin;
+  }
+  if (begin == end) {
+    return false;
+  }
+  for (auto i = begin; i < end; ++i) {
+    if (value[i] < '0' || value[i] > '9') {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Matches a line as the "#include<(.+)>" and "#include<(.+)>\[(.*)]"
+// regular expressions did, whose matches can not span a carriage return.
+bool parseInclude(const std::string& line, std::string& name,
+                  bool& instanced, std::string& indexString)
+{
+  const auto start = line.find(INCLUDE_DIRECTIVE);
+  if (start == std::string::npos) {
+    return false;
+  }
+  const auto begin = start + INCLUDE_DIRECTIVE.size();
+  const auto end   = std::min(line.find('\r', begin), line.size());
+  if (end < begin + 2) {
+    return false;
+  }
+  // The name extends to the last '>'
+  const auto close = line.rfind('>', end - 1);
+  if (close == std::string::npos || close < begin + 1) {
+    return false;
+  }
+  name      = line.substr(begin, close - begin);
+  instanced = false;
+  // The index string extends from the last ">[" to the last ']'
+  const auto bracket = line.rfind(']', end - 1);
+  if (bracket == std::string::npos || bracket < begin + 3) {
+    return true;
+  }
+  const auto open = line.rfind(">[", bracket - 2);
+  if (open != std::string::npos && open >= begin + 1) {
+    instanced   = true;
+    indexString = line.substr(open + 2, bracket - open - 2);
+  }
+  return true;
+}
+
+std::unique_ptr<TokenizedSource> tokenize(const std::string& sourceCode)
+{
+  auto source = std_util::make_unique<TokenizedSource>();
+  std::string text;
+  std::string name, indexString;
+  bool instanced = false;
+  for (const auto& line : String::split(sourceCode, '\n')) {
+    if (!parseInclude(line, name, instanced, indexString)) {
+      text.append(line);
+      text.push_back('\n');
+      continue;
+    }
+    auto it = EffectIncludesShadersStore::Shaders.find(name);
+    if (it == EffectIncludesShadersStore::Shaders.end()) {
+      continue;
+    }
+    Include include;
+    include.name      = name;
+    include.content   = it->second;
+    include.instanced = instanced;
+    if (instanced && indexString.find("..") != std::string::npos) {
+      String::replaceInPlace(indexString, "..", ".");
+      auto indexSplits = String::split(indexString, '.');
+      if (indexSplits.size() == 2) {
+        include.hasRange = true;
+        include.minIndex = indexSplits[0];
+        include.maxIndex = indexSplits[1];
+        if (!isInteger(include.maxIndex)
+            && !std_util::contains(source->parameters, include.maxIndex)) {
+          source->parameters.emplace_back(include.maxIndex);
+        }
+      }
+    }
+    const auto index = static_cast<int>(source->includes.size());
+    source->tokens.emplace_back(Token{std::move(text), index});
+    source->includes.emplace_back(std::move(include));
+    text.clear();
+  }
+  source->tokens.emplace_back(Token{std::move(text), -1});
+  return source;
+}
+
+struct Cache {
+  std::mutex mutex;
+  // Generation of the EffectIncludesShadersStore the entries were built with
+  std::size_t generation = 0;
+  std::size_t uses       = 0;
+  // Tokenized sources by hash of their source
+  std::unordered_multimap<std::size_t, std::unique_ptr<TokenizedSource>>
+    sources;
+  // Expanded instanced includes by name and index range
+  std::unordered_map<std::string, std::string> instancedIncludes;
+
+  void clear()
+  {
+    sources.clear();
+    instancedIncludes.clear();
+  }
+
+  TokenizedSource& get(const std::string& sourceCode)
+  {
+    const auto storeGeneration = EffectIncludesShadersStore::Generation();
+    if (generation != storeGeneration) {
+      clear();
+      generation = storeGeneration;
+    }
+
+    const auto hash  = std::hash<std::string>()(sourceCode);
+    const auto range = sources.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->sourceCode == sourceCode) {
+        it->second->lastUse = ++uses;
+        return *it->second;
+      }
+    }
+
+    if (sources.size() >= MaxCachedSources) {
+      auto leastRecentlyUsed = sources.begin();
+      for (auto it = sources.begin(); it != sources.end(); ++it) {
+        if (it->second->lastUse < leastRecentlyUsed->second->lastUse) {
+          leastRecentlyUsed = it;
+        }
+      }
+      sources.erase(leastRecentlyUsed);
+    }
+    auto source        = tokenize(sourceCode);
+    source->sourceCode = sourceCode;
+    source->lastUse    = ++uses;
+    return *sources.emplace(hash, std::move(source))->second;
+  }
+}; // end of struct Cache
+
+Cache& cache()
+{
+  static Cache instance;
+  return instance;
+}
+
+const std::string& expandInstanced(
+  Cache& cache, const Include& include,
+  const std::unordered_map<std::string, unsigned int>& indexParameters)
+{
+  static const std::string empty;
+  auto maxIndex = include.maxIndex;
+  if (!isInteger(maxIndex)) {
+    auto it = indexParameters.find(maxIndex);
+    if (it != indexParameters.end()) {
+      maxIndex = std::to_string(it->second);
+    }
+  }
+  if (!isInteger(include.minIndex) || !isInteger(maxIndex)) {
+    return empty;
+  }
+
+  const auto key
+    = include.name + "[" + include.minIndex + ".." + maxIndex + "]";
+  auto it = cache.instancedIncludes.find(key);
+  if (it != cache.instancedIncludes.end()) {
+    return it->second;
+  }
+
+  // The content is split on its {X} placeholders once for all the indices
+  const std::string content(include.content);
+  std::vector<std::string> parts;
+  std::string::size_type p = 0, q;
+  while ((q = content.find("{X}", p)) != std::string::npos) {
+    parts.emplace_back(content, p, q - p);
+    p = q + 3;
+  }
+  parts.emplace_back(content, p);
+
+  std::string expanded;
+  const size_t minIndexValue = std::stoul(include.minIndex, nullptr, 0);
+  const size_t maxIndexValue = std::stoul(maxIndex, nullptr, 0);
+  for (size_t i = minIndexValue; i <= maxIndexValue; ++i) {
+    const auto index = std::to_string(i);
+    expanded.append(parts[0]);
+    for (size_t j = 1; j < parts.size(); ++j) {
+      expanded.append(index);
+      expanded.append(parts[j]);
+    }
+    expanded.push_back('\n');
+  }
+  return cache.instancedIncludes[key] = std::move(expanded);
+}
+
+} // end of anonymous namespace
+
+std::string ShaderProcessor::ProcessIncludes(
+  const std::string& sourceCode,
+  const std::unordered_map<std::string, unsigned int>& indexParameters)
+{
+  auto& _cache = cache();
+  std::lock_guard<std::mutex> lock(_cache.mutex);
+
+  auto& source = _cache.get(sourceCode);
+
+  std::string key;
+  for (const auto& parameter : source.parameters) {
+    auto it = indexParameters.find(parameter);
+    key.append(it == indexParameters.end() ? "-" :
+                                             std::to_string(it->second));
+    key.push_back(',');
+  }
+  auto it = source.expansions.find(key);
+  if (it != source.expansions.end()) {
+    return it->second;
+  }
+
+  std::string expanded;
+  for (const auto& token : source.tokens) {
+    expanded.append(token.text);
+    if (token.include < 0) {
+      continue;
+    }
+    const auto& include = source.includes[static_cast<size_t>(token.include)];
+    if (!include.instanced) {
+      expanded.append(include.content);
+    }
+    else if (include.hasRange) {
+      expanded.append(expandInstanced(_cache, include, indexParameters));
+    }
+  }
+  return source.expansions[key] = std::move(expanded);
+}
+
+void ShaderProcessor::ClearCache()
+{
+  auto& _cache = cache();
+  std::lock_guard<std::mutex> lock(_cache.mutex);
+  _cache.clear();
+}
+
+} // end of namespace BABYLON
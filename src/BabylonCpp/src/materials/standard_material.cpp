@@ -1186,8 +1186,8 @@ Material* StandardMaterial::clone(const std::string& _name,
                                   bool /*cloneChildren*/) const
 {
   auto standardMaterial  = StandardMaterial::New(*this);
-  standardMaterial->name = _name;
-  standardMaterial->id   = _name;
+  standardMaterial->setName(_name);
+  standardMaterial->setId(_name);
   return standardMaterial;
 }
 
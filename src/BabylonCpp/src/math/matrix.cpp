@@ -10,6 +10,11 @@
 #include <babylon/math/vector4.h>
 #include <babylon/math/viewport.h>
 
+// SIMD
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+#include <babylon/math/simd/simd_matrix.h>
+#endif
+
 namespace BABYLON {
 
 Quaternion Matrix::_tempQuaternion = Quaternion::Zero();
@@ -204,7 +209,7 @@ Matrix& Matrix::addToSelf(const Matrix& other)
 Matrix& Matrix::invertToRef(Matrix& other)
 {
 #if BABYLONCPP_OPTION_ENABLE_SIMD == true
-  simdMatrix.invertToRefSIMD(other);
+  SIMD::SIMDMatrix::InvertToRefSIMD(*this, other);
 #else
   const float l1  = m[0];
   const float l2  = m[1];
@@ -381,7 +386,7 @@ const Matrix& Matrix::multiplyToArray(const Matrix& other,
                                       unsigned int offset) const
 {
 #if BABYLONCPP_OPTION_ENABLE_SIMD == true
-  simdMatrix.multiplyToArraySIMD(other, result, offset);
+  SIMD::SIMDMatrix::MultiplyToArraySIMD(*this, other, result.data() + offset);
 #else
   const float tm0  = m[0];
   const float tm1  = m[1];
@@ -480,6 +485,9 @@ bool Matrix::equals(const Matrix& other) const
 bool Matrix::decompose(Vector3& scale, Quaternion& rotation,
                        Vector3& translation) const
 {
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+  return SIMD::SIMDMatrix::DecomposeSIMD(*this, scale, rotation, translation);
+#else
   translation.x = m[12];
   translation.y = m[13];
   translation.z = m[14];
@@ -512,6 +520,7 @@ bool Matrix::decompose(Vector3& scale, Quaternion& rotation,
   Quaternion::FromRotationMatrixToRef(Tmp::MatrixArray[0], rotation);
 
   return true;
+#endif
 }
 
 Matrix Matrix::getRotationMatrix() const
@@ -735,6 +744,9 @@ Matrix Matrix::Compose(const Vector3& scale, Quaternion& rotation,
 void Matrix::ComposeToRef(const Vector3& scale, Quaternion& rotation,
                           const Vector3& translation, Matrix& result)
 {
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+  SIMD::SIMDMatrix::ComposeToRefSIMD(scale, rotation, translation, result);
+#else
   Matrix::FromValuesToRef(scale.x, 0.f, 0.f, 0.f, //
                           0.f, scale.y, 0.f, 0.f, //
                           0.f, 0.f, scale.z, 0.f, //
@@ -745,6 +757,7 @@ void Matrix::ComposeToRef(const Vector3& scale, Quaternion& rotation,
   Tmp::MatrixArray[1].multiplyToRef(Tmp::MatrixArray[0], result);
 
   result.setTranslation(translation);
+#endif
 }
 
 Matrix Matrix::Identity()
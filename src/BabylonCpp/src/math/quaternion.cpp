@@ -4,6 +4,11 @@
 #include <babylon/math/tmp.h>
 #include <babylon/math/vector3.h>
 
+// SIMD
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+#include <babylon/math/simd/simd_quaternion.h>
+#endif
+
 namespace BABYLON {
 
 Quaternion::Quaternion(float ix, float iy, float iz, float iw)
@@ -153,11 +158,15 @@ Quaternion Quaternion::multiply(const Quaternion& q1) const
 const Quaternion& Quaternion::multiplyToRef(const Quaternion& q1,
                                             Quaternion& result) const
 {
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+  SIMD::SIMDQuaternion::MultiplyToRefSIMD(*this, q1, result);
+#else
   const float xTemp = x * q1.w + y * q1.z - z * q1.y + w * q1.x;
   const float yTemp = -x * q1.z + y * q1.w + z * q1.x + w * q1.y;
   const float zTemp = x * q1.y - y * q1.x + z * q1.w + w * q1.z;
   const float wTemp = -x * q1.x - y * q1.y - z * q1.z + w * q1.w;
   result.copyFromFloats(xTemp, yTemp, zTemp, wTemp);
+#endif
 
   return *this;
 }
@@ -251,6 +260,9 @@ Quaternion::toEulerAnglesToRef(Vector3& result,
 
 const Quaternion& Quaternion::toRotationMatrix(Matrix& result) const
 {
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+  SIMD::SIMDQuaternion::ToRotationMatrixSIMD(*this, result);
+#else
   const float xx = x * x;
   const float yy = y * y;
   const float zz = z * z;
@@ -277,6 +289,7 @@ const Quaternion& Quaternion::toRotationMatrix(Matrix& result) const
   result.m[13] = 0;
   result.m[14] = 0;
   result.m[15] = 1.f;
+#endif
 
   result._markAsUpdated();
 
@@ -517,6 +530,9 @@ Quaternion Quaternion::Slerp(const Quaternion& left, const Quaternion& right,
 void Quaternion::SlerpToRef(const Quaternion& left, const Quaternion& right,
                             float amount, Quaternion& result)
 {
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+  SIMD::SIMDQuaternion::SlerpToRefSIMD(left, right, amount, result);
+#else
   float num2, num3, num = amount;
   float num4 = (((left.x * right.x) + (left.y * right.y)) + (left.z * right.z))
                + (left.w * right.w);
@@ -543,6 +559,7 @@ void Quaternion::SlerpToRef(const Quaternion& left, const Quaternion& right,
   result.y = (num3 * left.y) + (num2 * right.y);
   result.z = (num3 * left.z) + (num2 * right.z);
   result.w = (num3 * left.w) + (num2 * right.w);
+#endif
 }
 
 } // end of namespace BABYLON
@@ -1,7 +1,9 @@
 #include <babylon/math/simd/simd_matrix.h>
 
 #include <babylon/math/matrix.h>
+#include <babylon/math/quaternion.h>
 #include <babylon/math/simd/float32x4.h>
+#include <babylon/math/simd/simd_quaternion.h>
 #include <babylon/math/vector3.h>
 
 namespace BABYLON {
@@ -299,5 +301,191 @@ void SIMDMatrix::LookAtLHToRefSIMD(const Vector3& eyeRef,
           SIMD::Float32x4::mul(SIMD::Float32x4::swizzle(b, 3, 3, 3, 3), a3)))));
 }
 
+void SIMDMatrix::MultiplyToRefSIMD(const Matrix& left, const Matrix& right,
+                                   Matrix& result)
+{
+  MultiplyToArraySIMD(left, right, result.m.data());
+}
+
+void SIMDMatrix::MultiplyToArraySIMD(const Matrix& left, const Matrix& right,
+                                     float* result)
+{
+  const float* lm = left.m.data();
+  const float* rm = right.m.data();
+  float* dest     = result;
+
+  const auto r0 = _mm_loadu_ps(rm);
+  const auto r1 = _mm_loadu_ps(rm + 4);
+  const auto r2 = _mm_loadu_ps(rm + 8);
+  const auto r3 = _mm_loadu_ps(rm + 12);
+
+  for (unsigned int i = 0; i < 16; i += 4) {
+    // The row of left is read before the row of result is written. Summed in
+    // the order of Matrix::multiplyToArray() for identical results.
+    auto row = _mm_mul_ps(_mm_set1_ps(lm[i]), r0);
+    row      = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lm[i + 1]), r1));
+    row      = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lm[i + 2]), r2));
+    row      = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(lm[i + 3]), r3));
+    _mm_storeu_ps(dest + i, row);
+  }
+}
+
+void SIMDMatrix::InvertToRefSIMD(const Matrix& matrix, Matrix& result)
+{
+  // Cramer's rule on the transposed matrix (Intel AP-928), with the shuffles
+  // encoded as immediates and an exact reciprocal of the determinant
+  const float* src = matrix.m.data();
+  const auto src0  = _mm_loadu_ps(src);
+  const auto src1  = _mm_loadu_ps(src + 4);
+  const auto src2  = _mm_loadu_ps(src + 8);
+  const auto src3  = _mm_loadu_ps(src + 12);
+
+  auto tmp1 = _mm_shuffle_ps(src0, src1, _MM_SHUFFLE(1, 0, 1, 0));
+  auto row1 = _mm_shuffle_ps(src2, src3, _MM_SHUFFLE(1, 0, 1, 0));
+  auto row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+  row1      = _mm_shuffle_ps(row1, tmp1, 0xDD);
+  tmp1      = _mm_shuffle_ps(src0, src1, _MM_SHUFFLE(3, 2, 3, 2));
+  auto row3 = _mm_shuffle_ps(src2, src3, _MM_SHUFFLE(3, 2, 3, 2));
+  auto row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+  row3      = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+  tmp1        = _mm_mul_ps(row2, row3);
+  tmp1        = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+  auto minor0 = _mm_mul_ps(row1, tmp1);
+  auto minor1 = _mm_mul_ps(row0, tmp1);
+  tmp1        = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+  minor0      = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
+  minor1      = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
+  minor1      = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+  tmp1        = _mm_mul_ps(row1, row2);
+  tmp1        = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+  minor0      = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
+  auto minor3 = _mm_mul_ps(row0, tmp1);
+  tmp1        = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+  minor0      = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
+  minor3      = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
+  minor3      = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+  tmp1        = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+  tmp1        = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+  row2        = _mm_shuffle_ps(row2, row2, 0x4E);
+  minor0      = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
+  auto minor2 = _mm_mul_ps(row0, tmp1);
+  tmp1        = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+  minor0      = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
+  minor2      = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
+  minor2      = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+  tmp1   = _mm_mul_ps(row0, row1);
+  tmp1   = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+  minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
+  minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
+  tmp1   = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+  minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
+  minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
+
+  tmp1   = _mm_mul_ps(row0, row3);
+  tmp1   = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+  minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
+  minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
+  tmp1   = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+  minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
+  minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
+
+  tmp1   = _mm_mul_ps(row0, row2);
+  tmp1   = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+  minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
+  minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
+  tmp1   = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+  minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
+  minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
+
+  // Determinant, in all the lanes
+  auto det = _mm_mul_ps(row0, minor0);
+  det      = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+  det      = _mm_add_ps(_mm_shuffle_ps(det, det, 0xB1), det);
+  det      = _mm_div_ps(_mm_set1_ps(1.f), det);
+
+  float* dest = result.m.data();
+  _mm_storeu_ps(dest, _mm_mul_ps(det, minor0));
+  _mm_storeu_ps(dest + 4, _mm_mul_ps(det, minor1));
+  _mm_storeu_ps(dest + 8, _mm_mul_ps(det, minor2));
+  _mm_storeu_ps(dest + 12, _mm_mul_ps(det, minor3));
+}
+
+void SIMDMatrix::ComposeToRefSIMD(const Vector3& scale,
+                                  const Quaternion& rotation,
+                                  const Vector3& translation, Matrix& result)
+{
+  // Rows of the rotation matrix scaled by the components of the scaling
+  SIMDQuaternion::ToRotationMatrixSIMD(rotation, result);
+  float* dest = result.m.data();
+  _mm_storeu_ps(dest, _mm_mul_ps(_mm_loadu_ps(dest), _mm_set1_ps(scale.x)));
+  _mm_storeu_ps(dest + 4,
+                _mm_mul_ps(_mm_loadu_ps(dest + 4), _mm_set1_ps(scale.y)));
+  _mm_storeu_ps(dest + 8,
+                _mm_mul_ps(_mm_loadu_ps(dest + 8), _mm_set1_ps(scale.z)));
+  _mm_storeu_ps(dest + 12,
+                _mm_set_ps(1.f, translation.z, translation.y, translation.x));
+  result._markAsUpdated();
+}
+
+bool SIMDMatrix::DecomposeSIMD(const Matrix& matrix, Vector3& scale,
+                               Quaternion& rotation, Vector3& translation)
+{
+  const float* src = matrix.m.data();
+  translation.x    = src[12];
+  translation.y    = src[13];
+  translation.z    = src[14];
+
+  auto row0 = _mm_loadu_ps(src);
+  auto row1 = _mm_loadu_ps(src + 4);
+  auto row2 = _mm_loadu_ps(src + 8);
+  auto col0 = row0, col1 = row1, col2 = row2, col3 = _mm_setzero_ps();
+  _MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+  // Lengths of the first 3 rows, negated when the product of the row is
+  // negative, in the order of the operations of Matrix::decompose()
+  const auto product
+    = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(col0, col1), col2), col3);
+  auto lengths = _mm_sqrt_ps(_mm_add_ps(
+    _mm_add_ps(_mm_mul_ps(col0, col0), _mm_mul_ps(col1, col1)),
+    _mm_mul_ps(col2, col2)));
+  const auto negative = _mm_cmplt_ps(product, _mm_setzero_ps());
+  lengths = _mm_xor_ps(lengths, _mm_and_ps(negative, _mm_set1_ps(-0.f)));
+  float ALIGN_16 lanes[4];
+  _mm_store_ps(lanes, lengths);
+  scale.x = lanes[0];
+  scale.y = lanes[1];
+  scale.z = lanes[2];
+
+  if (std_util::almost_equal(scale.x, 0.f)
+      || std_util::almost_equal(scale.y, 0.f)
+      || std_util::almost_equal(scale.z, 0.f)) {
+    rotation.x = 0.f;
+    rotation.y = 0.f;
+    rotation.z = 0.f;
+    rotation.w = 1.f;
+    return false;
+  }
+
+  // Rotation matrix, rows divided by the scaling
+  Matrix rotationMatrix;
+  float* dest        = rotationMatrix.m.data();
+  const auto keepXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  row0 = _mm_and_ps(_mm_div_ps(row0, _mm_set1_ps(scale.x)), keepXYZ);
+  row1 = _mm_and_ps(_mm_div_ps(row1, _mm_set1_ps(scale.y)), keepXYZ);
+  row2 = _mm_and_ps(_mm_div_ps(row2, _mm_set1_ps(scale.z)), keepXYZ);
+  _mm_storeu_ps(dest, row0);
+  _mm_storeu_ps(dest + 4, row1);
+  _mm_storeu_ps(dest + 8, row2);
+  _mm_storeu_ps(dest + 12, _mm_set_ps(1.f, 0.f, 0.f, 0.f));
+
+  Quaternion::FromRotationMatrixToRef(rotationMatrix, rotation);
+
+  return true;
+}
+
 } // end of namespace SIMD
 } // end of namespace BABY
@@ -0,0 +1,137 @@
+#include <babylon/math/simd/simd_quaternion.h>
+
+#include <babylon/math/matrix.h>
+#include <babylon/math/quaternion.h>
+#include <babylon/math/simd/float32x4.h>
+
+namespace BABYLON {
+namespace SIMD {
+
+namespace {
+
+inline __m128 load(const Quaternion& quaternion)
+{
+  return _mm_set_ps(quaternion.w, quaternion.z, quaternion.y, quaternion.x);
+}
+
+inline void store(__m128 value, Quaternion& result)
+{
+  float ALIGN_16 lanes[4];
+  _mm_store_ps(lanes, value);
+  result.copyFromFloats(lanes[0], lanes[1], lanes[2], lanes[3]);
+}
+
+/**
+ * @brief Returns factor * vector with the sign bits of signs flipped.
+ */
+inline __m128 signedProducts(float factor, __m128 vector, __m128 signs)
+{
+  return _mm_xor_ps(_mm_mul_ps(_mm_set1_ps(factor), vector), signs);
+}
+
+} // end of anonymous namespace
+
+void SIMDQuaternion::MultiplyToRefSIMD(const Quaternion& left,
+                                       const Quaternion& right,
+                                       Quaternion& result)
+{
+  // Each lane sums the terms of left.x, left.y, left.z and left.w in the order
+  // of Quaternion::multiplyToRef(), the signs being applied to the products
+  const auto r      = load(right);
+  const auto wzyx   = _mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 1, 2, 3));
+  const auto zwxy   = _mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2));
+  const auto yxwz   = _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1));
+  const auto xSigns = _mm_set_ps(-0.f, 0.f, -0.f, 0.f);
+  const auto ySigns = _mm_set_ps(-0.f, -0.f, 0.f, 0.f);
+  const auto zSigns = _mm_set_ps(-0.f, 0.f, 0.f, -0.f);
+
+  auto sum = signedProducts(left.x, wzyx, xSigns);
+  sum      = _mm_add_ps(sum, signedProducts(left.y, zwxy, ySigns));
+  sum      = _mm_add_ps(sum, signedProducts(left.z, yxwz, zSigns));
+  sum      = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(left.w), r));
+  store(sum, result);
+}
+
+void SIMDQuaternion::SlerpToRefSIMD(const Quaternion& left,
+                                    const Quaternion& right, float amount,
+                                    Quaternion& result)
+{
+  // Same weights as Quaternion::SlerpToRef(), the dot product is computed in
+  // the same order so that both select the same branch
+  float num2, num3, num = amount;
+  float num4 = (((left.x * right.x) + (left.y * right.y)) + (left.z * right.z))
+               + (left.w * right.w);
+  bool flag = false;
+
+  if (num4 < 0.f) {
+    flag = true;
+    num4 = -num4;
+  }
+
+  if (num4 > 0.999999f) {
+    num3 = 1.f - num;
+    num2 = flag ? -num : num;
+  }
+  else {
+    const float num5 = std::acos(num4);
+    const float num6 = (1.f / std::sin(num5));
+    num3             = (std::sin((1.f - num) * num5)) * num6;
+    num2             = flag ? ((-std::sin(num * num5)) * num6) :
+                  ((std::sin(num * num5)) * num6);
+  }
+
+  store(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(num3), load(left)),
+                   _mm_mul_ps(_mm_set1_ps(num2), load(right))),
+        result);
+}
+
+void SIMDQuaternion::ToRotationMatrixSIMD(const Quaternion& quaternion,
+                                          Matrix& result)
+{
+  const auto q       = load(quaternion);
+  const auto q2      = _mm_add_ps(q, q);
+  const auto zero    = _mm_setzero_ps();
+  const auto keepXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+  // Diagonal: (1 - 2(yy + zz), 1 - 2(zz + xx), 1 - 2(yy + xx))
+  const auto squares = _mm_mul_ps(q, q2);
+  const auto diagonal
+    = _mm_sub_ps(_mm_set_ps(0.f, 1.f, 1.f, 1.f),
+                 _mm_and_ps(_mm_add_ps(_mm_shuffle_ps(squares, squares,
+                                                      _MM_SHUFFLE(3, 1, 2, 1)),
+                                       _mm_shuffle_ps(squares, squares,
+                                                      _MM_SHUFFLE(3, 0, 0, 2))),
+                            keepXYZ));
+
+  // (2zx, 2xy, 2yz) and (2yw, 2zw, 2xw)
+  const auto products
+    = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 1, 0, 2)),
+                 _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 2, 1, 0)));
+  const auto wProducts
+    = _mm_mul_ps(_mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3)),
+                 _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(3, 0, 2, 1)));
+  const auto sum        = _mm_add_ps(products, wProducts);
+  const auto difference = _mm_sub_ps(products, wProducts);
+
+  // Row 0: (diagonal.x, 2(xy + zw), 2(zx - yw), 0)
+  auto a    = _mm_shuffle_ps(diagonal, sum, _MM_SHUFFLE(1, 1, 0, 0));
+  auto b    = _mm_shuffle_ps(difference, zero, _MM_SHUFFLE(0, 0, 0, 0));
+  auto row0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+  // Row 1: (2(xy - zw), diagonal.y, 2(yz + xw), 0)
+  a         = _mm_shuffle_ps(difference, diagonal, _MM_SHUFFLE(1, 1, 1, 1));
+  b         = _mm_shuffle_ps(sum, zero, _MM_SHUFFLE(0, 0, 2, 2));
+  auto row1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+  // Row 2: (2(zx + yw), 2(yz - xw), diagonal.z, 0)
+  a         = _mm_shuffle_ps(sum, difference, _MM_SHUFFLE(2, 2, 0, 0));
+  b         = _mm_shuffle_ps(diagonal, zero, _MM_SHUFFLE(0, 0, 2, 2));
+  auto row2 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+
+  float* dest = result.m.data();
+  _mm_storeu_ps(dest, row0);
+  _mm_storeu_ps(dest + 4, row1);
+  _mm_storeu_ps(dest + 8, row2);
+  _mm_storeu_ps(dest + 12, _mm_set_ps(1.f, 0.f, 0.f, 0.f));
+}
+
+} // end of namespace SIMD
+} // end of namespace BABYLON
@@ -7,6 +7,71 @@
 namespace BABYLON {
 namespace SIMD {
 
+namespace {
+
+/**
+ * @brief Loads 4 packed vectors, 12 floats, as their x, y and z lanes.
+ */
+inline void loadVectors(const float* source, __m128& x, __m128& y, __m128& z)
+{
+  // a = (x0, y0, z0, x1), b = (y1, z1, x2, y2), c = (z2, x3, y3, z3)
+  const auto a = _mm_loadu_ps(source);
+  const auto b = _mm_loadu_ps(source + 4);
+  const auto c = _mm_loadu_ps(source + 8);
+  x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)),
+                     _MM_SHUFFLE(2, 0, 3, 0));
+  y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                     _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                     _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+/**
+ * @brief Stores the x, y and z lanes of 4 vectors as 12 packed floats.
+ */
+inline void storeVectors(__m128 x, __m128 y, __m128 z, float* result)
+{
+  const auto a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+                                _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                                _MM_SHUFFLE(2, 0, 2, 0));
+  const auto b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                                _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                                _MM_SHUFFLE(2, 0, 2, 0));
+  const auto c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                                _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+                                _MM_SHUFFLE(2, 0, 2, 0));
+  _mm_storeu_ps(result, a);
+  _mm_storeu_ps(result + 4, b);
+  _mm_storeu_ps(result + 8, c);
+}
+
+/**
+ * @brief Returns x * m[column] + y * m[column + 4] + z * m[column + 8], summed
+ * in the order of the scalar transforms.
+ */
+inline __m128 transformLanes(__m128 x, __m128 y, __m128 z, const float* m,
+                             unsigned int column)
+{
+  return _mm_add_ps(
+    _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(m[column])),
+               _mm_mul_ps(y, _mm_set1_ps(m[column + 4]))),
+    _mm_mul_ps(z, _mm_set1_ps(m[column + 8])));
+}
+
+/**
+ * @brief Returns transformLanes() plus the translation m[column + 12].
+ */
+inline __m128 transformCoordinateLanes(__m128 x, __m128 y, __m128 z,
+                                       const float* m, unsigned int column)
+{
+  return _mm_add_ps(transformLanes(x, y, z, m, column),
+                    _mm_set1_ps(m[column + 12]));
+}
+
+} // end of anonymous namespace
+
 void SIMDVector3::TransformCoordinatesToRefSIMD(const Vector3& vector,
                                                 const Matrix& transformation,
                                                 Vector3& result)
@@ -24,16 +89,69 @@ void SIMDVector3::TransformCoordinatesFromFloatsToRefSIMD(
   auto m1 = SIMD::Float32x4::load(m, 4);
   auto m2 = SIMD::Float32x4::load(m, 8);
   auto m3 = SIMD::Float32x4::load(m, 12);
+  // Summed in the order of the scalar version, for the same rounding
   auto r  = SIMD::Float32x4::add(
-    SIMD::Float32x4::add(SIMD::Float32x4::mul(SIMD::Float32x4::splat(x), m0),
-                         SIMD::Float32x4::mul(SIMD::Float32x4::splat(y), m1)),
-    SIMD::Float32x4::add(SIMD::Float32x4::mul(SIMD::Float32x4::splat(z), m2),
-                         m3));
+    SIMD::Float32x4::mul(SIMD::Float32x4::splat(x), m0),
+    SIMD::Float32x4::mul(SIMD::Float32x4::splat(y), m1));
+  r = SIMD::Float32x4::add(
+    r, SIMD::Float32x4::mul(SIMD::Float32x4::splat(z), m2));
+  r        = SIMD::Float32x4::add(r, m3);
   r        = SIMD::Float32x4::div(r, SIMD::Float32x4::swizzle(r, 3, 3, 3, 3));
   result.x = SIMD::Float32x4::extractLane(r, 0);
   result.y = SIMD::Float32x4::extractLane(r, 1);
   result.z = SIMD::Float32x4::extractLane(r, 2);
 }
 
+void SIMDVector3::TransformCoordinatesArraySIMD(const Float32Array& source,
+                                                const Matrix& transformation,
+                                                Float32Array& result)
+{
+  result.resize(source.size());
+  const float* m              = transformation.m.data();
+  const std::size_t count     = source.size() / 3;
+  const std::size_t simdCount = count - count % 4;
+  __m128 x, y, z;
+  for (std::size_t i = 0; i < simdCount * 3; i += 12) {
+    loadVectors(source.data() + i, x, y, z);
+    const auto w = transformCoordinateLanes(x, y, z, m, 3);
+    storeVectors(_mm_div_ps(transformCoordinateLanes(x, y, z, m, 0), w),
+                 _mm_div_ps(transformCoordinateLanes(x, y, z, m, 1), w),
+                 _mm_div_ps(transformCoordinateLanes(x, y, z, m, 2), w),
+                 result.data() + i);
+  }
+
+  Vector3 vector;
+  for (std::size_t i = simdCount * 3; i < count * 3; i += 3) {
+    Vector3::TransformCoordinatesFromFloatsToRef(source[i], source[i + 1],
+                                                 source[i + 2], transformation,
+                                                 vector);
+    vector.toArray(result, static_cast<unsigned int>(i));
+  }
+}
+
+void SIMDVector3::TransformNormalsArraySIMD(const Float32Array& source,
+                                            const Matrix& transformation,
+                                            Float32Array& result)
+{
+  result.resize(source.size());
+  const float* m              = transformation.m.data();
+  const std::size_t count     = source.size() / 3;
+  const std::size_t simdCount = count - count % 4;
+  __m128 x, y, z;
+  for (std::size_t i = 0; i < simdCount * 3; i += 12) {
+    loadVectors(source.data() + i, x, y, z);
+    storeVectors(transformLanes(x, y, z, m, 0), transformLanes(x, y, z, m, 1),
+                 transformLanes(x, y, z, m, 2), result.data() + i);
+  }
+
+  Vector3 vector;
+  for (std::size_t i = simdCount * 3; i < count * 3; i += 3) {
+    Vector3::TransformNormalFromFloatsToRef(source[i], source[i + 1],
+                                            source[i + 2], transformation,
+                                            vector);
+    vector.toArray(result, static_cast<unsigned int>(i));
+  }
+}
+
 } // end of namespace SIMD
 } // end of namespace BABY
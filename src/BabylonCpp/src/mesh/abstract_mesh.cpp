@@ -73,6 +73,7 @@ AbstractMesh::AbstractMesh(const std::string& iName, Scene* scene)
     , _renderId{0}
     , _submeshesOctree{nullptr}
     , _unIndexed{false}
+    , _isStaticBatched{false}
     , _facetNb{0}
     , _partitioningSubdivisions{10}
     , _partitioningBBoxRatio{1.01f}
@@ -106,6 +107,7 @@ AbstractMesh::AbstractMesh(const std::string& iName, Scene* scene)
     , _isDirty{false}
     , _pivotMatrix{Matrix::Identity()}
     , _isWorldMatrixFrozen{false}
+    , _worldMatrixUpdateCount{0}
     , _skeleton{nullptr}
 {
   _resyncLightSources();
@@ -695,6 +697,11 @@ bool AbstractMesh::isWorldMatrixFrozen()
   return _isWorldMatrixFrozen;
 }
 
+unsigned int AbstractMesh::worldMatrixUpdateCount() const
+{
+  return _worldMatrixUpdateCount;
+}
+
 AbstractMesh& AbstractMesh::rotate(Vector3& axis, float amount,
                                    const Space& space)
 {
@@ -949,6 +956,15 @@ Matrix AbstractMesh::computeWorldMatrix(bool force)
     return *_worldMatrix;
   }
 
+  _computeLocalWorldMatrix();
+  _computeWorldMatrixFromParent();
+  _afterWorldMatrixUpdate();
+
+  return *_worldMatrix;
+}
+
+void AbstractMesh::_computeLocalWorldMatrix()
+{
   _cache.position.copyFrom(_position);
   _cache.scaling.copyFrom(scaling());
   _cache.pivotMatrixUpdated = false;
@@ -1067,8 +1083,10 @@ Matrix AbstractMesh::computeWorldMatrix(bool force)
 
   // Local world
   Tmp::MatrixArray[5].multiplyToRef(Tmp::MatrixArray[2], _localWorld);
+}
 
-  // Parent
+void AbstractMesh::_computeWorldMatrixFromParent()
+{
   if (parent() && parent()->getWorldMatrix()) {
     _markSyncedWithParent();
 
@@ -1103,6 +1121,11 @@ Matrix AbstractMesh::computeWorldMatrix(bool force)
   else {
     _worldMatrix->copyFrom(_localWorld);
   }
+}
+
+void AbstractMesh::_afterWorldMatrixUpdate()
+{
+  ++_worldMatrixUpdateCount;
 
   // Bounding info
   _updateBoundingInfo();
@@ -1117,8 +1140,6 @@ Matrix AbstractMesh::computeWorldMatrix(bool force)
   if (!_poseMatrix) {
     _poseMatrix = std_util::make_unique<Matrix>(Matrix::Invert(*_worldMatrix));
   }
-
-  return *_worldMatrix;
 }
 
 AbstractMesh& AbstractMesh::registerAfterWorldMatrixUpdate(
@@ -1299,12 +1320,12 @@ bool AbstractMesh::checkCollisions() const
 void AbstractMesh::setCheckCollisions(bool collisionEnabled)
 {
   _checkCollisions = collisionEnabled;
-  /*if (getScene()->workerCollisions()) {
-    getScene()->collisionCoordinator()->onMeshUpdated(this);
-  }*/
+  if (getScene()->workerCollisions()) {
+    getScene()->collisionCoordinator->onMeshUpdated(this);
+  }
 }
 
-AbstractMesh& AbstractMesh::moveWithCollisions(const Vector3& /*velocity*/)
+AbstractMesh& AbstractMesh::moveWithCollisions(const Vector3& velocity)
 {
   auto globalPosition = getAbsolutePosition();
 
@@ -1318,33 +1339,39 @@ AbstractMesh& AbstractMesh::moveWithCollisions(const Vector3& /*velocity*/)
 
   _collider->radius = ellipsoid;
 
-  // getScene()->collisionCoordinator->getNewPosition(
-  //  _oldPositionForCollisions, velocity, _collider.get(), 3, this,
-  //  _onCollisionPositionChange(), uniqueId);
+  // With worker collisions the new position is applied when the worker reply
+  // is dispatched, after the next rendered frame
+  auto displacement = velocity;
+  getScene()->collisionCoordinator->getNewPosition(
+    _oldPositionForCollisions, displacement, _collider.get(), 3, this,
+    [this](int collisionId, Vector3& newPosition, AbstractMesh* collidedMesh) {
+      _onCollisionPositionChange(collisionId, newPosition, collidedMesh);
+    },
+    uniqueId);
 
   return *this;
 }
 
 void AbstractMesh::_onCollisionPositionChange(int /*collisionId*/,
-                                              const Vector3& /*newPosition*/,
-                                              AbstractMesh* /*collidedMesh*/)
+                                              Vector3& newPosition,
+                                              AbstractMesh* collidedMesh)
 {
-  /*if (getScene().workerCollisions) {
-    newPosition.multiplyInPlace(_collider.radius);
+  if (getScene()->workerCollisions()) {
+    newPosition.multiplyInPlace(_collider->radius);
   }
 
   newPosition.subtractToRef(_oldPositionForCollisions,
                             _diffPositionForCollisions);
 
   if (_diffPositionForCollisions.length() > Engine::CollisionsEpsilon) {
-    position.addInPlace(_diffPositionForCollisions);
+    position().addInPlace(_diffPositionForCollisions);
   }
 
   if (collidedMesh) {
     onCollideObservable.notifyObservers(collidedMesh);
   }
 
-  onCollisionPositionChangeObservable.notifyObservers(position);*/
+  onCollisionPositionChangeObservable.notifyObservers(&position());
 }
 
 Octree<SubMesh*>*
@@ -1353,10 +1380,7 @@ Octree<SubMesh*>*
 {
   // if (!_submeshesOctree) {
   //  _submeshesOctree = new Octree<SubMesh*>(
-  //    [](SubMesh* entry, OctreeBlock<SubMesh*>& block) {
-  //      Octree<AbstractMesh*>::CreationFuncForSubMeshes(entry, block);
-  //    },
-  //    maxCapacity, maxDepth);
+  //    Octree<SubMesh*>::BoundsFuncForSubMeshes, maxCapacity, maxDepth);
   //}
 
   computeWorldMatrix(true);
@@ -1545,13 +1569,13 @@ AbstractMesh* AbstractMesh::clone(const std::string& /*name*/,
 
 AbstractMesh& AbstractMesh::releaseSubMeshes()
 {
-  if (!subMeshes.empty()) {
-    for (auto& subMesh : subMeshes) {
-      subMesh->dispose();
-    }
-  }
-
+  // Disposing a submesh removes it from the submeshes of its mesh: they are
+  // moved out first, then destroyed once disposed
+  auto released = std::move(subMeshes);
   subMeshes.clear();
+  for (auto& subMesh : released) {
+    subMesh->dispose();
+  }
 
   return *this;
 }
@@ -0,0 +1,171 @@
+#include <babylon/mesh/instances_stream.h>
+
+#include <babylon/engine/engine.h>
+#include <babylon/engine/scene.h>
+#include <babylon/math/matrix.h>
+#include <babylon/mesh/buffer.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/vertex_buffer.h>
+
+namespace BABYLON {
+
+constexpr std::size_t InstancesStream::InstanceSize;
+constexpr std::size_t InstancesStream::MaxRangeGap;
+constexpr std::size_t InstancesStream::MaxDirtyRanges;
+
+InstancesStream::InstancesStream(Mesh* mesh, std::size_t capacity)
+    : _mesh{mesh}
+    , _engine{mesh->getScene()->getEngine()}
+    , _capacity{0}
+    , _buffer{nullptr}
+    , _instancesCount{0}
+    , _uploadedCount{0}
+    , _reallocationCount{0}
+{
+  _dirtyRanges.reserve(MaxDirtyRanges);
+  _grow(std::max<std::size_t>(capacity, 1));
+}
+
+InstancesStream::~InstancesStream()
+{
+}
+
+std::size_t InstancesStream::getCapacity() const
+{
+  return _capacity;
+}
+
+std::size_t InstancesStream::getInstancesCount() const
+{
+  return _instancesCount;
+}
+
+void InstancesStream::begin(std::size_t instancesCount)
+{
+  if (instancesCount > _capacity) {
+    auto capacity = std::max<std::size_t>(_capacity, 1);
+    while (capacity < instancesCount) {
+      capacity *= 2;
+    }
+    _grow(capacity);
+    ++_reallocationCount;
+  }
+
+  _instancesCount = 0;
+  _dirtyRanges.clear();
+}
+
+void InstancesStream::write(AbstractMesh* mesh)
+{
+  if (_instancesCount == _capacity) {
+    return;
+  }
+
+  const auto index       = _instancesCount++;
+  auto& slot             = _slots[index];
+  const auto updateCount = mesh->worldMatrixUpdateCount();
+  if (slot.mesh == mesh && slot.uniqueId == mesh->uniqueId
+      && slot.worldMatrixUpdateCount == updateCount) {
+    return;
+  }
+
+  slot.mesh                   = mesh;
+  slot.uniqueId               = mesh->uniqueId;
+  slot.worldMatrixUpdateCount = updateCount;
+  mesh->getWorldMatrix()->copyToArray(
+    _data, static_cast<unsigned int>(index * InstanceSize));
+  _markSlotAsDirty(index);
+}
+
+std::size_t InstancesStream::end()
+{
+  _uploadedCount = 0;
+  for (const auto& range : _dirtyRanges) {
+    // Only the changed floats are copied, the upload storage keeping its
+    // capacity from a call to the next
+    _uploadData.assign(_data.begin() + range.first * InstanceSize,
+                       _data.begin() + range.second * InstanceSize);
+    _buffer->updateDirectly(
+      _uploadData,
+      static_cast<int>(range.first * InstanceSize * sizeof(float)));
+    _uploadedCount += range.second - range.first;
+  }
+  _dirtyRanges.clear();
+
+  return _instancesCount;
+}
+
+void InstancesStream::markAsDirty()
+{
+  for (auto& slot : _slots) {
+    slot.mesh = nullptr;
+  }
+}
+
+void InstancesStream::dispose()
+{
+  if (_buffer) {
+    _buffer->dispose();
+    _buffer.reset(nullptr);
+  }
+  _capacity       = 0;
+  _instancesCount = 0;
+  _data.clear();
+  _slots.clear();
+  _dirtyRanges.clear();
+}
+
+std::size_t InstancesStream::getUploadedCount() const
+{
+  return _uploadedCount;
+}
+
+std::size_t InstancesStream::getReallocationCount() const
+{
+  return _reallocationCount;
+}
+
+void InstancesStream::_grow(std::size_t capacity)
+{
+  // The content of the slots is kept, the new buffer being created from it
+  _capacity = capacity;
+  _data.resize(_capacity * InstanceSize, 0.f);
+  _slots.resize(_capacity, Slot{nullptr, 0, 0});
+  _uploadData.reserve(_data.size());
+
+  if (_buffer) {
+    _buffer->dispose();
+  }
+
+  const auto stride = static_cast<int>(InstanceSize);
+  _buffer
+    = std_util::make_unique<Buffer>(_engine, _data, true, stride, false, true);
+
+  _mesh->setVerticesBuffer(
+    _buffer->createVertexBuffer(VertexBuffer::World0Kind, 0, 4));
+  _mesh->setVerticesBuffer(
+    _buffer->createVertexBuffer(VertexBuffer::World1Kind, 4, 4));
+  _mesh->setVerticesBuffer(
+    _buffer->createVertexBuffer(VertexBuffer::World2Kind, 8, 4));
+  _mesh->setVerticesBuffer(
+    _buffer->createVertexBuffer(VertexBuffer::World3Kind, 12, 4));
+}
+
+void InstancesStream::_markSlotAsDirty(std::size_t slot)
+{
+  // The slots are written in order, a slot extends the last range or starts
+  // a new one
+  if (!_dirtyRanges.empty()
+      && slot - _dirtyRanges.back().second <= MaxRangeGap) {
+    _dirtyRanges.back().second = slot + 1;
+  }
+  else if (_dirtyRanges.size() == MaxDirtyRanges) {
+    _dirtyRanges.front().second = slot + 1;
+    _dirtyRanges.resize(1);
+  }
+  else {
+    _dirtyRanges.emplace_back(slot, slot + 1);
+  }
+}
+
+} // end of namespace BABYLON
@@ -5,6 +5,7 @@
 #include <babylon/core/json.h>
 #include <babylon/core/logging.h>
 #include <babylon/core/string.h>
+#include <babylon/core/task_scheduler.h>
 #include <babylon/culling/bounding_box.h>
 #include <babylon/culling/bounding_info.h>
 #include <babylon/culling/bounding_sphere.h>
@@ -19,12 +20,15 @@
 #include <babylon/math/vector2.h>
 #include <babylon/mesh/_instances_batch.h>
 #include <babylon/mesh/_visible_instances.h>
-#include <babylon/mesh/buffer.h>
 #include <babylon/mesh/geometry.h>
 #include <babylon/mesh/ground_mesh.h>
 #include <babylon/mesh/instanced_mesh.h>
+#include <babylon/mesh/instances_stream.h>
 #include <babylon/mesh/mesh_builder.h>
 #include <babylon/mesh/mesh_lod_level.h>
+#include <babylon/mesh/mesh_optimizer.h>
+#include <babylon/mesh/simplification/isimplification_task.h>
+#include <babylon/mesh/simplification/simplification_queue.h>
 #include <babylon/mesh/vertex_buffer.h>
 #include <babylon/mesh/vertex_data.h>
 #include <babylon/mesh/vertex_data_options.h>
@@ -49,7 +53,7 @@ Mesh::Mesh(const std::string& iName, Scene* scene, Node* iParent, Mesh* source,
     , _onBeforeDrawObserver{nullptr}
     , _morphTargetManager{nullptr}
     , _batchCache{std_util::make_unique<_InstancesBatch>()}
-    , _instancesBufferSize{32 * 16 * 4} // maximum of 32 instances
+    , _instancesStream{nullptr}
     , _overridenInstanceCount{0}
     , _preActivateId{-1}
     , _sideOrientation{Mesh::DEFAULTSIDE}
@@ -202,14 +206,7 @@ void Mesh::_sortLODLevels()
   std::sort(_LODLevels.begin(), _LODLevels.end(),
             [](const std::unique_ptr<MeshLODLevel>& a,
                const std::unique_ptr<MeshLODLevel>& b) {
-              if (a->distance < b->distance) {
-                return 1;
-              }
-              if (a->distance > b->distance) {
-                return -1;
-              }
-
-              return 0;
+              return a->distance > b->distance;
             });
 }
 
@@ -243,13 +240,16 @@ Mesh* Mesh::getLODLevelAtDistance(float distance)
 
 Mesh& Mesh::removeLODLevel(Mesh* mesh)
 {
-  for (auto& level : _LODLevels) {
-    if (level->mesh == mesh) {
-      std_util::erase(_LODLevels, level);
+  for (auto it = _LODLevels.begin(); it != _LODLevels.end();) {
+    if ((*it)->mesh == mesh) {
+      it = _LODLevels.erase(it);
       if (mesh) {
         mesh->_masterMesh = nullptr;
       }
     }
+    else {
+      ++it;
+    }
   }
 
   _sortLODLevels();
@@ -264,12 +264,15 @@ AbstractMesh* Mesh::getLOD(Camera* camera, BoundingSphere* boundingSphere)
 
   float distanceToCamera = 0.f;
   if (boundingSphere) {
-    boundingSphere->centerWorld.subtract(camera->globalPosition()).length();
+    distanceToCamera
+      = boundingSphere->centerWorld.subtract(camera->globalPosition())
+          .length();
   }
   else {
-    getBoundingInfo()
-      ->boundingSphere.centerWorld.subtract(camera->globalPosition())
-      .length();
+    distanceToCamera
+      = getBoundingInfo()
+          ->boundingSphere.centerWorld.subtract(camera->globalPosition())
+          .length();
   }
 
   if (_LODLevels.back()->distance > distanceToCamera) {
@@ -382,7 +385,7 @@ IndicesArray Mesh::getIndices(bool copyWhenShared)
   return _geometry->getIndices(copyWhenShared);
 }
 
-bool Mesh::isBlocked()
+bool Mesh::isBlocked() const
 {
   return _masterMesh != nullptr;
 }
@@ -462,6 +465,7 @@ Mesh& Mesh::_registerInstanceForRenderId(InstancedMesh* instance, int renderId)
   if (_visibleInstances->meshes.find(renderId)
       == _visibleInstances->meshes.end()) {
     _visibleInstances->meshes[renderId] = std::vector<InstancedMesh*>();
+    _visibleInstances->meshes[renderId].reserve(instances.size());
   }
 
   _visibleInstances->meshes[renderId].emplace_back(instance);
@@ -753,33 +757,36 @@ Mesh& Mesh::unregisterAfterRender(
 
 _InstancesBatch* Mesh::_getInstancesRenderList(size_t subMeshId)
 {
-  auto scene                               = getScene();
-  _batchCache->mustReturn                  = false;
-  _batchCache->renderSelf[subMeshId]       = isEnabled() && isVisible;
-  _batchCache->visibleInstances[subMeshId] = std::vector<InstancedMesh*>();
+  auto scene                         = getScene();
+  _batchCache->mustReturn            = false;
+  _batchCache->renderSelf[subMeshId] = isEnabled() && isVisible;
+  // Cleared rather than replaced, to keep its storage from a frame to the next
+  auto& visibleInstances = _batchCache->visibleInstances[subMeshId];
+  visibleInstances.clear();
 
   if (_visibleInstances) {
+    auto& meshes          = _visibleInstances->meshes;
     auto currentRenderId_ = scene->getRenderId();
     auto defaultRenderId  = scene->_isInIntermediateRendering() ?
                              _visibleInstances->intermediateDefaultRenderId :
                              _visibleInstances->defaultRenderId;
-    _batchCache->visibleInstances[subMeshId]
-      = _visibleInstances->meshes[currentRenderId_];
+    auto it          = meshes.find(currentRenderId_);
     int selfRenderId = _renderId;
 
-    if ((_batchCache->visibleInstances.find(subMeshId)
-         == _batchCache->visibleInstances.end())
-        && defaultRenderId) {
-      _batchCache->visibleInstances[subMeshId]
-        = _visibleInstances->meshes[defaultRenderId];
+    if (it == meshes.end() && defaultRenderId) {
+      it               = meshes.find(defaultRenderId);
       currentRenderId_ = std::max(defaultRenderId, currentRenderId_);
       selfRenderId
         = std::max(_visibleInstances->selfDefaultRenderId, currentRenderId_);
     }
 
-    if ((_batchCache->visibleInstances.find(subMeshId)
-         != _batchCache->visibleInstances.end())
-        && _batchCache->visibleInstances[subMeshId].size() > 0) {
+    if (subMeshId >= _renderIdForInstances.size()) {
+      _renderIdForInstances.resize(subMeshId + 1, -1);
+    }
+
+    if (it != meshes.end() && !it->second.empty()) {
+      // The submeshes of the instances are dispatched as well, the instances
+      // are only copied for the call which draws them
       if (_renderIdForInstances[subMeshId] == currentRenderId_) {
         _batchCache->mustReturn = true;
         return _batchCache.get();
@@ -788,6 +795,7 @@ _InstancesBatch* Mesh::_getInstancesRenderList(size_t subMeshId)
       if (currentRenderId_ != selfRenderId) {
         _batchCache->renderSelf[subMeshId] = false;
       }
+      visibleInstances = it->second;
     }
     _renderIdForInstances[subMeshId] = currentRenderId_;
   }
@@ -804,62 +812,22 @@ Mesh& Mesh::_renderWithInstances(SubMesh* subMesh, int fillMode,
     return *this;
   }
 
-  std::vector<InstancedMesh*> visibleInstances
-    = batch->visibleInstances[subMesh->_id];
-  size_t matricesCount = visibleInstances.size() + 1;
-  size_t bufferSize    = matricesCount * 16 * 4;
+  const auto& visibleInstances = batch->visibleInstances[subMesh->_id];
+  const bool renderSelf        = batch->renderSelf[subMesh->_id];
 
-  auto currentInstancesBufferSize = _instancesBufferSize;
-
-  while (_instancesBufferSize < bufferSize) {
-    _instancesBufferSize *= 2;
+  if (!_instancesStream) {
+    // 32 instances, grown when more instances are visible
+    _instancesStream = std_util::make_unique<InstancesStream>(this, 32);
   }
 
-  if (_instancesData.empty()
-      || currentInstancesBufferSize != _instancesBufferSize) {
-    _instancesData = Float32Array(_instancesBufferSize / 4);
+  _instancesStream->begin(visibleInstances.size() + (renderSelf ? 1 : 0));
+  if (renderSelf) {
+    _instancesStream->write(this);
   }
-
-  unsigned int offset         = 0;
-  unsigned int instancesCount = 0;
-
-  auto world = getWorldMatrix();
-  if (batch->renderSelf[subMesh->_id]) {
-    world->copyToArray(_instancesData, offset);
-    offset += 16;
-    instancesCount++;
-  }
-
-  if (!visibleInstances.empty()) {
-    for (size_t instanceIndex = 0; instanceIndex < visibleInstances.size();
-         ++instanceIndex) {
-      InstancedMesh* instance = visibleInstances[instanceIndex];
-      instance->getWorldMatrix()->copyToArray(_instancesData, offset);
-      offset += 16;
-      ++instancesCount;
-    }
-  }
-
-  if (!_instancesBuffer || currentInstancesBufferSize != _instancesBufferSize) {
-    if (_instancesBuffer) {
-      _instancesBuffer->dispose();
-    }
-
-    _instancesBuffer = std_util::make_unique<Buffer>(engine, _instancesData,
-                                                     true, 16, false, true);
-
-    setVerticesBuffer(
-      _instancesBuffer->createVertexBuffer(VertexBuffer::World0Kind, 0, 4));
-    setVerticesBuffer(
-      _instancesBuffer->createVertexBuffer(VertexBuffer::World1Kind, 4, 4));
-    setVerticesBuffer(
-      _instancesBuffer->createVertexBuffer(VertexBuffer::World2Kind, 8, 4));
-    setVerticesBuffer(
-      _instancesBuffer->createVertexBuffer(VertexBuffer::World3Kind, 12, 4));
-  }
-  else {
-    _instancesBuffer->updateDirectly(_instancesData, 0, instancesCount);
+  for (auto& instance : visibleInstances) {
+    _instancesStream->write(instance);
   }
+  auto instancesCount = _instancesStream->end();
 
   geometry()->_bind(effect);
 
@@ -999,7 +967,8 @@ Mesh& Mesh::render(SubMesh* subMesh, bool enableAlphaMode)
     hardwareInstancedRendering,
     [&](bool isInstance, Matrix world, Material* _effectiveMaterial) {
       _onBeforeDraw(isInstance, world, _effectiveMaterial);
-    });
+    },
+    effectiveMaterial);
 
   // Unbind
   effectiveMaterial->unbind();
@@ -1268,9 +1237,9 @@ void Mesh::dispose(bool /*doNotRecurse*/)
   _source = nullptr;
 
   // Instances
-  if (_instancesBuffer) {
-    _instancesBuffer->dispose();
-    _instancesBuffer.reset(nullptr);
+  if (_instancesStream) {
+    _instancesStream->dispose();
+    _instancesStream.reset(nullptr);
   }
 
   for (auto& instance : instances) {
@@ -1563,20 +1532,28 @@ Mesh& Mesh::synchronizeInstances()
   return *this;
 }
 
-/*void Mesh::simplify(
-  const std::vector<ISimplificationSettings*>& settings,
-  bool parallelProcessing, SimplificationType simplificationType,
-  std::function<void(Mesh* mesh, int submeshIndex)>& successCallback)
-{
-  settings(nullptr);
-  std::cout << parallelProcessing << simplificationType;
-  successCallback(nullptr, 0);
-}*/
-
 void Mesh::optimizeIndices(
   const std::function<void(Mesh* mesh)>& successCallback)
 {
-  successCallback(nullptr);
+  MeshOptimizer::Optimize(this);
+  if (successCallback) {
+    successCallback(this);
+  }
+}
+
+Mesh& Mesh::simplify(const std::vector<ISimplificationSettings>& settings,
+                     bool parallelProcessing,
+                     SimplificationType simplificationType,
+                     const std::function<void(Mesh* mesh)>& successCallback)
+{
+  ISimplificationTask task;
+  task.settings           = settings;
+  task.simplificationType = simplificationType;
+  task.mesh               = this;
+  task.parallelProcessing = parallelProcessing;
+  task.successCallback    = successCallback;
+  getScene()->simplificationQueue->addTask(task);
+  return *this;
 }
 
 void Mesh::_syncGeometryWithMorphTargetManager()
@@ -1634,7 +1611,7 @@ Mesh* Mesh::Parse(const Json::value& parsedMesh, Scene* scene,
   else {
     mesh = Mesh::New(Json::GetString(parsedMesh, "name"), scene);
   }
-  mesh->id = Json::GetString(parsedMesh, "id");
+  mesh->setId(Json::GetString(parsedMesh, "id"));
 
   // Tags.AddTagsTo(mesh, parsedMesh.tags);
 
@@ -2285,59 +2262,63 @@ Mesh* Mesh::applySkeleton(Skeleton* skeleton)
     = needExtras ? getVerticesData(VertexBuffer::MatricesWeightsExtraKind) :
                    Float32Array();
 
-  auto skeletonMatrices = skeleton->getTransformMatrices(this);
-
-  auto tempVector3 = Vector3::Zero();
-  Matrix finalMatrix;
-  Matrix tempMatrix;
-
-  unsigned int matWeightIdx = 0;
-  unsigned int inf;
-  float weight;
-  for (unsigned int index = 0; index < positionsData.size();
-       index += 3, matWeightIdx += 4) {
-    for (inf = 0; inf < 4; ++inf) {
-      weight = matricesWeightsData[matWeightIdx + inf];
-      if (weight > 0.f) {
-        Matrix::FromFloat32ArrayToRefScaled(
-          skeletonMatrices,
-          static_cast<unsigned>(matricesIndicesData[matWeightIdx + inf]) * 16,
-          weight, tempMatrix);
-        finalMatrix.addToSelf(tempMatrix);
-      }
-      else {
-        break;
-      }
-    }
-    if (needExtras) {
+  const auto& skeletonMatrices = skeleton->getTransformMatrices(this);
+
+  // The vertices are skinned in chunks on the task scheduler
+  const auto skin = [&](std::size_t vertexBegin, std::size_t vertexEnd) {
+    auto tempVector3 = Vector3::Zero();
+    Matrix finalMatrix;
+    Matrix tempMatrix;
+
+    unsigned int inf;
+    float weight;
+    for (auto vertex = vertexBegin; vertex < vertexEnd; ++vertex) {
+      const auto index        = static_cast<unsigned int>(vertex * 3);
+      const auto matWeightIdx = static_cast<unsigned int>(vertex * 4);
       for (inf = 0; inf < 4; ++inf) {
-        weight = matricesWeightsExtraData[matWeightIdx + inf];
+        weight = matricesWeightsData[matWeightIdx + inf];
         if (weight > 0.f) {
+          const auto matrixIndex
+            = static_cast<unsigned>(matricesIndicesData[matWeightIdx + inf]);
           Matrix::FromFloat32ArrayToRefScaled(
-            skeletonMatrices,
-            static_cast<unsigned>(matricesIndicesExtraData[matWeightIdx + inf])
-              * 16,
-            weight, tempMatrix);
+            skeletonMatrices, matrixIndex * 16, weight, tempMatrix);
           finalMatrix.addToSelf(tempMatrix);
         }
         else {
           break;
         }
       }
-    }
+      if (needExtras) {
+        for (inf = 0; inf < 4; ++inf) {
+          weight = matricesWeightsExtraData[matWeightIdx + inf];
+          if (weight > 0.f) {
+            const auto matrixIndex = static_cast<unsigned>(
+              matricesIndicesExtraData[matWeightIdx + inf]);
+            Matrix::FromFloat32ArrayToRefScaled(
+              skeletonMatrices, matrixIndex * 16, weight, tempMatrix);
+            finalMatrix.addToSelf(tempMatrix);
+          }
+          else {
+            break;
+          }
+        }
+      }
 
-    Vector3::TransformCoordinatesFromFloatsToRef(
-      _sourcePositions[index], _sourcePositions[index + 1],
-      _sourcePositions[index + 2], finalMatrix, tempVector3);
-    tempVector3.toArray(positionsData, index);
+      Vector3::TransformCoordinatesFromFloatsToRef(
+        _sourcePositions[index], _sourcePositions[index + 1],
+        _sourcePositions[index + 2], finalMatrix, tempVector3);
+      tempVector3.toArray(positionsData, index);
 
-    Vector3::TransformNormalFromFloatsToRef(
-      _sourceNormals[index], _sourceNormals[index + 1],
-      _sourceNormals[index + 2], finalMatrix, tempVector3);
-    tempVector3.toArray(normalsData, index);
+      Vector3::TransformNormalFromFloatsToRef(
+        _sourceNormals[index], _sourceNormals[index + 1],
+        _sourceNormals[index + 2], finalMatrix, tempVector3);
+      tempVector3.toArray(normalsData, index);
 
-    finalMatrix.reset();
-  }
+      finalMatrix.reset();
+    }
+  };
+  TaskScheduler::Instance().parallelFor(0, positionsData.size() / 3, skin,
+                                        1024);
 
   updateVerticesData(VertexBuffer::PositionKind, positionsData);
   updateVerticesData(VertexBuffer::NormalKind, normalsData);
@@ -0,0 +1,738 @@
+#include <babylon/mesh/mesh_optimizer.h>
+
+#include <babylon/engine/scene.h>
+#include <babylon/mesh/instanced_mesh.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/sub_mesh.h>
+#include <babylon/mesh/vertex_buffer.h>
+
+namespace BABYLON {
+
+namespace {
+
+// Key of a float for the welding, the zeros being merged
+std::int64_t weldKey(float value, float epsilon)
+{
+  if (epsilon > 0.f) {
+    return static_cast<std::int64_t>(std::floor(value / epsilon + 0.5f));
+  }
+  if (value == 0.f) {
+    return 0;
+  }
+  std::int32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+} // end of anonymous namespace
+
+MeshOptimizer::MeshOptimizer(Scene* scene, TaskScheduler& scheduler)
+    : _scene{scene}, _scheduler{scheduler}, _onBeforeRenderObserver{nullptr}
+{
+  _onBeforeRenderObserver = _scene->onBeforeRenderObservable.add(
+    [this]() { _applyCompleted(); });
+}
+
+MeshOptimizer::~MeshOptimizer()
+{
+  // The tasks own their data and end on their own
+  _scene->onBeforeRenderObservable.remove(_onBeforeRenderObserver);
+}
+
+MeshOptimizationReport
+MeshOptimizer::Optimize(Mesh* mesh, const MeshOptimizationOptions& options)
+{
+  MeshOptimizationReport report;
+  MeshData data;
+  if (!_Extract(mesh, data)) {
+    return report;
+  }
+
+  _Optimize(data, options, report);
+  report.applied = _Apply(mesh, data, report);
+
+  return report;
+}
+
+void MeshOptimizer::optimizeAsync(Mesh* mesh,
+                                  const MeshOptimizationOptions& options,
+                                  const Callback& callback)
+{
+  auto job      = std::make_shared<Job>();
+  job->callback = callback;
+  if (!_Extract(mesh, job->data)) {
+    if (callback) {
+      callback(mesh, job->report);
+    }
+    return;
+  }
+
+  job->meshUniqueId = mesh->uniqueId;
+  job->task         = _scheduler.submit(
+    [job, options]() { _Optimize(job->data, options, job->report); });
+  _jobs.emplace_back(job);
+}
+
+std::size_t MeshOptimizer::getPendingCount() const
+{
+  return _jobs.size();
+}
+
+void MeshOptimizer::wait()
+{
+  // The optimizations queued by the callbacks are applied at the next frame
+  const auto jobs = _jobs;
+  for (auto& job : jobs) {
+    job->task.wait();
+  }
+  _applyCompleted();
+}
+
+void MeshOptimizer::_applyCompleted()
+{
+  // The completed jobs are removed first, as the callbacks may queue new ones,
+  // the others being left for the next frame
+  std::vector<std::shared_ptr<Job>> completed;
+  for (auto it = _jobs.begin(); it != _jobs.end();) {
+    if ((*it)->task.isReady()) {
+      completed.emplace_back(*it);
+      it = _jobs.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+
+  for (auto& job : completed) {
+    auto mesh
+      = dynamic_cast<Mesh*>(_scene->getMeshByUniqueID(job->meshUniqueId));
+    if (mesh) {
+      job->report.applied = _Apply(mesh, job->data, job->report);
+    }
+    if (job->callback) {
+      job->callback(mesh, job->report);
+    }
+  }
+}
+
+VertexCacheStatistics
+MeshOptimizer::AnalyzeVertexCache(const IndicesArray& indices,
+                                  std::size_t vertexCount,
+                                  std::size_t cacheSize)
+{
+  VertexCacheStatistics statistics;
+  statistics.triangles = indices.size() / 3;
+  if (statistics.triangles == 0) {
+    return statistics;
+  }
+
+  for (auto index : indices) {
+    vertexCount = std::max<std::size_t>(vertexCount, index + 1);
+  }
+
+  // FIFO cache: a vertex is in the cache while less than cacheSize misses
+  // happened since it was last transformed
+  std::vector<std::size_t> timestamps(vertexCount, 0);
+  std::size_t timestamp = cacheSize + 1;
+  for (std::size_t i = 0; i < statistics.triangles * 3; ++i) {
+    const auto index = indices[i];
+    if (timestamp - timestamps[index] > cacheSize) {
+      if (timestamps[index] == 0) {
+        ++statistics.vertices;
+      }
+      timestamps[index] = timestamp++;
+      ++statistics.transformedVertices;
+    }
+  }
+
+  const auto transformed = static_cast<float>(statistics.transformedVertices);
+  statistics.acmr        = transformed / statistics.triangles;
+  statistics.atvr        = transformed / statistics.vertices;
+
+  return statistics;
+}
+
+std::vector<std::size_t>
+MeshOptimizer::OptimizeVertexCache(IndicesArray& indices,
+                                   std::size_t vertexCount,
+                                   std::size_t cacheSize)
+{
+  const auto triangleCount = indices.size() / 3;
+  std::vector<std::size_t> clusters;
+  if (triangleCount == 0) {
+    return clusters;
+  }
+
+  // Triangles adjacent to each vertex, and number of them left to emit
+  std::vector<unsigned int> liveCounts(vertexCount, 0);
+  for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+    ++liveCounts[indices[i]];
+  }
+  std::vector<std::size_t> offsets(vertexCount + 1, 0);
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    offsets[vertex + 1] = offsets[vertex] + liveCounts[vertex];
+  }
+  std::vector<uint32_t> adjacency(offsets[vertexCount]);
+  {
+    auto fill = offsets;
+    for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+      adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+  }
+
+  IndicesArray result;
+  result.reserve(triangleCount * 3);
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<std::size_t> timestamps(vertexCount, 0);
+  std::size_t timestamp = cacheSize + 1;
+  std::vector<uint32_t> deadEnds;
+  std::vector<uint32_t> candidates;
+  std::size_t cursor = 0;
+
+  // Next vertex with triangles left when the fanning vertex has no good
+  // neighbour: a recently used one, or the next one in the input order
+  const auto skipDeadEnd = [&]() -> long {
+    while (!deadEnds.empty()) {
+      const auto vertex = deadEnds.back();
+      deadEnds.pop_back();
+      if (liveCounts[vertex] > 0) {
+        return vertex;
+      }
+    }
+    while (cursor < vertexCount) {
+      if (liveCounts[cursor] > 0) {
+        return static_cast<long>(cursor);
+      }
+      ++cursor;
+    }
+    return -1;
+  };
+
+  long fanning = skipDeadEnd();
+  clusters.emplace_back(0);
+  while (fanning >= 0) {
+    // Emits the triangles around the fanning vertex
+    candidates.clear();
+    for (auto i = offsets[fanning]; i < offsets[fanning + 1]; ++i) {
+      const auto triangle = adjacency[i];
+      if (emitted[triangle]) {
+        continue;
+      }
+      for (std::size_t corner = 0; corner < 3; ++corner) {
+        const auto vertex = indices[triangle * 3 + corner];
+        result.emplace_back(vertex);
+        deadEnds.emplace_back(vertex);
+        candidates.emplace_back(vertex);
+        --liveCounts[vertex];
+        if (timestamp - timestamps[vertex] > cacheSize) {
+          timestamps[vertex] = timestamp++;
+        }
+      }
+      emitted[triangle] = true;
+    }
+
+    // The next fanning vertex is the oldest one which stays in the cache
+    // while its remaining triangles are emitted
+    long next         = -1;
+    long bestPriority = -1;
+    for (auto vertex : candidates) {
+      if (liveCounts[vertex] == 0) {
+        continue;
+      }
+      long priority  = 0;
+      const auto age = timestamp - timestamps[vertex];
+      if (age + 2 * liveCounts[vertex] <= cacheSize) {
+        priority = static_cast<long>(age);
+      }
+      if (priority > bestPriority) {
+        bestPriority = priority;
+        next         = vertex;
+      }
+    }
+    if (next < 0) {
+      next = skipDeadEnd();
+      if (next >= 0) {
+        clusters.emplace_back(result.size() / 3);
+      }
+    }
+    fanning = next;
+  }
+
+  indices = std::move(result);
+  return clusters;
+}
+
+std::size_t MeshOptimizer::OptimizeOverdraw(
+  IndicesArray& indices, const Float32Array& positions,
+  const std::vector<std::size_t>& clusters, std::size_t cacheSize,
+  float threshold)
+{
+  const auto triangleCount = indices.size() / 3;
+  if (triangleCount == 0 || clusters.empty()) {
+    return 0;
+  }
+  for (auto index : indices) {
+    if (static_cast<std::size_t>(index) * 3 + 2 >= positions.size()) {
+      return clusters.size();
+    }
+  }
+
+  // Splits the clusters where their ACMR so far is close to their final one,
+  // the cache being assumed to be empty at the start of each cluster
+  std::vector<std::size_t> timestamps(positions.size() / 3, 0);
+  std::size_t timestamp = cacheSize + 1;
+  const auto simulate   = [&](std::size_t triangle) {
+    std::size_t misses = 0;
+    for (std::size_t corner = 0; corner < 3; ++corner) {
+      const auto vertex = indices[triangle * 3 + corner];
+      if (timestamp - timestamps[vertex] > cacheSize) {
+        timestamps[vertex] = timestamp++;
+        ++misses;
+      }
+    }
+    return misses;
+  };
+  const auto flushCache = [&]() { timestamp += cacheSize + 1; };
+
+  std::vector<std::size_t> starts;
+  for (std::size_t c = 0; c < clusters.size(); ++c) {
+    const auto begin = clusters[c];
+    const auto end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+    if (begin >= end) {
+      continue;
+    }
+
+    flushCache();
+    std::size_t clusterMisses = 0;
+    for (auto triangle = begin; triangle < end; ++triangle) {
+      clusterMisses += simulate(triangle);
+    }
+    const auto limit = threshold * static_cast<float>(clusterMisses)
+                       / static_cast<float>(end - begin);
+
+    flushCache();
+    starts.emplace_back(begin);
+    std::size_t misses = 0;
+    for (auto triangle = begin; triangle < end; ++triangle) {
+      misses += simulate(triangle);
+      const auto count = triangle + 1 - starts.back();
+      if (triangle + 1 < end
+          && static_cast<float>(misses) <= limit * static_cast<float>(count)) {
+        starts.emplace_back(triangle + 1);
+        misses = 0;
+        flushCache();
+      }
+    }
+  }
+
+  // Area weighted centroid and normal of each cluster
+  struct Cluster {
+    std::size_t begin;
+    std::size_t end;
+    float centroid[3];
+    float normal[3];
+    float area;
+    float key;
+  }; // end of struct Cluster
+
+  std::vector<Cluster> sorted(starts.size(), Cluster());
+  float meshCentroid[3] = {0.f, 0.f, 0.f};
+  float meshArea        = 0.f;
+  for (std::size_t c = 0; c < starts.size(); ++c) {
+    auto& cluster = sorted[c];
+    cluster.begin = starts[c];
+    cluster.end   = c + 1 < starts.size() ? starts[c + 1] : triangleCount;
+    for (auto triangle = cluster.begin; triangle < cluster.end; ++triangle) {
+      const float* p0   = &positions[indices[triangle * 3 + 0] * 3];
+      const float* p1   = &positions[indices[triangle * 3 + 1] * 3];
+      const float* p2   = &positions[indices[triangle * 3 + 2] * 3];
+      const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      // Babylon.js front faces are clockwise: the normal is e2 x e1
+      const float n[3] = {e2[1] * e1[2] - e2[2] * e1[1],
+                          e2[2] * e1[0] - e2[0] * e1[2],
+                          e2[0] * e1[1] - e2[1] * e1[0]};
+      const auto area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      for (unsigned int k = 0; k < 3; ++k) {
+        cluster.centroid[k] += (p0[k] + p1[k] + p2[k]) / 3.f * area;
+        cluster.normal[k] += n[k];
+      }
+      cluster.area += area;
+    }
+    for (unsigned int k = 0; k < 3; ++k) {
+      meshCentroid[k] += cluster.centroid[k];
+    }
+    meshArea += cluster.area;
+  }
+  if (meshArea > 0.f) {
+    for (unsigned int k = 0; k < 3; ++k) {
+      meshCentroid[k] /= meshArea;
+    }
+  }
+
+  // The clusters facing away from the center are drawn first, as they are
+  // the most likely to occlude the others
+  for (auto& cluster : sorted) {
+    const auto length = std::sqrt(cluster.normal[0] * cluster.normal[0]
+                                  + cluster.normal[1] * cluster.normal[1]
+                                  + cluster.normal[2] * cluster.normal[2]);
+    if (cluster.area <= 0.f || length <= 0.f) {
+      continue;
+    }
+    for (unsigned int k = 0; k < 3; ++k) {
+      cluster.key += (cluster.centroid[k] / cluster.area - meshCentroid[k])
+                     * cluster.normal[k] / length;
+    }
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const Cluster& a, const Cluster& b) {
+                     return a.key > b.key;
+                   });
+
+  IndicesArray result;
+  result.reserve(triangleCount * 3);
+  for (const auto& cluster : sorted) {
+    result.insert(result.end(), indices.begin() + cluster.begin * 3,
+                  indices.begin() + cluster.end * 3);
+  }
+  result.insert(result.end(), indices.begin() + triangleCount * 3,
+                indices.end());
+  indices = std::move(result);
+
+  return sorted.size();
+}
+
+bool MeshOptimizer::_Extract(Mesh* mesh, MeshData& data)
+{
+  if (!mesh || !mesh->geometry() || mesh->getTotalIndices() == 0) {
+    return false;
+  }
+
+  data.indices       = mesh->getIndices();
+  data.totalVertices = mesh->getTotalVertices();
+  data.remappable    = !mesh->morphTargetManager();
+
+  // The vertex buffers which cannot be remapped, interleaved or of an
+  // unexpected size, only prevent the vertex steps
+  for (auto kind : mesh->getVerticesDataKinds()) {
+    auto vertexBuffer = mesh->getVertexBuffer(kind);
+    if (!vertexBuffer || vertexBuffer->getIsInstanced()) {
+      continue;
+    }
+    const auto size = static_cast<std::size_t>(vertexBuffer->getSize());
+    Stream stream{kind, mesh->getVerticesData(kind), size,
+                  vertexBuffer->isUpdatable()};
+    if (vertexBuffer->getOffset() != 0
+        || vertexBuffer->getStrideSize() != vertexBuffer->getSize()
+        || stream.data.size() != data.totalVertices * size) {
+      data.remappable = false;
+      continue;
+    }
+    if (kind == VertexBuffer::PositionKind) {
+      data.streams.insert(data.streams.begin(), std::move(stream));
+    }
+    else {
+      data.streams.emplace_back(std::move(stream));
+    }
+  }
+
+  for (const auto& subMesh : mesh->subMeshes) {
+    data.subMeshes.emplace_back(
+      SubMeshLayout{subMesh->materialIndex, subMesh->verticesStart,
+                    subMesh->verticesCount, subMesh->indexStart,
+                    subMesh->indexCount});
+  }
+
+  return true;
+}
+
+void MeshOptimizer::_Optimize(MeshData& data,
+                              const MeshOptimizationOptions& options,
+                              MeshOptimizationReport& report)
+{
+  auto& indices          = data.indices;
+  const auto vertexCount = data.totalVertices;
+  const auto cacheSize   = options.cacheSize;
+  report.before          = AnalyzeVertexCache(indices, vertexCount, cacheSize);
+  report.verticesBefore  = vertexCount;
+  report.verticesAfter   = vertexCount;
+
+  // Index ranges reordered independently, the submeshes, which must not
+  // overlap for their triangles to be moved
+  auto layouts = data.subMeshes;
+  if (layouts.empty()) {
+    layouts.emplace_back(SubMeshLayout{0, 0, vertexCount, 0, indices.size()});
+  }
+  std::vector<std::size_t> segments(layouts.size());
+  std::iota(segments.begin(), segments.end(), 0);
+  std::sort(segments.begin(), segments.end(),
+            [&layouts](std::size_t a, std::size_t b) {
+              return layouts[a].indexStart < layouts[b].indexStart;
+            });
+  bool trianglesMovable = true;
+  bool indicesCovered   = true;
+  std::size_t indexEnd  = 0;
+  for (auto segment : segments) {
+    const auto& layout = layouts[segment];
+    if (layout.indexStart < indexEnd || layout.indexCount % 3 != 0
+        || layout.indexStart + layout.indexCount > indices.size()) {
+      trianglesMovable = false;
+      break;
+    }
+    indicesCovered = indicesCovered && layout.indexStart == indexEnd;
+    indexEnd       = layout.indexStart + layout.indexCount;
+  }
+  indicesCovered = indicesCovered && indexEnd == indices.size();
+
+  // The vertices are only moved when each submesh references its vertex range
+  // only, the new vertex ranges bounding the new indices
+  bool verticesMovable = data.remappable && trianglesMovable && indicesCovered
+                         && !data.streams.empty();
+  for (std::size_t s = 0; verticesMovable && s < layouts.size(); ++s) {
+    const auto& layout = layouts[s];
+    const auto end     = layout.verticesStart + layout.verticesCount;
+    verticesMovable    = end <= vertexCount;
+    for (auto i = layout.indexStart;
+         verticesMovable && i < layout.indexStart + layout.indexCount; ++i) {
+      verticesMovable
+        = indices[i] >= layout.verticesStart && indices[i] < end;
+    }
+  }
+  const bool remapVertices = verticesMovable
+                             && (options.weldVertices
+                                 || options.optimizeVertexFetch);
+  report.verticesOptimized = remapVertices;
+
+  // Welding within the groups of submeshes whose vertex ranges overlap
+  if (remapVertices && options.weldVertices) {
+    std::vector<std::pair<std::size_t, std::size_t>> groups;
+    for (const auto& layout : layouts) {
+      groups.emplace_back(layout.verticesStart,
+                          layout.verticesStart + layout.verticesCount);
+    }
+    std::sort(groups.begin(), groups.end());
+    std::vector<std::pair<std::size_t, std::size_t>> merged;
+    for (const auto& group : groups) {
+      if (!merged.empty() && group.first < merged.back().second) {
+        merged.back().second = std::max(merged.back().second, group.second);
+      }
+      else {
+        merged.emplace_back(group);
+      }
+    }
+
+    Uint32Array weld(vertexCount);
+    std::iota(weld.begin(), weld.end(), 0u);
+    for (const auto& group : merged) {
+      const auto groupWeld = _WeldVertices(
+        data, group.first, group.second - group.first, options.weldEpsilon);
+      std::copy(groupWeld.begin(), groupWeld.end(),
+                weld.begin() + static_cast<long>(group.first));
+    }
+    for (auto& index : indices) {
+      index = weld[index];
+    }
+  }
+
+  // Triangle reordering of each submesh, on local vertex ids
+  const Float32Array* positions = nullptr;
+  for (const auto& stream : data.streams) {
+    if (stream.kind == VertexBuffer::PositionKind && stream.size == 3
+        && stream.data.size() == vertexCount * 3) {
+      positions = &stream.data;
+    }
+  }
+  if (trianglesMovable && options.optimizeVertexCache) {
+    const uint32_t unset = std::numeric_limits<uint32_t>::max();
+    Uint32Array localIds(vertexCount, unset);
+    Uint32Array globalIds;
+    IndicesArray local;
+    Float32Array localPositions;
+    report.clusters = 0;
+    for (const auto& layout : layouts) {
+      if (layout.indexCount == 0) {
+        continue;
+      }
+      const auto first = indices.begin() + static_cast<long>(layout.indexStart);
+      globalIds.clear();
+      local.assign(first, first + static_cast<long>(layout.indexCount));
+      for (auto& index : local) {
+        if (localIds[index] == unset) {
+          localIds[index] = static_cast<uint32_t>(globalIds.size());
+          globalIds.emplace_back(index);
+        }
+        index = localIds[index];
+      }
+
+      const auto clusters
+        = OptimizeVertexCache(local, globalIds.size(), cacheSize);
+      if (options.optimizeOverdraw && positions) {
+        localPositions.resize(globalIds.size() * 3);
+        for (std::size_t v = 0; v < globalIds.size(); ++v) {
+          std::copy_n(positions->begin() + globalIds[v] * 3, 3,
+                      localPositions.begin() + static_cast<long>(v * 3));
+        }
+        report.clusters
+          += OptimizeOverdraw(local, localPositions, clusters, cacheSize,
+                              options.overdrawThreshold);
+      }
+      else {
+        report.clusters += clusters.size();
+      }
+
+      for (std::size_t i = 0; i < local.size(); ++i) {
+        first[static_cast<long>(i)] = globalIds[local[i]];
+      }
+      for (auto vertex : globalIds) {
+        localIds[vertex] = unset;
+      }
+    }
+  }
+
+  // Vertex fetch order: the vertices are renumbered in the order of their
+  // first use, the unreferenced ones being removed
+  if (remapVertices) {
+    const uint32_t unset = std::numeric_limits<uint32_t>::max();
+    Uint32Array remap(vertexCount, unset);
+    Uint32Array order;
+    order.reserve(vertexCount);
+    for (auto& index : indices) {
+      if (remap[index] == unset) {
+        remap[index] = static_cast<uint32_t>(order.size());
+        order.emplace_back(index);
+      }
+      index = remap[index];
+    }
+
+    for (auto& stream : data.streams) {
+      Float32Array remapped(order.size() * stream.size);
+      for (std::size_t v = 0; v < order.size(); ++v) {
+        std::copy_n(stream.data.begin() + order[v] * stream.size, stream.size,
+                    remapped.begin() + static_cast<long>(v * stream.size));
+      }
+      stream.data = std::move(remapped);
+    }
+    data.totalVertices   = order.size();
+    report.verticesAfter = order.size();
+
+    for (auto& layout : data.subMeshes) {
+      const auto first = indices.begin() + static_cast<long>(layout.indexStart);
+      const auto last  = first + static_cast<long>(layout.indexCount);
+      if (first == last) {
+        layout.verticesStart = 0;
+        layout.verticesCount = 0;
+        continue;
+      }
+      const auto bounds    = std::minmax_element(first, last);
+      layout.verticesStart = *bounds.first;
+      layout.verticesCount = *bounds.second - *bounds.first + 1;
+    }
+  }
+
+  report.after = AnalyzeVertexCache(indices, data.totalVertices, cacheSize);
+}
+
+bool MeshOptimizer::_Apply(Mesh* mesh, const MeshData& data,
+                           const MeshOptimizationReport& report)
+{
+  // The geometry must not have changed since the extraction
+  auto geometry = mesh->geometry();
+  if (!geometry || mesh->getTotalVertices() != report.verticesBefore
+      || mesh->getTotalIndices() != data.indices.size()) {
+    return false;
+  }
+
+  // The indices are set first: the vertices are only removed, so that the
+  // bounding info computed from the indices stays within the vertices
+  mesh->setIndices(data.indices, data.totalVertices);
+  if (report.verticesOptimized) {
+    for (const auto& stream : data.streams) {
+      mesh->setVerticesData(stream.kind, stream.data, stream.updatable,
+                            static_cast<int>(stream.size));
+    }
+  }
+
+  // Setting the geometry data recreated the submeshes of the meshes sharing
+  // it: their layout is restored, and the instances follow their source
+  if (data.subMeshes.empty()) {
+    return true;
+  }
+  for (const auto& sceneMesh : mesh->getScene()->meshes) {
+    if (auto other = dynamic_cast<Mesh*>(sceneMesh.get())) {
+      if (other->geometry() != geometry) {
+        continue;
+      }
+      other->releaseSubMeshes();
+      for (const auto& layout : data.subMeshes) {
+        SubMesh::New(layout.materialIndex,
+                     static_cast<unsigned int>(layout.verticesStart),
+                     layout.verticesCount,
+                     static_cast<unsigned int>(layout.indexStart),
+                     layout.indexCount, other);
+      }
+    }
+    else if (auto instance = dynamic_cast<InstancedMesh*>(sceneMesh.get())) {
+      if (instance->sourceMesh() != mesh
+          || instance->subMeshes.size() != data.subMeshes.size()) {
+        continue;
+      }
+      for (std::size_t s = 0; s < data.subMeshes.size(); ++s) {
+        auto& subMesh = instance->subMeshes[s];
+        subMesh->verticesStart
+          = static_cast<unsigned int>(data.subMeshes[s].verticesStart);
+        subMesh->verticesCount = data.subMeshes[s].verticesCount;
+      }
+    }
+  }
+
+  return true;
+}
+
+Uint32Array MeshOptimizer::_WeldVertices(const MeshData& data,
+                                         std::size_t verticesStart,
+                                         std::size_t verticesCount,
+                                         float epsilon)
+{
+  // Keys of the vertices, all their data, sorted to group the identical ones
+  std::size_t width = 0;
+  for (const auto& stream : data.streams) {
+    width += stream.size;
+  }
+  std::vector<std::int64_t> keys(verticesCount * width);
+  for (std::size_t v = 0; v < verticesCount; ++v) {
+    auto key = keys.begin() + static_cast<long>(v * width);
+    for (const auto& stream : data.streams) {
+      const auto source = (verticesStart + v) * stream.size;
+      for (std::size_t k = 0; k < stream.size; ++k) {
+        *key++ = weldKey(stream.data[source + k], epsilon);
+      }
+    }
+  }
+
+  const auto compare = [&keys, width](uint32_t a, uint32_t b) {
+    const auto keyA = keys.begin() + static_cast<long>(a * width);
+    const auto keyB = keys.begin() + static_cast<long>(b * width);
+    return std::lexicographical_compare(keyA, keyA + static_cast<long>(width),
+                                        keyB, keyB + static_cast<long>(width));
+  };
+  Uint32Array order(verticesCount);
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), compare);
+
+  // Each vertex is mapped to the first of its identical vertices
+  Uint32Array weld(verticesCount);
+  for (std::size_t i = 0; i < verticesCount;) {
+    auto j = i + 1;
+    while (j < verticesCount && !compare(order[i], order[j])) {
+      ++j;
+    }
+    const auto first = static_cast<uint32_t>(verticesStart + order[i]);
+    for (; i < j; ++i) {
+      weld[order[i]] = first;
+    }
+  }
+
+  return weld;
+}
+
+} // end of namespace BABYLON
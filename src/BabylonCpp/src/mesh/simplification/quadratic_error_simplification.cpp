@@ -0,0 +1,623 @@
+#include <babylon/mesh/simplification/quadratic_error_simplification.h>
+
+#include <babylon/engine/scene.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/sub_mesh.h>
+#include <babylon/mesh/vertex_buffer.h>
+
+namespace BABYLON {
+
+namespace {
+
+/**
+ * @brief Decimation of a triangle list, the vertices, their quadrics, the
+ * triangles and the references from the vertices to their triangles being
+ * stored in flat arrays.
+ */
+class Decimation {
+
+public:
+  Decimation(std::vector<double>&& positions, IndicesArray&& triangles)
+      : _positions{std::move(positions)}, _triangles{std::move(triangles)}
+  {
+    const auto vertexCount = _positions.size() / 3;
+    _quadrics.resize(vertexCount * 10);
+    _borders.resize(vertexCount, 0);
+    _refStarts.resize(vertexCount);
+    _refCounts.resize(vertexCount);
+  }
+
+  /**
+   * @brief Collapses the edges of lowest error until the target number of
+   * triangles is reached, the error threshold growing with the iterations.
+   */
+  void run(std::size_t targetCount, int aggressiveness, int iterations)
+  {
+    const auto triangleCount = _triangles.size() / 3;
+    std::size_t deletedCount = 0;
+    std::vector<uint8_t> deleted0;
+    std::vector<uint8_t> deleted1;
+
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+      if (triangleCount - deletedCount <= targetCount) {
+        break;
+      }
+
+      // The triangles are compacted and the references rebuilt from time to
+      // time only, as it is the most expensive step
+      if (iteration % 5 == 0) {
+        _updateMesh(iteration);
+      }
+      std::fill(_dirty.begin(), _dirty.end(), 0);
+
+      const auto threshold
+        = 1e-9 * std::pow(static_cast<double>(iteration + 3), aggressiveness);
+
+      const auto count = _triangles.size() / 3;
+      for (std::size_t t = 0; t < count; ++t) {
+        if (_errors[t * 4 + 3] > threshold || _deleted[t] || _dirty[t]) {
+          continue;
+        }
+
+        for (std::size_t j = 0; j < 3; ++j) {
+          if (_errors[t * 4 + j] >= threshold) {
+            continue;
+          }
+          const auto i0 = _triangles[t * 3 + j];
+          const auto i1 = _triangles[t * 3 + (j + 1) % 3];
+          // The borders only collapse along themselves
+          if (_borders[i0] != _borders[i1]) {
+            continue;
+          }
+
+          double p[3];
+          _calculateError(i0, i1, p);
+          deleted0.resize(_refCounts[i0]);
+          deleted1.resize(_refCounts[i1]);
+          if (_flipped(p, i0, i1, deleted0) || _flipped(p, i1, i0, deleted1)) {
+            // The position of least error may be far from the edge when the
+            // quadric is almost singular, the edge ends or middle may not be
+            _calculateError(i0, i1, p, false);
+            if (_flipped(p, i0, i1, deleted0)
+                || _flipped(p, i1, i0, deleted1)) {
+              continue;
+            }
+          }
+
+          // i1 collapses into i0, moved to the position of least error
+          std::copy_n(p, 3, &_positions[i0 * 3]);
+          for (std::size_t k = 0; k < 10; ++k) {
+            _quadrics[i0 * 10 + k] += _quadrics[i1 * 10 + k];
+          }
+          const auto refStart = _refTriangles.size();
+          _updateTriangles(i0, i0, deleted0, deletedCount);
+          _updateTriangles(i0, i1, deleted1, deletedCount);
+          const auto refCount = _refTriangles.size() - refStart;
+          if (refCount <= _refCounts[i0]) {
+            // The references fit in the previous ones of i0
+            std::copy_n(_refTriangles.begin() + refStart, refCount,
+                        _refTriangles.begin() + _refStarts[i0]);
+            std::copy_n(_refCorners.begin() + refStart, refCount,
+                        _refCorners.begin() + _refStarts[i0]);
+            _refTriangles.resize(refStart);
+            _refCorners.resize(refStart);
+          }
+          else {
+            _refStarts[i0] = static_cast<uint32_t>(refStart);
+          }
+          _refCounts[i0] = static_cast<uint32_t>(refCount);
+          break;
+        }
+
+        if (triangleCount - deletedCount <= targetCount) {
+          break;
+        }
+      }
+    }
+
+    _compact();
+  }
+
+  const std::vector<double>& positions() const
+  {
+    return _positions;
+  }
+
+  const IndicesArray& triangles() const
+  {
+    return _triangles;
+  }
+
+private:
+  // Error of a position for a quadric, whose 10 coefficients are the upper
+  // triangle of the symmetric 4x4 matrix, row by row
+  static double _vertexError(const double* q, double x, double y, double z)
+  {
+    return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x
+           + q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y + q[7] * z * z
+           + 2 * q[8] * z + q[9];
+  }
+
+  static double _det(const double* q, int a11, int a12, int a13, int a21,
+                     int a22, int a23, int a31, int a32, int a33)
+  {
+    return q[a11] * q[a22] * q[a33] + q[a13] * q[a21] * q[a32]
+           + q[a12] * q[a23] * q[a31] - q[a13] * q[a22] * q[a31]
+           - q[a11] * q[a23] * q[a32] - q[a12] * q[a21] * q[a33];
+  }
+
+  // Error of the collapse of an edge, and the position minimizing it, or the
+  // best of the edge ends and middle when not solving the quadric
+  double _calculateError(uint32_t i0, uint32_t i1, double* p,
+                         bool solve = true) const
+  {
+    double q[10];
+    for (std::size_t k = 0; k < 10; ++k) {
+      q[k] = _quadrics[i0 * 10 + k] + _quadrics[i1 * 10 + k];
+    }
+    const bool border = _borders[i0] && _borders[i1];
+    const auto det    = _det(q, 0, 1, 2, 1, 4, 5, 2, 5, 7);
+    if (solve && det != 0.0 && !border) {
+      p[0] = -1.0 / det * _det(q, 1, 2, 3, 4, 5, 6, 5, 7, 8);
+      p[1] = 1.0 / det * _det(q, 0, 2, 3, 1, 5, 6, 2, 7, 8);
+      p[2] = -1.0 / det * _det(q, 0, 1, 3, 1, 4, 6, 2, 5, 8);
+      return _vertexError(q, p[0], p[1], p[2]);
+    }
+
+    // The edge ends or its middle
+    const double* p0 = &_positions[i0 * 3];
+    const double* p1 = &_positions[i1 * 3];
+    const double middle[3]
+      = {(p0[0] + p1[0]) / 2, (p0[1] + p1[1]) / 2, (p0[2] + p1[2]) / 2};
+    const double* candidates[3] = {p0, p1, middle};
+    double error = std::numeric_limits<double>::max();
+    for (auto candidate : candidates) {
+      const auto candidateError
+        = _vertexError(q, candidate[0], candidate[1], candidate[2]);
+      if (candidateError < error) {
+        error = candidateError;
+        std::copy_n(candidate, 3, p);
+      }
+    }
+    return error;
+  }
+
+  void _updateErrors(std::size_t t)
+  {
+    double p[3];
+    auto* errors = &_errors[t * 4];
+    for (std::size_t j = 0; j < 3; ++j) {
+      errors[j] = _calculateError(_triangles[t * 3 + j],
+                                  _triangles[t * 3 + (j + 1) % 3], p);
+    }
+    errors[3] = std::min(errors[0], std::min(errors[1], errors[2]));
+  }
+
+  // Whether moving i0 to p flips one of its triangles, those shared with i1,
+  // which the collapse removes, being flagged
+  bool _flipped(const double* p, uint32_t i0, uint32_t i1,
+                std::vector<uint8_t>& deleted) const
+  {
+    for (std::size_t k = 0; k < _refCounts[i0]; ++k) {
+      const auto t = _refTriangles[_refStarts[i0] + k];
+      if (_deleted[t]) {
+        continue;
+      }
+      const auto s   = _refCorners[_refStarts[i0] + k];
+      const auto id1 = _triangles[t * 3 + (s + 1) % 3];
+      const auto id2 = _triangles[t * 3 + (s + 2) % 3];
+      if (id1 == i1 || id2 == i1) {
+        deleted[k] = 1;
+        continue;
+      }
+
+      double d1[3];
+      double d2[3];
+      const auto cosine = _cosine(p, id1, id2, d1, d2);
+      if (cosine > 0.999) {
+        // Thin triangles, as in anisotropic tessellations, are only rejected
+        // when the collapse makes them much thinner, or degenerate
+        double e1[3];
+        double e2[3];
+        const auto previous = _cosine(&_positions[i0 * 3], id1, id2, e1, e2);
+        if (cosine > 1.0 - 1e-6 || 1.0 - cosine < (1.0 - previous) / 2) {
+          return true;
+        }
+      }
+      double n[3] = {d1[1] * d2[2] - d1[2] * d2[1],
+                     d1[2] * d2[0] - d1[0] * d2[2],
+                     d1[0] * d2[1] - d1[1] * d2[0]};
+      _normalize(n);
+      deleted[k]    = 0;
+      const auto* m = &_normals[t * 3];
+      if (n[0] * m[0] + n[1] * m[1] + n[2] * m[2] < 0.2) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Absolute cosine of the angle at p of the triangle p, id1, id2, whose
+  // normalized edges from p are stored in d1 and d2
+  double _cosine(const double* p, uint32_t id1, uint32_t id2, double* d1,
+                 double* d2) const
+  {
+    for (std::size_t c = 0; c < 3; ++c) {
+      d1[c] = _positions[id1 * 3 + c] - p[c];
+      d2[c] = _positions[id2 * 3 + c] - p[c];
+    }
+    _normalize(d1);
+    _normalize(d2);
+    return std::abs(d1[0] * d2[0] + d1[1] * d2[1] + d1[2] * d2[2]);
+  }
+
+  // Points the triangles of v to i0, removing those flagged by _flipped()
+  void _updateTriangles(uint32_t i0, uint32_t v,
+                        const std::vector<uint8_t>& deleted,
+                        std::size_t& deletedCount)
+  {
+    for (std::size_t k = 0; k < _refCounts[v]; ++k) {
+      const auto t      = _refTriangles[_refStarts[v] + k];
+      const auto corner = _refCorners[_refStarts[v] + k];
+      if (_deleted[t]) {
+        continue;
+      }
+      if (deleted[k]) {
+        _deleted[t] = 1;
+        ++deletedCount;
+        continue;
+      }
+      _triangles[t * 3 + corner] = i0;
+      _dirty[t]                  = 1;
+      _updateErrors(t);
+      _refTriangles.emplace_back(t);
+      _refCorners.emplace_back(corner);
+    }
+  }
+
+  void _updateMesh(int iteration)
+  {
+    // Removal of the deleted triangles
+    if (iteration > 0) {
+      std::size_t count = 0;
+      for (std::size_t t = 0; t < _triangles.size() / 3; ++t) {
+        if (_deleted[t]) {
+          continue;
+        }
+        std::copy_n(&_triangles[t * 3], 3, &_triangles[count * 3]);
+        std::copy_n(&_errors[t * 4], 4, &_errors[count * 4]);
+        std::copy_n(&_normals[t * 3], 3, &_normals[count * 3]);
+        ++count;
+      }
+      _triangles.resize(count * 3);
+      _errors.resize(count * 4);
+      _normals.resize(count * 3);
+    }
+    const auto triangleCount = _triangles.size() / 3;
+    _deleted.assign(triangleCount, 0);
+    _dirty.assign(triangleCount, 0);
+
+    // References from the vertices to their triangles
+    std::fill(_refCounts.begin(), _refCounts.end(), 0);
+    for (auto index : _triangles) {
+      ++_refCounts[index];
+    }
+    uint32_t start = 0;
+    for (std::size_t v = 0; v < _refCounts.size(); ++v) {
+      _refStarts[v] = start;
+      start += _refCounts[v];
+      _refCounts[v] = 0;
+    }
+    _refTriangles.resize(_triangles.size());
+    _refCorners.resize(_triangles.size());
+    for (std::size_t i = 0; i < _triangles.size(); ++i) {
+      const auto v       = _triangles[i];
+      const auto ref     = _refStarts[v] + _refCounts[v]++;
+      _refTriangles[ref] = static_cast<uint32_t>(i / 3);
+      _refCorners[ref]   = static_cast<uint8_t>(i % 3);
+    }
+
+    if (iteration > 0) {
+      return;
+    }
+
+    // Border vertices: an edge used by a single triangle is a border
+    std::vector<uint32_t> neighbours;
+    std::vector<uint32_t> neighbourCounts;
+    for (std::size_t v = 0; v < _refCounts.size(); ++v) {
+      neighbours.clear();
+      neighbourCounts.clear();
+      for (std::size_t k = 0; k < _refCounts[v]; ++k) {
+        const auto t = _refTriangles[_refStarts[v] + k];
+        for (std::size_t j = 0; j < 3; ++j) {
+          const auto id = _triangles[t * 3 + j];
+          const auto it = std::find(neighbours.begin(), neighbours.end(), id);
+          if (it == neighbours.end()) {
+            neighbours.emplace_back(id);
+            neighbourCounts.emplace_back(1);
+          }
+          else {
+            const auto j = static_cast<std::size_t>(it - neighbours.begin());
+            ++neighbourCounts[j];
+          }
+        }
+      }
+      for (std::size_t j = 0; j < neighbours.size(); ++j) {
+        if (neighbourCounts[j] == 1) {
+          _borders[neighbours[j]] = 1;
+        }
+      }
+    }
+
+    // Quadrics of the planes of the triangles around each vertex
+    _normals.resize(triangleCount * 3);
+    _errors.resize(triangleCount * 4);
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+      const double* p0   = &_positions[_triangles[t * 3 + 0] * 3];
+      const double* p1   = &_positions[_triangles[t * 3 + 1] * 3];
+      const double* p2   = &_positions[_triangles[t * 3 + 2] * 3];
+      const double e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const double e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+
+      double* n = &_normals[t * 3];
+      n[0]      = e1[1] * e2[2] - e1[2] * e2[1];
+      n[1]      = e1[2] * e2[0] - e1[0] * e2[2];
+      n[2]      = e1[0] * e2[1] - e1[1] * e2[0];
+      _normalize(n);
+      const double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+      const double plane[10]
+        = {n[0] * n[0], n[0] * n[1], n[0] * n[2], n[0] * d, n[1] * n[1],
+           n[1] * n[2], n[1] * d,    n[2] * n[2], n[2] * d, d * d};
+      for (std::size_t j = 0; j < 3; ++j) {
+        auto* q = &_quadrics[_triangles[t * 3 + j] * 10];
+        for (std::size_t k = 0; k < 10; ++k) {
+          q[k] += plane[k];
+        }
+      }
+    }
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+      _updateErrors(t);
+    }
+  }
+
+  // Removes the deleted triangles
+  void _compact()
+  {
+    std::size_t count = 0;
+    for (std::size_t t = 0; t < _triangles.size() / 3; ++t) {
+      if (!_deleted.empty() && _deleted[t]) {
+        continue;
+      }
+      std::copy_n(&_triangles[t * 3], 3, &_triangles[count * 3]);
+      ++count;
+    }
+    _triangles.resize(count * 3);
+  }
+
+  static void _normalize(double* v)
+  {
+    const auto length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    if (length > 0.0) {
+      v[0] /= length;
+      v[1] /= length;
+      v[2] /= length;
+    }
+  }
+
+private:
+  // Vertices
+  std::vector<double> _positions;
+  std::vector<double> _quadrics;
+  std::vector<uint8_t> _borders;
+  std::vector<uint32_t> _refStarts;
+  std::vector<uint32_t> _refCounts;
+  // Triangles
+  IndicesArray _triangles;
+  std::vector<double> _errors;
+  std::vector<double> _normals;
+  std::vector<uint8_t> _deleted;
+  std::vector<uint8_t> _dirty;
+  // References, a triangle and the corner of the vertex in it
+  std::vector<uint32_t> _refTriangles;
+  std::vector<uint8_t> _refCorners;
+
+}; // end of class Decimation
+
+} // end of anonymous namespace
+
+QuadraticErrorSimplification::QuadraticErrorSimplification(Mesh* mesh)
+    : aggressiveness{7}, decimationIterations{100}, _mesh{mesh}
+{
+  _indices                 = mesh->getIndices();
+  const auto totalVertices = mesh->getTotalVertices();
+
+  // The vertex buffers which cannot be copied per vertex, interleaved or
+  // instanced, are not part of the simplified mesh
+  for (auto kind : mesh->getVerticesDataKinds()) {
+    auto vertexBuffer = mesh->getVertexBuffer(kind);
+    if (!vertexBuffer || vertexBuffer->getIsInstanced()
+        || vertexBuffer->getOffset() != 0
+        || vertexBuffer->getStrideSize() != vertexBuffer->getSize()) {
+      continue;
+    }
+    const auto size = static_cast<std::size_t>(vertexBuffer->getSize());
+    Stream stream{kind, mesh->getVerticesData(kind), size};
+    if (stream.data.size() != totalVertices * size) {
+      continue;
+    }
+    if (kind == VertexBuffer::PositionKind) {
+      _streams.insert(_streams.begin(), std::move(stream));
+    }
+    else {
+      _streams.emplace_back(std::move(stream));
+    }
+  }
+
+  for (const auto& subMesh : mesh->subMeshes) {
+    _subMeshes.emplace_back(
+      SubMeshLayout{subMesh->materialIndex, subMesh->verticesStart,
+                    subMesh->verticesCount, subMesh->indexStart,
+                    subMesh->indexCount});
+  }
+  if (_subMeshes.empty()) {
+    _subMeshes.emplace_back(
+      SubMeshLayout{0, 0, totalVertices, 0, _indices.size()});
+  }
+}
+
+QuadraticErrorSimplification::~QuadraticErrorSimplification()
+{
+}
+
+void QuadraticErrorSimplification::simplify(
+  const ISimplificationSettings& settings,
+  const std::function<void(Mesh* simplifiedMesh)>& successCallback)
+{
+  auto simplifiedMesh = reconstructMesh(decimate(settings));
+  if (successCallback) {
+    successCallback(simplifiedMesh);
+  }
+}
+
+QuadraticErrorSimplification::DecimatedMesh
+QuadraticErrorSimplification::decimate(
+  const ISimplificationSettings& settings) const
+{
+  DecimatedMesh decimated;
+  if (_streams.empty() || _streams.front().kind != VertexBuffer::PositionKind
+      || _streams.front().size != 3) {
+    return decimated;
+  }
+  for (const auto& stream : _streams) {
+    decimated.streams.emplace_back(Stream{stream.kind, {}, stream.size});
+  }
+  const auto& positions  = _streams.front().data;
+  const auto vertexCount = positions.size() / 3;
+
+  // With optimizeMesh, the vertices sharing their position are merged, so that
+  // the seams of the attributes do not become borders
+  Uint32Array welded(vertexCount);
+  std::iota(welded.begin(), welded.end(), 0u);
+  if (settings.optimizeMesh) {
+    std::vector<uint32_t> order(vertexCount);
+    std::iota(order.begin(), order.end(), 0u);
+    const auto less = [&positions](uint32_t a, uint32_t b) {
+      return std::lexicographical_compare(
+        positions.begin() + a * 3, positions.begin() + a * 3 + 3,
+        positions.begin() + b * 3, positions.begin() + b * 3 + 3);
+    };
+    std::stable_sort(order.begin(), order.end(), less);
+    for (std::size_t i = 1; i < vertexCount; ++i) {
+      if (!less(order[i - 1], order[i])) {
+        welded[order[i]] = welded[order[i - 1]];
+      }
+    }
+  }
+
+  const uint32_t unset = std::numeric_limits<uint32_t>::max();
+  Uint32Array localIds(vertexCount, unset);
+  for (const auto& layout : _subMeshes) {
+    const auto triangleCount = layout.indexCount / 3;
+    if (triangleCount == 0
+        || layout.indexStart + layout.indexCount > _indices.size()) {
+      continue;
+    }
+    const auto first = _indices.begin() + static_cast<long>(layout.indexStart);
+
+    // Local vertices of the submesh
+    Uint32Array globalIds;
+    IndicesArray triangles(triangleCount * 3);
+    for (std::size_t i = 0; i < triangles.size(); ++i) {
+      const auto index = welded[first[static_cast<long>(i)]];
+      if (localIds[index] == unset) {
+        localIds[index] = static_cast<uint32_t>(globalIds.size());
+        globalIds.emplace_back(index);
+      }
+      triangles[i] = localIds[index];
+    }
+    std::vector<double> localPositions(globalIds.size() * 3);
+    for (std::size_t v = 0; v < globalIds.size(); ++v) {
+      for (std::size_t c = 0; c < 3; ++c) {
+        localPositions[v * 3 + c] = positions[globalIds[v] * 3 + c];
+      }
+    }
+    for (auto index : globalIds) {
+      localIds[index] = unset;
+    }
+
+    Decimation decimation(std::move(localPositions), std::move(triangles));
+    const auto target = static_cast<std::size_t>(
+      std::max(0.f, settings.quality) * static_cast<float>(triangleCount));
+    decimation.run(target, aggressiveness, decimationIterations);
+
+    // The remaining vertices, in their order of use, keep the attributes of
+    // the vertex they were
+    const auto verticesStart = decimated.streams.front().data.size() / 3;
+    const auto indexStart    = decimated.indices.size();
+    std::vector<uint32_t> remap(globalIds.size(), unset);
+    std::size_t remainingCount = 0;
+    for (auto local : decimation.triangles()) {
+      if (remap[local] == unset) {
+        remap[local] = static_cast<uint32_t>(verticesStart + remainingCount++);
+        const auto global = globalIds[local];
+        for (std::size_t s = 0; s < _streams.size(); ++s) {
+          const auto& source = _streams[s];
+          auto& destination  = decimated.streams[s].data;
+          if (s == 0) {
+            for (std::size_t c = 0; c < 3; ++c) {
+              destination.emplace_back(
+                static_cast<float>(decimation.positions()[local * 3 + c]));
+            }
+            continue;
+          }
+          const auto begin = source.data.begin() + global * source.size;
+          destination.insert(destination.end(), begin, begin + source.size);
+        }
+      }
+      decimated.indices.emplace_back(remap[local]);
+    }
+
+    decimated.subMeshes.emplace_back(
+      SubMeshLayout{layout.materialIndex, verticesStart, remainingCount,
+                    indexStart, decimated.indices.size() - indexStart});
+  }
+
+  return decimated;
+}
+
+Mesh* QuadraticErrorSimplification::reconstructMesh(
+  const DecimatedMesh& decimated)
+{
+  auto scene = _mesh->getScene();
+  auto mesh  = Mesh::New(_mesh->name + "Decimated", scene);
+  if (decimated.indices.empty()) {
+    return mesh;
+  }
+
+  for (const auto& stream : decimated.streams) {
+    mesh->setVerticesData(stream.kind, stream.data, false,
+                          static_cast<int>(stream.size));
+  }
+  const auto vertexCount = decimated.streams.front().data.size() / 3;
+  mesh->setIndices(decimated.indices, vertexCount);
+  mesh->setMaterial(_mesh->getMaterial());
+  mesh->Node::setParent(_mesh->parent());
+
+  mesh->releaseSubMeshes();
+  for (const auto& layout : decimated.subMeshes) {
+    SubMesh::New(layout.materialIndex,
+                 static_cast<unsigned int>(layout.verticesStart),
+                 layout.verticesCount,
+                 static_cast<unsigned int>(layout.indexStart),
+                 layout.indexCount, mesh);
+  }
+
+  return mesh;
+}
+
+std::size_t QuadraticErrorSimplification::getTriangleCount() const
+{
+  return _indices.size() / 3;
+}
+
+} // end of namespace BABYLON
@@ -1,10 +1,13 @@
 #include <babylon/mesh/simplification/simplification_queue.h>
 
+#include <babylon/engine/scene.h>
+#include <babylon/mesh/mesh.h>
 #include <babylon/mesh/simplification/simplification_settings.h>
 
 namespace BABYLON {
 
-SimplificationQueue::SimplificationQueue() : running{false}
+SimplificationQueue::SimplificationQueue(TaskScheduler& scheduler)
+    : running{false}, _scheduler{scheduler}
 {
 }
 
@@ -14,38 +17,111 @@ SimplificationQueue::~SimplificationQueue()
 
 void SimplificationQueue::addTask(const ISimplificationTask& task)
 {
-  _simplificationQueue.emplace(task);
+  runSimplification(task);
 }
 
 void SimplificationQueue::executeNext()
 {
-  if (!_simplificationQueue.empty()) {
-    running                         = true;
-    const ISimplificationTask& task = _simplificationQueue.front();
-    _simplificationQueue.pop();
-    runSimplification(task);
+  for (auto it = _runningTasks.begin(); it != _runningTasks.end();) {
+    if (!_addCompletedLevels(**it)) {
+      ++it;
+      continue;
+    }
+    // The callback may queue another task, so it is called once removed, and
+    // not at all when the mesh was disposed during the decimation
+    const auto successCallback = (*it)->task.successCallback;
+    const auto meshUniqueId    = (*it)->meshUniqueId;
+    auto scene                 = (*it)->scene;
+    it                         = _runningTasks.erase(it);
+    auto mesh = dynamic_cast<Mesh*>(scene->getMeshByUniqueID(meshUniqueId));
+    if (successCallback && mesh) {
+      successCallback(mesh);
+    }
   }
-  else {
-    running = false;
+
+  running = !_runningTasks.empty();
+}
+
+void SimplificationQueue::runSimplification(const ISimplificationTask& task)
+{
+  if (!task.mesh) {
+    return;
+  }
+
+  auto runningTask          = std_util::make_unique<RunningTask>();
+  runningTask->task         = task;
+  runningTask->scene        = task.mesh->getScene();
+  runningTask->meshUniqueId = task.mesh->uniqueId;
+  runningTask->simplifier   = getSimplifier(task);
+
+  // The geometry is copied by the simplifier, the decimations only read it
+  auto simplifier = runningTask->simplifier;
+  TaskHandle<DecimatedMesh> previous;
+  for (std::size_t i = 0; i < task.settings.size(); ++i) {
+    const auto setting = task.settings[i];
+    if (task.parallelProcessing || !previous.valid()) {
+      previous = _scheduler.submit(
+        [simplifier, setting]() { return simplifier->decimate(setting); });
+    }
+    else {
+      previous = previous.then(
+        [simplifier, setting](std::shared_future<DecimatedMesh>) {
+          return simplifier->decimate(setting);
+        });
+    }
+    runningTask->levels.emplace_back(i, previous);
+  }
+
+  _runningTasks.emplace_back(std::move(runningTask));
+  running = true;
+}
+
+void SimplificationQueue::wait()
+{
+  executeNext();
+  for (auto& runningTask : _runningTasks) {
+    for (auto& level : runningTask->levels) {
+      level.second.wait();
+    }
   }
+  executeNext();
 }
 
-void SimplificationQueue::runSimplification(const ISimplificationTask& /*task*/)
+std::size_t SimplificationQueue::getPendingCount() const
 {
-  // TODO IMPLEMENT
-  // if (task.parallelProcessing)
-  //  std::cout << "";
+  return _runningTasks.size();
 }
 
-ISimplifier* SimplificationQueue::getSimplifier(const ISimplificationTask& task)
+std::shared_ptr<QuadraticErrorSimplification>
+SimplificationQueue::getSimplifier(const ISimplificationTask& task)
 {
   switch (task.simplificationType) {
     case SimplificationType::QUADRATIC:
     default:
-      // TODO FIXME
-      return nullptr;
-      // return new QuadraticErrorSimplification(task.mesh);
+      return std::make_shared<QuadraticErrorSimplification>(task.mesh);
+  }
+}
+
+bool SimplificationQueue::_addCompletedLevels(RunningTask& runningTask)
+{
+  auto& levels = runningTask.levels;
+  for (auto it = levels.begin(); it != levels.end();) {
+    if (!it->second.isReady()) {
+      ++it;
+      continue;
+    }
+    // The mesh may have been disposed during the decimation
+    auto mesh = dynamic_cast<Mesh*>(
+      runningTask.scene->getMeshByUniqueID(runningTask.meshUniqueId));
+    const auto& setting = runningTask.task.settings[it->first];
+    if (mesh && mesh == runningTask.task.mesh) {
+      auto lod = runningTask.simplifier->reconstructMesh(it->second.get());
+      mesh->addLODLevel(setting.distance, lod);
+      lod->isVisible = true;
+    }
+    it = levels.erase(it);
   }
+  return levels.empty();
 }
 
 } // end of namespace BABYLON
@@ -0,0 +1,523 @@
+#include <babylon/mesh/static_batcher.h>
+
+#include <babylon/culling/bounding_box.h>
+#include <babylon/culling/bounding_info.h>
+#include <babylon/culling/octrees/octree.h>
+#include <babylon/engine/scene.h>
+#include <babylon/materials/multi_material.h>
+#include <babylon/math/matrix.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/vertex_buffer.h>
+
+namespace BABYLON {
+
+namespace {
+
+// Flags of the layout of a batch, above the bits of the vertex data kinds
+const unsigned int VERTEX_ALPHA_FLAG    = 1u << 30;
+const unsigned int RECEIVE_SHADOWS_FLAG = 1u << 31;
+
+} // end of anonymous namespace
+
+bool StaticBatcher::BatchKey::operator<(const BatchKey& other) const
+{
+  return std::tie(material, layout, renderingGroupId, layerMask, x, y, z)
+         < std::tie(other.material, other.layout, other.renderingGroupId,
+                    other.layerMask, other.x, other.y, other.z);
+}
+
+bool StaticBatcher::BatchKey::operator==(const BatchKey& other) const
+{
+  return std::tie(material, layout, renderingGroupId, layerMask, x, y, z)
+         == std::tie(other.material, other.layout, other.renderingGroupId,
+                     other.layerMask, other.x, other.y, other.z);
+}
+
+StaticBatcher::StaticBatcher(Scene* scene, float cellSize)
+    : _scene{scene}
+    , _cellSize{cellSize > 0.f ? cellSize : 1.f}
+    , _octree{nullptr}
+    , _batchNameCounter{0}
+    , _rebuiltCount{0}
+    , _updatedCount{0}
+{
+}
+
+StaticBatcher::~StaticBatcher()
+{
+}
+
+float StaticBatcher::getCellSize() const
+{
+  return _cellSize;
+}
+
+bool StaticBatcher::CanBatch(AbstractMesh* abstractMesh)
+{
+  if (!abstractMesh
+      || !((abstractMesh->type() == IReflect::Type::MESH)
+           || (abstractMesh->type() == IReflect::Type::GROUNDMESH))) {
+    return false;
+  }
+
+  auto mesh = static_cast<Mesh*>(abstractMesh);
+  if (!mesh->instances.empty() || mesh->skeleton() || mesh->hasLODLevels()
+      || mesh->billboardMode != AbstractMesh::BILLBOARDMODE_NONE
+      || mesh->actionManager || mesh->subMeshes.size() != 1
+      || mesh->getTotalIndices() == 0) {
+    return false;
+  }
+
+  // The sub materials are selected by the submeshes
+  if (dynamic_cast<MultiMaterial*>(mesh->getMaterial())) {
+    return false;
+  }
+
+  return _GetLayout(mesh) != 0;
+}
+
+bool StaticBatcher::addMesh(AbstractMesh* abstractMesh)
+{
+  if (!CanBatch(abstractMesh)) {
+    return false;
+  }
+
+  auto mesh = static_cast<Mesh*>(abstractMesh);
+  if (_memberIndices.find(mesh) != _memberIndices.end()) {
+    return false;
+  }
+
+  mesh->computeWorldMatrix(true);
+
+  const auto index = _members.size();
+  _members.emplace_back(Member{mesh, nullptr, mesh->worldMatrixUpdateCount(),
+                               false, false, 0, 0, 0, 0});
+  _memberIndices[mesh] = index;
+  _insert(index);
+  return true;
+}
+
+std::size_t StaticBatcher::addStaticMeshes()
+{
+  std::size_t count = 0;
+  for (auto& mesh : _scene->getMeshes()) {
+    if (mesh->isWorldMatrixFrozen() && addMesh(mesh)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+bool StaticBatcher::removeMesh(AbstractMesh* abstractMesh)
+{
+  auto it = _memberIndices.find(abstractMesh);
+  if (it == _memberIndices.end()) {
+    return false;
+  }
+
+  const auto index = it->second;
+  _detach(index);
+  _memberIndices.erase(it);
+
+  // The last member takes the place of the removed one
+  const auto last = _members.size() - 1;
+  if (index != last) {
+    _members[index] = _members[last];
+    auto& moved     = _members[index];
+    _memberIndices[moved.mesh] = index;
+    std::replace(moved.batch->members.begin(), moved.batch->members.end(),
+                 last, index);
+  }
+  _members.pop_back();
+  return true;
+}
+
+void StaticBatcher::markMeshAsDirty(AbstractMesh* abstractMesh)
+{
+  auto it = _memberIndices.find(abstractMesh);
+  if (it != _memberIndices.end()) {
+    _markAsDirty(_members[it->second].batch, true);
+  }
+}
+
+void StaticBatcher::update()
+{
+  _rebuiltCount = 0;
+  _updatedCount = 0;
+  _updateOctree();
+
+  for (std::size_t i = 0; i < _members.size();) {
+    auto& member = _members[i];
+    auto mesh    = member.mesh;
+
+    // The last member takes the place of a member which cannot be batched
+    // anymore
+    if (!CanBatch(mesh)) {
+      removeMesh(mesh);
+      continue;
+    }
+    ++i;
+
+    // Moves to the batch of its new material, rendering settings or cell
+    if (!(_getKey(mesh) == member.batch->key)) {
+      _detach(i - 1);
+      _insert(i - 1);
+      continue;
+    }
+
+    auto& batch = *member.batch;
+    if (batch.needsRebuild) {
+      continue;
+    }
+
+    const bool active = _CanBeActive(mesh);
+    if (active != member.active
+        || (active && mesh->getTotalVertices() != member.vertexCount)) {
+      _markAsDirty(&batch, true);
+      continue;
+    }
+
+    if (active
+        && mesh->worldMatrixUpdateCount() != member.worldMatrixUpdateCount) {
+      // The indices only change when the winding of the triangles does
+      if ((mesh->getWorldMatrix()->determinant() < 0.f) != member.reversed) {
+        _markAsDirty(&batch, true);
+        continue;
+      }
+      _transform(member, batch);
+      _markAsDirty(&batch, false);
+    }
+  }
+
+  for (auto batch : _dirtyBatches) {
+    if (batch->needsRebuild) {
+      ++_rebuiltCount;
+      _rebuild(*batch);
+    }
+    else {
+      ++_updatedCount;
+      _upload(*batch);
+    }
+  }
+  _dirtyBatches.clear();
+}
+
+void StaticBatcher::dispose()
+{
+  // Released first, as disposing the batch meshes notifies the batcher
+  auto batches = std::move(_batches);
+  auto members = std::move(_members);
+  _batches.clear();
+  _members.clear();
+  _memberIndices.clear();
+  _dirtyBatches.clear();
+
+  for (auto& member : members) {
+    member.mesh->_isStaticBatched = false;
+  }
+  for (auto& item : batches) {
+    if (item.second->mesh) {
+      item.second->mesh->dispose();
+    }
+  }
+}
+
+void StaticBatcher::_onMeshRemoved(AbstractMesh* mesh)
+{
+  if (removeMesh(mesh)) {
+    return;
+  }
+
+  // Batch mesh disposed from outside, created again by the next update
+  for (auto& item : _batches) {
+    auto& batch = *item.second;
+    if (batch.mesh == mesh) {
+      batch.mesh = nullptr;
+      _markAsDirty(&batch, true);
+      return;
+    }
+  }
+}
+
+std::size_t StaticBatcher::getMeshCount() const
+{
+  return _members.size();
+}
+
+std::size_t StaticBatcher::getBatchCount() const
+{
+  return _batches.size();
+}
+
+std::size_t StaticBatcher::getRebuiltCount() const
+{
+  return _rebuiltCount;
+}
+
+std::size_t StaticBatcher::getUpdatedCount() const
+{
+  return _updatedCount;
+}
+
+unsigned int StaticBatcher::_GetLayout(Mesh* mesh)
+{
+  unsigned int layout = 0;
+  for (auto kind : mesh->getVerticesDataKinds()) {
+    switch (kind) {
+      case VertexBuffer::PositionKind:
+      case VertexBuffer::NormalKind:
+      case VertexBuffer::UVKind:
+      case VertexBuffer::UV2Kind:
+        layout |= 1u << kind;
+        break;
+      case VertexBuffer::ColorKind:
+        // Merged with the colors of the other members, with alpha
+        if (mesh->getVertexBuffer(kind)->getSize() != 4) {
+          return 0;
+        }
+        layout |= 1u << kind;
+        break;
+      default:
+        return 0;
+    }
+  }
+
+  if (!(layout & (1u << VertexBuffer::PositionKind))) {
+    return 0;
+  }
+
+  return layout;
+}
+
+bool StaticBatcher::_CanBeActive(Mesh* mesh)
+{
+  return mesh->isVisible && mesh->visibility >= 1.f && mesh->isEnabled()
+         && mesh->getTotalVertices() > 0;
+}
+
+StaticBatcher::BatchKey StaticBatcher::_getKey(Mesh* mesh) const
+{
+  const auto& center = mesh->getBoundingInfo()->boundingBox.centerWorld;
+
+  BatchKey key;
+  key.material = mesh->getMaterial();
+  key.layout   = _GetLayout(mesh);
+  if (mesh->hasVertexAlpha()) {
+    key.layout |= VERTEX_ALPHA_FLAG;
+  }
+  if (mesh->receiveShadows()) {
+    key.layout |= RECEIVE_SHADOWS_FLAG;
+  }
+  key.renderingGroupId = mesh->renderingGroupId;
+  key.layerMask        = mesh->layerMask;
+  key.x = static_cast<int>(std::floor(center.x / _cellSize));
+  key.y = static_cast<int>(std::floor(center.y / _cellSize));
+  key.z = static_cast<int>(std::floor(center.z / _cellSize));
+  return key;
+}
+
+void StaticBatcher::_insert(std::size_t memberIndex)
+{
+  auto& member   = _members[memberIndex];
+  const auto key = _getKey(member.mesh);
+
+  auto& batch = _batches[key];
+  if (!batch) {
+    batch               = std_util::make_unique<Batch>();
+    batch->key          = key;
+    batch->mesh         = nullptr;
+    batch->needsRebuild = false;
+    batch->needsUpload  = false;
+    for (unsigned int kind = 0; kind < 30; ++kind) {
+      if (key.layout & (1u << kind)) {
+        batch->vertexData.emplace_back(kind, Float32Array());
+      }
+    }
+  }
+
+  batch->members.emplace_back(memberIndex);
+  member.batch = batch.get();
+  _markAsDirty(member.batch, true);
+}
+
+void StaticBatcher::_detach(std::size_t memberIndex)
+{
+  auto& member = _members[memberIndex];
+  auto& batch  = *member.batch;
+  batch.members.erase(
+    std::remove(batch.members.begin(), batch.members.end(), memberIndex),
+    batch.members.end());
+  _markAsDirty(&batch, true);
+
+  member.mesh->_isStaticBatched = false;
+  member.active                 = false;
+  member.batch                  = nullptr;
+}
+
+void StaticBatcher::_markAsDirty(Batch* batch, bool rebuild)
+{
+  if (!batch->needsRebuild && !batch->needsUpload) {
+    _dirtyBatches.emplace_back(batch);
+  }
+  if (rebuild) {
+    batch->needsRebuild = true;
+  }
+  else {
+    batch->needsUpload = true;
+  }
+}
+
+void StaticBatcher::_updateOctree()
+{
+  // The selection octree replaces the meshes of the scene by its selection
+  auto octree = _scene->selectionOctree();
+  if (octree == _octree) {
+    return;
+  }
+
+  _octree = octree;
+  if (_octree) {
+    for (auto& item : _batches) {
+      if (item.second->mesh) {
+        _addToOctree(item.second->mesh);
+      }
+    }
+  }
+}
+
+void StaticBatcher::_addToOctree(Mesh* mesh)
+{
+  auto& content = _octree->dynamicContent;
+  if (std::find(content.begin(), content.end(), mesh) == content.end()) {
+    content.emplace_back(mesh);
+  }
+}
+
+void StaticBatcher::_transform(Member& member, Batch& batch)
+{
+  auto mesh         = member.mesh;
+  const auto& world = *mesh->getWorldMatrix();
+  Vector3 result;
+  for (auto& item : batch.vertexData) {
+    const auto kind = item.first;
+    if (kind != VertexBuffer::PositionKind
+        && kind != VertexBuffer::NormalKind) {
+      continue;
+    }
+    const auto source = mesh->getVerticesData(kind);
+    auto target       = item.second.data() + member.vertexStart * 3;
+    for (std::size_t i = 0; i < member.vertexCount * 3; i += 3) {
+      if (kind == VertexBuffer::PositionKind) {
+        Vector3::TransformCoordinatesFromFloatsToRef(
+          source[i], source[i + 1], source[i + 2], world, result);
+      }
+      else {
+        Vector3::TransformNormalFromFloatsToRef(source[i], source[i + 1],
+                                                source[i + 2], world, result);
+        result.normalize();
+      }
+      target[i]     = result.x;
+      target[i + 1] = result.y;
+      target[i + 2] = result.z;
+    }
+  }
+  member.worldMatrixUpdateCount = mesh->worldMatrixUpdateCount();
+}
+
+void StaticBatcher::_rebuild(Batch& batch)
+{
+  batch.needsRebuild = false;
+  batch.needsUpload  = false;
+  for (auto& item : batch.vertexData) {
+    item.second.clear();
+  }
+  batch.indices.clear();
+
+  std::size_t vertexCount = 0;
+  for (auto index : batch.members) {
+    auto& member = _members[index];
+    auto mesh    = member.mesh;
+
+    member.active          = _CanBeActive(mesh);
+    mesh->_isStaticBatched = member.active;
+    if (!member.active) {
+      continue;
+    }
+
+    member.vertexStart = vertexCount;
+    member.vertexCount = mesh->getTotalVertices();
+    member.indexStart  = batch.indices.size();
+    for (auto& item : batch.vertexData) {
+      const auto data = mesh->getVerticesData(item.first);
+      item.second.insert(item.second.end(), data.begin(), data.end());
+    }
+
+    // The triangles of a mirrored mesh are reversed to keep their front faces
+    const auto indices = mesh->getIndices();
+    member.reversed    = mesh->getWorldMatrix()->determinant() < 0.f;
+    member.indexCount  = indices.size() - indices.size() % 3;
+    const auto offset  = static_cast<std::uint32_t>(vertexCount);
+    for (std::size_t i = 0; i < member.indexCount; i += 3) {
+      batch.indices.emplace_back(indices[i] + offset);
+      batch.indices.emplace_back(indices[i + (member.reversed ? 2 : 1)]
+                                 + offset);
+      batch.indices.emplace_back(indices[i + (member.reversed ? 1 : 2)]
+                                 + offset);
+    }
+    vertexCount += member.vertexCount;
+
+    _transform(member, batch);
+  }
+
+  if (vertexCount == 0) {
+    if (batch.mesh) {
+      auto mesh  = batch.mesh;
+      batch.mesh = nullptr;
+      mesh->dispose();
+    }
+    if (batch.members.empty()) {
+      const auto key = batch.key;
+      _batches.erase(key);
+    }
+    return;
+  }
+
+  if (!batch.mesh) {
+    batch.mesh = Mesh::New(
+      "staticBatch" + std::to_string(_batchNameCounter++), _scene);
+    batch.mesh->setMaterial(batch.key.material);
+    batch.mesh->setHasVertexAlpha((batch.key.layout & VERTEX_ALPHA_FLAG) != 0);
+    batch.mesh->setReceiveShadows((batch.key.layout & RECEIVE_SHADOWS_FLAG)
+                                  != 0);
+    batch.mesh->renderingGroupId = batch.key.renderingGroupId;
+    batch.mesh->layerMask        = batch.key.layerMask;
+    // The members are picked instead
+    batch.mesh->isPickable = false;
+    // The vertices are in world space
+    batch.mesh->freezeWorldMatrix();
+    // Its bounds change with its members
+    if (_octree) {
+      _addToOctree(batch.mesh);
+    }
+  }
+
+  for (auto& item : batch.vertexData) {
+    batch.mesh->setVerticesData(item.first, item.second, true);
+  }
+  batch.mesh->setIndices(batch.indices, vertexCount);
+}
+
+void StaticBatcher::_upload(Batch& batch)
+{
+  batch.needsUpload = false;
+  for (auto& item : batch.vertexData) {
+    if (item.first == VertexBuffer::PositionKind) {
+      batch.mesh->updateVerticesData(item.first, item.second, true);
+    }
+    else if (item.first == VertexBuffer::NormalKind) {
+      batch.mesh->updateVerticesData(item.first, item.second);
+    }
+  }
+}
+
+} // end of namespace BABYLON
@@ -41,7 +41,8 @@ SubMesh::SubMesh(unsigned int iMaterialIndex, unsigned int iVerticesStart,
     _renderingMesh = static_cast<Mesh*>(mesh);
   }
 
-  _id = mesh->subMeshes.size() - 1;
+  // The sub-mesh is only appended to the mesh by addToMesh()
+  _id = mesh->subMeshes.size();
 
   if (createBoundingBox) {
     refreshBoundingInfo();
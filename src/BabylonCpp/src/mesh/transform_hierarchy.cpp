@@ -0,0 +1,183 @@
+#include <babylon/mesh/transform_hierarchy.h>
+
+#include <babylon/engine/scene.h>
+#include <babylon/math/simd/simd_matrix.h>
+#include <babylon/mesh/abstract_mesh.h>
+
+namespace BABYLON {
+
+constexpr int TransformHierarchy::NoParent;
+constexpr int TransformHierarchy::ExternalParent;
+
+TransformHierarchy::TransformHierarchy(Scene* scene)
+    : _scene{scene}, _isDirty{true}, _updatedCount{0}
+{
+}
+
+TransformHierarchy::~TransformHierarchy()
+{
+}
+
+void TransformHierarchy::markAsDirty()
+{
+  _isDirty = true;
+}
+
+std::size_t TransformHierarchy::size() const
+{
+  return _entries.size();
+}
+
+std::size_t TransformHierarchy::updatedCount() const
+{
+  return _updatedCount;
+}
+
+void TransformHierarchy::_rebuild()
+{
+  _isDirty = false;
+
+  const auto& meshes = _scene->meshes;
+  std::unordered_map<const Node*, std::size_t> meshIndices;
+  meshIndices.reserve(meshes.size());
+  for (std::size_t i = 0; i < meshes.size(); ++i) {
+    meshIndices[meshes[i].get()] = i;
+  }
+
+  // Depth of each mesh, the meshes whose parent is not a mesh of the scene
+  // being roots
+  std::vector<std::size_t> depths(meshes.size(), 0);
+  std::size_t maxDepth = 0;
+  for (std::size_t i = 0; i < meshes.size(); ++i) {
+    std::size_t depth = 0;
+    for (Node* node = meshes[i]->parent();
+         node && depth < meshes.size() && meshIndices.count(node);
+         node = node->parent()) {
+      ++depth;
+    }
+    depths[i] = depth;
+    maxDepth  = std::max(maxDepth, depth);
+  }
+
+  // Counting sort by depth, keeping the order of the meshes in the scene
+  _levels.assign(maxDepth + 2, 0);
+  for (auto depth : depths) {
+    ++_levels[depth + 1];
+  }
+  for (std::size_t level = 1; level < _levels.size(); ++level) {
+    _levels[level] += _levels[level - 1];
+  }
+  std::vector<std::size_t> order(meshes.size());
+  std::vector<std::size_t> positions(meshes.size());
+  {
+    auto next = _levels;
+    for (std::size_t i = 0; i < meshes.size(); ++i) {
+      positions[i]        = next[depths[i]]++;
+      order[positions[i]] = i;
+    }
+  }
+
+  _entries.resize(meshes.size());
+  for (std::size_t position = 0; position < order.size(); ++position) {
+    auto mesh    = meshes[order[position]].get();
+    auto& entry  = _entries[position];
+    entry.mesh   = mesh;
+    entry.parent = mesh->parent();
+    if (!entry.parent) {
+      entry.parentIndex = NoParent;
+    }
+    else {
+      auto it           = meshIndices.find(entry.parent);
+      entry.parentIndex = (it == meshIndices.end()
+                           || meshes[it->second]->_masterMesh) ?
+                            ExternalParent :
+                            static_cast<int>(positions[it->second]);
+    }
+    entry.worldMatrixUpdateCount = mesh->worldMatrixUpdateCount();
+  }
+  _changed.assign(_entries.size(), 0);
+}
+
+void TransformHierarchy::update()
+{
+  bool sorted = false;
+  if (_isDirty || _entries.size() != _scene->meshes.size()) {
+    _rebuild();
+    sorted = true;
+  }
+
+  _updatedCount      = 0;
+  const int renderId = _scene->getRenderId();
+  for (std::size_t level = 0; level + 1 < _levels.size(); ++level) {
+    _updateLevel(_levels[level], _levels[level + 1], renderId, sorted);
+  }
+}
+
+void TransformHierarchy::_updateLevel(std::size_t start, std::size_t end,
+                                      int renderId, bool sorted)
+{
+  // Local world matrices of the meshes to update
+  _batch.clear();
+  for (std::size_t i = start; i < end; ++i) {
+    const auto& entry = _entries[i];
+    auto mesh         = entry.mesh;
+    if (mesh->_isWorldMatrixFrozen) {
+      continue;
+    }
+    if (mesh->parent() != entry.parent) {
+      // Sorted again on the next update
+      _isDirty = true;
+      mesh->computeWorldMatrix();
+    }
+    else if (sorted || entry.parentIndex == ExternalParent
+             || mesh->billboardMode != AbstractMesh::BILLBOARDMODE_NONE
+             || mesh->infiniteDistance || mesh->_meshToBoneReferal
+             || mesh->hasNewParent()) {
+      // Depends on other nodes, or on changes of the parent which are not known
+      // right after sorting
+      mesh->computeWorldMatrix();
+    }
+    else if ((entry.parentIndex != NoParent && _changed[entry.parentIndex])
+             || !mesh->_isSynchronized()) {
+      mesh->_computeLocalWorldMatrix();
+      _batch.emplace_back(i);
+    }
+    else {
+      // Up to date, as checked by AbstractMesh::computeWorldMatrix()
+      mesh->_currentRenderId = renderId;
+      if (entry.parentIndex != NoParent) {
+        mesh->_markSyncedWithParent();
+      }
+    }
+  }
+
+  // World matrices, multiplied by the world matrices of the parents
+  for (auto i : _batch) {
+    const auto& entry = _entries[i];
+    auto mesh         = entry.mesh;
+    if (entry.parentIndex == NoParent) {
+      mesh->_worldMatrix->copyFrom(mesh->_localWorld);
+    }
+    else {
+      SIMD::SIMDMatrix::MultiplyToRefSIMD(
+        mesh->_localWorld, *_entries[entry.parentIndex].mesh->_worldMatrix,
+        *mesh->_worldMatrix);
+      mesh->_worldMatrix->_markAsUpdated();
+      mesh->_markSyncedWithParent();
+    }
+  }
+  for (auto i : _batch) {
+    _entries[i].mesh->_afterWorldMatrixUpdate();
+  }
+
+  for (std::size_t i = start; i < end; ++i) {
+    auto& entry        = _entries[i];
+    const auto count   = entry.mesh->worldMatrixUpdateCount();
+    const bool changed = count != entry.worldMatrixUpdateCount;
+    _changed[i]        = changed ? 1 : 0;
+    _updatedCount += changed ? 1 : 0;
+    entry.worldMatrixUpdateCount = count;
+  }
+}
+
+} // end of namespace BABYLON
@@ -11,6 +11,11 @@
 #include <babylon/mesh/vertex_data_options.h>
 #include <babylon/tools/tools.h>
 
+// SIMD
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+#include <babylon/math/simd/simd_vector3.h>
+#endif
+
 namespace BABYLON {
 
 VertexData::VertexData()
@@ -256,6 +261,11 @@ VertexData& VertexData::_update(IGetSetVerticesData* meshOrGeometry,
 
 VertexData& VertexData::transform(const Matrix& matrix)
 {
+#if BABYLONCPP_OPTION_ENABLE_SIMD == true
+  SIMD::SIMDVector3::TransformCoordinatesArraySIMD(positions, matrix,
+                                                   positions);
+  SIMD::SIMDVector3::TransformNormalsArraySIMD(normals, matrix, normals);
+#else
   auto transformed = Vector3::Zero();
   if (!positions.empty()) {
     auto position = Vector3::Zero();
@@ -282,6 +292,7 @@ VertexData& VertexData::transform(const Matrix& matrix)
       normals[index + 2] = transformed.z;
     }
   }
+#endif
 
   if (!tangents.empty()) {
     auto tangent            = Vector4::Zero();
@@ -10,7 +10,13 @@ namespace BABYLON {
 
 PhysicsEngine::PhysicsEngine(const Vector3& _gravity,
                              IPhysicsEnginePlugin* physicsPlugin)
-    : _initialized{false}, _physicsPlugin{physicsPlugin}
+    : _initialized{false}
+    , _physicsPlugin{physicsPlugin}
+    , _timeStep{1.f / 60.f}
+    , _maxSubSteps{4}
+    , _timeAccumulator{0.f}
+    , _interpolationAlpha{0.f}
+    , _interpolationEnabled{true}
 {
   if (_physicsPlugin && _physicsPlugin->isSupported()) {
     setGravity(_gravity);
@@ -37,9 +43,40 @@ void PhysicsEngine::setGravity(const Vector3& _gravity)
 
 void PhysicsEngine::setTimeStep(float newTimeStep)
 {
+  _timeStep = newTimeStep;
   _physicsPlugin->setTimeStep(newTimeStep);
 }
 
+float PhysicsEngine::getTimeStep() const
+{
+  return _timeStep;
+}
+
+void PhysicsEngine::setMaxSubSteps(unsigned int maxSubSteps)
+{
+  _maxSubSteps = std::max(maxSubSteps, 1u);
+}
+
+unsigned int PhysicsEngine::getMaxSubSteps() const
+{
+  return _maxSubSteps;
+}
+
+void PhysicsEngine::setInterpolationEnabled(bool enabled)
+{
+  _interpolationEnabled = enabled;
+}
+
+bool PhysicsEngine::isInterpolationEnabled() const
+{
+  return _interpolationEnabled;
+}
+
+float PhysicsEngine::getInterpolationAlpha() const
+{
+  return _interpolationAlpha;
+}
+
 void PhysicsEngine::dispose(bool /*doNotRecurse*/)
 {
   for (auto& impostor : _impostors) {
@@ -125,14 +162,22 @@ void PhysicsEngine::_step(float delta)
     }
   }
 
-  if (delta > 0.1f) {
-    delta = 0.1f;
-  }
-  else if (delta <= 0.f) {
-    delta = 1.f / 60.f;
+  // The frame time is consumed in fixed time steps, so that the simulation
+  // does not depend on the frame rate. The time left is carried over to the
+  // next frame, up to _maxSubSteps steps per frame.
+  _timeAccumulator += std::min(std::max(delta, 0.f),
+                               static_cast<float>(_maxSubSteps) * _timeStep);
+  while (_timeAccumulator >= _timeStep) {
+    _physicsPlugin->executeStep(_timeStep, _impostors);
+    _timeAccumulator -= _timeStep;
   }
+  _interpolationAlpha = _timeAccumulator / _timeStep;
 
-  _physicsPlugin->executeStep(delta, _impostors);
+  if (_interpolationEnabled) {
+    for (auto& impostor : _impostors) {
+      impostor->interpolate(_interpolationAlpha);
+    }
+  }
 }
 
 IPhysicsEnginePlugin* PhysicsEngine::getPhysicsPlugin()
@@ -7,6 +7,7 @@
 #include <babylon/math/vector3.h>
 #include <babylon/mesh/abstract_mesh.h>
 #include <babylon/mesh/mesh.h>
+#include <babylon/physics/iphysics_body.h>
 #include <babylon/physics/iphysics_enabled_object.h>
 #include <babylon/physics/iphysics_engine_plugin.h>
 #include <babylon/physics/joint/physics_joint.h>
@@ -26,6 +27,8 @@ PhysicsImpostor::PhysicsImpostor(IPhysicsEnabledObject* _object,
     , _scene{scene}
     , _bodyUpdateRequired{false}
     , _deltaPosition{Vector3::Zero()}
+    , _isSynced{false}
+    , _isMoving{false}
 {
   // Sanity check!
   if (!object) {
@@ -241,18 +244,24 @@ void PhysicsImpostor::unregisterOnPhysicsCollide()
 
 void PhysicsImpostor::beforeStep()
 {
-  object->position().subtractToRef(_deltaPosition, _tmpPositionWithDelta);
-  // conjugate deltaRotation
-  if (_deltaRotationConjugated) {
-    object->rotationQuaternion().multiplyToRef(*_deltaRotationConjugated,
-                                               _tmpRotationWithDelta);
-  }
-  else {
-    _tmpRotationWithDelta.copyFrom(object->rotationQuaternion());
-  }
+  // The body already has the transform of an object which was not moved
+  // since the physics engine last set it
+  if (!_isSynced || !object->position().equals(_syncedPosition)
+      || !object->rotationQuaternion().equals(_syncedRotation)) {
+    object->position().subtractToRef(_deltaPosition, _tmpPositionWithDelta);
+    // conjugate deltaRotation
+    if (_deltaRotationConjugated) {
+      object->rotationQuaternion().multiplyToRef(*_deltaRotationConjugated,
+                                                 _tmpRotationWithDelta);
+    }
+    else {
+      _tmpRotationWithDelta.copyFrom(object->rotationQuaternion());
+    }
 
-  _physicsEngine->getPhysicsPlugin()->setPhysicsBodyTransformation(
-    this, _tmpPositionWithDelta, _tmpRotationWithDelta);
+    _physicsEngine->getPhysicsPlugin()->setPhysicsBodyTransformation(
+      this, _tmpPositionWithDelta, _tmpRotationWithDelta);
+    _isSynced = false;
+  }
 
   for (auto& func : _onBeforePhysicsStepCallbacks) {
     func(this);
@@ -265,12 +274,56 @@ void PhysicsImpostor::afterStep()
     func(this);
   }
 
+  // A sleeping body did not move, unless its object was moved before the step
+  if (_isSynced && physicsBody()->sleeping()) {
+    _previousPosition.copyFrom(_currentPosition);
+    _previousRotation.copyFrom(_currentRotation);
+    _isMoving = !_syncedPosition.equals(_currentPosition)
+                || !_syncedRotation.equals(_currentRotation);
+    return;
+  }
+
   _physicsEngine->getPhysicsPlugin()->setTransformationFromPhysicsBody(this);
 
   object->position().addInPlace(_deltaPosition);
   if (_deltaRotation) {
     object->rotationQuaternion().multiplyInPlace(*_deltaRotation);
   }
+
+  // A moved object is not interpolated from where it was
+  if (_isSynced) {
+    _previousPosition.copyFrom(_currentPosition);
+    _previousRotation.copyFrom(_currentRotation);
+  }
+  else {
+    _previousPosition.copyFrom(object->position());
+    _previousRotation.copyFrom(object->rotationQuaternion());
+  }
+  _currentPosition.copyFrom(object->position());
+  _currentRotation.copyFrom(object->rotationQuaternion());
+  _syncedPosition.copyFrom(_currentPosition);
+  _syncedRotation.copyFrom(_currentRotation);
+  _isSynced = true;
+  _isMoving = true;
+}
+
+void PhysicsImpostor::interpolate(float alpha)
+{
+  // Moved objects are left where they are until the next step
+  if (!_isMoving || !object->position().equals(_syncedPosition)
+      || !object->rotationQuaternion().equals(_syncedRotation)) {
+    return;
+  }
+
+  Vector3::LerpToRef(_previousPosition, _currentPosition, alpha,
+                     object->position());
+  Quaternion::SlerpToRef(_previousRotation, _currentRotation, alpha,
+                         object->rotationQuaternion());
+  _syncedPosition.copyFrom(object->position());
+  _syncedRotation.copyFrom(object->rotationQuaternion());
+  // An object at rest stays where it is until the next step moves it
+  _isMoving = !_previousPosition.equals(_currentPosition)
+              || !_previousRotation.equals(_currentRotation);
 }
 
 void PhysicsImpostor::onCollide(IPhysicsBody* /*body*/)
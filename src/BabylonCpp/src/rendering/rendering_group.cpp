@@ -7,12 +7,31 @@
 #include <babylon/engine/scene.h>
 #include <babylon/materials/material.h>
 #include <babylon/mesh/abstract_mesh.h>
+#include <babylon/mesh/mesh.h>
 #include <babylon/mesh/sub_mesh.h>
 #include <babylon/particles/particle_system.h>
 #include <babylon/sprites/sprite_manager.h>
 
 namespace BABYLON {
 
+namespace {
+
+// Below this count, the submeshes are sorted by insertion
+const size_t RADIX_SORT_THRESHOLD = 32;
+
+// 16 bits Fibonacci hash of a pointer, 0 for null
+std::uint64_t hashPointer(const void* pointer)
+{
+  if (!pointer) {
+    return 0;
+  }
+  return (static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(pointer))
+          * 0x9E3779B97F4A7C15ull)
+         >> 48;
+}
+
+} // end of anonymous namespace
+
 RenderingGroup::RenderingGroup(
   unsigned int iIndex, Scene* scene,
   const std::function<int(SubMesh* a, SubMesh* b)>& opaqueSortCompareFn,
@@ -23,6 +42,9 @@ RenderingGroup::RenderingGroup(
   _opaqueSubMeshes.reserve(256);
   _transparentSubMeshes.reserve(256);
   _alphaTestSubMeshes.reserve(256);
+  _sortKeys.reserve(256);
+  _sortKeysBuffer.reserve(256);
+  _sortSubMeshesBuffer.reserve(256);
   _particleSystems.reserve(256);
   _spriteManagers.reserve(256);
 
@@ -101,11 +123,17 @@ void RenderingGroup::render(
 
   // Opaque
   if (!_opaqueSubMeshes.empty()) {
+    if (!_opaqueSortCompareFn) {
+      _sortByState(_opaqueSubMeshes);
+    }
     _renderOpaque(_opaqueSubMeshes);
   }
 
   // Alpha test
   if (!_alphaTestSubMeshes.empty()) {
+    if (!_alphaTestSortCompareFn) {
+      _sortByState(_alphaTestSubMeshes);
+    }
     engine->setAlphaTesting(true);
     _renderAlphaTest(_alphaTestSubMeshes);
     engine->setAlphaTesting(false);
@@ -167,10 +195,8 @@ void RenderingGroup::renderSorted(
 {
   for (auto& subMesh : subMeshes) {
     subMesh->_alphaIndex = subMesh->getMesh()->alphaIndex;
-    subMesh->_distanceToCamera
-      = subMesh->getBoundingInfo()
-          ->boundingSphere.centerWorld.subtract(cameraPosition)
-          .length();
+    subMesh->_distanceToCamera = Vector3::Distance(
+      subMesh->getBoundingInfo()->boundingSphere.centerWorld, cameraPosition);
   }
 
   auto sortedArray = subMeshes;
@@ -194,6 +220,105 @@ void RenderingGroup::renderUnsorted(const std::vector<SubMesh*>& subMeshes)
   }
 }
 
+void RenderingGroup::_sortByState(std::vector<SubMesh*>& subMeshes)
+{
+  const auto count = subMeshes.size();
+  if (count < 2) {
+    return;
+  }
+
+  Vector3 cameraPosition = Vector3::Zero();
+  float maxDistance      = 1.f;
+  if (_scene->activeCamera) {
+    cameraPosition = _scene->activeCamera->globalPosition();
+    maxDistance    = std::max(_scene->activeCamera->maxZ, 1.f);
+  }
+
+  _sortKeys.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    _sortKeys[i] = _getStateSortKey(subMeshes[i], cameraPosition, maxDistance);
+  }
+
+  if (count < RADIX_SORT_THRESHOLD) {
+    for (size_t i = 1; i < count; ++i) {
+      const auto key     = _sortKeys[i];
+      const auto subMesh = subMeshes[i];
+      auto j             = i;
+      for (; j > 0 && _sortKeys[j - 1] > key; --j) {
+        _sortKeys[j] = _sortKeys[j - 1];
+        subMeshes[j] = subMeshes[j - 1];
+      }
+      _sortKeys[j] = key;
+      subMeshes[j] = subMesh;
+    }
+    return;
+  }
+
+  // Least significant byte first, the histograms of all the bytes being
+  // counted in a single pass
+  std::array<std::array<size_t, 256>, 8> histograms{};
+  for (auto key : _sortKeys) {
+    for (auto& histogram : histograms) {
+      ++histogram[key & 0xFF];
+      key >>= 8;
+    }
+  }
+
+  _sortKeysBuffer.resize(count);
+  _sortSubMeshesBuffer.resize(count);
+  for (unsigned int pass = 0; pass < 8; ++pass) {
+    auto& histogram  = histograms[pass];
+    const auto shift = 8 * pass;
+    // Skips the bytes which are the same for all the keys, as the effect
+    // hashes of a scene using a single effect
+    if (histogram[(_sortKeys[0] >> shift) & 0xFF] == count) {
+      continue;
+    }
+    size_t offset = 0;
+    for (auto& bucket : histogram) {
+      const auto bucketCount = bucket;
+      bucket                 = offset;
+      offset += bucketCount;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      const auto digit               = (_sortKeys[i] >> shift) & 0xFF;
+      const auto position            = histogram[digit]++;
+      _sortKeysBuffer[position]      = _sortKeys[i];
+      _sortSubMeshesBuffer[position] = subMeshes[i];
+    }
+    _sortKeys.swap(_sortKeysBuffer);
+    subMeshes.swap(_sortSubMeshesBuffer);
+  }
+}
+
+std::uint64_t RenderingGroup::_getStateSortKey(SubMesh* subMesh,
+                                               const Vector3& cameraPosition,
+                                               float maxDistance)
+{
+  auto material  = subMesh->getMaterial();
+  Effect* effect = material->storeEffectOnSubMeshes ? subMesh->effect() :
+                                                      material->getEffect();
+
+  // The clones of a mesh share the vertex buffers of its geometry
+  const void* vertexBuffers = nullptr;
+  if (auto renderingMesh = subMesh->getRenderingMesh()) {
+    vertexBuffers = renderingMesh->geometry();
+  }
+  if (!vertexBuffers) {
+    vertexBuffers = subMesh->getMesh();
+  }
+
+  // Front to back, to limit the overdraw
+  subMesh->_distanceToCamera = Vector3::Distance(
+    subMesh->getBoundingInfo()->boundingSphere.centerWorld, cameraPosition);
+  const auto depth = std::min(
+    std::max(subMesh->_distanceToCamera / maxDistance, 0.f), 1.f);
+
+  return (hashPointer(effect) << 48) | (hashPointer(material) << 32)
+         | (hashPointer(vertexBuffers) << 16)
+         | static_cast<std::uint64_t>(depth * 65535.f);
+}
+
 int RenderingGroup::defaultTransparentSortCompare(SubMesh* a, SubMesh* b)
 {
   // Alpha index first
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <babylon/cameras/free_camera.h>
+#include <babylon/collisions/collider.h>
+#include <babylon/collisions/icollision_coordinator.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/mesh/mesh.h>
+
+namespace {
+
+// Requests a new position for the collision index, and dispatches the replies
+// of the worker until the request of the control index is answered. The
+// replies being dispatched in order, the replies of the requests sent before
+// are dispatched too.
+void collide(BABYLON::Scene* scene, unsigned int collisionIndex,
+             bool& replied)
+{
+  using namespace BABYLON;
+
+  Collider collider;
+  collider.radius     = Vector3(0.5f, 0.5f, 0.5f);
+  const auto callback = [&replied](unsigned int, Vector3&, AbstractMesh*) {
+    replied = true;
+  };
+  for (int i = 0; i < 10000 && !replied; ++i) {
+    Vector3 position(0.f, 5.f, 0.f);
+    Vector3 velocity(0.f, -1.f, 0.f);
+    scene->collisionCoordinator->getNewPosition(position, velocity, &collider,
+                                                3, nullptr, callback,
+                                                collisionIndex);
+    scene->onAfterRenderObservable.notifyObservers(scene);
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+} // end of anonymous namespace
+
+TEST(TestCollisionCoordinatorWorker, Reply)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  scene->setWorkerCollisions(true);
+  auto ground = Mesh::CreateGround("ground", 10, 10, 2, scene.get());
+  ground->setCheckCollisions(true);
+
+  bool replied = false;
+  collide(scene.get(), ground->uniqueId, replied);
+  EXPECT_TRUE(replied);
+}
+
+TEST(TestCollisionCoordinatorWorker, ReplyAfterDispose)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  scene->setWorkerCollisions(true);
+  auto ground = Mesh::CreateGround("ground", 10, 10, 2, scene.get());
+  auto box    = Mesh::CreateBox("box", 1.f, scene.get());
+  auto camera
+    = FreeCamera::New("camera", Vector3(0.f, 5.f, -10.f), scene.get());
+  const auto boxId    = box->uniqueId;
+  const auto cameraId = camera->uniqueId;
+
+  // The worker is initialized once a first request is answered
+  bool initialized = false;
+  collide(scene.get(), ground->uniqueId, initialized);
+  ASSERT_TRUE(initialized);
+
+  // Requests of a mesh and a camera disposed before the replies arrive
+  Collider collider;
+  collider.radius     = Vector3(0.5f, 0.5f, 0.5f);
+  bool staleReply     = false;
+  const auto callback = [&staleReply](unsigned int, Vector3&, AbstractMesh*) {
+    staleReply = true;
+  };
+  Vector3 position(0.f, 5.f, 0.f);
+  Vector3 velocity(0.f, -1.f, 0.f);
+  for (auto collisionIndex : {boxId, cameraId}) {
+    scene->collisionCoordinator->getNewPosition(
+      position, velocity, &collider, 3, nullptr, callback, collisionIndex);
+  }
+  box->dispose();
+  camera->dispose();
+
+  bool replied = false;
+  collide(scene.get(), ground->uniqueId, replied);
+  EXPECT_TRUE(replied);
+  EXPECT_FALSE(staleReply);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <babylon/core/bounded_queue.h>
+
+TEST(TestBoundedQueue, PushAndPop)
+{
+  using namespace BABYLON;
+  BoundedQueue<int> testQueue;
+  EXPECT_TRUE(testQueue.empty());
+  testQueue.push(2);
+  EXPECT_FALSE(testQueue.empty());
+  EXPECT_EQ(testQueue.size(), 1);
+  int poppedItem;
+  bool result = testQueue.tryAndPop(poppedItem);
+  EXPECT_EQ(poppedItem, 2);
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(testQueue.empty());
+  result = testQueue.tryAndPop(poppedItem);
+  EXPECT_FALSE(result);
+}
+
+TEST(TestBoundedQueue, Capacity)
+{
+  using namespace BABYLON;
+  BoundedQueue<int> testQueue(5);
+  EXPECT_EQ(testQueue.capacity(), 8);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(testQueue.tryPush(i));
+  }
+  EXPECT_FALSE(testQueue.tryPush(8));
+  EXPECT_EQ(testQueue.size(), 8);
+  // Items are retrieved in insertion order
+  int poppedItem;
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(testQueue.tryAndPop(poppedItem));
+    EXPECT_EQ(poppedItem, i);
+  }
+  EXPECT_TRUE(testQueue.empty());
+}
+
+TEST(TestBoundedQueue, PushAndPopBatch)
+{
+  using namespace BABYLON;
+  BoundedQueue<int> testQueue(4);
+  std::vector<int> items{0, 1, 2, 3, 4, 5};
+  EXPECT_EQ(testQueue.tryPushBatch(items.begin(), items.end()), 4);
+  std::vector<int> poppedItems;
+  EXPECT_EQ(testQueue.tryPopBatch(std::back_inserter(poppedItems), 3), 3);
+  EXPECT_EQ(poppedItems, std::vector<int>({0, 1, 2}));
+  EXPECT_EQ(testQueue.waitAndPopBatch(std::back_inserter(poppedItems), 3), 1);
+  EXPECT_EQ(poppedItems, std::vector<int>({0, 1, 2, 3}));
+  EXPECT_EQ(testQueue.tryPopBatch(std::back_inserter(poppedItems), 3), 0);
+}
+
+TEST(TestBoundedQueue, MultipleProducersMultipleConsumers)
+{
+  using namespace BABYLON;
+  const int threadCount = 4, itemCount = 10000;
+  BoundedQueue<int> testQueue(16);
+  std::atomic<long long> sum{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 1; i <= itemCount; ++i) {
+        testQueue.push(i);
+      }
+    });
+    threads.emplace_back([&] {
+      int poppedItem;
+      for (int i = 0; i < itemCount; ++i) {
+        testQueue.waitAndPop(poppedItem);
+        sum += poppedItem;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(testQueue.empty());
+  EXPECT_EQ(sum, threadCount * (itemCount * (itemCount + 1ll) / 2));
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <babylon/core/lookup_index.h>
+
+TEST(TestLookupIndex, AddAndRemove)
+{
+  using namespace BABYLON;
+  int a = 0, b = 1, c = 2;
+  LookupIndex<std::string, int> index;
+  EXPECT_EQ(index.first("box"), nullptr);
+  index.add("box", &a);
+  index.add("sphere", &b);
+  index.add("box", &c);
+  EXPECT_EQ(index.size(), 2);
+  EXPECT_EQ(index.first("box"), &a);
+  EXPECT_EQ(index.last("box"), &c);
+  EXPECT_EQ(index.all("box"), std::vector<int*>({&a, &c}));
+  EXPECT_EQ(index.first("sphere"), &b);
+  EXPECT_FALSE(index.remove("sphere", &a));
+  EXPECT_TRUE(index.remove("sphere", &b));
+  EXPECT_EQ(index.first("sphere"), nullptr);
+  EXPECT_TRUE(index.all("sphere").empty());
+  EXPECT_TRUE(index.remove("box", &a));
+  EXPECT_EQ(index.first("box"), &c);
+  index.clear();
+  EXPECT_EQ(index.size(), 0);
+}
+
+TEST(TestLookupIndex, Rename)
+{
+  using namespace BABYLON;
+  int a = 0, b = 1, c = 2;
+  LookupIndex<std::string, int> index;
+  index.add("a", &a);
+  index.add("b", &b);
+  index.add("c", &c);
+  // Renamed items keep their insertion order
+  index.rename("c", "b", &c);
+  index.rename("a", "b", &a);
+  EXPECT_EQ(index.all("b"), std::vector<int*>({&a, &b, &c}));
+  EXPECT_EQ(index.first("a"), nullptr);
+  EXPECT_EQ(index.first("c"), nullptr);
+  // Items which are not indexed are ignored
+  int d = 3;
+  index.rename("d", "b", &d);
+  EXPECT_EQ(index.last("b"), &c);
+}
+
+TEST(TestLookupIndex, UniqueIds)
+{
+  using namespace BABYLON;
+  std::vector<int> items(1000);
+  LookupIndex<unsigned int, int> index;
+  for (unsigned int i = 0; i < items.size(); ++i) {
+    index.add(i, &items[i]);
+  }
+  for (unsigned int i = 0; i < items.size(); ++i) {
+    EXPECT_EQ(index.first(i), &items[i]);
+  }
+  EXPECT_EQ(index.first(1000), nullptr);
+}
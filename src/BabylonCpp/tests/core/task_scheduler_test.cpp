@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <babylon/core/future.h>
+#include <babylon/core/task_scheduler.h>
+
+TEST(TestTaskScheduler, Submit)
+{
+  using namespace BABYLON;
+  TaskScheduler scheduler(2);
+  auto task = scheduler.submit([]() { return 6 * 7; });
+  EXPECT_TRUE(task.valid());
+  EXPECT_EQ(task.get(), 42);
+  EXPECT_TRUE(task.isReady());
+}
+
+TEST(TestTaskScheduler, Continuations)
+{
+  using namespace BABYLON;
+  TaskScheduler scheduler(2);
+  auto task = scheduler.submit([]() { return std::string("Hello"); })
+                .then([](std::shared_future<std::string> hello) {
+                  return hello.get() + " world";
+                })
+                .then([](std::shared_future<std::string> helloWorld) {
+                  return helloWorld.get().size();
+                });
+  EXPECT_EQ(task.get(), 11);
+
+  // Exceptions are propagated to the continuations
+  auto failed = scheduler.submit([]() -> int {
+    throw std::runtime_error("failed");
+  });
+  auto continuation = failed.then(
+    [](std::shared_future<int> result) { return result.get() + 1; });
+  EXPECT_ANY_THROW(continuation.get());
+}
+
+TEST(TestTaskScheduler, ParallelFor)
+{
+  using namespace BABYLON;
+  TaskScheduler scheduler(3);
+  std::vector<int> values(10000, 0);
+  scheduler.parallelFor(0, values.size(),
+                        [&values](std::size_t begin, std::size_t end) {
+                          for (std::size_t i = begin; i < end; ++i) {
+                            values[i] += static_cast<int>(i);
+                          }
+                        },
+                        64);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], static_cast<int>(i));
+  }
+
+  // Nested in tasks
+  std::atomic<std::size_t> count{0};
+  std::vector<TaskHandle<void>> tasks;
+  for (int i = 0; i < 8; ++i) {
+    tasks.emplace_back(scheduler.submit([&]() {
+      scheduler.parallelFor(0, 1000, [&](std::size_t begin, std::size_t end) {
+        count += end - begin;
+      });
+    }));
+  }
+  for (auto& task : tasks) {
+    task.wait();
+  }
+  EXPECT_EQ(count, 8000);
+}
+
+TEST(TestTaskScheduler, WaitOnlyRunsAwaitedWork)
+{
+  using namespace BABYLON;
+  TaskScheduler scheduler(1);
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+  auto blocker = scheduler.submit([&]() {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  // With the worker busy, the waiting thread runs the awaited task and the
+  // chunks of its parallelFor, not the other pending tasks
+  auto unrelated = scheduler.submit([]() {});
+  auto awaited   = scheduler.submit([]() { return 42; });
+  EXPECT_EQ(awaited.get(), 42);
+  std::atomic<std::size_t> count{0};
+  scheduler.parallelFor(0, 100,
+                        [&count](std::size_t begin, std::size_t end) {
+                          count += end - begin;
+                        },
+                        10);
+  EXPECT_EQ(count, 100);
+  SerialTaskQueue queue(scheduler);
+  int value = 0;
+  queue.send([&value]() { value = 1; });
+  queue.wait();
+  EXPECT_EQ(value, 1);
+  EXPECT_FALSE(unrelated.isReady());
+
+  release = true;
+  blocker.wait();
+  unrelated.wait();
+}
+
+TEST(TestTaskScheduler, SerialTaskQueue)
+{
+  using namespace BABYLON;
+  TaskScheduler scheduler(4);
+  std::vector<int> order;
+  {
+    SerialTaskQueue queue(scheduler);
+    for (int i = 0; i < 100; ++i) {
+      queue.send([&order, i]() { order.emplace_back(i); });
+    }
+  }
+  ASSERT_EQ(order.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(TestTaskScheduler, Statistics)
+{
+  using namespace BABYLON;
+  TaskScheduler scheduler(2);
+  EXPECT_EQ(scheduler.statistics().size(), 2);
+  for (int i = 0; i < 16; ++i) {
+    scheduler.submit([]() {}).get();
+  }
+  std::size_t executedTasks = 0;
+  for (const auto& statistics : scheduler.statistics()) {
+    executedTasks += statistics.executedTasks;
+    EXPECT_LE(statistics.utilization(), 1.f);
+  }
+  // Tasks may also be executed by the waiting thread
+  EXPECT_LE(executedTasks, 16);
+  scheduler.resetStatistics();
+  for (const auto& statistics : scheduler.statistics()) {
+    EXPECT_EQ(statistics.executedTasks, 0);
+  }
+}
+
+TEST(TestTaskScheduler, SpawnTask)
+{
+  using namespace BABYLON;
+  // Scheduler used as background worker
+  TaskScheduler scheduler(1);
+  auto future = spawn_task([]() { return 1; }, &scheduler);
+  EXPECT_EQ(future.get(), 1);
+  // Shared scheduler
+  auto task = spawn_task([]() { return 2; });
+  EXPECT_EQ(task.get(), 2);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <babylon/culling/bounding_info.h>
+#include <babylon/culling/bounding_volume_arrays.h>
+#include <babylon/math/frustum.h>
+#include <babylon/math/matrix.h>
+#include <babylon/math/plane.h>
+
+namespace {
+
+std::array<BABYLON::Plane, 6> cameraFrustumPlanes()
+{
+  using namespace BABYLON;
+  Vector3 target(0.f, 0.f, 0.f);
+  auto view = Matrix::LookAtLH(Vector3(0.f, 0.f, -50.f), target, Vector3::Up());
+  return Frustum::GetPlanes(
+    view.multiply(Matrix::PerspectiveFovLH(0.8f, 1.5f, 1.f, 100.f)));
+}
+
+} // end of anonymous namespace
+
+TEST(TestBoundingVolumeArrays, Cull)
+{
+  using namespace BABYLON;
+
+  const auto frustumPlanes = cameraFrustumPlanes();
+
+  // Randomly placed, rotated and scaled boxes
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<float> position(-120.f, 120.f);
+  std::uniform_real_distribution<float> angle(-3.f, 3.f);
+  std::uniform_real_distribution<float> size(0.1f, 10.f);
+  const auto randomWorld = [&]() {
+    return Matrix::Scaling(size(generator), size(generator), size(generator))
+      .multiply(Matrix::RotationYawPitchRoll(angle(generator),
+                                             angle(generator),
+                                             angle(generator)))
+      .multiply(Matrix::Translation(position(generator), position(generator),
+                                    position(generator)));
+  };
+  const std::size_t count = 1003;
+  std::vector<std::unique_ptr<BoundingInfo>> boundingInfos;
+  BoundingVolumeArrays volumes;
+  volumes.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    boundingInfos.emplace_back(std_util::make_unique<BoundingInfo>(
+      Vector3(-size(generator), -size(generator), -size(generator)),
+      Vector3(size(generator), size(generator), size(generator))));
+    boundingInfos.back()->update(randomWorld());
+    volumes.attach(i, *boundingInfos.back());
+  }
+
+  Uint32Array visibility;
+  for (unsigned int pass = 0; pass < 2; ++pass) {
+    volumes.cull(frustumPlanes, visibility);
+    ASSERT_EQ(visibility.size(), (count + 31) / 32);
+    std::size_t visibleCount = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      const bool visible = BoundingVolumeArrays::IsVisible(visibility, i);
+      EXPECT_EQ(visible, boundingInfos[i]->isInFrustum(frustumPlanes)) << i;
+      visibleCount += visible ? 1 : 0;
+    }
+    EXPECT_GT(visibleCount, 0);
+    EXPECT_LT(visibleCount, count);
+    // Padding objects are culled
+    EXPECT_EQ(visibility.back() >> (count % 32), 0u);
+
+    // The updated bounding volumes are mirrored
+    for (auto& boundingInfo : boundingInfos) {
+      boundingInfo->update(randomWorld());
+    }
+  }
+}
+
+TEST(TestBoundingVolumeArrays, Flags)
+{
+  using namespace BABYLON;
+
+  const auto frustumPlanes = cameraFrustumPlanes();
+
+  BoundingInfo inside(Vector3(-1.f, -1.f, -1.f), Vector3(1.f, 1.f, 1.f));
+  BoundingInfo outside(Vector3(-1.f, -1.f, -1.f), Vector3(1.f, 1.f, 1.f));
+  outside.update(Matrix::Translation(0.f, 0.f, -200.f));
+  BoundingInfo other(inside);
+
+  BoundingVolumeArrays volumes;
+  volumes.resize(40);
+  volumes.attach(0, inside);
+  volumes.attach(1, outside);
+  volumes.setAlwaysVisible(2, true);
+  volumes.attach(3, other);
+  volumes.setCulled(3, true);
+  volumes.setAlwaysVisible(35, true);
+  volumes.attach(36, other);
+
+  Uint32Array visibility;
+  volumes.cull(frustumPlanes, visibility);
+  ASSERT_EQ(visibility.size(), 2);
+  // The bounding info was moved from the object 3 to the object 36
+  EXPECT_EQ(visibility[0], 0x5u);
+  EXPECT_EQ(visibility[1], 0x18u);
+
+  // Destroyed bounding infos are detached
+  {
+    BoundingInfo temporary(inside);
+    volumes.attach(4, temporary);
+    volumes.cull(frustumPlanes, visibility);
+    EXPECT_EQ(visibility[0], 0x15u);
+  }
+  volumes.cull(frustumPlanes, visibility);
+  EXPECT_EQ(visibility[0], 0x5u);
+
+  volumes.resize(2);
+  volumes.cull(frustumPlanes, visibility);
+  ASSERT_EQ(visibility.size(), 1);
+  EXPECT_EQ(visibility[0], 0x1u);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <babylon/culling/bounding_box.h>
+#include <babylon/culling/bounding_info.h>
+#include <babylon/culling/octrees/octree.h>
+#include <babylon/culling/ray.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/math/frustum.h>
+#include <babylon/math/matrix.h>
+#include <babylon/math/plane.h>
+#include <babylon/mesh/mesh.h>
+
+namespace {
+
+bool contains(const std::vector<BABYLON::AbstractMesh*>& selection,
+              BABYLON::AbstractMesh* mesh)
+{
+  return std::find(selection.begin(), selection.end(), mesh)
+         != selection.end();
+}
+
+bool hasDuplicates(std::vector<BABYLON::AbstractMesh*> selection)
+{
+  std::sort(selection.begin(), selection.end());
+  return std::adjacent_find(selection.begin(), selection.end())
+         != selection.end();
+}
+
+} // end of anonymous namespace
+
+TEST(TestOctree, Update)
+{
+  using namespace BABYLON;
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+
+  // Randomly placed boxes
+  std::mt19937 generator(11);
+  std::uniform_real_distribution<float> position(-100.f, 100.f);
+  std::uniform_real_distribution<float> size(0.1f, 8.f);
+  std::vector<AbstractMesh*> meshes;
+  for (unsigned int i = 0; i < 500; ++i) {
+    auto mesh = Mesh::New("box" + std::to_string(i), scene.get());
+    mesh->setBoundingInfo(
+      BoundingInfo(Vector3(-size(generator), -size(generator), 0.f),
+                   Vector3(size(generator), size(generator), size(generator))));
+    mesh->getBoundingInfo()->update(Matrix::Translation(
+      position(generator), position(generator), position(generator)));
+    meshes.emplace_back(mesh);
+  }
+  Octree<AbstractMesh*> octree(Octree<AbstractMesh*>::BoundsFuncForMeshes, 8,
+                               3);
+  octree.update(Vector3(-110.f, -110.f, -110.f), Vector3(110.f, 110.f, 110.f),
+                meshes);
+  EXPECT_EQ(octree.entries(), meshes);
+  ASSERT_GT(octree.blocks.size(), 8);
+  EXPECT_EQ(octree.blocks[0].depth(), 1);
+
+  // Each leaf holds exactly the entries intersecting it
+  for (const auto& block : octree.blocks) {
+    if (!block.isLeaf()) {
+      EXPECT_EQ(octree.blocks[block.firstBlock()].depth(), block.depth() + 1);
+      continue;
+    }
+    EXPECT_TRUE(block.entriesCount() <= 8 || block.depth() == 3);
+    std::vector<AbstractMesh*> expected, actual;
+    for (auto mesh : octree.entries()) {
+      if (mesh->getBoundingInfo()->boundingBox.intersectsMinMax(
+            block.minPoint(), block.maxPoint())) {
+        expected.emplace_back(mesh);
+      }
+    }
+    for (size_t i = 0; i < block.entriesCount(); ++i) {
+      actual.emplace_back(
+        octree.entries()[octree.blockEntries()[block.entriesStart() + i]]);
+    }
+    EXPECT_EQ(actual, expected);
+  }
+
+  // Frustum selection
+  Vector3 target(0.f, 0.f, 0.f);
+  auto view = Matrix::LookAtLH(Vector3(0.f, 0.f, -50.f), target, Vector3::Up());
+  const auto frustumPlanes = Frustum::GetPlanes(
+    view.multiply(Matrix::PerspectiveFovLH(0.8f, 1.5f, 1.f, 100.f)));
+  const auto selection = octree.select(frustumPlanes, false);
+  EXPECT_FALSE(hasDuplicates(selection));
+  EXPECT_LT(selection.size(), octree.entries().size());
+  EXPECT_TRUE(hasDuplicates(octree.select(frustumPlanes, true)));
+  for (auto mesh : octree.entries()) {
+    if (mesh->getBoundingInfo()->isInFrustum(frustumPlanes)) {
+      EXPECT_TRUE(contains(selection, mesh));
+    }
+  }
+
+  // Sphere and ray intersections
+  const Vector3 sphereCenter(10.f, -20.f, 30.f);
+  const auto spheres = octree.intersects(sphereCenter, 25.f, false);
+  EXPECT_FALSE(hasDuplicates(spheres));
+  const Ray ray(Vector3(-100.f, -50.f, 0.f), Vector3(1.f, 0.5f, 0.f), 1000.f);
+  const auto rays = octree.intersectsRay(ray);
+  EXPECT_FALSE(hasDuplicates(rays));
+  for (auto mesh : octree.entries()) {
+    const auto& boundingBox = mesh->getBoundingInfo()->boundingBox;
+    if (BoundingBox::IntersectsSphere(boundingBox.minimumWorld,
+                                      boundingBox.maximumWorld, sphereCenter,
+                                      25.f)) {
+      EXPECT_TRUE(contains(spheres, mesh));
+    }
+    if (ray.intersectsBoxMinMax(boundingBox.minimumWorld,
+                                boundingBox.maximumWorld)) {
+      EXPECT_TRUE(contains(rays, mesh));
+    }
+  }
+
+  // Batched queries
+  std::vector<std::vector<AbstractMesh*>> selections;
+  octree.select({frustumPlanes, frustumPlanes}, selections, false);
+  ASSERT_EQ(selections.size(), 2);
+  EXPECT_EQ(selections[0], selection);
+  EXPECT_EQ(selections[1], selection);
+  octree.intersects({sphereCenter}, {25.f}, selections, false);
+  ASSERT_EQ(selections.size(), 1);
+  EXPECT_EQ(selections[0], spheres);
+  octree.intersectsRay({ray}, selections);
+  ASSERT_EQ(selections.size(), 1);
+  EXPECT_EQ(selections[0], rays);
+
+  // Dynamic content is appended in its order, without duplicates
+  AbstractMesh* dynamicMesh  = Mesh::New("dynamic", scene.get());
+  AbstractMesh* dynamicMesh2 = Mesh::New("dynamic2", scene.get());
+  octree.dynamicContent
+    = {dynamicMesh2, selection.front(), dynamicMesh, dynamicMesh2, dynamicMesh};
+
+  const auto withDynamicContent = octree.select(frustumPlanes, false);
+  ASSERT_EQ(withDynamicContent.size(), selection.size() + 2);
+  EXPECT_EQ(withDynamicContent[selection.size()], dynamicMesh2);
+  EXPECT_EQ(withDynamicContent.back(), dynamicMesh);
+  octree.dynamicContent.clear();
+
+  // Added meshes are stored in the leaves they intersect
+  auto added = Mesh::New("added", scene.get());
+  added->setBoundingInfo(
+    BoundingInfo(Vector3(-1.f, -1.f, -1.f), Vector3(1.f, 1.f, 1.f)));
+  added->getBoundingInfo()->update(Matrix::Identity());
+  AbstractMesh* addedMesh = added;
+  octree.addMesh(addedMesh);
+  EXPECT_TRUE(contains(octree.select(frustumPlanes, false), added));
+  EXPECT_TRUE(contains(octree.intersects(Vector3::Zero(), 0.5f), added));
+  EXPECT_FALSE(contains(octree.intersects(sphereCenter, 0.5f), added));
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <unistd.h>
+
+#include <babylon/core/filesystem.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/recording_gl_rendering_context.h>
+#include <babylon/engine/shader_program_cache.h>
+
+namespace {
+
+using namespace BABYLON;
+
+const std::string VERTEX_CODE   = "void main(void) { gl_Position = vec4(0.); }";
+const std::string FRAGMENT_CODE = "void main(void) { glFragColor = vec4(1.); }";
+
+struct TestShaderProgramCache : public ::testing::Test {
+  void SetUp() override
+  {
+    char directory[] = "/tmp/shader_program_cache_XXXXXX";
+    ASSERT_NE(::mkdtemp(directory), nullptr);
+    cacheDirectory = directory;
+  }
+
+  void TearDown() override
+  {
+    for (const auto& key : keys) {
+      Filesystem::removeFile(
+        Filesystem::joinPath(cacheDirectory, key + ".bin"));
+    }
+    // No temporary file is left behind
+    EXPECT_EQ(::rmdir(cacheDirectory.c_str()), 0);
+  }
+
+  std::string cacheDirectory;
+  std::vector<std::string> keys;
+};
+
+} // end of anonymous namespace
+
+TEST_F(TestShaderProgramCache, ReusesProgramBinaries)
+{
+  using namespace BABYLON;
+
+  // First run: the program is compiled, linked and stored
+  {
+    HeadlessCanvas canvas;
+    auto engine = Engine::New(&canvas);
+    engine->enableShaderProgramCache(cacheDirectory);
+    auto cache = engine->getShaderProgramCache();
+    auto gl    = canvas.recordingContext();
+    keys.emplace_back(
+      cache->getKey(gl, VERTEX_CODE, FRAGMENT_CODE, "#define A").name);
+
+    gl->resetStatistics();
+    EXPECT_NE(engine->createShaderProgram(VERTEX_CODE, FRAGMENT_CODE,
+                                          "#define A"),
+              nullptr);
+    EXPECT_EQ(gl->statistics().shaderCompilations, 2u);
+    EXPECT_EQ(gl->statistics().programLinks, 1u);
+    EXPECT_EQ(cache->getMissCount(), 1u);
+    EXPECT_EQ(cache->getStoredCount(), 1u);
+  }
+
+  // Later run: the program is loaded from its binary
+  {
+    HeadlessCanvas canvas;
+    auto engine = Engine::New(&canvas);
+    engine->enableShaderProgramCache(cacheDirectory);
+    auto cache = engine->getShaderProgramCache();
+    auto gl    = canvas.recordingContext();
+
+    gl->resetStatistics();
+    EXPECT_NE(engine->createShaderProgram(VERTEX_CODE, FRAGMENT_CODE,
+                                          "#define A"),
+              nullptr);
+    EXPECT_EQ(gl->statistics().shaderCompilations, 0u);
+    EXPECT_EQ(gl->statistics().programLinks, 0u);
+    EXPECT_EQ(gl->statistics().programBinaryLoads, 1u);
+    EXPECT_EQ(cache->getHitCount(), 1u);
+
+    // Other defines, other program
+    keys.emplace_back(
+      cache->getKey(gl, VERTEX_CODE, FRAGMENT_CODE, "#define B").name);
+    EXPECT_NE(engine->createShaderProgram(VERTEX_CODE, FRAGMENT_CODE,
+                                          "#define B"),
+              nullptr);
+    EXPECT_EQ(gl->statistics().shaderCompilations, 2u);
+    EXPECT_EQ(cache->getMissCount(), 1u);
+  }
+}
+
+TEST_F(TestShaderProgramCache, FallsBackOnInvalidBinaries)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  engine->enableShaderProgramCache(cacheDirectory);
+  auto cache = engine->getShaderProgramCache();
+  auto gl    = canvas.recordingContext();
+  keys.emplace_back(cache->getKey(gl, VERTEX_CODE, FRAGMENT_CODE, "").name);
+
+  // Corrupted cache file
+  const auto path = Filesystem::joinPath(cacheDirectory, keys.back() + ".bin");
+  Filesystem::writeFileContents(path.c_str(), "not a program binary");
+
+  gl->resetStatistics();
+  EXPECT_NE(engine->createShaderProgram(VERTEX_CODE, FRAGMENT_CODE, ""),
+            nullptr);
+  EXPECT_EQ(cache->getRejectedCount(), 1u);
+  EXPECT_EQ(gl->statistics().shaderCompilations, 2u);
+  EXPECT_EQ(cache->getStoredCount(), 1u);
+
+  // The file was replaced by a valid binary
+  engine->disableShaderProgramCache();
+  engine->enableShaderProgramCache(cacheDirectory);
+  cache = engine->getShaderProgramCache();
+  EXPECT_NE(engine->createShaderProgram(VERTEX_CODE, FRAGMENT_CODE, ""),
+            nullptr);
+  EXPECT_EQ(cache->getHitCount(), 1u);
+  EXPECT_EQ(gl->statistics().programBinaryLoads, 1u);
+}
+
+TEST_F(TestShaderProgramCache, RejectsOtherPrograms)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  engine->enableShaderProgramCache(cacheDirectory);
+  auto cache = engine->getShaderProgramCache();
+  auto gl    = canvas.recordingContext();
+  keys.emplace_back(cache->getKey(gl, VERTEX_CODE, FRAGMENT_CODE, "").name);
+  keys.emplace_back(
+    cache->getKey(gl, VERTEX_CODE, FRAGMENT_CODE, "#define A").name);
+  EXPECT_NE(engine->createShaderProgram(VERTEX_CODE, FRAGMENT_CODE, ""),
+            nullptr);
+
+  // The file of another program, as when the names of the files collide
+  const auto data = Filesystem::readFileContents(
+    Filesystem::joinPath(cacheDirectory, keys[0] + ".bin").c_str());
+  Filesystem::writeFileContents(
+    Filesystem::joinPath(cacheDirectory, keys[1] + ".bin").c_str(), data);
+
+  gl->resetStatistics();
+  EXPECT_NE(engine->createShaderProgram(VERTEX_CODE, FRAGMENT_CODE,
+                                        "#define A"),
+            nullptr);
+  EXPECT_EQ(cache->getRejectedCount(), 1u);
+  EXPECT_EQ(gl->statistics().programBinaryLoads, 0u);
+  EXPECT_EQ(gl->statistics().shaderCompilations, 2u);
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/materials/multi_material.h>
+#include <babylon/materials/standard_material.h>
+
+TEST(TestMaterial, Rename)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine   = Engine::New(&canvas);
+  auto scene    = Scene::New(engine.get());
+  auto material = StandardMaterial::New("material", scene.get());
+  EXPECT_EQ(scene->getMaterialByID("material"), material);
+
+  material->setId("id");
+  material->setName("name");
+  EXPECT_EQ(scene->getMaterialByID("material"), nullptr);
+  EXPECT_EQ(scene->getMaterialByName("material"), nullptr);
+  EXPECT_EQ(scene->getMaterialByID("id"), material);
+  EXPECT_EQ(scene->getMaterialByName("name"), material);
+
+  // The multi materials are not looked up with the materials
+  auto multiMaterial = MultiMaterial::New("multi", scene.get());
+  multiMaterial->setId("multiId");
+  multiMaterial->setName("multiName");
+  EXPECT_EQ(multiMaterial->id, "multiId");
+  EXPECT_EQ(multiMaterial->name, "multiName");
+  EXPECT_EQ(scene->getMaterialByID("multiId"), nullptr);
+  EXPECT_EQ(scene->getMaterialByName("multiName"), nullptr);
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <babylon/materials/effect_includes_shaders_store.h>
+#include <babylon/materials/shader_processor.h>
+
+namespace {
+
+using namespace BABYLON;
+
+struct TestShaderProcessor : public ::testing::Test {
+  void SetUp() override
+  {
+    EffectIncludesShadersStore::SetShader("testDeclaration", "uniform vec3 a;");
+    EffectIncludesShadersStore::SetShader("testLight",
+                                          "vec3 light{X} = color{X};");
+  }
+
+  void TearDown() override
+  {
+    EffectIncludesShadersStore::RemoveShader("testDeclaration");
+    EffectIncludesShadersStore::RemoveShader("testLight");
+  }
+};
+
+} // end of anonymous namespace
+
+TEST_F(TestShaderProcessor, Includes)
+{
+  using namespace BABYLON;
+
+  const std::unordered_map<std::string, unsigned int> noParameters;
+
+  // Lines without includes
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes("a\nb", noParameters), "a\nb\n");
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes("", noParameters), "\n");
+
+  // Include, without trailing new line
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes(
+              "a\n#include<testDeclaration>\nb", noParameters),
+            "a\nuniform vec3 a;b\n");
+
+  // Unknown include
+  EXPECT_EQ(
+    ShaderProcessor::ProcessIncludes("a\n#include<unknown>\nb", noParameters),
+    "a\nb\n");
+}
+
+TEST_F(TestShaderProcessor, InstancedIncludes)
+{
+  using namespace BABYLON;
+
+  const std::string source = "#include<testLight>[0..maxLights]\nend";
+  std::unordered_map<std::string, unsigned int> indexParameters{
+    {"maxLights", 1}};
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes(source, indexParameters),
+            "vec3 light0 = color0;\nvec3 light1 = color1;\nend\n");
+
+  // The expansion depends on the index parameters
+  indexParameters["maxLights"] = 0;
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes(source, indexParameters),
+            "vec3 light0 = color0;\nend\n");
+
+  // Numeric range
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes("#include<testLight>[2..3]",
+                                             indexParameters),
+            "vec3 light2 = color2;\nvec3 light3 = color3;\n");
+
+  // Unknown index parameter or invalid range
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes(
+              "#include<testLight>[0..unknown]\nend", indexParameters),
+            "end\n");
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes("#include<testLight>[0]\nend",
+                                             indexParameters),
+            "end\n");
+}
+
+TEST_F(TestShaderProcessor, ModifiedIncludes)
+{
+  using namespace BABYLON;
+
+  const std::unordered_map<std::string, unsigned int> noParameters;
+  const std::string source = "#include<testDeclaration>\n#include<testExtra>";
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes(source, noParameters),
+            "uniform vec3 a;");
+
+  // The sources are processed again with the modified includes
+  EffectIncludesShadersStore::SetShader("testDeclaration", "uniform vec3 b;");
+  EffectIncludesShadersStore::SetShader("testExtra", "uniform vec3 c;");
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes(source, noParameters),
+            "uniform vec3 b;uniform vec3 c;");
+  EffectIncludesShadersStore::RemoveShader("testExtra");
+  EXPECT_EQ(ShaderProcessor::ProcessIncludes(source, noParameters),
+            "uniform vec3 b;");
+}
+
+TEST_F(TestShaderProcessor, ManySources)
+{
+  using namespace BABYLON;
+
+  // More sources than the cache holds, processed twice
+  const std::unordered_map<std::string, unsigned int> noParameters;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int i = 0; i < 1000; ++i) {
+      const auto index = std::to_string(i);
+      EXPECT_EQ(ShaderProcessor::ProcessIncludes(
+                  "#include<testDeclaration>\n" + index, noParameters),
+                "uniform vec3 a;" + index + "\n");
+    }
+  }
+}
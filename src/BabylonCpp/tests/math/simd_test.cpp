@@ -1,7 +1,46 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <babylon/math/matrix.h>
+#include <babylon/math/quaternion.h>
 #include <babylon/math/simd/float32x4.h>
+#include <babylon/math/simd/simd_matrix.h>
+#include <babylon/math/simd/simd_quaternion.h>
+#include <babylon/math/simd/simd_vector3.h>
+#include <babylon/math/vector3.h>
+
+namespace {
+
+BABYLON::Matrix testMatrix()
+{
+  using namespace BABYLON;
+  auto rotation = Quaternion::RotationYawPitchRoll(0.3f, -1.2f, 2.1f);
+  return Matrix::Compose(Vector3(1.5f, 2.f, 0.5f), rotation,
+                         Vector3(1.f, -2.f, 3.f));
+}
+
+void expectNear(const BABYLON::Matrix& actual, const BABYLON::Matrix& expected)
+{
+  for (unsigned int i = 0; i < 16; ++i) {
+    EXPECT_NEAR(actual.m[i], expected.m[i], 1e-5f) << "index " << i;
+  }
+}
+
+} // end of anonymous namespace
+
+TEST(TestSIMDFloat32x4, abs)
+{
+  using namespace BABYLON;
+
+  auto a   = SIMD::Float32x4(-1, 2, -0.f, -4);
+  auto res = SIMD::Float32x4(SIMD::Float32x4::abs(a.xmm));
+
+  EXPECT_EQ(res.x(), 1);
+  EXPECT_EQ(res.y(), 2);
+  EXPECT_EQ(res.z(), 0);
+  EXPECT_FALSE(std::signbit(res.z()));
+  EXPECT_EQ(res.w(), 4);
+}
 
 TEST(TestSIMDFloat32x4, add)
 {
@@ -31,6 +70,41 @@ TEST(TestSIMDFloat32x4, div)
   EXPECT_EQ(res.w(), 0.5f);
 }
 
+TEST(TestSIMDFloat32x4, greaterThanOrEqual)
+{
+  using namespace BABYLON;
+
+  auto a = SIMD::Float32x4(1, 2, 3, 4);
+  auto b = SIMD::Float32x4(2, 2, 2, 2);
+
+  EXPECT_EQ(SIMD::Float32x4::signMask(
+              SIMD::Float32x4::greaterThanOrEqual(a.xmm, b.xmm)),
+            0xE);
+}
+
+TEST(TestSIMDFloat32x4, lessThan)
+{
+  using namespace BABYLON;
+
+  auto a = SIMD::Float32x4(1, 2, 3, 4);
+  auto b = SIMD::Float32x4(2, 2, 2, 2);
+
+  EXPECT_EQ(
+    SIMD::Float32x4::signMask(SIMD::Float32x4::lessThan(a.xmm, b.xmm)), 0x1);
+}
+
+TEST(TestSIMDFloat32x4, lessThanOrEqual)
+{
+  using namespace BABYLON;
+
+  auto a = SIMD::Float32x4(1, 2, 3, 4);
+  auto b = SIMD::Float32x4(2, 2, 2, 2);
+
+  EXPECT_EQ(SIMD::Float32x4::signMask(
+              SIMD::Float32x4::lessThanOrEqual(a.xmm, b.xmm)),
+            0x3);
+}
+
 TEST(TestSIMDFloat32x4, load)
 {
   using namespace BABYLON;
@@ -136,6 +210,15 @@ TEST(TestSIMDFloat32x4, shuffle)
   EXPECT_EQ(res.w(), 8);
 }
 
+TEST(TestSIMDFloat32x4, signMask)
+{
+  using namespace BABYLON;
+
+  auto a = SIMD::Float32x4(-1, 2, -3, 4);
+
+  EXPECT_EQ(SIMD::Float32x4::signMask(a.xmm), 0x5);
+}
+
 TEST(TestSIMDFloat32x4, splat)
 {
   using namespace BABYLON;
@@ -188,3 +271,181 @@ TEST(TestSIMDFloat32x4, swizzle)
   EXPECT_EQ(res.z(), 1);
   EXPECT_EQ(res.w(), 4);
 }
+
+TEST(TestSIMDMatrix, Compose)
+{
+  using namespace BABYLON;
+
+  Vector3 scale(1.5f, -2.f, 0.5f), translation(1.f, -2.f, 3.f);
+  auto rotation = Quaternion::RotationYawPitchRoll(0.3f, -1.2f, 2.1f);
+  Matrix result;
+  SIMD::SIMDMatrix::ComposeToRefSIMD(scale, rotation, translation, result);
+
+  expectNear(result, Matrix::Compose(scale, rotation, translation));
+}
+
+TEST(TestSIMDMatrix, Decompose)
+{
+  using namespace BABYLON;
+
+  const auto matrix = testMatrix();
+  Vector3 expectedScale, expectedTranslation, scale, translation;
+  Quaternion expectedRotation, rotation;
+  EXPECT_TRUE(
+    matrix.decompose(expectedScale, expectedRotation, expectedTranslation));
+  EXPECT_TRUE(
+    SIMD::SIMDMatrix::DecomposeSIMD(matrix, scale, rotation, translation));
+
+  EXPECT_EQ(scale.x, expectedScale.x);
+  EXPECT_EQ(scale.y, expectedScale.y);
+  EXPECT_EQ(scale.z, expectedScale.z);
+  EXPECT_EQ(rotation.x, expectedRotation.x);
+  EXPECT_EQ(rotation.y, expectedRotation.y);
+  EXPECT_EQ(rotation.z, expectedRotation.z);
+  EXPECT_EQ(rotation.w, expectedRotation.w);
+  EXPECT_EQ(translation.x, expectedTranslation.x);
+  EXPECT_EQ(translation.y, expectedTranslation.y);
+  EXPECT_EQ(translation.z, expectedTranslation.z);
+
+  // Zero scaling
+  EXPECT_FALSE(SIMD::SIMDMatrix::DecomposeSIMD(Matrix::Scaling(1.f, 0.f, 1.f),
+                                               scale, rotation, translation));
+  EXPECT_EQ(rotation.w, 1.f);
+}
+
+TEST(TestSIMDMatrix, Invert)
+{
+  using namespace BABYLON;
+
+  auto matrix = testMatrix();
+  Matrix expected, result;
+  matrix.invertToRef(expected);
+  SIMD::SIMDMatrix::InvertToRefSIMD(matrix, result);
+  expectNear(result, expected);
+
+  // In place
+  SIMD::SIMDMatrix::InvertToRefSIMD(matrix, matrix);
+  expectNear(matrix, expected);
+}
+
+TEST(TestSIMDMatrix, Multiply)
+{
+  using namespace BABYLON;
+
+  auto left  = testMatrix();
+  auto right = Matrix::RotationYawPitchRoll(-0.7f, 0.4f, 1.1f);
+  right.setTranslationFromFloats(-4.f, 5.f, 6.f);
+  Matrix result;
+  SIMD::SIMDMatrix::MultiplyToRefSIMD(left, right, result);
+
+  // Summed in the same order as the scalar multiplication
+  const auto expected = left.multiply(right);
+  for (unsigned int i = 0; i < 16; ++i) {
+    EXPECT_EQ(result.m[i], expected.m[i]);
+  }
+}
+
+TEST(TestSIMDQuaternion, Multiply)
+{
+  using namespace BABYLON;
+
+  const auto left  = Quaternion::RotationYawPitchRoll(0.3f, -1.2f, 2.1f);
+  const auto right = Quaternion::RotationYawPitchRoll(-0.7f, 0.4f, 1.1f);
+  Quaternion result;
+  SIMD::SIMDQuaternion::MultiplyToRefSIMD(left, right, result);
+
+  const auto expected = left.multiply(right);
+  EXPECT_EQ(result.x, expected.x);
+  EXPECT_EQ(result.y, expected.y);
+  EXPECT_EQ(result.z, expected.z);
+  EXPECT_EQ(result.w, expected.w);
+}
+
+TEST(TestSIMDQuaternion, Slerp)
+{
+  using namespace BABYLON;
+
+  const auto left  = Quaternion::RotationYawPitchRoll(0.3f, -1.2f, 2.1f);
+  const auto right = Quaternion::RotationYawPitchRoll(-0.7f, 0.4f, 1.1f);
+  for (float amount : {0.f, 0.25f, 0.5f, 1.f}) {
+    Quaternion result;
+    SIMD::SIMDQuaternion::SlerpToRefSIMD(left, right, amount, result);
+
+    const auto expected = Quaternion::Slerp(left, right, amount);
+    EXPECT_EQ(result.x, expected.x);
+    EXPECT_EQ(result.y, expected.y);
+    EXPECT_EQ(result.z, expected.z);
+    EXPECT_EQ(result.w, expected.w);
+  }
+}
+
+TEST(TestSIMDQuaternion, ToRotationMatrix)
+{
+  using namespace BABYLON;
+
+  const auto quaternion = Quaternion::RotationYawPitchRoll(0.3f, -1.2f, 2.1f);
+  Matrix expected, result;
+  quaternion.toRotationMatrix(expected);
+  SIMD::SIMDQuaternion::ToRotationMatrixSIMD(quaternion, result);
+
+  for (unsigned int i = 0; i < 16; ++i) {
+    EXPECT_EQ(result.m[i], expected.m[i]);
+  }
+}
+
+TEST(TestSIMDVector3, TransformCoordinatesArray)
+{
+  using namespace BABYLON;
+
+  // 4 vectors at a time, and a remaining vector
+  Float32Array positions;
+  for (unsigned int i = 0; i < 15; ++i) {
+    positions.emplace_back(static_cast<float>(i) * 0.5f - 3.f);
+  }
+  auto transformation = testMatrix();
+  transformation.m[3] = 0.1f;
+  Float32Array result;
+  SIMD::SIMDVector3::TransformCoordinatesArraySIMD(positions, transformation,
+                                                   result);
+
+  ASSERT_EQ(result.size(), positions.size());
+  for (unsigned int i = 0; i < positions.size(); i += 3) {
+    Vector3 expected;
+    Vector3::TransformCoordinatesFromFloatsToRef(
+      positions[i], positions[i + 1], positions[i + 2], transformation,
+      expected);
+    EXPECT_EQ(result[i], expected.x);
+    EXPECT_EQ(result[i + 1], expected.y);
+    EXPECT_EQ(result[i + 2], expected.z);
+  }
+
+  // In place
+  SIMD::SIMDVector3::TransformCoordinatesArraySIMD(positions, transformation,
+                                                   positions);
+  EXPECT_EQ(positions, result);
+}
+
+TEST(TestSIMDVector3, TransformNormalsArray)
+{
+  using namespace BABYLON;
+
+  Float32Array normals;
+  for (unsigned int i = 0; i < 15; ++i) {
+    normals.emplace_back(static_cast<float>(i) * 0.5f - 3.f);
+  }
+  const auto transformation = testMatrix();
+  Float32Array result;
+  SIMD::SIMDVector3::TransformNormalsArraySIMD(normals, transformation,
+                                               result);
+
+  ASSERT_EQ(result.size(), normals.size());
+  for (unsigned int i = 0; i < normals.size(); i += 3) {
+    Vector3 expected;
+    Vector3::TransformNormalFromFloatsToRef(normals[i], normals[i + 1],
+                                            normals[i + 2], transformation,
+                                            expected);
+    EXPECT_EQ(result[i], expected.x);
+    EXPECT_EQ(result[i + 1], expected.y);
+    EXPECT_EQ(result[i + 2], expected.z);
+  }
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <babylon/cameras/free_camera.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/recording_gl_rendering_context.h>
+#include <babylon/engine/scene.h>
+#include <babylon/lights/hemispheric_light.h>
+#include <babylon/materials/standard_material.h>
+#include <babylon/mesh/instanced_mesh.h>
+#include <babylon/mesh/mesh.h>
+
+TEST(TestInstancesStream, UploadsChangedInstances)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto camera
+    = FreeCamera::New("camera", Vector3(0.f, 50.f, -0.1f), scene.get());
+  camera->setTarget(Vector3::Zero());
+  HemisphericLight::New("light", Vector3(0.f, 1.f, 0.f), scene.get());
+
+  // A box and 99 instances
+  auto box = Mesh::CreateBox("box", 1.f, scene.get());
+  box->setMaterial(StandardMaterial::New("material", scene.get()));
+  std::vector<InstancedMesh*> instances;
+  for (unsigned int i = 1; i < 100; ++i) {
+    auto instance = box->createInstance("box" + std::to_string(i));
+    instance->setPosition(Vector3(static_cast<float>(i % 10) - 5.f, 0.f,
+                                  static_cast<float>(i / 10) - 5.f));
+    instances.emplace_back(instance);
+  }
+
+  auto gl               = canvas.recordingContext();
+  const auto& stats     = gl->statistics();
+  const auto matrixSize = 16 * sizeof(float);
+  scene->render();
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawCalls, 1u);
+  EXPECT_EQ(stats.instancedDrawCalls, 1u);
+  EXPECT_EQ(stats.drawnInstances, 100u);
+
+  // Nothing moved: nothing is uploaded
+  EXPECT_EQ(stats.uploadedBytes, 0u);
+
+  // Only the moved instances are uploaded
+  instances[10]->setPosition(Vector3(0.f, 1.f, 0.f));
+  instances[11]->setPosition(Vector3(0.f, 2.f, 0.f));
+  instances[50]->setPosition(Vector3(0.f, 3.f, 0.f));
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.uploadedBytes, 3 * matrixSize);
+  EXPECT_EQ(stats.bufferUploads, 2u);
+
+  // More instances than the capacity: the buffer grows once, then nothing is
+  // uploaded anymore
+  for (unsigned int i = 100; i < 200; ++i) {
+    auto instance = box->createInstance("box" + std::to_string(i));
+    instance->setPosition(Vector3(static_cast<float>(i % 10) - 5.f, 1.f,
+                                  static_cast<float>(i / 10) - 5.f));
+  }
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawnInstances, 200u);
+  EXPECT_GT(stats.uploadedBytes, 0u);
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawnInstances, 200u);
+  EXPECT_EQ(stats.uploadedBytes, 0u);
+
+  // A hidden instance shifts the next ones to the previous slots
+  instances[97]->isVisible = false;
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawnInstances, 199u);
+  EXPECT_GT(stats.uploadedBytes, 0u);
+  EXPECT_LT(stats.uploadedBytes, 199 * matrixSize);
+}
@@ -0,0 +1,299 @@
+#include <gtest/gtest.h>
+
+#include <babylon/cameras/free_camera.h>
+#include <babylon/core/task_scheduler.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/lights/hemispheric_light.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/mesh_optimizer.h>
+#include <babylon/mesh/sub_mesh.h>
+#include <babylon/mesh/vertex_buffer.h>
+
+namespace {
+
+// Splits a mesh in one vertex per index, the triangles being shuffled, as
+// exported by some tools
+void unweld(BABYLON::Mesh* mesh)
+{
+  using namespace BABYLON;
+
+  const auto indices     = mesh->getIndices();
+  const auto vertexCount = mesh->getTotalVertices();
+  std::vector<std::size_t> triangles(indices.size() / 3);
+  std::iota(triangles.begin(), triangles.end(), 0);
+  std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+
+  const auto kinds = {VertexBuffer::PositionKind, VertexBuffer::NormalKind,
+                      VertexBuffer::UVKind};
+  for (auto kind : kinds) {
+    const auto data = mesh->getVerticesData(kind);
+    const auto size = data.size() / vertexCount;
+    Float32Array unwelded;
+    for (auto triangle : triangles) {
+      for (std::size_t corner = 0; corner < 3; ++corner) {
+        const auto vertex = indices[triangle * 3 + corner];
+        const auto first  = data.begin() + vertex * size;
+        unwelded.insert(unwelded.end(), first, first + size);
+      }
+    }
+    mesh->setVerticesData(kind, unwelded);
+  }
+
+  IndicesArray unweldedIndices(indices.size());
+  std::iota(unweldedIndices.begin(), unweldedIndices.end(), 0u);
+  mesh->setIndices(unweldedIndices, unweldedIndices.size());
+}
+
+// Sorted positions of the corners of each triangle, which the optimization
+// must preserve
+std::vector<std::vector<float>> triangles(BABYLON::Mesh* mesh)
+{
+  using namespace BABYLON;
+
+  const auto indices   = mesh->getIndices();
+  const auto positions = mesh->getVerticesData(VertexBuffer::PositionKind);
+  std::vector<std::vector<float>> result;
+  for (std::size_t i = 0; i < indices.size(); i += 3) {
+    std::vector<std::vector<float>> corners;
+    for (std::size_t corner = 0; corner < 3; ++corner) {
+      const auto first = positions.begin() + indices[i + corner] * 3;
+      corners.emplace_back(first, first + 3);
+    }
+    std::sort(corners.begin(), corners.end());
+    std::vector<float> triangle;
+    for (const auto& corner : corners) {
+      triangle.insert(triangle.end(), corner.begin(), corner.end());
+    }
+    result.emplace_back(triangle);
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+} // end of anonymous namespace
+
+TEST(TestMeshOptimizer, AnalyzeVertexCache)
+{
+  using namespace BABYLON;
+
+  // Two triangles sharing an edge: 4 vertices transformed once
+  auto statistics
+    = MeshOptimizer::AnalyzeVertexCache({0, 1, 2, 2, 1, 3}, 4, 16);
+  EXPECT_EQ(statistics.triangles, 2u);
+  EXPECT_EQ(statistics.vertices, 4u);
+  EXPECT_EQ(statistics.transformedVertices, 4u);
+  EXPECT_FLOAT_EQ(statistics.acmr, 2.f);
+  EXPECT_FLOAT_EQ(statistics.atvr, 1.f);
+
+  // A cache of 3 vertices evicts the first vertex before it is reused
+  statistics
+    = MeshOptimizer::AnalyzeVertexCache({0, 1, 2, 1, 2, 3, 0, 2, 3}, 4, 3);
+  EXPECT_EQ(statistics.transformedVertices, 5u);
+  EXPECT_FLOAT_EQ(statistics.atvr, 1.25f);
+}
+
+TEST(TestMeshOptimizer, OptimizeVertexCache)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto ground = Mesh::CreateGround("ground", 10, 10, 32, scene.get());
+
+  // Shuffled triangles
+  auto indices = ground->getIndices();
+  std::vector<std::size_t> order(indices.size() / 3);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+  IndicesArray shuffled;
+  for (auto triangle : order) {
+    shuffled.insert(shuffled.end(), indices.begin() + triangle * 3,
+                    indices.begin() + triangle * 3 + 3);
+  }
+
+  const auto vertexCount = ground->getTotalVertices();
+  const auto before
+    = MeshOptimizer::AnalyzeVertexCache(shuffled, vertexCount, 16);
+  const auto clusters
+    = MeshOptimizer::OptimizeVertexCache(shuffled, vertexCount, 16);
+  const auto after
+    = MeshOptimizer::AnalyzeVertexCache(shuffled, vertexCount, 16);
+  EXPECT_EQ(shuffled.size(), indices.size());
+  EXPECT_FALSE(clusters.empty());
+  EXPECT_GT(before.acmr, 2.f);
+  EXPECT_LT(after.acmr, 0.8f);
+  EXPECT_LT(after.atvr, 1.5f);
+}
+
+TEST(TestMeshOptimizer, WeldsAndReordersVertices)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto ground = Mesh::CreateGround("ground", 10, 10, 16, scene.get());
+  const auto vertexCount = ground->getTotalVertices();
+  const auto indexCount  = ground->getTotalIndices();
+  unweld(ground);
+  const auto expected = triangles(ground);
+  EXPECT_EQ(ground->getTotalVertices(), indexCount);
+
+  const auto report = MeshOptimizer::Optimize(ground);
+  EXPECT_TRUE(report.applied);
+  EXPECT_TRUE(report.verticesOptimized);
+  EXPECT_EQ(report.verticesBefore, indexCount);
+  EXPECT_EQ(report.verticesAfter, vertexCount);
+  EXPECT_FLOAT_EQ(report.before.acmr, 3.f);
+  EXPECT_LT(report.after.acmr, 1.f);
+  EXPECT_GE(report.clusters, 1u);
+
+  EXPECT_EQ(ground->getTotalVertices(), vertexCount);
+  EXPECT_EQ(ground->getTotalIndices(), indexCount);
+  EXPECT_EQ(ground->getVerticesData(VertexBuffer::NormalKind).size(),
+            vertexCount * 3);
+  EXPECT_EQ(triangles(ground), expected);
+
+  // The vertices are in their order of first use
+  const auto indices = ground->getIndices();
+  uint32_t next      = 0;
+  for (auto index : indices) {
+    EXPECT_LE(index, next);
+    next = std::max(next, index + 1);
+  }
+}
+
+TEST(TestMeshOptimizer, KeepsSubMeshes)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto sphere = Mesh::CreateSphere("sphere", 16, 2.f, scene.get());
+  sphere->subdivide(3);
+  ASSERT_EQ(sphere->subMeshes.size(), 3u);
+  std::vector<std::pair<unsigned int, std::size_t>> indexRanges;
+  for (const auto& subMesh : sphere->subMeshes) {
+    indexRanges.emplace_back(subMesh->indexStart, subMesh->indexCount);
+  }
+  const auto expected = triangles(sphere);
+
+  bool called = false;
+  sphere->optimizeIndices([&called, &sphere](Mesh* mesh) {
+    called = true;
+    EXPECT_EQ(mesh, sphere);
+  });
+  EXPECT_TRUE(called);
+
+  ASSERT_EQ(sphere->subMeshes.size(), 3u);
+  const auto indices = sphere->getIndices();
+  for (std::size_t s = 0; s < indexRanges.size(); ++s) {
+    const auto& subMesh = sphere->subMeshes[s];
+    EXPECT_EQ(subMesh->indexStart, indexRanges[s].first);
+    EXPECT_EQ(subMesh->indexCount, indexRanges[s].second);
+    for (auto i = subMesh->indexStart;
+         i < subMesh->indexStart + subMesh->indexCount; ++i) {
+      EXPECT_GE(indices[i], subMesh->verticesStart);
+      EXPECT_LT(indices[i], subMesh->verticesStart + subMesh->verticesCount);
+    }
+  }
+  EXPECT_EQ(triangles(sphere), expected);
+}
+
+TEST(TestMeshOptimizer, OptimizeAsync)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto camera
+    = FreeCamera::New("camera", Vector3(0.f, 5.f, -10.f), scene.get());
+  camera->setTarget(Vector3::Zero());
+  HemisphericLight::New("light", Vector3(0.f, 1.f, 0.f), scene.get());
+  auto ground = Mesh::CreateGround("ground", 10, 10, 16, scene.get());
+  auto box    = Mesh::CreateBox("box", 1.f, scene.get());
+  unweld(ground);
+  unweld(box);
+
+  MeshOptimizer optimizer(scene.get());
+  std::vector<std::pair<Mesh*, MeshOptimizationReport>> results;
+  const auto callback = [&results](Mesh* mesh,
+                                   const MeshOptimizationReport& report) {
+    results.emplace_back(mesh, report);
+  };
+  optimizer.optimizeAsync(ground, MeshOptimizationOptions(), callback);
+  optimizer.optimizeAsync(box, MeshOptimizationOptions(), callback);
+
+  // A mesh whose geometry changed in the meantime is left as is
+  const auto boxVertices = box->getTotalVertices() / 2;
+  box->setIndices(IndicesArray{0, 1, 2}, boxVertices);
+
+  optimizer.wait();
+  EXPECT_EQ(optimizer.getPendingCount(), 0u);
+  ASSERT_EQ(results.size(), 2u);
+  EXPECT_EQ(results[0].first, ground);
+  EXPECT_TRUE(results[0].second.applied);
+  EXPECT_EQ(ground->getTotalVertices(), 17u * 17u);
+  EXPECT_EQ(results[1].first, box);
+  EXPECT_FALSE(results[1].second.applied);
+  EXPECT_EQ(box->getTotalIndices(), 3u);
+
+  // The results are also applied before rendering
+  auto sphere = Mesh::CreateSphere("sphere", 8, 2.f, scene.get());
+  unweld(sphere);
+  const auto vertexCount = sphere->getTotalVertices();
+  optimizer.optimizeAsync(sphere);
+  while (optimizer.getPendingCount() > 0) {
+    scene->render();
+  }
+  EXPECT_LT(sphere->getTotalVertices(), vertexCount);
+}
+
+TEST(TestMeshOptimizer, AppliesCompletedOptimizations)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto ground = Mesh::CreateGround("ground", 10, 10, 16, scene.get());
+  unweld(ground);
+  const auto vertexCount = ground->getTotalVertices();
+
+  // The only worker of the scheduler is busy
+  TaskScheduler scheduler(1);
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+  scheduler.submit([&]() {
+    started = true;
+    while (!release) {
+      std::this_thread::yield();
+    }
+  });
+  while (!started) {
+    std::this_thread::yield();
+  }
+
+  // The frames do not wait for the optimizations still running
+  MeshOptimizer optimizer(scene.get(), scheduler);
+  bool applied = false;
+  optimizer.optimizeAsync(ground, MeshOptimizationOptions(),
+                          [&applied](Mesh*, const MeshOptimizationReport&) {
+                            applied = true;
+                          });
+  scene->onBeforeRenderObservable.notifyObservers(scene.get());
+  EXPECT_EQ(optimizer.getPendingCount(), 1u);
+  EXPECT_FALSE(applied);
+  EXPECT_EQ(ground->getTotalVertices(), vertexCount);
+
+  release = true;
+  optimizer.wait();
+  EXPECT_EQ(optimizer.getPendingCount(), 0u);
+  EXPECT_TRUE(applied);
+  EXPECT_LT(ground->getTotalVertices(), vertexCount);
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <babylon/cameras/free_camera.h>
+#include <babylon/culling/bounding_box.h>
+#include <babylon/culling/bounding_info.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/simplification/isimplification_settings.h>
+#include <babylon/mesh/simplification/quadratic_error_simplification.h>
+#include <babylon/mesh/simplification/simplification_queue.h>
+#include <babylon/mesh/sub_mesh.h>
+#include <babylon/mesh/vertex_buffer.h>
+
+TEST(TestQuadraticErrorSimplification, Decimate)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto sphere = Mesh::CreateSphere("sphere", 32, 2.f, scene.get());
+  const auto triangleCount = sphere->getTotalIndices() / 3;
+
+  QuadraticErrorSimplification simplifier(sphere);
+  EXPECT_EQ(simplifier.getTriangleCount(), triangleCount);
+  const auto decimated = simplifier.decimate({0.5f, 10.f, true});
+  const auto remaining = decimated.indices.size() / 3;
+  EXPECT_LE(remaining, triangleCount / 2);
+  EXPECT_GE(remaining, triangleCount / 4);
+
+  // Every stream is kept, with the same number of vertices
+  ASSERT_EQ(decimated.streams.size(), sphere->getVerticesDataKinds().size());
+  EXPECT_EQ(decimated.streams.front().kind, VertexBuffer::PositionKind);
+  const auto vertexCount = decimated.streams.front().data.size() / 3;
+  for (const auto& stream : decimated.streams) {
+    EXPECT_EQ(stream.data.size(), vertexCount * stream.size);
+  }
+  for (auto index : decimated.indices) {
+    EXPECT_LT(index, vertexCount);
+  }
+
+  // The simplified mesh keeps the shape of the sphere
+  auto simplified = simplifier.reconstructMesh(decimated);
+  EXPECT_EQ(simplified->getTotalIndices(), decimated.indices.size());
+  EXPECT_EQ(simplified->getTotalVertices(), vertexCount);
+  const auto& expected = sphere->getBoundingInfo()->boundingBox;
+  const auto& actual   = simplified->getBoundingInfo()->boundingBox;
+  EXPECT_NEAR(actual.maximum.x, expected.maximum.x, 0.1f);
+  EXPECT_NEAR(actual.minimum.y, expected.minimum.y, 0.1f);
+  EXPECT_NEAR(actual.maximum.z, expected.maximum.z, 0.1f);
+}
+
+TEST(TestQuadraticErrorSimplification, DecimateThinTriangles)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  // Rings of 256 vertices far apart compared to their vertices
+  auto knot = Mesh::CreateTorusKnot("knot", 2.f, 0.5f, 64, 256, 2.f, 3.f,
+                                    scene.get());
+  const auto triangleCount = knot->getTotalIndices() / 3;
+
+  QuadraticErrorSimplification simplifier(knot);
+  for (auto quality : {0.5f, 0.1f}) {
+    const auto decimated = simplifier.decimate({quality, 10.f, true});
+    EXPECT_LE(decimated.indices.size() / 3,
+              static_cast<std::size_t>(triangleCount * quality));
+  }
+}
+
+TEST(TestQuadraticErrorSimplification, KeepsSubMeshes)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto sphere = Mesh::CreateSphere("sphere", 32, 2.f, scene.get());
+  sphere->subdivide(3);
+  ASSERT_EQ(sphere->subMeshes.size(), 3u);
+
+  QuadraticErrorSimplification simplifier(sphere);
+  auto simplified = simplifier.reconstructMesh(
+    simplifier.decimate({0.25f, 10.f, true}));
+  ASSERT_EQ(simplified->subMeshes.size(), 3u);
+  const auto indices = simplified->getIndices();
+  std::size_t indexStart = 0;
+  for (const auto& subMesh : simplified->subMeshes) {
+    EXPECT_EQ(subMesh->indexStart, indexStart);
+    EXPECT_GT(subMesh->indexCount, 0u);
+    indexStart += subMesh->indexCount;
+    for (auto i = subMesh->indexStart;
+         i < subMesh->indexStart + subMesh->indexCount; ++i) {
+      EXPECT_GE(indices[i], subMesh->verticesStart);
+      EXPECT_LT(indices[i], subMesh->verticesStart + subMesh->verticesCount);
+    }
+  }
+  EXPECT_EQ(indexStart, indices.size());
+}
+
+TEST(TestQuadraticErrorSimplification, Simplify)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto sphere = Mesh::CreateSphere("sphere", 32, 2.f, scene.get());
+  auto knot   = Mesh::CreateTorusKnot("knot", 2.f, 0.5f, 64, 16, 2.f, 3.f,
+                                    scene.get());
+
+  std::vector<Mesh*> simplified;
+  const auto callback = [&simplified](Mesh* mesh) {
+    simplified.emplace_back(mesh);
+  };
+  sphere->simplify({{0.5f, 10.f, true}, {0.2f, 30.f, true}}, true,
+                   SimplificationType::QUADRATIC, callback);
+  knot->simplify({{0.5f, 10.f, true}, {0.2f, 30.f, true}}, false,
+                 SimplificationType::QUADRATIC, callback);
+  EXPECT_EQ(scene->simplificationQueue->getPendingCount(), 2u);
+
+  scene->simplificationQueue->wait();
+  EXPECT_EQ(scene->simplificationQueue->getPendingCount(), 0u);
+  EXPECT_FALSE(scene->simplificationQueue->running);
+  ASSERT_EQ(simplified.size(), 2u);
+  EXPECT_EQ(simplified[0], sphere);
+  EXPECT_EQ(simplified[1], knot);
+
+  for (auto mesh : {sphere, knot}) {
+    EXPECT_TRUE(mesh->hasLODLevels());
+    auto near = mesh->getLODLevelAtDistance(10.f);
+    auto far  = mesh->getLODLevelAtDistance(30.f);
+    ASSERT_NE(near, nullptr);
+    ASSERT_NE(far, nullptr);
+    EXPECT_TRUE(near->isBlocked());
+    EXPECT_LT(far->getTotalIndices(), near->getTotalIndices());
+    EXPECT_LT(near->getTotalIndices(), mesh->getTotalIndices());
+  }
+}
+
+TEST(TestQuadraticErrorSimplification, SimplifyDisposedMesh)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto sphere = Mesh::CreateSphere("sphere", 32, 2.f, scene.get());
+  auto knot   = Mesh::CreateTorusKnot("knot", 2.f, 0.5f, 64, 16, 2.f, 3.f,
+                                    scene.get());
+
+  std::vector<Mesh*> simplified;
+  const auto callback = [&simplified](Mesh* mesh) {
+    simplified.emplace_back(mesh);
+  };
+  sphere->simplify({{0.5f, 10.f, true}}, true, SimplificationType::QUADRATIC,
+                   callback);
+  knot->simplify({{0.5f, 10.f, true}}, true, SimplificationType::QUADRATIC,
+                 callback);
+  // The meshes are destroyed at the next frame, before the queue is executed
+  sphere->dispose();
+  scene->render();
+
+  scene->simplificationQueue->wait();
+  EXPECT_EQ(scene->simplificationQueue->getPendingCount(), 0u);
+  ASSERT_EQ(simplified.size(), 1u);
+  EXPECT_EQ(simplified[0], knot);
+  EXPECT_TRUE(knot->hasLODLevels());
+}
+
+TEST(TestQuadraticErrorSimplification, GetLOD)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto sphere = Mesh::CreateSphere("sphere", 32, 2.f, scene.get());
+  sphere->simplify({{0.2f, 30.f, true}, {0.5f, 10.f, true}});
+  scene->simplificationQueue->wait();
+  auto near = sphere->getLODLevelAtDistance(10.f);
+  auto far  = sphere->getLODLevelAtDistance(30.f);
+  ASSERT_NE(near, nullptr);
+  ASSERT_NE(far, nullptr);
+
+  sphere->computeWorldMatrix(true);
+  const auto lodAt = [&scene, &sphere](float distance) {
+    auto camera = FreeCamera::New("camera", Vector3(0.f, 0.f, -distance),
+                                  scene.get());
+    camera->getViewMatrix(true);
+    return sphere->getLOD(camera);
+  };
+  EXPECT_EQ(lodAt(5.f), sphere);
+  EXPECT_EQ(lodAt(20.f), near);
+  EXPECT_EQ(lodAt(40.f), far);
+
+  sphere->removeLODLevel(far);
+  EXPECT_FALSE(far->isBlocked());
+  EXPECT_EQ(lodAt(40.f), near);
+}
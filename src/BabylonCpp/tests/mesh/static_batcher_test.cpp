@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <babylon/cameras/free_camera.h>
+#include <babylon/culling/bounding_box.h>
+#include <babylon/culling/bounding_info.h>
+#include <babylon/culling/ray.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/recording_gl_rendering_context.h>
+#include <babylon/engine/scene.h>
+#include <babylon/lights/hemispheric_light.h>
+#include <babylon/materials/standard_material.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/static_batcher.h>
+
+TEST(TestStaticBatcher, BatchesStaticMeshes)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto camera
+    = FreeCamera::New("camera", Vector3(0.f, 20.f, -20.f), scene.get());
+  camera->setTarget(Vector3::Zero());
+  HemisphericLight::New("light", Vector3(0.f, 1.f, 0.f), scene.get());
+
+  // 16 static boxes with 2 materials, and a box which can move
+  auto red  = StandardMaterial::New("red", scene.get());
+  auto blue = StandardMaterial::New("blue", scene.get());
+  std::vector<Mesh*> boxes;
+  for (unsigned int i = 0; i < 16; ++i) {
+    auto box = Mesh::CreateBox("box" + std::to_string(i), 1.f, scene.get());
+    box->setPosition(Vector3(static_cast<float>(i % 4) * 2.f + 1.f, 0.f,
+                             static_cast<float>(i / 4) * 2.f + 1.f));
+    box->setMaterial(i % 2 == 0 ? red : blue);
+    box->freezeWorldMatrix();
+    boxes.emplace_back(box);
+  }
+  auto dynamicBox = Mesh::CreateBox("dynamicBox", 1.f, scene.get());
+  dynamicBox->setPosition(Vector3(9.f, 0.f, 9.f));
+  dynamicBox->setMaterial(red);
+
+  auto gl           = canvas.recordingContext();
+  const auto& stats = gl->statistics();
+  scene->render();
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawCalls, 17u);
+
+  // The frozen boxes are merged per material
+  auto batcher = scene->enableStaticBatching(100.f);
+  EXPECT_EQ(batcher->getMeshCount(), 16u);
+  scene->render();
+  EXPECT_EQ(batcher->getBatchCount(), 2u);
+  EXPECT_EQ(batcher->getRebuiltCount(), 2u);
+  EXPECT_TRUE(boxes[0]->_isStaticBatched);
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(batcher->getRebuiltCount(), 0u);
+  EXPECT_EQ(stats.drawCalls, 3u);
+
+  // The members keep their bounding info for picking
+  const Ray ray(Vector3(1.f, 10.f, 1.f), Vector3(0.f, -1.f, 0.f), 100.f);
+  const auto intersects = [&ray](Mesh* mesh) {
+    const auto& boundingBox = mesh->getBoundingInfo()->boundingBox;
+    return ray.intersectsBoxMinMax(boundingBox.minimumWorld,
+                                   boundingBox.maximumWorld);
+  };
+  EXPECT_TRUE(boxes[0]->isPickable);
+  EXPECT_TRUE(intersects(boxes[0]));
+  EXPECT_FALSE(intersects(boxes[1]));
+
+  // Added to a batch, then moved: its vertices are updated in place
+  EXPECT_TRUE(batcher->addMesh(dynamicBox));
+  EXPECT_FALSE(batcher->addMesh(dynamicBox));
+  scene->render();
+  EXPECT_EQ(batcher->getRebuiltCount(), 1u);
+  dynamicBox->setPosition(Vector3(9.f, 2.f, 9.f));
+  scene->render();
+  EXPECT_EQ(batcher->getRebuiltCount(), 0u);
+  EXPECT_EQ(batcher->getUpdatedCount(), 1u);
+
+  // Hidden members are removed from the geometry of their batch, members
+  // whose material changed move to another batch
+  boxes[2]->isVisible = false;
+  boxes[4]->setMaterial(blue);
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(batcher->getRebuiltCount(), 2u);
+  EXPECT_EQ(stats.drawCalls, 2u);
+
+  // Members whose rendering settings changed move to another batch too
+  boxes[8]->renderingGroupId = 1;
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(batcher->getBatchCount(), 3u);
+  EXPECT_EQ(batcher->getRebuiltCount(), 2u);
+  EXPECT_EQ(stats.drawCalls, 3u);
+
+  // Disposed members are removed
+  boxes[6]->dispose();
+  EXPECT_EQ(batcher->getMeshCount(), 16u);
+  scene->render();
+  EXPECT_EQ(batcher->getRebuiltCount(), 1u);
+
+  // The meshes are rendered on their own again
+  scene->disableStaticBatching();
+  EXPECT_EQ(scene->getStaticBatcher(), nullptr);
+  EXPECT_FALSE(boxes[0]->_isStaticBatched);
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawCalls, 15u);
+}
+
+TEST(TestStaticBatcher, BatchesWithSelectionOctree)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto camera
+    = FreeCamera::New("camera", Vector3(0.f, 20.f, -20.f), scene.get());
+  camera->setTarget(Vector3::Zero());
+  HemisphericLight::New("light", Vector3(0.f, 1.f, 0.f), scene.get());
+
+  auto red  = StandardMaterial::New("red", scene.get());
+  auto blue = StandardMaterial::New("blue", scene.get());
+  std::vector<Mesh*> boxes;
+  for (unsigned int i = 0; i < 16; ++i) {
+    auto box = Mesh::CreateBox("box" + std::to_string(i), 1.f, scene.get());
+    box->setPosition(Vector3(static_cast<float>(i % 4) * 2.f + 1.f, 0.f,
+                             static_cast<float>(i / 4) * 2.f + 1.f));
+    box->setMaterial(i % 2 == 0 ? red : blue);
+    box->freezeWorldMatrix();
+    boxes.emplace_back(box);
+  }
+
+  // The octree selects the members, which are skipped, and the batches
+  scene->createOrUpdateSelectionOctree();
+  auto batcher      = scene->enableStaticBatching(100.f);
+  auto gl           = canvas.recordingContext();
+  const auto& stats = gl->statistics();
+  scene->render();
+  EXPECT_EQ(batcher->getBatchCount(), 2u);
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawCalls, 2u);
+
+  // Still selected once when the octree is updated with the batches
+  scene->createOrUpdateSelectionOctree();
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawCalls, 2u);
+
+  // A new batch is added to the octree
+  boxes[0]->setMaterial(StandardMaterial::New("green", scene.get()));
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(batcher->getBatchCount(), 3u);
+  EXPECT_EQ(stats.drawCalls, 3u);
+
+  // The meshes are rendered on their own again
+  scene->disableStaticBatching();
+  scene->createOrUpdateSelectionOctree();
+  gl->resetStatistics();
+  scene->render();
+  EXPECT_EQ(stats.drawCalls, 16u);
+}
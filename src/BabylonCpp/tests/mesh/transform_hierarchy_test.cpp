@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/scene.h>
+#include <babylon/math/matrix.h>
+#include <babylon/mesh/mesh.h>
+#include <babylon/mesh/transform_hierarchy.h>
+
+TEST(TestTransformHierarchy, Update)
+{
+  using namespace BABYLON;
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  // Created children first, the hierarchy sorts them after their parents
+  auto grandChild = Mesh::New("grandChild", scene.get());
+  auto child      = Mesh::New("child", scene.get());
+  auto root       = Mesh::New("root", scene.get());
+  Mesh::New("other", scene.get());
+  grandChild->setParent(child);
+  child->setParent(root);
+  root->position().copyFromFloats(1.f, 2.f, 3.f);
+  root->scaling().copyFromFloats(2.f, 2.f, 2.f);
+  child->position().copyFromFloats(1.f, 0.f, 0.f);
+  child->rotation().copyFromFloats(0.f, 1.f, 0.f);
+  grandChild->position().copyFromFloats(0.f, 1.f, 2.f);
+  grandChild->rotation().copyFromFloats(0.5f, 0.f, 0.25f);
+
+  TransformHierarchy hierarchy(scene.get());
+  scene->incrementRenderId();
+  hierarchy.update();
+  EXPECT_EQ(hierarchy.size(), 4);
+  EXPECT_EQ(hierarchy.updatedCount(), 4);
+
+  // Static meshes are not computed again
+  const auto updateCount = grandChild->worldMatrixUpdateCount();
+  scene->incrementRenderId();
+  hierarchy.update();
+  EXPECT_EQ(hierarchy.updatedCount(), 0);
+  EXPECT_EQ(grandChild->worldMatrixUpdateCount(), updateCount);
+
+  // The changes of a parent are propagated to its descendants only
+  root->position().x = 4.f;
+  scene->incrementRenderId();
+  hierarchy.update();
+  EXPECT_EQ(hierarchy.updatedCount(), 3);
+  EXPECT_EQ(grandChild->worldMatrixUpdateCount(), updateCount + 1);
+
+  grandChild->position().z = 1.f;
+  scene->incrementRenderId();
+  hierarchy.update();
+  EXPECT_EQ(hierarchy.updatedCount(), 1);
+
+  // Same world matrices as AbstractMesh::computeWorldMatrix()
+  std::vector<Matrix> worldMatrices;
+  for (auto mesh : {root, child, grandChild}) {
+    worldMatrices.emplace_back(*mesh->getWorldMatrix());
+  }
+  std::size_t index = 0;
+  for (auto mesh : {root, child, grandChild}) {
+    const auto expected = mesh->computeWorldMatrix(true);
+    const auto& actual  = worldMatrices[index++];
+    for (unsigned int i = 0; i < 16; ++i) {
+      EXPECT_NEAR(actual.m[i], expected.m[i], 1e-5f);
+    }
+  }
+
+  // Reparented meshes are sorted again
+  child->setParent(nullptr);
+  root->setParent(grandChild);
+  for (unsigned int i = 0; i < 3; ++i) {
+    scene->incrementRenderId();
+    hierarchy.update();
+  }
+  EXPECT_EQ(hierarchy.updatedCount(), 0);
+  const Matrix world  = *root->getWorldMatrix();
+  const auto expected = root->computeWorldMatrix(true);
+  for (unsigned int i = 0; i < 16; ++i) {
+    EXPECT_NEAR(world.m[i], expected.m[i], 1e-5f);
+  }
+}
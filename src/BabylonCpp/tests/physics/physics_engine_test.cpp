@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <babylon/math/quaternion.h>
+#include <babylon/math/vector3.h>
+#include <babylon/physics/iphysics_engine_plugin.h>
+#include <babylon/physics/physics_engine.h>
+
+namespace {
+
+using namespace BABYLON;
+
+// A plugin recording the steps it is asked to run
+struct StepCountingPlugin : public IPhysicsEnginePlugin {
+  std::vector<float> steps;
+
+  void setGravity(const Vector3& /*gravity*/) override
+  {
+  }
+  void setTimeStep(float /*timeStep*/) override
+  {
+  }
+  void executeStep(
+    float delta,
+    const std::vector<std::unique_ptr<PhysicsImpostor>>& /*impostors*/) override
+  {
+    steps.emplace_back(delta);
+  }
+  void applyImpulse(PhysicsImpostor*, const Vector3&, const Vector3&) override
+  {
+  }
+  void applyForce(PhysicsImpostor*, const Vector3&, const Vector3&) override
+  {
+  }
+  void generatePhysicsBody(PhysicsImpostor*) override
+  {
+  }
+  void removePhysicsBody(PhysicsImpostor*) override
+  {
+  }
+  void generateJoint(PhysicsImpostorJoint*) override
+  {
+  }
+  void removeJoint(PhysicsImpostorJoint*) override
+  {
+  }
+  bool isSupported() override
+  {
+    return true;
+  }
+  void setTransformationFromPhysicsBody(PhysicsImpostor*) override
+  {
+  }
+  void setPhysicsBodyTransformation(PhysicsImpostor*, const Vector3&,
+                                    const Quaternion&) override
+  {
+  }
+  void setLinearVelocity(PhysicsImpostor*, const Vector3&) override
+  {
+  }
+  void setAngularVelocity(PhysicsImpostor*, const Vector3&) override
+  {
+  }
+  Vector3 getLinearVelocity(PhysicsImpostor*) override
+  {
+    return Vector3::Zero();
+  }
+  Vector3 getAngularVelocity(PhysicsImpostor*) override
+  {
+    return Vector3::Zero();
+  }
+  void setBodyMass(PhysicsImpostor*, float) override
+  {
+  }
+  void sleepBody(PhysicsImpostor*) override
+  {
+  }
+  void wakeUpBody(PhysicsImpostor*) override
+  {
+  }
+  void updateDistanceJoint(DistanceJoint*, float, float) override
+  {
+  }
+  void setMotor(IMotorEnabledJoint*, float, float, unsigned int) override
+  {
+  }
+  void setLimit(IMotorEnabledJoint*, float, float, unsigned int) override
+  {
+  }
+  void dispose() override
+  {
+  }
+};
+
+// A power of two, so that the accumulated time is exact
+const float timeStep = 1.f / 64.f;
+
+} // end of anonymous namespace
+
+TEST(TestPhysicsEngine, FixedTimeStep)
+{
+  StepCountingPlugin plugin;
+  PhysicsEngine engine(Vector3(0.f, -9.807f, 0.f), &plugin);
+  engine.setTimeStep(timeStep);
+
+  // Two frames per step
+  engine._step(timeStep / 2.f);
+  EXPECT_TRUE(plugin.steps.empty());
+  EXPECT_FLOAT_EQ(engine.getInterpolationAlpha(), 0.5f);
+  engine._step(timeStep / 2.f);
+  EXPECT_EQ(plugin.steps, std::vector<float>({timeStep}));
+  EXPECT_FLOAT_EQ(engine.getInterpolationAlpha(), 0.f);
+
+  // Two and a half steps per frame
+  plugin.steps.clear();
+  engine._step(timeStep * 2.5f);
+  EXPECT_EQ(plugin.steps.size(), 2u);
+  EXPECT_FLOAT_EQ(engine.getInterpolationAlpha(), 0.5f);
+  engine._step(timeStep * 2.5f);
+  EXPECT_EQ(plugin.steps.size(), 5u);
+  EXPECT_FLOAT_EQ(engine.getInterpolationAlpha(), 0.f);
+}
+
+TEST(TestPhysicsEngine, MaxSubSteps)
+{
+  StepCountingPlugin plugin;
+  PhysicsEngine engine(Vector3(0.f, -9.807f, 0.f), &plugin);
+  engine.setTimeStep(timeStep);
+  EXPECT_EQ(engine.getMaxSubSteps(), 4u);
+
+  // A slow frame runs at most the maximum number of steps, and the time it
+  // could not simulate is dropped
+  engine._step(1.f);
+  EXPECT_EQ(plugin.steps.size(), 4u);
+  EXPECT_FLOAT_EQ(engine.getInterpolationAlpha(), 0.f);
+
+  plugin.steps.clear();
+  engine.setMaxSubSteps(2);
+  engine._step(1.f);
+  EXPECT_EQ(plugin.steps.size(), 2u);
+  engine._step(timeStep);
+  EXPECT_EQ(plugin.steps.size(), 3u);
+}
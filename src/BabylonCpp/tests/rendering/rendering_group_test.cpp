@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <babylon/cameras/free_camera.h>
+#include <babylon/engine/engine.h>
+#include <babylon/engine/headless_canvas.h>
+#include <babylon/engine/recording_gl_rendering_context.h>
+#include <babylon/engine/scene.h>
+#include <babylon/lights/hemispheric_light.h>
+#include <babylon/materials/standard_material.h>
+#include <babylon/mesh/mesh.h>
+
+TEST(TestRenderingGroup, SortsOpaqueSubMeshesByState)
+{
+  using namespace BABYLON;
+
+  HeadlessCanvas canvas;
+  auto engine = Engine::New(&canvas);
+  auto scene  = Scene::New(engine.get());
+  auto camera
+    = FreeCamera::New("camera", Vector3(0.f, 20.f, -20.f), scene.get());
+  camera->setTarget(Vector3::Zero());
+  HemisphericLight::New("light", Vector3(0.f, 1.f, 0.f), scene.get());
+
+  // Lit and unlit materials, which use different effects, alternating
+  std::vector<StandardMaterial*> materials;
+  for (unsigned int i = 0; i < 4; ++i) {
+    materials.emplace_back(
+      StandardMaterial::New("material" + std::to_string(i), scene.get()));
+    materials.back()->setDisableLighting(i % 2 == 1);
+  }
+  auto box = Mesh::CreateBox("box", 1.f, scene.get());
+  box->setMaterial(materials[0]);
+  for (unsigned int i = 1; i < 64; ++i) {
+    auto clone = box->clone("box" + std::to_string(i));
+    clone->setPosition(Vector3(static_cast<float>(i % 8) * 2.f - 8.f, 0.f,
+                               static_cast<float>(i / 8) * 2.f - 8.f));
+    clone->setMaterial(materials[i % materials.size()]);
+  }
+
+  // Compiles the effects
+  scene->render();
+  scene->render();
+
+  auto gl = canvas.recordingContext();
+  gl->resetStatistics();
+  scene->render();
+  const auto& stats = gl->statistics();
+  EXPECT_EQ(stats.drawCalls, 64u);
+  // One switch between the two effects, and one from the previous frame
+  EXPECT_LE(stats.programChanges, 2u);
+}
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <oimo/collision/broadphase/broad_phase.h>
+#include <oimo/collision/broadphase/dbvt/dbvt_broad_phase.h>
+#include <oimo/collision/shape/box_shape.h>
+#include <oimo/collision/shape/shape_config.h>
+#include <oimo/dynamics/rigid_body.h>
+#include <oimo/dynamics/world.h>
+
+/**
+ * @brief Measures the bounding volume tree broad-phase for 20000 boxes moving
+ * inside a cube, a tenth of them static, with the leaves fattened by a margin
+ * only, extended along the velocity of the boxes, and with the tree rebuilt
+ * when its cost degrades.
+ *
+ * The pairs of the last step are compared with the ones of the SIMD sweep and
+ * prune broad-phase.
+ *
+ * Usage: dbvt_benchmark [steps] [bodies]
+ */
+
+namespace {
+
+using namespace OIMO;
+
+using Clock = std::chrono::high_resolution_clock;
+
+// Deterministic values in [0, 1)
+float nextRandom(unsigned int& seed)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24);
+}
+
+struct Scene {
+  std::vector<std::unique_ptr<Shape>> shapes;
+  std::vector<std::unique_ptr<RigidBody>> bodies;
+  std::unique_ptr<World> world;
+  unsigned int firstShapeId;
+  float size;
+
+  Scene(BroadPhase::Type type, unsigned int numBodies)
+      : world{make_unique<World>(1.f / 60.f, type)}, firstShapeId{0}
+  {
+    // About one box per 16 units of volume, so that each box overlaps a few
+    // others
+    size              = std::cbrt(16.f * static_cast<float>(numBodies));
+    unsigned int seed = 12345;
+    for (unsigned int i = 0; i < numBodies; ++i) {
+      const float x = size * nextRandom(seed);
+      const float y = size * nextRandom(seed);
+      const float z = size * nextRandom(seed);
+      bodies.emplace_back(make_unique<RigidBody>(x, y, z));
+      shapes.emplace_back(make_unique<BoxShape>(
+        ShapeConfig(), 0.5f + 1.5f * nextRandom(seed),
+        0.5f + 1.5f * nextRandom(seed), 0.5f + 1.5f * nextRandom(seed)));
+      auto body = bodies.back().get();
+      body->addShape(shapes.back().get());
+      const bool isStatic = i % 10 == 0;
+      body->setupMass(isStatic ? RigidBody::Type::BODY_STATIC :
+                                 RigidBody::Type::BODY_DYNAMIC);
+      world->addRigidBody(body);
+      if (!isStatic) {
+        body->linearVelocity.set(4.f * nextRandom(seed) - 2.f,
+                                 4.f * nextRandom(seed) - 2.f,
+                                 4.f * nextRandom(seed) - 2.f);
+      }
+    }
+    firstShapeId = shapes.front()->id;
+  }
+
+  ~Scene()
+  {
+    world->clear();
+  }
+
+  // Moves the boxes, bouncing on the sides of the cube
+  void move(float timeStep)
+  {
+    for (const auto& body : bodies) {
+      if (!body->isDynamic) {
+        continue;
+      }
+      auto& p            = body->position;
+      auto& v            = body->linearVelocity;
+      float* position[3] = {&p.x, &p.y, &p.z};
+      float* speed[3]    = {&v.x, &v.y, &v.z};
+      for (unsigned int axis = 0; axis < 3; ++axis) {
+        *position[axis] += *speed[axis] * timeStep;
+        if (*position[axis] < 0.f || *position[axis] > size) {
+          *speed[axis] = -*speed[axis];
+        }
+      }
+      body->syncShapes();
+    }
+  }
+
+  // The pairs as sorted shape indices
+  std::vector<std::pair<unsigned int, unsigned int>> pairs() const
+  {
+    std::vector<std::pair<unsigned int, unsigned int>> result;
+    for (const auto& pair : world->broadPhase->pairs) {
+      const unsigned int id1 = pair.shape1->id - firstShapeId;
+      const unsigned int id2 = pair.shape2->id - firstShapeId;
+      result.emplace_back(std::min(id1, id2), std::max(id1, id2));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+};
+
+struct Result {
+  double time                 = 0.0;
+  double numMovedLeaves       = 0.0;
+  unsigned int numRebuilds    = 0;
+  unsigned int numPairs       = 0;
+  std::vector<std::pair<unsigned int, unsigned int>> pairs;
+};
+
+Result run(BroadPhase::Type type, unsigned int numBodies, unsigned int steps,
+           float predictionSteps, bool rebuildEnabled)
+{
+  Scene scene(type, numBodies);
+  auto& broadPhase = *scene.world->broadPhase;
+  auto dbvt        = dynamic_cast<DBVTBroadPhase*>(&broadPhase);
+  if (dbvt != nullptr) {
+    dbvt->predictionSteps = predictionSteps;
+    dbvt->rebuildEnabled  = rebuildEnabled;
+  }
+
+  Result result;
+  std::chrono::nanoseconds time{0};
+  for (unsigned int i = 0; i < steps; ++i) {
+    scene.move(1.f / 60.f);
+    const auto start = Clock::now();
+    broadPhase.detectPairs();
+    time += Clock::now() - start;
+    if (dbvt != nullptr) {
+      result.numMovedLeaves += dbvt->numMovedLeaves;
+    }
+  }
+  result.time
+    = std::chrono::duration<double, std::milli>(time).count() / steps;
+  result.numMovedLeaves /= steps;
+  if (dbvt != nullptr) {
+    result.numRebuilds = dbvt->numRebuilds;
+  }
+  result.numPairs = broadPhase.numPairs;
+  result.pairs    = scene.pairs();
+  return result;
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  unsigned int steps     = 120;
+  unsigned int numBodies = 20000;
+  if (argc > 1) {
+    steps = std::max(1u, static_cast<unsigned int>(
+                           std::strtoul(argv[1], nullptr, 10)));
+  }
+  if (argc > 2) {
+    numBodies = std::max(2u, static_cast<unsigned int>(
+                               std::strtoul(argv[2], nullptr, 10)));
+  }
+
+  std::printf("%u bodies, %u steps, times per step\n", numBodies, steps);
+  std::printf("  %-22s %10s %12s %9s %8s %9s\n", "leaves", "ms",
+              "moved leaves", "rebuilds", "pairs", "identical");
+
+  const auto reference = run(BroadPhase::Type::BR_SIMD_SWEEP_AND_PRUNE,
+                             numBodies, steps, 0.f, false);
+  const struct {
+    const char* name;
+    float predictionSteps;
+    bool rebuildEnabled;
+  } configs[] = {
+    {"margin", 0.f, false},
+    {"velocity", 2.f, false},
+    {"velocity and rebuild", 2.f, true},
+  };
+  for (const auto& config : configs) {
+    const auto result
+      = run(BroadPhase::Type::BR_BOUNDING_VOLUME_TREE, numBodies, steps,
+            config.predictionSteps, config.rebuildEnabled);
+    std::printf("  %-22s %10.3f %12.1f %9u %8u %9s\n", config.name,
+                result.time, result.numMovedLeaves, result.numRebuilds,
+                result.numPairs,
+                result.pairs == reference.pairs ? "yes" : "NO");
+  }
+  std::printf("  %-22s %10.3f %12s %9s %8u\n", "simd sweep and prune",
+              reference.time, "", "", reference.numPairs);
+
+  return 0;
+}
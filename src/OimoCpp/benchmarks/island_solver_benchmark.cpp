@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <oimo/collision/shape/box_shape.h>
+#include <oimo/collision/shape/shape_config.h>
+#include <oimo/collision/shape/sphere_shape.h>
+#include <oimo/constraint/joint/ball_and_socket_joint.h>
+#include <oimo/constraint/joint/hinge_joint.h>
+#include <oimo/constraint/joint/joint_config.h>
+#include <oimo/dynamics/rigid_body.h>
+#include <oimo/dynamics/world.h>
+
+/**
+ * @brief Measures World::step with the contacts updated and the simulation
+ * islands solved on 1, 2, 4 and 8 threads, for a grid of stacked boxes and a
+ * grid of ragdolls falling on a static ground. Each stack and each ragdoll is
+ * an island. Sleeping is disabled so that every island is solved at every
+ * step.
+ *
+ * The final positions and orientations of the bodies are compared with the
+ * ones of the single threaded run, which they have to match bit for bit.
+ *
+ * Usage: island_solver_benchmark [steps] [gridSize]
+ */
+
+namespace {
+
+using namespace OIMO;
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct Scene {
+  std::vector<std::unique_ptr<Shape>> shapes;
+  std::vector<std::unique_ptr<RigidBody>> bodies;
+  std::vector<std::unique_ptr<Joint>> joints;
+  std::unique_ptr<World> world;
+
+  Scene()
+      : world{make_unique<World>(1.f / 60.f,
+                                 BroadPhase::Type::BR_BOUNDING_VOLUME_TREE)}
+  {
+  }
+
+  ~Scene()
+  {
+    world->clear();
+  }
+
+  RigidBody* addBody(float x, float y, float z, Shape* shape,
+                     RigidBody::Type type = RigidBody::Type::BODY_DYNAMIC)
+  {
+    bodies.emplace_back(make_unique<RigidBody>(x, y, z));
+    shapes.emplace_back(shape);
+    auto body = bodies.back().get();
+    body->addShape(shape);
+    body->setupMass(type);
+    body->allowSleep = false;
+    world->addRigidBody(body);
+    return body;
+  }
+
+  RigidBody* addBox(float x, float y, float z, float width, float height,
+                    float depth)
+  {
+    return addBody(x, y, z, new BoxShape(ShapeConfig(), width, height, depth));
+  }
+
+  void addJoint(Joint* joint)
+  {
+    joints.emplace_back(joint);
+    world->addJoint(joint);
+  }
+
+  // Joint anchored at a world point
+  JointConfig jointConfig(RigidBody* body1, RigidBody* body2, float x, float y,
+                          float z) const
+  {
+    JointConfig config;
+    config.body1 = body1;
+    config.body2 = body2;
+    config.localAnchorPoint1.set(x - body1->position.x, y - body1->position.y,
+                                 z - body1->position.z);
+    config.localAnchorPoint2.set(x - body2->position.x, y - body2->position.y,
+                                 z - body2->position.z);
+    return config;
+  }
+
+  void addGround(float size)
+  {
+    addBody(0.f, -0.5f, 0.f, new BoxShape(ShapeConfig(), size, 1.f, size),
+            RigidBody::Type::BODY_STATIC);
+  }
+};
+
+void buildStacks(Scene& scene, unsigned int gridSize)
+{
+  const unsigned int height = 8;
+  const float spacing       = 3.f;
+  const float offset        = 0.5f * spacing * static_cast<float>(gridSize - 1);
+  scene.addGround(spacing * static_cast<float>(gridSize + 2));
+  for (unsigned int i = 0; i < gridSize; ++i) {
+    for (unsigned int j = 0; j < gridSize; ++j) {
+      const float x = spacing * static_cast<float>(i) - offset;
+      const float z = spacing * static_cast<float>(j) - offset;
+      for (unsigned int k = 0; k < height; ++k) {
+        scene.addBox(x, 0.5f + 1.01f * static_cast<float>(k), z, 1.f, 1.f,
+                     1.f);
+      }
+    }
+  }
+}
+
+void buildRagdoll(Scene& scene, float x, float y, float z)
+{
+  auto pelvis = scene.addBox(x, y + 1.f, z, 0.4f, 0.2f, 0.2f);
+  auto chest  = scene.addBox(x, y + 1.36f, z, 0.4f, 0.4f, 0.2f);
+  auto head   = scene.addBody(x, y + 1.75f, z,
+                            new SphereShape(ShapeConfig(), 0.15f));
+  scene.addJoint(new BallAndSocketJoint(
+    scene.jointConfig(pelvis, chest, x, y + 1.13f, z)));
+  scene.addJoint(new BallAndSocketJoint(
+    scene.jointConfig(chest, head, x, y + 1.58f, z)));
+  for (float side : {-1.f, 1.f}) {
+    auto upperArm
+      = scene.addBox(x + side * 0.38f, y + 1.48f, z, 0.3f, 0.1f, 0.1f);
+    auto lowerArm
+      = scene.addBox(x + side * 0.7f, y + 1.48f, z, 0.3f, 0.1f, 0.1f);
+    auto upperLeg
+      = scene.addBox(x + side * 0.1f, y + 0.66f, z, 0.12f, 0.4f, 0.12f);
+    auto lowerLeg
+      = scene.addBox(x + side * 0.1f, y + 0.22f, z, 0.12f, 0.4f, 0.12f);
+    scene.addJoint(new BallAndSocketJoint(
+      scene.jointConfig(chest, upperArm, x + side * 0.215f, y + 1.48f, z)));
+    scene.addJoint(new BallAndSocketJoint(
+      scene.jointConfig(pelvis, upperLeg, x + side * 0.1f, y + 0.88f, z)));
+    auto elbow = scene.jointConfig(upperArm, lowerArm, x + side * 0.54f,
+                                   y + 1.48f, z);
+    elbow.localAxis1.set(0.f, 1.f, 0.f);
+    elbow.localAxis2.set(0.f, 1.f, 0.f);
+    scene.addJoint(new HingeJoint(elbow, 0.f, 2.5f));
+    auto knee = scene.jointConfig(upperLeg, lowerLeg, x + side * 0.1f,
+                                  y + 0.44f, z);
+    knee.localAxis1.set(1.f, 0.f, 0.f);
+    knee.localAxis2.set(1.f, 0.f, 0.f);
+    scene.addJoint(new HingeJoint(knee, 0.f, 2.5f));
+  }
+}
+
+void buildRagdolls(Scene& scene, unsigned int gridSize)
+{
+  const float spacing = 2.5f;
+  const float offset  = 0.5f * spacing * static_cast<float>(gridSize - 1);
+  scene.addGround(spacing * static_cast<float>(gridSize + 2));
+  for (unsigned int i = 0; i < gridSize; ++i) {
+    for (unsigned int j = 0; j < gridSize; ++j) {
+      // Every other ragdoll is tilted so that they do not all fall alike
+      const float tilt = ((i + j) % 2 == 0) ? 0.f : 0.3f;
+      buildRagdoll(scene, spacing * static_cast<float>(i) - offset + tilt,
+                   0.5f + tilt, spacing * static_cast<float>(j) - offset);
+    }
+  }
+}
+
+struct Result {
+  double totalTime       = 0.0;
+  double narrowPhaseTime = 0.0;
+  double solvingTime     = 0.0;
+  unsigned int numIslands = 0;
+  unsigned int numContacts = 0;
+  std::vector<float> state;
+};
+
+Result run(void (*build)(Scene&, unsigned int), unsigned int gridSize,
+           unsigned int numThreads, unsigned int steps)
+{
+  Scene scene;
+  build(scene, gridSize);
+  scene.world->setNumThreads(numThreads);
+
+  Result result;
+  std::chrono::microseconds narrowPhaseTime{0}, solvingTime{0};
+  const auto start = Clock::now();
+  for (unsigned int i = 0; i < steps; ++i) {
+    scene.world->step();
+    narrowPhaseTime += scene.world->performance.narrowPhaseTime;
+    solvingTime += scene.world->performance.solvingTime;
+  }
+  const auto end = Clock::now();
+  result.totalTime
+    = std::chrono::duration<double, std::milli>(end - start).count() / steps;
+  result.narrowPhaseTime
+    = std::chrono::duration<double, std::milli>(narrowPhaseTime).count()
+      / steps;
+  result.solvingTime
+    = std::chrono::duration<double, std::milli>(solvingTime).count() / steps;
+  result.numIslands  = scene.world->numIslands;
+  result.numContacts = scene.world->numContacts;
+  for (const auto& body : scene.bodies) {
+    for (float value :
+         {body->position.x, body->position.y, body->position.z,
+          body->orientation.x, body->orientation.y, body->orientation.z,
+          body->orientation.w}) {
+      result.state.emplace_back(value);
+    }
+  }
+  return result;
+}
+
+void report(const char* name, void (*build)(Scene&, unsigned int),
+            unsigned int gridSize, unsigned int steps)
+{
+  std::printf("\n%s, %u steps\n", name, steps);
+  std::printf("  %-8s %10s %10s %10s %8s %8s %9s %10s\n", "threads",
+              "step ms", "narrow ms", "solve ms", "speedup", "islands",
+              "contacts", "identical");
+  Result reference;
+  for (unsigned int numThreads : {1u, 2u, 4u, 8u}) {
+    auto result = run(build, gridSize, numThreads, steps);
+    if (numThreads == 1) {
+      reference = result;
+    }
+    const bool identical
+      = result.state.size() == reference.state.size()
+        && std::memcmp(result.state.data(), reference.state.data(),
+                       result.state.size() * sizeof(float))
+             == 0;
+    std::printf("  %-8u %10.3f %10.3f %10.3f %8.2f %8u %9u %10s\n",
+                numThreads, result.totalTime, result.narrowPhaseTime,
+                result.solvingTime, reference.totalTime / result.totalTime,
+                result.numIslands, result.numContacts,
+                identical ? "yes" : "NO");
+  }
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  unsigned int steps    = 300;
+  unsigned int gridSize = 10;
+  if (argc > 1) {
+    steps = std::max(1u, static_cast<unsigned int>(
+                           std::strtoul(argv[1], nullptr, 10)));
+  }
+  if (argc > 2) {
+    gridSize = std::max(1u, static_cast<unsigned int>(
+                              std::strtoul(argv[2], nullptr, 10)));
+  }
+
+  std::printf("%u hardware threads, times per step\n",
+              std::thread::hardware_concurrency());
+
+  report("Stacks of 8 boxes", buildStacks, gridSize, steps);
+  report("Ragdolls of 11 bodies", buildRagdolls, gridSize, steps);
+
+  return 0;
+}
@@ -0,0 +1,447 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <oimo/collision/broadphase/broad_phase.h>
+#include <oimo/collision/shape/box_shape.h>
+#include <oimo/collision/shape/cylinder_shape.h>
+#include <oimo/collision/shape/shape_config.h>
+#include <oimo/collision/shape/sphere_shape.h>
+#include <oimo/constraint/joint/ball_and_socket_joint.h>
+#include <oimo/constraint/joint/joint_config.h>
+#include <oimo/dynamics/rigid_body.h>
+#include <oimo/dynamics/world.h>
+
+/**
+ * @brief Runs reproducible headless scenarios with each broad-phase and
+ * reports the steps per second, the time of each phase of a step, the number
+ * of contacts and the peak memory.
+ *
+ * Scenarios:
+ * - pyramid: a pyramid of boxes resting on the ground,
+ * - sphere_rain: spheres falling into a walled pit,
+ * - joint_chains: chains of boxes linked by ball and socket joints swinging
+ *   from static anchors,
+ * - mixed_pile: boxes, spheres and cylinders falling into a walled pit,
+ * - sleeping_bodies: boxes resting apart on the ground, which fall asleep.
+ *
+ * The scenes do not depend on anything but the number of steps, so the
+ * results can be compared across releases. With --json, the results are
+ * printed as a JSON array with one object per scenario and broad-phase.
+ *
+ * Usage: physics_scenarios_benchmark [--steps N] [--json]
+ *                                    [--scenario name] [--broadphase name]
+ * with the broad-phase names brute_force, sap, simd_sap and dbvt.
+ */
+
+namespace {
+
+using namespace OIMO;
+
+using Clock = std::chrono::high_resolution_clock;
+
+struct Scene {
+  std::vector<std::unique_ptr<Shape>> shapes;
+  std::vector<std::unique_ptr<RigidBody>> bodies;
+  std::vector<std::unique_ptr<Joint>> joints;
+  std::unique_ptr<World> world;
+
+  Scene(BroadPhase::Type broadPhaseType)
+      : world{make_unique<World>(1.f / 60.f, broadPhaseType)}
+  {
+  }
+
+  ~Scene()
+  {
+    world->clear();
+  }
+
+  RigidBody* addBody(float x, float y, float z, Shape* shape,
+                     RigidBody::Type type = RigidBody::Type::BODY_DYNAMIC)
+  {
+    bodies.emplace_back(make_unique<RigidBody>(x, y, z));
+    shapes.emplace_back(shape);
+    auto body = bodies.back().get();
+    body->addShape(shape);
+    body->setupMass(type);
+    world->addRigidBody(body);
+    return body;
+  }
+
+  RigidBody* addBox(float x, float y, float z, float width, float height,
+                    float depth,
+                    RigidBody::Type type = RigidBody::Type::BODY_DYNAMIC)
+  {
+    return addBody(x, y, z, new BoxShape(ShapeConfig(), width, height, depth),
+                   type);
+  }
+
+  RigidBody* addSphere(float x, float y, float z, float radius)
+  {
+    return addBody(x, y, z, new SphereShape(ShapeConfig(), radius));
+  }
+
+  RigidBody* addCylinder(float x, float y, float z, float radius, float height)
+  {
+    return addBody(x, y, z, new CylinderShape(ShapeConfig(), radius, height));
+  }
+
+  void addGround(float size)
+  {
+    addBox(0.f, -0.5f, 0.f, size, 1.f, size, RigidBody::Type::BODY_STATIC);
+  }
+
+  // A ground surrounded by four walls
+  void addPit(float size, float height)
+  {
+    const float half = 0.5f * size;
+    addGround(size + 2.f);
+    addBox(-half - 0.5f, 0.5f * height, 0.f, 1.f, height, size,
+           RigidBody::Type::BODY_STATIC);
+    addBox(half + 0.5f, 0.5f * height, 0.f, 1.f, height, size,
+           RigidBody::Type::BODY_STATIC);
+    addBox(0.f, 0.5f * height, -half - 0.5f, size, height, 1.f,
+           RigidBody::Type::BODY_STATIC);
+    addBox(0.f, 0.5f * height, half + 0.5f, size, height, 1.f,
+           RigidBody::Type::BODY_STATIC);
+  }
+};
+
+// Deterministic offsets in [-1, 1)
+float nextRandom(unsigned int& seed)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return static_cast<float>(seed >> 8) / static_cast<float>(1 << 23) - 1.f;
+}
+
+void buildPyramid(Scene& scene)
+{
+  const unsigned int base = 14;
+  scene.addGround(40.f);
+  for (unsigned int row = 0; row < base; ++row) {
+    const unsigned int count = base - row;
+    const float offset       = -0.5f * static_cast<float>(count - 1);
+    for (unsigned int i = 0; i < count; ++i) {
+      scene.addBox(offset + static_cast<float>(i),
+                   0.5f + static_cast<float>(row), 0.f, 1.f, 1.f, 1.f);
+    }
+  }
+}
+
+void buildSphereRain(Scene& scene)
+{
+  const unsigned int side   = 8;
+  const unsigned int layers = 6;
+  unsigned int seed         = 1;
+  scene.addPit(12.f, 4.f);
+  for (unsigned int k = 0; k < layers; ++k) {
+    for (unsigned int i = 0; i < side; ++i) {
+      for (unsigned int j = 0; j < side; ++j) {
+        scene.addSphere(1.2f * (static_cast<float>(i) - 3.5f)
+                          + 0.1f * nextRandom(seed),
+                        3.f + 1.5f * static_cast<float>(k),
+                        1.2f * (static_cast<float>(j) - 3.5f)
+                          + 0.1f * nextRandom(seed),
+                        0.4f);
+      }
+    }
+  }
+}
+
+void buildJointChains(Scene& scene)
+{
+  const unsigned int numChains = 16;
+  const unsigned int numLinks  = 12;
+  scene.addGround(60.f);
+  for (unsigned int c = 0; c < numChains; ++c) {
+    const float z = 2.f * static_cast<float>(c) - 15.f;
+    auto previous = scene.addBox(0.f, 15.f, z, 0.2f, 0.2f, 0.2f,
+                                 RigidBody::Type::BODY_STATIC);
+    // The chains start horizontal and swing down
+    for (unsigned int l = 0; l < numLinks; ++l) {
+      const float x = 0.6f * static_cast<float>(l) + 0.35f;
+      auto link     = scene.addBox(x, 15.f, z, 0.5f, 0.2f, 0.2f);
+      JointConfig config;
+      config.body1 = previous;
+      config.body2 = link;
+      config.localAnchorPoint1.set(l == 0 ? 0.1f : 0.3f, 0.f, 0.f);
+      config.localAnchorPoint2.set(-0.25f, 0.f, 0.f);
+      scene.joints.emplace_back(make_unique<BallAndSocketJoint>(config));
+      scene.world->addJoint(scene.joints.back().get());
+      previous = link;
+    }
+  }
+}
+
+void buildMixedPile(Scene& scene)
+{
+  const unsigned int side   = 7;
+  const unsigned int layers = 6;
+  unsigned int seed         = 2;
+  scene.addPit(10.f, 4.f);
+  unsigned int n = 0;
+  for (unsigned int k = 0; k < layers; ++k) {
+    for (unsigned int i = 0; i < side; ++i) {
+      for (unsigned int j = 0; j < side; ++j, ++n) {
+        const float x = 1.3f * (static_cast<float>(i) - 3.f)
+                        + 0.1f * nextRandom(seed);
+        const float y = 2.f + 1.6f * static_cast<float>(k);
+        const float z = 1.3f * (static_cast<float>(j) - 3.f)
+                        + 0.1f * nextRandom(seed);
+        switch (n % 3) {
+          case 0:
+            scene.addBox(x, y, z, 0.8f, 0.8f, 0.8f);
+            break;
+          case 1:
+            scene.addSphere(x, y, z, 0.45f);
+            break;
+          default:
+            scene.addCylinder(x, y, z, 0.4f, 0.8f);
+            break;
+        }
+      }
+    }
+  }
+}
+
+void buildSleepingBodies(Scene& scene)
+{
+  const unsigned int side = 40;
+  scene.addGround(90.f);
+  for (unsigned int i = 0; i < side; ++i) {
+    for (unsigned int j = 0; j < side; ++j) {
+      scene.addBox(2.f * static_cast<float>(i) - 40.f, 0.5f,
+                   2.f * static_cast<float>(j) - 40.f, 1.f, 1.f, 1.f);
+    }
+  }
+}
+
+struct Scenario {
+  const char* name;
+  void (*build)(Scene&);
+};
+
+struct BroadPhaseKind {
+  const char* name;
+  BroadPhase::Type type;
+};
+
+struct Result {
+  unsigned int numBodies        = 0;
+  unsigned int numJoints        = 0;
+  double stepsPerSecond         = 0.0;
+  // Average times per step, in milliseconds
+  double totalTime              = 0.0;
+  double broadPhaseTime         = 0.0;
+  double narrowPhaseTime        = 0.0;
+  double manifoldUpdateTime     = 0.0;
+  double contactMergeTime       = 0.0;
+  double solvingTime            = 0.0;
+  double updateTime             = 0.0;
+  // The state of the world after the last step
+  unsigned int numContacts      = 0;
+  unsigned int numContactPoints = 0;
+  unsigned int numIslands       = 0;
+  unsigned int numSleeping      = 0;
+  // In kilobytes, 0 when unknown
+  long peakMemory               = 0;
+};
+
+// Resets the peak resident set size of the process where supported
+void resetPeakMemory()
+{
+#ifdef __linux__
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  if (clearRefs) {
+    clearRefs << "5";
+  }
+#endif
+}
+
+// The peak resident set size of the process in kilobytes, 0 when unknown
+long peakMemory()
+{
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 6, "VmHWM:") == 0) {
+      return std::strtol(line.c_str() + 6, nullptr, 10);
+    }
+  }
+#endif
+  return 0;
+}
+
+double toMilliseconds(Performance::microsecond_t time, unsigned int steps)
+{
+  return std::chrono::duration<double, std::milli>(time).count() / steps;
+}
+
+Result run(const Scenario& scenario, const BroadPhaseKind& broadPhase,
+           unsigned int steps)
+{
+  resetPeakMemory();
+
+  Scene scene(broadPhase.type);
+  scenario.build(scene);
+
+  Performance::microsecond_t broadPhaseTime{0}, narrowPhaseTime{0},
+    manifoldUpdateTime{0}, contactMergeTime{0}, solvingTime{0}, updateTime{0};
+  const auto start = Clock::now();
+  for (unsigned int i = 0; i < steps; ++i) {
+    scene.world->step();
+    const auto& performance = scene.world->performance;
+    broadPhaseTime += performance.broadPhaseTime;
+    narrowPhaseTime += performance.narrowPhaseTime;
+    manifoldUpdateTime += performance.manifoldUpdateTime;
+    contactMergeTime += performance.contactMergeTime;
+    solvingTime += performance.solvingTime;
+    updateTime += performance.updateTime;
+  }
+  const auto end = Clock::now();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+
+  Result result;
+  result.numBodies          = static_cast<unsigned int>(scene.bodies.size());
+  result.numJoints          = static_cast<unsigned int>(scene.joints.size());
+  result.stepsPerSecond     = steps / seconds;
+  result.totalTime          = 1000.0 * seconds / steps;
+  result.broadPhaseTime     = toMilliseconds(broadPhaseTime, steps);
+  result.narrowPhaseTime    = toMilliseconds(narrowPhaseTime, steps);
+  result.manifoldUpdateTime = toMilliseconds(manifoldUpdateTime, steps);
+  result.contactMergeTime   = toMilliseconds(contactMergeTime, steps);
+  result.solvingTime        = toMilliseconds(solvingTime, steps);
+  result.updateTime         = toMilliseconds(updateTime, steps);
+  result.numContacts        = scene.world->numContacts;
+  result.numContactPoints   = scene.world->numContactPoints;
+  result.numIslands         = scene.world->numIslands;
+  for (const auto& body : scene.bodies) {
+    if (body->sleeping) {
+      ++result.numSleeping;
+    }
+  }
+  result.peakMemory = peakMemory();
+  return result;
+}
+
+void printHeader()
+{
+  std::printf("%-16s %-12s %6s %9s %8s %8s %8s %8s %8s %8s %8s %8s %9s\n",
+              "scenario", "broadphase", "bodies", "steps/s", "step ms",
+              "broad ms", "narrow", "update", "merge", "solve ms", "contacts",
+              "sleeping", "peak kB");
+}
+
+void printResult(const char* scenario, const char* broadPhase,
+                 const Result& r)
+{
+  std::printf(
+    "%-16s %-12s %6u %9.1f %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %8u %8u %9ld\n",
+    scenario, broadPhase, r.numBodies, r.stepsPerSecond, r.totalTime,
+    r.broadPhaseTime, r.narrowPhaseTime, r.manifoldUpdateTime,
+    r.contactMergeTime, r.solvingTime, r.numContacts, r.numSleeping,
+    r.peakMemory);
+}
+
+void printJson(const char* scenario, const char* broadPhase,
+               unsigned int steps, const Result& r, bool first)
+{
+  std::printf(
+    "%s\n  {\"scenario\": \"%s\", \"broadphase\": \"%s\", \"steps\": %u, "
+    "\"bodies\": %u, \"joints\": %u, \"steps_per_second\": %.3f, "
+    "\"step_ms\": %.4f, \"broadphase_ms\": %.4f, \"narrowphase_ms\": %.4f, "
+    "\"manifold_update_ms\": %.4f, \"contact_merge_ms\": %.4f, "
+    "\"solving_ms\": %.4f, \"update_ms\": %.4f, \"contacts\": %u, "
+    "\"contact_points\": %u, \"islands\": %u, \"sleeping_bodies\": %u, "
+    "\"peak_memory_kb\": %ld}",
+    first ? "" : ",", scenario, broadPhase, steps, r.numBodies, r.numJoints,
+    r.stepsPerSecond, r.totalTime, r.broadPhaseTime, r.narrowPhaseTime,
+    r.manifoldUpdateTime, r.contactMergeTime, r.solvingTime, r.updateTime,
+    r.numContacts, r.numContactPoints, r.numIslands, r.numSleeping,
+    r.peakMemory);
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  unsigned int steps = 300;
+  bool json          = false;
+  std::string scenarioFilter, broadPhaseFilter;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--json") {
+      json = true;
+    }
+    else if (arg == "--steps" && i + 1 < argc) {
+      steps = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+      steps = steps > 0 ? steps : 1;
+    }
+    else if (arg == "--scenario" && i + 1 < argc) {
+      scenarioFilter = argv[++i];
+    }
+    else if (arg == "--broadphase" && i + 1 < argc) {
+      broadPhaseFilter = argv[++i];
+    }
+    else {
+      std::fprintf(stderr,
+                   "Usage: %s [--steps N] [--json] [--scenario name] "
+                   "[--broadphase name]\n",
+                   argv[0]);
+      return 1;
+    }
+  }
+
+  const Scenario scenarios[] = {
+    {"pyramid", buildPyramid},
+    {"sphere_rain", buildSphereRain},
+    {"joint_chains", buildJointChains},
+    {"mixed_pile", buildMixedPile},
+    {"sleeping_bodies", buildSleepingBodies},
+  };
+  const BroadPhaseKind broadPhases[] = {
+    {"brute_force", BroadPhase::Type::BR_BRUTE_FORCE},
+    {"sap", BroadPhase::Type::BR_SWEEP_AND_PRUNE},
+    {"simd_sap", BroadPhase::Type::BR_SIMD_SWEEP_AND_PRUNE},
+    {"dbvt", BroadPhase::Type::BR_BOUNDING_VOLUME_TREE},
+  };
+
+  if (json) {
+    std::printf("[");
+  }
+  else {
+    std::printf("%u steps, times per step\n", steps);
+    printHeader();
+  }
+  bool first = true;
+  for (const auto& scenario : scenarios) {
+    if (!scenarioFilter.empty() && scenarioFilter != scenario.name) {
+      continue;
+    }
+    for (const auto& broadPhase : broadPhases) {
+      if (!broadPhaseFilter.empty() && broadPhaseFilter != broadPhase.name) {
+        continue;
+      }
+      const auto result = run(scenario, broadPhase, steps);
+      if (json) {
+        printJson(scenario.name, broadPhase.name, steps, result, first);
+      }
+      else {
+        printResult(scenario.name, broadPhase.name, result);
+      }
+      first = false;
+    }
+  }
+  if (json) {
+    std::printf("\n]\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <oimo/collision/broadphase/broad_phase.h>
+#include <oimo/collision/query/scene_query.h>
+#include <oimo/collision/shape/box_shape.h>
+#include <oimo/collision/shape/shape_config.h>
+#include <oimo/collision/shape/sphere_shape.h>
+#include <oimo/dynamics/rigid_body.h>
+#include <oimo/dynamics/world.h>
+#include <oimo/math/quat.h>
+
+/**
+ * @brief Measures World::rayCast and World::overlap with batches of 1000
+ * queries, as many as agents checking their line of sight, in a world of
+ * 20000 rotated boxes and spheres, with the bounding volume tree and the two
+ * sweep and prune broad-phases. The results are compared with the exact tests
+ * of every shape of the world, which are also timed.
+ *
+ * Usage: scene_query_benchmark [repeats] [bodies] [threads]
+ */
+
+namespace {
+
+using namespace OIMO;
+
+using Clock = std::chrono::high_resolution_clock;
+
+const unsigned int NUM_QUERIES = 1000;
+
+// Deterministic values in [0, 1)
+float nextRandom(unsigned int& seed)
+{
+  seed = seed * 1664525u + 1013904223u;
+  return static_cast<float>(seed >> 8) / static_cast<float>(1 << 24);
+}
+
+struct Scene {
+  std::vector<std::unique_ptr<Shape>> shapes;
+  std::vector<std::unique_ptr<RigidBody>> bodies;
+  std::unique_ptr<World> world;
+  float size;
+
+  Scene(BroadPhase::Type type, unsigned int numBodies, unsigned int threads)
+      : world{make_unique<World>(1.f / 60.f, type)}
+  {
+    world->setNumThreads(threads);
+    size              = std::cbrt(16.f * static_cast<float>(numBodies));
+    unsigned int seed = 12345;
+    for (unsigned int i = 0; i < numBodies; ++i) {
+      const float x = size * nextRandom(seed);
+      const float y = size * nextRandom(seed);
+      const float z = size * nextRandom(seed);
+      bodies.emplace_back(make_unique<RigidBody>(
+        x, y, z, 180.f * nextRandom(seed), nextRandom(seed) - 0.5f,
+        nextRandom(seed) - 0.5f, nextRandom(seed) - 0.5f));
+      if (i % 2 == 0) {
+        shapes.emplace_back(make_unique<BoxShape>(
+          ShapeConfig(), 0.5f + 1.5f * nextRandom(seed),
+          0.5f + 1.5f * nextRandom(seed), 0.5f + 1.5f * nextRandom(seed)));
+      }
+      else {
+        shapes.emplace_back(make_unique<SphereShape>(
+          ShapeConfig(), 0.25f + 0.75f * nextRandom(seed)));
+      }
+      auto body = bodies.back().get();
+      body->addShape(shapes.back().get());
+      const bool isStatic = i % 10 == 0;
+      body->setupMass(isStatic ? RigidBody::Type::BODY_STATIC :
+                                 RigidBody::Type::BODY_DYNAMIC);
+      world->addRigidBody(body);
+      if (!isStatic) {
+        body->linearVelocity.set(4.f * nextRandom(seed) - 2.f,
+                                 4.f * nextRandom(seed) - 2.f,
+                                 4.f * nextRandom(seed) - 2.f);
+      }
+    }
+    // Move the bodies for a few steps, so that the broad-phase is in the
+    // state it has during a simulation
+    for (unsigned int step = 0; step < 10; ++step) {
+      move(world->timeStep);
+      world->broadPhase->detectPairs();
+    }
+    move(world->timeStep);
+  }
+
+  ~Scene()
+  {
+    world->clear();
+  }
+
+  void move(float timeStep)
+  {
+    for (const auto& body : bodies) {
+      if (body->isDynamic) {
+        body->position.addScaledVector(body->linearVelocity, timeStep);
+        body->syncShapes();
+      }
+    }
+  }
+};
+
+struct Queries {
+  std::vector<RayQuery> lineOfSight;
+  std::vector<RayQuery> rays;
+  std::vector<RayQuery> sweeps;
+  std::vector<OverlapQuery> spheres;
+  std::vector<OverlapQuery> boxes;
+
+  Queries(float size)
+  {
+    unsigned int seed = 54321;
+    auto point        = [&seed, size](Vec3& v) {
+      v.set(size * nextRandom(seed), size * nextRandom(seed),
+            size * nextRandom(seed));
+    };
+    for (unsigned int i = 0; i < NUM_QUERIES; ++i) {
+      // Agents looking at another agent a few meters away
+      RayQuery ray;
+      point(ray.begin);
+      ray.end.set(ray.begin.x + 20.f * nextRandom(seed) - 10.f,
+                  ray.begin.y + 20.f * nextRandom(seed) - 10.f,
+                  ray.begin.z + 20.f * nextRandom(seed) - 10.f);
+      ray.anyHit = true;
+      lineOfSight.emplace_back(ray);
+      ray.anyHit = false;
+      rays.emplace_back(ray);
+      ray.radius = 0.5f;
+      sweeps.emplace_back(ray);
+
+      OverlapQuery overlap;
+      point(overlap.center);
+      overlap.radius = 2.f;
+      spheres.emplace_back(overlap);
+      overlap.type = OverlapQuery::Type::OVERLAP_BOX;
+      overlap.halfExtents.set(1.5f, 1.f, 2.f);
+      Quat q;
+      Vec3 axis(nextRandom(seed), nextRandom(seed), 1.f);
+      axis.normalize();
+      q.setFromAxis(axis, 3.f * nextRandom(seed));
+      overlap.rotation.setQuat(q);
+      boxes.emplace_back(overlap);
+    }
+  }
+};
+
+// The exact tests of every shape, as without a broad-phase. The shapes are
+// tested by increasing id, so that the first one hit is kept on ties.
+void rayCastAll(const Scene& scene, const std::vector<RayQuery>& queries,
+                std::vector<RayHit>& hits)
+{
+  hits.assign(queries.size(), RayHit());
+  RayHit candidate;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    auto& hit = hits[i];
+    for (const auto& shape : scene.shapes) {
+      if (!SceneQuery::rayCast(queries[i], *shape, hit.fraction, candidate)) {
+        continue;
+      }
+      if (hit.shape == nullptr || candidate.fraction < hit.fraction) {
+        hit = candidate;
+      }
+      if (queries[i].anyHit) {
+        break;
+      }
+    }
+  }
+}
+
+void overlapAll(const Scene& scene, const std::vector<OverlapQuery>& queries,
+                OverlapResults& results)
+{
+  results.shapes.clear();
+  results.offsets.assign(1, 0);
+  for (const auto& query : queries) {
+    for (const auto& shape : scene.shapes) {
+      if (SceneQuery::overlap(query, *shape)) {
+        results.shapes.emplace_back(shape.get());
+      }
+    }
+    results.offsets.emplace_back(
+      static_cast<unsigned int>(results.shapes.size()));
+  }
+}
+
+// The queries hit the same shapes at the same fractions, any hit being
+// enough for a line of sight
+bool sameHits(const std::vector<RayQuery>& queries,
+              const std::vector<RayHit>& hits,
+              const std::vector<RayHit>& reference)
+{
+  for (size_t i = 0; i < queries.size(); ++i) {
+    if ((hits[i].shape == nullptr) != (reference[i].shape == nullptr)) {
+      return false;
+    }
+    if (!queries[i].anyHit && hits[i].shape != nullptr
+        && (hits[i].fraction != reference[i].fraction
+            || hits[i].shape != reference[i].shape)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool sameOverlaps(const OverlapResults& results,
+                  const OverlapResults& reference)
+{
+  if (results.offsets != reference.offsets) {
+    return false;
+  }
+  for (size_t i = 0; i + 1 < results.offsets.size(); ++i) {
+    const auto begin = static_cast<std::ptrdiff_t>(results.offsets[i]);
+    const auto end   = static_cast<std::ptrdiff_t>(results.offsets[i + 1]);
+    std::vector<Shape*> shapes(results.shapes.begin() + begin,
+                               results.shapes.begin() + end);
+    std::vector<Shape*> expected(reference.shapes.begin() + begin,
+                                 reference.shapes.begin() + end);
+    std::sort(shapes.begin(), shapes.end());
+    std::sort(expected.begin(), expected.end());
+    if (shapes != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double time(unsigned int repeats, const std::function<void()>& func)
+{
+  const auto start = Clock::now();
+  for (unsigned int i = 0; i < repeats; ++i) {
+    func();
+  }
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+           .count()
+         / repeats;
+}
+
+unsigned int countHits(const std::vector<RayHit>& hits)
+{
+  return static_cast<unsigned int>(
+    std::count_if(hits.begin(), hits.end(),
+                  [](const RayHit& hit) { return hit.shape != nullptr; }));
+}
+
+void report(BroadPhase::Type type, const char* name, unsigned int numBodies,
+            unsigned int repeats, unsigned int threads)
+{
+  Scene scene(type, numBodies, threads);
+  const Queries queries(scene.size);
+  auto& world = *scene.world;
+  std::printf("\n%s\n", name);
+
+  const struct {
+    const char* name;
+    const std::vector<RayQuery>* queries;
+  } rayQueries[] = {
+    {"line of sight", &queries.lineOfSight},
+    {"closest ray", &queries.rays},
+    {"sphere sweep", &queries.sweeps},
+  };
+  std::vector<RayHit> hits, reference;
+  for (const auto& rays : rayQueries) {
+    const double ms
+      = time(repeats, [&]() { world.rayCast(*rays.queries, hits); });
+    const double allMs
+      = time(1, [&]() { rayCastAll(scene, *rays.queries, reference); });
+    std::printf("  %-16s %10.3f %12.3f %8u %9s\n", rays.name, ms, allMs,
+                countHits(hits),
+                sameHits(*rays.queries, hits, reference) ? "yes" : "NO");
+  }
+
+  const struct {
+    const char* name;
+    const std::vector<OverlapQuery>* queries;
+  } overlapQueries[] = {
+    {"sphere overlap", &queries.spheres},
+    {"box overlap", &queries.boxes},
+  };
+  OverlapResults results, expected;
+  for (const auto& overlaps : overlapQueries) {
+    const double ms
+      = time(repeats, [&]() { world.overlap(*overlaps.queries, results); });
+    const double allMs
+      = time(1, [&]() { overlapAll(scene, *overlaps.queries, expected); });
+    std::printf("  %-16s %10.3f %12.3f %8zu %9s\n", overlaps.name, ms, allMs,
+                results.shapes.size(),
+                sameOverlaps(results, expected) ? "yes" : "NO");
+  }
+}
+
+} // end of anonymous namespace
+
+int main(int argc, char** argv)
+{
+  unsigned int repeats   = 20;
+  unsigned int numBodies = 20000;
+  unsigned int threads   = 1;
+  if (argc > 1) {
+    repeats = std::max(1u, static_cast<unsigned int>(
+                             std::strtoul(argv[1], nullptr, 10)));
+  }
+  if (argc > 2) {
+    numBodies = static_cast<unsigned int>(std::strtoul(argv[2], nullptr, 10));
+  }
+  if (argc > 3) {
+    threads = std::max(1u, static_cast<unsigned int>(
+                             std::strtoul(argv[3], nullptr, 10)));
+  }
+
+  std::printf("%u bodies, %u queries per batch, %u threads, ms per batch\n",
+              numBodies, NUM_QUERIES, threads);
+  std::printf("  %-16s %10s %12s %8s %9s\n", "query", "ms", "all shapes",
+              "hits", "identical");
+
+  const struct {
+    const char* name;
+    BroadPhase::Type type;
+  } broadPhases[] = {
+    {"bounding volume tree", BroadPhase::Type::BR_BOUNDING_VOLUME_TREE},
+    {"simd sweep and prune", BroadPhase::Type::BR_SIMD_SWEEP_AND_PRUNE},
+    {"sweep and prune", BroadPhase::Type::BR_SWEEP_AND_PRUNE},
+  };
+  for (const auto& broadPhase : broadPhases) {
+    report(broadPhase.type, broadPhase.name, numBodies, repeats, threads);
+  }
+
+  return 0;
+}
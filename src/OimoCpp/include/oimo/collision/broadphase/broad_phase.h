@@ -1,6 +1,7 @@
 #ifndef OIMO_COLLISION_BROADPHASE_BROAD_PHASE_H
 #define OIMO_COLLISION_BROADPHASE_BROAD_PHASE_H
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -8,7 +9,9 @@
 
 namespace OIMO {
 
+class AABB;
 class Proxy;
+struct RayQuery;
 class Shape;
 
 /**
@@ -26,8 +29,10 @@ public:
     BR_SWEEP_AND_PRUNE = 1,
     // Dynamic bounding volume tree broad-phase algorithm.
     BR_BOUNDING_VOLUME_TREE = 2,
+    // Sweep and prune over arrays of bounds with SIMD overlap tests.
+    BR_SIMD_SWEEP_AND_PRUNE = 3,
     // Unknown broad-phase algorithm.
-    BR_NULL = 3
+    BR_NULL = 4
   }; // end of enum class Type
 
 public:
@@ -72,6 +77,34 @@ public:
 
   void addPair(Shape* s1, Shape* s2);
 
+  /**
+   * Brings the broad-phase up to date with its proxies before a batch of
+   * queries.
+   */
+  virtual void prepareQueries();
+
+  /**
+   * Collects the shapes whose AABB overlaps each AABB of a batch. The
+   * broad-phase is only read, so that batches can be queried concurrently
+   * once prepareQueries has been called.
+   * @param   aabbs
+   * @param   numAABBs
+   * @param   shapes   The shapes of each AABB, one AABB after the other.
+   * @param   offsets  The start of the shapes of each AABB in shapes,
+   *                   followed by the end of the shapes of the last one.
+   */
+  virtual void queryAABBs(const AABB* aabbs, size_t numAABBs,
+                          std::vector<Shape*>& shapes,
+                          std::vector<unsigned int>& offsets) const = 0;
+
+  /**
+   * Collects the shapes whose AABB, enlarged by the radius of the query, is
+   * crossed by the segment of each ray query of a batch, as queryAABBs does.
+   */
+  virtual void queryRays(const RayQuery* queries, size_t numQueries,
+                         std::vector<Shape*>& shapes,
+                         std::vector<unsigned int>& offsets) const;
+
 public:
   BroadPhase::Type type;
   // The number of pair checks.
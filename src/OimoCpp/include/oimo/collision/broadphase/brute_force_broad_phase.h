@@ -25,6 +25,9 @@ public:
   void addProxy(Proxy* proxy) override;
   void removeProxy(Proxy* proxy) override;
   void collectPairs() override;
+  void queryAABBs(const AABB* aabbs, size_t numAABBs,
+                  std::vector<Shape*>& shapes,
+                  std::vector<unsigned int>& offsets) const override;
 
   BroadPhase::Type type() const;
 
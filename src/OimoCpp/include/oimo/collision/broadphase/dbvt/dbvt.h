@@ -1,14 +1,15 @@
 #ifndef OIMO_COLLISION_BROADPHASE_DBVT_DBVT_H
 #define OIMO_COLLISION_BROADPHASE_DBVT_DBVT_H
 
+#include <deque>
 #include <vector>
 
+#include <oimo/collision/broadphase/dbvt/dbvt_node.h>
 #include <oimo/oimo_utils.h>
 
 namespace OIMO {
 
 class AABB;
-struct DBVTNode;
 
 /**
  * @brief A dynamic bounding volume tree for the broad-phase algorithm.
@@ -39,7 +40,37 @@ public:
    */
   void deleteLeaf(DBVTNode* leaf);
 
+  /**
+   * Sets the AABB of a leaf. The leaf stays in place when the AABB of its
+   * parent still contains the new one, and is moved otherwise.
+   * @param   leaf
+   * @param   aabb
+   */
+  void refitLeaf(DBVTNode* leaf, const AABB& aabb);
+
+  /**
+   * Collects the leaves whose AABB overlaps an AABB.
+   * @param   aabb
+   * @param   leaves  The overlapping leaves, cleared first.
+   */
+  void query(const AABB& aabb, std::vector<DBVTNode*>& leaves);
+
+  /**
+   * Returns the surface area heuristic cost of the tree, the sum of the areas
+   * of the internal nodes relative to the area of the root.
+   */
+  float cost();
+
+  /**
+   * Rebuilds the whole tree from its leaves, top-down, splitting the leaves
+   * with the surface area heuristic.
+   */
+  void rebuild();
+
 private:
+  DBVTNode* _allocateNode();
+  void _freeNode(DBVTNode* node);
+  DBVTNode* _build(DBVTNode** leaves, size_t numLeaves);
   DBVTNode* _balance(DBVTNode* node);
   void _fix(DBVTNode* node);
 
@@ -48,9 +79,12 @@ public:
   DBVTNode* root;
 
 private:
-  std::vector<std::unique_ptr<DBVTNode>> _freeList;
-  std::array<DBVTNode*, 16384> _freeNodes;
-  unsigned int _numFreeNodes;
+  // The internal nodes, allocated in blocks and recycled through the free
+  // list
+  std::deque<DBVTNode> _nodes;
+  std::vector<DBVTNode*> _freeNodes;
+  std::vector<DBVTNode*> _stack;
+  std::vector<DBVTNode*> _leaves;
   std::unique_ptr<AABB> _aabb;
 
 }; // end of class DBVTBroadPhase
@@ -1,6 +1,7 @@
 #ifndef OIMO_COLLISION_BROADPHASE_DBVT_DBVT_BROAD_PHASE_H
 #define OIMO_COLLISION_BROADPHASE_DBVT_DBVT_BROAD_PHASE_H
 
+#include <oimo/collision/broadphase/aabb.h>
 #include <oimo/collision/broadphase/broad_phase.h>
 #include <oimo/oimo_utils.h>
 
@@ -8,11 +9,19 @@ namespace OIMO {
 
 class DBVT;
 struct DBVTNode;
+class DBVTProxy;
 class Proxy;
 class Shape;
 
 /**
  * @brief A broad-phase algorithm using dynamic bounding volume tree.
+ *
+ * The leaves hold the AABB of their proxy fattened by a margin and extended
+ * along the velocity of the rigid body, and are only refitted when the proxy
+ * leaves it. The pairs of leaves whose fattened AABB overlap are cached: the
+ * refitted leaves query the tree as one batch to add their new pairs, and
+ * the cached pairs whose proxies overlap are reported at each step, so the
+ * pairs are the same as the ones of SAPBroadPhase.
  */
 class DBVTBroadPhase : public BroadPhase {
 
@@ -25,16 +34,82 @@ public:
   void removeProxy(Proxy* proxy) override;
   void collectPairs() override;
 
+  /**
+   * Refits the leaves whose proxy moved out of their AABB, which keep their
+   * previous AABB until the next step collects their new pairs.
+   */
+  void prepareQueries() override;
+
+  void queryAABBs(const AABB* aabbs, size_t numAABBs,
+                  std::vector<Shape*>& shapes,
+                  std::vector<unsigned int>& offsets) const override;
+  void queryRays(const RayQuery* queries, size_t numQueries,
+                 std::vector<Shape*>& shapes,
+                 std::vector<unsigned int>& offsets) const override;
+
 private:
-  void _collide(DBVTNode* node1, DBVTNode* node2);
+  // A pair of leaves whose fattened AABB overlap, with the ids of their
+  // shapes.
+  struct LeafPair {
+    DBVTNode* leaf1;
+    DBVTNode* leaf2;
+    unsigned int id1;
+    unsigned int id2;
+  }; // end of struct LeafPair
+
+  /**
+   * Sets an AABB to the fattened AABB of a proxy.
+   */
+  void _fatten(const DBVTProxy& proxy, AABB& aabb) const;
+
+  /**
+   * Removes the cached pairs of the removed proxies.
+   */
+  void _removePairs();
+
+  /**
+   * Refits the new leaves and the leaves whose proxy moved out of their AABB,
+   * and adds them to the moved leaves.
+   */
+  void _refitLeaves();
+
+  /**
+   * Refits the leaves whose proxy moved out of their AABB and caches the new
+   * pairs of the moved leaves.
+   */
+  void _updateLeaves();
+
+public:
+  // The margin by which the AABB of the leaves are fattened.
+  float margin;
+  // The number of time steps of displacement by which the AABB of the leaves
+  // are extended along the velocity of their rigid body.
+  float predictionSteps;
+  // Whether the tree is rebuilt with the surface area heuristic when its cost
+  // grows past rebuildThreshold times its cost after the last rebuild.
+  bool rebuildEnabled;
+  float rebuildThreshold;
+  // The number of leaves refitted by the last step.
+  unsigned int numMovedLeaves;
+  // The number of rebuilds of the tree.
+  unsigned int numRebuilds;
 
 private:
   std::unique_ptr<DBVT> _tree;
-  std::vector<DBVTNode*> _stack;
-  unsigned int _maxStack;
   std::vector<DBVTNode*> _leaves;
   unsigned int _numLeaves;
   unsigned int _maxLeaves;
+  std::vector<DBVTNode*> _overlaps;
+  AABB _fatAABB;
+  // The leaves refitted since the last step and their AABB before the first
+  // refit
+  std::vector<DBVTNode*> _movedLeaves;
+  std::vector<AABB> _previousAABBs;
+  std::vector<LeafPair> _pairCache;
+  // The ids of the shapes removed since the last step
+  std::vector<unsigned int> _removedIds;
+  // The cost per leaf of the tree after the last rebuild
+  float _baseCost;
 
 }; // end of class DBVTBroadPhase
 
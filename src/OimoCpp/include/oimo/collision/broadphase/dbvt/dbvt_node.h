@@ -1,12 +1,12 @@
 #ifndef OIMO_COLLISION_BROADPHASE_DBVT_DBVT_NODE_H
 #define OIMO_COLLISION_BROADPHASE_DBVT_DBVT_NODE_H
 
+#include <oimo/collision/broadphase/aabb.h>
 #include <oimo/collision/broadphase/proxy.h>
 #include <oimo/oimo_utils.h>
 
 namespace OIMO {
 
-class AABB;
 struct DBVTNode;
 class DBVTProxy;
 
@@ -28,8 +28,8 @@ struct DBVTNode {
   DBVTProxy* proxy;
   // The maximum distance from leaf nodes.
   int height;
-  // The AABB of this node.
-  std::unique_ptr<AABB> aabb;
+  // The AABB of this node, fattened for a leaf.
+  AABB aabb;
 
 }; // end of struct DBVTNode
 
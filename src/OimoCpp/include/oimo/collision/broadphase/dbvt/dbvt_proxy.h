@@ -31,6 +31,11 @@ public:
 public:
   // The leaf of the proxy.
   std::unique_ptr<DBVTNode> leaf;
+  // Whether the leaf was inserted since the last step.
+  bool inserted;
+  // The index of the leaf among the leaves moved by the current step, -1
+  // when the leaf did not move.
+  int moveIndex;
 
 }; // end of class DBVTProxy
 
@@ -26,7 +26,7 @@ public:
   unsigned int numElements;
   unsigned int bufferSize;
   std::vector<SAPElement*> elements;
-  std::array<unsigned int, 64> stack;
+  std::array<int, 64> stack;
 
 }; // end of class SAPAxis
 
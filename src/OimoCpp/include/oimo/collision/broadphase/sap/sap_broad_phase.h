@@ -10,6 +10,7 @@ namespace OIMO {
 
 class Proxy;
 class SAPAxis;
+class SAPProxy;
 class Shape;
 
 /**
@@ -26,6 +27,24 @@ public:
   void removeProxy(Proxy* proxy) override;
   void collectPairs() override;
 
+  /**
+   * Sorts the first axes and measures the widest proxy along them, so that
+   * queries only scan the elements which can overlap them.
+   */
+  void prepareQueries() override;
+
+  void queryAABBs(const AABB* aabbs, size_t numAABBs,
+                  std::vector<Shape*>& shapes,
+                  std::vector<unsigned int>& offsets) const override;
+
+private:
+  /**
+   * Moves the proxies of the bodies which fell asleep or woke up between the
+   * dynamic and the static axes. This is not done by SAPProxy::update(), which
+   * is called from the island solver threads.
+   */
+  void _moveProxies();
+
 private:
   unsigned int _numElementsD;
   unsigned int _numElementsS;
@@ -36,6 +55,9 @@ private:
   // Indices
   unsigned int _index1;
   unsigned int _index2;
+  std::vector<SAPProxy*> _movedProxies;
+  // The widest extent of the proxies along the first axis
+  float _maxExtent;
 
 }; // end of class SAPBroadPhase
 
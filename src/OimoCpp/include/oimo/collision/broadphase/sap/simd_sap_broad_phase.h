@@ -0,0 +1,107 @@
+#ifndef OIMO_COLLISION_BROADPHASE_SAP_SIMD_SAP_BROAD_PHASE_H
+#define OIMO_COLLISION_BROADPHASE_SAP_SIMD_SAP_BROAD_PHASE_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <oimo/collision/broadphase/broad_phase.h>
+#include <oimo/oimo_utils.h>
+
+namespace OIMO {
+
+class Proxy;
+class Shape;
+class SIMDSAPProxy;
+
+/**
+ * @brief A broad-phase collision detection algorithm using sweep and prune
+ * over arrays of bounds.
+ *
+ * The bounds of the proxies are kept in one array per axis. At each step the
+ * proxies are sorted by their minimum along the axis on which their centers
+ * spread the most: the order of the previous step is fixed with an insertion
+ * sort while it stays nearly sorted, and rebuilt with a radix sort otherwise.
+ * The sweep tests each proxy against the next ones four at a time with SSE,
+ * on the sweep axis and the two other axes at once.
+ *
+ * The pairs are the same as the ones of SAPBroadPhase, a pair being reported
+ * when at least one of its proxies is dynamic.
+ */
+class SIMDSAPBroadPhase : public BroadPhase {
+
+public:
+  SIMDSAPBroadPhase();
+  ~SIMDSAPBroadPhase();
+
+  std::unique_ptr<Proxy> createProxy(Shape* shape) override;
+  void addProxy(Proxy* proxy) override;
+  void removeProxy(Proxy* proxy) override;
+  void collectPairs() override;
+  void queryAABBs(const AABB* aabbs, size_t numAABBs,
+                  std::vector<Shape*>& shapes,
+                  std::vector<unsigned int>& offsets) const override;
+
+  /**
+   * Copies the AABB of a proxy into its slot.
+   * @param   proxy
+   */
+  void updateBounds(const SIMDSAPProxy& proxy);
+
+private:
+  /**
+   * Returns the axis along which the variance of the centers of the proxies
+   * is the largest, keeping the current sweep axis unless another axis is
+   * clearly better.
+   */
+  unsigned int _selectAxis() const;
+
+  /**
+   * Sorts the slots by their minimum along the sweep axis.
+   */
+  void _sort();
+
+  /**
+   * Insertion sort of the order of the previous step.
+   * @return False when it gave up because the order changed too much.
+   */
+  bool _insertionSort();
+
+  void _radixSort();
+
+  /**
+   * Copies the bounds and the dynamic state of the proxies in sorted order.
+   */
+  void _gather();
+
+  void _sweep();
+
+public:
+  // The axis along which the proxies are sorted, 0, 1 or 2.
+  unsigned int sweepAxis;
+  // The number of radix sorts, for benchmarking.
+  unsigned int numRadixSorts;
+
+private:
+  std::vector<SIMDSAPProxy*> _proxies;
+  // The bounds by slot, min x, y, z then max x, y, z
+  std::array<std::vector<float>, 6> _bounds;
+  // The slots sorted by their minimum along the sweep axis
+  std::vector<unsigned int> _order;
+  // Whether _order holds every slot, false after a removal
+  bool _orderValid;
+  // The bounds in sorted order: along the sweep axis and the two other axes,
+  // padded with 3 infinite minimums so that the sweep can load 4 values past
+  // the last proxy.
+  std::vector<float> _sweepMin, _sweepMax;
+  std::vector<float> _min1, _max1, _min2, _max2;
+  std::vector<unsigned char> _dynamic;
+  // Radix sort buffers
+  std::vector<uint32_t> _keys, _keysTmp;
+  std::vector<unsigned int> _orderTmp;
+
+}; // end of class SIMDSAPBroadPhase
+
+} // end of namespace OIMO
+
+#endif // end of OIMO_COLLISION_BROADPHASE_SAP_SIMD_SAP_BROAD_PHASE_H
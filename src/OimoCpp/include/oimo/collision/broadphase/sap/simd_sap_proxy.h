@@ -0,0 +1,40 @@
+#ifndef OIMO_COLLISION_BROADPHASE_SAP_SIMD_SAP_PROXY_H
+#define OIMO_COLLISION_BROADPHASE_SAP_SIMD_SAP_PROXY_H
+
+#include <oimo/collision/broadphase/proxy.h>
+
+namespace OIMO {
+
+class SIMDSAPBroadPhase;
+class Shape;
+
+/**
+ * @brief A proxy for the SIMD sweep and prune broad-phase.
+ */
+class SIMDSAPProxy : public Proxy {
+
+public:
+  SIMDSAPProxy(SIMDSAPBroadPhase* sap, Shape* shape);
+  ~SIMDSAPProxy();
+
+  /**
+   * Returns whether the proxy is dynamic or not.
+   */
+  bool isDynamic() const;
+
+  /**
+   * Update the proxy.
+   */
+  void update() override;
+
+public:
+  // The slot of the proxy in the bounds of the broad-phase, -1 when the proxy
+  // is not in the broad-phase.
+  int slot;
+  SIMDSAPBroadPhase* sap;
+
+}; // end of class SIMDSAPProxy
+
+} // end of namespace OIMO
+
+#endif // end of OIMO_COLLISION_BROADPHASE_SAP_SIMD_SAP_PROXY_H
@@ -1,8 +1,6 @@
 #ifndef OIMO_COLLISION_NARROWPHASE_BOX_BOX_COLLISION_DETECTOR_H
 #define OIMO_COLLISION_NARROWPHASE_BOX_BOX_COLLISION_DETECTOR_H
 
-#include <array>
-
 #include <oimo/collision/narrowphase/collision_detector.h>
 
 namespace OIMO {
@@ -23,10 +21,6 @@ public:
                        ContactManifold* manifold) override;
 
 private:
-  // 8 vertices x,y,z
-  std::array<float, 24> _clipVertices1;
-  std::array<float, 24> _clipVertices2;
-  std::array<bool, 8> _used;
   float _inf;
 
 }; // end of class BoxBoxCollisionDetector
@@ -0,0 +1,152 @@
+#ifndef OIMO_COLLISION_QUERY_SCENE_QUERY_H
+#define OIMO_COLLISION_QUERY_SCENE_QUERY_H
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <oimo/collision/broadphase/aabb.h>
+#include <oimo/math/mat33.h>
+#include <oimo/math/vec3.h>
+
+namespace OIMO {
+
+class Shape;
+
+/**
+ * @brief A ray cast along a segment, or the sweep of a sphere along it when
+ * the radius is positive.
+ */
+struct RayQuery {
+  // The beginning of the segment.
+  Vec3 begin;
+  // The end of the segment.
+  Vec3 end;
+  // The radius of the swept sphere, 0 for a ray.
+  float radius = 0.f;
+  // The bits of the collision groups of the shapes which can be hit.
+  int collidesWith = ~0;
+  // Whether any hit is enough, as for a line of sight, instead of the closest
+  // one.
+  bool anyHit = false;
+}; // end of struct RayQuery
+
+/**
+ * @brief The hit of a ray query.
+ */
+struct RayHit {
+  // The shape hit, nullptr when nothing was hit.
+  Shape* shape = nullptr;
+  // The position of the hit along the segment, from 0 at its beginning to 1
+  // at its end. A query starting inside a shape hits it at 0.
+  float fraction = 1.f;
+  // The point of the surface of the shape which is hit.
+  Vec3 position;
+  // The normal of the surface of the shape at the hit point.
+  Vec3 normal;
+}; // end of struct RayHit
+
+/**
+ * @brief A sphere or an oriented box collecting the shapes it overlaps.
+ */
+struct OverlapQuery {
+  // Overlap query type
+  enum class Type : unsigned int {
+    OVERLAP_SPHERE = 0,
+    OVERLAP_BOX    = 1
+  }; // end of enum class Type
+
+  Type type = Type::OVERLAP_SPHERE;
+  // The center of the sphere or of the box.
+  Vec3 center;
+  // The radius of the sphere.
+  float radius = 0.f;
+  // The half extents of the box along its axes.
+  Vec3 halfExtents;
+  // The rotation of the box, whose columns are its axes.
+  Mat33 rotation;
+  // The bits of the collision groups of the shapes which can be overlapped.
+  int collidesWith = ~0;
+}; // end of struct OverlapQuery
+
+/**
+ * @brief The shapes overlapped by a batch of overlap queries. The shapes of
+ * the query i are stored in shapes from offsets[i] to offsets[i + 1].
+ */
+struct OverlapResults {
+  std::vector<Shape*> shapes;
+  std::vector<unsigned int> offsets;
+}; // end of struct OverlapResults
+
+/**
+ * @brief The segment of a ray query, prepared for slab tests against AABBs.
+ */
+struct RaySegment {
+
+  RaySegment(const RayQuery& query);
+
+  /**
+   * Returns whether the segment crosses an AABB enlarged by the radius of the
+   * query. Defined here as the broad-phases call it for every node they visit.
+   */
+  bool intersects(const AABB& aabb) const
+  {
+    const auto& te = aabb.elements;
+    float tMin = 0.f, tMax = 1.f;
+    for (unsigned int k = 0; k < 3; ++k) {
+      const float t1 = (te[k] - radius - begin[k]) * invDelta[k];
+      const float t2 = (te[k + 3] + radius - begin[k]) * invDelta[k];
+      tMin           = std::max(tMin, std::min(t1, t2));
+      tMax           = std::min(tMax, std::max(t1, t2));
+    }
+    return tMin <= tMax;
+  }
+
+  std::array<float, 3> begin;
+  std::array<float, 3> delta;
+  // The inverse of delta, the largest float along the axes the segment is
+  // parallel to, so that the slabs of these axes are tested without a NaN
+  std::array<float, 3> invDelta;
+  float radius;
+}; // end of struct RaySegment
+
+/**
+ * @brief The exact tests of the scene queries against a shape.
+ *
+ * Spheres, boxes and planes are tested exactly, the other shapes are tested
+ * with their AABB.
+ */
+class SceneQuery {
+
+public:
+  /**
+   * Tests a ray query against a shape.
+   * @param   query
+   * @param   shape
+   * @param   maxFraction The fraction beyond which hits are ignored.
+   * @param   hit         Set when the shape is hit.
+   * @return  Whether the shape is hit before maxFraction.
+   */
+  static bool rayCast(const RayQuery& query, Shape& shape, float maxFraction,
+                      RayHit& hit);
+
+  /**
+   * Returns whether an overlap query overlaps a shape.
+   */
+  static bool overlap(const OverlapQuery& query, const Shape& shape);
+
+  /**
+   * Sets the AABB of an overlap query.
+   */
+  static void bounds(const OverlapQuery& query, AABB& aabb);
+
+  /**
+   * Sets the AABB of the segment of a ray query, enlarged by its radius.
+   */
+  static void bounds(const RayQuery& query, AABB& aabb);
+
+}; // end of class SceneQuery
+
+} // end of namespace OIMO
+
+#endif // end of OIMO_COLLISION_QUERY_SCENE_QUERY_H
@@ -78,7 +78,6 @@ public:
   std::unique_ptr<ContactManifold> manifold;
   // The contact constraint of the contact.
   std::unique_ptr<ContactConstraint> constraint;
-  std::array<ManifoldPoint, 4> points;
   std::array<ImpulseDataBuffer, 4> buffer;
 
 }; // end of class Contact
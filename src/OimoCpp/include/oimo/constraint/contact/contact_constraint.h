@@ -46,17 +46,17 @@ public:
 private:
   // The contact manifold of the constraint.
   ContactManifold* _manifold;
-  Vec3 _p1, _p2;
-  Vec3 _lv1, _lv2;
-  Vec3 _av1, _av2;
-  Mat33 _i1, _i2;
+  // The state of the bodies, bound on attach.
+  Vec3 *_p1, *_p2;
+  Vec3 *_lv1, *_lv2;
+  Vec3 *_av1, *_av2;
+  Mat33 *_i1, *_i2;
   Vec3 _tmp, _tmpC1, _tmpC2;
   Vec3 _tmpP1, _tmpP2;
   Vec3 _tmplv1, _tmplv2;
   Vec3 _tmpav1, _tmpav2;
   float _m1, _m2;
   unsigned int _num;
-  std::array<ManifoldPoint, 4> _ps;
   std::unique_ptr<ContactPointDataBuffer> _cs;
 
 }; // end of class ContactConstraint
@@ -33,8 +33,8 @@ private:
   Vec3 _imp;
   Vec3 _rn0, _rn1, _rn2;
   RigidBody *_b1, *_b2;
-  Vec3 _a1, _a2;
-  Mat33 _i1, _i2;
+  Vec3 &_a1, &_a2;
+  Mat33 &_i1, &_i2;
 
 }; // end of class AngularConstraint
 
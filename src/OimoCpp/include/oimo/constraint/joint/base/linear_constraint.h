@@ -36,12 +36,12 @@ private:
   float _az2x, _az2y, _az2z;
   float _velx, _vely, _velz;
   Joint* _joint;
-  Vec3 _r1, _r2;
-  Vec3 _p1, _p2;
+  Vec3 &_r1, &_r2;
+  Vec3 &_p1, &_p2;
   RigidBody *_b1, *_b2;
-  Vec3 _l1, _l2;
-  Vec3 _a1, _a2;
-  Mat33 _i1, _i2;
+  Vec3 &_l1, &_l2;
+  Vec3 &_a1, &_a2;
+  Mat33 &_i1, &_i2;
   float _impx, _impy, _impz;
 
 }; // end of class LinearConstraint
@@ -75,8 +75,8 @@ private:
   float _d10, _d11, _d12;
   float _d20, _d21, _d22;
   RigidBody *_b1, *_b2;
-  Vec3 _a1, _a2;
-  Mat33 _i1, _i2;
+  Vec3 &_a1, &_a2;
+  Mat33 &_i1, &_i2;
   float _limitImpulse1;
   float _motorImpulse1;
   float _limitImpulse2;
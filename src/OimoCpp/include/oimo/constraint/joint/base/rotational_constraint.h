@@ -47,8 +47,8 @@ private:
 
   LimitMotor* _limitMotor;
   RigidBody *_b1, *_b2;
-  Vec3 _a1, _a2;
-  Mat33 _i1, _i2;
+  Vec3 &_a1, &_a2;
+  Mat33 &_i1, &_i2;
   float _limitImpulse;
   float _motorImpulse;
 
@@ -91,11 +91,11 @@ private:
   float _d20, _d21, _d22;
   LimitMotor *_limitMotor1, *_limitMotor2, *_limitMotor3;
   RigidBody *_b1, *_b2;
-  Vec3 _p1, _p2;
-  Vec3 _r1, _r2;
-  Vec3 _l1, _l2;
-  Vec3 _a1, _a2;
-  Mat33 _i1, _i2;
+  Vec3 &_p1, &_p2;
+  Vec3 &_r1, &_r2;
+  Vec3 &_l1, &_l2;
+  Vec3 &_a1, &_a2;
+  Mat33 &_i1, &_i2;
   float _limitImpulse1;
   float _motorImpulse1;
   float _limitImpulse2;
@@ -53,11 +53,11 @@ private:
   float _maxMotorImpulse;
   LimitMotor* _limitMotor;
   RigidBody *_b1, *_b2;
-  Vec3 _p1, _p2;
-  Vec3 _r1, _r2;
-  Vec3 _l1, _l2;
-  Vec3 _a1, _a2;
-  Mat33 _i1, _i2;
+  Vec3 &_p1, &_p2;
+  Vec3 &_r1, &_r2;
+  Vec3 &_l1, &_l2;
+  Vec3 &_a1, &_a2;
+  Mat33 &_i1, &_i2;
   float _limitImpulse;
   float _motorImpulse;
 
@@ -83,7 +83,6 @@ public:
   Joint* prev;
   // The next joint in the world.
   Joint* next;
-  RigidBody *body1, *body2;
   // The anchor point on the first rigid body in local coordinate system.
   Vec3 localAnchorPoint1;
   // The anchor point on the second rigid body in local coordinate system.
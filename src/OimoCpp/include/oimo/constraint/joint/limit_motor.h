@@ -42,8 +42,8 @@ public:
   void setSpring(float frequency, float dampingRatio);
 
 public:
-  // The axis of the constraint.
-  Vec3 axis;
+  // The axis of the constraint, updated by the joint on each step.
+  const Vec3& axis;
   // The current angle for rotational constraints.
   float angle;
   // The lower limit. Set lower > upper to disable
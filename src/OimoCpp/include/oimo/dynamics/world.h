@@ -12,14 +12,39 @@
 #include <oimo/math/vec3.h>
 #include <oimo/oimo_utils.h>
 #include <oimo/util/performance.h>
+#include <oimo/util/thread_pool.h>
 
 namespace OIMO {
 
 class Contact;
 class Joint;
+struct OverlapQuery;
+struct OverlapResults;
+struct RayHit;
+struct RayQuery;
 class RigidBody;
 class Shape;
 
+/**
+ * @brief A simulation island, a group of rigid bodies connected by contacts
+ * or joints, which is solved independently of the other islands.
+ */
+struct Island {
+  // The rigid bodies of the island in World::islandRigidBodies.
+  unsigned int rigidBodiesStart;
+  unsigned int numRigidBodies;
+  // The constraints of the island in World::islandConstraints.
+  unsigned int constraintsStart;
+  unsigned int numConstraints;
+  // The seed of the constraints randomizer of the island.
+  unsigned int seed;
+  // Whether a joint of the island is attached to a static body, which can be
+  // shared with another island.
+  bool touchesStatic;
+  // Whether the island has to be put to sleep, set by the solver.
+  bool sleep;
+}; // end of struct Island
+
 /**
  * @brief The class of physical computing world.
  */
@@ -30,7 +55,14 @@ public:
   // scale all by 100 so object is between 10 to 10000 three unit.
   static float WORLD_SCALE;
   static float INV_SCALE;
-  static const std::array<std::string, 4> Btypes;
+  // The cost, in rigid bodies plus constraints times iterations, from which a
+  // batch of islands is solved as one task.
+  static const unsigned int ISLAND_BATCH_COST;
+  // The number of contacts whose manifolds are updated as one task.
+  static const unsigned int CONTACT_BATCH_SIZE;
+  // The number of scene queries run as one task.
+  static const unsigned int QUERY_BATCH_SIZE;
+  static const std::array<std::string, 5> Btypes;
 
 public:
   World(float timeStep                  = 0.01666f, // 1/60
@@ -104,11 +136,63 @@ public:
   bool checkContact(const std::string& name1, const std::string& name2);
   bool callSleep(RigidBody* body);
 
+  /**
+   * Sets the number of threads updating the contacts and solving the
+   * simulation islands, the calling thread included. The result of a step
+   * does not depend on the number of threads.
+   */
+  void setNumThreads(unsigned int numThreads);
+  unsigned int getNumThreads() const;
+
   /**
    * Proceed only time step seconds time of World.
    */
   void step();
 
+  /**
+   * Casts a batch of rays, or sweeps spheres along them, and sets the hit of
+   * each query. The broad-phase is queried once per batch of
+   * QUERY_BATCH_SIZE queries, and the batches run on the threads of the
+   * world. Of the shapes hit at the same fraction, the one with the lowest id
+   * is kept, so that the hits do not depend on the broad-phase. Queries close
+   * to each other in the batch visit the same nodes of the broad-phase while
+   * they are in cache.
+   * @param   queries
+   * @param   hits     The hit of each query.
+   */
+  void rayCast(const std::vector<RayQuery>& queries,
+               std::vector<RayHit>& hits);
+
+  /**
+   * Collects the shapes overlapped by each of a batch of spheres and boxes,
+   * in batches as rayCast does.
+   * @param   queries
+   * @param   results  The shapes overlapped by each query.
+   */
+  void overlap(const std::vector<OverlapQuery>& queries,
+               OverlapResults& results);
+
+private:
+  /**
+   * Unlinks a contact from the contact list and the shapes and keeps it for
+   * reuse, without removing it from contactArray.
+   */
+  void _freeContact(Contact* contact);
+
+  /**
+   * Builds the simulation islands of the awake rigid bodies and groups them
+   * into batches of similar cost.
+   */
+  void _buildIslands();
+
+  /**
+   * Solves the constraints of an island and integrates its rigid bodies.
+   * Islands only share static bodies, which are never written to by contacts,
+   * so islands which are not attached to a static body by a joint can be
+   * solved concurrently.
+   */
+  void _solveIsland(Island& island, float invTimeStep);
+
 public:
   // The time between each step
   float timeStep;
@@ -131,6 +215,12 @@ public:
   // The contact list
   Contact* contacts;
   Contact* unusedContacts;
+  // The contacts of the contact list, stored contiguously so that the
+  // narrow-phase can update them in batches.
+  std::vector<Contact*> contactArray;
+  // Whether each contact of contactArray separated during the narrow-phase,
+  // in which case it is removed by the serial merge which follows it.
+  std::vector<unsigned char> separatedContacts;
   // The number of contact
   unsigned int numContacts;
   // The number of contact points
@@ -148,9 +238,16 @@ public:
   std::array<std::array<std::unique_ptr<CollisionDetector>, 5>, 5> detectors;
   // Rand
   unsigned int randX, randA, randB;
+  // The simulation islands of the last step, in the order they were built.
+  std::vector<Island> islands;
+  // The start of each batch of islands in islands, followed by the end of the
+  // last batch.
+  std::vector<unsigned int> islandBatches;
   std::vector<RigidBody*> islandRigidBodies;
   std::vector<RigidBody*> islandStack;
   std::vector<Constraint*> islandConstraints;
+  // The workers updating the contacts and solving the islands.
+  std::unique_ptr<ThreadPool> threadPool;
 
 }; // end of struct World
 
@@ -34,6 +34,7 @@ public:
   void setTime(unsigned int n = 0);
   void resetMax();
   void calcBroadPhase();
+  void calcManifoldUpdate();
   void calcNarrowPhase();
   void calcEnd();
   void upfps();
@@ -42,7 +43,7 @@ public:
   World* parent;
   std::array<float, 13> infos;
   std::array<high_res_time_point_t, 2> f;
-  std::array<high_res_time_point_t, 3> times;
+  std::array<high_res_time_point_t, 5> times;
   std::string broadPhase;
   std::string version;
   float fps, fpsTmp;
@@ -54,11 +55,17 @@ public:
   unsigned int numIslands;
   microsecond_t broadPhaseTime;
   microsecond_t narrowPhaseTime;
+  // The narrow-phase is split into the concurrent update of the contact
+  // manifolds and the serial merge removing the separated contacts.
+  microsecond_t manifoldUpdateTime;
+  microsecond_t contactMergeTime;
   microsecond_t solvingTime;
   microsecond_t totalTime;
   microsecond_t updateTime;
   microsecond_t maxBroadPhaseTime;
   microsecond_t maxNarrowPhaseTime;
+  microsecond_t maxManifoldUpdateTime;
+  microsecond_t maxContactMergeTime;
   microsecond_t maxSolvingTime;
   microsecond_t maxTotalTime;
   microsecond_t maxUpdateTime;
@@ -0,0 +1,62 @@
+#ifndef OIMO_UTIL_THREAD_POOL_H
+#define OIMO_UTIL_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OIMO {
+
+/**
+ * @brief A pool of worker threads sharing the iterations of a loop with the
+ * calling thread.
+ */
+class ThreadPool {
+
+public:
+  using Func = std::function<void(size_t index)>;
+
+public:
+  /**
+   * @param numThreads The number of threads running the loops, the calling
+   * thread included. With one thread, no worker is started.
+   */
+  ThreadPool(unsigned int numThreads = 1);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  unsigned int numThreads() const;
+
+  /**
+   * Calls func(index) for each index in [0, count) and returns once all the
+   * calls are done. The indices are claimed one at a time by the workers and
+   * by the calling thread, so the calls should be of a reasonable size.
+   */
+  void parallelFor(size_t count, const Func& func);
+
+private:
+  void _run();
+  void _work();
+
+private:
+  std::vector<std::thread> _workers;
+  std::mutex _mutex;
+  std::condition_variable _wakeUp;
+  std::condition_variable _done;
+  const Func* _func;
+  size_t _count;
+  std::atomic<size_t> _next;
+  // Number of workers which did not finish the current loop
+  unsigned int _busyWorkers;
+  unsigned int _generation;
+  bool _stop;
+
+}; // end of class ThreadPool
+
+} // end of namespace OIMO
+
+#endif // end of OIMO_UTIL_THREAD_POOL_H
@@ -1,5 +1,7 @@
 #include <oimo/collision/broadphase/broad_phase.h>
 
+#include <oimo/collision/broadphase/aabb.h>
+#include <oimo/collision/query/scene_query.h>
 #include <oimo/collision/shape/shape.h>
 #include <oimo/constraint/joint/joint.h>
 #include <oimo/constraint/joint/joint_link.h>
@@ -63,4 +65,32 @@ void BroadPhase::addPair(Shape* s1, Shape* s2)
   ++numPairs;
 }
 
+void BroadPhase::prepareQueries()
+{
+}
+
+void BroadPhase::queryRays(const RayQuery* queries, size_t numQueries,
+                           std::vector<Shape*>& shapes,
+                           std::vector<unsigned int>& offsets) const
+{
+  // The shapes overlapping the AABB of each segment, crossed by the segment
+  shapes.clear();
+  offsets.clear();
+  AABB aabb;
+  std::vector<Shape*> candidates;
+  std::vector<unsigned int> candidateOffsets;
+  for (size_t i = 0; i < numQueries; ++i) {
+    offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+    SceneQuery::bounds(queries[i], aabb);
+    queryAABBs(&aabb, 1, candidates, candidateOffsets);
+    const RaySegment segment(queries[i]);
+    for (auto shape : candidates) {
+      if (segment.intersects(*shape->aabb)) {
+        shapes.emplace_back(shape);
+      }
+    }
+  }
+  offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+}
+
 } // end of namespace OIMO
@@ -52,6 +52,23 @@ void BruteForceBroadPhase::collectPairs()
   }
 }
 
+void BruteForceBroadPhase::queryAABBs(const AABB* aabbs, size_t numAABBs,
+                                      std::vector<Shape*>& shapes,
+                                      std::vector<unsigned int>& offsets) const
+{
+  shapes.clear();
+  offsets.clear();
+  for (size_t i = 0; i < numAABBs; ++i) {
+    offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+    for (auto proxy : _proxies) {
+      if (!aabbs[i].intersectTest(*proxy->aabb)) {
+        shapes.emplace_back(proxy->shape);
+      }
+    }
+  }
+  offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+}
+
 BroadPhase::Type BruteForceBroadPhase::type() const
 {
   return _type;
@@ -1,11 +1,26 @@
 #include <oimo/collision/broadphase/dbvt/dbvt.h>
 
+#include <algorithm>
+#include <array>
+
 #include <oimo/collision/broadphase/aabb.h>
 #include <oimo/collision/broadphase/dbvt/dbvt_node.h>
 
 namespace OIMO {
 
-DBVT::DBVT() : root{nullptr}, _numFreeNodes{0}, _aabb{make_unique<AABB>()}
+namespace {
+
+// The number of bins along the split axis of the surface area heuristic
+const unsigned int SAH_BINS = 16;
+
+float centroid(const DBVTNode* node, unsigned int axis)
+{
+  return 0.5f * (node->aabb.elements[axis] + node->aabb.elements[axis + 3]);
+}
+
+} // end of anonymous namespace
+
+DBVT::DBVT() : root{nullptr}, _aabb{make_unique<AABB>()}
 {
 }
 
@@ -25,7 +40,7 @@ void DBVT::insertLeaf(DBVTNode* leaf)
     root = leaf;
     return;
   }
-  auto lb      = leaf->aabb.get();
+  auto lb      = &leaf->aabb;
   auto sibling = root;
   DBVTNode *c1 = nullptr, *c2 = nullptr;
   DBVTNode *oldParent = nullptr, *newParent = nullptr;
@@ -37,9 +52,9 @@ void DBVT::insertLeaf(DBVTNode* leaf)
     // descend the node to search the best pair
     c1      = sibling->child1;
     c2      = sibling->child2;
-    b       = sibling->aabb.get();
-    c1b     = c1->aabb.get();
-    c2b     = c2->aabb.get();
+    b       = &sibling->aabb;
+    c1b     = &c1->aabb;
+    c2b     = &c2->aabb;
     oldArea = b->surfaceArea();
     _aabb->combine(*lb, *b);
     newArea      = _aabb->surfaceArea();
@@ -84,18 +99,12 @@ void DBVT::insertLeaf(DBVTNode* leaf)
     }
   }
   oldParent = sibling->parent;
-  if (_numFreeNodes > 0) {
-    newParent = _freeNodes[--_numFreeNodes];
-  }
-  else {
-    _freeList.emplace_back(make_unique<DBVTNode>());
-    newParent = _freeList.back().get();
-  }
+  newParent = _allocateNode();
 
   newParent->parent = oldParent;
   newParent->child1 = leaf;
   newParent->child2 = sibling;
-  newParent->aabb->combine(*leaf->aabb, *sibling->aabb);
+  newParent->aabb.combine(leaf->aabb, sibling->aabb);
   newParent->height = sibling->height + 1;
   sibling->parent   = newParent;
   leaf->parent      = newParent;
@@ -145,6 +154,7 @@ void DBVT::deleteLeaf(DBVTNode* leaf)
   if (parent == root) {
     root            = sibling;
     sibling->parent = nullptr;
+    _freeNode(parent);
     return;
   }
   auto grandParent = parent->parent;
@@ -155,9 +165,7 @@ void DBVT::deleteLeaf(DBVTNode* leaf)
   else {
     grandParent->child2 = sibling;
   }
-  if (_numFreeNodes < 16384) {
-    _freeNodes[_numFreeNodes++] = parent;
-  }
+  _freeNode(parent);
   do {
     grandParent = _balance(grandParent);
     _fix(grandParent);
@@ -165,6 +173,217 @@ void DBVT::deleteLeaf(DBVTNode* leaf)
   } while (grandParent != nullptr);
 }
 
+void DBVT::refitLeaf(DBVTNode* leaf, const AABB& aabb)
+{
+  // The ancestors still bound the leaf when its parent contains the new AABB
+  if (leaf->parent != nullptr && !aabb.intersectTestTwo(leaf->parent->aabb)) {
+    leaf->aabb = aabb;
+    return;
+  }
+  deleteLeaf(leaf);
+  leaf->aabb = aabb;
+  insertLeaf(leaf);
+}
+
+void DBVT::query(const AABB& aabb, std::vector<DBVTNode*>& leaves)
+{
+  leaves.clear();
+  if (root == nullptr) {
+    return;
+  }
+  _stack.clear();
+  _stack.emplace_back(root);
+  while (!_stack.empty()) {
+    auto node = _stack.back();
+    _stack.pop_back();
+    if (aabb.intersectTest(node->aabb)) {
+      continue;
+    }
+    if (node->proxy != nullptr) {
+      leaves.emplace_back(node);
+    }
+    else {
+      _stack.emplace_back(node->child1);
+      _stack.emplace_back(node->child2);
+    }
+  }
+}
+
+float DBVT::cost()
+{
+  if (root == nullptr || root->proxy != nullptr) {
+    return 0.f;
+  }
+  float area = 0.f;
+  _stack.clear();
+  _stack.emplace_back(root);
+  while (!_stack.empty()) {
+    auto node = _stack.back();
+    _stack.pop_back();
+    if (node->proxy == nullptr) {
+      area += node->aabb.surfaceArea();
+      _stack.emplace_back(node->child1);
+      _stack.emplace_back(node->child2);
+    }
+  }
+  const float rootArea = root->aabb.surfaceArea();
+  return rootArea > 0.f ? area / rootArea : 0.f;
+}
+
+void DBVT::rebuild()
+{
+  if (root == nullptr) {
+    return;
+  }
+  // Collect the leaves and recycle the internal nodes
+  _leaves.clear();
+  _stack.clear();
+  _stack.emplace_back(root);
+  while (!_stack.empty()) {
+    auto node = _stack.back();
+    _stack.pop_back();
+    if (node->proxy != nullptr) {
+      _leaves.emplace_back(node);
+    }
+    else {
+      _stack.emplace_back(node->child1);
+      _stack.emplace_back(node->child2);
+      _freeNode(node);
+    }
+  }
+  root         = _build(_leaves.data(), _leaves.size());
+  root->parent = nullptr;
+}
+
+DBVTNode* DBVT::_allocateNode()
+{
+  if (!_freeNodes.empty()) {
+    auto node = _freeNodes.back();
+    _freeNodes.pop_back();
+    return node;
+  }
+  _nodes.emplace_back();
+  return &_nodes.back();
+}
+
+void DBVT::_freeNode(DBVTNode* node)
+{
+  _freeNodes.emplace_back(node);
+}
+
+DBVTNode* DBVT::_build(DBVTNode** leaves, size_t numLeaves)
+{
+  if (numLeaves == 1) {
+    return leaves[0];
+  }
+
+  // Split along the axis on which the centroids spread the most
+  std::array<float, 3> lower, upper;
+  for (unsigned int axis = 0; axis < 3; ++axis) {
+    lower[axis] = upper[axis] = centroid(leaves[0], axis);
+  }
+  for (size_t i = 1; i < numLeaves; ++i) {
+    for (unsigned int axis = 0; axis < 3; ++axis) {
+      const float c = centroid(leaves[i], axis);
+      lower[axis]   = std::min(lower[axis], c);
+      upper[axis]   = std::max(upper[axis], c);
+    }
+  }
+  unsigned int axis = 0;
+  for (unsigned int i = 1; i < 3; ++i) {
+    if (upper[i] - lower[i] > upper[axis] - lower[axis]) {
+      axis = i;
+    }
+  }
+
+  size_t numLeft     = 0;
+  const float extent = upper[axis] - lower[axis];
+  if (extent > 0.f) {
+    // Bin the leaves by centroid and take the split of lowest cost
+    const float origin = lower[axis];
+    const float scale  = static_cast<float>(SAH_BINS) / extent;
+    auto binOf         = [axis, origin, scale](const DBVTNode* leaf) {
+      const auto bin = static_cast<unsigned int>(
+        (centroid(leaf, axis) - origin) * scale);
+      return std::min(bin, SAH_BINS - 1);
+    };
+    std::array<AABB, SAH_BINS> bounds;
+    std::array<size_t, SAH_BINS> counts{};
+    for (size_t i = 0; i < numLeaves; ++i) {
+      const unsigned int bin = binOf(leaves[i]);
+      if (counts[bin]++ == 0) {
+        bounds[bin] = leaves[i]->aabb;
+      }
+      else {
+        bounds[bin].combine(bounds[bin], leaves[i]->aabb);
+      }
+    }
+    // Areas of the bins below each split, then cost with the bins above
+    std::array<float, SAH_BINS> leftArea;
+    std::array<size_t, SAH_BINS> leftCount;
+    AABB box;
+    size_t count = 0;
+    for (unsigned int bin = 0; bin + 1 < SAH_BINS; ++bin) {
+      if (counts[bin] > 0 && count == 0) {
+        box = bounds[bin];
+      }
+      else if (counts[bin] > 0) {
+        box.combine(box, bounds[bin]);
+      }
+      count += counts[bin];
+      leftArea[bin]  = count > 0 ? box.surfaceArea() : 0.f;
+      leftCount[bin] = count;
+    }
+    float bestCost         = 0.f;
+    unsigned int bestSplit = SAH_BINS;
+    count                  = 0;
+    for (unsigned int bin = SAH_BINS - 1; bin > 0; --bin) {
+      if (counts[bin] > 0 && count == 0) {
+        box = bounds[bin];
+      }
+      else if (counts[bin] > 0) {
+        box.combine(box, bounds[bin]);
+      }
+      count += counts[bin];
+      if (count == 0 || leftCount[bin - 1] == 0) {
+        continue;
+      }
+      const float cost
+        = leftArea[bin - 1] * static_cast<float>(leftCount[bin - 1])
+          + box.surfaceArea() * static_cast<float>(count);
+      if (bestSplit == SAH_BINS || cost < bestCost) {
+        bestCost  = cost;
+        bestSplit = bin;
+      }
+    }
+    if (bestSplit < SAH_BINS) {
+      numLeft = static_cast<size_t>(
+        std::partition(leaves, leaves + numLeaves,
+                       [&](const DBVTNode* leaf) {
+                         return binOf(leaf) < bestSplit;
+                       })
+        - leaves);
+    }
+  }
+  if (numLeft == 0 || numLeft == numLeaves) {
+    // The centroids do not separate, split at the median
+    numLeft = numLeaves / 2;
+    std::nth_element(leaves, leaves + numLeft, leaves + numLeaves,
+                     [axis](const DBVTNode* a, const DBVTNode* b) {
+                       return centroid(a, axis) < centroid(b, axis);
+                     });
+  }
+
+  auto node            = _allocateNode();
+  node->proxy          = nullptr;
+  node->child1         = _build(leaves, numLeft);
+  node->child2         = _build(leaves + numLeft, numLeaves - numLeft);
+  node->child1->parent = node;
+  node->child2->parent = node;
+  _fix(node);
+  return node;
+}
+
 DBVTNode* DBVT::_balance(DBVTNode* node)
 {
   auto nh = node->height;
@@ -221,10 +440,10 @@ DBVTNode* DBVT::_balance(DBVTNode* node)
        */
 
       // fix bounds and heights
-      node->aabb->combine(*lr->aabb, *r->aabb);
+      node->aabb.combine(lr->aabb, r->aabb);
       t            = lrh - rh;
       node->height = lrh - (t & t >> 31) + 1;
-      l->aabb->combine(*ll->aabb, *node->aabb);
+      l->aabb.combine(ll->aabb, node->aabb);
       t         = llh - nh;
       l->height = llh - (t & t >> 31) + 1;
     }
@@ -254,11 +473,11 @@ DBVTNode* DBVT::_balance(DBVTNode* node)
        */
 
       // fix bounds and heights
-      node->aabb->combine(*ll->aabb, *r->aabb);
+      node->aabb.combine(ll->aabb, r->aabb);
       t            = llh - rh;
       node->height = llh - (t & t >> 31) + 1;
 
-      l->aabb->combine(*node->aabb, *lr->aabb);
+      l->aabb.combine(node->aabb, lr->aabb);
       t         = nh - lrh;
       l->height = nh - (t & t >> 31) + 1;
     }
@@ -310,10 +529,10 @@ DBVTNode* DBVT::_balance(DBVTNode* node)
        */
 
       // fix bounds and heights
-      node->aabb->combine(*l->aabb, *rr->aabb);
+      node->aabb.combine(l->aabb, rr->aabb);
       t            = lh - rrh;
       node->height = lh - (t & t >> 31) + 1;
-      r->aabb->combine(*rl->aabb, *node->aabb);
+      r->aabb.combine(rl->aabb, node->aabb);
       t         = rlh - nh;
       r->height = rlh - (t & t >> 31) + 1;
     }
@@ -343,10 +562,10 @@ DBVTNode* DBVT::_balance(DBVTNode* node)
        */
 
       // fix bounds and heights
-      node->aabb->combine(*l->aabb, *rl->aabb);
+      node->aabb.combine(l->aabb, rl->aabb);
       t            = lh - rlh;
       node->height = lh - (t & t >> 31) + 1;
-      r->aabb->combine(*node->aabb, *rr->aabb);
+      r->aabb.combine(node->aabb, rr->aabb);
       t         = nh - rrh;
       r->height = nh - (t & t >> 31) + 1;
     }
@@ -372,7 +591,7 @@ void DBVT::_fix(DBVTNode* node)
 {
   auto c1 = node->child1;
   auto c2 = node->child2;
-  node->aabb->combine(*c1->aabb, *c2->aabb);
+  node->aabb.combine(c1->aabb, c2->aabb);
   node->height = c1->height < c2->height ? c2->height + 1 : c1->height + 1;
 }
 
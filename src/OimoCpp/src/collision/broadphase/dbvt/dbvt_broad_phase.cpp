@@ -1,25 +1,35 @@
 #include <oimo/collision/broadphase/dbvt/dbvt_broad_phase.h>
 
 #include <algorithm>
+#include <array>
+#include <limits>
 
 #include <oimo/collision/broadphase/aabb.h>
 #include <oimo/collision/broadphase/dbvt/dbvt.h>
 #include <oimo/collision/broadphase/dbvt/dbvt_node.h>
 #include <oimo/collision/broadphase/dbvt/dbvt_proxy.h>
 #include <oimo/collision/broadphase/proxy.h>
+#include <oimo/collision/query/scene_query.h>
 #include <oimo/collision/shape/shape.h>
+#include <oimo/dynamics/rigid_body.h>
+#include <oimo/dynamics/world.h>
 
 namespace OIMO {
 
 DBVTBroadPhase::DBVTBroadPhase()
     : BroadPhase{}
+    , margin{0.1f}
+    , predictionSteps{2.f}
+    , rebuildEnabled{true}
+    , rebuildThreshold{1.5f}
+    , numMovedLeaves{0}
+    , numRebuilds{0}
     , _tree{make_unique<DBVT>()}
-    , _maxStack{256}
     , _numLeaves{0}
     , _maxLeaves{256}
+    , _baseCost{0.f}
 {
   type = BroadPhase::Type::BR_BOUNDING_VOLUME_TREE;
-  _stack.resize(_maxStack);
   _leaves.reserve(_maxLeaves);
 }
 
@@ -38,7 +48,9 @@ void DBVTBroadPhase::addProxy(Proxy* proxy)
   if (_proxy == nullptr) {
     return;
   }
+  _fatten(*_proxy, _proxy->leaf->aabb);
   _tree->insertLeaf(_proxy->leaf.get());
+  _proxy->inserted = true;
   _leaves.emplace_back(_proxy->leaf.get());
   ++_numLeaves;
 }
@@ -50,6 +62,18 @@ void DBVTBroadPhase::removeProxy(Proxy* proxy)
     return;
   }
   _tree->deleteLeaf(_proxy->leaf.get());
+  _removedIds.emplace_back(_proxy->shape->id);
+  if (_proxy->moveIndex >= 0) {
+    // Refitted by prepareQueries, replaced by the last moved leaf
+    const auto index      = static_cast<size_t>(_proxy->moveIndex);
+    auto last             = _movedLeaves.back();
+    _movedLeaves[index]   = last;
+    _previousAABBs[index] = _previousAABBs.back();
+    _movedLeaves.pop_back();
+    _previousAABBs.pop_back();
+    last->proxy->moveIndex = _proxy->moveIndex;
+    _proxy->moveIndex      = -1;
+  }
   auto it = std::find_if(
     _leaves.begin(), _leaves.end(),
     [_proxy](const DBVTNode* node) { return node == _proxy->leaf.get(); });
@@ -61,69 +85,205 @@ void DBVTBroadPhase::removeProxy(Proxy* proxy)
 
 void DBVTBroadPhase::collectPairs()
 {
-  if (_numLeaves < 2) {
-    return;
-  }
-  DBVTNode* leaf = nullptr;
-  float margin   = 0.1f;
-  for (unsigned int i = _numLeaves - 1; i-- > 0;) {
-    leaf = _leaves[i];
-    if (leaf->proxy->aabb->intersectTestTwo(*leaf->aabb)) {
-      leaf->aabb->copy(*leaf->proxy->aabb, margin);
-      _tree->deleteLeaf(leaf);
-      _tree->insertLeaf(leaf);
-      _collide(leaf, _tree->root);
+  _removePairs();
+  _updateLeaves();
+
+  // Report the cached pairs whose proxies overlap, and forget the ones whose
+  // leaves stopped overlapping
+  Shape *s1 = nullptr, *s2 = nullptr;
+  size_t numCached = 0;
+  for (const auto& pair : _pairCache) {
+    if (pair.leaf1->aabb.intersectTest(pair.leaf2->aabb)) {
+      continue;
+    }
+    _pairCache[numCached++] = pair;
+    ++numPairChecks;
+    auto p1 = pair.leaf1->proxy;
+    auto p2 = pair.leaf2->proxy;
+    s1      = p1->shape;
+    s2      = p2->shape;
+    if ((!p1->isDynamic() && !p2->isDynamic())
+        || s1->aabb->intersectTest(*s2->aabb) || !isAvailablePair(s1, s2)) {
+      continue;
     }
+    addPair(s1, s2);
   }
+  _pairCache.resize(numCached);
 }
 
-void DBVTBroadPhase::_collide(DBVTNode* node1, DBVTNode* node2)
+void DBVTBroadPhase::_removePairs()
 {
-  bool l1 = false, l2 = false;
-  unsigned int stackCount = 2;
-  DBVTNode *n1 = nullptr, *n2 = nullptr;
-  Shape *s1 = nullptr, *s2 = nullptr;
-  _stack[0] = node1;
-  _stack[1] = node2;
-
-  while (stackCount > 0) {
-
-    n1 = _stack[--stackCount];
-    n2 = _stack[--stackCount];
-    l1 = (n1->proxy != nullptr);
-    l2 = (n2->proxy != nullptr);
+  if (_removedIds.empty()) {
+    return;
+  }
+  std::sort(_removedIds.begin(), _removedIds.end());
+  auto isRemoved = [this](unsigned int id) {
+    return std::binary_search(_removedIds.begin(), _removedIds.end(), id);
+  };
+  _pairCache.erase(std::remove_if(_pairCache.begin(), _pairCache.end(),
+                                  [&isRemoved](const LeafPair& pair) {
+                                    return isRemoved(pair.id1)
+                                           || isRemoved(pair.id2);
+                                  }),
+                   _pairCache.end());
+  _removedIds.clear();
+}
 
-    ++numPairChecks;
+void DBVTBroadPhase::prepareQueries()
+{
+  _refitLeaves();
+}
 
-    if (l1 && l2) {
-      s1 = n1->proxy->shape;
-      s2 = n2->proxy->shape;
-      if (s1 == s2 || s1->aabb->intersectTest(*s2->aabb)
-          || !isAvailablePair(s1, s2)) {
+void DBVTBroadPhase::queryAABBs(const AABB* aabbs, size_t numAABBs,
+                                std::vector<Shape*>& shapes,
+                                std::vector<unsigned int>& offsets) const
+{
+  shapes.clear();
+  offsets.clear();
+  std::vector<const DBVTNode*> stack;
+  for (size_t i = 0; i < numAABBs; ++i) {
+    offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+    if (_tree->root == nullptr) {
+      continue;
+    }
+    stack.emplace_back(_tree->root);
+    while (!stack.empty()) {
+      auto node = stack.back();
+      stack.pop_back();
+      if (aabbs[i].intersectTest(node->aabb)) {
         continue;
       }
-      addPair(s1, s2);
+      if (node->proxy == nullptr) {
+        stack.emplace_back(node->child1);
+        stack.emplace_back(node->child2);
+      }
+      else if (!aabbs[i].intersectTest(*node->proxy->aabb)) {
+        shapes.emplace_back(node->proxy->shape);
+      }
     }
-    else {
-      if (n1->aabb->intersectTest(*n2->aabb)) {
+  }
+  offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+}
+
+void DBVTBroadPhase::queryRays(const RayQuery* queries, size_t numQueries,
+                               std::vector<Shape*>& shapes,
+                               std::vector<unsigned int>& offsets) const
+{
+  shapes.clear();
+  offsets.clear();
+  std::vector<const DBVTNode*> stack;
+  for (size_t i = 0; i < numQueries; ++i) {
+    offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+    if (_tree->root == nullptr) {
+      continue;
+    }
+    const RaySegment segment(queries[i]);
+    stack.emplace_back(_tree->root);
+    while (!stack.empty()) {
+      auto node = stack.back();
+      stack.pop_back();
+      if (!segment.intersects(node->aabb)) {
         continue;
       }
-      if (stackCount + 4 >= _maxStack) { // expand the stack
-        _maxStack *= 2;
-        _stack.resize(_maxStack);
+      if (node->proxy == nullptr) {
+        stack.emplace_back(node->child1);
+        stack.emplace_back(node->child2);
+      }
+      else if (segment.intersects(*node->proxy->aabb)) {
+        shapes.emplace_back(node->proxy->shape);
       }
-      if (l2 || (!l1 && (n1->aabb->surfaceArea() > n2->aabb->surfaceArea()))) {
-        _stack[stackCount++] = n1->child1;
-        _stack[stackCount++] = n2;
-        _stack[stackCount++] = n1->child2;
-        _stack[stackCount++] = n2;
+    }
+  }
+  offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+}
+
+void DBVTBroadPhase::_refitLeaves()
+{
+  // A new leaf has no previous AABB, which is stored as an empty one
+  const float inf = std::numeric_limits<float>::max();
+  const AABB empty(inf, -inf, inf, -inf, inf, -inf);
+  for (unsigned int i = _numLeaves; i-- > 0;) {
+    auto leaf  = _leaves[i];
+    auto proxy = leaf->proxy;
+    if (!proxy->inserted && !proxy->aabb->intersectTestTwo(leaf->aabb)) {
+      continue;
+    }
+    if (proxy->moveIndex < 0) {
+      proxy->moveIndex = static_cast<int>(_movedLeaves.size());
+      _movedLeaves.emplace_back(leaf);
+      _previousAABBs.emplace_back(proxy->inserted ? empty : leaf->aabb);
+    }
+    if (!proxy->inserted) {
+      _fatten(*proxy, _fatAABB);
+      _tree->refitLeaf(leaf, _fatAABB);
+    }
+    proxy->inserted = false;
+  }
+}
+
+void DBVTBroadPhase::_updateLeaves()
+{
+  _refitLeaves();
+  numMovedLeaves = static_cast<unsigned int>(_movedLeaves.size());
+
+  // The first rebuild replaces the tree built by insertion
+  if (rebuildEnabled && numMovedLeaves > 0
+      && (_baseCost <= 0.f
+          || _tree->cost() > rebuildThreshold * _baseCost
+                               * static_cast<float>(_numLeaves))) {
+    _tree->rebuild();
+    _baseCost = _tree->cost() / static_cast<float>(_numLeaves);
+    ++numRebuilds;
+  }
+
+  // Query the refitted tree with the moved leaves. A pair is new when the
+  // previous AABB of its leaves did not overlap, and a pair of moved leaves
+  // is added by the first of them.
+  for (unsigned int i = 0; i < numMovedLeaves; ++i) {
+    auto leaf       = _movedLeaves[i];
+    const int index = static_cast<int>(i);
+    _tree->query(leaf->aabb, _overlaps);
+    for (auto other : _overlaps) {
+      const int otherIndex = other->proxy->moveIndex;
+      if (other == leaf || (otherIndex >= 0 && otherIndex < index)) {
+        continue;
       }
-      else {
-        _stack[stackCount++] = n1;
-        _stack[stackCount++] = n2->child1;
-        _stack[stackCount++] = n1;
-        _stack[stackCount++] = n2->child2;
+      const AABB& previous = otherIndex >= 0 ?
+                               _previousAABBs[static_cast<size_t>(otherIndex)] :
+                               other->aabb;
+      if (!_previousAABBs[i].intersectTest(previous)) {
+        continue;
       }
+      _pairCache.emplace_back(LeafPair{leaf, other, leaf->proxy->shape->id,
+                                       other->proxy->shape->id});
+    }
+  }
+  for (auto leaf : _movedLeaves) {
+    leaf->proxy->moveIndex = -1;
+  }
+  _movedLeaves.clear();
+  _previousAABBs.clear();
+}
+
+void DBVTBroadPhase::_fatten(const DBVTProxy& proxy, AABB& aabb) const
+{
+  aabb.copy(*proxy.aabb, margin);
+  auto body = proxy.shape->parent;
+  if (body->parent == nullptr || !proxy.isDynamic()) {
+    return;
+  }
+  // Extend the AABB on the side the rigid body is moving to
+  const float time = predictionSteps * body->parent->timeStep;
+  auto& te         = aabb.elements;
+  const std::array<float, 3> displacement{{body->linearVelocity.x * time,
+                                           body->linearVelocity.y * time,
+                                           body->linearVelocity.z * time}};
+  for (unsigned int i = 0; i < 3; ++i) {
+    if (displacement[i] < 0.f) {
+      te[i] += displacement[i];
+    }
+    else {
+      te[i + 3] += displacement[i];
     }
   }
 }
@@ -1,7 +1,5 @@
 #include <oimo/collision/broadphase/dbvt/dbvt_node.h>
 
-#include <oimo/collision/broadphase/aabb.h>
-
 namespace OIMO {
 
 DBVTNode::DBVTNode()
@@ -10,7 +8,6 @@ DBVTNode::DBVTNode()
     , parent{nullptr}
     , proxy{nullptr}
     , height{0}
-    , aabb{make_unique<AABB>()}
 {
 }
 
@@ -2,10 +2,12 @@
 
 #include <oimo/collision/broadphase/dbvt/dbvt_node.h>
 #include <oimo/collision/shape/shape.h>
+#include <oimo/dynamics/rigid_body.h>
 
 namespace OIMO {
 
-DBVTProxy::DBVTProxy(Shape* _shape) : Proxy{_shape}
+DBVTProxy::DBVTProxy(Shape* _shape)
+    : Proxy{_shape}, inserted{false}, moveIndex{-1}
 {
   leaf        = make_unique<DBVTNode>();
   leaf->proxy = this;
@@ -17,7 +19,8 @@ DBVTProxy::~DBVTProxy()
 
 bool DBVTProxy::isDynamic() const
 {
-  return false;
+  auto body = shape->parent;
+  return body->isDynamic && !body->sleeping;
 }
 
 void DBVTProxy::update()
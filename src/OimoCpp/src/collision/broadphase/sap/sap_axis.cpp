@@ -1,7 +1,5 @@
 #include <oimo/collision/broadphase/sap/sap_axis.h>
 
-#include <cmath>
-
 #include <oimo/collision/broadphase/sap/sap_element.h>
 
 namespace OIMO {
@@ -41,9 +39,11 @@ void SAPAxis::removeElements(SAPElement* min, SAPElement* max)
       }
     }
   }
-  unsigned int _maxIndex
-    = (maxIndex < 0) ? 0 : static_cast<unsigned int>(maxIndex);
-  for (unsigned int i = _maxIndex + 1; i < _maxIndex; ++i) {
+  if (maxIndex < 0) {
+    return;
+  }
+  for (unsigned int i = static_cast<unsigned int>(minIndex + 1);
+       i < static_cast<unsigned int>(maxIndex); ++i) {
     elements[i - 1] = elements[i];
   }
   for (unsigned int i = static_cast<unsigned int>(maxIndex + 1);
@@ -92,18 +92,19 @@ void SAPAxis::sort()
   }
   count    = 2;
   stack[0] = 0;
-  stack[1] = numElements - 1;
+  stack[1] = static_cast<int>(numElements) - 1;
 
+  // Signed indices, a partition at the start of a range pushes an empty range
+  // ending at left - 1
   SAPElement *ei = nullptr, *ej = nullptr;
-  unsigned int i = 0, j = 0;
+  int i = 0, j = 0;
   while (count > 0) {
-    unsigned int right = stack[--count];
-    unsigned int left  = stack[--count];
-    unsigned int diff  = right - left;
+    int right = stack[--count];
+    int left  = stack[--count];
+    int diff  = right - left;
     if (diff > 16) { // quick sort
       // var mid=left+(diff>>1);
-      unsigned int mid = left + static_cast<unsigned int>(
-                                  std::floor(static_cast<float>(diff) * 0.5f));
+      int mid = left + (diff >> 1);
       tmp             = elements[mid];
       elements[mid]   = elements[right];
       elements[right] = tmp;
@@ -1,5 +1,8 @@
 #include <oimo/collision/broadphase/sap/sap_broad_phase.h>
 
+#include <algorithm>
+
+#include <oimo/collision/broadphase/aabb.h>
 #include <oimo/collision/broadphase/proxy.h>
 #include <oimo/collision/broadphase/sap/sap_axis.h>
 #include <oimo/collision/broadphase/sap/sap_element.h>
@@ -9,7 +12,12 @@
 namespace OIMO {
 
 SAPBroadPhase::SAPBroadPhase()
-    : BroadPhase{}, _numElementsD{0}, _numElementsS{0}, _index1{0}, _index2{1}
+    : BroadPhase{}
+    , _numElementsD{0}
+    , _numElementsS{0}
+    , _index1{0}
+    , _index2{1}
+    , _maxExtent{0.f}
 {
   type = BroadPhase::Type::BR_SWEEP_AND_PRUNE;
   // dynamic proxies
@@ -89,35 +97,39 @@ void SAPBroadPhase::removeProxy(Proxy* proxy)
 
 void SAPBroadPhase::collectPairs()
 {
+  _moveProxies();
+
   if (_numElementsD == 0) {
     return;
   }
 
-  SAPAxis& axis1 = _axesD[_index1];
-  SAPAxis& axis2 = _axesD[_index2];
+  SAPAxis* axis1 = &_axesD[_index1];
+  SAPAxis* axis2 = &_axesD[_index2];
 
-  axis1.sort();
-  axis2.sort();
+  axis1->sort();
+  axis2->sort();
 
-  int count1 = axis1.calculateTestCount();
-  int count2 = axis2.calculateTestCount();
-  std::vector<SAPElement*> elementsD;
-  std::vector<SAPElement*> elementsS;
+  int count1 = axis1->calculateTestCount();
+  int count2 = axis2->calculateTestCount();
+  const std::vector<SAPElement*>* sortedD = nullptr;
+  const std::vector<SAPElement*>* sortedS = nullptr;
   if (count1 <= count2) { // select the best axis
-    axis2 = _axesS[_index1];
-    axis2.sort();
-    elementsD = axis1.elements;
-    elementsS = axis2.elements;
+    axis2 = &_axesS[_index1];
+    axis2->sort();
+    sortedD = &axis1->elements;
+    sortedS = &axis2->elements;
   }
   else {
-    axis1 = _axesS[_index2];
-    axis1.sort();
-    elementsD = axis2.elements;
-    elementsS = axis1.elements;
+    axis1 = &_axesS[_index2];
+    axis1->sort();
+    sortedD = &axis2->elements;
+    sortedS = &axis1->elements;
     _index1 ^= _index2;
     _index2 ^= _index1;
     _index1 ^= _index2;
   }
+  const auto& elementsD = *sortedD;
+  const auto& elementsS = *sortedS;
   unsigned int p = 0, q = 0;
   SAPElement *activeD = nullptr, *activeS = nullptr;
   SAPElement *s = nullptr, *d = nullptr;
@@ -218,4 +230,65 @@ void SAPBroadPhase::collectPairs()
   _index2 = (_index1 | _index2) ^ 3;
 }
 
+void SAPBroadPhase::prepareQueries()
+{
+  _maxExtent = 0.f;
+  for (auto axis : {&_axesD[0], &_axesS[0]}) {
+    axis->sort();
+    for (unsigned int i = 0; i < axis->numElements; ++i) {
+      auto element = axis->elements[i];
+      if (element->max) {
+        _maxExtent = std::max(_maxExtent,
+                              element->value - element->pair->value);
+      }
+    }
+  }
+}
+
+void SAPBroadPhase::queryAABBs(const AABB* aabbs, size_t numAABBs,
+                               std::vector<Shape*>& shapes,
+                               std::vector<unsigned int>& offsets) const
+{
+  // A proxy overlapping an AABB along the first axis has its minimum between
+  // the minimum of the AABB less the widest extent and the maximum of the AABB
+  const auto lessThan = [](const SAPElement* element, float value) {
+    return element->value < value;
+  };
+  shapes.clear();
+  offsets.clear();
+  for (size_t i = 0; i < numAABBs; ++i) {
+    offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+    const auto& te = aabbs[i].elements;
+    for (auto axis : {&_axesD[0], &_axesS[0]}) {
+      const auto end = axis->elements.begin() + axis->numElements;
+      for (auto it = std::lower_bound(axis->elements.begin(), end,
+                                      te[0] - _maxExtent, lessThan);
+           it != end && (*it)->value <= te[3]; ++it) {
+        if (!(*it)->max && !aabbs[i].intersectTest(*(*it)->proxy->aabb)) {
+          shapes.emplace_back((*it)->proxy->shape);
+        }
+      }
+    }
+  }
+  offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+}
+
+void SAPBroadPhase::_moveProxies()
+{
+  _movedProxies.clear();
+  for (auto axis : {&_axesD[0], &_axesS[0]}) {
+    for (unsigned int i = 0; i < axis->numElements; ++i) {
+      auto element = axis->elements[i];
+      if (!element->max
+          && element->proxy->isDynamic() != (element->proxy->belongsTo == 1)) {
+        _movedProxies.emplace_back(element->proxy);
+      }
+    }
+  }
+  for (auto proxy : _movedProxies) {
+    removeProxy(proxy);
+    addProxy(proxy);
+  }
+}
+
 } // end of namespace OIMO
@@ -53,11 +53,7 @@ void SAPProxy::update()
   max[0].value = te[3];
   max[1].value = te[4];
   max[2].value = te[5];
-
-  if ((belongsTo == 1 && !isDynamic()) || (belongsTo == 2 && isDynamic())) {
-    sap->removeProxy(this);
-    sap->addProxy(this);
-  }
+  // A proxy which belongs to the wrong axes is moved by the broad-phase
 }
 
 } // end of namespace OIMO
@@ -0,0 +1,349 @@
+#include <oimo/collision/broadphase/sap/simd_sap_broad_phase.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include <xmmintrin.h>
+
+#include <oimo/collision/broadphase/aabb.h>
+#include <oimo/collision/broadphase/proxy.h>
+#include <oimo/collision/broadphase/sap/simd_sap_proxy.h>
+#include <oimo/collision/shape/shape.h>
+
+namespace OIMO {
+
+namespace {
+
+// The radix sort sorts 32-bit keys in 3 passes of 11 bits
+const unsigned int RADIX_BITS    = 11;
+const unsigned int RADIX_BUCKETS = 1 << RADIX_BITS;
+
+// The number of bits set in a 4-bit mask
+const int BIT_COUNTS[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+// Maps a float to an unsigned integer with the same order
+uint32_t sortKey(float value)
+{
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits ^ ((bits >> 31) != 0 ? 0xffffffffu : 0x80000000u);
+}
+
+} // end of anonymous namespace
+
+SIMDSAPBroadPhase::SIMDSAPBroadPhase()
+    : BroadPhase{}, sweepAxis{0}, numRadixSorts{0}, _orderValid{true}
+{
+  type = BroadPhase::Type::BR_SIMD_SWEEP_AND_PRUNE;
+}
+
+SIMDSAPBroadPhase::~SIMDSAPBroadPhase()
+{
+}
+
+std::unique_ptr<Proxy> SIMDSAPBroadPhase::createProxy(Shape* shape)
+{
+  return make_unique<SIMDSAPProxy>(this, shape);
+}
+
+void SIMDSAPBroadPhase::addProxy(Proxy* proxy)
+{
+  auto p = dynamic_cast<SIMDSAPProxy*>(proxy);
+  if (p == nullptr || p->slot >= 0) {
+    return;
+  }
+  const auto slot = static_cast<unsigned int>(_proxies.size());
+  p->slot         = static_cast<int>(slot);
+  _proxies.emplace_back(p);
+  for (auto& bounds : _bounds) {
+    bounds.emplace_back(0.f);
+  }
+  updateBounds(*p);
+  // The new slot is moved to its place by the next insertion sort
+  if (_orderValid) {
+    _order.emplace_back(slot);
+  }
+}
+
+void SIMDSAPBroadPhase::removeProxy(Proxy* proxy)
+{
+  auto p = dynamic_cast<SIMDSAPProxy*>(proxy);
+  if (p == nullptr || p->slot < 0) {
+    return;
+  }
+  // Move the last slot into the removed one
+  const auto slot = static_cast<size_t>(p->slot);
+  auto last       = _proxies.back();
+  _proxies[slot]  = last;
+  last->slot      = p->slot;
+  _proxies.pop_back();
+  for (auto& bounds : _bounds) {
+    bounds[slot] = bounds.back();
+    bounds.pop_back();
+  }
+  p->slot     = -1;
+  _orderValid = false;
+}
+
+void SIMDSAPBroadPhase::updateBounds(const SIMDSAPProxy& proxy)
+{
+  const auto slot = static_cast<size_t>(proxy.slot);
+  const auto& te  = proxy.aabb->elements;
+  for (unsigned int i = 0; i < 6; ++i) {
+    _bounds[i][slot] = te[i];
+  }
+}
+
+void SIMDSAPBroadPhase::collectPairs()
+{
+  if (_proxies.size() < 2) {
+    return;
+  }
+  _sort();
+  _gather();
+  _sweep();
+}
+
+void SIMDSAPBroadPhase::queryAABBs(const AABB* aabbs, size_t numAABBs,
+                                   std::vector<Shape*>& shapes,
+                                   std::vector<unsigned int>& offsets) const
+{
+  // The bounds of the slots are tested four at a time on the three axes
+  shapes.clear();
+  offsets.clear();
+  const size_t n = _proxies.size();
+  for (size_t i = 0; i < numAABBs; ++i) {
+    offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+    const auto& te = aabbs[i].elements;
+    __m128 bounds[6];
+    for (unsigned int k = 0; k < 6; ++k) {
+      bounds[k] = _mm_set1_ps(te[k]);
+    }
+    size_t slot = 0;
+    for (; slot + 4 <= n; slot += 4) {
+      __m128 overlap
+        = _mm_cmple_ps(bounds[0], _mm_loadu_ps(&_bounds[3][slot]));
+      for (unsigned int k = 0; k < 3; ++k) {
+        const __m128 min = _mm_loadu_ps(&_bounds[k][slot]);
+        const __m128 max = _mm_loadu_ps(&_bounds[k + 3][slot]);
+        overlap = _mm_and_ps(overlap, _mm_cmple_ps(min, bounds[k + 3]));
+        if (k > 0) {
+          overlap = _mm_and_ps(overlap, _mm_cmple_ps(bounds[k], max));
+        }
+      }
+      const int mask = _mm_movemask_ps(overlap);
+      for (unsigned int j = 0; j < 4; ++j) {
+        if ((mask & (1 << j)) != 0) {
+          shapes.emplace_back(_proxies[slot + j]->shape);
+        }
+      }
+    }
+    for (; slot < n; ++slot) {
+      bool overlaps = true;
+      for (unsigned int k = 0; k < 3; ++k) {
+        overlaps = overlaps && _bounds[k][slot] <= te[k + 3]
+                   && te[k] <= _bounds[k + 3][slot];
+      }
+      if (overlaps) {
+        shapes.emplace_back(_proxies[slot]->shape);
+      }
+    }
+  }
+  offsets.emplace_back(static_cast<unsigned int>(shapes.size()));
+}
+
+unsigned int SIMDSAPBroadPhase::_selectAxis() const
+{
+  const size_t n = _proxies.size();
+  std::array<double, 3> variances;
+  for (unsigned int axis = 0; axis < 3; ++axis) {
+    const float* min = _bounds[axis].data();
+    const float* max = _bounds[axis + 3].data();
+    double sum = 0.0, sumSquares = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+      const double center = 0.5 * (static_cast<double>(min[i]) + max[i]);
+      sum += center;
+      sumSquares += center * center;
+    }
+    const double mean = sum / static_cast<double>(n);
+    variances[axis]   = sumSquares / static_cast<double>(n) - mean * mean;
+  }
+  unsigned int best = sweepAxis;
+  for (unsigned int axis = 0; axis < 3; ++axis) {
+    if (variances[axis] > variances[best]) {
+      best = axis;
+    }
+  }
+  // Changing the axis costs a radix sort, the current axis is kept unless
+  // the proxies spread a quarter more along another one
+  return variances[best] > 1.25 * variances[sweepAxis] ? best : sweepAxis;
+}
+
+void SIMDSAPBroadPhase::_sort()
+{
+  const unsigned int axis = _selectAxis();
+  const bool coherent     = _orderValid && axis == sweepAxis;
+  sweepAxis               = axis;
+  if (!coherent || !_insertionSort()) {
+    _radixSort();
+  }
+  _orderValid = true;
+}
+
+bool SIMDSAPBroadPhase::_insertionSort()
+{
+  const auto n        = static_cast<unsigned int>(_order.size());
+  const float* value  = _bounds[sweepAxis].data();
+  unsigned int* order = _order.data();
+
+  // Same threshold as SAPAxis::sort, about n * log2(n) / 4 moves
+  unsigned int threshold = 1;
+  while ((n >> threshold) != 0) {
+    ++threshold;
+  }
+  threshold          = threshold * n >> 2;
+  unsigned int count = 0;
+
+  for (unsigned int i = 1; i < n; ++i) {
+    const unsigned int slot = order[i];
+    const float pivot       = value[slot];
+    unsigned int j          = i;
+    while (j > 0 && value[order[j - 1]] > pivot) {
+      order[j] = order[j - 1];
+      --j;
+    }
+    order[j] = slot;
+    count += i - j;
+    if (count > threshold) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SIMDSAPBroadPhase::_radixSort()
+{
+  const size_t n     = _proxies.size();
+  const float* value = _bounds[sweepAxis].data();
+  _keys.resize(n);
+  _keysTmp.resize(n);
+  _order.resize(n);
+  _orderTmp.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    _keys[i]  = sortKey(value[i]);
+    _order[i] = static_cast<unsigned int>(i);
+  }
+
+  std::array<unsigned int, RADIX_BUCKETS> offsets;
+  for (unsigned int shift = 0; shift < 32; shift += RADIX_BITS) {
+    offsets.fill(0);
+    for (size_t i = 0; i < n; ++i) {
+      ++offsets[(_keys[i] >> shift) & (RADIX_BUCKETS - 1)];
+    }
+    unsigned int sum = 0;
+    for (auto& offset : offsets) {
+      const unsigned int bucketSize = offset;
+      offset                        = sum;
+      sum += bucketSize;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const unsigned int index
+        = offsets[(_keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+      _keysTmp[index]  = _keys[i];
+      _orderTmp[index] = _order[i];
+    }
+    std::swap(_keys, _keysTmp);
+    std::swap(_order, _orderTmp);
+  }
+  ++numRadixSorts;
+}
+
+void SIMDSAPBroadPhase::_gather()
+{
+  const size_t n           = _proxies.size();
+  const unsigned int axis1 = (sweepAxis + 1) % 3;
+  const unsigned int axis2 = (sweepAxis + 2) % 3;
+  // A NaN fails every comparison, so the padding never overlaps
+  const float padding = std::numeric_limits<float>::quiet_NaN();
+  for (auto values :
+       {&_sweepMin, &_sweepMax, &_min1, &_max1, &_min2, &_max2}) {
+    values->resize(n + 3);
+    std::fill(values->begin() + static_cast<std::ptrdiff_t>(n), values->end(),
+              padding);
+  }
+  _dynamic.resize(n);
+
+  const float* sweepMin = _bounds[sweepAxis].data();
+  const float* sweepMax = _bounds[sweepAxis + 3].data();
+  const float* min1     = _bounds[axis1].data();
+  const float* max1     = _bounds[axis1 + 3].data();
+  const float* min2     = _bounds[axis2].data();
+  const float* max2     = _bounds[axis2 + 3].data();
+  for (size_t i = 0; i < n; ++i) {
+    const unsigned int slot = _order[i];
+    _sweepMin[i]            = sweepMin[slot];
+    _sweepMax[i]            = sweepMax[slot];
+    _min1[i]                = min1[slot];
+    _max1[i]                = max1[slot];
+    _min2[i]                = min2[slot];
+    _max2[i]                = max2[slot];
+    _dynamic[i]             = _proxies[slot]->isDynamic() ? 1 : 0;
+  }
+}
+
+void SIMDSAPBroadPhase::_sweep()
+{
+  const auto n          = static_cast<unsigned int>(_proxies.size());
+  const float* sweepMin = _sweepMin.data();
+  const float* sweepMax = _sweepMax.data();
+  const float* min1     = _min1.data();
+  const float* max1     = _max1.data();
+  const float* min2     = _min2.data();
+  const float* max2     = _max2.data();
+
+  for (unsigned int i = 0; i < n; ++i) {
+    const float maxI   = sweepMax[i];
+    const __m128 max0I = _mm_set1_ps(maxI);
+    const __m128 min1I = _mm_set1_ps(min1[i]);
+    const __m128 max1I = _mm_set1_ps(max1[i]);
+    const __m128 min2I = _mm_set1_ps(min2[i]);
+    const __m128 max2I = _mm_set1_ps(max2[i]);
+    Shape* s1          = nullptr;
+    // The proxies j > i start after the minimum of i, so they overlap it along
+    // the sweep axis while they start before its maximum
+    for (unsigned int j = i + 1; j < n && sweepMin[j] <= maxI; j += 4) {
+      const __m128 inRange = _mm_cmple_ps(_mm_loadu_ps(sweepMin + j), max0I);
+      const __m128 overlap1
+        = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min1 + j), max1I),
+                     _mm_cmple_ps(min1I, _mm_loadu_ps(max1 + j)));
+      const __m128 overlap2
+        = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min2 + j), max2I),
+                     _mm_cmple_ps(min2I, _mm_loadu_ps(max2 + j)));
+      const __m128 overlap
+        = _mm_and_ps(inRange, _mm_and_ps(overlap1, overlap2));
+      numPairChecks += BIT_COUNTS[_mm_movemask_ps(inRange)];
+      const int mask = _mm_movemask_ps(overlap);
+      if (mask == 0) {
+        continue;
+      }
+      for (unsigned int k = 0; k < 4; ++k) {
+        const unsigned int other = j + k;
+        if ((mask & (1 << k)) == 0 || (_dynamic[i] | _dynamic[other]) == 0) {
+          continue;
+        }
+        if (s1 == nullptr) {
+          s1 = _proxies[_order[i]]->shape;
+        }
+        Shape* s2 = _proxies[_order[other]]->shape;
+        if (!isAvailablePair(s1, s2)) {
+          continue;
+        }
+        addPair(s1, s2);
+      }
+    }
+  }
+}
+
+} // end of namespace OIMO
@@ -0,0 +1,33 @@
+#include <oimo/collision/broadphase/sap/simd_sap_proxy.h>
+
+#include <oimo/collision/broadphase/sap/simd_sap_broad_phase.h>
+#include <oimo/collision/shape/shape.h>
+#include <oimo/dynamics/rigid_body.h>
+
+namespace OIMO {
+
+SIMDSAPProxy::SIMDSAPProxy(SIMDSAPBroadPhase* _sap, Shape* _shape)
+    : Proxy{_shape}, slot{-1}, sap{_sap}
+{
+}
+
+SIMDSAPProxy::~SIMDSAPProxy()
+{
+}
+
+bool SIMDSAPProxy::isDynamic() const
+{
+  auto body = shape->parent;
+  return body->isDynamic && !body->sleeping;
+}
+
+void SIMDSAPProxy::update()
+{
+  // Only the slot of the proxy is written, so the proxies can be updated from
+  // the island solver threads
+  if (slot >= 0) {
+    sap->updateBounds(*this);
+  }
+}
+
+} // end of namespace OIMO
@@ -1,5 +1,6 @@
 #include <oimo/collision/narrowphase/box_box_collision_detector.h>
 
+#include <array>
 #include <cmath>
 #include <limits>
 
@@ -1536,61 +1537,65 @@ void BoxBoxCollisionDetector::detectCollision(Shape* shape1, Shape* shape2,
   float x1, y1, z1;
   float x2, y2, z2;
   float t;
-  _clipVertices1[0]    = q1x;
-  _clipVertices1[1]    = q1y;
-  _clipVertices1[2]    = q1z;
-  _clipVertices1[3]    = q2x;
-  _clipVertices1[4]    = q2y;
-  _clipVertices1[5]    = q2z;
-  _clipVertices1[6]    = q3x;
-  _clipVertices1[7]    = q3y;
-  _clipVertices1[8]    = q3z;
-  _clipVertices1[9]    = q4x;
-  _clipVertices1[10]   = q4y;
-  _clipVertices1[11]   = q4z;
+  // 8 vertices x,y,z, local so that the detector can run on several threads
+  std::array<float, 24> clipVertices1;
+  std::array<float, 24> clipVertices2;
+  std::array<bool, 8> used;
+  clipVertices1[0]     = q1x;
+  clipVertices1[1]     = q1y;
+  clipVertices1[2]     = q1z;
+  clipVertices1[3]     = q2x;
+  clipVertices1[4]     = q2y;
+  clipVertices1[5]     = q2z;
+  clipVertices1[6]     = q3x;
+  clipVertices1[7]     = q3y;
+  clipVertices1[8]     = q3z;
+  clipVertices1[9]     = q4x;
+  clipVertices1[10]    = q4y;
+  clipVertices1[11]    = q4z;
   numAddedClipVertices = 0;
-  x1                   = _clipVertices1[9];
-  y1                   = _clipVertices1[10];
-  z1                   = _clipVertices1[11];
+  x1                   = clipVertices1[9];
+  y1                   = clipVertices1[10];
+  z1                   = clipVertices1[11];
   dot1 = (x1 - cx - s1x) * n1x + (y1 - cy - s1y) * n1y + (z1 - cz - s1z) * n1z;
 
   for (unsigned int i = 0; i < 4; ++i) {
     index = i * 3;
-    x2    = _clipVertices1[index];
-    y2    = _clipVertices1[index + 1];
-    z2    = _clipVertices1[index + 2];
+    x2    = clipVertices1[index];
+    y2    = clipVertices1[index + 1];
+    z2    = clipVertices1[index + 2];
     dot2
       = (x2 - cx - s1x) * n1x + (y2 - cy - s1y) * n1y + (z2 - cz - s1z) * n1z;
     if (dot1 > 0.f) {
       if (dot2 > 0.f) {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        _clipVertices2[index]     = x2;
-        _clipVertices2[index + 1] = y2;
-        _clipVertices2[index + 2] = z2;
+        clipVertices2[index]     = x2;
+        clipVertices2[index + 1] = y2;
+        clipVertices2[index + 2] = z2;
       }
       else {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        t                         = dot1 / (dot1 - dot2);
-        _clipVertices2[index]     = x1 + (x2 - x1) * t;
-        _clipVertices2[index + 1] = y1 + (y2 - y1) * t;
-        _clipVertices2[index + 2] = z1 + (z2 - z1) * t;
+        t                        = dot1 / (dot1 - dot2);
+        clipVertices2[index]     = x1 + (x2 - x1) * t;
+        clipVertices2[index + 1] = y1 + (y2 - y1) * t;
+        clipVertices2[index + 2] = z1 + (z2 - z1) * t;
       }
     }
     else {
       if (dot2 > 0.f) {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        t                         = dot1 / (dot1 - dot2);
-        _clipVertices2[index]     = x1 + (x2 - x1) * t;
-        _clipVertices2[index + 1] = y1 + (y2 - y1) * t;
-        _clipVertices2[index + 2] = z1 + (z2 - z1) * t;
-        index                     = numAddedClipVertices * 3;
+        t                        = dot1 / (dot1 - dot2);
+        clipVertices2[index]     = x1 + (x2 - x1) * t;
+        clipVertices2[index + 1] = y1 + (y2 - y1) * t;
+        clipVertices2[index + 2] = z1 + (z2 - z1) * t;
+        index                    = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        _clipVertices2[index]     = x2;
-        _clipVertices2[index + 1] = y2;
-        _clipVertices2[index + 2] = z2;
+        clipVertices2[index]     = x2;
+        clipVertices2[index + 1] = y2;
+        clipVertices2[index + 2] = z2;
       }
     }
     x1   = x2;
@@ -1605,48 +1610,48 @@ void BoxBoxCollisionDetector::detectCollision(Shape* shape1, Shape* shape2,
   }
   numAddedClipVertices = 0;
   index                = (numClipVertices - 1) * 3;
-  x1                   = _clipVertices2[index];
-  y1                   = _clipVertices2[index + 1];
-  z1                   = _clipVertices2[index + 2];
+  x1                   = clipVertices2[index];
+  y1                   = clipVertices2[index + 1];
+  z1                   = clipVertices2[index + 2];
   dot1 = (x1 - cx - s2x) * n2x + (y1 - cy - s2y) * n2y + (z1 - cz - s2z) * n2z;
 
   for (unsigned int i = 0; i < numClipVertices; ++i) {
     index = i * 3;
-    x2    = _clipVertices2[index];
-    y2    = _clipVertices2[index + 1];
-    z2    = _clipVertices2[index + 2];
+    x2    = clipVertices2[index];
+    y2    = clipVertices2[index + 1];
+    z2    = clipVertices2[index + 2];
     dot2
       = (x2 - cx - s2x) * n2x + (y2 - cy - s2y) * n2y + (z2 - cz - s2z) * n2z;
     if (dot1 > 0.f) {
       if (dot2 > 0.f) {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        _clipVertices1[index]     = x2;
-        _clipVertices1[index + 1] = y2;
-        _clipVertices1[index + 2] = z2;
+        clipVertices1[index]     = x2;
+        clipVertices1[index + 1] = y2;
+        clipVertices1[index + 2] = z2;
       }
       else {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        t                         = dot1 / (dot1 - dot2);
-        _clipVertices1[index]     = x1 + (x2 - x1) * t;
-        _clipVertices1[index + 1] = y1 + (y2 - y1) * t;
-        _clipVertices1[index + 2] = z1 + (z2 - z1) * t;
+        t                        = dot1 / (dot1 - dot2);
+        clipVertices1[index]     = x1 + (x2 - x1) * t;
+        clipVertices1[index + 1] = y1 + (y2 - y1) * t;
+        clipVertices1[index + 2] = z1 + (z2 - z1) * t;
       }
     }
     else {
       if (dot2 > 0.f) {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        t                         = dot1 / (dot1 - dot2);
-        _clipVertices1[index]     = x1 + (x2 - x1) * t;
-        _clipVertices1[index + 1] = y1 + (y2 - y1) * t;
-        _clipVertices1[index + 2] = z1 + (z2 - z1) * t;
-        index                     = numAddedClipVertices * 3;
+        t                        = dot1 / (dot1 - dot2);
+        clipVertices1[index]     = x1 + (x2 - x1) * t;
+        clipVertices1[index + 1] = y1 + (y2 - y1) * t;
+        clipVertices1[index + 2] = z1 + (z2 - z1) * t;
+        index                    = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        _clipVertices1[index]     = x2;
-        _clipVertices1[index + 1] = y2;
-        _clipVertices1[index + 2] = z2;
+        clipVertices1[index]     = x2;
+        clipVertices1[index + 1] = y2;
+        clipVertices1[index + 2] = z2;
       }
     }
     x1   = x2;
@@ -1661,49 +1666,49 @@ void BoxBoxCollisionDetector::detectCollision(Shape* shape1, Shape* shape2,
   }
   numAddedClipVertices = 0;
   index                = (numClipVertices - 1) * 3;
-  x1                   = _clipVertices1[index];
-  y1                   = _clipVertices1[index + 1];
-  z1                   = _clipVertices1[index + 2];
+  x1                   = clipVertices1[index];
+  y1                   = clipVertices1[index + 1];
+  z1                   = clipVertices1[index + 2];
   dot1
     = (x1 - cx + s1x) * -n1x + (y1 - cy + s1y) * -n1y + (z1 - cz + s1z) * -n1z;
 
   for (unsigned int i = 0; i < numClipVertices; ++i) {
     index = i * 3;
-    x2    = _clipVertices1[index];
-    y2    = _clipVertices1[index + 1];
-    z2    = _clipVertices1[index + 2];
+    x2    = clipVertices1[index];
+    y2    = clipVertices1[index + 1];
+    z2    = clipVertices1[index + 2];
     dot2  = (x2 - cx + s1x) * -n1x + (y2 - cy + s1y) * -n1y
            + (z2 - cz + s1z) * -n1z;
     if (dot1 > 0.f) {
       if (dot2 > 0.f) {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        _clipVertices2[index]     = x2;
-        _clipVertices2[index + 1] = y2;
-        _clipVertices2[index + 2] = z2;
+        clipVertices2[index]     = x2;
+        clipVertices2[index + 1] = y2;
+        clipVertices2[index + 2] = z2;
       }
       else {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        t                         = dot1 / (dot1 - dot2);
-        _clipVertices2[index]     = x1 + (x2 - x1) * t;
-        _clipVertices2[index + 1] = y1 + (y2 - y1) * t;
-        _clipVertices2[index + 2] = z1 + (z2 - z1) * t;
+        t                        = dot1 / (dot1 - dot2);
+        clipVertices2[index]     = x1 + (x2 - x1) * t;
+        clipVertices2[index + 1] = y1 + (y2 - y1) * t;
+        clipVertices2[index + 2] = z1 + (z2 - z1) * t;
       }
     }
     else {
       if (dot2 > 0.f) {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        t                         = dot1 / (dot1 - dot2);
-        _clipVertices2[index]     = x1 + (x2 - x1) * t;
-        _clipVertices2[index + 1] = y1 + (y2 - y1) * t;
-        _clipVertices2[index + 2] = z1 + (z2 - z1) * t;
-        index                     = numAddedClipVertices * 3;
+        t                        = dot1 / (dot1 - dot2);
+        clipVertices2[index]     = x1 + (x2 - x1) * t;
+        clipVertices2[index + 1] = y1 + (y2 - y1) * t;
+        clipVertices2[index + 2] = z1 + (z2 - z1) * t;
+        index                    = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        _clipVertices2[index]     = x2;
-        _clipVertices2[index + 1] = y2;
-        _clipVertices2[index + 2] = z2;
+        clipVertices2[index]     = x2;
+        clipVertices2[index + 1] = y2;
+        clipVertices2[index + 2] = z2;
       }
     }
     x1   = x2;
@@ -1718,49 +1723,49 @@ void BoxBoxCollisionDetector::detectCollision(Shape* shape1, Shape* shape2,
   }
   numAddedClipVertices = 0;
   index                = (numClipVertices - 1) * 3;
-  x1                   = _clipVertices2[index];
-  y1                   = _clipVertices2[index + 1];
-  z1                   = _clipVertices2[index + 2];
+  x1                   = clipVertices2[index];
+  y1                   = clipVertices2[index + 1];
+  z1                   = clipVertices2[index + 2];
   dot1
     = (x1 - cx + s2x) * -n2x + (y1 - cy + s2y) * -n2y + (z1 - cz + s2z) * -n2z;
 
   for (unsigned int i = 0; i < numClipVertices; ++i) {
     index = i * 3;
-    x2    = _clipVertices2[index];
-    y2    = _clipVertices2[index + 1];
-    z2    = _clipVertices2[index + 2];
+    x2    = clipVertices2[index];
+    y2    = clipVertices2[index + 1];
+    z2    = clipVertices2[index + 2];
     dot2  = (x2 - cx + s2x) * -n2x + (y2 - cy + s2y) * -n2y
            + (z2 - cz + s2z) * -n2z;
     if (dot1 > 0.f) {
       if (dot2 > 0.f) {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        _clipVertices1[index]     = x2;
-        _clipVertices1[index + 1] = y2;
-        _clipVertices1[index + 2] = z2;
+        clipVertices1[index]     = x2;
+        clipVertices1[index + 1] = y2;
+        clipVertices1[index + 2] = z2;
       }
       else {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        t                         = dot1 / (dot1 - dot2);
-        _clipVertices1[index]     = x1 + (x2 - x1) * t;
-        _clipVertices1[index + 1] = y1 + (y2 - y1) * t;
-        _clipVertices1[index + 2] = z1 + (z2 - z1) * t;
+        t                        = dot1 / (dot1 - dot2);
+        clipVertices1[index]     = x1 + (x2 - x1) * t;
+        clipVertices1[index + 1] = y1 + (y2 - y1) * t;
+        clipVertices1[index + 2] = z1 + (z2 - z1) * t;
       }
     }
     else {
       if (dot2 > 0.f) {
         index = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        t                         = dot1 / (dot1 - dot2);
-        _clipVertices1[index]     = x1 + (x2 - x1) * t;
-        _clipVertices1[index + 1] = y1 + (y2 - y1) * t;
-        _clipVertices1[index + 2] = z1 + (z2 - z1) * t;
-        index                     = numAddedClipVertices * 3;
+        t                        = dot1 / (dot1 - dot2);
+        clipVertices1[index]     = x1 + (x2 - x1) * t;
+        clipVertices1[index + 1] = y1 + (y2 - y1) * t;
+        clipVertices1[index + 2] = z1 + (z2 - z1) * t;
+        index                    = numAddedClipVertices * 3;
         ++numAddedClipVertices;
-        _clipVertices1[index]     = x2;
-        _clipVertices1[index + 1] = y2;
-        _clipVertices1[index + 2] = z2;
+        clipVertices1[index]     = x2;
+        clipVertices1[index + 1] = y2;
+        clipVertices1[index + 2] = z2;
       }
     }
     x1   = x2;
@@ -1799,12 +1804,12 @@ void BoxBoxCollisionDetector::detectCollision(Shape* shape1, Shape* shape2,
     // i = numClipVertices;
     // while(i--){
     for (unsigned int i = 0; i < numClipVertices; ++i) {
-      _used[i] = false;
-      index    = i * 3;
-      x1       = _clipVertices1[index];
-      y1       = _clipVertices1[index + 1];
-      z1       = _clipVertices1[index + 2];
-      dot      = x1 * n1x + y1 * n1y + z1 * n1z;
+      used[i] = false;
+      index   = i * 3;
+      x1      = clipVertices1[index];
+      y1      = clipVertices1[index + 1];
+      z1      = clipVertices1[index + 2];
+      dot     = x1 * n1x + y1 * n1y + z1 * n1z;
       if (dot < minDot) {
         minDot = dot;
         index1 = i;
@@ -1815,19 +1820,19 @@ void BoxBoxCollisionDetector::detectCollision(Shape* shape1, Shape* shape2,
       }
     }
 
-    _used[index1] = true;
-    _used[index3] = true;
-    maxDot        = -_inf;
-    minDot        = _inf;
+    used[index1] = true;
+    used[index3] = true;
+    maxDot       = -_inf;
+    minDot       = _inf;
 
     for (unsigned int i = 0; i < numClipVertices; ++i) {
-      if (_used[i]) {
+      if (used[i]) {
         continue;
       }
       index = i * 3;
-      x1    = _clipVertices1[index];
-      y1    = _clipVertices1[index + 1];
-      z1    = _clipVertices1[index + 2];
+      x1    = clipVertices1[index];
+      y1    = clipVertices1[index + 1];
+      z1    = clipVertices1[index + 2];
       dot   = x1 * n2x + y1 * n2y + z1 * n2z;
       if (dot < minDot) {
         minDot = dot;
@@ -1840,36 +1845,36 @@ void BoxBoxCollisionDetector::detectCollision(Shape* shape1, Shape* shape2,
     }
 
     index = index1 * 3;
-    x1    = _clipVertices1[index];
-    y1    = _clipVertices1[index + 1];
-    z1    = _clipVertices1[index + 2];
+    x1    = clipVertices1[index];
+    y1    = clipVertices1[index + 1];
+    z1    = clipVertices1[index + 2];
     dot   = (x1 - cx) * nx + (y1 - cy) * ny + (z1 - cz) * nz;
     if (dot < 0.f) {
       manifold->addPoint(x1, y1, z1, nx, ny, nz, dot, flipped);
     }
 
     index = index2 * 3;
-    x1    = _clipVertices1[index];
-    y1    = _clipVertices1[index + 1];
-    z1    = _clipVertices1[index + 2];
+    x1    = clipVertices1[index];
+    y1    = clipVertices1[index + 1];
+    z1    = clipVertices1[index + 2];
     dot   = (x1 - cx) * nx + (y1 - cy) * ny + (z1 - cz) * nz;
     if (dot < 0.f) {
       manifold->addPoint(x1, y1, z1, nx, ny, nz, dot, flipped);
     }
 
     index = index3 * 3;
-    x1    = _clipVertices1[index];
-    y1    = _clipVertices1[index + 1];
-    z1    = _clipVertices1[index + 2];
+    x1    = clipVertices1[index];
+    y1    = clipVertices1[index + 1];
+    z1    = clipVertices1[index + 2];
     dot   = (x1 - cx) * nx + (y1 - cy) * ny + (z1 - cz) * nz;
     if (dot < 0.f) {
       manifold->addPoint(x1, y1, z1, nx, ny, nz, dot, flipped);
     }
 
     index = index4 * 3;
-    x1    = _clipVertices1[index];
-    y1    = _clipVertices1[index + 1];
-    z1    = _clipVertices1[index + 2];
+    x1    = clipVertices1[index];
+    y1    = clipVertices1[index + 1];
+    z1    = clipVertices1[index + 2];
     dot   = (x1 - cx) * nx + (y1 - cy) * ny + (z1 - cz) * nz;
     if (dot < 0.f) {
       manifold->addPoint(x1, y1, z1, nx, ny, nz, dot, flipped);
@@ -1878,9 +1883,9 @@ void BoxBoxCollisionDetector::detectCollision(Shape* shape1, Shape* shape2,
   else {
     for (unsigned int i = 0; i < numClipVertices; ++i) {
       index = i * 3;
-      x1    = _clipVertices1[index];
-      y1    = _clipVertices1[index + 1];
-      z1    = _clipVertices1[index + 2];
+      x1    = clipVertices1[index];
+      y1    = clipVertices1[index + 1];
+      z1    = clipVertices1[index + 2];
       dot   = (x1 - cx) * nx + (y1 - cy) * ny + (z1 - cz) * nz;
       if (dot < 0.f) {
         manifold->addPoint(x1, y1, z1, nx, ny, nz, dot, flipped);
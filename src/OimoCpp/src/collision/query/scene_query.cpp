@@ -0,0 +1,485 @@
+#include <oimo/collision/query/scene_query.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <oimo/collision/broadphase/aabb.h>
+#include <oimo/collision/shape/box_shape.h>
+#include <oimo/collision/shape/plane_shape.h>
+#include <oimo/collision/shape/shape.h>
+#include <oimo/collision/shape/sphere_shape.h>
+
+namespace OIMO {
+
+namespace {
+
+using Vector = std::array<float, 3>;
+
+// An oriented box, whose axes are the columns of a rotation matrix
+struct Box {
+  Vector center;
+  std::array<Vector, 3> axes;
+  Vector halfExtents;
+};
+
+Vector toVector(const Vec3& v)
+{
+  return {{v.x, v.y, v.z}};
+}
+
+float dot(const Vector& a, const Vector& b)
+{
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vector sub(const Vector& a, const Vector& b)
+{
+  return {{a[0] - b[0], a[1] - b[1], a[2] - b[2]}};
+}
+
+Vector addScaled(const Vector& a, const Vector& b, float s)
+{
+  return {{a[0] + b[0] * s, a[1] + b[1] * s, a[2] + b[2] * s}};
+}
+
+std::array<Vector, 3> columns(const Mat33& rotation)
+{
+  const auto& te = rotation.elements;
+  return {{{{te[0], te[3], te[6]}},
+           {{te[1], te[4], te[7]}},
+           {{te[2], te[5], te[8]}}}};
+}
+
+Box toBox(const BoxShape& shape)
+{
+  return Box{toVector(shape.position), columns(shape.rotation),
+             {{shape.halfWidth, shape.halfHeight, shape.halfDepth}}};
+}
+
+Box toBox(const AABB& aabb)
+{
+  const auto& te = aabb.elements;
+  return Box{{{0.5f * (te[0] + te[3]), 0.5f * (te[1] + te[4]),
+               0.5f * (te[2] + te[5])}},
+             columns(Mat33()),
+             {{0.5f * (te[3] - te[0]), 0.5f * (te[4] - te[1]),
+               0.5f * (te[5] - te[2])}}};
+}
+
+Box toBox(const OverlapQuery& query)
+{
+  return Box{toVector(query.center), columns(query.rotation),
+             toVector(query.halfExtents)};
+}
+
+// The squared distance from a point to a box
+float distanceSq(const Box& box, const Vector& point)
+{
+  const Vector relative = sub(point, box.center);
+  float result          = 0.f;
+  for (unsigned int k = 0; k < 3; ++k) {
+    const float d = std::abs(dot(relative, box.axes[k])) - box.halfExtents[k];
+    if (d > 0.f) {
+      result += d * d;
+    }
+  }
+  return result;
+}
+
+// Separating axis test of two boxes
+bool overlaps(const Box& a, const Box& b)
+{
+  // Keeps the cross products of nearly parallel axes from being used as
+  // separating axes
+  const float epsilon = 1e-6f;
+  float r[3][3], absR[3][3];
+  for (unsigned int i = 0; i < 3; ++i) {
+    for (unsigned int j = 0; j < 3; ++j) {
+      r[i][j]    = dot(a.axes[i], b.axes[j]);
+      absR[i][j] = std::abs(r[i][j]) + epsilon;
+    }
+  }
+  const Vector relative = sub(b.center, a.center);
+  const Vector t{{dot(relative, a.axes[0]), dot(relative, a.axes[1]),
+                  dot(relative, a.axes[2])}};
+  const auto& ea = a.halfExtents;
+  const auto& eb = b.halfExtents;
+
+  // The axes of a
+  for (unsigned int i = 0; i < 3; ++i) {
+    const float rb
+      = eb[0] * absR[i][0] + eb[1] * absR[i][1] + eb[2] * absR[i][2];
+    if (std::abs(t[i]) > ea[i] + rb) {
+      return false;
+    }
+  }
+  // The axes of b
+  for (unsigned int j = 0; j < 3; ++j) {
+    const float ra
+      = ea[0] * absR[0][j] + ea[1] * absR[1][j] + ea[2] * absR[2][j];
+    if (std::abs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j])
+        > ra + eb[j]) {
+      return false;
+    }
+  }
+  // The cross products of an axis of a and an axis of b
+  for (unsigned int i = 0; i < 3; ++i) {
+    const unsigned int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+    for (unsigned int j = 0; j < 3; ++j) {
+      const unsigned int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+      const float ra = ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j];
+      const float rb = eb[j1] * absR[i][j2] + eb[j2] * absR[i][j1];
+      if (std::abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// The fraction at which a segment enters a sphere, 0 when it starts inside
+bool raySphere(const Vector& begin, const Vector& delta, const Vector& center,
+               float radius, float& t)
+{
+  const Vector m = sub(begin, center);
+  const float c  = dot(m, m) - radius * radius;
+  if (c <= 0.f) {
+    t = 0.f;
+    return true;
+  }
+  const float b = dot(m, delta);
+  if (b >= 0.f) {
+    return false;
+  }
+  const float a            = dot(delta, delta);
+  const float discriminant = b * b - a * c;
+  if (discriminant < 0.f) {
+    return false;
+  }
+  t = (-b - std::sqrt(discriminant)) / a;
+  return t <= 1.f;
+}
+
+// The fraction at which a segment enters a capsule along the axis k, of
+// half-length halfLength around center
+bool rayCapsule(const Vector& begin, const Vector& delta, const Vector& center,
+                unsigned int k, float halfLength, float radius, float& t)
+{
+  // The infinite cylinder around the axis first, in the plane of the two
+  // other axes. The spheres of the ends are inside it, so the segment enters
+  // the capsule through the cylinder if it is then between the ends.
+  const unsigned int i = (k + 1) % 3, j = (k + 2) % 3;
+  const float mx = begin[i] - center[i], my = begin[j] - center[j];
+  const float dx = delta[i], dy = delta[j];
+  const float a  = dx * dx + dy * dy;
+  const float b  = mx * dx + my * dy;
+  const float c  = mx * mx + my * my - radius * radius;
+  float tc       = -1.f;
+  if (c <= 0.f) {
+    tc = 0.f;
+  }
+  else if (b < 0.f && b * b - a * c >= 0.f) {
+    tc = (-b - std::sqrt(b * b - a * c)) / a;
+  }
+  if (tc >= 0.f && tc <= 1.f
+      && std::abs(begin[k] + delta[k] * tc - center[k]) <= halfLength) {
+    t = tc;
+    return true;
+  }
+  // Otherwise through one of the ends
+  bool hit = false;
+  t        = std::numeric_limits<float>::max();
+  for (float side : {-1.f, 1.f}) {
+    Vector end = center;
+    end[k] += side * halfLength;
+    float te = 0.f;
+    if (raySphere(begin, delta, end, radius, te) && te < t) {
+      t   = te;
+      hit = true;
+    }
+  }
+  return hit;
+}
+
+// Ray cast against a box, the box being enlarged by the radius of the query
+// with rounded edges and corners
+bool rayBox(const RayQuery& query, const Box& box, float maxFraction,
+            RayHit& hit)
+{
+  const Vector relativeBegin = sub(toVector(query.begin), box.center);
+  const Vector worldDelta    = sub(toVector(query.end), toVector(query.begin));
+  const auto& half           = box.halfExtents;
+  const float radius         = query.radius;
+  Vector begin, delta;
+  for (unsigned int k = 0; k < 3; ++k) {
+    begin[k] = dot(relativeBegin, box.axes[k]);
+    delta[k] = dot(worldDelta, box.axes[k]);
+  }
+
+  // The slabs of the box enlarged by the radius
+  float t = 0.f, tMax = 1.f;
+  int entryAxis = -1;
+  for (unsigned int k = 0; k < 3; ++k) {
+    const float extent = half[k] + radius;
+    if (delta[k] == 0.f) {
+      if (std::abs(begin[k]) > extent) {
+        return false;
+      }
+      continue;
+    }
+    const float invDelta = 1.f / delta[k];
+    float t1             = (-extent - begin[k]) * invDelta;
+    float t2             = (extent - begin[k]) * invDelta;
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+    if (t1 > t) {
+      t         = t1;
+      entryAxis = static_cast<int>(k);
+    }
+    tMax = std::min(tMax, t2);
+    if (t > tMax) {
+      return false;
+    }
+  }
+  if (t > maxFraction) {
+    return false;
+  }
+  Vector point = addScaled(begin, delta, t);
+
+  // Outside the box along two axes the sphere touches an edge, and along
+  // three axes one of the edges of a corner
+  if (radius > 0.f) {
+    unsigned int numOutside = 0;
+    for (unsigned int k = 0; k < 3; ++k) {
+      numOutside += std::abs(point[k]) > half[k] ? 1 : 0;
+    }
+    if (numOutside >= 2) {
+      Vector corner;
+      for (unsigned int k = 0; k < 3; ++k) {
+        corner[k] = point[k] > 0.f ? half[k] : -half[k];
+      }
+      float edgeT = std::numeric_limits<float>::max();
+      for (unsigned int k = 0; k < 3; ++k) {
+        if (numOutside == 2 && std::abs(point[k]) > half[k]) {
+          continue;
+        }
+        Vector center = corner;
+        center[k]     = 0.f;
+        float te      = 0.f;
+        if (rayCapsule(begin, delta, center, k, half[k], radius, te)) {
+          edgeT = std::min(edgeT, te);
+        }
+      }
+      if (edgeT > maxFraction) {
+        return false;
+      }
+      t     = edgeT;
+      point = addScaled(begin, delta, t);
+    }
+  }
+
+  // The closest point of the box and the normal at it
+  Vector closest, normal;
+  for (unsigned int k = 0; k < 3; ++k) {
+    closest[k] = std::max(-half[k], std::min(half[k], point[k]));
+    normal[k]  = point[k] - closest[k];
+  }
+  const float length = std::sqrt(dot(normal, normal));
+  if (length > 1e-6f) {
+    for (auto& n : normal) {
+      n /= length;
+    }
+  }
+  else if (entryAxis >= 0) {
+    const auto k = static_cast<unsigned int>(entryAxis);
+    normal       = {{0.f, 0.f, 0.f}};
+    normal[k]    = point[k] > 0.f ? 1.f : -1.f;
+  }
+  else {
+    // Starting inside the box, the normal faces the segment
+    const float deltaLength = std::sqrt(dot(delta, delta));
+    for (unsigned int k = 0; k < 3; ++k) {
+      normal[k] = deltaLength > 0.f ? -delta[k] / deltaLength : 0.f;
+    }
+  }
+
+  Vector position = box.center, worldNormal{{0.f, 0.f, 0.f}};
+  for (unsigned int k = 0; k < 3; ++k) {
+    position    = addScaled(position, box.axes[k], closest[k]);
+    worldNormal = addScaled(worldNormal, box.axes[k], normal[k]);
+  }
+  hit.fraction = t;
+  hit.position.set(position[0], position[1], position[2]);
+  hit.normal.set(worldNormal[0], worldNormal[1], worldNormal[2]);
+  return true;
+}
+
+bool raySphere(const RayQuery& query, const SphereShape& sphere,
+               float maxFraction, RayHit& hit)
+{
+  const Vector begin  = toVector(query.begin);
+  const Vector delta  = sub(toVector(query.end), begin);
+  const Vector center = toVector(sphere.position);
+  const float radius  = sphere.radius + query.radius;
+  float t             = 0.f;
+  if (!raySphere(begin, delta, center, radius, t) || t > maxFraction) {
+    return false;
+  }
+  Vector normal      = sub(addScaled(begin, delta, t), center);
+  const float length = std::sqrt(dot(normal, normal));
+  if (length > 1e-6f) {
+    for (auto& n : normal) {
+      n /= length;
+    }
+  }
+  else {
+    normal = {{0.f, 1.f, 0.f}};
+  }
+  hit.fraction = t;
+  hit.position.set(center[0] + normal[0] * sphere.radius,
+                   center[1] + normal[1] * sphere.radius,
+                   center[2] + normal[2] * sphere.radius);
+  hit.normal.set(normal[0], normal[1], normal[2]);
+  return true;
+}
+
+// A plane bounds the half-space opposite to its normal
+bool rayPlane(const RayQuery& query, const PlaneShape& plane,
+              float maxFraction, RayHit& hit)
+{
+  const Vector begin  = toVector(query.begin);
+  const Vector delta  = sub(toVector(query.end), begin);
+  const Vector normal = toVector(plane.normal);
+  const float distance
+    = dot(normal, sub(begin, toVector(plane.position))) - query.radius;
+  float t = 0.f;
+  if (distance > 0.f) {
+    const float speed = dot(normal, delta);
+    if (speed >= 0.f) {
+      return false;
+    }
+    t = -distance / speed;
+  }
+  if (t > 1.f || t > maxFraction) {
+    return false;
+  }
+  const Vector position
+    = addScaled(addScaled(begin, delta, t), normal, -query.radius);
+  hit.fraction = t;
+  hit.position.set(position[0], position[1], position[2]);
+  hit.normal.copy(plane.normal);
+  return true;
+}
+
+} // end of anonymous namespace
+
+RaySegment::RaySegment(const RayQuery& query)
+    : begin(toVector(query.begin))
+    , delta(sub(toVector(query.end), begin))
+    , radius{query.radius}
+{
+  for (unsigned int k = 0; k < 3; ++k) {
+    invDelta[k] = delta[k] != 0.f ? 1.f / delta[k] :
+                                    std::numeric_limits<float>::max();
+  }
+}
+
+bool SceneQuery::rayCast(const RayQuery& query, Shape& shape,
+                         float maxFraction, RayHit& hit)
+{
+  bool result = false;
+  switch (shape.type) {
+    case Shape::Type::SHAPE_SPHERE:
+      result = raySphere(query, static_cast<const SphereShape&>(shape),
+                         maxFraction, hit);
+      break;
+    case Shape::Type::SHAPE_BOX:
+      result = rayBox(query, toBox(static_cast<const BoxShape&>(shape)),
+                      maxFraction, hit);
+      break;
+    case Shape::Type::SHAPE_PLANE:
+      result = rayPlane(query, static_cast<const PlaneShape&>(shape),
+                        maxFraction, hit);
+      break;
+    default:
+      result = rayBox(query, toBox(*shape.aabb), maxFraction, hit);
+      break;
+  }
+  if (result) {
+    hit.shape = &shape;
+  }
+  return result;
+}
+
+bool SceneQuery::overlap(const OverlapQuery& query, const Shape& shape)
+{
+  const Vector center = toVector(query.center);
+  const bool isSphere = query.type == OverlapQuery::Type::OVERLAP_SPHERE;
+  switch (shape.type) {
+    case Shape::Type::SHAPE_SPHERE: {
+      const auto& sphere        = static_cast<const SphereShape&>(shape);
+      const Vector sphereCenter = toVector(sphere.position);
+      if (isSphere) {
+        const Vector d     = sub(sphereCenter, center);
+        const float radius = query.radius + sphere.radius;
+        return dot(d, d) <= radius * radius;
+      }
+      return distanceSq(toBox(query), sphereCenter)
+             <= sphere.radius * sphere.radius;
+    }
+    case Shape::Type::SHAPE_PLANE: {
+      const auto& plane   = static_cast<const PlaneShape&>(shape);
+      const Vector normal = toVector(plane.normal);
+      float extent        = query.radius;
+      if (!isSphere) {
+        const Box box = toBox(query);
+        extent        = 0.f;
+        for (unsigned int k = 0; k < 3; ++k) {
+          extent += box.halfExtents[k] * std::abs(dot(normal, box.axes[k]));
+        }
+      }
+      return dot(normal, sub(center, toVector(plane.position))) <= extent;
+    }
+    default: {
+      const Box box = shape.type == Shape::Type::SHAPE_BOX ?
+                        toBox(static_cast<const BoxShape&>(shape)) :
+                        toBox(*shape.aabb);
+      if (isSphere) {
+        return distanceSq(box, center) <= query.radius * query.radius;
+      }
+      return overlaps(toBox(query), box);
+    }
+  }
+}
+
+void SceneQuery::bounds(const OverlapQuery& query, AABB& aabb)
+{
+  const Vector center = toVector(query.center);
+  Vector extent{{query.radius, query.radius, query.radius}};
+  if (query.type == OverlapQuery::Type::OVERLAP_BOX) {
+    const Box box = toBox(query);
+    for (unsigned int w = 0; w < 3; ++w) {
+      extent[w] = 0.f;
+      for (unsigned int k = 0; k < 3; ++k) {
+        extent[w] += box.halfExtents[k] * std::abs(box.axes[k][w]);
+      }
+    }
+  }
+  aabb.set(center[0] - extent[0], center[0] + extent[0], //
+           center[1] - extent[1], center[1] + extent[1], //
+           center[2] - extent[2], center[2] + extent[2]);
+}
+
+void SceneQuery::bounds(const RayQuery& query, AABB& aabb)
+{
+  const Vec3& b = query.begin;
+  const Vec3& e = query.end;
+  const float r = query.radius;
+  aabb.set(std::min(b.x, e.x) - r, std::max(b.x, e.x) + r, //
+           std::min(b.y, e.y) - r, std::max(b.y, e.y) + r, //
+           std::min(b.z, e.z) - r, std::max(b.z, e.z) + r);
+}
+
+} // end of namespace OIMO
@@ -31,7 +31,6 @@ Contact::Contact()
     , manifold{make_unique<ContactManifold>()}
     , constraint{make_unique<ContactConstraint>(manifold.get())}
 {
-  points = manifold->points;
 }
 
 Contact::~Contact()
@@ -55,9 +54,9 @@ void Contact::updateManifold()
   constraint->friction
     = Contact::MixFriction(shape1->friction, shape2->friction);
   auto numBuffers = manifold->numPoints;
-  for (unsigned int i = numBuffers - 1; i-- > 0;) {
+  for (unsigned int i = numBuffers; i-- > 0;) {
     auto& b   = buffer[i];
-    auto& p   = points[i];
+    auto& p   = manifold->points[i];
     b.lp1X    = p.localPoint1.x;
     b.lp1Y    = p.localPoint1.y;
     b.lp1Z    = p.localPoint1.z;
@@ -80,8 +79,8 @@ void Contact::updateManifold()
     close = true;
   }
   touching = true;
-  for (unsigned int i = num - 1; i-- > 0;) {
-    auto& p            = points[i];
+  for (unsigned int i = num; i-- > 0;) {
+    auto& p            = manifold->points[i];
     float lp1x         = p.localPoint1.x;
     float lp1y         = p.localPoint1.y;
     float lp1z         = p.localPoint1.z;
@@ -91,7 +90,7 @@ void Contact::updateManifold()
     bool indexSet      = false;
     unsigned int index = 0;
     float minDistance  = 0.0004f;
-    for (unsigned int j = numBuffers - 1; j-- > 0;) {
+    for (unsigned int j = numBuffers; j-- > 0;) {
       ImpulseDataBuffer& b = buffer[j];
       float dx             = b.lp1X - lp1x;
       float dy             = b.lp1Y - lp1y;
@@ -117,7 +116,7 @@ void Contact::updateManifold()
       }
     }
     if (indexSet) {
-      auto& tmp          = buffer[index];
+      const auto tmp     = buffer[index];
       buffer[index]      = buffer[--numBuffers];
       buffer[numBuffers] = tmp;
       p.normalImpulse    = tmp.impulse;
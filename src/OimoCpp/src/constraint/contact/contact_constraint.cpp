@@ -14,11 +14,18 @@ ContactConstraint::ContactConstraint(ContactManifold* manifold)
     , restitution{0.f}
     , friction{0.f}
     , _manifold{manifold}
+    , _p1{nullptr}
+    , _p2{nullptr}
+    , _lv1{nullptr}
+    , _lv2{nullptr}
+    , _av1{nullptr}
+    , _av2{nullptr}
+    , _i1{nullptr}
+    , _i2{nullptr}
     , _m1{0.f}
     , _m2{0.f}
     , _num{0}
 {
-  _ps                   = _manifold->points;
   _cs                   = make_unique<ContactPointDataBuffer>();
   _cs->next             = make_unique<ContactPointDataBuffer>();
   _cs->next->next       = make_unique<ContactPointDataBuffer>();
@@ -31,26 +38,26 @@ ContactConstraint::~ContactConstraint()
 
 void ContactConstraint::attach()
 {
-  _p1  = body1->position;
-  _p2  = body2->position;
-  _lv1 = body1->linearVelocity;
-  _av1 = body1->angularVelocity;
-  _lv2 = body2->linearVelocity;
-  _av2 = body2->angularVelocity;
-  _i1  = body1->inverseInertia;
-  _i2  = body2->inverseInertia;
+  _p1  = &body1->position;
+  _p2  = &body2->position;
+  _lv1 = &body1->linearVelocity;
+  _av1 = &body1->angularVelocity;
+  _lv2 = &body2->linearVelocity;
+  _av2 = &body2->angularVelocity;
+  _i1  = &body1->inverseInertia;
+  _i2  = &body2->inverseInertia;
 }
 
 void ContactConstraint::detach()
 {
-  _p1  = Vec3();
-  _p2  = Vec3();
-  _lv1 = Vec3();
-  _lv2 = Vec3();
-  _av1 = Vec3();
-  _av2 = Vec3();
-  _i1  = Mat33();
-  _i2  = Mat33();
+  _p1  = nullptr;
+  _p2  = nullptr;
+  _lv1 = nullptr;
+  _lv2 = nullptr;
+  _av1 = nullptr;
+  _av2 = nullptr;
+  _i1  = nullptr;
+  _i2  = nullptr;
 }
 
 void ContactConstraint::preSolve(float /*timeStep*/, float invTimeStep)
@@ -67,13 +74,13 @@ void ContactConstraint::preSolve(float /*timeStep*/, float invTimeStep)
   Mat33 i1, i2;
 
   for (unsigned int i = 0; i < _num; ++i) {
-    const auto& p = _ps[i];
+    const auto& p = _manifold->points[i];
 
-    _tmpP1.sub(p.position, _p1);
-    _tmpP2.sub(p.position, _p2);
+    _tmpP1.sub(p.position, *_p1);
+    _tmpP2.sub(p.position, *_p2);
 
-    _tmpC1.crossVectors(_av1, _tmpP1);
-    _tmpC2.crossVectors(_av2, _tmpP2);
+    _tmpC1.crossVectors(*_av1, _tmpP1);
+    _tmpC2.crossVectors(*_av2, _tmpP2);
 
     c->norImp = p.normalImpulse;
     c->tanImp = p.tangentImpulse;
@@ -81,9 +88,9 @@ void ContactConstraint::preSolve(float /*timeStep*/, float invTimeStep)
 
     c->nor.copy(p.normal);
 
-    _tmp.set((_lv2.x + _tmpC2.x) - (_lv1.x + _tmpC1.x), //
-             (_lv2.y + _tmpC2.y) - (_lv1.y + _tmpC1.y), //
-             (_lv2.z + _tmpC2.z) - (_lv1.z + _tmpC1.z));
+    _tmp.set((_lv2->x + _tmpC2.x) - (_lv1->x + _tmpC1.x), //
+             (_lv2->y + _tmpC2.y) - (_lv1->y + _tmpC1.y), //
+             (_lv2->z + _tmpC2.z) - (_lv1->z + _tmpC1.z));
 
     rvn = Math::dotVectors(c->nor, _tmp);
 
@@ -118,8 +125,8 @@ void ContactConstraint::preSolve(float /*timeStep*/, float invTimeStep)
     c->tanT2.crossVectors(_tmpP2, c->tan);
     c->binT2.crossVectors(_tmpP2, c->bin);
 
-    i1 = _i1;
-    i2 = _i2;
+    i1 = *_i1;
+    i2 = *_i2;
 
     c->norTU1.copy(c->norT1).applyMatrix3(i1, true);
     c->tanTU1.copy(c->tanT1).applyMatrix3(i1, true);
@@ -147,11 +154,16 @@ void ContactConstraint::preSolve(float /*timeStep*/, float invTimeStep)
     if (p.warmStarted) {
       norImp = p.normalImpulse;
 
-      _lv1.addScaledVector(c->norU1, norImp);
-      _av1.addScaledVector(c->norTU1, norImp);
-
-      _lv2.subScaledVector(c->norU2, norImp);
-      _av2.subScaledVector(c->norTU2, norImp);
+      // Static bodies can be shared between islands solved concurrently,
+      // their velocities are left untouched
+      if (!body1->isStatic) {
+        _lv1->addScaledVector(c->norU1, norImp);
+        _av1->addScaledVector(c->norTU1, norImp);
+      }
+      if (!body2->isStatic) {
+        _lv2->subScaledVector(c->norU2, norImp);
+        _av2->subScaledVector(c->norTU2, norImp);
+      }
 
       c->norImp = norImp;
       c->tanImp = 0.f;
@@ -182,10 +194,10 @@ void ContactConstraint::preSolve(float /*timeStep*/, float invTimeStep)
 
 void ContactConstraint::solve()
 {
-  _tmplv1.copy(_lv1);
-  _tmplv2.copy(_lv2);
-  _tmpav1.copy(_av1);
-  _tmpav2.copy(_av2);
+  _tmplv1.copy(*_lv1);
+  _tmplv2.copy(*_lv2);
+  _tmpav1.copy(*_av1);
+  _tmpav2.copy(*_av2);
 
   float oldImp1, newImp1, oldImp2, newImp2, rvn, norImp, tanImp, binImp, max,
     len;
@@ -280,17 +292,22 @@ void ContactConstraint::solve()
     c = c->next.get();
   }
 
-  _lv1.copy(_tmplv1);
-  _lv2.copy(_tmplv2);
-  _av1.copy(_tmpav1);
-  _av2.copy(_tmpav2);
+  if (!body1->isStatic) {
+    _lv1->copy(_tmplv1);
+    _av1->copy(_tmpav1);
+  }
+  if (!body2->isStatic) {
+    _lv2->copy(_tmplv2);
+    _av2->copy(_tmpav2);
+  }
 }
 
 void ContactConstraint::postSolve()
 {
   ContactPointDataBuffer* c = _cs.get();
-  for (unsigned int i = _num - 1; i-- > 0;) {
-    auto& p = _ps[i];
+  // Same order as the point data buffers filled in preSolve
+  for (unsigned int i = 0; i < _num; ++i) {
+    auto& p = _manifold->points[i];
     p.normal.copy(c->nor);
     p.tangent.copy(c->tan);
     p.binormal.copy(c->bin);
@@ -7,14 +7,15 @@ namespace OIMO {
 
 AngularConstraint::AngularConstraint(Joint* joint,
                                      const Quat& targetOrientation)
-    : _joint{joint}, _targetOrientation{Quat().invert(targetOrientation)}
+    : _joint{joint}
+    , _targetOrientation{Quat().invert(targetOrientation)}
+    , _b1{joint->body1}
+    , _b2{joint->body2}
+    , _a1{joint->body1->angularVelocity}
+    , _a2{joint->body2->angularVelocity}
+    , _i1{joint->body1->inverseInertia}
+    , _i2{joint->body2->inverseInertia}
 {
-  _b1 = _joint->body1;
-  _b2 = _joint->body2;
-  _a1 = _b1->angularVelocity;
-  _a2 = _b2->angularVelocity;
-  _i1 = _b1->inverseInertia;
-  _i2 = _b2->inverseInertia;
 }
 
 AngularConstraint::~AngularConstraint()
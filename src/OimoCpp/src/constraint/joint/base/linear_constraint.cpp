@@ -8,20 +8,23 @@
 namespace OIMO {
 
 LinearConstraint::LinearConstraint(Joint* joint)
-    : _joint{joint}, _impx{0.f}, _impy{0.f}, _impz{0.f}
+    : _joint{joint}
+    , _r1{joint->relativeAnchorPoint1}
+    , _r2{joint->relativeAnchorPoint2}
+    , _p1{joint->anchorPoint1}
+    , _p2{joint->anchorPoint2}
+    , _b1{joint->body1}
+    , _b2{joint->body2}
+    , _l1{joint->body1->linearVelocity}
+    , _l2{joint->body2->linearVelocity}
+    , _a1{joint->body1->angularVelocity}
+    , _a2{joint->body2->angularVelocity}
+    , _i1{joint->body1->inverseInertia}
+    , _i2{joint->body2->inverseInertia}
+    , _impx{0.f}
+    , _impy{0.f}
+    , _impz{0.f}
 {
-  _r1 = _joint->relativeAnchorPoint1;
-  _r2 = _joint->relativeAnchorPoint2;
-  _p1 = _joint->anchorPoint1;
-  _p2 = _joint->anchorPoint2;
-  _b1 = _joint->body1;
-  _b2 = _joint->body2;
-  _l1 = _b1->linearVelocity;
-  _l2 = _b2->linearVelocity;
-  _a1 = _b1->angularVelocity;
-  _a2 = _b2->angularVelocity;
-  _i1 = _b1->inverseInertia;
-  _i2 = _b2->inverseInertia;
 }
 
 LinearConstraint::~LinearConstraint()
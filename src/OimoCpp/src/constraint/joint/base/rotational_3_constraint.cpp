@@ -20,6 +20,12 @@ Rotational3Constraint::Rotational3Constraint(Joint* joint,
     , _enableMotor2{false}
     , _limitState3{0}
     , _enableMotor3{false}
+    , _b1{joint->body1}
+    , _b2{joint->body2}
+    , _a1{joint->body1->angularVelocity}
+    , _a2{joint->body2->angularVelocity}
+    , _i1{joint->body1->inverseInertia}
+    , _i2{joint->body2->inverseInertia}
     , _limitImpulse1{0.f}
     , _motorImpulse1{0.f}
     , _limitImpulse2{0.f}
@@ -27,12 +33,6 @@ Rotational3Constraint::Rotational3Constraint(Joint* joint,
     , _limitImpulse3{0.f}
     , _motorImpulse3{0.f}
 {
-  _b1 = joint->body1;
-  _b2 = joint->body2;
-  _a1 = _b1->angularVelocity;
-  _a2 = _b2->angularVelocity;
-  _i1 = _b1->inverseInertia;
-  _i2 = _b2->inverseInertia;
 }
 
 Rotational3Constraint::~Rotational3Constraint()
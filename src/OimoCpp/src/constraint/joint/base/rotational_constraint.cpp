@@ -11,15 +11,15 @@ RotationalConstraint::RotationalConstraint(Joint* joint, LimitMotor* limitMotor)
     : _limitState{0}
     , _enableMotor{false}
     , _limitMotor{limitMotor}
+    , _b1{joint->body1}
+    , _b2{joint->body2}
+    , _a1{joint->body1->angularVelocity}
+    , _a2{joint->body2->angularVelocity}
+    , _i1{joint->body1->inverseInertia}
+    , _i2{joint->body2->inverseInertia}
     , _limitImpulse{0.f}
     , _motorImpulse{0.f}
 {
-  _b1 = joint->body1;
-  _b2 = joint->body2;
-  _a1 = _b1->angularVelocity;
-  _a2 = _b2->angularVelocity;
-  _i1 = _b1->inverseInertia;
-  _i2 = _b2->inverseInertia;
 }
 
 RotationalConstraint::~RotationalConstraint()
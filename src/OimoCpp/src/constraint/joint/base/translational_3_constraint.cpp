@@ -21,6 +21,18 @@ Translational3Constraint::Translational3Constraint(Joint* joint,
     , _limitMotor1{limitMotor1}
     , _limitMotor2{limitMotor2}
     , _limitMotor3{limitMotor3}
+    , _b1{joint->body1}
+    , _b2{joint->body2}
+    , _p1{joint->anchorPoint1}
+    , _p2{joint->anchorPoint2}
+    , _r1{joint->relativeAnchorPoint1}
+    , _r2{joint->relativeAnchorPoint2}
+    , _l1{joint->body1->linearVelocity}
+    , _l2{joint->body2->linearVelocity}
+    , _a1{joint->body1->angularVelocity}
+    , _a2{joint->body2->angularVelocity}
+    , _i1{joint->body1->inverseInertia}
+    , _i2{joint->body2->inverseInertia}
     , _limitImpulse1{0.f}
     , _motorImpulse1{0.f}
     , _limitImpulse2{0.f}
@@ -31,18 +43,6 @@ Translational3Constraint::Translational3Constraint(Joint* joint,
     , _cfm2{0.f}
     , _cfm3{0.f}
 {
-  _b1 = joint->body1;
-  _b2 = joint->body2;
-  _p1 = joint->anchorPoint1;
-  _p2 = joint->anchorPoint2;
-  _r1 = joint->relativeAnchorPoint1;
-  _r2 = joint->relativeAnchorPoint2;
-  _l1 = _b1->linearVelocity;
-  _l2 = _b2->linearVelocity;
-  _a1 = _b1->angularVelocity;
-  _a2 = _b2->angularVelocity;
-  _i1 = _b1->inverseInertia;
-  _i2 = _b2->inverseInertia;
 }
 
 Translational3Constraint::~Translational3Constraint()
@@ -12,21 +12,21 @@ TranslationalConstraint::TranslationalConstraint(Joint* joint,
     : _limitState{0}
     , _enableMotor{false}
     , _limitMotor{limitMotor}
+    , _b1{joint->body1}
+    , _b2{joint->body2}
+    , _p1{joint->anchorPoint1}
+    , _p2{joint->anchorPoint2}
+    , _r1{joint->relativeAnchorPoint1}
+    , _r2{joint->relativeAnchorPoint2}
+    , _l1{joint->body1->linearVelocity}
+    , _l2{joint->body2->linearVelocity}
+    , _a1{joint->body1->angularVelocity}
+    , _a2{joint->body2->angularVelocity}
+    , _i1{joint->body1->inverseInertia}
+    , _i2{joint->body2->inverseInertia}
     , _limitImpulse{0.f}
     , _motorImpulse{0.f}
 {
-  _b1 = joint->body1;
-  _b2 = joint->body2;
-  _p1 = joint->anchorPoint1;
-  _p2 = joint->anchorPoint2;
-  _r1 = joint->relativeAnchorPoint1;
-  _r2 = joint->relativeAnchorPoint2;
-  _l1 = _b1->linearVelocity;
-  _l2 = _b2->linearVelocity;
-  _a1 = _b1->angularVelocity;
-  _a2 = _b2->angularVelocity;
-  _i1 = _b1->inverseInertia;
-  _i2 = _b2->inverseInertia;
 }
 
 TranslationalConstraint::~TranslationalConstraint()
@@ -15,14 +15,15 @@ Joint::Joint(const JointConfig& config)
     , type{Type::JOINT_NULL}
     , prev{nullptr}
     , next{nullptr}
-    , body1{config.body1}
-    , body2{config.body2}
     , localAnchorPoint1{Vec3().copy(config.localAnchorPoint1)}
     , localAnchorPoint2{Vec3().copy(config.localAnchorPoint2)}
     , allowCollision{config.allowCollision}
     , b1Link{make_unique<JointLink>(this)}
     , b2Link{make_unique<JointLink>(this)}
 {
+  // The bodies of the constraint, which the islands are built from
+  body1 = config.body1;
+  body2 = config.body2;
 }
 
 Joint::~Joint()
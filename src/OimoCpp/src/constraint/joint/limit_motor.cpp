@@ -26,7 +26,7 @@ LimitMotor::LimitMotor(const LimitMotor& lm)
 {
 }
 
-LimitMotor::LimitMotor(LimitMotor&& lm)
+LimitMotor::LimitMotor(LimitMotor&& lm) : axis{lm.axis}
 {
   *this = std::move(lm);
 }
@@ -37,8 +37,8 @@ LimitMotor::~LimitMotor()
 
 LimitMotor& LimitMotor::operator=(const LimitMotor& lm)
 {
+  // The axis stays bound to the joint of this limit motor
   if (&lm != this) {
-    axis          = lm.axis;
     angle         = lm.angle;
     lowerLimit    = lm.lowerLimit;
     upperLimit    = lm.upperLimit;
@@ -54,7 +54,6 @@ LimitMotor& LimitMotor::operator=(const LimitMotor& lm)
 LimitMotor& LimitMotor::operator=(LimitMotor&& lm)
 {
   if (&lm != this) {
-    axis          = std::move(lm.axis);
     angle         = std::move(lm.angle);
     lowerLimit    = std::move(lm.lowerLimit);
     upperLimit    = std::move(lm.upperLimit);
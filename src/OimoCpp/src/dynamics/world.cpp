@@ -1,11 +1,14 @@
 #include <oimo/dynamics/world.h>
 
+#include <algorithm>
+
 #include <oimo/collision/broadphase/aabb.h>
 #include <oimo/collision/broadphase/broad_phase.h>
 #include <oimo/collision/broadphase/brute_force_broad_phase.h>
 #include <oimo/collision/broadphase/dbvt/dbvt_broad_phase.h>
 #include <oimo/collision/broadphase/proxy.h>
 #include <oimo/collision/broadphase/sap/sap_broad_phase.h>
+#include <oimo/collision/broadphase/sap/simd_sap_broad_phase.h>
 #include <oimo/collision/narrowphase/box_box_collision_detector.h>
 #include <oimo/collision/narrowphase/box_cylinder_collision_detector.h>
 #include <oimo/collision/narrowphase/cylinder_cylinder_collision_detector.h>
@@ -13,6 +16,7 @@
 #include <oimo/collision/narrowphase/sphere_cylinder_collision_detector.h>
 #include <oimo/collision/narrowphase/sphere_sphere_collision_detector.h>
 #include <oimo/collision/narrowphase/tetra_tetra_collision_detector.h>
+#include <oimo/collision/query/scene_query.h>
 #include <oimo/collision/shape/shape.h>
 #include <oimo/constraint/contact/contact.h>
 #include <oimo/constraint/contact/contact_constraint.h>
@@ -26,8 +30,12 @@ namespace OIMO {
 
 float World::WORLD_SCALE = 100.f;
 float World::INV_SCALE   = 0.01f;
-const std::array<std::string, 4> World::Btypes
-  = {{"None", "BruteForce", "Sweep & Prune", "Bounding Volume Tree"}};
+const unsigned int World::ISLAND_BATCH_COST = 256;
+const unsigned int World::CONTACT_BATCH_SIZE = 64;
+const unsigned int World::QUERY_BATCH_SIZE = 64;
+const std::array<std::string, 5> World::Btypes
+  = {{"None", "BruteForce", "Sweep & Prune", "Bounding Volume Tree",
+      "SIMD Sweep & Prune"}};
 
 World::World(float _timeStep, BroadPhase::Type iBroadPhaseType,
              unsigned int _numIterations, bool noStat)
@@ -36,6 +44,7 @@ World::World(float _timeStep, BroadPhase::Type iBroadPhaseType,
     , numIterations{_numIterations}
     , performance{Performance(this)}
     , isNoStat{noStat}
+    , enableRandomizer{true}
     , rigidBodies{nullptr}
     , numRigidBodies{0}
     , contacts{nullptr}
@@ -49,6 +58,7 @@ World::World(float _timeStep, BroadPhase::Type iBroadPhaseType,
     , randX{65535}
     , randA{98765}
     , randB{123456789}
+    , threadPool{make_unique<ThreadPool>(1)}
 {
   // Broad phase
   switch (iBroadPhaseType) {
@@ -67,6 +77,11 @@ World::World(float _timeStep, BroadPhase::Type iBroadPhaseType,
       broadPhase     = make_unique<DBVTBroadPhase>();
       broadPhaseType = Btypes[3];
       break;
+    case BroadPhase::Type::BR_SIMD_SWEEP_AND_PRUNE:
+      // Sweep & Prune over arrays of bounds
+      broadPhase     = make_unique<SIMDSAPBroadPhase>();
+      broadPhaseType = Btypes[4];
+      break;
     default:
     case BroadPhase::Type::BR_NULL:
       broadPhase     = make_unique<SAPBroadPhase>();
@@ -122,9 +137,10 @@ void World::clear()
   while (joints != nullptr) {
     removeJoint(joints);
   }
-  while (contacts != nullptr) {
-    removeContact(contacts);
+  for (auto contact : contactArray) {
+    _freeContact(contact);
   }
+  contactArray.clear();
   while (rigidBodies != nullptr) {
     removeRigidBody(rigidBodies);
   }
@@ -210,7 +226,7 @@ void World::addJoint(Joint* joint)
   }
   if (joints != nullptr) {
     joints->prev = joint;
-    joints->next = joints;
+    joint->next  = joints;
   }
   joints        = joint;
   joint->parent = this;
@@ -266,10 +282,19 @@ void World::addContact(Shape* s1, Shape* s2)
     contacts->prev->next = contacts;
   }
   contacts = newContact;
+  contactArray.emplace_back(newContact);
   ++numContacts;
 }
 
 void World::removeContact(Contact* contact)
+{
+  contactArray.erase(
+    std::remove(contactArray.begin(), contactArray.end(), contact),
+    contactArray.end());
+  _freeContact(contact);
+}
+
+void World::_freeContact(Contact* contact)
 {
   auto prevContact = contact->prev;
   auto nextContact = contact->next;
@@ -326,6 +351,16 @@ bool World::callSleep(RigidBody* body)
   return true;
 }
 
+void World::setNumThreads(unsigned int numThreads)
+{
+  threadPool = make_unique<ThreadPool>(std::max(numThreads, 1u));
+}
+
+unsigned int World::getNumThreads() const
+{
+  return threadPool->numThreads();
+}
+
 void World::step()
 {
   bool stat = !isNoStat ? true : false;
@@ -359,7 +394,7 @@ void World::step()
   ContactLink* link = nullptr;
   Contact* contact  = nullptr;
   bool exists       = false;
-  for (unsigned int i = broadPhase->numPairs - 1; i-- > 0;) {
+  for (unsigned int i = broadPhase->numPairs; i-- > 0;) {
     auto pair = pairs[i];
     if (pair.shape1->id < pair.shape2->id) {
       s1 = pair.shape1;
@@ -400,29 +435,52 @@ void World::step()
   //   UPDATE NARROWPHASE CONTACT
   //----------------------------------------------------------------------------
 
-  // update & narrow phase
-  numContactPoints = 0;
-  contact          = contacts;
-  RigidBody *b1 = nullptr, *b2 = nullptr;
-  while (contact != nullptr) {
-    if (!contact->persisting) {
-      if (contact->shape1->aabb->intersectTest(*contact->shape2->aabb)) {
-        auto nextContact = contact->next;
-        removeContact(contact);
-        contact = nextContact;
+  // update & narrow phase, the contacts only write to their own manifold and
+  // constraint so they are updated concurrently
+  const size_t numContactBatches
+    = (contactArray.size() + World::CONTACT_BATCH_SIZE - 1)
+      / World::CONTACT_BATCH_SIZE;
+  separatedContacts.assign(contactArray.size(), 0);
+  threadPool->parallelFor(numContactBatches, [this](size_t batch) {
+    const size_t begin = batch * World::CONTACT_BATCH_SIZE;
+    const size_t end
+      = std::min(begin + World::CONTACT_BATCH_SIZE, contactArray.size());
+    for (size_t i = begin; i < end; ++i) {
+      auto current = contactArray[i];
+      if (!current->persisting
+          && current->shape1->aabb->intersectTest(*current->shape2->aabb)) {
+        separatedContacts[i] = 1;
         continue;
       }
+      auto b1 = current->body1;
+      auto b2 = current->body2;
+      if ((b1->isDynamic && !b1->sleeping)
+          || (b2->isDynamic && !b2->sleeping)) {
+        current->updateManifold();
+      }
+      current->persisting                = false;
+      current->constraint->addedToIsland = false;
     }
-    b1 = contact->body1;
-    b2 = contact->body2;
-    if ((b1->isDynamic && !b1->sleeping) || (b2->isDynamic && !b2->sleeping)) {
-      contact->updateManifold();
+  });
+
+  if (stat) {
+    performance.calcManifoldUpdate();
+  }
+
+  // remove the separated contacts, which unlinks them from the shapes and the
+  // rigid bodies, and compact the contact array
+  numContactPoints = 0;
+  size_t numKept   = 0;
+  for (size_t i = 0; i < contactArray.size(); ++i) {
+    contact = contactArray[i];
+    if (separatedContacts[i]) {
+      _freeContact(contact);
+      continue;
     }
     numContactPoints += contact->manifold->numPoints;
-    contact->persisting                = false;
-    contact->constraint->addedToIsland = false;
-    contact                            = contact->next;
+    contactArray[numKept++] = contact;
   }
+  contactArray.resize(numKept);
 
   if (stat) {
     performance.calcNarrowPhase();
@@ -433,196 +491,308 @@ void World::step()
   //----------------------------------------------------------------------------
 
   float invTimeStep = 1.f / timeStep;
-  // var body;
-  Joint* joint           = nullptr;
-  Constraint* constraint = nullptr;
-  for (joint = joints; joint != nullptr; joint = joint->next) {
+  for (auto joint = joints; joint != nullptr; joint = joint->next) {
     joint->addedToIsland = false;
   }
 
-  // clear old island array
-  islandRigidBodies.clear();
-  islandConstraints.clear();
-  islandStack.clear();
-
   if (stat) {
     performance.setTime(1);
   }
 
-  numIslands = 0;
+  // build simulation islands
+  _buildIslands();
+  numIslands = static_cast<unsigned int>(islands.size());
 
-  // build and solve simulation islands
-  unsigned int islandNumRigidBodies = 0;
-  unsigned int islandNumConstraints = 0;
-  unsigned int stackCount           = 1;
-  ContactLink* cs                   = nullptr;
-  contact                           = nullptr;
-  RigidBody* nextRigidBody          = nullptr;
-  for (auto base = rigidBodies; base != nullptr; base = base->next) {
+  // solve the batches of islands concurrently, then the islands which can
+  // share a static body with another island
+  threadPool->parallelFor(islandBatches.size() - 1, [&](size_t batch) {
+    for (unsigned int i = islandBatches[batch]; i < islandBatches[batch + 1];
+         ++i) {
+      if (!islands[i].touchesStatic) {
+        _solveIsland(islands[i], invTimeStep);
+      }
+    }
+  });
+  for (auto& island : islands) {
+    if (island.touchesStatic) {
+      _solveIsland(island, invTimeStep);
+    }
+  }
 
-    if (base->addedToIsland || base->isStatic || base->sleeping) {
-      // ignore
+  // sleep the islands, which updates the broad-phase proxies of the bodies
+  for (const auto& island : islands) {
+    if (!island.sleep) {
       continue;
     }
+    for (unsigned int j = 0; j < island.numRigidBodies; ++j) {
+      islandRigidBodies[island.rigidBodiesStart + j]->sleep();
+    }
+  }
 
-    if (base->isLonely()) { // update single body
-      if (base->isDynamic) {
-        base->linearVelocity.addScaledVector(gravity, timeStep);
-      }
-      if (callSleep(base)) {
-        base->sleepTime += timeStep;
-        if (base->sleepTime > 0.5f) {
-          base->sleep();
+  //----------------------------------------------------------------------------
+  //   END SIMULATION
+  //----------------------------------------------------------------------------
+
+  if (stat) {
+    performance.calcEnd();
+  }
+}
+
+void World::rayCast(const std::vector<RayQuery>& queries,
+                    std::vector<RayHit>& hits)
+{
+  hits.assign(queries.size(), RayHit());
+  broadPhase->prepareQueries();
+  const size_t numBatches
+    = (queries.size() + World::QUERY_BATCH_SIZE - 1) / World::QUERY_BATCH_SIZE;
+  threadPool->parallelFor(numBatches, [this, &queries, &hits](size_t batch) {
+    const size_t begin = batch * World::QUERY_BATCH_SIZE;
+    const size_t end
+      = std::min(begin + World::QUERY_BATCH_SIZE, queries.size());
+    std::vector<Shape*> shapes;
+    std::vector<unsigned int> offsets;
+    broadPhase->queryRays(&queries[begin], end - begin, shapes, offsets);
+    RayHit candidate;
+    for (size_t i = begin; i < end; ++i) {
+      const auto& query = queries[i];
+      auto& hit         = hits[i];
+      for (unsigned int j = offsets[i - begin]; j < offsets[i - begin + 1];
+           ++j) {
+        auto shape = shapes[j];
+        if ((shape->belongsTo & query.collidesWith) == 0
+            || !SceneQuery::rayCast(query, *shape, hit.fraction, candidate)) {
+          continue;
         }
-        else {
-          base->updatePosition(timeStep);
+        if (hit.shape == nullptr || candidate.fraction < hit.fraction
+            || shape->id < hit.shape->id) {
+          hit = candidate;
+        }
+        if (query.anyHit) {
+          break;
         }
       }
-      else {
-        base->sleepTime = 0;
-        base->updatePosition(timeStep);
+    }
+  });
+}
+
+void World::overlap(const std::vector<OverlapQuery>& queries,
+                    OverlapResults& results)
+{
+  // The shapes of each batch are gathered in order once the batches are done
+  const size_t numBatches
+    = (queries.size() + World::QUERY_BATCH_SIZE - 1) / World::QUERY_BATCH_SIZE;
+  std::vector<std::vector<Shape*>> batchShapes(numBatches);
+  results.offsets.assign(queries.size() + 1, 0);
+  broadPhase->prepareQueries();
+  threadPool->parallelFor(numBatches, [this, &queries, &results,
+                                       &batchShapes](size_t batch) {
+    const size_t begin = batch * World::QUERY_BATCH_SIZE;
+    const size_t end
+      = std::min(begin + World::QUERY_BATCH_SIZE, queries.size());
+    std::vector<AABB> aabbs(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+      SceneQuery::bounds(queries[i], aabbs[i - begin]);
+    }
+    std::vector<Shape*> shapes;
+    std::vector<unsigned int> offsets;
+    broadPhase->queryAABBs(aabbs.data(), aabbs.size(), shapes, offsets);
+    auto& overlapped = batchShapes[batch];
+    for (size_t i = begin; i < end; ++i) {
+      const auto& query = queries[i];
+      for (unsigned int j = offsets[i - begin]; j < offsets[i - begin + 1];
+           ++j) {
+        auto shape = shapes[j];
+        if ((shape->belongsTo & query.collidesWith) != 0
+            && SceneQuery::overlap(query, *shape)) {
+          overlapped.emplace_back(shape);
+        }
       }
-      ++numIslands;
+      results.offsets[i + 1] = static_cast<unsigned int>(overlapped.size());
+    }
+  });
+
+  results.shapes.clear();
+  for (size_t batch = 0; batch < numBatches; ++batch) {
+    const auto start   = static_cast<unsigned int>(results.shapes.size());
+    const size_t begin = batch * World::QUERY_BATCH_SIZE;
+    const size_t end
+      = std::min(begin + World::QUERY_BATCH_SIZE, queries.size());
+    for (size_t i = begin; i < end; ++i) {
+      results.offsets[i + 1] += start;
+    }
+    results.shapes.insert(results.shapes.end(), batchShapes[batch].begin(),
+                          batchShapes[batch].end());
+  }
+}
+
+void World::_buildIslands()
+{
+  islands.clear();
+  islandBatches.clear();
+  islandRigidBodies.clear();
+  islandConstraints.clear();
+  islandStack.clear();
+
+  islandBatches.emplace_back(0);
+  unsigned int batchCost = 0;
+  for (auto base = rigidBodies; base != nullptr; base = base->next) {
+
+    if (base->addedToIsland || base->isStatic || base->sleeping) {
+      // ignore
       continue;
     }
 
-    islandNumRigidBodies = 0;
-    islandNumConstraints = 0;
-    stackCount           = 1;
+    Island island;
+    island.rigidBodiesStart
+      = static_cast<unsigned int>(islandRigidBodies.size());
+    island.constraintsStart
+      = static_cast<unsigned int>(islandConstraints.size());
+    island.touchesStatic = false;
+    island.sleep         = false;
+    // One draw of the world randomizer per island, in the order of
+    // construction, whichever thread solves the island
+    randX       = randX * randA + randB;
+    island.seed = randX;
+
     // add rigid body to stack
-    islandStack[0]      = base;
+    islandStack.emplace_back(base);
     base->addedToIsland = true;
 
     // build an island
     do {
       // get rigid body from stack
-      body                    = islandStack[--stackCount];
-      islandStack[stackCount] = nullptr;
-      body->sleeping          = false;
+      auto body = islandStack.back();
+      islandStack.pop_back();
+      body->sleeping = false;
       // add rigid body to the island
-      islandRigidBodies[islandNumRigidBodies++] = body;
-      if (body->isStatic) {
-        continue;
-      }
+      islandRigidBodies.emplace_back(body);
 
       // search connections
-      for (cs = body->contactLink; cs != nullptr; cs = cs->next) {
-        contact    = cs->contact;
-        constraint = contact->constraint.get();
+      for (auto cs = body->contactLink; cs != nullptr; cs = cs->next) {
+        auto contact    = cs->contact;
+        auto constraint = contact->constraint.get();
         if (constraint->addedToIsland || !contact->touching) {
           // ignore
           continue;
         }
-
         // add constraint to the island
-        islandConstraints[islandNumConstraints++] = constraint;
-        constraint->addedToIsland                 = true;
-        nextRigidBody                             = cs->body;
-
-        if (nextRigidBody->addedToIsland) {
+        islandConstraints.emplace_back(constraint);
+        constraint->addedToIsland = true;
+        auto nextRigidBody        = cs->body;
+        // static bodies do not connect islands
+        if (nextRigidBody->addedToIsland || nextRigidBody->isStatic) {
           continue;
         }
-
         // add rigid body to stack
-        islandStack[stackCount++]    = nextRigidBody;
+        islandStack.emplace_back(nextRigidBody);
         nextRigidBody->addedToIsland = true;
       }
       for (auto js = body->jointLink; js != nullptr; js = js->next) {
-        constraint = js->joint;
+        Constraint* constraint = js->joint;
         if (constraint->addedToIsland) {
           // ignore
           continue;
         }
         // add constraint to the island
-        islandConstraints[islandNumConstraints++] = constraint;
-        constraint->addedToIsland                 = true;
-        nextRigidBody                             = js->body;
-        if (nextRigidBody->addedToIsland || !nextRigidBody->isDynamic) {
+        islandConstraints.emplace_back(constraint);
+        constraint->addedToIsland = true;
+        auto nextRigidBody        = js->body;
+        if (!nextRigidBody->isDynamic) {
+          // joints write to the velocities of both bodies
+          island.touchesStatic = true;
+          continue;
+        }
+        if (nextRigidBody->addedToIsland) {
           continue;
         }
         // add rigid body to stack
-        islandStack[stackCount++]    = nextRigidBody;
+        islandStack.emplace_back(nextRigidBody);
         nextRigidBody->addedToIsland = true;
       }
-    } while (stackCount != 0);
-
-    // update velocities
-    auto gVel = Vec3().addScaledVector(gravity, timeStep);
-    for (unsigned int j = islandNumRigidBodies - 1; j-- > 0;) {
-      body = islandRigidBodies[j];
-      if (body->isDynamic) {
-        body->linearVelocity.addEqual(gVel);
-      }
+    } while (!islandStack.empty());
+
+    island.numRigidBodies = static_cast<unsigned int>(islandRigidBodies.size())
+                            - island.rigidBodiesStart;
+    island.numConstraints = static_cast<unsigned int>(islandConstraints.size())
+                            - island.constraintsStart;
+    islands.emplace_back(island);
+
+    // close the batch once it is worth a task
+    batchCost += island.numRigidBodies + island.numConstraints * numIterations;
+    if (batchCost >= World::ISLAND_BATCH_COST) {
+      islandBatches.emplace_back(static_cast<unsigned int>(islands.size()));
+      batchCost = 0;
     }
+  }
+  if (islandBatches.back() != islands.size()) {
+    islandBatches.emplace_back(static_cast<unsigned int>(islands.size()));
+  }
+}
 
-    // randomizing order
-    if (enableRandomizer) {
-      for (unsigned int j = islandNumRigidBodies - 1; j-- > 0;) {
-        randX = ((randX * randA) + (randB & 0x7fffffff));
-        float tmp
-          = static_cast<float>(randX) / static_cast<float>(2147483648 * j);
-        unsigned int swap       = static_cast<unsigned int>(tmp) | 0;
-        constraint              = islandConstraints[j];
-        islandConstraints[j]    = islandConstraints[swap];
-        islandConstraints[swap] = constraint;
-      }
+void World::_solveIsland(Island& island, float invTimeStep)
+{
+  RigidBody** bodies = islandRigidBodies.data() + island.rigidBodiesStart;
+  Constraint** constraints
+    = islandConstraints.data() + island.constraintsStart;
+  const unsigned int numBodies      = island.numRigidBodies;
+  const unsigned int numConstraints = island.numConstraints;
+
+  // update velocities
+  auto gVel = Vec3().addScaledVector(gravity, timeStep);
+  for (unsigned int j = numBodies; j-- > 0;) {
+    if (bodies[j]->isDynamic) {
+      bodies[j]->linearVelocity.addEqual(gVel);
     }
+  }
 
-    // solve contraints
-    for (unsigned int j = islandNumConstraints - 1; j-- > 0;) {
-      // pre-solve
-      islandConstraints[j]->preSolve(timeStep, invTimeStep);
-    }
-    for (unsigned int k = 0; k < numIterations; ++k) {
-      for (unsigned int j = islandNumConstraints - 1; j-- > 0;) {
-        // main-solve
-        islandConstraints[j]->solve();
-      }
-    }
-    for (unsigned int j = islandNumConstraints - 1; j-- > 0;) {
-      islandConstraints[j]->postSolve(); // post-solve
-      islandConstraints[j] = nullptr;    // gc
+  // randomizing order
+  if (enableRandomizer) {
+    unsigned int rand = island.seed;
+    for (unsigned int j = numConstraints; j-- > 1;) {
+      rand = rand * randA + randB;
+      std::swap(constraints[j], constraints[rand % (j + 1)]);
     }
+  }
 
-    // sleeping check
-    float sleepTime = 10.f;
-    for (unsigned int j = islandNumRigidBodies - 1; j-- > 0;) {
-      body = islandRigidBodies[j];
-      if (callSleep(body)) {
-        body->sleepTime += timeStep;
-        if (body->sleepTime < sleepTime) {
-          sleepTime = body->sleepTime;
-        }
-      }
-      else {
-        body->sleepTime = 0.f;
-        sleepTime       = 0.f;
-        continue;
-      }
+  // solve contraints
+  for (unsigned int j = numConstraints; j-- > 0;) {
+    // pre-solve
+    constraints[j]->preSolve(timeStep, invTimeStep);
+  }
+  for (unsigned int k = 0; k < numIterations; ++k) {
+    for (unsigned int j = numConstraints; j-- > 0;) {
+      // main-solve
+      constraints[j]->solve();
     }
-    if (sleepTime > 0.5f) {
-      // sleep the island
-      for (unsigned int j = islandNumRigidBodies - 1; j-- > 0;) {
-        islandRigidBodies[j]->sleep();
-        islandRigidBodies[j] = nullptr; // gc
+  }
+  for (unsigned int j = numConstraints; j-- > 0;) {
+    constraints[j]->postSolve(); // post-solve
+  }
+
+  // sleeping check
+  float sleepTime = 10.f;
+  for (unsigned int j = numBodies; j-- > 0;) {
+    auto body = bodies[j];
+    if (callSleep(body)) {
+      body->sleepTime += timeStep;
+      if (body->sleepTime < sleepTime) {
+        sleepTime = body->sleepTime;
       }
     }
     else {
-      // update positions
-      for (unsigned int j = islandNumRigidBodies - 1; j-- > 0;) {
-        islandRigidBodies[j]->updatePosition(timeStep);
-        islandRigidBodies[j] = nullptr; // gc
-      }
+      body->sleepTime = 0.f;
+      sleepTime       = 0.f;
     }
-    ++numIslands;
   }
-
-  //----------------------------------------------------------------------------
-  //   END SIMULATION
-  //----------------------------------------------------------------------------
-
-  if (stat) {
-    performance.calcEnd();
+  if (sleepTime > 0.5f) {
+    // the island is put to sleep by step()
+    island.sleep = true;
+  }
+  else {
+    // update positions
+    for (unsigned int j = numBodies; j-- > 0;) {
+      bodies[j]->updatePosition(timeStep);
+    }
   }
 }
 
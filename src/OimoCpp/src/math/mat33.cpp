@@ -244,8 +244,9 @@ Mat33& Mat33::scaleEqual(float s)
 
 Mat33& Mat33::mul(const Mat33& m1, const Mat33& m2, bool transpose)
 {
-  const std::array<float, 9>& tm1 = m1.elements;
-  const std::array<float, 9>& tm2
+  // Copies, as this matrix can be one of the operands
+  const std::array<float, 9> tm1 = m1.elements;
+  const std::array<float, 9> tm2
     = transpose ? m2.clone().transpose().elements : m2.elements;
 
   float a0 = tm1[0], a3 = tm1[3], a6 = tm1[6];
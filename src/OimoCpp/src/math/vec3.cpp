@@ -177,7 +177,7 @@ Vec3& Vec3::scale(const Vec3& v, float s)
 
 Vec3& Vec3::addScaledVector(const Vec3& v, float s)
 {
-  return scale(v, s);
+  return addScale(v, s);
 }
 
 Vec3& Vec3::scaleEqual(float s)
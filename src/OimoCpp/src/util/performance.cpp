@@ -22,11 +22,15 @@ Performance::Performance(World* world)
     , numIslands{0}
     , broadPhaseTime{microsecond_t(0)}
     , narrowPhaseTime{microsecond_t(0)}
+    , manifoldUpdateTime{microsecond_t(0)}
+    , contactMergeTime{microsecond_t(0)}
     , solvingTime{microsecond_t(0)}
     , totalTime{microsecond_t(0)}
     , updateTime{microsecond_t(0)}
     , maxBroadPhaseTime{microsecond_t(0)}
     , maxNarrowPhaseTime{microsecond_t(0)}
+    , maxManifoldUpdateTime{microsecond_t(0)}
+    , maxContactMergeTime{microsecond_t(0)}
     , maxSolvingTime{microsecond_t(0)}
     , maxTotalTime{microsecond_t(0)}
     , maxUpdateTime{microsecond_t(0)}
@@ -44,11 +48,13 @@ void Performance::setTime(unsigned int n)
 
 void Performance::resetMax()
 {
-  maxBroadPhaseTime  = microsecond_t(0);
-  maxNarrowPhaseTime = microsecond_t(0);
-  maxSolvingTime     = microsecond_t(0);
-  maxTotalTime       = microsecond_t(0);
-  maxUpdateTime      = microsecond_t(0);
+  maxBroadPhaseTime     = microsecond_t(0);
+  maxNarrowPhaseTime    = microsecond_t(0);
+  maxManifoldUpdateTime = microsecond_t(0);
+  maxContactMergeTime   = microsecond_t(0);
+  maxSolvingTime        = microsecond_t(0);
+  maxTotalTime          = microsecond_t(0);
+  maxUpdateTime         = microsecond_t(0);
 }
 
 void Performance::calcBroadPhase()
@@ -58,11 +64,20 @@ void Performance::calcBroadPhase()
     = std::chrono::duration_cast<microseconds_t>(times[2] - times[1]);
 }
 
+void Performance::calcManifoldUpdate()
+{
+  setTime(4);
+  manifoldUpdateTime
+    = std::chrono::duration_cast<microseconds_t>(times[4] - times[2]);
+}
+
 void Performance::calcNarrowPhase()
 {
   setTime(3);
   narrowPhaseTime
     = std::chrono::duration_cast<microseconds_t>(times[3] - times[2]);
+  contactMergeTime
+    = std::chrono::duration_cast<microseconds_t>(times[3] - times[4]);
 }
 
 void Performance::calcEnd()
@@ -83,6 +98,12 @@ void Performance::calcEnd()
     if (narrowPhaseTime > maxNarrowPhaseTime) {
       maxNarrowPhaseTime = narrowPhaseTime;
     }
+    if (manifoldUpdateTime > maxManifoldUpdateTime) {
+      maxManifoldUpdateTime = manifoldUpdateTime;
+    }
+    if (contactMergeTime > maxContactMergeTime) {
+      maxContactMergeTime = contactMergeTime;
+    }
     if (solvingTime > maxSolvingTime) {
       maxSolvingTime = solvingTime;
     }
@@ -0,0 +1,88 @@
+#include <oimo/util/thread_pool.h>
+
+namespace OIMO {
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+    : _func{nullptr}
+    , _count{0}
+    , _next{0}
+    , _busyWorkers{0}
+    , _generation{0}
+    , _stop{false}
+{
+  for (unsigned int i = 1; i < numThreads; ++i) {
+    _workers.emplace_back([this]() { _run(); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _wakeUp.notify_all();
+  for (auto& worker : _workers) {
+    worker.join();
+  }
+}
+
+unsigned int ThreadPool::numThreads() const
+{
+  return static_cast<unsigned int>(_workers.size()) + 1;
+}
+
+void ThreadPool::parallelFor(size_t count, const Func& func)
+{
+  if (_workers.empty() || count < 2) {
+    for (size_t i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _func        = &func;
+    _count       = count;
+    _busyWorkers = static_cast<unsigned int>(_workers.size());
+    _next.store(0);
+    ++_generation;
+  }
+  _wakeUp.notify_all();
+
+  _work();
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  _done.wait(lock, [this]() { return _busyWorkers == 0; });
+  _func = nullptr;
+}
+
+void ThreadPool::_run()
+{
+  unsigned int generation = 0;
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _wakeUp.wait(lock,
+                 [&]() { return _stop || _generation != generation; });
+    if (_stop) {
+      return;
+    }
+    generation = _generation;
+    lock.unlock();
+    _work();
+    lock.lock();
+    if (--_busyWorkers == 0) {
+      _done.notify_one();
+    }
+  }
+}
+
+void ThreadPool::_work()
+{
+  for (size_t i = _next++; i < _count; i = _next++) {
+    (*_func)(i);
+  }
+}
+
+} // end of namespace OIMO